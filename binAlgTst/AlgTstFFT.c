@@ -0,0 +1,537 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _AlgTstFFT_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         AlgTstFFT.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Benchmark for the libAlg mixed radix FFT code. Times
+* 		the mixed radix transforms of the requested size
+* 		against Hartley transforms of the next power of two
+* 		(the size that data had to be padded to previously)
+* 		and reports the round trip error of the mixed radix
+* 		transforms.
+* \ingroup	binAlgTst
+*/
+
+#include <stdio.h>
+#include <float.h>
+#include <math.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <Alc.h>
+#include <Alg.h>
+
+static AlgError			AlgTstFFTRun(
+				  int d,
+				  int realFlg,
+				  int fltFlg,
+				  int nX,
+				  int nY,
+				  int nZ,
+				  void ***re,
+				  void ***im,
+				  AlgFFTDir dir);
+static void			AlgTstFFTHart(
+				  double ***a,
+				  int d,
+				  int nX,
+				  int nY,
+				  int nZ);
+static double			AlgTstFFTTime(
+				  struct timeval *t0,
+				  struct timeval *t1);
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern char     *optarg;
+extern int      optind,
+		opterr,
+		optopt;
+
+int             main(int argc, char **argv)
+{
+  int           d = 1,
+  		n = 1000,
+		nL = 1000,
+		nR = 5,
+		nP = 0,
+		idR,
+		fltFlg = 0,
+		realFlg = 0,
+		option,
+  		ok = 1,
+		usage = 0;
+  size_t	idx,
+  		nE = 0;
+  int		nX[2],
+  		nY[2],
+		nZ[2];
+  double	tFFT = 0.0,
+  		tHart = 0.0,
+		err = 0.0,
+		mag = 0.0;
+  void		***a[2];
+  double	***o = NULL;
+  double	***h[2];
+  struct timeval times[2];
+  AlgError	errNum = ALG_ERR_NONE;
+  static char	optList[] = "cfhrd:l:n:t:";
+
+  a[0] = a[1] = NULL;
+  h[0] = h[1] = NULL;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != -1))
+  {
+    switch(option)
+    {
+      case 'c':
+	realFlg = 0;
+	break;
+      case 'r':
+	realFlg = 1;
+	break;
+      case 'f':
+	fltFlg = 1;
+	break;
+      case 'd':
+	if((sscanf(optarg, "%d", &d) != 1) || (d < 1) || (d > 3))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'l':
+	if((sscanf(optarg, "%d", &nL) != 1) || (nL < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'n':
+	if((sscanf(optarg, "%d", &n) != 1) || (n < 2))
+	{
+	  usage = 1;
+	}
+	break;
+      case 't':
+	if((sscanf(optarg, "%d", &nR) != 1) || (nR < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if(usage == 0)
+  {
+    if(realFlg && ((n % 2) != 0))
+    {
+      usage = 1;
+    }
+    else if(AlgBitNextPowerOfTwo((unsigned int *)&nP, n) < 0)
+    {
+      usage = 1;
+    }
+  }
+  ok = usage == 0;
+  /* Array sizes, index 0 for the mixed radix transforms and 1 for the
+   * power of two Hartley transforms. One dimensional transforms are
+   * of nL lines each of length n. */
+  if(ok)
+  {
+    nX[0] = n;
+    nX[1] = nP;
+    nY[0] = (d == 1)? nL: n;
+    nY[1] = (d == 1)? nL: nP;
+    nZ[0] = (d == 3)? n: 1;
+    nZ[1] = (d == 3)? nP: 1;
+    nE = (size_t )nX[0] * nY[0] * nZ[0];
+    if(fltFlg)
+    {
+      ok = (AlcFloat3Malloc((float ****)&(a[0]),
+			    nZ[0], nY[0], nX[0]) == ALC_ER_NONE) &&
+	   (AlcFloat3Malloc((float ****)&(a[1]),
+			    nZ[0], nY[0], nX[0]) == ALC_ER_NONE);
+    }
+    else
+    {
+      ok = (AlcDouble3Malloc((double ****)&(a[0]),
+			     nZ[0], nY[0], nX[0]) == ALC_ER_NONE) &&
+	   (AlcDouble3Malloc((double ****)&(a[1]),
+			     nZ[0], nY[0], nX[0]) == ALC_ER_NONE);
+    }
+    ok = ok &&
+	 (AlcDouble3Malloc(&o, nZ[0], nY[0], nX[0]) == ALC_ER_NONE) &&
+	 (AlcDouble3Malloc(&(h[0]), nZ[1], nY[1], nX[1]) == ALC_ER_NONE) &&
+	 (AlcDouble3Malloc(&(h[1]), nZ[1], nY[1], nX[1]) == ALC_ER_NONE);
+    if(!ok)
+    {
+      (void )fprintf(stderr, "%s: Failed to allocate arrays.\n", *argv);
+    }
+  }
+  if(ok)
+  {
+    for(idx = 0; idx < nE; ++idx)
+    {
+      o[0][0][idx] = AlgRandUniform() - 0.5;
+    }
+    for(idx = 0; idx < (size_t )nX[1] * nY[1] * nZ[1]; ++idx)
+    {
+      h[0][0][0][idx] = AlgRandUniform() - 0.5;
+      h[1][0][0][idx] = AlgRandUniform() - 0.5;
+    }
+    for(idR = 0; ok && (idR < nR); ++idR)
+    {
+      /* Mixed radix forward and inverse transforms. */
+      for(idx = 0; idx < nE; ++idx)
+      {
+	if(fltFlg)
+	{
+	  ((float ***)a[0])[0][0][idx] = (float )(o[0][0][idx]);
+	  ((float ***)a[1])[0][0][idx] = 0.0f;
+	}
+	else
+	{
+	  ((double ***)a[0])[0][0][idx] = o[0][0][idx];
+	  ((double ***)a[1])[0][0][idx] = 0.0;
+	}
+      }
+      gettimeofday(times + 0, NULL);
+      errNum = AlgTstFFTRun(d, realFlg, fltFlg, nX[0], nY[0], nZ[0],
+			    a[0], a[1], ALG_FFT_DIR_FWD);
+      if(errNum == ALG_ERR_NONE)
+      {
+	errNum = AlgTstFFTRun(d, realFlg, fltFlg, nX[0], nY[0], nZ[0],
+			      a[0], a[1], ALG_FFT_DIR_INV);
+      }
+      gettimeofday(times + 1, NULL);
+      tFFT += AlgTstFFTTime(times + 0, times + 1);
+      if(errNum != ALG_ERR_NONE)
+      {
+	ok = 0;
+	(void )fprintf(stderr, "%s: FFT failed (error %d).\n",
+		       *argv, (int )errNum);
+      }
+      /* Power of two Hartley forward and inverse transforms, for
+       * complex data both the real and imaginary arrays are
+       * transformed. */
+      if(ok)
+      {
+        gettimeofday(times + 0, NULL);
+	AlgTstFFTHart(h[0], d, nX[1], nY[1], nZ[1]);
+	AlgTstFFTHart(h[0], d, nX[1], nY[1], nZ[1]);
+	if(!realFlg)
+	{
+	  AlgTstFFTHart(h[1], d, nX[1], nY[1], nZ[1]);
+	  AlgTstFFTHart(h[1], d, nX[1], nY[1], nZ[1]);
+	}
+        gettimeofday(times + 1, NULL);
+	tHart += AlgTstFFTTime(times + 0, times + 1);
+      }
+    }
+  }
+  if(ok)
+  {
+    /* Round trip error relative to the maximum input value, the
+     * unnormalised forward and inverse transforms scale by the number
+     * of data in the transform. */
+    double	s;
+
+    s = 1.0 / ((d == 1)? (double )n: (double )nE);
+    for(idx = 0; idx < nE; ++idx)
+    {
+      double	v;
+
+      v = (fltFlg)? ((float ***)a[0])[0][0][idx]:
+		    ((double ***)a[0])[0][0][idx];
+      v = fabs((v * s) - o[0][0][idx]);
+      if(v > err)
+      {
+        err = v;
+      }
+      v = fabs(o[0][0][idx]);
+      if(v > mag)
+      {
+        mag = v;
+      }
+    }
+    (void )printf("%s %s %dD size %d%s\n",
+		  (fltFlg)? "float": "double",
+		  (realFlg)? "real": "complex",
+		  d, n, (d == 1)? "": " per axis");
+    (void )printf("mixed radix (%d)  %gs\n", n, tFFT / nR);
+    (void )printf("hartley     (%d)  %gs\n", nP, tHart / nR);
+    (void )printf("speed up          %g\n",
+		  (tFFT > DBL_EPSILON)? tHart / tFFT: 0.0);
+    (void )printf("round trip error  %g\n",
+		  (mag > DBL_EPSILON)? err / mag: err);
+  }
+  if(fltFlg)
+  {
+    (void )AlcFloat3Free((float ***)a[0]);
+    (void )AlcFloat3Free((float ***)a[1]);
+  }
+  else
+  {
+    (void )AlcDouble3Free((double ***)a[0]);
+    (void )AlcDouble3Free((double ***)a[1]);
+  }
+  (void )AlcDouble3Free(o);
+  (void )AlcDouble3Free(h[0]);
+  (void )AlcDouble3Free(h[1]);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-c] [-f] [-r] [-d #] [-l #] [-n #] [-t #]\n"
+    "Benchmark for the libAlg mixed radix FFT code, which times mixed\n"
+    "radix forward and inverse transforms of the given size against\n"
+    "Hartley transforms of the next power of two size.\n"
+    "Options are:\n"
+    "  -c  Complex transforms, as opposed to real (value %s).\n"
+    "  -f  Single precision mixed radix transforms (value %s).\n"
+    "  -r  Real transforms, as opposed to complex (value %s).\n"
+    "  -d  Number of dimensions (value %d).\n"
+    "  -l  Number of lines for 1D transforms (value %d).\n"
+    "  -n  Transform size, must be even for real transforms (value %d).\n"
+    "  -t  Number of times to repeat the transforms (value %d).\n",
+    *argv,
+    (realFlg)? "false": "true",
+    (fltFlg)? "true": "false",
+    (realFlg)? "true": "false",
+    d, nL, n, nR);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	binAlgTst
+* \brief	Applies a mixed radix transform to the given array(s).
+* 		One dimensional transforms are applied to each of the
+* 		nY lines of the array.
+* \param	d			Transform dimension.
+* \param	realFlg			Real transforms if non zero.
+* \param	fltFlg			Float arrays if non zero, otherwise
+* 					double.
+* \param	nX			Number of columns.
+* \param	nY			Number of lines.
+* \param	nZ			Number of planes.
+* \param	re			Real (or real data) array.
+* \param	im			Imaginary array, unused for real
+* 					transforms.
+* \param	dir			Transform direction.
+*/
+static AlgError	AlgTstFFTRun(int d, int realFlg, int fltFlg,
+			     int nX, int nY, int nZ,
+			     void ***re, void ***im, AlgFFTDir dir)
+{
+  AlgError	errNum = ALG_ERR_NONE;
+
+  switch(d)
+  {
+    case 1:
+      {
+	int	idY;
+	void	*wrk = NULL;
+	AlgFFTPlan *plan;
+
+	plan = AlgFFTPlanGet(nX, realFlg, &errNum);
+	if(errNum == ALG_ERR_NONE)
+	{
+	  if((wrk = AlcMalloc(plan->wrkSz *
+	                      ((fltFlg)? sizeof(float): sizeof(double)))) == NULL)
+	  {
+	    errNum = ALG_ERR_MALLOC;
+	  }
+	}
+	for(idY = 0; (errNum == ALG_ERR_NONE) && (idY < nY); ++idY)
+	{
+	  if(fltFlg)
+	  {
+	    errNum = (realFlg)?
+		     AlgFFTRealFlt1D(plan, ((float **)re[0])[idY], 1, dir,
+				     (float *)wrk):
+		     AlgFFTFlt1D(plan, ((float **)re[0])[idY],
+				 ((float **)im[0])[idY], 1, dir, (float *)wrk);
+	  }
+	  else
+	  {
+	    errNum = (realFlg)?
+		     AlgFFTRealDbl1D(plan, ((double **)re[0])[idY], 1, dir,
+				     (double *)wrk):
+		     AlgFFTDbl1D(plan, ((double **)re[0])[idY],
+				 ((double **)im[0])[idY], 1, dir, (double *)wrk);
+	  }
+	}
+	AlcFree(wrk);
+	AlgFFTPlanFree(plan);
+      }
+      break;
+    case 2:
+      if(fltFlg)
+      {
+	errNum = (realFlg)?
+		 AlgFFTRealFlt2D((float **)re[0], nX, nY, dir):
+		 AlgFFTFlt2D((float **)re[0], (float **)im[0], nX, nY, dir);
+      }
+      else
+      {
+	errNum = (realFlg)?
+		 AlgFFTRealDbl2D((double **)re[0], nX, nY, dir):
+		 AlgFFTDbl2D((double **)re[0], (double **)im[0], nX, nY, dir);
+      }
+      break;
+    case 3:
+      if(fltFlg)
+      {
+	errNum = (realFlg)?
+		 AlgFFTRealFlt3D((float ***)re, nX, nY, nZ, dir):
+		 AlgFFTFlt3D((float ***)re, (float ***)im, nX, nY, nZ, dir);
+      }
+      else
+      {
+	errNum = (realFlg)?
+		 AlgFFTRealDbl3D((double ***)re, nX, nY, nZ, dir):
+		 AlgFFTDbl3D((double ***)re, (double ***)im, nX, nY, nZ, dir);
+      }
+      break;
+    default:
+      errNum = ALG_ERR_FUNC;
+      break;
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	binAlgTst
+* \brief	Applies power of two Hartley transforms along each axis
+* 		of the given array, copying the lines of data to a
+* 		contiguous buffer as the previous Fourier code did.
+* 		One dimensional transforms are applied to each of the
+* 		nY lines of the array.
+* \param	a			Contiguous array.
+* \param	d			Transform dimension.
+* \param	nX			Number of columns.
+* \param	nY			Number of lines.
+* \param	nZ			Number of planes.
+*/
+static void	AlgTstFFTHart(double ***a, int d, int nX, int nY, int nZ)
+{
+  int		ax;
+  double	*buf = NULL;
+  double	*data;
+
+  data = a[0][0];
+  for(ax = 0; ax < d; ++ax)
+  {
+    int		idL,
+    		nL,
+    		num;
+    size_t	step;
+
+    switch(ax)
+    {
+      case 0:
+	num = nX;
+	step = 1;
+	nL = nY * nZ;
+	break;
+      case 1:
+	num = nY;
+	step = nX;
+	nL = nX * nZ;
+	break;
+      default:
+	num = nZ;
+	step = (size_t )nX * nY;
+	nL = nX * nY;
+	break;
+    }
+#ifdef _OPENMP
+#pragma omp parallel private(buf)
+#endif
+    {
+      buf = (double *)AlcMalloc(sizeof(double) * num);
+#ifdef _OPENMP
+#pragma omp for
+#endif
+      for(idL = 0; idL < nL; ++idL)
+      {
+	int	idN;
+	double	*p;
+
+        switch(ax)
+	{
+	  case 0:
+	    p = data + ((size_t )idL * nX);
+	    break;
+	  case 1:
+	    p = data + ((size_t )(idL / nX) * nX * nY) + (idL % nX);
+	    break;
+	  default:
+	    p = data + idL;
+	    break;
+	}
+	if(buf)
+	{
+	  for(idN = 0; idN < num; ++idN)
+	  {
+	    buf[idN] = p[idN * step];
+	  }
+	  AlgFourHart1D(buf, num, 1);
+	  for(idN = 0; idN < num; ++idN)
+	  {
+	    p[idN * step] = buf[idN];
+	  }
+	}
+      }
+      AlcFree(buf);
+    }
+  }
+}
+
+/*!
+* \return	Elapsed time in seconds.
+* \ingroup	binAlgTst
+* \brief	Computes the elapsed time between two times.
+* \param	t0			Start time.
+* \param	t1			End time.
+*/
+static double	AlgTstFFTTime(struct timeval *t0, struct timeval *t1)
+{
+  struct timeval t2;
+
+  ALC_TIMERSUB(t1, t0, &t2);
+  return(t2.tv_sec + (0.000001 * t2.tv_usec));
+}
@@ -49,7 +49,8 @@ static char _WlzGauss_c[] = "University of Edinburgh $Id$";
 WlzGauss - applies a Gaussian filter to an objects grey values.
 \par Synopsis
 \verbatim
-WlzGauss [-w #[ #]] [-x#] [-y#] [-h] [<input file>]
+WlzGauss [-w #[ #[ #]]] [-x#] [-y#] [-z#] [-r] [-S] [-N#] [-h]
+         [<input file>]
 \endverbatim
 \par Options
 <table width="500" border="0">
@@ -60,10 +61,19 @@ WlzGauss [-w #[ #]] [-x#] [-y#] [-h] [<input file>]
   <tr> 
     <td><b>-w</b></td>
     <td>
-    Gaussian widths in the x and (optionaly) y directions,
+    Gaussian widths in the x and (optionaly) y and z directions,
     specified as full width half maximum in pixels,
     with a default value of 3.0. If a single width parameter is given
-    the y width is set equal to the x width.
+    the y width is set equal to the x width and if the z width is
+    not given it is set equal to the x width.
+    </td>
+  </tr>
+  <tr> 
+    <td><b>-r</b></td>
+    <td>
+    Use the recursive filter WlzGaussObj() for 2D objects, the
+    cost of which is independent of the Gaussian width.
+    The recursive filter is always used for 3D objects.
     </td>
   </tr>
   <tr> 
@@ -76,13 +86,36 @@ WlzGauss [-w #[ #]] [-x#] [-y#] [-h] [<input file>]
   <tr> 
     <td><b>-y</b></td>
     <td>
-    Order of the x derivative with possible values 0,1,2 and
+    Order of the y derivative with possible values 0,1,2 and
+    a default value of 0.
+    </td>
+  </tr>
+  <tr> 
+    <td><b>-z</b></td>
+    <td>
+    Order of the z derivative with possible values 0,1,2 and
     a default value of 0.
     </td>
   </tr>
+  <tr> 
+    <td><b>-S</b></td>
+    <td>
+    Stream a single 3D object, reading and writing it one plane at
+    a time so that only a window of planes is held in memory.
+    The result differs from that of filtering the whole object by a
+    negligible amount.
+    </td>
+  </tr>
+  <tr> 
+    <td><b>-N</b></td>
+    <td>
+    Number of planes in the window when streaming, if not given a
+    default is used.
+    </td>
+  </tr>
 </table>
 \par Description
-Applies a Gaussian filter to the grey values of a Woolz object.
+Applies a Gaussian filter to the grey values of a 2D or 3D Woolz object.
 \par Examples
 \verbatim
 WlzGauss -w 5 in.wlz >smooth.wlz
@@ -97,6 +130,7 @@ The resulting object is written to smooth.wlz.
 \ref wlzrankobj "WlzRankObj(1)"
 \ref wlzrsvfilterobj "WlzRsvFilterObj(1)"
 \ref WlzGauss2 "WlzGauss2(3)"
+\ref WlzGaussObj "WlzGaussObj(3)"
 */
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -104,6 +138,7 @@ The resulting object is written to smooth.wlz.
 #include <stdlib.h>
 #include <limits.h>
 #include <float.h>
+#include <math.h>
 
 #include <Wlz.h>
 
@@ -118,17 +153,24 @@ extern char     *optarg;
 static void usage(char *proc_str)
 {
   fprintf(stderr,
-	  "Usage:\t%s [-w#[#]] [-x#] [-y#] [-h] [<input file>]\n"
+	  "Usage:\t%s [-w#[#[#]]] [-x#] [-y#] [-z#] [-r] [-S] [-N#] [-h]\n"
+	  "\t\t[<input file>]\n"
 	  "\tApply a Gaussian filter to a grey-level woolz object\n"
 	  "\twriting the new object to standard output\n"
 	  "Version: %s\n"
 	  "Options:\n"
-	  "\t  -w#[,#]   x_width[y_width] gaussian widths defined as\n"
-	  "\t            full width half maximum in pixels\n"
-	  "\t            default value 3.0, if y_width omitted\n"
-	  "\t            then it is set equal to x_width\n"
+	  "\t  -w#[,#[,#]] x_width[y_width[z_width]] gaussian widths\n"
+	  "\t            defined as full width half maximum in pixels\n"
+	  "\t            default value 3.0, if y_width or z_width are\n"
+	  "\t            omitted then they are set equal to x_width\n"
 	  "\t  -x#       x derivative - possible values 0,1,2, default - 0\n"
 	  "\t  -y#       y derivative - possible values 0,1,2, default - 0\n"
+	  "\t  -z#       z derivative - possible values 0,1,2, default - 0\n"
+	  "\t  -r        use the recursive filter for 2D objects (it is\n"
+	  "\t            always used for 3D objects)\n"
+	  "\t  -S        stream a single 3D object through memory a\n"
+	  "\t            window of planes at a time\n"
+	  "\t  -N#       number of planes in the streaming window\n"
 	  "\t  -h        Help - prints this usage message\n",
 	  proc_str,
 	  WlzVersion());
@@ -141,23 +183,31 @@ int main(int	argc,
 
   WlzObject	*obj, *nobj;
   FILE		*inFile;
-  char 		optList[] = "hw:x:y:";
+  char 		optList[] = "hrSN:w:x:y:z:";
   int		option;
-  double	x_width, y_width;
-  int		x_deriv, y_deriv;
+  int		rsvFlg = 0,
+  		stream = 0,
+		nWin = 0;
+  double	x_width, y_width, z_width;
+  int		x_deriv, y_deriv, z_deriv;
+  WlzDVertex3	sigma;
+  WlzIVertex3	order;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const double	fwhmToSigma = 1.0 / (2.0 * sqrt(2.0 * log(2.0)));
     
   /* set defaults, read the argument list and check for an input file */
   opterr = 0;
   x_width = 3.0;
   y_width = 3.0;
+  z_width = 3.0;
   x_deriv = 0;
   y_deriv = 0;
+  z_deriv = 0;
   while( (option = getopt(argc, argv, optList)) != EOF ){
     switch( option ){
 
     case 'w':
-      switch( sscanf(optarg, "%lg,%lg", &x_width, &y_width) ){
+      switch( sscanf(optarg, "%lg,%lg,%lg", &x_width, &y_width, &z_width) ){
 
       default:
       case 0:
@@ -167,9 +217,14 @@ int main(int	argc,
 
       case 1:
 	y_width = x_width;
+	z_width = x_width;
 	break;
 
       case 2:
+	z_width = x_width;
+	break;
+
+      case 3:
 	break;
 
       }
@@ -183,6 +238,22 @@ int main(int	argc,
       y_deriv = atoi(optarg);
       break;
 
+    case 'z':
+      z_deriv = atoi(optarg);
+      break;
+
+    case 'r':
+      rsvFlg = 1;
+      break;
+
+    case 'S':
+      stream = 1;
+      break;
+
+    case 'N':
+      nWin = atoi(optarg);
+      break;
+
     case 'h':
     default:
       usage(argv[0]);
@@ -200,20 +271,49 @@ int main(int	argc,
     }
   }
 
+  sigma.vtX = x_width * fwhmToSigma;
+  sigma.vtY = y_width * fwhmToSigma;
+  sigma.vtZ = z_width * fwhmToSigma;
+  order.vtX = x_deriv;
+  order.vtY = y_deriv;
+  order.vtZ = z_deriv;
+
+  /* stream a single 3D object */
+  if( stream ){
+    if((errNum = WlzPlaneStreamGauss(inFile, stdout, nWin,
+    				     sigma, order)) != WLZ_ERR_NONE){
+      const char *errMsg;
+
+      (void )WlzStringFromErrorNum(errNum, &errMsg);
+      (void )fprintf(stderr, "%s: failed to filter object (%s).\n",
+		     argv[0], errMsg);
+      return 1;
+    }
+    return 0;
+  }
+
   /* read objects and threshold if possible */
   while((obj = WlzAssignObject(WlzReadObj(inFile, NULL), NULL)) != NULL) 
   {
     switch( obj->type )
     {
       case WLZ_2D_DOMAINOBJ:
-	if( (nobj = WlzGauss2(obj, x_width, y_width,
-			      x_deriv, y_deriv, &errNum)) != NULL ){
+	nobj = (rsvFlg)?
+	       WlzGaussObj(obj, sigma, order, &errNum):
+	       WlzGauss2(obj, x_width, y_width, x_deriv, y_deriv, &errNum);
+	if( nobj != NULL ){
 	  errNum = WlzWriteObj(stdout, nobj);
 	  WlzFreeObj(nobj);
 	}
 	break;
 
       case WLZ_3D_DOMAINOBJ:
+	if( (nobj = WlzGaussObj(obj, sigma, order, &errNum)) != NULL ){
+	  errNum = WlzWriteObj(stdout, nobj);
+	  WlzFreeObj(nobj);
+	}
+	break;
+
       default:
 	errNum = WlzWriteObj(stdout, obj);
 	break;
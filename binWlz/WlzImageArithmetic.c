@@ -49,7 +49,7 @@ static char _WlzImageArithmetic_c[] = "University of Edinburgh $Id$";
 WlzImageArithmetic - binary image arithmetic on a pair of domain objects.
 \par Synopsis
 \verbatim
-WlzImageArithmetic [-o<out file>] [-a] [-d] [-l] [-g] [-i] [-m] [-s]
+WlzImageArithmetic [-o<out file>] [-a] [-c] [-d] [-l] [-g] [-i] [-m] [-s]
                    [-n] [-N] [-h] [-O#] [<in object 0>] [<in object 1>]
 \endverbatim
 \par Options
@@ -66,6 +66,11 @@ WlzImageArithmetic [-o<out file>] [-a] [-d] [-l] [-g] [-i] [-m] [-s]
     <td><b>-a</b></td>
     <td>Add the object's grey values.</td>
   </tr>
+  <tr> 
+    <td><b>-c</b></td>
+    <td>Clamp values into the range of the output grey type rather
+        than casting them.</td>
+  </tr>
   <tr> 
     <td><b>-d</b></td>
     <td>Divide the grey values of the 1st object by those of the 2nd.</td>
@@ -147,6 +152,7 @@ int             main(int argc, char **argv)
 {
   int		idx,
 		option,
+		clamp = 0,
 		dither = 0,
 		overwrite = 1,
 		ok = 1,
@@ -162,7 +168,7 @@ int             main(int argc, char **argv)
   WlzPixelV	gMin[3],
   		gMax[3];
   const char	*errMsg;
-  static char	optList[] = "O:o:ab:dgilmsnNh",
+  static char	optList[] = "O:o:ab:cdgilmsnNh",
 		outObjFileStrDef[] = "-",
   		inObjFileStrDef[] = "-";
 
@@ -217,6 +223,9 @@ int             main(int argc, char **argv)
 	    break;
 	}
 	break;
+      case 'c':
+        clamp = 1;
+	break;
       case 'd':
 	operator = WLZ_BO_DIVIDE;
 	break;
@@ -336,8 +345,11 @@ int             main(int argc, char **argv)
 		       *argv, errMsg);
       }
     }
-    else if((outObj = WlzImageArithmetic(inObj[0], inObj[1], operator, 0,
-				    &errNum)) == NULL)
+    else if((outObj = (clamp)?
+		      WlzImageArithmeticClamp(inObj[0], inObj[1], operator, 0,
+				              &errNum):
+		      WlzImageArithmetic(inObj[0], inObj[1], operator, 0,
+				         &errNum)) == NULL)
     {
       ok = 0;
       (void )WlzStringFromErrorNum(errNum, &errMsg);
@@ -469,7 +481,7 @@ int             main(int argc, char **argv)
 
     fprintf(stderr,
 	    "Usage: %s"
-	    " [-O#] [-o<out file>] [-a] [-b <op>] [-d] [-g]\n"
+	    " [-O#] [-o<out file>] [-a] [-b <op>] [-c] [-d] [-g]\n"
 	    "                          [-i] [-l] [-m] [-s] [-h]\n"
 	    "                          [<in object 0>] [<in object 1>]\n"
 	    "Version: %s\n"
@@ -495,6 +507,8 @@ int             main(int argc, char **argv)
 	    "               =  %d - MAX\n"
 	    "               =  %d - MIN\n"
 	    "               =  %d - MAGNITUDE\n"
+	    "  -c        Clamp values into the range of the output grey type\n"
+	    "            rather than casting them.\n"
 	    "  -d        Divide the grey values of the 1st object by those of the 2nd.\n"
 	    "  -g        Vector magnitude of horizontal and vertical component objects\n"
 	    "  -i        Dither values if setting range\n"
@@ -49,7 +49,7 @@ static char _WlzLabel_c[] = "University of Edinburgh $Id$";
 WlzLabel - labels (segments) the input objects.
 \par Synopsis
 \verbatim
-WlzLabel [i#] [-v] [-h] [-M#] [<input file>]
+WlzLabel [i#] [-v] [-h] [-l] [-u] [-M#] [<input file>]
 \endverbatim
 \par Options
 <table width="500" border="0">
@@ -69,6 +69,17 @@ WlzLabel [i#] [-v] [-h] [-M#] [<input file>]
     <td><b>-M</b></td>
     <td>Maximum number of segmented objects.</td>
   </tr>
+  <tr> 
+    <td><b>-u</b></td>
+    <td>Use the union-find labeller which has no limit on the number
+        of segmented objects.</td>
+  </tr>
+  <tr> 
+    <td><b>-l</b></td>
+    <td>Write a single object with int values which are the labels of
+        the segmented objects rather than the segmented objects,
+	implies -u.</td>
+  </tr>
 </table>
 \par Description
 Label (segment) the input objects and write the result
@@ -83,6 +94,13 @@ keeping all values less than 200,
 labels the resulting domain and then expoldes the concatonated
 objects into seperate files.
 
+\verbatim
+WlzThreshold -v 200 -L vol.wlz | WlzLabel -l >lbl.wlz
+\endverbatim
+Thresholds the 3D object read from the file vol.wlz
+and writes a single object to lbl.wlz in which the values of
+the resulting domain are the labels of the connected components.
+
 \verbatim
 WlzThreshold -v 150 -L sec.wlz | WlzLabel | WlzArea
 \endverbatim
@@ -116,7 +134,7 @@ extern char     *optarg;
 static void usage(char *proc_str)
 {
   (void )fprintf(stderr,
-	  "Usage:\t%s [i#] [-M#] [-v] [-h] [<input file>]\n"
+	  "Usage:\t%s [i#] [-M#] [-l] [-u] [-v] [-h] [<input file>]\n"
 	  "\tLabel (segment) the input objects and write the result\n"
 	  "\tto stdout. Non-domain objects are ignored, the number\n"
 	  "\tof segments found is written to stderr\n"
@@ -124,6 +142,10 @@ static void usage(char *proc_str)
 	  "Options:\n"
 	  "\t  -i#       Ignore objects with number of lines < #\n"
 	  "\t  -M#       Maximum number of segmented objects.\n"
+	  "\t  -u        Use the union-find labeller which has no limit on\n"
+	  "\t            the number of segmented objects.\n"
+	  "\t  -l        Write a single object with the component labels as\n"
+	  "\t            its values, implies -u.\n"
 	  "\t  -v        Verbose flag\n"
 	  "\t  -h        Help - prints this usage message\n",
 	  proc_str,
@@ -140,9 +162,11 @@ int main(int	argc,
   WlzObject	*obj;
   WlzObject	**objlist = NULL;
   FILE		*inFile;
-  char 		optList[] = "i:M:vh";
+  char 		optList[] = "i:M:luvh";
   int		option;
   int		count, numobj, maxobj = MAXOBJS, i, verbose = 0;
+  int		lblImg = 0, useUF = 0;
+  WlzObject	*lblObj;
   int		ignw = -1;
   const char	*errMsg;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -170,6 +194,14 @@ int main(int	argc,
       }
       break;
  
+    case 'l':
+      lblImg = 1;
+      break;
+
+    case 'u':
+      useUF = 1;
+      break;
+
     case 'v':
       verbose = 1;
       break;
@@ -201,7 +233,26 @@ int main(int	argc,
 
     case WLZ_2D_DOMAINOBJ:
     case WLZ_3D_DOMAINOBJ:
-      errNum = WlzLabel(obj, &numobj, &objlist, maxobj, ignw, WLZ_8_CONNECTED);
+      if(lblImg) {
+	lblObj = WlzLabelUFImage(obj, ignw, WLZ_8_CONNECTED, &numobj,
+				 &errNum);
+	if(errNum == WLZ_ERR_NONE) {
+	  if(verbose) {
+	    fprintf(stderr,"%s: writing %d labels from input object %d\n",
+		    argv[0], numobj, count);
+	  }
+	  errNum = WlzWriteObj(stdout, lblObj);
+	  WlzFreeObj(lblObj);
+	}
+	break;
+      }
+      if(useUF) {
+	errNum = WlzLabelUF(obj, &numobj, &objlist, ignw, WLZ_8_CONNECTED);
+      }
+      else {
+	errNum = WlzLabel(obj, &numobj, &objlist, maxobj, ignw,
+			  WLZ_8_CONNECTED);
+      }
       if(errNum == WLZ_ERR_DOMAIN_TYPE) {
 	errNum = WlzWriteObj(stdout, obj);
       }
@@ -50,8 +50,8 @@ static char _WlzMatchICPObj_c[] = "University of Edinburgh $Id$";
 WlzMatchICPObj - object matching using ICP based registration.
 \par Synopsis
 \verbatim
-WlzMatchICPObj [-b#] [-d#] [-D#] [-E#] [-o#] [-t#] [-g#] [-i#] [-s#]
-               [-A#] [-S#] [-F#] [-I#] [-N] [-h]
+WlzMatchICPObj [-b#] [-d#] [-D#] [-E#] [-f#] [-T#] [-o#] [-t#] [-g#]
+               [-i#] [-s#] [-A#] [-S#] [-F#] [-I#] [-N] [-h]
 	       [<input object 0>] [<input object 1>]
 \endverbatim
 \par Options
@@ -77,6 +77,19 @@ WlzMatchICPObj [-b#] [-d#] [-D#] [-E#] [-o#] [-t#] [-g#] [-i#] [-s#]
     <td><b>-E</b></td>
     <td>Tolerance in mean registration metric value.</td>
   </tr>
+  <tr> 
+    <td><b>-f</b></td>
+    <td>Initial fraction of the source vertices matched in each
+        registration, range (0.0-1.0]. The fraction is doubled each
+	time a registration converges until all the vertices are used.
+	The default 1.0 uses all the vertices in every iteration.</td>
+  </tr>
+  <tr> 
+    <td><b>-T</b></td>
+    <td>Tolerance for the transform update, a registration ends when
+        no element of the update differs from the identity transform
+	by more than this. The default 0.0 disables this test.</td>
+  </tr>
   <tr> 
     <td><b>-o</b></td>
     <td>Output file name.</td>
@@ -187,6 +200,8 @@ int             main(int argc, char *argv[])
   		ok = 1,
 		usage = 0;
   double	delta = 0.01,
+  		subFrac = 1.0,
+		trTol = 0.0,
   		maxAng = 30.0 * ALG_M_PI / 180.0,
   		maxDeform = 0.5,
   		maxDisp = 25.0,
@@ -202,7 +217,7 @@ int             main(int argc, char *argv[])
   		matchSP;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   const char	*errMsg;
-  static char	optList[] = "ahrA:b:d:D:E:F:N:o:t:i:I:s:P:S:";
+  static char	optList[] = "ahrA:b:d:D:E:f:F:N:o:t:T:i:I:s:P:S:";
   const char	outFileStrDef[] = "-",
   		inObjFileStrDef[] = "-";
 
@@ -255,6 +270,21 @@ int             main(int argc, char *argv[])
 	  ok = 0;
 	}
 	break;
+      case 'f':
+        if((sscanf(optarg, "%lg", &subFrac) != 1) ||
+	   (subFrac <= 0.0) || (subFrac > 1.0))
+	{
+	  usage = 1;
+	  ok = 0;
+	}
+	break;
+      case 'T':
+        if((sscanf(optarg, "%lg", &trTol) != 1) || (trTol < 0.0))
+	{
+	  usage = 1;
+	  ok = 0;
+	}
+	break;
       case 'F':
         if((sscanf(optarg, "%lg", &maxDeform) != 1) || (maxDeform < 0.0))
 	{
@@ -403,7 +433,8 @@ int             main(int argc, char *argv[])
 			     &nMatch, &matchTP, &matchSP,
 			     maxItr, minSpx, minSegSpx, brkFlg,
 			     maxDisp, maxAng, maxDeform,
-			     matchImpNN, matchImpThr, delta);
+			     matchImpNN, matchImpThr, delta,
+			     subFrac, trTol);
     if(errNum != WLZ_ERR_NONE)
     {
       ok = 0;
@@ -482,8 +513,8 @@ int             main(int argc, char *argv[])
       (void )fprintf(stderr,
       "Usage: %s%s%s%s",
       *argv,
-      " [-b#] [-d#] [-D#] [-E#] [-o#] [-t#] [-g#] [-i#] [-s#]\n"
-      "          [-A#] [-S#] [-F#] [-I#] [-N]\n"
+      " [-b#] [-d#] [-D#] [-E#] [-f#] [-T#] [-o#] [-t#] [-g#]\n"
+      "          [-i#] [-s#] [-A#] [-S#] [-F#] [-I#] [-N]\n"
       "          [-h] [<input object 0>] [<input object 1>]\n"
       "Version: ",
       WlzVersion(),
@@ -495,6 +526,13 @@ int             main(int argc, char *argv[])
       "        0  no debug output.\n"
       "        1  untransformed decomposed source model.\n"
       "  -E  Tolerance in mean registration metric value.\n"
+      "  -f  Initial fraction of the source vertices matched in each\n"
+      "      registration, range (0.0-1.0]. The fraction is doubled each\n"
+      "      time a registration converges until all the vertices are\n"
+      "      used (default 1.0).\n"
+      "  -T  Tolerance for the transform update, a registration ends when\n"
+      "      no element of the update differs from the identity transform\n"
+      "      by more than this, 0.0 disables this test (default 0.0).\n"
       "  -h  Prints this usage information.\n"
       "  -o  Output file name.\n"
       "  -t  Initial affine transform.\n"
@@ -49,7 +49,7 @@ static char _WlzRankObj_c[] = "University of Edinburgh $Id$";
 WlzRankObj  -  rank filters domain objects with values.
 \par Synopsis
 \verbatim
-WlzRankObj [-h] [-o<output file>] [-r#] [-s#] [<input file>]
+WlzRankObj [-h] [-o<output file>] [-r#] [-s#] [-S] [-N#] [<input file>]
 \endverbatim
 \par Options
 <table width="500" border="0">
@@ -71,6 +71,16 @@ WlzRankObj [-h] [-o<output file>] [-r#] [-s#] [<input file>]
     <td>Size of filter region, must be greater than zero.
         Default 3 for 3x3 region.</td>
   </tr>
+  <tr> 
+    <td><b>-S</b></td>
+    <td>Stream a 3D object, reading and writing it one plane at a
+        time so that only a window of planes is held in memory.</td>
+  </tr>
+  <tr> 
+    <td><b>-N</b></td>
+    <td>Number of planes in the window when streaming, if not
+        given a default is used.</td>
+  </tr>
 </table>
 \par Description
 Rank filters the grey values of a domain object.
@@ -83,6 +93,11 @@ WlzRankObj -o out.wlz -r 0.5 in.wlz
 Creates a new object which is written to the file out.wlz.
 This object is computed by applying a median filter to
 the object read from the file in.wlz.
+\verbatim
+WlzRankObj -S -s 5 -o out.wlz in.wlz
+\endverbatim
+Median filters the 3D object read from in.wlz using a 5x5x5 region,
+with the object being streamed through memory a few planes at a time.
 \par File
 \ref WlzRankObj.c "WlzRankObj.c"
 \par See Also
@@ -113,15 +128,18 @@ int		main(int argc, char *argv[])
   int		ok = 1,
   		option,
   		usage = 0,
+		stream = 0,
+		nWin = 0,
 		rSz = 3;
   double 	rank = 0.5;
-  FILE		*fP = NULL;
+  FILE		*fP = NULL,
+  		*oFP = NULL;
   char		*inObjFileStr,
   		*outObjFileStr;
   const char	*errMsgStr;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   WlzObject	*obj = NULL;
-  static char   optList[] = "ho:r:s:";
+  static char   optList[] = "hSN:o:r:s:";
   const char    inObjFileStrDef[] = "-",
   	        outObjFileStrDef[] = "-";
 
@@ -135,6 +153,16 @@ int		main(int argc, char *argv[])
       case 'o':
         outObjFileStr = optarg;
 	break;
+      case 'N':
+	if(sscanf(optarg, "%d", &nWin) != 1)
+	{
+	  usage = 1;
+	  ok = 0;
+	}
+	break;
+      case 'S':
+        stream = 1;
+	break;
       case 'r':
 	if((sscanf(optarg, "%lg", &rank) != 1) || (rank < 0.0) || (rank > 1.0))
 	{
@@ -177,7 +205,46 @@ int		main(int argc, char *argv[])
       }
     }
   }
-  if(ok)
+  if(ok && stream)
+  {
+    if((fP = (strcmp(inObjFileStr, "-")?
+              fopen(inObjFileStr, "r"): stdin)) == NULL)
+    {
+      ok = 0;
+      (void )fprintf(stderr,
+                     "%s: failed to open input file %s\n",
+                     *argv, inObjFileStr);
+    }
+    else if((oFP = (strcmp(outObjFileStr, "-")?
+	           fopen(outObjFileStr, "w"): stdout)) == NULL)
+    {
+      ok = 0;
+      (void )fprintf(stderr,
+		     "%s: Failed to open output file %s.\n",
+		     argv[0], outObjFileStr);
+    }
+    else
+    {
+      errNum = WlzPlaneStreamRankFilter(fP, oFP, nWin, rSz, rank);
+      if(errNum != WLZ_ERR_NONE)
+      {
+	ok = 0;
+	(void )WlzStringFromErrorNum(errNum, &errMsgStr);
+	(void )fprintf(stderr, "%s Failed to rank filter object, %s.\n",
+		       argv[0],
+		       errMsgStr);
+      }
+    }
+    if(fP && strcmp(inObjFileStr, "-"))
+    {
+      fclose(fP);
+    }
+    if(oFP && strcmp(outObjFileStr, "-"))
+    {
+      fclose(oFP);
+    }
+  }
+  else if(ok)
   {
     if((inObjFileStr == NULL) ||
        (*inObjFileStr == '\0') ||
@@ -196,7 +263,7 @@ int		main(int argc, char *argv[])
       fclose(fP);
     }
   }
-  if(ok)
+  if(ok && !stream)
   {
     errNum = WlzRankFilter(obj, rSz, rank);
     if(errNum != WLZ_ERR_NONE)
@@ -208,7 +275,7 @@ int		main(int argc, char *argv[])
 		     errMsgStr);
     }
   }
-  if(ok)
+  if(ok && !stream)
   {
     if((fP = (strcmp(outObjFileStr, "-")?
 	     fopen(outObjFileStr, "w"): stdout)) == NULL)
@@ -219,7 +286,7 @@ int		main(int argc, char *argv[])
 		     argv[0], outObjFileStr);
     }
   }
-  if(ok)
+  if(ok && !stream)
   {
     errNum = WlzWriteObj(fP, obj);
     if(errNum != WLZ_ERR_NONE)
@@ -235,7 +302,8 @@ int		main(int argc, char *argv[])
   if(usage)
   {
     (void )fprintf(stderr,
-            "Usage: %s [-h] [-o<output file>] [-r#] [-s#] [<input file>]\n"
+            "Usage: %s [-h] [-o<output file>] [-r#] [-s#] [-S] [-N#]\n"
+	    "       [<input file>]\n"
     	    "Rank filters the grey values of a Woolz domain object.\n"
 	    "Version %s\n"
 	    "Options:\n"
@@ -244,7 +312,11 @@ int		main(int argc, char *argv[])
 	    "  -r  Required rank. Range [0.0-1.0] with 0.0 minimum, 0.5\n"
 	    "      median and 1.0 maximum value. Default 0.5.\n"
 	    "  -s  Size of filter region, must be greater than zero.\n"
-	    "      Default 3 for 3x3 region.\n",
+	    "      Default 3 for 3x3 region.\n"
+	    "  -S  Stream a 3D object, reading and writing it one plane at a\n"
+	    "      time so that only a window of planes is held in memory.\n"
+	    "  -N  Number of planes in the window when streaming, if not\n"
+	    "      given a default is used.\n",
 	    argv[0],
 	    WlzVersion());
 
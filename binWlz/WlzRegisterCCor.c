@@ -35,7 +35,7 @@ static char _WlzRegisterCCor_c[] = "University of Edinburgh $Id$";
 * License along with this program; if not, write to the Free
 * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
 * Boston, MA  02110-1301, USA.
-* \brief	Registers a pair of 2D domain objects with grey values
+* \brief	Registers a pair of 2D or 3D domain objects with grey values
 * 		using frequency domain cross-correlation.
 * \ingroup	BinWlz
 *
@@ -47,8 +47,8 @@ static char _WlzRegisterCCor_c[] = "University of Edinburgh $Id$";
 \ingroup BinWlz
 \defgroup wlzregisterccor WlzRegisterCCor
 \par Name
-WlzRegisterCCor - registers a pair of 2D domain objects with grey values
-                  using frequency domain cross-correlation.
+WlzRegisterCCor - registers a pair of 2D or 3D domain objects with grey
+                  values using frequency domain cross-correlation.
 \par Synopsis
 \verbatim
 WlzRegisterCCor [-h] [-v] [-o<out obj>] [-i <init tr>] [-n]
@@ -102,8 +102,10 @@ WlzRegisterCCor [-h] [-v] [-o<out obj>] [-i <init tr>] [-n]
 </table>
 \par Description
 Attempts to register two objects using an frequency domain
-cross-correlation algorithm.  The two objects must be 2D spatial
-domain objects with grey values.
+cross-correlation algorithm.  The two objects must both be either 2D
+or 3D spatial domain objects with grey values. For 3D objects the
+maximum translation in z is the greater of the maximum translations in
+x and y and the maximum rotation applies about each of the axes.
 It is important to give sensible maximum translation and rotation
 values. If they are to small the itteration probably will not converge
 to the true maximum cross-correlation values, but if the values are
@@ -318,7 +320,8 @@ int             main(int argc, char **argv)
   if(ok)
   {
     /* Check object types. */
-    if((inObj[0]->type != WLZ_2D_DOMAINOBJ) ||
+    if(((inObj[0]->type != WLZ_2D_DOMAINOBJ) &&
+        (inObj[0]->type != WLZ_3D_DOMAINOBJ)) ||
        (inObj[0]->type != inObj[1]->type))
     {
       errNum = WLZ_ERR_OBJECT_TYPE;
@@ -439,8 +442,10 @@ int             main(int argc, char **argv)
     "  -V  Invert grey values. Objects must have the background with low\n"
     "      and the foreground with high values.\n"
     "Attempts to register two objects using an frequency domain\n"
-    "cross-correlation algorithm.  The two objects must be 2D spatial\n"
-    "domain objects with grey values.\n"
+    "cross-correlation algorithm.  The two objects must both be either 2D\n"
+    "or 3D spatial domain objects with grey values. For 3D objects the\n"
+    "maximum translation in z is the greater of the maximum translations in\n"
+    "x and y and the maximum rotation applies about each of the axes.\n"
     "It is important to give sensible maximum translation and rotation\n"
     "values. If they are to small the itteration probably will not converge\n"
     "to the true maximum cross-correlation values, but if the values are\n"
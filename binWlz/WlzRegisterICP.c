@@ -52,7 +52,7 @@ WlzRegisterICP - registers two objects using an iterative closest point
 \par Synopsis
 \verbatim
 WlzRegisterICP [-h] [-o<out obj>]
-               [-E #] [-I] [-M #] [-i <init tr>] [-t] [-r]
+               [-E #] [-I] [-M #] [-f #] [-T #] [-i <init tr>] [-t] [-r]
 	       [<in obj 0>] [<in obj 1>]
 \endverbatim
 \par Options
@@ -79,6 +79,19 @@ WlzRegisterICP [-h] [-o<out obj>]
     <td><b>-E</b></td>
     <td>Tolerance in the mean registration metric value.</td>
   </tr>
+  <tr> 
+    <td><b>-f</b></td>
+    <td>Initial fraction of the source vertices matched, range
+        (0.0-1.0]. The fraction is doubled each time the registration
+	converges until all the vertices are used. The default 1.0
+	uses all the vertices in every iteration.</td>
+  </tr>
+  <tr> 
+    <td><b>-T</b></td>
+    <td>Tolerance for the transform update, the iteration ends when
+        no element of the update differs from the identity transform
+	by more than this. The default 0.0 disables this test.</td>
+  </tr>
   <tr> 
     <td><b>-i</b></td>
     <td>Initial affine transform object.</td>
@@ -146,7 +159,9 @@ int             main(int argc, char **argv)
 		ok = 1,
 		usage = 0;
   double	minDistWgt = 0.25,
-  		delta = 0.1;
+  		delta = 0.1,
+		subFrac = 1.0,
+		trTol = 0.0;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   WlzTransformType trType = WLZ_TRANSFORM_2D_REG;
   WlzDomain	outDom;
@@ -159,7 +174,7 @@ int             main(int argc, char **argv)
   		*outObjFileStr;
   char  	*inObjFileStr[2];
   const char	*errMsg;
-  static char	optList[] = "i:o:E:M:gIhart",
+  static char	optList[] = "i:o:E:M:f:T:gIhart",
 		outObjFileStrDef[] = "-",
   		inObjFileStrDef[] = "-";
 
@@ -197,6 +212,21 @@ int             main(int argc, char **argv)
 	  ok = 0;
 	}
 	break;
+      case 'f':
+        if((sscanf(optarg, "%lg", &subFrac) != 1) ||
+	   (subFrac <= 0.0) || (subFrac > 1.0))
+	{
+	  usage = 1;
+	  ok = 0;
+	}
+	break;
+      case 'T':
+        if((sscanf(optarg, "%lg", &trTol) != 1) || (trTol < 0.0))
+	{
+	  usage = 1;
+	  ok = 0;
+	}
+	break;
       case 'i':
         inTrObjFileStr = optarg;
 	break;
@@ -386,14 +416,15 @@ int             main(int argc, char **argv)
 				  inTrObj? inTrObj->domain.t: NULL,
 				  trType, 50.0, 50.0, 1.6,
 				  NULL, NULL, maxItr,
-				  delta, minDistWgt, &errNum);
+				  delta, minDistWgt, subFrac, trTol,
+				  &errNum);
     }
     else
     {
       outDom.t = WlzRegICPObjs(inObj[0], inObj[1],
 			       inTrObj? inTrObj->domain.t: NULL, trType,
 			       NULL, NULL, maxItr, 
-			       delta, minDistWgt, &errNum);
+			       delta, minDistWgt, subFrac, trTol, &errNum);
     }
     if(errNum != WLZ_ERR_NONE)
     {
@@ -457,7 +488,8 @@ int             main(int argc, char **argv)
     "Usage: %s%s%s%sExample: %s%s",
     *argv,
     " [-h] [-o<out obj>]\n"
-    "                      [-E #] [-I] [-M #] [-i <init tr>] [-t] [-r]\n"
+    "                      [-E #] [-I] [-M #] [-f #] [-T #] [-i <init tr>]\n"
+    "                      [-t] [-r]\n"
     "                      [<in obj 0>] [<in obj 1>]\n"
     "Version: ",
     WlzVersion(),
@@ -467,6 +499,12 @@ int             main(int argc, char **argv)
     "  -M  Minimum distance weight, range [0.0-1.0]: Useful values are\n"
     "      0.25 (default) for global matching and 0.0 for local matching.\n"
     "  -E  Tolerance in the mean registration metric value.\n"
+    "  -f  Initial fraction of the source vertices matched, range\n"
+    "      (0.0-1.0]. The fraction is doubled each time the registration\n"
+    "      converges until all the vertices are used (default 1.0).\n"
+    "  -T  Tolerance for the transform update, the iteration ends when\n"
+    "      no element of the update differs from the identity transform\n"
+    "      by more than this, 0.0 disables this test (default 0.0).\n"
     "  -i  Initial affine transform object.\n"
     "  -o  Output file name for affine transform.\n"
     "  -g  Use maximal gradient contours.\n"
@@ -58,6 +58,10 @@ WlzScalarBinaryOp
     <td><b>-b</b></td>
     <td>Operator code.</td>
   </tr>
+  <tr>
+    <td><b>-c</b></td>
+    <td>Clamp values into the range of the grey type.</td>
+  </tr>
   <tr>
     <td><b>-o</b></td>
     <td>Output object file name.</td>
@@ -95,7 +99,7 @@ extern char     *optarg;
 static void usage(char *proc_str)
 {
   (void )fprintf(stderr,
-	  "Usage:\t%s [-b <op>] [-h] [<value>] [<input file>]\n"
+	  "Usage:\t%s [-b <op>] [-c] [-h] [<value>] [<input file>]\n"
 	  "\tApply a scalar binary operation to the grey values of\n"
 	  "\tthe given image with respect to the input value. Note\n"
 	  "\tmost options require an input value.\n"
@@ -119,6 +123,8 @@ static void usage(char *proc_str)
 	  "\t              =  %d - MAX\n"
 	  "\t              =  %d - MIN\n"
 	  "\t              =  %d - MAGNITUDE\n"
+	  "\t  -c       clamp values into the range of the grey type\n"
+	  "\t           rather than casting them\n"
 	  "\t  -h        Help - prints this usage message\n",
 	  proc_str,
 	  WlzVersion(),
@@ -146,8 +152,8 @@ int main(int	argc,
 	 char	**argv)
 {
 
-  char 		optList[] = "b:h";
-  int		option;
+  char 		optList[] = "b:ch";
+  int		option, clamp=0;
   WlzBinaryOperatorType operator = WLZ_BO_ADD;
   FILE		*inFile;
   double	val;
@@ -188,6 +194,10 @@ int main(int	argc,
       }
       break;
 
+    case 'c':
+      clamp = 1;
+      break;
+
     case 'h':
     default:
       usage(argv[0]);
@@ -244,7 +254,12 @@ int main(int	argc,
       WlzFreeObj(obj1);
     }
     else {
-      WlzScalarBinaryOp(obj, pval, obj, operator);
+      if( clamp ){
+	WlzScalarBinaryOpClamp(obj, pval, obj, operator);
+      }
+      else {
+	WlzScalarBinaryOp(obj, pval, obj, operator);
+      }
       WlzWriteObj(stdout, obj);
       WlzFreeObj(obj);
     }
@@ -52,7 +52,7 @@ WlzScalarFnObj - applies a scalar function to the values of a Woolz
 \par Synopsis
 \verbatim
 WlzScalarFnObj [-o<out object>] [-h] 
-		       [-e] [-m] [-l] [-s] [-S]
+		       [-e] [-m] [-l] [-s] [-S] [-p]
 		       [<in object>]
 \endverbatim
 \par Options
@@ -85,6 +85,11 @@ WlzScalarFnObj [-o<out object>] [-h]
     <td><b>-o</b></td>
     <td>File for the output object.</td>
   </tr>
+  <tr> 
+    <td><b>-p</b></td>
+    <td>Stream a 3D object, reading and writing it one plane at a
+        time so that only a few planes are held in memory.</td>
+  </tr>
 </table>
 \par Description
 Applies  scalar function to the values of a Woolz
@@ -126,16 +131,18 @@ int             main(int argc, char **argv)
 {
   int		option,
 		ok = 1,
+		stream = 0,
 		usage = 0;
   WlzObject	*inObj = NULL,
 		*outObj = NULL;
-  FILE		*fP = NULL;
+  FILE		*fP = NULL,
+  		*oFP = NULL;
   WlzFnType	fn = WLZ_FN_SCALAR_MOD;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   char 		*inObjFileStr,
   		*outObjFileStr;
   const char    *errMsg;
-  static char	optList[] = "ehlmsSo:",
+  static char	optList[] = "ehlmpsSo:",
   		inObjFileStrDef[] = "-",
 		outObjFileStrDef[] = "-";
 
@@ -164,6 +171,9 @@ int             main(int argc, char **argv)
       case 'S':
 	fn = WLZ_FN_SCALAR_INVSQRT;
 	break;
+      case 'p':
+        stream = 1;
+	break;
       case 'h':
       default:
         usage = 1;
@@ -189,7 +199,42 @@ int             main(int argc, char **argv)
       inObjFileStr = *(argv + optind);
     }
   }
-  if(ok)
+  if(ok && stream)
+  {
+    if((fP = (strcmp(inObjFileStr, "-")?
+	      fopen(inObjFileStr, "r"): stdin)) == NULL)
+    {
+      ok = 0;
+      (void )fprintf(stderr,
+		     "%s: failed to open input file %s\n",
+		     *argv, inObjFileStr);
+    }
+    else if((oFP = (strcmp(outObjFileStr, "-")?
+		    fopen(outObjFileStr, "w"): stdout)) == NULL)
+    {
+      ok = 0;
+      (void )fprintf(stderr,
+		     "%s: failed to open output file %s\n",
+		     *argv, outObjFileStr);
+    }
+    else if((errNum = WlzPlaneStreamScalarFn(fP, oFP, fn)) != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsg);
+      (void )fprintf(stderr,
+		     "%s: failed to apply scalar function to object (%s).\n",
+		     *argv, errMsg);
+    }
+    if(fP && strcmp(inObjFileStr, "-"))
+    {
+      fclose(fP);
+    }
+    if(oFP && strcmp(outObjFileStr, "-"))
+    {
+      fclose(oFP);
+    }
+  }
+  else if(ok)
   {
     errNum = WLZ_ERR_READ_EOF;
     if((inObjFileStr == NULL) ||
@@ -213,7 +258,7 @@ int             main(int argc, char **argv)
       fP = NULL;
     }
   }
-  if(ok)
+  if(ok && !stream)
   {
     outObj = WlzScalarFn(inObj, fn, &errNum);
     if(errNum != WLZ_ERR_NONE)
@@ -225,7 +270,7 @@ int             main(int argc, char **argv)
 		     *argv, errMsg);
     }
   }
-  if(ok)
+  if(ok && !stream)
   {
     if(errNum == WLZ_ERR_NONE)
     {
@@ -255,7 +300,7 @@ int             main(int argc, char **argv)
     "Usage: %s%s%s%s",
     *argv,
     " [-o<out object>] [-h>]\n"
-    "                  [-e] [-m] [-l]\n"
+    "                  [-e] [-m] [-l] [-s] [-S] [-p]\n"
     "                  [<in object>]\n"
     "Version: ",
     WlzVersion(),
@@ -266,6 +311,7 @@ int             main(int argc, char **argv)
     "  -l  Log function (g_out = log(g_in)).\n"
     "  -s  Square root function (g_out = sqrt(g_in)).\n"
     "  -S  Inverse square root function (g_out = 1.0 / sqrt(g_in)).\n"
+    "  -p  Stream a 3D object through memory a plane at a time.\n"
     "  -o  Output object file name.\n"
     "  -h  Help, prints this usage message.\n"
     "Applies a scalar function to the values of a Woolz object.\n");
@@ -49,7 +49,7 @@ static char _WlzThreshold_c[] = "University of Edinburgh $Id$";
 WlzThreshold - thresholds a grey-level object.
 \par Synopsis
 \verbatim
-WlzThreshold [-h] [-t#] [-v#] [-H] [-L] [-E] [<input object>]
+WlzThreshold [-h] [-t#] [-v#] [-H] [-L] [-E] [-S] [<input object>]
 \endverbatim
 \par Options
 <table width="500" border="0">
@@ -88,6 +88,11 @@ WlzThreshold [-h] [-t#] [-v#] [-H] [-L] [-E] [<input object>]
     <td>Threshold equal,
         keep pixels equal to threshold value.</td>
   </tr>
+  <tr> 
+    <td><b>-S</b></td>
+    <td>Stream a single 3D object, reading and writing it one plane
+        at a time so that only a few planes are held in memory.</td>
+  </tr>
 </table>
 \par Description
 Thresholds a grey-level object writing the new object to the standard output.
@@ -125,7 +130,7 @@ extern char     *optarg;
 static void usage(char *proc_str)
 {
   fprintf(stderr,
-      "Usage:\t%s [-t#] [-v#] [-H] [-L] [-E] [-h] [<input file>]\n"
+      "Usage:\t%s [-t#] [-v#] [-H] [-L] [-E] [-S] [-h] [<input file>]\n"
       "\tThreshold a grey-level woolz object\n"
       "\twriting the new object to standard output\n"
       "Version: %s\n"
@@ -142,6 +147,8 @@ static void usage(char *proc_str)
       "\t                %d: double\n"
       "\t            Note -t option must precede -v\n"
       "\t  -v#       threshold value  - integer unless -t used\n"
+      "\t  -S        stream a single 3D object through memory one\n"
+      "\t            plane at a time\n"
       "\t  -h        Help - prints this usage message\n",
       proc_str,
       WlzVersion(),
@@ -156,8 +163,9 @@ int main(int	argc,
 
   WlzObject	*obj, *nobj;
   FILE		*inFile;
-  char 		optList[] = "HLEht:v:";
-  int		option;
+  char 		optList[] = "HLESht:v:";
+  int		option,
+  		stream = 0;
   WlzThresholdType highLow = WLZ_THRESH_HIGH;
   WlzGreyType	threshpixtype = WLZ_GREY_INT;
   WlzPixelV	thresh;
@@ -230,6 +238,10 @@ int main(int	argc,
       highLow = WLZ_THRESH_EQUAL;
       break;
 
+    case 'S':
+      stream = 1;
+      break;
+
     case 'h':
     default:
       usage(argv[0]);
@@ -247,8 +259,20 @@ int main(int	argc,
     }
   }
 
+  /* stream a single 3D object */
+  if( stream ){
+    if((errNum = WlzPlaneStreamThreshold(inFile, stdout, thresh,
+    					 highLow)) != WLZ_ERR_NONE) {
+      (void )WlzStringFromErrorNum(errNum, &errMsg);
+      (void )fprintf(stderr, "%s: failed to threshold object (%s).\n",
+		     argv[0], errMsg);
+      return(1);
+    }
+  }
+
   /* read objects and threshold if possible */
-  while(((obj = WlzAssignObject(WlzReadObj(inFile, NULL), NULL)) != NULL) &&
+  while((!stream) &&
+        ((obj = WlzAssignObject(WlzReadObj(inFile, NULL), NULL)) != NULL) &&
         (errNum == WLZ_ERR_NONE))
   {
     switch( obj->type )
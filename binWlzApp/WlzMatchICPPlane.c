@@ -948,7 +948,7 @@ int             main(int argc, char **argv)
 			      maxDisp, maxAng, maxDeform,
 			      matchImpNN, matchImpThr,
 			      WlzMatchICPWeightMatches, &cbData,
-			      delta);
+			      delta, 1.0, 0.0);
       if(errNum != WLZ_ERR_NONE)
       {
 	ok = 0;
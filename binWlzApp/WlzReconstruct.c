@@ -52,7 +52,7 @@ WlzReconstruct - reconstructs a 3D object using the information in a
 \par Synopsis
 \verbatim
 WlzReconstruct  [-h] [-o <out obj file>] [-T <out obj fmt>] [-b <out bibfile>]
-                [-f] [-g] [-h] [-i] [-l] [-L] [-p]
+                [-a] [-f] [-g] [-h] [-i] [-l] [-L] [-p] [-q #]
 		[-s #] [-m #] [-c #,#,#] [-C #,#,#] <input bibfile>
                 
 \endverbatim
@@ -79,6 +79,12 @@ WlzReconstruct  [-h] [-o <out obj file>] [-T <out obj fmt>] [-b <out bibfile>]
     <td>o</td>
     <td>Output file name.</td>
   </tr>
+  <tr>
+    <td>a</td>
+    <td>Automatically register the sections before constructing the
+      3D object, registering neighbouring pairs of sections
+      concurrently.</td>
+  </tr>
   <tr>
     <td>f</td>
     <td>Force overwriting of files, without this option confirmation is
@@ -104,6 +110,12 @@ WlzReconstruct  [-h] [-o <out obj file>] [-T <out obj fmt>] [-b <out bibfile>]
     <td>p</td>
     <td>Use fast sampling.</td>
   </tr>
+  <tr>
+    <td>q</td>
+    <td>Maximum number of section images held in memory during
+      automatic registration, the default is two more than twice
+      the number of threads.</td>
+  </tr>
   <tr>
     <td>s</td>
     <td>Scaling factor (eg 0.5 implies half linear dimension of source).</td>
@@ -169,6 +181,8 @@ be overwriten without confirmation.
 
 typedef	struct _WlzRecCmdLnOptions
 {
+  int		autoFlg;
+  int		autoMaxImg;
   int		fastSamFlg;
   int		filterFlg;
   int		forceFlg;
@@ -204,6 +218,13 @@ static	int			WlzRecConfirmFileOverwrite(
 static RecError			WlzRecMakeFilePathAbs(
     				  char **path,
 				  char *file);
+static RecError			WlzRecAutoRegister(
+				  HGUDlpList *secList,
+				  int maxImg,
+				  char **eMsg);
+static void			WlzRecAutoSecFn(
+				  RecSection *sec,
+				  void *data);
 
 extern int      getopt(int argc, char * const *argv, const char *optstring);
 
@@ -224,7 +245,7 @@ int		 main(int argc, char *argv[])
 		*cp1,
 		*cp2,
 		*errMsg;
-  static char	optList[] = "fghilLpb:c:C:m:o:s:T:",
+  static char	optList[] = "afghilLpb:c:C:m:o:q:s:T:",
   		defFile[] = "-",
 		defErrMsg[] = "";
 
@@ -237,6 +258,9 @@ int		 main(int argc, char *argv[])
   {
     switch(option)
     {
+      case 'a':
+	recOptions.autoFlg = 1;
+	break;
       case 'f':
 	recOptions.forceFlg = 1;
 	break;
@@ -271,6 +295,9 @@ int		 main(int argc, char *argv[])
       case 'o':
 	recOptions.objFName = optarg;
 	break;
+      case 'q':
+	usage = sscanf(optarg, "%d", &(recOptions.autoMaxImg)) != 1;
+	break;
       case 's':
 	recOptions.scaleStr = optarg;
 	break;
@@ -415,6 +442,20 @@ int		 main(int argc, char *argv[])
        }
     }
   }
+  if(ok && recOptions.autoFlg)
+  {
+    recErr = WlzRecAutoRegister(secList->list, recOptions.autoMaxImg,
+    				&errMsg);
+    if(recErr != REC_ERR_NONE)
+    {
+      ok = 0;
+      (void )fprintf(stderr,
+                     "%s: Failed to register sections.\n%s%s",
+		     argv[0],
+		     (errMsg && *errMsg)? "Error message - ": "",
+		     (errMsg && *errMsg)? errMsg: "");
+    }
+  }
   if(ok)
   {
     recErr = RecConstruct3DObj(&(secList->reconstruction.obj), secList->list,
@@ -549,7 +590,7 @@ int		 main(int argc, char *argv[])
   {
     (void )fprintf(stderr,
     "Usage: %s [-o <out obj file>] [-T <out obj fmt>] [-b <out bibfile>]\n"
-    "                      [-f] [-g] [-h] [-i] [-l] [-L] [-p]\n"
+    "                      [-a] [-f] [-g] [-h] [-i] [-l] [-L] [-p] [-q #]\n"
     "                      [-s #] [-m #] [-c #,#,#] [-C #,#,#] <in bibfile>\n"
     "Reads a reconstruction bibfile either from the command line or the\n"
     "standard input and constructs a 3D object. The reconstruction process\n"
@@ -563,6 +604,8 @@ int		 main(int argc, char *argv[])
     "  -b  Output bibfile, the default is the same file name as the output\n"
     "      object file name but with a .bib file extension.\n"
     "  -o  Output file name.\n"
+    "  -a  Automatically register the sections before constructing the 3D\n"
+    "      object, registering neighbouring pairs of sections concurrently.\n"
     "  -f  Force overwriting of files, without this option confirmation is\n"
     "      needed.\n"
     "  -g  Use resource greedy algorithms.\n"
@@ -570,6 +613,9 @@ int		 main(int argc, char *argv[])
     "  -i  Use integer scaling.\n"
     "  -l  Use slow but accurate filter when sampling output.\n"
     "  -p  Use fast sampling.\n"
+    "  -q  Maximum number of section images held in memory during automatic\n"
+    "      registration, the default is two more than twice the number of\n"
+    "      threads.\n"
     "  -s  Scaling factor (eg 0.5 implies half linear dimension of source).\n"
     "  -m  Match all section histograms to the section with the given index.\n"
     "  -c  Clip the source (2D sections) using the given bounding box.\n"
@@ -853,4 +899,77 @@ static RecError	WlzRecMakeFilePathAbs(char **path, char *file)
   }
   return(recErr);
 }
+
+/*!
+* \return	Reconstruct error code.
+* \brief	Registers all the non-empty sections of the given list
+*		using RecAutoParallel() with the default registration
+*		parameters. The relative transform of each section is
+*		replaced by that found by registering it with the
+*		previous non-empty section.
+* \param	secList		Section list.
+* \param	maxImg		Maximum number of section images to hold
+*				in memory, if less than two a default is
+*				used.
+* \param	eMsg		Destination pointer for error message.
+*/
+static RecError	WlzRecAutoRegister(HGUDlpList *secList, int maxImg,
+				   char **eMsg)
+{
+  int		cancel = 0;
+  RecSection	*sec0,
+  		*sec1;
+  RecControl	rCtrl;
+  RecPPControl	ppCtrl;
+  RecError	recErr = REC_ERR_NONE;
+
+  sec0 = RecSecNext(secList, NULL, NULL, 1);
+  sec1 = RecSecPrev(secList, NULL, NULL, 1);
+  if((sec0 == NULL) || (sec1 == NULL))
+  {
+    recErr = REC_ERR_LIST;
+  }
+  else if(sec0 != sec1)
+  {
+    rCtrl.method = REC_DEF_METHOD;
+    rCtrl.xLim = REC_DEF_XLIM;
+    rCtrl.yLim = REC_DEF_YLIM;
+    rCtrl.rLim = REC_DEF_RLIM;
+    rCtrl.itLim = REC_DEF_ITLIM;
+    rCtrl.firstIdx = sec0->index;
+    rCtrl.lastIdx = sec1->index;
+    (void )memset(&ppCtrl, 0, sizeof(RecPPControl));
+    ppCtrl.method = REC_DEF_PP;
+    *eMsg = NULL;
+    recErr = RecAutoParallel(&rCtrl, &ppCtrl, secList, &cancel,
+			     WlzRecAutoSecFn, secList, NULL, NULL,
+			     maxImg, eMsg);
+  }
+  return(recErr);
+}
+
+/*!
+* \brief	Section update function for RecAutoParallel() which
+*		replaces the section in the list with a copy of the
+*		registered section.
+* \param	sec		Registered section.
+* \param	data		Section list.
+*/
+static void	WlzRecAutoSecFn(RecSection *sec, void *data)
+{
+  HGUDlpList	*secList;
+  HGUDlpListItem *item;
+  RecSection	*oldSec,
+  		*newSec;
+
+  secList = (HGUDlpList *)data;
+  item = RecSecFindItemIndex(secList, NULL, sec->index,
+  			     HGU_DLPLIST_DIR_TOTAIL);
+  if(item && ((newSec = RecSecDup(sec)) != NULL))
+  {
+    oldSec = (RecSection *)HGUDlpListEntryGet(secList, item);
+    (void )HGUDlpListEntrySet(secList, item, RecSecAssign(newSec));
+    RecSecFree(oldSec);
+  }
+}
 #endif /* DOXYGEN_SHOULD_SKIP_THIS */
@@ -52,7 +52,7 @@ WlzExtFFContourObj - computes a VTK polydata file from a Woolz object.
 \par Synopsis
 \verbatim
 WlzExtFFContourObj  [-h] [-o<output object>] [-f#] [-F#]
-                    [-b] [-g] [-i] [-l] [-L] [-N] [-U]
+                    [-b] [-g] [-i] [-l] [-L] [-N] [-U] [-x]
 		    [-p#] [-s#] [-n#] [-v#] [-w#] [<input object>]
 \endverbatim
 \par Options
@@ -125,12 +125,24 @@ WlzExtFFContourObj  [-h] [-o<output object>] [-f#] [-F#]
     <td><b>-w</b></td>
     <td>Contour (Deriche) gradient operator width.</td>
   </tr>
+  <tr> 
+    <td><b>-x</b></td>
+    <td>Compute a 3D iso-value contour as an indexed triangle mesh
+        and write it directly, without building a geometric model.
+	The output format must be either STL or VTK.</td>
+  </tr>
 </table>
 \par Description
 WlzExtFFContourObj computes a contour object from the given Woolz object and saves it
 using the VTK ascii polydata format.
 See the documentation for WlzContourGeomFilter(1) for an explaination
 of the filter parameters.
+With the -x option a 3D iso-value contour is computed as an indexed
+triangle mesh using WlzContourIsoIdxMesh3D() and is written directly
+by WlzEffWriteIdxMesh3DStl() or WlzEffWriteIdxMesh3DVtk(). This avoids
+building a geometric model, so it is faster and uses less memory for
+large surfaces, but the geometry filter, normal and orientation options
+can not be used with it.
 The input object is read from stdin and output data are written
 to stdout unless filenames are given.
 \par Examples
@@ -174,7 +186,8 @@ int             main(int argc, char **argv)
 		nItr = 10,
 		nonMan = 0,
 		unitVoxelSz = 0,
-		filterGeom = 0;
+		filterGeom = 0,
+		idxMesh = 0;
   double	lambda,
   		mu,
   		ctrVal = 100,
@@ -187,6 +200,7 @@ int             main(int argc, char **argv)
   		*outObjFileStr;
   WlzObject     *inObj = NULL,
   		*outObj = NULL;
+  WlzIdxMesh3D	*mesh = NULL;
   WlzDomain	ctrDom;
   WlzValues	dumVal;
   WlzEffFormat  inFmt = WLZEFF_FORMAT_NONE,
@@ -196,7 +210,7 @@ int             main(int argc, char **argv)
   const double	filterDPB = 0.25,
   		filterDSB = 0.10;
   const char	*errMsgStr;
-  static char	optList[] = "bfghilmFLNUo:p:s:n:v:w:";
+  static char	optList[] = "bf:ghilmxF:LNUo:p:s:n:v:w:";
   const char	outFileStrDef[] = "-",
   		inObjFileStrDef[] = "-";
 
@@ -290,6 +304,9 @@ int             main(int argc, char **argv)
 	  ok = 0;
 	}
 	break;
+      case 'x':
+        idxMesh = 1;
+	break;
       default:
         usage = 1;
 	ok = 0;
@@ -346,6 +363,16 @@ int             main(int argc, char **argv)
       usage = 1;
       ok = 0;
     }
+    /* An indexed mesh is only computed for iso-value contours and can
+     * only be written as STL or VTK without any filtering. */
+    if(idxMesh &&
+       ((ctrMtd != WLZ_CONTOUR_MTD_ISO) ||
+        ((outFmt != WLZEFF_FORMAT_STL) && (outFmt != WLZEFF_FORMAT_VTK)) ||
+	flip || nrm || filterGeom))
+    {
+      usage = 1;
+      ok = 0;
+    }
   }
   if(ok)
   {
@@ -383,7 +410,43 @@ int             main(int argc, char **argv)
       inObj->domain.p->voxel_size[2] = 1.0;
     } 
   }
-  if(ok)
+  if(ok && idxMesh)
+  {
+    FILE	*oFP = NULL;
+
+    mesh = WlzContourIsoIdxMesh3D(inObj, ctrVal, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if(strcmp(outObjFileStr, "-") == 0)
+      {
+        oFP = stdout;
+      }
+      else if((oFP = fopen(outObjFileStr, "w")) == NULL)
+      {
+        errNum = WLZ_ERR_WRITE_EOF;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = (outFmt == WLZEFF_FORMAT_STL)?
+               WlzEffWriteIdxMesh3DStl(oFP, mesh):
+	       WlzEffWriteIdxMesh3DVtk(oFP, mesh);
+    }
+    if(oFP && (oFP != stdout))
+    {
+      (void )fclose(oFP);
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+      		     "%s: Failed to compute or write indexed mesh (%s).\n",
+      	     	     argv[0], errMsgStr);
+    }
+    (void )WlzFreeIdxMesh3D(mesh);
+  }
+  if(ok && !idxMesh)
   {
     ctrDom.ctr = WlzContourObj(inObj, ctrMtd, ctrVal, ctrWth, nrm, &errNum);
     if(errNum != WLZ_ERR_NONE)
@@ -413,7 +476,7 @@ int             main(int argc, char **argv)
       		     argv[0], errMsgStr);
     }
   }
-  if(ok)
+  if(ok && !idxMesh)
   {
     outObj = WlzMakeMain(WLZ_CONTOUR, ctrDom, dumVal, NULL, NULL, &errNum);
     if(errNum != WLZ_ERR_NONE)
@@ -440,7 +503,7 @@ int             main(int argc, char **argv)
       }
     }
   }
-  if(ok)
+  if(ok && !idxMesh)
   {
     if(strcmp(outObjFileStr, "-") == 0)
     {
@@ -453,7 +516,7 @@ int             main(int argc, char **argv)
       fStr = outObjFileStr;
     }
   }
-  if(ok)
+  if(ok && !idxMesh)
   {
     errNum = WlzEffWriteObj(fP, fStr, outObj, outFmt);
     if(errNum != WLZ_ERR_NONE)
@@ -491,7 +554,8 @@ int             main(int argc, char **argv)
     "Usage: %s%s%s%sExample: %s%s%s%s%s",
     *argv,
     " [-h] [-o<output object>] [-b] [-g] [-i] [-l]\n"
-    "                          [-L] [-N] [-U] [-p#] [-s#] [-n#] [-v#] [-w#]\n"
+    "                          [-L] [-N] [-U] [-x] [-p#] [-s#] [-n#] [-v#]\n"
+    "                          [-w#]\n"
     "                          [<input object>]\n"
     "Version: ",
     WlzVersion(),
@@ -513,7 +577,10 @@ int             main(int argc, char **argv)
     "  -p  Geometry filter low band value.\n"
     "  -s  Geometry filter stop band value.\n"
     "  -v  Contour iso-value or minimum gradient.\n"
-    "  -w  Contour (Deriche) gradient operator width.\n",
+    "  -w  Contour (Deriche) gradient operator width.\n"
+    "  -x  Compute a 3D iso-value contour as an indexed triangle mesh and\n"
+    "      write it directly, the output format must be STL or VTK. The\n"
+    "      -l, -L and -m options can not be used with this option.\n",
     "The known file formats are:\n"
     "  Description                                       Extension\n"
     "  ***********                                       *********\n",
@@ -0,0 +1,234 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzExtFFTstReadTiff_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzExtFF/WlzExtFFTstReadTiff.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Benchmark for reading (multi-page) TIFF images.
+* 		Reports the time taken by WlzEffReadObjTiff() to read
+* 		the given file and the resulting throughput in pages
+* 		and decoded megabytes per second. The number of threads
+* 		used to decode the pages of a TIFF stack may be set so
+* 		that the scaling of the reader can be measured.
+* \ingroup	BinWlzExtFF
+*/
+
+#include <sys/time.h>
+#include <stdio.h>
+#include <string.h>
+#include <Wlz.h>
+#include <WlzExtFF.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern char	*optarg;
+extern int	optind,
+		opterr,
+		optopt;
+
+static double			WlzExtFFTstReadTiffTime(
+				  struct timeval *t0,
+				  struct timeval *t1);
+
+int		main(int argc, char *argv[])
+{
+  int		idx,
+  		option,
+  		ok = 1,
+		usage = 0,
+		nThr = 1,
+		nPln = 1,
+		nRep = 1;
+  size_t	gSz = 0,
+  		fSz = 0,
+		nVal = 0;
+  double	tObj = 0.0;
+  FILE		*fP = NULL;
+  WlzObject	*obj = NULL;
+  WlzGreyType	gType = WLZ_GREY_ERROR;
+  struct timeval times[2];
+  char		*inFileStr;
+  const char	*errMsg;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char	optList[] = "hn:t:";
+
+  opterr = 0;
+  inFileStr = NULL;
+#ifdef _OPENMP
+  nThr = omp_get_max_threads();
+#endif
+  while(ok && ((option = getopt(argc, argv, optList)) != -1))
+  {
+    switch(option)
+    {
+      case 'n':
+        if((sscanf(optarg, "%d", &nRep) != 1) || (nRep < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 't':
+        if((sscanf(optarg, "%d", &nThr) != 1) || (nThr < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if((usage == 0) && ((optind + 1) != argc))
+  {
+    usage = 1;
+  }
+  ok = !usage;
+  if(ok)
+  {
+    inFileStr = *(argv + optind);
+    if((fP = fopen(inFileStr, "r")) == NULL)
+    {
+      ok = 0;
+      (void )fprintf(stderr, "%s: Failed to open file %s.\n",
+                     *argv, inFileStr);
+    }
+    else
+    {
+      (void )fseek(fP, 0, SEEK_END);
+      fSz = ftell(fP);
+      (void )fclose(fP);
+    }
+  }
+  if(ok)
+  {
+#ifdef _OPENMP
+    omp_set_num_threads(nThr);
+#else
+    nThr = 1;
+#endif
+    gettimeofday(times + 0, NULL);
+    for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nRep); ++idx)
+    {
+      (void )WlzFreeObj(obj);
+      obj = WlzAssignObject(WlzEffReadObjTiff(inFileStr, 0, &errNum), NULL);
+    }
+    gettimeofday(times + 1, NULL);
+    tObj = WlzExtFFTstReadTiffTime(times + 0, times + 1) / nRep;
+    if(errNum == WLZ_ERR_NONE)
+    {
+      switch(obj->type)
+      {
+        case WLZ_2D_DOMAINOBJ:
+	  nVal = WlzArea(obj, &errNum);
+	  break;
+        case WLZ_3D_DOMAINOBJ:
+	  nPln = obj->domain.p->lastpl - obj->domain.p->plane1 + 1;
+	  nVal = WlzVolume(obj, &errNum);
+	  break;
+	default:
+	  errNum = WLZ_ERR_OBJECT_TYPE;
+	  break;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      gType = WlzGreyTypeFromObj(obj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      gSz = WlzGreySize(gType);
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsg);
+      (void )fprintf(stderr,
+                     "%s: Failed to read TIFF image from file %s (%s).\n",
+		     *argv, inFileStr, errMsg);
+    }
+  }
+  if(ok)
+  {
+    (void )printf("file                  %s\n"
+                  "file size (bytes)     %ld\n"
+		  "pages                 %d\n"
+		  "grey values           %ld\n"
+		  "grey size (bytes)     %d\n"
+		  "threads               %d\n"
+		  "object read (s)       %g\n"
+		  "pages read (1/s)      %g\n"
+		  "file read (MB/s)      %g\n"
+		  "decoded (MB/s)        %g\n",
+		  inFileStr, (long )fSz, nPln, (long )nVal, (int )gSz, nThr,
+		  tObj, nPln / tObj,
+		  fSz / (1.0e6 * tObj),
+		  (nVal * gSz) / (1.0e6 * tObj));
+  }
+  (void )WlzFreeObj(obj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s%s",
+    *argv,
+    " [-h] [-n #] [-t #] <input TIFF file>\n"
+    "Benchmark for reading (multi-page) TIFF images using\n"
+    "WlzEffReadObjTiff(). The pages of a TIFF stack are decoded in\n"
+    "parallel when built with OpenMP.\n"
+    "Options:\n"
+    "  -h  Prints this usage information.\n"
+    "  -n  Number of repeats.\n"
+    "  -t  Number of threads (defaults to the OpenMP maximum).\n");
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Time between the given times in seconds.
+* \ingroup	BinWlzExtFF
+* \brief	Computes the difference between the given times.
+* \param	t0			Start time.
+* \param	t1			End time.
+*/
+static double	WlzExtFFTstReadTiffTime(struct timeval *t0, struct timeval *t1)
+{
+  struct timeval t2;
+
+  ALC_TIMERSUB(t1, t0, &t2);
+  return(t2.tv_sec + (0.000001 * t2.tv_usec));
+}
@@ -0,0 +1,367 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstContourIdxMesh_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstContourIdxMesh.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test program for WlzContourIsoIdxMesh3D() which checks
+* 		that the indexed triangle mesh has the same triangles as
+* 		the geometric model computed by WlzContourObj().
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <Wlz.h>
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern char     *optarg;
+extern int      optind,
+		opterr,
+		optopt;
+
+static int			WlzTstContourIdxMeshCmp(
+				  const void *t0,
+				  const void *t1);
+static void			WlzTstContourIdxMeshTri(
+				  double *dst,
+				  WlzDVertex3 *vtx);
+static WlzObject		*WlzTstContourIdxMeshObj(
+				  int sz,
+				  int nLvl,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		idF,
+  		idT,
+  		option,
+		nFce = 0,
+		nLvl = 4,
+		sz = 24,
+		ok = 1,
+		verbose = 0,
+		usage = 0;
+  double	isoVal = 1.0;
+  double	*fceTri = NULL,
+  		*mshTri = NULL;
+  FILE		*fP = NULL;
+  char		*iFileStr = NULL;
+  const char	*errMsgStr;
+  WlzObject	*iObj = NULL;
+  WlzContour	*ctr = NULL;
+  WlzIdxMesh3D	*mesh = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "i:l:s:hv";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'i':
+        usage = (sscanf(optarg, "%lg", &isoVal) != 1);
+	break;
+      case 'l':
+        usage = (sscanf(optarg, "%d", &nLvl) != 1) || (nLvl < 2);
+	break;
+      case 's':
+        usage = (sscanf(optarg, "%d", &sz) != 1) || (sz < 2);
+	break;
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if((usage == 0) && (optind < argc))
+  {
+    if((optind + 1) != argc)
+    {
+      usage = 1;
+    }
+    else
+    {
+      iFileStr = *(argv + optind);
+    }
+  }
+  ok = usage == 0;
+  if(ok)
+  {
+    if(iFileStr)
+    {
+      if((*iFileStr == '\0') ||
+	 ((fP = (strcmp(iFileStr, "-")?
+	         fopen(iFileStr, "r"): stdin)) == NULL) ||
+	 ((iObj = WlzAssignObject(WlzReadObj(fP, &errNum), NULL)) == NULL))
+      {
+	ok = 0;
+	(void )fprintf(stderr,
+		       "%s: Failed to read object from file (%s)\n",
+		       *argv, iFileStr);
+      }
+      if(fP && strcmp(iFileStr, "-"))
+      {
+	(void )fclose(fP);
+      }
+    }
+    else
+    {
+      iObj = WlzAssignObject(WlzTstContourIdxMeshObj(sz, nLvl, &errNum),
+      			     NULL);
+    }
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    mesh = WlzContourIsoIdxMesh3D(iObj, isoVal, &errNum);
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    ctr = WlzContourObj(iObj, WLZ_CONTOUR_MTD_ISO, isoVal, 1.0, 0, &errNum);
+  }
+  /* Collect the triangles of the model's faces and of the mesh, each
+   * as its three vertices in sorted order. */
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    if(((fceTri = (double *)AlcMalloc(sizeof(double) * 9 *
+    				      (ctr->model->res.face.numIdx + 1))) ==
+				      NULL) ||
+       ((mshTri = (double *)AlcMalloc(sizeof(double) * 9 *
+       				      (mesh->nTri + 1))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    WlzGMFace	*fce;
+    WlzDVertex3	vtx[3];
+
+    for(idF = 0; (errNum == WLZ_ERR_NONE) &&
+                 (idF < ctr->model->res.face.numIdx); ++idF)
+    {
+      fce = (WlzGMFace *)AlcVectorItemGet(ctr->model->res.face.vec, idF);
+      if(fce->idx >= 0)
+      {
+	errNum = WlzGMFaceGetG3D(fce, vtx + 0, vtx + 1, vtx + 2);
+	WlzTstContourIdxMeshTri(fceTri + (9 * nFce++), vtx);
+      }
+    }
+    for(idT = 0; idT < mesh->nTri; ++idT)
+    {
+      for(idF = 0; idF < 3; ++idF)
+      {
+        vtx[idF] = mesh->vtx[mesh->tri[(3 * idT) + idF]];
+      }
+      WlzTstContourIdxMeshTri(mshTri + (9 * idT), vtx);
+    }
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    int		same;
+
+    same = nFce == mesh->nTri;
+    if(same)
+    {
+      qsort(fceTri, nFce, sizeof(double) * 9, WlzTstContourIdxMeshCmp);
+      qsort(mshTri, nFce, sizeof(double) * 9, WlzTstContourIdxMeshCmp);
+      for(idT = 0; same && (idT < nFce); ++idT)
+      {
+        same = WlzTstContourIdxMeshCmp(fceTri + (9 * idT),
+				       mshTri + (9 * idT)) == 0;
+      }
+    }
+    if(verbose)
+    {
+      (void )printf("model faces %d, mesh vertices %d, mesh triangles %d\n",
+                    nFce, mesh->nVtx, mesh->nTri);
+    }
+    ok = same;
+    (void )printf("%s: %s\n", *argv, (ok)? "passed": "failed");
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    ok = 0;
+    (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+    (void )fprintf(stderr,
+		   "%s: Failed to compute iso-surface (%s).\n",
+		   argv[0],
+		   errMsgStr);
+  }
+  AlcFree(fceTri);
+  AlcFree(mshTri);
+  if(ctr)
+  {
+    (void )WlzFreeContour(ctr);
+  }
+  if(mesh)
+  {
+    (void )WlzFreeIdxMesh3D(mesh);
+  }
+  (void )WlzFreeObj(iObj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-i#] [-l#] [-s#] [-v] [<input object>]\n"
+    "Computes an iso-surface as an indexed triangle mesh using\n"
+    "WlzContourIsoIdxMesh3D() and as a geometric model using\n"
+    "WlzContourObj() and checks that both have the same triangles.\n"
+    "If no input object is given a cube of random integer values\n"
+    "is used, so that the iso-value is hit exactly by many voxels.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -i  Iso-value (default %g).\n"
+    "  -l  Number of distinct random values (default %d).\n"
+    "  -s  Size of the random cube (default %d).\n"
+    "  -v  Verbose output.\n",
+    argv[0], isoVal, nLvl, sz);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Comparison value for qsort().
+* \ingroup	BinWlzTst
+* \brief	Compares two triangles, each given as nine doubles.
+* \param	t0			First triangle.
+* \param	t1			Second triangle.
+*/
+static int	WlzTstContourIdxMeshCmp(const void *t0, const void *t1)
+{
+  int		idx,
+  		cmp = 0;
+  const double	*d0,
+  		*d1;
+
+  d0 = (const double *)t0;
+  d1 = (const double *)t1;
+  for(idx = 0; (cmp == 0) && (idx < 9); ++idx)
+  {
+    cmp = (d0[idx] < d1[idx])? -1: (d0[idx] > d1[idx]);
+  }
+  return(cmp);
+}
+
+/*!
+* \ingroup	BinWlzTst
+* \brief	Sets the nine doubles of a triangle from its three
+* 		vertices, rounding the vertex positions and sorting the
+* 		vertices so that equal triangles compare equal.
+* \param	dst			Destination for the nine doubles.
+* \param	vtx			The three vertices.
+*/
+static void	WlzTstContourIdxMeshTri(double *dst, WlzDVertex3 *vtx)
+{
+  int		idx,
+  		idy;
+  double	tmp[3];
+
+  for(idx = 0; idx < 3; ++idx)
+  {
+    dst[(3 * idx) + 0] = floor((vtx[idx].vtX * 1.0e6) + 0.5);
+    dst[(3 * idx) + 1] = floor((vtx[idx].vtY * 1.0e6) + 0.5);
+    dst[(3 * idx) + 2] = floor((vtx[idx].vtZ * 1.0e6) + 0.5);
+  }
+  for(idx = 1; idx < 3; ++idx)
+  {
+    for(idy = idx; (idy > 0) &&
+                   (WlzTstContourIdxMeshCmp(dst + (3 * idy),
+		                            dst + (3 * (idy - 1))) < 0); --idy)
+    {
+      (void )memcpy(tmp, dst + (3 * idy), sizeof(double) * 3);
+      (void )memcpy(dst + (3 * idy), dst + (3 * (idy - 1)),
+                    sizeof(double) * 3);
+      (void )memcpy(dst + (3 * (idy - 1)), tmp, sizeof(double) * 3);
+    }
+  }
+}
+
+/*!
+* \return	New object or NULL on error.
+* \ingroup	BinWlzTst
+* \brief	Creates a cube of random integer values in the range
+* 		[0, nLvl - 1].
+* \param	sz			Size of the cube.
+* \param	nLvl			Number of distinct values.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzTstContourIdxMeshObj(int sz, int nLvl,
+					  WlzErrorNum *dstErr)
+{
+  int		idX,
+  		idY,
+		idZ;
+  WlzPixelV	bgdV;
+  WlzObject	*obj = NULL;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bgdV.type = WLZ_GREY_INT;
+  bgdV.v.inv = 0;
+  obj = WlzMakeCuboid(0, sz - 1, 0, sz - 1, 0, sz - 1, WLZ_GREY_INT, bgdV,
+  		      NULL, NULL, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    srand48(0);
+    for(idZ = 0; idZ < sz; ++idZ)
+    {
+      for(idY = 0; idY < sz; ++idY)
+      {
+	for(idX = 0; idX < sz; ++idX)
+	{
+	  WlzGreyValueGet(gVWSp, idZ, idY, idX);
+	  *(gVWSp->gPtr[0].inp) = (int )(drand48() * nLvl);
+	}
+      }
+    }
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(obj);
+    obj = NULL;
+  }
+  *dstErr = errNum;
+  return(obj);
+}
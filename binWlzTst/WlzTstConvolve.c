@@ -0,0 +1,422 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstConvolve_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstConvolve.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Tests and times the methods of WlzConvolveObjKernel()
+*		by comparing the separable and FFT convolutions with
+*		the direct convolution.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+#include <Wlz.h>
+
+static double			WlzTstConvolveMaxDiff(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+				  double *dstMaxVal,
+				  WlzErrorNum *dstErr);
+static double			WlzTstConvolveTime(
+				  struct timeval *t0,
+				  struct timeval *t1);
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern char     *optarg;
+extern int      optind,
+		opterr,
+		optopt;
+
+int		main(int argc, char *argv[])
+{
+  int		idM,
+  		idx,
+		option,
+		nK = 0,
+		ok = 1,
+		timeFlg = 0,
+		dblFlg = 0,
+		intFlg = 0,
+		usage = 0;
+  double	sigma = 0.0,
+  		tol = 1.0e-6;
+  double	diff[4],
+  		tm[4];
+  double	*krn = NULL;
+  FILE		*fP = NULL;
+  char		*iFileStr;
+  const char	*errMsgStr;
+  WlzIVertex3	kSz;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  WlzObject	*iObj = NULL,
+  		*dObj = NULL;
+  WlzObject	*cObj[4];
+  struct timeval times[2];
+  static char   optList[] = "g:k:e:dth";
+  const char    defFile[] = "-";
+  const char	*methodStr[4] = {"auto", "direct", "separable", "fft"};
+  const WlzConvolveMethod method[4] = {WLZ_CONVOLVE_METHOD_AUTO,
+  				       WLZ_CONVOLVE_METHOD_DIRECT,
+				       WLZ_CONVOLVE_METHOD_SEPARABLE,
+				       WLZ_CONVOLVE_METHOD_FFT};
+
+  opterr = 0;
+  kSz.vtX = kSz.vtY = 5;
+  kSz.vtZ = 1;
+  iFileStr = (char *)defFile;
+  for(idM = 0; idM < 4; ++idM)
+  {
+    cObj[idM] = NULL;
+    diff[idM] = tm[idM] = 0.0;
+  }
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'g':
+        if(sscanf(optarg, "%lg", &sigma) != 1)
+	{
+	  usage = 1;
+	}
+	break;
+      case 'k':
+        if(sscanf(optarg, "%d,%d,%d", &(kSz.vtX), &(kSz.vtY),
+		  &(kSz.vtZ)) != 3)
+	{
+	  usage = 1;
+	}
+	break;
+      case 'e':
+        if(sscanf(optarg, "%lg", &tol) != 1)
+	{
+	  usage = 1;
+	}
+	break;
+      case 'd':
+        dblFlg = 1;
+	break;
+      case 't':
+        timeFlg = 1;
+	break;
+      case 'h':
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if(usage == 0)
+  {
+    if((kSz.vtX < 1) || (kSz.vtY < 1) || (kSz.vtZ < 1))
+    {
+      usage = 1;
+    }
+    if((usage == 0) && (optind < argc))
+    {
+      if((optind + 1) != argc)
+      {
+        usage = 1;
+      }
+      else
+      {
+        iFileStr = *(argv + optind);
+      }
+    }
+  }
+  ok = usage == 0;
+  if(ok)
+  {
+    if((iFileStr == NULL) ||
+       (*iFileStr == '\0') ||
+       ((fP = (strcmp(iFileStr, "-")? fopen(iFileStr, "r"): stdin)) == NULL) ||
+       ((iObj = WlzAssignObject(WlzReadObj(fP, &errNum), NULL)) == NULL) ||
+       (errNum != WLZ_ERR_NONE))
+    {
+      ok = 0;
+      (void )fprintf(stderr,
+                     "%s: Failed to read object from file (%s)\n",
+                     *argv, iFileStr);
+    }
+    if(fP && strcmp(iFileStr, "-"))
+    {
+      (void )fclose(fP); fP = NULL;
+    }
+  }
+  if(ok)
+  {
+    /* Build either a separable Gaussian kernel or a kernel of random
+     * integers which is very unlikely to be separable. */
+    nK = kSz.vtX * kSz.vtY * kSz.vtZ;
+    if((krn = (double *)AlcMalloc(sizeof(double) * nK)) == NULL)
+    {
+      ok = 0;
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else if(sigma > 0.0)
+    {
+      int	idX,
+      		idY,
+		idZ;
+      double	s;
+
+      idx = 0;
+      s = -0.5 / (sigma * sigma);
+      for(idZ = 0; idZ < kSz.vtZ; ++idZ)
+      {
+	for(idY = 0; idY < kSz.vtY; ++idY)
+	{
+	  for(idX = 0; idX < kSz.vtX; ++idX)
+	  {
+	    WlzIVertex3 d;
+
+	    d.vtX = idX - ((kSz.vtX - 1) / 2);
+	    d.vtY = idY - ((kSz.vtY - 1) / 2);
+	    d.vtZ = idZ - ((kSz.vtZ - 1) / 2);
+	    krn[idx++] = exp(s * ((d.vtX * d.vtX) + (d.vtY * d.vtY) +
+	                          (d.vtZ * d.vtZ)));
+	  }
+	}
+      }
+    }
+    else
+    {
+      srand48(0);
+      for(idx = 0; idx < nK; ++idx)
+      {
+        krn[idx] = (int )(drand48() * 9.0) - 4;
+      }
+    }
+  }
+  if(ok)
+  {
+    /* Convolve the input object with its own grey type unless asked to
+     * convert it to double. */
+    if(dblFlg)
+    {
+      dObj = WlzAssignObject(
+	     WlzConvertPix(iObj, WLZ_GREY_DOUBLE, &errNum), NULL);
+    }
+    else
+    {
+      dObj = WlzAssignObject(iObj, NULL);
+    }
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    switch(WlzGreyTypeFromObj(dObj, &errNum))
+    {
+      case WLZ_GREY_INT:   /* FALLTHROUGH */
+      case WLZ_GREY_SHORT: /* FALLTHROUGH */
+      case WLZ_GREY_UBYTE:
+        intFlg = 1;
+	break;
+      default:
+        break;
+    }
+  }
+  for(idM = 0; ok && (errNum == WLZ_ERR_NONE) && (idM < 4); ++idM)
+  {
+    gettimeofday(times + 0, NULL);
+    cObj[idM] = WlzAssignObject(
+    		WlzConvolveObjKernel(dObj, kSz, krn, method[idM], 1,
+				     &errNum), NULL);
+    gettimeofday(times + 1, NULL);
+    tm[idM] = WlzTstConvolveTime(times + 0, times + 1);
+  }
+  if(ok && (errNum == WLZ_ERR_NONE))
+  {
+    double	maxVal = 0.0;
+
+    for(idM = 0; (errNum == WLZ_ERR_NONE) && (idM < 4); ++idM)
+    {
+      diff[idM] = WlzTstConvolveMaxDiff(cObj[1], cObj[idM], &maxVal,
+      					&errNum);
+    }
+    for(idM = 0; (errNum == WLZ_ERR_NONE) && (idM < 4); ++idM)
+    {
+      /* Integer values may differ by one after rounding. */
+      if(diff[idM] > tol * (1.0 + maxVal) + intFlg)
+      {
+        ok = 0;
+      }
+      (void )printf("%-10s max diff %g", methodStr[idM], diff[idM]);
+      if(timeFlg)
+      {
+        (void )printf(" time %gs", tm[idM]);
+      }
+      (void )printf("\n");
+    }
+    if(ok == 0)
+    {
+      (void )fprintf(stderr,
+                     "%s: Convolution methods differ by more than %g.\n",
+		     argv[0], tol);
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    ok = 0;
+    (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+    (void )fprintf(stderr,
+		   "%s: Failed to convolve object (%s).\n",
+		   argv[0],
+		   errMsgStr);
+  }
+  for(idM = 0; idM < 4; ++idM)
+  {
+    (void )WlzFreeObj(cObj[idM]);
+  }
+  (void )WlzFreeObj(dObj);
+  (void )WlzFreeObj(iObj);
+  AlcFree(krn);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-d] [-e#] [-g#] [-k#,#,#] [-t] [<input object>]\n"
+    "Convolves the input 2D or 3D object using each of the methods of\n"
+    "WlzConvolveObjKernel() and compares the results with those of the\n"
+    "direct method.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -d  Convert the input object to double before convolving it,\n"
+    "      otherwise its grey type is kept.\n"
+    "  -e  Tolerance for the differences relative to the maximum\n"
+    "      convolved value (default %g).\n"
+    "  -g  Use a (separable) Gaussian kernel with the given sigma rather\n"
+    "      than a kernel of random integers.\n"
+    "  -k  Kernel size (default 5,5,1).\n"
+    "  -t  Print the time taken by each method.\n",
+    argv[0], tol);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Maximum absolute difference between the values.
+* \ingroup	BinWlzTst
+* \brief	Computes the maximum absolute difference between the
+*		values of two objects with the same domain.
+* \param	obj0			First object.
+* \param	obj1			Second object.
+* \param	dstMaxVal		Destination pointer for the maximum
+*					absolute value of the first object,
+*					which is only updated if greater.
+* \param	dstErr			Destination error pointer.
+*/
+static double	WlzTstConvolveMaxDiff(WlzObject *obj0, WlzObject *obj1,
+				      double *dstMaxVal, WlzErrorNum *dstErr)
+{
+  int		idX,
+  		idY,
+		idZ;
+  double	d,
+		maxDiff = 0.0;
+  WlzIBox3	bBox;
+  WlzGreyValueWSpace *gVWSp0 = NULL,
+  		*gVWSp1 = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bBox = WlzBoundingBox3I(obj0, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp0 = WlzGreyValueMakeWSp(obj0, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp1 = WlzGreyValueMakeWSp(obj1, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(obj0->type == WLZ_2D_DOMAINOBJ)
+    {
+      bBox.zMin = bBox.zMax = 0;
+    }
+    for(idZ = bBox.zMin; idZ <= bBox.zMax; ++idZ)
+    {
+      for(idY = bBox.yMin; idY <= bBox.yMax; ++idY)
+      {
+	for(idX = bBox.xMin; idX <= bBox.xMax; ++idX)
+	{
+	  if(WlzInsideDomain(obj0, idZ, idY, idX, NULL))
+	  {
+	    WlzPixelV	p0,
+	    		p1;
+
+	    WlzGreyValueGet(gVWSp0, idZ, idY, idX);
+	    WlzGreyValueGet(gVWSp1, idZ, idY, idX);
+	    p0.type = gVWSp0->gType;
+	    p0.v = gVWSp0->gVal[0];
+	    p1.type = gVWSp1->gType;
+	    p1.v = gVWSp1->gVal[0];
+	    (void )WlzValueConvertPixel(&p0, p0, WLZ_GREY_DOUBLE);
+	    (void )WlzValueConvertPixel(&p1, p1, WLZ_GREY_DOUBLE);
+	    d = fabs(p0.v.dbv - p1.v.dbv);
+	    if(d > maxDiff)
+	    {
+	      maxDiff = d;
+	    }
+	    if(fabs(p0.v.dbv) > *dstMaxVal)
+	    {
+	      *dstMaxVal = fabs(p0.v.dbv);
+	    }
+	  }
+	}
+      }
+    }
+  }
+  WlzGreyValueFreeWSp(gVWSp0);
+  WlzGreyValueFreeWSp(gVWSp1);
+  *dstErr = errNum;
+  return(maxDiff);
+}
+
+/*!
+* \return	Time difference in seconds.
+* \ingroup	BinWlzTst
+* \brief	Computes the time difference between two times.
+* \param	t0			First time.
+* \param	t1			Second time.
+*/
+static double	WlzTstConvolveTime(struct timeval *t0, struct timeval *t1)
+{
+  struct timeval t2;
+
+  ALC_TIMERSUB(t1, t0, &t2);
+  return(t2.tv_sec + (0.000001 * t2.tv_usec));
+}
@@ -0,0 +1,434 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstDistEuclidean_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstDistEuclidean.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test program for the exact Euclidean distance transform
+* 		of WlzDistanceTransform(). The distances of 3D and 2D
+* 		objects are compared with those found by brute force.
+* 		Both the 3D foreground and reference objects have an
+* 		empty plane in the middle.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#include <Wlz.h>
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern char     *optarg;
+extern int      optind,
+		opterr,
+		optopt;
+
+/*!
+* \def		WLZ_TST_DISTEUCLIDEAN_NPLN
+* \ingroup	BinWlzTst
+* \brief	Number of planes in the 3D test objects.
+*/
+#define WLZ_TST_DISTEUCLIDEAN_NPLN	(11)
+
+static WlzObject		*WlzTstDistEuclideanObj(
+				  int ref,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzTstDistEuclideanPos(
+				  WlzIVertex3 *pos,
+				  int *nPos,
+				  int pln,
+				  WlzDomain dom);
+static int			WlzTstDistEuclideanCmp(
+				  WlzObject *dstObj,
+				  WlzObject *refObj,
+				  int verbose,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		idx,
+  		option,
+		nBad = 0,
+  		ok = 1,
+		verbose = 0,
+		usage = 0;
+  WlzObject	*forObj[2],
+  		*refObj[2],
+		*dstObj[2];
+  WlzValues	nullVal;
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hv";
+
+  opterr = 0;
+  nullVal.core = NULL;
+  for(idx = 0; idx < 2; ++idx)
+  {
+    forObj[idx] = refObj[idx] = dstObj[idx] = NULL;
+  }
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if(optind != argc)
+  {
+    usage = 1;
+  }
+  ok = !usage;
+  /* Make the 3D objects and 2D objects from one of their planes. */
+  if(ok)
+  {
+    forObj[0] = WlzAssignObject(WlzTstDistEuclideanObj(0, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      refObj[0] = WlzAssignObject(WlzTstDistEuclideanObj(1, &errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      forObj[1] = WlzAssignObject(
+      		  WlzMakeMain(WLZ_2D_DOMAINOBJ,
+			      forObj[0]->domain.p->domains[2], nullVal,
+			      NULL, NULL, &errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      refObj[1] = WlzAssignObject(
+      		  WlzMakeMain(WLZ_2D_DOMAINOBJ,
+			      refObj[0]->domain.p->domains[2], nullVal,
+			      NULL, NULL, &errNum), NULL);
+    }
+    for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < 2); ++idx)
+    {
+      dstObj[idx] = WlzAssignObject(
+      		    WlzDistanceTransform(forObj[idx], refObj[idx],
+		    			 WLZ_EUCLIDEAN_DISTANCE, 0.0,
+					 &errNum), NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        nBad += WlzTstDistEuclideanCmp(dstObj[idx], refObj[idx],
+				       verbose, &errNum);
+      }
+    }
+    /* The empty plane of the foreground object must still be empty. */
+    if(errNum == WLZ_ERR_NONE)
+    {
+      idx = WLZ_TST_DISTEUCLIDEAN_NPLN / 2;
+      if((dstObj[0]->domain.p->domains[idx].core != NULL) ||
+         (dstObj[0]->values.vox->values[idx].core != NULL))
+      {
+        ++nBad;
+	if(verbose)
+	{
+	  (void )printf("empty plane %d has a domain or values\n", idx);
+	}
+      }
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+                     "%s: Failed to compute distances (%s).\n",
+		     *argv, errMsgStr);
+    }
+    else
+    {
+      ok = nBad == 0;
+      (void )printf("%s: %s\n", *argv, (ok)? "passed": "failed");
+    }
+  }
+  for(idx = 0; idx < 2; ++idx)
+  {
+    (void )WlzFreeObj(forObj[idx]);
+    (void )WlzFreeObj(refObj[idx]);
+    (void )WlzFreeObj(dstObj[idx]);
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v]\n"
+    "Computes exact Euclidean distances using WlzDistanceTransform()\n"
+    "for 3D foreground and reference objects, which both have an empty\n"
+    "plane in the middle, and for 2D objects made from one of their\n"
+    "planes. The test passes if all the distances are the same as\n"
+    "those found by brute force and the empty plane remains empty.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output.\n",
+    argv[0]);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	New 3D domain object with no values.
+* \ingroup	BinWlzTst
+* \brief	Makes a 3D test object. The foreground object has the
+* 		same rectangle on all planes, apart from the middle plane
+* 		which is empty. The reference object has small rectangles
+* 		on some planes, including consecutive planes and a plane
+* 		beyond those of the foreground object, but none on the
+* 		middle plane.
+* \param	ref			Make the reference object if non-zero.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzTstDistEuclideanObj(int ref, WlzErrorNum *dstErr)
+{
+  int		idx,
+  		nRect;
+  WlzDomain	dom;
+  WlzValues	nullVal;
+  WlzObject	*obj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  /* Plane, first line, last line, first column and last column. */
+  const int	forRect[5] = {0, 3, 28, -4, 30};
+  const int	refRect[][5] = {{1,  5,  7,  2,  4},
+  				{2,  6,  9,  3,  5},
+				{3, 20, 21, 22, 27},
+				{8,  1,  1, 25, 25},
+				{9, 14, 16, -2,  0},
+				{13, 30, 31, 10, 11}};
+
+  nullVal.core = NULL;
+  nRect = (ref)? sizeof(refRect) / sizeof(refRect[0]):
+                 WLZ_TST_DISTEUCLIDEAN_NPLN;
+  dom.p = (ref)?
+	  WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
+			     refRect[0][0], refRect[nRect - 1][0],
+			     1, 31, -2, 27, &errNum):
+	  WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
+	  		     0, WLZ_TST_DISTEUCLIDEAN_NPLN - 1,
+			     forRect[1], forRect[2], forRect[3], forRect[4],
+			     &errNum);
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nRect); ++idx)
+  {
+    const int	*r;
+    WlzDomain	dom2;
+
+    r = (ref)? refRect[idx]: forRect;
+    if(ref || (idx != WLZ_TST_DISTEUCLIDEAN_NPLN / 2))
+    {
+      dom2.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_RECT,
+				     r[1], r[2], r[3], r[4], &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	dom.p->domains[((ref)? r[0]: idx) - dom.p->plane1] =
+	    WlzAssignDomain(dom2, NULL);
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    obj = WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, nullVal, NULL, NULL, &errNum);
+  }
+  else if(dom.p)
+  {
+    (void )WlzFreePlaneDomain(dom.p);
+  }
+  *dstErr = errNum;
+  return(obj);
+}
+
+/*!
+* \return	Number of distances which differ from those found by
+* 		brute force.
+* \ingroup	BinWlzTst
+* \brief	Compares the distances of the given distance object with
+* 		the rounded Euclidean distances to the nearest position
+* 		of the reference object, found by brute force.
+* \param	dstObj			Given distance object.
+* \param	refObj			Given reference object.
+* \param	verbose			Print differences if non-zero.
+* \param	dstErr			Destination error pointer.
+*/
+static int	WlzTstDistEuclideanCmp(WlzObject *dstObj, WlzObject *refObj,
+				       int verbose, WlzErrorNum *dstErr)
+{
+  int		nBad = 0,
+  		nRef = 0,
+		nVal = 0;
+  WlzIVertex3	*refPos = NULL;
+  WlzIterateWSpace *itWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  /* Collect the reference positions. */
+  nRef = (refObj->type == WLZ_2D_DOMAINOBJ)?
+	 WlzArea(refObj, &errNum): WlzVolume(refObj, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((refPos = (WlzIVertex3 *)
+                 AlcMalloc(sizeof(WlzIVertex3) * (nRef + 1))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    nRef = 0;
+    if(refObj->type == WLZ_2D_DOMAINOBJ)
+    {
+      errNum = WlzTstDistEuclideanPos(refPos, &nRef, 0, refObj->domain);
+    }
+    else
+    {
+      int	idP;
+      WlzPlaneDomain *pDom;
+
+      pDom = refObj->domain.p;
+      for(idP = pDom->plane1; (errNum == WLZ_ERR_NONE) &&
+                              (idP <= pDom->lastpl); ++idP)
+      {
+        errNum = WlzTstDistEuclideanPos(refPos, &nRef, idP,
+					pDom->domains[idP - pDom->plane1]);
+      }
+    }
+  }
+  /* Compare the distances. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    itWSp = WlzIterateInit(dstObj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+    {
+      int	idx,
+      		dist;
+      double	d,
+      		dMin;
+      WlzIVertex3 p;
+
+      dMin = DBL_MAX;
+      p = itWSp->pos;
+      for(idx = 0; idx < nRef; ++idx)
+      {
+        d = ((double )(p.vtX - refPos[idx].vtX) * (p.vtX - refPos[idx].vtX)) +
+	    ((double )(p.vtY - refPos[idx].vtY) * (p.vtY - refPos[idx].vtY)) +
+	    ((double )(p.vtZ - refPos[idx].vtZ) * (p.vtZ - refPos[idx].vtZ));
+	if(d < dMin)
+	{
+	  dMin = d;
+	}
+      }
+      dist = WLZ_NINT(sqrt(dMin));
+      if(*(itWSp->gP.inp) != dist)
+      {
+        ++nBad;
+	if(verbose)
+	{
+	  (void )printf("%d %d %d distance %d, brute force %d\n",
+	                p.vtX, p.vtY, p.vtZ, *(itWSp->gP.inp), dist);
+	}
+      }
+      ++nVal;
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+    WlzIterateWSpFree(itWSp);
+  }
+  if(verbose)
+  {
+    (void )printf("%dD: reference positions %d, distances %d, "
+                  "differences %d\n",
+		  (dstObj->type == WLZ_2D_DOMAINOBJ)? 2: 3,
+		  nRef, nVal, nBad);
+  }
+  AlcFree(refPos);
+  *dstErr = errNum;
+  return(nBad);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Appends the positions within the given 2D domain to
+* 		the given array of positions.
+* \param	pos			Array of positions.
+* \param	nPos			Number of positions in the array,
+* 					updated on return.
+* \param	pln			Plane coordinate of the domain.
+* \param	dom			Given 2D domain, may be empty.
+*/
+static WlzErrorNum WlzTstDistEuclideanPos(WlzIVertex3 *pos, int *nPos,
+					  int pln, WlzDomain dom)
+{
+  int		idK;
+  WlzObject	*obj;
+  WlzValues	nullVal;
+  WlzIntervalWSpace iWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nullVal.core = NULL;
+  if(dom.core != NULL)
+  {
+    obj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, nullVal, NULL, NULL, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzInitRasterScan(obj, &iWSp, WLZ_RASTERDIR_ILIC);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      while((errNum = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE)
+      {
+	for(idK = iWSp.lftpos; idK <= iWSp.rgtpos; ++idK)
+	{
+	  pos[*nPos].vtX = idK;
+	  pos[*nPos].vtY = iWSp.linpos;
+	  pos[*nPos].vtZ = pln;
+	  ++*nPos;
+	}
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+	errNum = WLZ_ERR_NONE;
+      }
+    }
+    (void )WlzFreeObj(obj);
+  }
+  return(errNum);
+}
@@ -0,0 +1,325 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstFourier_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstFourier.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test program for WlzFourierTransformObj() using 2D and
+* 		3D objects with sizes which are not powers of two. The
+* 		test checks that the transformed objects are padded
+* 		to the sizes given by AlgFFTGoodSize() and that the
+* 		inverse transform of the forward transform recovers
+* 		the given values, scaled by the number of values
+* 		transformed.
+* \ingroup 	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <Wlz.h>
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+
+static WlzObject		*WlzTstFourierMake(
+				  WlzIVertex3 sz,
+				  WlzErrorNum *dstErr);
+static double			WlzTstFourierVal(
+				  int x,
+				  int y,
+				  int z);
+static int			WlzTstFourierCheck(
+				  WlzIVertex3 sz,
+				  int verbose,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		option,
+		verbose = 0,
+  		ok = 1,
+  		usage = 0;
+  WlzIVertex3	sz;
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hv";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if(optind != argc)
+  {
+    usage = 1;
+  }
+  ok = !usage;
+  if(ok)
+  {
+    /* A 2D object of 60 x 45 and a 3D object of 30 x 21 x 11. */
+    WLZ_VTX_3_SET(sz, 60, 45, 0);
+    ok = WlzTstFourierCheck(sz, verbose, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WLZ_VTX_3_SET(sz, 30, 21, 11);
+      ok = WlzTstFourierCheck(sz, verbose, &errNum) && ok;
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr, "%s: Error - %s.\n", *argv, errMsgStr);
+    }
+    (void )printf("%s: %s\n", *argv, (ok)? "passed": "failed");
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v]\n"
+    "Computes the forward and inverse Fourier transforms of a 60 x 45\n"
+    "2D object and a 30 x 21 x 11 3D object. The test passes if the\n"
+    "transforms are padded to the sizes given by AlgFFTGoodSize() and\n"
+    "the inverse transforms recover the given values, scaled by the\n"
+    "number of values transformed.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output.\n",
+    argv[0]);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Non-zero if the check passes.
+* \ingroup	BinWlzTst
+* \brief	Makes an object of the given size, transforms it forward
+* 		and back, then checks the size of the transform and the
+* 		recovered values.
+* \param	sz			Size of the object, with zero depth
+* 					for a 2D object.
+* \param	verbose			Non-zero for verbose output.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static int	WlzTstFourierCheck(WlzIVertex3 sz, int verbose,
+				   WlzErrorNum *dstErr)
+{
+  int		x,
+		y,
+		z,
+		ok = 0,
+		dim;
+  double	scale,
+  		maxErr = 0.0;
+  WlzIVertex3	oSz,
+  		gSz,
+		off;
+  WlzIBox3	bBox;
+  WlzObject	*obj = NULL,
+  		*fObj = NULL,
+		*rObj = NULL;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dim = (sz.vtZ > 0)? 3: 2;
+  obj = WlzTstFourierMake(sz, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    fObj = WlzAssignObject(WlzFourierTransformObj(obj, 1, &errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rObj = WlzAssignObject(WlzFourierTransformObj(fObj, 0, &errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bBox = WlzBoundingBox3I(fObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    oSz.vtX = bBox.xMax - bBox.xMin + 1;
+    oSz.vtY = bBox.yMax - bBox.yMin + 1;
+    oSz.vtZ = (dim == 3)? bBox.zMax - bBox.zMin + 1: 0;
+    gSz.vtX = AlgFFTGoodSize(sz.vtX, 1);
+    gSz.vtY = AlgFFTGoodSize(sz.vtY, 1);
+    gSz.vtZ = (dim == 3)? AlgFFTGoodSize(sz.vtZ, 1): 0;
+    /* The given values are centred in the padded transform. */
+    off.vtX = (gSz.vtX - sz.vtX) / 2;
+    off.vtY = (gSz.vtY - sz.vtY) / 2;
+    off.vtZ = (gSz.vtZ - sz.vtZ) / 2;
+    scale = (double )(gSz.vtX) * gSz.vtY * ALG_MAX(gSz.vtZ, 1);
+    gVWSp = WlzGreyValueMakeWSp(rObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(z = 0; z < ALG_MAX(sz.vtZ, 1); ++z)
+    {
+      for(y = 0; y < sz.vtY; ++y)
+      {
+	for(x = 0; x < sz.vtX; ++x)
+	{
+	  double d;
+
+	  WlzGreyValueGet(gVWSp, z + off.vtZ, y + off.vtY, x + off.vtX);
+	  d = fabs((gVWSp->gVal[0].dbv / scale) - WlzTstFourierVal(x, y, z));
+	  maxErr = ALG_MAX(maxErr, d);
+	}
+      }
+    }
+    ok = (oSz.vtX == gSz.vtX) && (oSz.vtY == gSz.vtY) &&
+	 (oSz.vtZ == gSz.vtZ) && (maxErr < 1.0e-6);
+    if(verbose)
+    {
+      (void )printf("%dD size %d %d %d, transform size %d %d %d "
+		    "(expected %d %d %d), maximum error %g\n",
+		    dim, sz.vtX, sz.vtY, sz.vtZ,
+		    oSz.vtX, oSz.vtY, oSz.vtZ,
+		    gSz.vtX, gSz.vtY, gSz.vtZ, maxErr);
+    }
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  (void )WlzFreeObj(obj);
+  (void )WlzFreeObj(fObj);
+  (void )WlzFreeObj(rObj);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(ok);
+}
+
+/*!
+* \return	New object or NULL on error.
+* \ingroup	BinWlzTst
+* \brief	Makes a rectangular 2D or cuboid 3D object with its
+* 		origin at zero and double values given by
+* 		WlzTstFourierVal().
+* \param	sz			Size of the object, with zero depth
+* 					for a 2D object.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzTstFourierMake(WlzIVertex3 sz, WlzErrorNum *dstErr)
+{
+  int		x,
+		y,
+		z;
+  double	*buf;
+  WlzObject	*obj = NULL;
+  WlzPixelV	bgd;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bgd.type = WLZ_GREY_DOUBLE;
+  bgd.v.dbv = 0.0;
+  if(sz.vtZ > 0)
+  {
+    obj = WlzMakeCuboid(0, sz.vtZ - 1, 0, sz.vtY - 1, 0, sz.vtX - 1,
+			WLZ_GREY_DOUBLE, bgd, NULL, NULL, &errNum);
+  }
+  else if((buf = (double *)AlcMalloc(sizeof(double) *
+                                      sz.vtX * sz.vtY)) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    obj = WlzMakeRect(0, sz.vtY - 1, 0, sz.vtX - 1, WLZ_GREY_DOUBLE,
+		      (int *)buf, bgd, NULL, NULL, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      obj->values.r->freeptr = AlcFreeStackPush(obj->values.r->freeptr,
+						buf, NULL);
+    }
+    else
+    {
+      AlcFree(buf);
+    }
+  }
+  obj = WlzAssignObject(obj, NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(z = 0; z < ALG_MAX(sz.vtZ, 1); ++z)
+    {
+      for(y = 0; y < sz.vtY; ++y)
+      {
+	for(x = 0; x < sz.vtX; ++x)
+	{
+	  WlzGreyValueGet(gVWSp, z, y, x);
+	  *(gVWSp->gPtr[0].dbp) = WlzTstFourierVal(x, y, z);
+	}
+      }
+    }
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(obj);
+    obj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj);
+}
+
+/*!
+* \return	Value at the given position.
+* \ingroup	BinWlzTst
+* \brief	Computes the value of the test objects at the given
+* 		position.
+* \param	x			Column coordinate.
+* \param	y			Line coordinate.
+* \param	z			Plane coordinate.
+*/
+static double	WlzTstFourierVal(int x, int y, int z)
+{
+  return((double )(((x * 7) + (y * 13) + (z * 29)) % 31) - 15.0);
+}
@@ -0,0 +1,300 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstLabelUF_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstLabelUF.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test program which compares the components of a random
+* 		3D domain found by WlzLabelUF() with those found by
+* 		WlzLabel(), for both 4- and 8-connectivity and with one
+* 		or more threads, so that the union-find labeller joins
+* 		blocks of planes.
+* \ingroup 	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Wlz.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+
+static WlzObject		*WlzTstLabelUFMake(
+				  WlzErrorNum *dstErr);
+static int			WlzTstLabelUFCheck(
+				  WlzObject *obj,
+				  WlzConnectType connect,
+				  int verbose,
+				  WlzErrorNum *dstErr);
+static int			WlzTstLabelUFCmp(
+				  const void *p0,
+				  const void *p1);
+
+int		main(int argc, char *argv[])
+{
+  int		idT,
+  		option,
+		verbose = 0,
+  		ok = 1,
+  		usage = 0;
+  WlzObject	*obj = NULL;
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hv";
+  const int	nThr[2] = {1, 4};
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if(optind != argc)
+  {
+    usage = 1;
+  }
+  ok = !usage;
+  if(ok)
+  {
+    obj = WlzAssignObject(WlzTstLabelUFMake(&errNum), NULL);
+    for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < 2); ++idT)
+    {
+#ifdef _OPENMP
+      omp_set_num_threads(nThr[idT]);
+#endif
+      if(verbose)
+      {
+        (void )printf("threads %d\n", nThr[idT]);
+      }
+      ok = WlzTstLabelUFCheck(obj, WLZ_4_CONNECTED, verbose, &errNum) && ok;
+      if(errNum == WLZ_ERR_NONE)
+      {
+	ok = WlzTstLabelUFCheck(obj, WLZ_8_CONNECTED, verbose, &errNum) && ok;
+      }
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr, "%s: Error - %s.\n", *argv, errMsgStr);
+    }
+    (void )printf("%s: %s\n", *argv, (ok)? "passed": "failed");
+  }
+  (void )WlzFreeObj(obj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v]\n"
+    "Labels a random 3D domain using WlzLabel() and WlzLabelUF() with\n"
+    "4- and 8-connectivity, using first one and then four threads. The\n"
+    "test passes if both functions find the same number of components\n"
+    "with the same volumes.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output.\n",
+    argv[0]);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Non-zero if the check passes.
+* \ingroup	BinWlzTst
+* \brief	Labels the given object using both WlzLabel() and
+* 		WlzLabelUF() then compares the sorted volumes of the
+* 		components found.
+* \param	obj			Given object.
+* \param	connect			Connectivity.
+* \param	verbose			Non-zero for verbose output.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static int	WlzTstLabelUFCheck(WlzObject *obj, WlzConnectType connect,
+				   int verbose, WlzErrorNum *dstErr)
+{
+  int		idx,
+  		ok = 0;
+  int		nObj[2];
+  WlzLong	*vol[2];
+  WlzObject	**objs[2];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nObj[0] = nObj[1] = 0;
+  objs[0] = objs[1] = NULL;
+  vol[0] = vol[1] = NULL;
+  errNum = WlzLabel(obj, &(nObj[0]), &(objs[0]), 100000, 0, connect);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzLabelUF(obj, &(nObj[1]), &(objs[1]), 0, connect);
+  }
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < 2); ++idx)
+  {
+    if((vol[idx] = (WlzLong *)
+                   AlcMalloc(sizeof(WlzLong) * (nObj[idx] + 1))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      int	idO;
+
+      for(idO = 0; (errNum == WLZ_ERR_NONE) && (idO < nObj[idx]); ++idO)
+      {
+        vol[idx][idO] = WlzVolume(objs[idx][idO], &errNum);
+      }
+      qsort(vol[idx], nObj[idx], sizeof(WlzLong), WlzTstLabelUFCmp);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    ok = nObj[0] == nObj[1];
+    for(idx = 0; ok && (idx < nObj[0]); ++idx)
+    {
+      ok = vol[0][idx] == vol[1][idx];
+    }
+    if(verbose)
+    {
+      (void )printf("%d-connected, WlzLabel %d components, "
+                    "WlzLabelUF %d components, %s\n",
+		    (connect == WLZ_4_CONNECTED)? 4: 8, nObj[0], nObj[1],
+		    (ok)? "same": "different");
+    }
+  }
+  for(idx = 0; idx < 2; ++idx)
+  {
+    if(objs[idx])
+    {
+      int	idO;
+
+      for(idO = 0; idO < nObj[idx]; ++idO)
+      {
+        (void )WlzFreeObj(objs[idx][idO]);
+      }
+      AlcFree(objs[idx]);
+    }
+    AlcFree(vol[idx]);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(ok);
+}
+
+/*!
+* \return	New object or NULL on error.
+* \ingroup	BinWlzTst
+* \brief	Makes a 3D domain object by thresholding a 48 x 40 x 24
+* 		cuboid of uniform random values so that about a third of
+* 		the voxels are kept. The domain has many components,
+* 		some of which are only connected diagonally.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzTstLabelUFMake(WlzErrorNum *dstErr)
+{
+  int		x,
+		y,
+		z;
+  WlzObject	*obj = NULL,
+  		*tObj = NULL;
+  WlzPixelV	bgd,
+  		thr;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bgd.type = WLZ_GREY_UBYTE;
+  bgd.v.ubv = 0;
+  obj = WlzAssignObject(
+	WlzMakeCuboid(0, 23, 0, 39, 0, 47, WLZ_GREY_UBYTE, bgd,
+		      NULL, NULL, &errNum), NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    AlgRandSeed(340);
+    for(z = 0; z < 24; ++z)
+    {
+      for(y = 0; y < 40; ++y)
+      {
+	for(x = 0; x < 48; ++x)
+	{
+	  WlzGreyValueGet(gVWSp, z, y, x);
+	  *(gVWSp->gPtr[0].ubp) = (WlzUByte )(AlgRandUniform() * 255.0);
+	}
+      }
+    }
+    thr.type = WLZ_GREY_UBYTE;
+    thr.v.ubv = 170;
+    tObj = WlzThreshold(obj, thr, WLZ_THRESH_HIGH, &errNum);
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  (void )WlzFreeObj(obj);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tObj);
+}
+
+/*!
+* \return	Sorting order.
+* \ingroup	BinWlzTst
+* \brief	Compares two volumes for qsort().
+* \param	p0			First volume.
+* \param	p1			Second volume.
+*/
+static int	WlzTstLabelUFCmp(const void *p0, const void *p1)
+{
+  WlzLong	v0,
+  		v1;
+
+  v0 = *(const WlzLong *)p0;
+  v1 = *(const WlzLong *)p1;
+  return((v0 < v1)? -1: (v0 > v1)? 1: 0);
+}
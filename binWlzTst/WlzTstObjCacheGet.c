@@ -0,0 +1,361 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstObjCacheGet_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstObjCacheGet.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test program for WlzObjectCacheGet() which checks that
+* 		an object is re-read when its file is rewritten and that
+* 		the cache then holds a single entry for the file which
+* 		returns the fresh object. Rewrites which only change the
+* 		sub-second part of the modification time, or only the size
+* 		of the file, must also be detected.
+* \ingroup 	BinWlzTst
+*/
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <Wlz.h>
+
+/*!
+* \def		WLZ_TST_OBJCACHEGET_NPAR
+* \ingroup	BinWlzTst
+* \brief	Number of concurrent gets after the file is rewritten.
+*/
+#define WLZ_TST_OBJCACHEGET_NPAR	(64)
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+
+static WlzErrorNum		WlzTstObjCacheGetWrite(
+				  const char *path,
+				  int val,
+				  int sz,
+				  time_t mtime,
+				  long usec);
+static int			WlzTstObjCacheGetVal(
+				  WlzObject *obj);
+
+int		main(int argc, char *argv[])
+{
+  int		idx,
+  		fd,
+  		option,
+		verbose = 0,
+  		ok = 1,
+  		usage = 0;
+  int		nBadPar = 0,
+  		valUs = 0,
+		valSz = 0;
+  unsigned int	nItem = 0,
+  		nItemPar = 0;
+  WlzLong	hits = 0,
+  		misses = 0;
+  time_t	now;
+  WlzObject	*obj[3];
+  WlzObjectCache *cache = NULL;
+  char		path[] = "/tmp/WlzTstObjCacheGetXXXXXX";
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hv";
+
+  opterr = 0;
+  obj[0] = obj[1] = obj[2] = NULL;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if(optind != argc)
+  {
+    usage = 1;
+  }
+  ok = !usage;
+  if(ok)
+  {
+    if((fd = mkstemp(path)) < 0)
+    {
+      ok = 0;
+      (void )fprintf(stderr, "%s: Failed to create temporary file.\n",
+                     *argv);
+    }
+    else
+    {
+      (void )close(fd);
+    }
+  }
+  if(ok)
+  {
+    /* Read the first version of the file, then rewrite it with a new
+     * modification time and read it twice more. */
+    now = time(NULL);
+    cache = WlzObjectCacheNew(4, 0, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzTstObjCacheGetWrite(path, 1, 4, now - 10, 0);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      obj[0] = WlzObjectCacheGet(cache, path, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzTstObjCacheGetWrite(path, 2, 4, now, 0);
+    }
+    for(idx = 1; (errNum == WLZ_ERR_NONE) && (idx < 3); ++idx)
+    {
+      obj[idx] = WlzObjectCacheGet(cache, path, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzObjectCacheStats(cache, &hits, &misses, NULL,
+                                   &nItem, NULL);
+    }
+    /* Rewrite the file again and get it concurrently so that threads
+     * may race to replace the cached object. */
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzTstObjCacheGetWrite(path, 3, 4, now + 10, 0);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for(idx = 0; idx < WLZ_TST_OBJCACHEGET_NPAR; ++idx)
+      {
+	WlzObject *pObj;
+	WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	pObj = WlzObjectCacheGet(cache, path, &errNum2);
+	if(WlzTstObjCacheGetVal(pObj) != 3)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzTstObjCacheGet)
+#endif
+	  ++nBadPar;
+	}
+	(void )WlzFreeObj(pObj);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzTstObjCacheGet)
+#endif
+	  errNum = errNum2;
+	}
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzObjectCacheStats(cache, NULL, NULL, NULL, &nItemPar, NULL);
+    }
+    /* Rewrite the file with the same size and modification time in
+     * seconds, but a different sub-second part. */
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzTstObjCacheGetWrite(path, 4, 4, now + 10, 500000);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzObject *tObj;
+
+      tObj = WlzObjectCacheGet(cache, path, &errNum);
+      valUs = WlzTstObjCacheGetVal(tObj);
+      (void )WlzFreeObj(tObj);
+    }
+    /* Rewrite the file with a different size but the same modification
+     * time. */
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzTstObjCacheGetWrite(path, 5, 5, now + 10, 500000);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzObject *tObj;
+
+      tObj = WlzObjectCacheGet(cache, path, &errNum);
+      valSz = WlzTstObjCacheGetVal(tObj);
+      (void )WlzFreeObj(tObj);
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr, "%s: Error - %s.\n", *argv, errMsgStr);
+    }
+  }
+  if(ok)
+  {
+    if(verbose)
+    {
+      (void )printf("values %d %d %d, hits %ld, misses %ld, items %u\n"
+                    "concurrent gets %d, stale %d, items %u\n"
+		    "sub-second rewrite %d, size rewrite %d\n",
+                    WlzTstObjCacheGetVal(obj[0]),
+                    WlzTstObjCacheGetVal(obj[1]),
+                    WlzTstObjCacheGetVal(obj[2]),
+		    (long )hits, (long )misses, nItem,
+		    WLZ_TST_OBJCACHEGET_NPAR, nBadPar, nItemPar,
+		    valUs, valSz);
+    }
+    ok = (WlzTstObjCacheGetVal(obj[0]) == 1) &&
+         (WlzTstObjCacheGetVal(obj[1]) == 2) &&
+	 (obj[2] == obj[1]) &&
+	 (hits == 1) && (misses == 2) && (nItem == 1) &&
+	 (nBadPar == 0) && (nItemPar == 1) &&
+	 (valUs == 4) && (valSz == 5);
+    (void )printf("%s: %s\n", *argv, (ok)? "passed": "failed");
+  }
+  for(idx = 0; idx < 3; ++idx)
+  {
+    (void )WlzFreeObj(obj[idx]);
+  }
+  if(cache)
+  {
+    (void )WlzObjectCacheFree(cache);
+  }
+  if(!usage)
+  {
+    (void )unlink(path);
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v]\n"
+    "Writes an object to a temporary file and gets it from an object\n"
+    "cache. The file is then rewritten with a new object and the object\n"
+    "got from the cache twice more. The file is rewritten again and got\n"
+    "concurrently. Finally the file is rewritten changing only the\n"
+    "sub-second part of its modification time and then only its size.\n"
+    "The test passes if the fresh object is always returned and the\n"
+    "cache holds a single entry for the file.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output.\n",
+    argv[0]);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Writes a small square object with the given value to the
+* 		given file and sets the file's modification time.
+* \param	path			File path.
+* \param	val			Value for all pixels of the object.
+* \param	sz			Width and height of the object, at
+* 					most 5.
+* \param	mtime			Modification time for the file.
+* \param	usec			Microseconds of the modification time.
+*/
+static WlzErrorNum WlzTstObjCacheGetWrite(const char *path, int val, int sz,
+					  time_t mtime, long usec)
+{
+  int		idx;
+  int		vals[25];
+  FILE		*fP;
+  WlzObject	*obj;
+  WlzPixelV	bgd;
+  struct timeval tBuf[2];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  for(idx = 0; idx < 25; ++idx)
+  {
+    vals[idx] = val;
+  }
+  bgd.type = WLZ_GREY_INT;
+  bgd.v.inv = 0;
+  obj = WlzMakeRect(0, sz - 1, 0, sz - 1, WLZ_GREY_INT, vals, bgd,
+  		    NULL, NULL, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((fP = fopen(path, "w")) == NULL)
+    {
+      errNum = WLZ_ERR_FILE_OPEN;
+    }
+    else
+    {
+      errNum = WlzWriteObj(fP, obj);
+      (void )fclose(fP);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tBuf[0].tv_sec = tBuf[1].tv_sec = mtime;
+    tBuf[0].tv_usec = tBuf[1].tv_usec = usec;
+    if(utimes(path, tBuf) != 0)
+    {
+      errNum = WLZ_ERR_FILE_OPEN;
+    }
+  }
+  (void )WlzFreeObj(obj);
+  return(errNum);
+}
+
+/*!
+* \return	Value of the first pixel of the object or -1 on error.
+* \ingroup	BinWlzTst
+* \brief	Gets the value of the first pixel of the given object.
+* \param	obj			Given object.
+*/
+static int	WlzTstObjCacheGetVal(WlzObject *obj)
+{
+  int		val = -1;
+  WlzGreyValueWSpace *gVWSp;
+
+  if(obj && ((gVWSp = WlzGreyValueMakeWSp(obj, NULL)) != NULL))
+  {
+    WlzGreyValueGet(gVWSp, 0, 0, 0);
+    val = gVWSp->gVal[0].inv;
+    WlzGreyValueFreeWSp(gVWSp);
+  }
+  return(val);
+}
@@ -0,0 +1,289 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstPlaneStream_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstPlaneStream.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test program which compares the objects given by
+* 		WlzPlaneStreamThreshold() with those given by
+* 		WlzThreshold() for thresholds which keep some, all
+* 		and none of the voxels of a 3D object.
+* \ingroup 	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Wlz.h>
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+
+static WlzObject		*WlzTstPlaneStreamMake(
+				  WlzErrorNum *dstErr);
+static int			WlzTstPlaneStreamCheck(
+				  WlzObject *obj,
+				  int thr,
+				  int verbose,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		idT,
+  		option,
+		verbose = 0,
+  		ok = 1,
+  		usage = 0;
+  WlzObject	*obj = NULL;
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hv";
+  const int	thr[3] = {100, 0, 1000};
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if(optind != argc)
+  {
+    usage = 1;
+  }
+  ok = !usage;
+  if(ok)
+  {
+    obj = WlzAssignObject(WlzTstPlaneStreamMake(&errNum), NULL);
+    for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < 3); ++idT)
+    {
+      ok = WlzTstPlaneStreamCheck(obj, thr[idT], verbose, &errNum) && ok;
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr, "%s: Error - %s.\n", *argv, errMsgStr);
+    }
+    (void )printf("%s: %s\n", *argv, (ok)? "passed": "failed");
+  }
+  (void )WlzFreeObj(obj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v]\n"
+    "Thresholds a 3D object at 100, 0 and 1000, both as a whole object\n"
+    "using WlzThreshold() and one plane at a time using\n"
+    "WlzPlaneStreamThreshold(). The test passes if the objects have the\n"
+    "same type, bounds, non-empty planes and volume.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output.\n",
+    argv[0]);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Non-zero if the check passes.
+* \ingroup	BinWlzTst
+* \brief	Thresholds the given object (keeping values at or above
+* 		the threshold) using both WlzThreshold() and
+* 		WlzPlaneStreamThreshold(), then compares the objects.
+* \param	obj			Given object.
+* \param	thr			Threshold value.
+* \param	verbose			Non-zero for verbose output.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static int	WlzTstPlaneStreamCheck(WlzObject *obj, int thr, int verbose,
+				       WlzErrorNum *dstErr)
+{
+  int		idx,
+  		idP,
+  		ok = 0;
+  int		nPl[2];
+  WlzLong	vol[2];
+  FILE		*fP[2];
+  WlzObject	*tObj[2];
+  WlzPixelV	thrV;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  fP[0] = fP[1] = NULL;
+  tObj[0] = tObj[1] = NULL;
+  thrV.type = WLZ_GREY_INT;
+  thrV.v.inv = thr;
+  tObj[0] = WlzAssignObject(
+  	    WlzThreshold(obj, thrV, WLZ_THRESH_HIGH, &errNum), NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(((fP[0] = tmpfile()) == NULL) || ((fP[1] = tmpfile()) == NULL))
+    {
+      errNum = WLZ_ERR_FILE_OPEN;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzWriteObj(fP[0], obj);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rewind(fP[0]);
+    errNum = WlzPlaneStreamThreshold(fP[0], fP[1], thrV, WLZ_THRESH_HIGH);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rewind(fP[1]);
+    tObj[1] = WlzAssignObject(WlzReadObj(fP[1], &errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    ok = (tObj[0]->type == WLZ_3D_DOMAINOBJ) &&
+         (tObj[1]->type == WLZ_3D_DOMAINOBJ);
+    for(idx = 0; ok && (idx < 2); ++idx)
+    {
+      WlzPlaneDomain *pDom;
+
+      pDom = tObj[idx]->domain.p;
+      nPl[idx] = 0;
+      for(idP = 0; idP <= pDom->lastpl - pDom->plane1; ++idP)
+      {
+        if(pDom->domains[idP].core != NULL)
+	{
+	  ++(nPl[idx]);
+	}
+      }
+      vol[idx] = WlzVolume(tObj[idx], &errNum);
+      ok = errNum == WLZ_ERR_NONE;
+    }
+    if(ok)
+    {
+      WlzPlaneDomain *pDom0,
+      		*pDom1;
+
+      pDom0 = tObj[0]->domain.p;
+      pDom1 = tObj[1]->domain.p;
+      ok = (pDom0->plane1 == pDom1->plane1) &&
+	   (pDom0->lastpl == pDom1->lastpl) &&
+	   (pDom0->line1 == pDom1->line1) &&
+	   (pDom0->lastln == pDom1->lastln) &&
+	   (pDom0->kol1 == pDom1->kol1) &&
+	   (pDom0->lastkl == pDom1->lastkl) &&
+	   (nPl[0] == nPl[1]) && (vol[0] == vol[1]);
+    }
+    if(verbose)
+    {
+      (void )printf("threshold %d, %s\n", thr, (ok)? "same": "different");
+    }
+  }
+  for(idx = 0; idx < 2; ++idx)
+  {
+    if(fP[idx])
+    {
+      (void )fclose(fP[idx]);
+    }
+    (void )WlzFreeObj(tObj[idx]);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(ok);
+}
+
+/*!
+* \return	New object or NULL on error.
+* \ingroup	BinWlzTst
+* \brief	Makes a 20 x 16 x 12 cuboid 3D object with ubyte values
+* 		which increase from the centre of each plane and with
+* 		planes further from the centre plane being darker, so
+* 		that a threshold of 100 keeps a central ellipsoid.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzTstPlaneStreamMake(WlzErrorNum *dstErr)
+{
+  int		x,
+		y,
+		z;
+  WlzObject	*obj = NULL;
+  WlzPixelV	bgd;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bgd.type = WLZ_GREY_UBYTE;
+  bgd.v.ubv = 0;
+  obj = WlzMakeCuboid(2, 13, 3, 18, 4, 23, WLZ_GREY_UBYTE, bgd,
+		      NULL, NULL, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(z = 2; z <= 13; ++z)
+    {
+      for(y = 3; y <= 18; ++y)
+      {
+	for(x = 4; x <= 23; ++x)
+	{
+	  int	d2;
+
+	  d2 = ((x - 13) * (x - 13)) + ((y - 10) * (y - 10)) +
+	       (4 * (z - 7) * (z - 7));
+	  WlzGreyValueGet(gVWSp, z, y, x);
+	  *(gVWSp->gPtr[0].ubp) = (WlzUByte )ALG_MAX(200 - (4 * d2), 0);
+	}
+      }
+    }
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(obj);
+    obj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj);
+}
@@ -0,0 +1,426 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstRankFilter_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstRankFilter.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test program for WlzRankFilter() which compares the
+* 		values of rank filtered 2D and 3D objects with integral
+* 		grey values against those found by brute force. The
+* 		objects have irregular domains with many intervals per
+* 		line, the 3D object has an empty middle plane and the
+* 		range of the short values requires the planes to be
+* 		filtered in strips.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <Wlz.h>
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern char     *optarg;
+extern int      optind,
+		opterr,
+		optopt;
+
+/*!
+* \struct	_WlzTstRankFilterCase
+* \ingroup	BinWlzTst
+* \brief	A single test case.
+* 		Typedef: ::WlzTstRankFilterCase.
+*/
+typedef struct _WlzTstRankFilterCase
+{
+  WlzGreyType	gType;		/*!< Grey type of the object. */
+  int		nPln;		/*!< Number of planes, 0 for a 2D
+  				     object. */
+  int		nLn;		/*!< Number of lines. */
+  int		nKl;		/*!< Number of columns. */
+  int		maxVal;		/*!< Values are in the range
+  				     [0, maxVal]. */
+  int		fSz;		/*!< Rank filter size. */
+  double	rank;		/*!< Required rank. */
+} WlzTstRankFilterCase;
+
+static WlzObject		*WlzTstRankFilterObj(
+				  WlzTstRankFilterCase *tc,
+				  unsigned int *seed,
+				  WlzErrorNum *dstErr);
+static int			WlzTstRankFilterCmp(
+				  WlzObject *fObj,
+				  WlzObject *gObj,
+				  WlzTstRankFilterCase *tc,
+				  int verbose,
+				  WlzErrorNum *dstErr);
+static int			WlzTstRankFilterSortFn(
+				  const void *p0,
+				  const void *p1);
+
+int		main(int argc, char *argv[])
+{
+  int		idx,
+  		option,
+		nBad = 0,
+  		ok = 1,
+		verbose = 0,
+		usage = 0;
+  unsigned int	seed = 1;
+  WlzObject	*fObj = NULL,
+  		*gObj = NULL;
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hv";
+  WlzTstRankFilterCase tc[] =
+  {
+    {WLZ_GREY_UBYTE, 0, 61, 83,   255, 3, 0.5},
+    {WLZ_GREY_UBYTE, 0, 61, 83,   255, 4, 0.5},
+    {WLZ_GREY_UBYTE, 0, 61, 83,   255, 7, 0.25},
+    {WLZ_GREY_INT,   0, 47, 53,  1000, 5, 0.75},
+    {WLZ_GREY_SHORT, 0, 13, 611, 30000, 5, 0.5},
+    {WLZ_GREY_UBYTE, 7, 23, 31,   255, 3, 0.5},
+    {WLZ_GREY_SHORT, 7, 23, 31,  4000, 4, 0.5}
+  };
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if(optind != argc)
+  {
+    usage = 1;
+  }
+  ok = !usage;
+  if(ok)
+  {
+    for(idx = 0; (errNum == WLZ_ERR_NONE) &&
+                 (idx < sizeof(tc) / sizeof(tc[0])); ++idx)
+    {
+      gObj = WlzAssignObject(WlzTstRankFilterObj(tc + idx, &seed, &errNum),
+      			     NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        fObj = WlzAssignObject(WlzCopyObject(gObj, &errNum), NULL);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        errNum = WlzRankFilter(fObj, tc[idx].fSz, tc[idx].rank);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        nBad += WlzTstRankFilterCmp(fObj, gObj, tc + idx, verbose, &errNum);
+      }
+      (void )WlzFreeObj(fObj);
+      (void )WlzFreeObj(gObj);
+      fObj = gObj = NULL;
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr,
+                     "%s: Failed to rank filter object (%s).\n",
+		     *argv, errMsgStr);
+    }
+    else
+    {
+      ok = nBad == 0;
+      (void )printf("%s: %s\n", *argv, (ok)? "passed": "failed");
+    }
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v]\n"
+    "Rank filters 2D and 3D objects with irregular domains and integral\n"
+    "grey values using WlzRankFilter(). The test passes if all the\n"
+    "filtered values are the same as those found by brute force.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output.\n",
+    argv[0]);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	New 2D or 3D domain object with values.
+* \ingroup	BinWlzTst
+* \brief	Makes a test object by setting the values of a cuboid
+* 		to pseudo random values and then thresholding it so that
+* 		the domain has gaps. All values of the middle plane of
+* 		a 3D object are zero so that the plane is empty.
+* \param	tc			Test case.
+* \param	seed			Pseudo random number seed.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject *WlzTstRankFilterObj(WlzTstRankFilterCase *tc,
+				      unsigned int *seed,
+				      WlzErrorNum *dstErr)
+{
+  int		lastpl;
+  WlzObject	*obj = NULL,
+  		*rObj = NULL,
+		*tObj = NULL;
+  WlzPixelV	bgd,
+  		thr;
+  WlzIterateWSpace *itWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bgd.type = WLZ_GREY_INT;
+  bgd.v.inv = 0;
+  thr.type = WLZ_GREY_INT;
+  thr.v.inv = tc->maxVal / 8;
+  lastpl = (tc->nPln > 0)? tc->nPln - 1: 0;
+  (void )WlzValueConvertPixel(&bgd, bgd, tc->gType);
+  rObj = WlzAssignObject(
+         WlzMakeCuboid(0, lastpl, -3, tc->nLn - 4, 5, tc->nKl + 4,
+  		       tc->gType, bgd, NULL, NULL, &errNum), NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(tc->nPln > 0)
+    {
+      tObj = WlzAssignObject(rObj, NULL);
+    }
+    else
+    {
+      tObj = WlzAssignObject(
+             WlzMakeMain(WLZ_2D_DOMAINOBJ, rObj->domain.p->domains[0],
+	                 rObj->values.vox->values[0], NULL, NULL,
+			 &errNum), NULL);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    itWSp = WlzIterateInit(tObj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+    {
+      int	v;
+
+      *seed = (*seed * 1103515245u) + 12345u;
+      v = (int )((*seed >> 8) % (tc->maxVal + 1));
+      if((tc->nPln > 0) && (itWSp->pos.vtZ == tc->nPln / 2))
+      {
+        v = 0;
+      }
+      switch(tc->gType)
+      {
+        case WLZ_GREY_UBYTE:
+	  *(itWSp->gP.ubp) = (WlzUByte )v;
+	  break;
+        case WLZ_GREY_SHORT:
+	  *(itWSp->gP.shp) = (short )v;
+	  break;
+        default:
+	  *(itWSp->gP.inp) = v;
+	  break;
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+    WlzIterateWSpFree(itWSp);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    obj = WlzThreshold(tObj, thr, WLZ_THRESH_HIGH, &errNum);
+  }
+  (void )WlzFreeObj(tObj);
+  (void )WlzFreeObj(rObj);
+  *dstErr = errNum;
+  return(obj);
+}
+
+/*!
+* \return	Number of filtered values which differ from those found
+* 		by brute force.
+* \ingroup	BinWlzTst
+* \brief	Compares the values of the filtered object with the
+* 		ranked values of the neighbourhoods in the given object
+* 		found by sorting.
+* \param	fObj			Filtered object.
+* \param	gObj			Given object before filtering.
+* \param	tc			Test case.
+* \param	verbose			Print differences if non-zero.
+* \param	dstErr			Destination error pointer.
+*/
+static int	WlzTstRankFilterCmp(WlzObject *fObj, WlzObject *gObj,
+				    WlzTstRankFilterCase *tc, int verbose,
+				    WlzErrorNum *dstErr)
+{
+  int		lo,
+  		hi,
+		nBad = 0,
+		nVal = 0;
+  int		*buf = NULL;
+  WlzIterateWSpace *itWSp = NULL;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  lo = tc->fSz / 2;
+  hi = tc->fSz - 1 - lo;
+  if((buf = (int *)AlcMalloc(sizeof(int) *
+                             tc->fSz * tc->fSz * tc->fSz)) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp = WlzGreyValueMakeWSp(gObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    itWSp = WlzIterateInit(fObj, WLZ_RASTERDIR_ILIC, 1, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzIterate(itWSp)) == WLZ_ERR_NONE)
+    {
+      int	n = 0,
+      		r,
+      		v,
+      		x,
+		y,
+		z,
+		z0,
+		z1;
+      double	rank;
+      WlzIVertex3 p;
+
+      p = itWSp->pos;
+      z0 = (tc->nPln > 0)? p.vtZ - lo: p.vtZ;
+      z1 = (tc->nPln > 0)? p.vtZ + hi: p.vtZ;
+      for(z = z0; z <= z1; ++z)
+      {
+        for(y = p.vtY - lo; y <= p.vtY + hi; ++y)
+	{
+	  for(x = p.vtX - lo; x <= p.vtX + hi; ++x)
+	  {
+	    if(WlzInsideDomain(gObj, z, y, x, NULL))
+	    {
+	      WlzGreyValueGet(gVWSp, z, y, x);
+	      switch(tc->gType)
+	      {
+	        case WLZ_GREY_UBYTE:
+		  buf[n++] = gVWSp->gVal[0].ubv;
+		  break;
+	        case WLZ_GREY_SHORT:
+		  buf[n++] = gVWSp->gVal[0].shv;
+		  break;
+	        default:
+		  buf[n++] = gVWSp->gVal[0].inv;
+		  break;
+	      }
+	    }
+	  }
+	}
+      }
+      qsort(buf, n, sizeof(int), WlzTstRankFilterSortFn);
+      rank = (tc->rank < DBL_EPSILON)? DBL_EPSILON:
+             (tc->rank > 1.0 - DBL_EPSILON)? 1.0 - DBL_EPSILON: tc->rank;
+      r = buf[(int )floor(n * rank)];
+      switch(tc->gType)
+      {
+        case WLZ_GREY_UBYTE:
+	  v = *(itWSp->gP.ubp);
+	  break;
+        case WLZ_GREY_SHORT:
+	  v = *(itWSp->gP.shp);
+	  break;
+        default:
+	  v = *(itWSp->gP.inp);
+	  break;
+      }
+      if(v != r)
+      {
+        ++nBad;
+	if(verbose)
+	{
+	  (void )printf("%d %d %d filtered %d, brute force %d\n",
+	                p.vtX, p.vtY, p.vtZ, v, r);
+	}
+      }
+      ++nVal;
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  if(verbose)
+  {
+    (void )printf("%dD %s size %d rank %g: values %d, differences %d\n",
+                  (tc->nPln > 0)? 3: 2,
+		  WlzStringFromGreyType(tc->gType, NULL),
+		  tc->fSz, tc->rank, nVal, nBad);
+  }
+  if(itWSp)
+  {
+    WlzIterateWSpFree(itWSp);
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  AlcFree(buf);
+  *dstErr = errNum;
+  return(nBad);
+}
+
+/*!
+* \return	Sort order of the two ints.
+* \ingroup	BinWlzTst
+* \brief	Comparison function for sorting ints into ascending order.
+* \param	p0			Pointer to first int.
+* \param	p1			Pointer to second int.
+*/
+static int	WlzTstRankFilterSortFn(const void *p0, const void *p1)
+{
+  return(*(const int *)p0 - *(const int *)p1);
+}
@@ -0,0 +1,326 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstReadObj_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstReadObj.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Benchmark for reading domain objects with grey values.
+* 		Compares the time taken by WlzReadObj() with that of
+* 		a loop which reads the same number of grey values one
+* 		value at a time (as the grey value reader used to) and
+* 		optionally checks that the object re-written by
+* 		WlzWriteObj() is identical to the input file. The object
+* 		may also be read using WlzReadObjMapped().
+* \ingroup	BinWlzTst
+*/
+
+
+#include <sys/time.h>
+#include <stdio.h>
+#include <string.h>
+#include <Wlz.h>
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern char	*optarg;
+extern int	optind,
+		opterr,
+		optopt;
+
+static double			WlzTstReadObjTime(
+				  struct timeval *t0,
+				  struct timeval *t1);
+static WlzErrorNum		WlzTstReadObjCmpFile(
+				  FILE *fP0,
+				  FILE *fP1,
+				  int *dstSame);
+
+int		main(int argc, char *argv[])
+{
+  int		idx,
+  		option,
+  		ok = 1,
+		usage = 0,
+		check = 0,
+		mapped = 0,
+		nRep = 10;
+  size_t	gSz = 0,
+  		fSz = 0,
+		nVal = 0;
+  double	tObj = 0.0,
+  		tVal = 0.0;
+  FILE		*fP = NULL;
+  WlzObject	*obj = NULL;
+  WlzGreyType	gType = WLZ_GREY_ERROR;
+  struct timeval times[2];
+  char		*inFileStr;
+  const char	*errMsg;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char	optList[] = "chmn:";
+
+  opterr = 0;
+  inFileStr = NULL;
+  while(ok && ((option = getopt(argc, argv, optList)) != -1))
+  {
+    switch(option)
+    {
+      case 'c':
+        check = 1;
+	break;
+      case 'm':
+        mapped = 1;
+	break;
+      case 'n':
+        if((sscanf(optarg, "%d", &nRep) != 1) || (nRep < 1))
+	{
+	  usage = 1;
+	}
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if((usage == 0) && ((optind + 1) != argc))
+  {
+    usage = 1;
+  }
+  ok = !usage;
+  if(ok)
+  {
+    /* The input must be a seekable file as it is read many times. */
+    inFileStr = *(argv + optind);
+    if((fP = fopen(inFileStr, "r")) == NULL)
+    {
+      ok = 0;
+      (void )fprintf(stderr, "%s: Failed to open file %s.\n",
+                     *argv, inFileStr);
+    }
+  }
+  if(ok)
+  {
+    (void )fseek(fP, 0, SEEK_END);
+    fSz = ftell(fP);
+    gettimeofday(times + 0, NULL);
+    for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nRep); ++idx)
+    {
+      (void )WlzFreeObj(obj);
+      rewind(fP);
+      obj = WlzAssignObject((mapped)? WlzReadObjMapped(fP, &errNum):
+                                      WlzReadObj(fP, &errNum), NULL);
+    }
+    gettimeofday(times + 1, NULL);
+    tObj = WlzTstReadObjTime(times + 0, times + 1) / nRep;
+    if(errNum == WLZ_ERR_NONE)
+    {
+      switch(obj->type)
+      {
+        case WLZ_2D_DOMAINOBJ:
+	  nVal = WlzArea(obj, &errNum);
+	  break;
+        case WLZ_3D_DOMAINOBJ:
+	  nVal = WlzVolume(obj, &errNum);
+	  break;
+	default:
+	  errNum = WLZ_ERR_OBJECT_TYPE;
+	  break;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      gType = WlzGreyTypeFromObj(obj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      gSz = WlzGreySize(gType);
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsg);
+      (void )fprintf(stderr,
+                     "%s: Failed to read domain object with values from "
+		     "file %s (%s).\n",
+		     *argv, inFileStr, errMsg);
+    }
+  }
+  if(ok)
+  {
+    size_t	cnt;
+    WlzGreyV	val;
+
+    /* Read the same number of values from the file one value at a time
+     * as the grey value reader used to, rewinding at the end of file. */
+    rewind(fP);
+    gettimeofday(times + 0, NULL);
+    for(idx = 0; idx < nRep; ++idx)
+    {
+      for(cnt = 0; cnt < nVal; ++cnt)
+      {
+	if(fread(val.ubytes, sizeof(char), gSz, fP) != gSz)
+	{
+	  rewind(fP);
+	}
+      }
+    }
+    gettimeofday(times + 1, NULL);
+    tVal = WlzTstReadObjTime(times + 0, times + 1) / nRep;
+    (void )printf("file                  %s\n"
+                  "file size (bytes)     %ld\n"
+		  "grey values           %ld\n"
+		  "grey size (bytes)     %d\n"
+		  "object read (s)       %g\n"
+		  "object read (MB/s)    %g\n"
+		  "per value loop (s)    %g\n"
+		  "per value loop (MB/s) %g\n"
+		  "speed up              %g\n",
+		  inFileStr, (long )fSz, (long )nVal, (int )gSz,
+		  tObj, fSz / (1.0e6 * tObj),
+		  tVal, (nVal * gSz) / (1.0e6 * tVal),
+		  tVal / tObj);
+  }
+  if(ok && check)
+  {
+    int		same = 0;
+    FILE	*tP = NULL;
+
+    if((tP = tmpfile()) == NULL)
+    {
+      errNum = WLZ_ERR_WRITE_EOF;
+    }
+    else if((errNum = WlzWriteObj(tP, obj)) == WLZ_ERR_NONE)
+    {
+      errNum = WlzTstReadObjCmpFile(fP, tP, &same);
+    }
+    if(tP)
+    {
+      (void )fclose(tP);
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsg);
+      (void )fprintf(stderr,
+                     "%s: Failed to write and compare object (%s).\n",
+		     *argv, errMsg);
+    }
+    else
+    {
+      ok = same;
+      (void )printf("re-written file       %s\n",
+                    (same)? "identical": "differs");
+    }
+  }
+  if(fP)
+  {
+    (void )fclose(fP);
+  }
+  (void )WlzFreeObj(obj);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s%s",
+    *argv,
+    " [-c] [-h] [-m] [-n #] <input object>\n"
+    "Benchmark for reading domain objects with grey values. The time taken\n"
+    "by WlzReadObj() is compared with the time taken to read the same\n"
+    "number of grey values one value at a time.\n"
+    "Options:\n"
+    "  -c  Check that the object re-written to a temporary file is\n"
+    "      identical to the input file.\n"
+    "  -h  Prints this usage information.\n"
+    "  -m  Read the object using WlzReadObjMapped() so that rectangular\n"
+    "      value tables may be memory mapped.\n"
+    "  -n  Number of repeats.\n");
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Time between the given times in seconds.
+* \ingroup	BinWlzTst
+* \brief	Computes the difference between the given times.
+* \param	t0			Start time.
+* \param	t1			End time.
+*/
+static double	WlzTstReadObjTime(struct timeval *t0, struct timeval *t1)
+{
+  struct timeval t2;
+
+  ALC_TIMERSUB(t1, t0, &t2);
+  return(t2.tv_sec + (0.000001 * t2.tv_usec));
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Compares the contents of the two given files from their
+* 		start.
+* \param	fP0			First file.
+* \param	fP1			Second file.
+* \param	dstSame			Destination pointer for non-zero
+* 					value if the files are identical.
+*/
+static WlzErrorNum WlzTstReadObjCmpFile(FILE *fP0, FILE *fP1, int *dstSame)
+{
+  size_t	n0,
+  		n1;
+  int		same = 1;
+  char		*buf0 = NULL,
+  		*buf1 = NULL;
+  const size_t	bufSz = 1 << 16;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(((buf0 = (char *)AlcMalloc(bufSz)) == NULL) ||
+     ((buf1 = (char *)AlcMalloc(bufSz)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    rewind(fP0);
+    rewind(fP1);
+    do
+    {
+      n0 = fread(buf0, sizeof(char), bufSz, fP0);
+      n1 = fread(buf1, sizeof(char), bufSz, fP1);
+      same = (n0 == n1) && (memcmp(buf0, buf1, n0) == 0);
+    } while(same && (n0 > 0));
+  }
+  AlcFree(buf0);
+  AlcFree(buf1);
+  *dstSame = same;
+  return(errNum);
+}
@@ -0,0 +1,475 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstRecAutoParallel_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstRecAutoParallel.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test program for RecAutoParallel() which registers a
+* 		series of synthetic sections using both RecAuto() and
+* 		RecAutoParallel(), with a queue of only three section
+* 		images. The test checks that the transforms found are
+* 		identical, that the sections are updated in order and
+* 		that a missing section image or a cancel request stop
+* 		the registration with an error.
+* \ingroup 	BinWlzTst
+*/
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <Wlz.h>
+#include <Reconstruct.h>
+
+/*!
+* \def		WLZ_TST_RECAUTOPAR_NSEC
+* \ingroup	BinWlzTst
+* \brief	Number of synthetic sections.
+*/
+#define WLZ_TST_RECAUTOPAR_NSEC	(12)
+
+/*!
+* \def		WLZ_TST_RECAUTOPAR_SZ
+* \ingroup	BinWlzTst
+* \brief	Width and height of the synthetic sections.
+*/
+#define WLZ_TST_RECAUTOPAR_SZ	(128)
+
+/*!
+* \struct	_WlzTstRecAutoParData
+* \ingroup	BinWlzTst
+* \brief	Data for the section update function.
+*/
+typedef struct _WlzTstRecAutoParData
+{
+  HGUDlpList	*secList;		/*!< Section list being registered. */
+  int		nUpdate;		/*!< Number of sections updated. */
+  int		lastIdx;		/*!< Index of the last section
+  					     updated. */
+  int		ordered;		/*!< Zero if a section was updated
+  					     out of order. */
+} WlzTstRecAutoParData;
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+
+static WlzErrorNum		WlzTstRecAutoParWrite(
+				  const char *path,
+				  int idx);
+static RecError			WlzTstRecAutoParReg(
+				  HGUDlpList **dstList,
+				  WlzTstRecAutoParData *data,
+				  char **files,
+				  int par,
+				  int cancel);
+static void			WlzTstRecAutoParSecFn(
+				  RecSection *sec,
+				  void *data);
+
+int		main(int argc, char *argv[])
+{
+  int		idx,
+  		option,
+		verbose = 0,
+		nDiff = 0,
+  		ok = 1,
+  		usage = 0;
+  HGUDlpList	*secList[2];
+  HGUDlpListItem *item[2];
+  WlzTstRecAutoParData data[2],
+  		missData,
+		cancelData;
+  RecError	recErr[2],
+  		missErr = REC_ERR_NONE,
+		cancelErr = REC_ERR_NONE;
+  char		*files[WLZ_TST_RECAUTOPAR_NSEC + 1];
+  char		dir[] = "/tmp/WlzTstRecAutoParallelXXXXXX";
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hv";
+
+  opterr = 0;
+  secList[0] = secList[1] = NULL;
+  for(idx = 0; idx <= WLZ_TST_RECAUTOPAR_NSEC; ++idx)
+  {
+    files[idx] = NULL;
+  }
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if(optind != argc)
+  {
+    usage = 1;
+  }
+  ok = !usage;
+  if(ok)
+  {
+    if(mkdtemp(dir) == NULL)
+    {
+      ok = 0;
+      (void )fprintf(stderr, "%s: Failed to create temporary directory.\n",
+                     *argv);
+    }
+  }
+  if(ok)
+  {
+    /* Write the section images. */
+    for(idx = 0; (errNum == WLZ_ERR_NONE) &&
+                 (idx < WLZ_TST_RECAUTOPAR_NSEC); ++idx)
+    {
+      if((files[idx] = (char *)AlcMalloc(strlen(dir) + 16)) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+        (void )sprintf(files[idx], "%s/s%02d.wlz", dir, idx);
+	errNum = WlzTstRecAutoParWrite(files[idx], idx);
+      }
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr, "%s: Error - %s.\n", *argv, errMsgStr);
+    }
+  }
+  if(ok)
+  {
+    /* Register the sections serially and in parallel. */
+    for(idx = 0; idx < 2; ++idx)
+    {
+      recErr[idx] = WlzTstRecAutoParReg(&(secList[idx]), &(data[idx]),
+      				        files, idx, 0);
+    }
+    item[0] = HGUDlpListHead(secList[0]);
+    item[1] = HGUDlpListHead(secList[1]);
+    while(item[0] && item[1])
+    {
+      int	r,
+      		c;
+      RecSection *sec[2];
+
+      for(idx = 0; idx < 2; ++idx)
+      {
+        sec[idx] = (RecSection *)HGUDlpListEntryGet(secList[idx], item[idx]);
+	item[idx] = HGUDlpListNext(secList[idx], item[idx]);
+      }
+      for(r = 0; r < 3; ++r)
+      {
+	for(c = 0; c < 3; ++c)
+	{
+	  if(sec[0]->transform->mat[r][c] != sec[1]->transform->mat[r][c])
+	  {
+	    ++nDiff;
+	  }
+	}
+      }
+      if(verbose)
+      {
+        (void )printf("section %d, tx %g, ty %g, parallel tx %g, ty %g\n",
+		      sec[0]->index,
+		      sec[0]->transform->mat[0][2],
+		      sec[0]->transform->mat[1][2],
+		      sec[1]->transform->mat[0][2],
+		      sec[1]->transform->mat[1][2]);
+      }
+    }
+    HGUDlpListDestroy(secList[0]);
+    HGUDlpListDestroy(secList[1]);
+    secList[0] = secList[1] = NULL;
+    /* Register the sections in parallel with a missing section image
+     * and then with a cancel request. */
+    (void )unlink(files[WLZ_TST_RECAUTOPAR_NSEC / 2]);
+    missErr = WlzTstRecAutoParReg(&(secList[0]), &missData, files, 1, 0);
+    HGUDlpListDestroy(secList[0]);
+    cancelErr = WlzTstRecAutoParReg(&(secList[1]), &cancelData, files, 1, 1);
+    HGUDlpListDestroy(secList[1]);
+    if(verbose)
+    {
+      (void )printf("errors %d %d, updates %d %d, ordered %d %d\n"
+                    "transform differences %d\n"
+		    "missing section error %d, updates %d, ordered %d\n"
+		    "cancel error %d, updates %d\n",
+		    recErr[0], recErr[1], data[0].nUpdate, data[1].nUpdate,
+		    data[0].ordered, data[1].ordered, nDiff,
+		    missErr, missData.nUpdate, missData.ordered,
+		    cancelErr, cancelData.nUpdate);
+    }
+    ok = (recErr[0] == REC_ERR_NONE) && (recErr[1] == REC_ERR_NONE) &&
+	 (data[1].nUpdate == WLZ_TST_RECAUTOPAR_NSEC) &&
+	 (data[1].ordered != 0) && (nDiff == 0) &&
+	 (missErr != REC_ERR_NONE) && (missData.ordered != 0) &&
+	 (missData.nUpdate <= WLZ_TST_RECAUTOPAR_NSEC / 2) &&
+	 (cancelErr == REC_ERR_CANCEL);
+    (void )printf("%s: %s\n", *argv, (ok)? "passed": "failed");
+  }
+  for(idx = 0; idx < WLZ_TST_RECAUTOPAR_NSEC; ++idx)
+  {
+    if(files[idx])
+    {
+      (void )unlink(files[idx]);
+      AlcFree(files[idx]);
+    }
+  }
+  if(!usage)
+  {
+    (void )rmdir(dir);
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v]\n"
+    "Writes a series of synthetic sections to a temporary directory and\n"
+    "registers them using both RecAuto() and RecAutoParallel(), with the\n"
+    "latter holding at most three section images. The sections are then\n"
+    "registered in parallel with a missing section image and with a cancel\n"
+    "request. The test passes if the transforms are identical, the\n"
+    "sections are updated in order and both the missing section image and\n"
+    "the cancel request stop the registration with an error.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output.\n",
+    argv[0]);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	BinWlzTst
+* \brief	Writes a synthetic section image to the given file. Each
+* 		section has five Gaussian blobs which are displaced a
+* 		little from those of the previous section.
+* \param	path			File path.
+* \param	idx			Index of the section.
+*/
+static WlzErrorNum WlzTstRecAutoParWrite(const char *path, int idx)
+{
+  int		x,
+		y,
+		b;
+  double	tx,
+  		ty;
+  FILE		*fP;
+  WlzUByte	*buf;
+  WlzObject	*obj = NULL;
+  WlzPixelV	bgd;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const int	shift[WLZ_TST_RECAUTOPAR_NSEC][2] =
+		{
+		  {0, 0}, {-1, 0}, {1, -1}, {2, 1}, {0, 2}, {-2, 1},
+		  {-1, -2}, {1, -1}, {2, 0}, {0, 1}, {-1, 2}, {1, 1}
+		};
+
+  tx = ty = 0.0;
+  for(b = 0; b <= idx; ++b)
+  {
+    tx += shift[b][0];
+    ty += shift[b][1];
+  }
+  bgd.type = WLZ_GREY_UBYTE;
+  bgd.v.ubv = 0;
+  if((buf = (WlzUByte *)AlcMalloc(sizeof(WlzUByte) *
+  				   WLZ_TST_RECAUTOPAR_SZ *
+				   WLZ_TST_RECAUTOPAR_SZ)) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    obj = WlzMakeRect(0, WLZ_TST_RECAUTOPAR_SZ - 1,
+		      0, WLZ_TST_RECAUTOPAR_SZ - 1,
+		      WLZ_GREY_UBYTE, (int *)buf, bgd, NULL, NULL, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      obj->values.r->freeptr = AlcFreeStackPush(obj->values.r->freeptr,
+						buf, NULL);
+    }
+    else
+    {
+      AlcFree(buf);
+    }
+  }
+  obj = WlzAssignObject(obj, NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(y = 0; y < WLZ_TST_RECAUTOPAR_SZ; ++y)
+    {
+      for(x = 0; x < WLZ_TST_RECAUTOPAR_SZ; ++x)
+      {
+	double	v = 10.0;
+
+	for(b = 0; b < 5; ++b)
+	{
+	  double dx,
+	  	 dy,
+		 r;
+
+	  dx = x - (30.0 + (15.0 * b) + tx);
+	  dy = y - (40.0 + (12.0 * ((b * 7) % 5)) + ty);
+	  r = 6.0 + b;
+	  v += 180.0 * exp(-((dx * dx) + (dy * dy)) / (2.0 * r * r));
+	}
+	WlzGreyValueGet(gVWSp, 0, y, x);
+	*(gVWSp->gPtr[0].ubp) = (WlzUByte )WLZ_CLAMP(v, 0.0, 255.0);
+      }
+    }
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((fP = fopen(path, "w")) == NULL)
+    {
+      errNum = WLZ_ERR_FILE_OPEN;
+    }
+    else
+    {
+      errNum = WlzWriteObj(fP, obj);
+      (void )fclose(fP);
+    }
+  }
+  (void )WlzFreeObj(obj);
+  return(errNum);
+}
+
+/*!
+* \return	Reconstruct error code.
+* \ingroup	BinWlzTst
+* \brief	Makes a section list from the given files and registers
+* 		it using either RecAuto() or RecAutoParallel().
+* \param	dstList			Destination pointer for the section
+* 					list, which should be destroyed by
+* 					the caller.
+* \param	data			Data for the section update function,
+* 					which is initialised here.
+* \param	files			NULL terminated section image files.
+* \param	par			Use RecAutoParallel() if non-zero.
+* \param	cancel			Initial value of the cancel flag.
+*/
+static RecError	WlzTstRecAutoParReg(HGUDlpList **dstList,
+				    WlzTstRecAutoParData *data,
+				    char **files, int par, int cancel)
+{
+  RecControl	rCtrl;
+  RecPPControl	ppCtrl;
+  RecError	recErr = REC_ERR_NONE;
+  char		*eMsg = NULL;
+
+  data->nUpdate = 0;
+  data->lastIdx = -1;
+  data->ordered = 1;
+  if((data->secList = HGUDlpListCreate(NULL)) == NULL)
+  {
+    recErr = REC_ERR_MALLOC;
+  }
+  else
+  {
+    recErr = RecSecAppendListFromFiles(data->secList, NULL, files,
+    				       WLZ_TST_RECAUTOPAR_NSEC, 0, 1);
+  }
+  if(recErr == REC_ERR_NONE)
+  {
+    (void )memset(&rCtrl, 0, sizeof(RecControl));
+    (void )memset(&ppCtrl, 0, sizeof(RecPPControl));
+    rCtrl.method = REC_DEF_METHOD;
+    rCtrl.xLim = REC_DEF_XLIM;
+    rCtrl.yLim = REC_DEF_YLIM;
+    rCtrl.rLim = REC_DEF_RLIM;
+    rCtrl.itLim = REC_DEF_ITLIM;
+    rCtrl.firstIdx = 0;
+    rCtrl.lastIdx = WLZ_TST_RECAUTOPAR_NSEC - 1;
+    ppCtrl.method = REC_PP_NONE;
+    recErr = (par)?
+	     RecAutoParallel(&rCtrl, &ppCtrl, data->secList, &cancel,
+			     WlzTstRecAutoParSecFn, data, NULL, NULL,
+			     3, &eMsg):
+	     RecAuto(&rCtrl, &ppCtrl, data->secList, &cancel,
+		     WlzTstRecAutoParSecFn, data, NULL, NULL, &eMsg);
+  }
+  AlcFree(eMsg);
+  *dstList = data->secList;
+  return(recErr);
+}
+
+/*!
+* \ingroup	BinWlzTst
+* \brief	Section update function which replaces the section in
+* 		the list with a copy of the registered section and
+* 		checks that the sections are updated in order.
+* \param	sec			Registered section.
+* \param	data			Section update data.
+*/
+static void	WlzTstRecAutoParSecFn(RecSection *sec, void *data)
+{
+  HGUDlpListItem *item;
+  RecSection	*oldSec,
+  		*newSec;
+  WlzTstRecAutoParData *uData;
+
+  uData = (WlzTstRecAutoParData *)data;
+  if(sec->index <= uData->lastIdx)
+  {
+    uData->ordered = 0;
+  }
+  uData->lastIdx = sec->index;
+  ++(uData->nUpdate);
+  item = RecSecFindItemIndex(uData->secList, NULL, sec->index,
+  			     HGU_DLPLIST_DIR_TOTAIL);
+  if(item && ((newSec = RecSecDup(sec)) != NULL))
+  {
+    oldSec = (RecSection *)HGUDlpListEntryGet(uData->secList, item);
+    (void )HGUDlpListEntrySet(uData->secList, item, RecSecAssign(newSec));
+    RecSecFree(oldSec);
+  }
+}
@@ -0,0 +1,324 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstRegCCor3D_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstRegCCor3D.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test for the rigid registration of 3D objects using
+* 		WlzRegCCorObjs(). A synthetic volume is rotated about
+* 		each axis and translated, then registered with the
+* 		original. The test passes if the registration maps the
+* 		corners of the volume back to within a voxel or so of
+* 		their original positions.
+* \ingroup	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <Wlz.h>
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+
+static WlzObject		*WlzTstRegCCor3DMake(
+				  WlzIVertex3 sz,
+				  WlzErrorNum *dstErr);
+static WlzAffineTransform	*WlzTstRegCCor3DTr(
+				  WlzDVertex3 centre,
+				  double *ang,
+				  WlzDVertex3 tran,
+				  WlzErrorNum *dstErr);
+
+int		main(int argc, char *argv[])
+{
+  int		idx,
+  		option,
+		verbose = 0,
+		conv = 0,
+  		ok = 1,
+  		usage = 0;
+  double	cCor = 0.0,
+  		maxErr = 0.0,
+		maxRot = 0.3;
+  double	ang[3];
+  WlzIVertex3	sz;
+  WlzDVertex2	maxTran;
+  WlzDVertex3	centre,
+  		tran;
+  WlzObject	*tObj = NULL,
+  		*sObj = NULL;
+  WlzAffineTransform *tr = NULL,
+  		*regTr = NULL;
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hv";
+
+  opterr = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if(optind != argc)
+  {
+    usage = 1;
+  }
+  ok = !usage;
+  if(ok)
+  {
+    WLZ_VTX_3_SET(sz, 48, 40, 32);
+    WLZ_VTX_3_SET(centre, 0.5 * (sz.vtX - 1), 0.5 * (sz.vtY - 1),
+    		  0.5 * (sz.vtZ - 1));
+    WLZ_VTX_3_SET(tran, 3.0, -2.0, 1.0);
+    ang[0] = 0.05;
+    ang[1] = -0.08;
+    ang[2] = 0.12;
+    maxTran.vtX = maxTran.vtY = 8.0;
+    tObj = WlzAssignObject(WlzTstRegCCor3DMake(sz, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      tr = WlzTstRegCCor3DTr(centre, ang, tran, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      sObj = WlzAssignObject(
+             WlzAffineTransformObj(tObj, tr, WLZ_INTERPOLATION_LINEAR,
+				   &errNum), NULL);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      regTr = WlzRegCCorObjs(tObj, sObj, NULL, WLZ_TRANSFORM_3D_REG,
+			     maxTran, maxRot, 10, WLZ_WINDOWFN_NONE, 0, 0,
+			     &conv, &cCor, &errNum);
+    }
+    /* The registration transform applied after the test transform should
+     * take the corners of the volume back to their original positions. */
+    for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < 8); ++idx)
+    {
+      WlzDVertex3 p0,
+      		  p1;
+
+      WLZ_VTX_3_SET(p0, (idx & 1)? sz.vtX - 1: 0, (idx & 2)? sz.vtY - 1: 0,
+      		    (idx & 4)? sz.vtZ - 1: 0);
+      p1 = WlzAffineTransformVertexD3(tr, p0, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        p1 = WlzAffineTransformVertexD3(regTr, p1, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	WLZ_VTX_3_SUB(p1, p1, p0);
+	maxErr = WLZ_MAX(maxErr, WLZ_VTX_3_LENGTH(p1));
+      }
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr, "%s: Error - %s.\n", *argv, errMsgStr);
+    }
+    else
+    {
+      ok = maxErr < 2.0;
+      if(verbose)
+      {
+	(void )printf("converged %d, cross correlation %g, "
+		      "maximum corner error %g\n",
+		      conv, cCor, maxErr);
+      }
+    }
+    (void )printf("%s: %s\n", *argv, (ok)? "passed": "failed");
+  }
+  (void )WlzFreeObj(tObj);
+  (void )WlzFreeObj(sObj);
+  (void )WlzFreeAffineTransform(tr);
+  (void )WlzFreeAffineTransform(regTr);
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v]\n"
+    "Rotates a synthetic 48 x 40 x 32 volume by 0.05, -0.08 and 0.12\n"
+    "radians about the x, y and z axes, translates it by (3, -2, 1) and\n"
+    "then registers it with the original using WlzRegCCorObjs(). The\n"
+    "test passes if the registration takes the corners of the volume\n"
+    "to within two voxels of their original positions.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output.\n",
+    argv[0]);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	New object or NULL on error.
+* \ingroup	BinWlzTst
+* \brief	Makes a cuboid object of the given size, with its origin
+* 		at zero, which has three Gaussian blobs of differing size
+* 		and brightness so that it has no rotational symmetry.
+* \param	sz			Size of the object.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzTstRegCCor3DMake(WlzIVertex3 sz, WlzErrorNum *dstErr)
+{
+  int		x,
+		y,
+		z;
+  WlzObject	*obj = NULL;
+  WlzPixelV	bgd;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const double	blob[3][5] =
+  		{
+		  /* x, y, z, sigma, value */
+		  {16.0, 14.0, 12.0, 6.0, 200.0},
+		  {32.0, 26.0, 14.0, 4.0, 150.0},
+		  {22.0, 28.0, 22.0, 3.0, 250.0}
+		};
+
+  bgd.type = WLZ_GREY_UBYTE;
+  bgd.v.ubv = 0;
+  obj = WlzMakeCuboid(0, sz.vtZ - 1, 0, sz.vtY - 1, 0, sz.vtX - 1,
+		      WLZ_GREY_UBYTE, bgd, NULL, NULL, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(z = 0; z < sz.vtZ; ++z)
+    {
+      for(y = 0; y < sz.vtY; ++y)
+      {
+	for(x = 0; x < sz.vtX; ++x)
+	{
+	  int	idB;
+	  double v = 0.0;
+
+	  for(idB = 0; idB < 3; ++idB)
+	  {
+	    double d2;
+
+	    d2 = ((x - blob[idB][0]) * (x - blob[idB][0])) +
+	         ((y - blob[idB][1]) * (y - blob[idB][1])) +
+	         ((z - blob[idB][2]) * (z - blob[idB][2]));
+	    v += blob[idB][4] *
+	         exp(-d2 / (2.0 * blob[idB][3] * blob[idB][3]));
+	  }
+	  WlzGreyValueGet(gVWSp, z, y, x);
+	  *(gVWSp->gPtr[0].ubp) = (WlzUByte )WLZ_CLAMP(v, 0.0, 255.0);
+	}
+      }
+    }
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(obj);
+    obj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj);
+}
+
+/*!
+* \return	New affine transform or NULL on error.
+* \ingroup	BinWlzTst
+* \brief	Makes a transform which rotates about the given centre
+* 		and then translates.
+* \param	centre			Centre of rotation.
+* \param	ang			Angles of rotation about the x, y
+* 					and z axes.
+* \param	tran			Translation.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzAffineTransform *WlzTstRegCCor3DTr(WlzDVertex3 centre,
+					     double *ang, WlzDVertex3 tran,
+					     WlzErrorNum *dstErr)
+{
+  WlzAffineTransform *tr0 = NULL,
+  		*tr1 = NULL,
+		*tr2 = NULL,
+		*tr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  tr0 = WlzAffineTransformFromTranslation(WLZ_TRANSFORM_3D_AFFINE,
+  					  -(centre.vtX), -(centre.vtY),
+					  -(centre.vtZ), &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tr1 = WlzAffineTransformFromRotation(WLZ_TRANSFORM_3D_AFFINE,
+    					 ang[0], ang[1], ang[2], &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tr2 = WlzAffineTransformProduct(tr0, tr1, &errNum);
+  }
+  (void )WlzFreeAffineTransform(tr0);
+  (void )WlzFreeAffineTransform(tr1);
+  tr0 = NULL;
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tr0 = WlzAffineTransformFromTranslation(WLZ_TRANSFORM_3D_AFFINE,
+					    centre.vtX + tran.vtX,
+					    centre.vtY + tran.vtY,
+					    centre.vtZ + tran.vtZ, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tr = WlzAffineTransformProduct(tr2, tr0, &errNum);
+  }
+  (void )WlzFreeAffineTransform(tr0);
+  (void )WlzFreeAffineTransform(tr2);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tr);
+}
@@ -0,0 +1,373 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzTstTiledSectionCache_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         binWlzTst/WlzTstTiledSectionCache.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Test program which checks that a section cut from an
+* 		object with memory mapped tiled values uses the tile
+* 		cache of the values: a repeated section must hit the cache
+* 		for every tile it needs and the sections must match those
+* 		cut from the values without a cache.
+* \ingroup 	BinWlzTst
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <Wlz.h>
+
+extern int      getopt(int argc, char * const *argv, const char *optstring);
+
+extern int      optind, opterr, optopt;
+extern char     *optarg;
+
+static WlzObject		*WlzTstTiledSectionCacheMake(
+				  const char *path,
+				  WlzErrorNum *dstErr);
+static int			WlzTstTiledSectionCacheCmp(
+				  WlzObject *obj0,
+				  WlzObject *obj1);
+
+int		main(int argc, char *argv[])
+{
+  int		idx,
+  		fd,
+  		option,
+		same = 1,
+		verbose = 0,
+  		ok = 1,
+  		usage = 0;
+  WlzLong	hits[2],
+  		misses[2];
+  FILE		*fP = NULL;
+  WlzObject	*obj = NULL,
+  		*mObj = NULL;
+  WlzObject	*sec[3];
+  WlzThreeDViewStruct *view = NULL;
+  WlzTiledValuesCache *tc = NULL;
+  char		path[] = "/tmp/WlzTstTiledSectionCacheXXXXXX";
+  const char	*errMsgStr;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  static char   optList[] = "hv";
+
+  opterr = 0;
+  sec[0] = sec[1] = sec[2] = NULL;
+  hits[0] = hits[1] = misses[0] = misses[1] = 0;
+  while((usage == 0) && ((option = getopt(argc, argv, optList)) != EOF))
+  {
+    switch(option)
+    {
+      case 'v':
+        verbose = 1;
+	break;
+      case 'h': /* FALLTHROUGH */
+      default:
+	usage = 1;
+	break;
+    }
+  }
+  if(optind != argc)
+  {
+    usage = 1;
+  }
+  ok = !usage;
+  if(ok)
+  {
+    if((fd = mkstemp(path)) < 0)
+    {
+      ok = 0;
+      (void )fprintf(stderr, "%s: Failed to create temporary file.\n",
+                     *argv);
+    }
+    else
+    {
+      (void )close(fd);
+    }
+  }
+  if(ok)
+  {
+    /* Make an object with tiled values, write it to the file and then
+     * read it back with the tiles memory mapped. */
+    obj = WlzAssignObject(WlzTstTiledSectionCacheMake(path, &errNum), NULL);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if((fP = fopen(path, "r")) == NULL)
+      {
+        errNum = WLZ_ERR_FILE_OPEN;
+      }
+      else
+      {
+        mObj = WlzAssignObject(WlzReadObjMapped(fP, &errNum), NULL);
+	(void )fclose(fP);
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) &&
+       ((mObj->type != WLZ_3D_DOMAINOBJ) ||
+        (WlzGreyTableIsTiled(mObj->values.core->type) == 0) ||
+	(mObj->values.t->fd < 0)))
+    {
+      errNum = WLZ_ERR_VALUES_TYPE;
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      view = WlzMake3DViewStruct(WLZ_3D_VIEW_STRUCT, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      view->theta = 30.0 * WLZ_M_PI / 180.0;
+      view->phi = 60.0 * WLZ_M_PI / 180.0;
+      view->dist = 5.0;
+      view->fixed.vtX = view->fixed.vtY = view->fixed.vtZ = 32.0;
+      view->view_mode = WLZ_UP_IS_UP_MODE;
+      view->up.vtX = view->up.vtY = 0.0;
+      view->up.vtZ = 1.0;
+      errNum = WlzInit3DViewStruct(view, mObj);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      sec[0] = WlzAssignObject(
+	       WlzGetSubSectionFromObject(obj, NULL, view,
+					  WLZ_INTERPOLATION_NEAREST, NULL,
+					  &errNum), NULL);
+    }
+    /* Cut the same section twice with a cache set for the mapped
+     * values. */
+    if(errNum == WLZ_ERR_NONE)
+    {
+      tc = WlzMakeTiledValuesCache(mObj->values.t, 1024, &errNum);
+    }
+    if((errNum == WLZ_ERR_NONE) && (mObj->values.t->cache != tc))
+    {
+      errNum = WLZ_ERR_VALUES_DATA;
+    }
+    for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < 2); ++idx)
+    {
+      sec[idx + 1] = WlzAssignObject(
+		     WlzGetSubSectionFromObject(mObj, NULL, view,
+						WLZ_INTERPOLATION_NEAREST, NULL,
+						&errNum), NULL);
+      hits[idx] = tc->hits;
+      misses[idx] = tc->misses;
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      same = WlzTstTiledSectionCacheCmp(sec[0], sec[1]) &&
+             WlzTstTiledSectionCacheCmp(sec[0], sec[2]);
+      errNum = WlzFreeTiledValuesCache(tc);
+      tc = NULL;
+    }
+    if((errNum == WLZ_ERR_NONE) && (mObj->values.t->cache != NULL))
+    {
+      errNum = WLZ_ERR_VALUES_DATA;
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      ok = 0;
+      (void )WlzStringFromErrorNum(errNum, &errMsgStr);
+      (void )fprintf(stderr, "%s: Error - %s.\n", *argv, errMsgStr);
+    }
+  }
+  if(ok)
+  {
+    if(verbose)
+    {
+      (void )printf("first section hits %ld misses %ld\n"
+                    "repeated section hits %ld misses %ld\n"
+		    "sections same %d\n",
+		    (long )hits[0], (long )misses[0],
+		    (long )(hits[1] - hits[0]), (long )(misses[1] - misses[0]),
+		    same);
+    }
+    ok = (hits[0] == 0) && (misses[0] > 0) &&
+         (hits[1] - hits[0] == misses[0]) && (misses[1] == misses[0]) &&
+	 same;
+    (void )printf("%s: %s\n", *argv, (ok)? "passed": "failed");
+  }
+  if(tc)
+  {
+    (void )WlzFreeTiledValuesCache(tc);
+  }
+  for(idx = 0; idx < 3; ++idx)
+  {
+    (void )WlzFreeObj(sec[idx]);
+  }
+  (void )WlzFree3DViewStruct(view);
+  (void )WlzFreeObj(mObj);
+  (void )WlzFreeObj(obj);
+  if(!usage)
+  {
+    (void )unlink(path);
+  }
+  if(usage)
+  {
+    (void )fprintf(stderr,
+    "Usage: %s [-h] [-v]\n"
+    "Writes an object with tiled values to a temporary file and reads it\n"
+    "back with its tiles memory mapped. A tile cache is made for the\n"
+    "mapped values and the same section is cut twice. The test passes if\n"
+    "every tile needed by the repeated section is a cache hit and the\n"
+    "sections match one cut from the values without a cache.\n"
+    "Options are:\n"
+    "  -h  Help, prints this usage message.\n"
+    "  -v  Verbose output.\n",
+    argv[0]);
+  }
+  return(!ok);
+}
+
+/*!
+* \return	New 3D object with tiled values or NULL on error.
+* \ingroup	BinWlzTst
+* \brief	Makes a 64x64x64 cuboid object with varying values and
+* 		tiled values, then writes it to the given file.
+* \param	path			File path.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzTstTiledSectionCacheMake(const char *path,
+					      WlzErrorNum *dstErr)
+{
+  int		idX,
+		idY,
+		idZ;
+  FILE		*fP;
+  WlzObject	*obj = NULL,
+  		*tObj = NULL;
+  WlzPixelV	bgd;
+  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  bgd.type = WLZ_GREY_UBYTE;
+  bgd.v.ubv = 0;
+  obj = WlzAssignObject(WlzMakeCuboid(0, 63, 0, 63, 0, 63, WLZ_GREY_UBYTE,
+  				      bgd, NULL, NULL, &errNum), NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gVWSp = WlzGreyValueMakeWSp(obj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idZ = 0; idZ < 64; ++idZ)
+    {
+      for(idY = 0; idY < 64; ++idY)
+      {
+	for(idX = 0; idX < 64; ++idX)
+	{
+	  WlzGreyValueGet(gVWSp, idZ, idY, idX);
+	  *(gVWSp->gPtr[0].ubp) = (WlzUByte )((idX * 7 + idY * 3 + idZ) & 0xff);
+	}
+      }
+    }
+    tObj = WlzMakeTiledValuesFromObj(obj, 4096, 1, WLZ_GREY_UBYTE, bgd,
+    				     &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((fP = fopen(path, "w")) == NULL)
+    {
+      errNum = WLZ_ERR_FILE_OPEN;
+    }
+    else
+    {
+      errNum = WlzWriteObj(fP, tObj);
+      (void )fclose(fP);
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(tObj);
+    tObj = NULL;
+  }
+  WlzGreyValueFreeWSp(gVWSp);
+  (void )WlzFreeObj(obj);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tObj);
+}
+
+/*!
+* \return	Non zero if the sections are the same.
+* \ingroup	BinWlzTst
+* \brief	Compares the domains and values of two 2D sections.
+* \param	obj0			First section.
+* \param	obj1			Second section.
+*/
+static int	WlzTstTiledSectionCacheCmp(WlzObject *obj0, WlzObject *obj1)
+{
+  int		same = 0;
+  WlzIBox2	box;
+  WlzIntervalDomain *iDom0,
+  		*iDom1;
+
+  if(obj0 && obj1 && obj0->domain.core && obj1->domain.core &&
+     obj0->values.core && obj1->values.core)
+  {
+    iDom0 = obj0->domain.i;
+    iDom1 = obj1->domain.i;
+    box.xMin = iDom0->kol1;
+    box.xMax = iDom0->lastkl;
+    box.yMin = iDom0->line1;
+    box.yMax = iDom0->lastln;
+    if((box.xMin == iDom1->kol1) && (box.xMax == iDom1->lastkl) &&
+       (box.yMin == iDom1->line1) && (box.yMax == iDom1->lastln))
+    {
+      int	idX,
+      		idY;
+      WlzGreyValueWSpace *gVWSp0,
+      		*gVWSp1;
+
+      gVWSp0 = WlzGreyValueMakeWSp(obj0, NULL);
+      gVWSp1 = WlzGreyValueMakeWSp(obj1, NULL);
+      if(gVWSp0 && gVWSp1)
+      {
+	same = 1;
+	for(idY = box.yMin; same && (idY <= box.yMax); ++idY)
+	{
+	  for(idX = box.xMin; same && (idX <= box.xMax); ++idX)
+	  {
+	    WlzGreyValueGet(gVWSp0, 0, idY, idX);
+	    WlzGreyValueGet(gVWSp1, 0, idY, idX);
+	    same = gVWSp0->gVal[0].ubv == gVWSp1->gVal[0].ubv;
+	  }
+	}
+      }
+      WlzGreyValueFreeWSp(gVWSp0);
+      WlzGreyValueFreeWSp(gVWSp1);
+    }
+  }
+  return(same);
+}
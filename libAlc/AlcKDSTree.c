@@ -0,0 +1,1060 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _AlcKDSTree_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libAlc/AlcKDSTree.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	A static, arbitrary dimension, floating point kD-tree
+* 		which is built in a single pass from an array of points
+* 		and which supports batched nearest neighbour and radius
+* 		queries.
+*
+* 		Unlike the tree of AlcKDTree.c, which is built by
+* 		inserting nodes one at a time, the whole tree is built
+* 		at once by recursively splitting the points at the
+* 		median of the dimension in which they have the greatest
+* 		extent. The nodes are held in a single array in depth
+* 		first order and the points are copied into a single
+* 		array in tree order, with each leaf node holding a
+* 		small bucket of contiguous points. This keeps the
+* 		searches within a few cache lines and avoids any per
+* 		node allocation.
+*
+* 		Searches descend to the leaf containing the query and
+* 		then visit the other children only when the squared
+* 		distance from the query to their cell, which is kept
+* 		incrementally as in Arya and Mount's algorithm, is less
+* 		than the current bound.
+* \ingroup	AlcKDSTree
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <Alc.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Default maximum number of points in a leaf node. */
+#define ALC_KDS_BKTSZ_DEF	(8)
+/* Queries in a batch below which the batch is not run in parallel. */
+#define ALC_KDS_PAR_MIN		(256)
+/* Largest dimension for which a single query uses a stack work space. */
+#define ALC_KDS_DIM_STK		(8)
+
+/*!
+* \struct	_AlcKDSQryWSp
+* \ingroup	AlcKDSTree
+* \brief	Work space for a single query.
+*/
+typedef struct _AlcKDSQryWSp
+{
+  const double	*key;		/*!< The query position. */
+  double	*off;		/*!< Per dimension offsets from the query
+  				     to the current cell. */
+  double	bnd;		/*!< Current bound on the squared
+  				     distance. */
+  int		k;		/*!< Number of neighbours required. */
+  int		nFnd;		/*!< Number of neighbours found. */
+  size_t	*hIdx;		/*!< Max-heap of tree order point
+  				     indices found. */
+  double	*hDSq;		/*!< Max-heap of squared distances
+  				     found. */
+  size_t	cnt;		/*!< Number of points within radius. */
+  size_t	*rIdx;		/*!< Destination for the points within
+  				     the radius, NULL when counting. */
+  double	*rDSq;		/*!< Destination for squared distances
+  				     of the points within the radius, may
+				     be NULL. */
+} AlcKDSQryWSp;
+
+static size_t			AlcKDSNodeCount(
+				  size_t nPnt,
+				  int bktSz);
+static size_t			AlcKDSBuild(
+				  AlcKDSTree *tree,
+				  size_t nodIdx,
+				  size_t first,
+				  size_t nPnt);
+static void			AlcKDSSelect(
+				  AlcKDSTree *tree,
+				  size_t first,
+				  size_t nPnt,
+				  size_t k,
+				  int s);
+static void			AlcKDSSwap(
+				  AlcKDSTree *tree,
+				  size_t i,
+				  size_t j);
+static void			AlcKDSNodeKNN(
+				  AlcKDSTree *tree,
+				  size_t nodIdx,
+				  double rd,
+				  AlcKDSQryWSp *wSp);
+static void			AlcKDSNodeRadius(
+				  AlcKDSTree *tree,
+				  size_t nodIdx,
+				  double rd,
+				  AlcKDSQryWSp *wSp);
+static void			AlcKDSHeapAdd(
+				  AlcKDSQryWSp *wSp,
+				  size_t pIdx,
+				  double dSq);
+static void			AlcKDSHeapDown(
+				  size_t *hIdx,
+				  double *hDSq,
+				  int n,
+				  int i);
+static double			AlcKDSMaxDistSq(
+				  double maxDist);
+static void			AlcKDSQueryKNN(
+				  AlcKDSTree *tree,
+				  const double *key,
+				  int k,
+				  double maxDistSq,
+				  double *off,
+				  size_t *dstIdx,
+				  double *dstDist);
+static size_t			AlcKDSQueryRadius(
+				  AlcKDSTree *tree,
+				  const double *key,
+				  double radiusSq,
+				  double *off,
+				  size_t *dstIdx,
+				  double *dstDSq);
+
+/*!
+* \return	New static kD-tree, or NULL on error.
+* \ingroup	AlcKDSTree
+* \brief	Builds a static kD-tree from the given points. The
+* 		points are copied so the given array may be free'd
+* 		once the tree has been built. The tree is built by
+* 		recursively splitting the points at the median of
+* 		the dimension with the greatest extent until no more
+* 		than the bucket size of points remain, which takes
+* 		O(n log n) time.
+* \param	dim			Dimension of the tree (must be >= 1).
+* \param	nPnt			Number of points (must be >= 1).
+* \param	pnt			The points, with dim values for each
+* 					point. The index of each point in
+* 					this array is returned by the
+* 					queries.
+* \param	bktSz			Maximum number of points in a leaf
+* 					node, if < 1 a default value is used.
+* \param	dstErr			Destination pointer for error
+*					code, may be NULL.
+*/
+AlcKDSTree	*AlcKDSTreeNew(int dim, size_t nPnt, const double *pnt,
+			       int bktSz, AlcErrno *dstErr)
+{
+  size_t	idx;
+  AlcKDSTree	*tree = NULL;
+  AlcErrno	errNum = ALC_ER_NONE;
+
+  if(pnt == NULL)
+  {
+    errNum = ALC_ER_NULLPTR;
+  }
+  else if((dim < 1) || (nPnt < 1))
+  {
+    errNum = ALC_ER_PARAM;
+  }
+  else if((tree = (AlcKDSTree *)AlcCalloc(1, sizeof(AlcKDSTree))) == NULL)
+  {
+    errNum = ALC_ER_ALLOC;
+  }
+  else
+  {
+    tree->dim = dim;
+    tree->bktSz = (bktSz < 1)? ALC_KDS_BKTSZ_DEF: bktSz;
+    tree->nPnt = nPnt;
+    tree->nNode = AlcKDSNodeCount(nPnt, tree->bktSz);
+    if(((tree->node = (AlcKDSNode *)
+                      AlcMalloc(tree->nNode * sizeof(AlcKDSNode))) == NULL) ||
+       ((tree->pnt = (double *)
+                     AlcMalloc(nPnt * dim * sizeof(double))) == NULL) ||
+       ((tree->idx = (size_t *)AlcMalloc(nPnt * sizeof(size_t))) == NULL))
+    {
+      errNum = ALC_ER_ALLOC;
+    }
+  }
+  if(errNum == ALC_ER_NONE)
+  {
+    (void )memcpy(tree->pnt, pnt, nPnt * dim * sizeof(double));
+    for(idx = 0; idx < nPnt; ++idx)
+    {
+      tree->idx[idx] = idx;
+    }
+    (void )AlcKDSBuild(tree, 0, 0, nPnt);
+  }
+  else
+  {
+    (void )AlcKDSTreeFree(tree);
+    tree = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tree);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlcKDSTree
+* \brief	Frees the given static kD-tree.
+* \param	tree			The static kD-tree, may be NULL.
+*/
+AlcErrno	AlcKDSTreeFree(AlcKDSTree *tree)
+{
+  if(tree)
+  {
+    AlcFree(tree->node);
+    AlcFree(tree->pnt);
+    AlcFree(tree->idx);
+    AlcFree(tree);
+  }
+  return(ALC_ER_NONE);
+}
+
+/*!
+* \return	Index of the nearest neighbour in the array of points
+* 		from which the tree was built, or ALC_KDS_IDX_NONE if
+* 		there is no point within the maximum distance or on
+* 		error.
+* \ingroup	AlcKDSTree
+* \brief	Searches for the nearest neighbour of a single query
+* 		position. When there are many queries
+* 		AlcKDSGetKNN() should be used instead.
+* \param	tree			The static kD-tree.
+* \param	key			The query position.
+* \param	maxDist			Only points at less than this
+* 					distance are considered, there is
+* 					no limit if negative.
+* \param	dstNNDist		Destination pointer for distance
+*					to nearest neighbour, may be NULL.
+*					Only set if a neighbour is found.
+* \param	dstErr			Destination pointer for error
+*					code, may be NULL.
+*/
+size_t		AlcKDSGetNN(AlcKDSTree *tree, const double *key,
+			    double maxDist, double *dstNNDist,
+			    AlcErrno *dstErr)
+{
+  size_t	nnIdx = ALC_KDS_IDX_NONE;
+  double	nnDist;
+  double	*off = NULL;
+  double	offStk[ALC_KDS_DIM_STK];
+  AlcErrno	errNum = ALC_ER_NONE;
+
+  if((tree == NULL) || (key == NULL))
+  {
+    errNum = ALC_ER_NULLPTR;
+  }
+  else if(tree->dim <= ALC_KDS_DIM_STK)
+  {
+    off = offStk;
+  }
+  else if((off = (double *)AlcMalloc(tree->dim * sizeof(double))) == NULL)
+  {
+    errNum = ALC_ER_ALLOC;
+  }
+  if(errNum == ALC_ER_NONE)
+  {
+    AlcKDSQueryKNN(tree, key, 1, AlcKDSMaxDistSq(maxDist), off,
+    		   &nnIdx, &nnDist);
+    if((nnIdx != ALC_KDS_IDX_NONE) && dstNNDist)
+    {
+      *dstNNDist = nnDist;
+    }
+    if(off != offStk)
+    {
+      AlcFree(off);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nnIdx);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlcKDSTree
+* \brief	Finds the k nearest neighbours of each of the given
+* 		query positions. The queries are independent and are
+* 		run in parallel. For each query the neighbours are
+* 		returned in order of increasing distance, with any
+* 		neighbours which could not be found (because there are
+* 		fewer than k points within the maximum distance) having
+* 		index ALC_KDS_IDX_NONE and distance DBL_MAX.
+* \param	tree			The static kD-tree.
+* \param	nQry			Number of query positions.
+* \param	qry			The query positions, with the tree's
+* 					dimension of values for each query.
+* \param	k			Number of neighbours required
+* 					(must be >= 1).
+* \param	maxDist			Only points at less than this
+* 					distance are considered, there is
+* 					no limit if negative.
+* \param	dstIdx			Destination for the indices of the
+* 					neighbours in the array of points from
+* 					which the tree was built, with room
+* 					for nQry * k indices.
+* \param	dstDist			Destination for the distances of the
+* 					neighbours, with room for nQry * k
+* 					distances.
+*/
+AlcErrno	AlcKDSGetKNN(AlcKDSTree *tree, size_t nQry, const double *qry,
+			     int k, double maxDist,
+			     size_t *dstIdx, double *dstDist)
+{
+  size_t	q;
+  double	maxDistSq;
+  AlcErrno	errNum = ALC_ER_NONE;
+
+  if((tree == NULL) || (qry == NULL) || (dstIdx == NULL) || (dstDist == NULL))
+  {
+    errNum = ALC_ER_NULLPTR;
+  }
+  else if(k < 1)
+  {
+    errNum = ALC_ER_PARAM;
+  }
+  if((errNum == ALC_ER_NONE) && (nQry > 0))
+  {
+    maxDistSq = AlcKDSMaxDistSq(maxDist);
+#ifdef _OPENMP
+#pragma omp parallel if(nQry >= ALC_KDS_PAR_MIN)
+#endif
+    {
+      double	*off;
+
+      if((off = (double *)AlcMalloc(tree->dim * sizeof(double))) == NULL)
+      {
+#ifdef _OPENMP
+#pragma omp critical (AlcKDSGetKNN)
+#endif
+	{
+	  errNum = ALC_ER_ALLOC;
+	}
+      }
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+      for(q = 0; q < nQry; ++q)
+      {
+	if(off)
+	{
+	  AlcKDSQueryKNN(tree, qry + (q * tree->dim), k, maxDistSq, off,
+			 dstIdx + (q * k), dstDist + (q * k));
+	}
+      }
+      AlcFree(off);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlcKDSTree
+* \brief	Finds all the points within the given radius of each
+* 		of the given query positions. The queries are run in
+* 		parallel, first to count the points for each query and
+* 		then to fill them in. The results are returned in
+* 		compressed form: the points found for query q are
+* 		those with indices (*dstOff)[q] to (*dstOff)[q + 1] - 1
+* 		in the returned arrays, in no particular order. The
+* 		returned arrays should be free'd using AlcFree().
+* \param	tree			The static kD-tree.
+* \param	nQry			Number of query positions.
+* \param	qry			The query positions, with the tree's
+* 					dimension of values for each query.
+* \param	radius			Points at no more than this distance
+* 					from a query are found.
+* \param	dstOff			Destination pointer for the array of
+* 					nQry + 1 offsets.
+* \param	dstIdx			Destination pointer for the array of
+* 					indices of the points found in the
+* 					array of points from which the tree
+* 					was built.
+* \param	dstDist			Destination pointer for the array of
+* 					distances of the points found, may be
+* 					NULL.
+*/
+AlcErrno	AlcKDSGetRadius(AlcKDSTree *tree, size_t nQry,
+				const double *qry, double radius,
+				size_t **dstOff, size_t **dstIdx,
+				double **dstDist)
+{
+  size_t	q,
+  		nFnd = 0;
+  double	radiusSq;
+  size_t	*off = NULL,
+  		*idx = NULL;
+  double	*dist = NULL;
+  AlcErrno	errNum = ALC_ER_NONE;
+
+  if((tree == NULL) || (qry == NULL) || (dstOff == NULL) || (dstIdx == NULL))
+  {
+    errNum = ALC_ER_NULLPTR;
+  }
+  else if(radius < 0.0)
+  {
+    errNum = ALC_ER_PARAM;
+  }
+  else if((off = (size_t *)AlcCalloc(nQry + 1, sizeof(size_t))) == NULL)
+  {
+    errNum = ALC_ER_ALLOC;
+  }
+  if(errNum == ALC_ER_NONE)
+  {
+    int		pass;
+
+    radiusSq = radius * radius;
+    for(pass = 0; (errNum == ALC_ER_NONE) && (pass < 2); ++pass)
+    {
+#ifdef _OPENMP
+#pragma omp parallel if(nQry >= ALC_KDS_PAR_MIN)
+#endif
+      {
+	double	*pOff;
+
+	if((pOff = (double *)AlcMalloc(tree->dim * sizeof(double))) == NULL)
+	{
+#ifdef _OPENMP
+#pragma omp critical (AlcKDSGetRadius)
+#endif
+	  {
+	    errNum = ALC_ER_ALLOC;
+	  }
+	}
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+	for(q = 0; q < nQry; ++q)
+	{
+	  if(pOff)
+	  {
+	    if(pass == 0)
+	    {
+	      off[q + 1] = AlcKDSQueryRadius(tree, qry + (q * tree->dim),
+	                                     radiusSq, pOff, NULL, NULL);
+	    }
+	    else
+	    {
+	      (void )AlcKDSQueryRadius(tree, qry + (q * tree->dim),
+	                               radiusSq, pOff, idx + off[q],
+				       (dist)? dist + off[q]: NULL);
+	    }
+	  }
+	}
+	AlcFree(pOff);
+      }
+      /* Between the passes convert the counts to offsets and allocate
+       * the results. */
+      if((errNum == ALC_ER_NONE) && (pass == 0))
+      {
+	for(q = 0; q < nQry; ++q)
+	{
+	  off[q + 1] += off[q];
+	}
+	nFnd = off[nQry];
+	if(((idx = (size_t *)AlcMalloc((nFnd + 1) * sizeof(size_t))) == NULL) ||
+	   (dstDist &&
+	    ((dist = (double *)AlcMalloc((nFnd + 1) *
+	                                 sizeof(double))) == NULL)))
+	{
+	  errNum = ALC_ER_ALLOC;
+	}
+      }
+    }
+  }
+  if(errNum == ALC_ER_NONE)
+  {
+    for(q = 0; q < nFnd; ++q)
+    {
+      idx[q] = tree->idx[idx[q]];
+    }
+    if(dist)
+    {
+      for(q = 0; q < nFnd; ++q)
+      {
+	dist[q] = sqrt(dist[q]);
+      }
+    }
+    *dstOff = off;
+    *dstIdx = idx;
+    if(dstDist)
+    {
+      *dstDist = dist;
+    }
+  }
+  else
+  {
+    AlcFree(off);
+    AlcFree(idx);
+    AlcFree(dist);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Number of nodes.
+* \ingroup	AlcKDSTree
+* \brief	Computes the number of nodes in a tree built from the
+* 		given number of points.
+* \param	nPnt			Number of points.
+* \param	bktSz			Maximum number of points in a leaf.
+*/
+static size_t	AlcKDSNodeCount(size_t nPnt, int bktSz)
+{
+  size_t	nNode = 1;
+
+  if(nPnt > (size_t )bktSz)
+  {
+    nNode += AlcKDSNodeCount(nPnt / 2, bktSz) +
+             AlcKDSNodeCount(nPnt - (nPnt / 2), bktSz);
+  }
+  return(nNode);
+}
+
+/*!
+* \return	Index of the next free node.
+* \ingroup	AlcKDSTree
+* \brief	Recursively builds the sub-tree with the given root
+* 		node index for the given range of points.
+* \param	tree			The tree being built.
+* \param	nodIdx			Index of the sub-tree's root node.
+* \param	first			First point of the sub-tree.
+* \param	nPnt			Number of points in the sub-tree.
+*/
+static size_t	AlcKDSBuild(AlcKDSTree *tree, size_t nodIdx,
+			    size_t first, size_t nPnt)
+{
+  size_t	nxtIdx;
+  AlcKDSNode	*nod;
+
+  nod = tree->node + nodIdx;
+  nod->first = first;
+  nod->nPnt = nPnt;
+  nod->childP = 0;
+  nod->cut = 0.0;
+  if(nPnt <= (size_t )(tree->bktSz))
+  {
+    nod->split = -1;
+    nxtIdx = nodIdx + 1;
+  }
+  else
+  {
+    int		d,
+    		s = 0;
+    size_t	i,
+    		nN;
+    double	ext,
+    		maxExt = -1.0;
+    const double *p;
+
+    /* Split in the dimension with the greatest extent. */
+    for(d = 0; d < tree->dim; ++d)
+    {
+      double	lo,
+      		hi;
+
+      p = tree->pnt + (first * tree->dim) + d;
+      lo = hi = *p;
+      for(i = 1; i < nPnt; ++i)
+      {
+	p += tree->dim;
+	if(*p < lo)
+	{
+	  lo = *p;
+	}
+	else if(*p > hi)
+	{
+	  hi = *p;
+	}
+      }
+      if((ext = hi - lo) > maxExt)
+      {
+	maxExt = ext;
+	s = d;
+      }
+    }
+    nN = nPnt / 2;
+    AlcKDSSelect(tree, first, nPnt, first + nN, s);
+    nod->split = s;
+    nod->cut = tree->pnt[((first + nN) * tree->dim) + s];
+    nxtIdx = AlcKDSBuild(tree, nodIdx + 1, first, nN);
+    tree->node[nodIdx].childP = nxtIdx;
+    nxtIdx = AlcKDSBuild(tree, nxtIdx, first + nN, nPnt - nN);
+  }
+  return(nxtIdx);
+}
+
+/*!
+* \return	void
+* \ingroup	AlcKDSTree
+* \brief	Partially sorts the given range of points in the given
+* 		dimension so that the k'th point is in its sorted
+* 		position with no greater values before it and no lesser
+* 		values after it. This is Wirth's selection algorithm.
+* \param	tree			The tree being built.
+* \param	first			First point of the range.
+* \param	nPnt			Number of points in the range.
+* \param	k			Index of the point to select.
+* \param	s			Dimension to sort in.
+*/
+static void	AlcKDSSelect(AlcKDSTree *tree, size_t first, size_t nPnt,
+			     size_t k, int s)
+{
+  ptrdiff_t	i,
+  		j,
+		l,
+		r;
+  double	x;
+  const int	dim = tree->dim;
+  const double	*v;
+
+  v = tree->pnt + s;
+  l = first;
+  r = first + nPnt - 1;
+  while(l < r)
+  {
+    x = v[k * dim];
+    i = l;
+    j = r;
+    do
+    {
+      while(v[i * dim] < x)
+      {
+        ++i;
+      }
+      while(x < v[j * dim])
+      {
+        --j;
+      }
+      if(i <= j)
+      {
+	AlcKDSSwap(tree, i, j);
+        ++i;
+	--j;
+      }
+    } while(i <= j);
+    if(j < (ptrdiff_t )k)
+    {
+      l = i;
+    }
+    if((ptrdiff_t )k < i)
+    {
+      r = j;
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlcKDSTree
+* \brief	Swaps two points, along with their indices.
+* \param	tree			The tree being built.
+* \param	i			First point.
+* \param	j			Second point.
+*/
+static void	AlcKDSSwap(AlcKDSTree *tree, size_t i, size_t j)
+{
+  if(i != j)
+  {
+    int		d;
+    size_t	tI;
+    double	tD;
+    double	*pI,
+    		*pJ;
+
+    pI = tree->pnt + (i * tree->dim);
+    pJ = tree->pnt + (j * tree->dim);
+    for(d = 0; d < tree->dim; ++d)
+    {
+      tD = pI[d];
+      pI[d] = pJ[d];
+      pJ[d] = tD;
+    }
+    tI = tree->idx[i];
+    tree->idx[i] = tree->idx[j];
+    tree->idx[j] = tI;
+  }
+}
+
+/*!
+* \return	Square of the given maximum distance, or DBL_MAX if the
+* 		distance is negative or its square would overflow.
+* \ingroup	AlcKDSTree
+* \brief	Computes the bound on the squared distance of a nearest
+* 		neighbour query from the given maximum distance.
+* \param	maxDist			Given maximum distance, negative
+* 					for no limit.
+*/
+static double	AlcKDSMaxDistSq(double maxDist)
+{
+  return(((maxDist < 0.0) || (maxDist >= sqrt(DBL_MAX)))?
+         DBL_MAX: maxDist * maxDist);
+}
+
+/*!
+* \return	void
+* \ingroup	AlcKDSTree
+* \brief	Finds the k nearest neighbours of a single query.
+* \param	tree			The static kD-tree.
+* \param	key			The query position.
+* \param	k			Number of neighbours required.
+* \param	maxDistSq		Square of the maximum distance.
+* \param	off			Work space for the tree's dimension
+* 					of offsets.
+* \param	dstIdx			Destination for k indices.
+* \param	dstDist			Destination for k distances.
+*/
+static void	AlcKDSQueryKNN(AlcKDSTree *tree, const double *key, int k,
+			       double maxDistSq, double *off,
+			       size_t *dstIdx, double *dstDist)
+{
+  int		i;
+  AlcKDSQryWSp	wSp;
+
+  wSp.key = key;
+  wSp.off = off;
+  wSp.bnd = maxDistSq;
+  wSp.k = k;
+  wSp.nFnd = 0;
+  wSp.hIdx = dstIdx;
+  wSp.hDSq = dstDist;
+  for(i = 0; i < tree->dim; ++i)
+  {
+    off[i] = 0.0;
+  }
+  AlcKDSNodeKNN(tree, 0, 0.0, &wSp);
+  /* Sort the max-heap into increasing distance order. */
+  for(i = wSp.nFnd - 1; i > 0; --i)
+  {
+    size_t	tI;
+    double	tD;
+
+    tI = dstIdx[0]; dstIdx[0] = dstIdx[i]; dstIdx[i] = tI;
+    tD = dstDist[0]; dstDist[0] = dstDist[i]; dstDist[i] = tD;
+    AlcKDSHeapDown(dstIdx, dstDist, i, 0);
+  }
+  for(i = 0; i < wSp.nFnd; ++i)
+  {
+    dstIdx[i] = tree->idx[dstIdx[i]];
+    dstDist[i] = sqrt(dstDist[i]);
+  }
+  for(i = wSp.nFnd; i < k; ++i)
+  {
+    dstIdx[i] = ALC_KDS_IDX_NONE;
+    dstDist[i] = DBL_MAX;
+  }
+}
+
+/*!
+* \return	Number of points found.
+* \ingroup	AlcKDSTree
+* \brief	Finds the points within a radius of a single query.
+* \param	tree			The static kD-tree.
+* \param	key			The query position.
+* \param	radiusSq		Square of the radius.
+* \param	off			Work space for the tree's dimension
+* 					of offsets.
+* \param	dstIdx			Destination for the tree order
+* 					indices, if NULL the points are
+* 					only counted.
+* \param	dstDSq			Destination for the squared
+* 					distances, may be NULL.
+*/
+static size_t	AlcKDSQueryRadius(AlcKDSTree *tree, const double *key,
+				  double radiusSq, double *off,
+				  size_t *dstIdx, double *dstDSq)
+{
+  int		i;
+  AlcKDSQryWSp	wSp;
+
+  wSp.key = key;
+  wSp.off = off;
+  wSp.bnd = radiusSq;
+  wSp.cnt = 0;
+  wSp.rIdx = dstIdx;
+  wSp.rDSq = dstDSq;
+  for(i = 0; i < tree->dim; ++i)
+  {
+    off[i] = 0.0;
+  }
+  AlcKDSNodeRadius(tree, 0, 0.0, &wSp);
+  return(wSp.cnt);
+}
+
+/*!
+* \return	void
+* \ingroup	AlcKDSTree
+* \brief	Recursive k nearest neighbour search of the sub-tree
+* 		with the given root node. The nearer child is searched
+* 		first and the further child only if its cell is within
+* 		the current bound.
+* \param	tree			The static kD-tree.
+* \param	nodIdx			Index of the sub-tree's root node.
+* \param	rd			Squared distance from the query to
+* 					the node's cell.
+* \param	wSp			Query work space.
+*/
+static void	AlcKDSNodeKNN(AlcKDSTree *tree, size_t nodIdx, double rd,
+			      AlcKDSQryWSp *wSp)
+{
+  const int	dim = tree->dim;
+  AlcKDSNode	*nod;
+
+  nod = tree->node + nodIdx;
+  if(nod->split < 0)
+  {
+    int		d;
+    size_t	i;
+    double	t,
+    		dSq;
+    const double *p;
+
+    p = tree->pnt + (nod->first * dim);
+    for(i = 0; i < nod->nPnt; ++i)
+    {
+      dSq = 0.0;
+      for(d = 0; d < dim; ++d)
+      {
+	t = p[d] - wSp->key[d];
+	dSq += t * t;
+      }
+      if(dSq < wSp->bnd)
+      {
+	AlcKDSHeapAdd(wSp, nod->first + i, dSq);
+      }
+      p += dim;
+    }
+  }
+  else
+  {
+    int		s;
+    size_t	nrIdx,
+    		frIdx;
+    double	d,
+    		o;
+
+    s = nod->split;
+    d = wSp->key[s] - nod->cut;
+    if(d < 0.0)
+    {
+      nrIdx = nodIdx + 1;
+      frIdx = nod->childP;
+    }
+    else
+    {
+      nrIdx = nod->childP;
+      frIdx = nodIdx + 1;
+    }
+    AlcKDSNodeKNN(tree, nrIdx, rd, wSp);			/* Recursive */
+    o = wSp->off[s];
+    rd += (d * d) - (o * o);
+    if(rd < wSp->bnd)
+    {
+      wSp->off[s] = d;
+      AlcKDSNodeKNN(tree, frIdx, rd, wSp);			/* Recursive */
+      wSp->off[s] = o;
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlcKDSTree
+* \brief	Recursive radius search of the sub-tree with the given
+* 		root node.
+* \param	tree			The static kD-tree.
+* \param	nodIdx			Index of the sub-tree's root node.
+* \param	rd			Squared distance from the query to
+* 					the node's cell.
+* \param	wSp			Query work space.
+*/
+static void	AlcKDSNodeRadius(AlcKDSTree *tree, size_t nodIdx, double rd,
+				 AlcKDSQryWSp *wSp)
+{
+  const int	dim = tree->dim;
+  AlcKDSNode	*nod;
+
+  nod = tree->node + nodIdx;
+  if(nod->split < 0)
+  {
+    int		d;
+    size_t	i;
+    double	t,
+    		dSq;
+    const double *p;
+
+    p = tree->pnt + (nod->first * dim);
+    for(i = 0; i < nod->nPnt; ++i)
+    {
+      dSq = 0.0;
+      for(d = 0; d < dim; ++d)
+      {
+	t = p[d] - wSp->key[d];
+	dSq += t * t;
+      }
+      if(dSq <= wSp->bnd)
+      {
+	if(wSp->rIdx)
+	{
+	  wSp->rIdx[wSp->cnt] = nod->first + i;
+	  if(wSp->rDSq)
+	  {
+	    wSp->rDSq[wSp->cnt] = dSq;
+	  }
+	}
+	++(wSp->cnt);
+      }
+      p += dim;
+    }
+  }
+  else
+  {
+    int		s;
+    size_t	nrIdx,
+    		frIdx;
+    double	d,
+    		o;
+
+    s = nod->split;
+    d = wSp->key[s] - nod->cut;
+    if(d < 0.0)
+    {
+      nrIdx = nodIdx + 1;
+      frIdx = nod->childP;
+    }
+    else
+    {
+      nrIdx = nod->childP;
+      frIdx = nodIdx + 1;
+    }
+    AlcKDSNodeRadius(tree, nrIdx, rd, wSp);			/* Recursive */
+    o = wSp->off[s];
+    rd += (d * d) - (o * o);
+    if(rd <= wSp->bnd)
+    {
+      wSp->off[s] = d;
+      AlcKDSNodeRadius(tree, frIdx, rd, wSp);			/* Recursive */
+      wSp->off[s] = o;
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlcKDSTree
+* \brief	Adds a point to the query's max-heap of nearest
+* 		neighbours, replacing the furthest when the heap is
+* 		full, and updates the search bound.
+* \param	wSp			Query work space.
+* \param	pIdx			Tree order index of the point.
+* \param	dSq			Squared distance of the point.
+*/
+static void	AlcKDSHeapAdd(AlcKDSQryWSp *wSp, size_t pIdx, double dSq)
+{
+  int		i,
+  		p;
+
+  if(wSp->nFnd < wSp->k)
+  {
+    i = wSp->nFnd++;
+    while((i > 0) && (wSp->hDSq[p = (i - 1) / 2] < dSq))
+    {
+      wSp->hIdx[i] = wSp->hIdx[p];
+      wSp->hDSq[i] = wSp->hDSq[p];
+      i = p;
+    }
+    wSp->hIdx[i] = pIdx;
+    wSp->hDSq[i] = dSq;
+    if(wSp->nFnd == wSp->k)
+    {
+      wSp->bnd = wSp->hDSq[0];
+    }
+  }
+  else
+  {
+    wSp->hIdx[0] = pIdx;
+    wSp->hDSq[0] = dSq;
+    AlcKDSHeapDown(wSp->hIdx, wSp->hDSq, wSp->k, 0);
+    wSp->bnd = wSp->hDSq[0];
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlcKDSTree
+* \brief	Restores the max-heap property below the given entry.
+* \param	hIdx			Heap point indices.
+* \param	hDSq			Heap squared distances.
+* \param	n			Number of entries in the heap.
+* \param	i			Given entry.
+*/
+static void	AlcKDSHeapDown(size_t *hIdx, double *hDSq, int n, int i)
+{
+  int		c;
+  size_t	tI;
+  double	tD;
+
+  tI = hIdx[i];
+  tD = hDSq[i];
+  while((c = (2 * i) + 1) < n)
+  {
+    if((c + 1 < n) && (hDSq[c + 1] > hDSq[c]))
+    {
+      ++c;
+    }
+    if(hDSq[c] <= tD)
+    {
+      break;
+    }
+    hIdx[i] = hIdx[c];
+    hDSq[i] = hDSq[c];
+    i = c;
+  }
+  hIdx[i] = tI;
+  hDSq[i] = tD;
+}
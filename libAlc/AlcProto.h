@@ -444,6 +444,11 @@ extern void            		*AlcFreeStackPush(
 				  void *prev,
 				  void *data,
 				  AlcErrno *dstErr);
+extern void            		*AlcFreeStackPushFn(
+				  void *prev,
+				  void *data,
+				  void (*freeFn)(void *),
+				  AlcErrno *dstErr);
 extern void			*AlcFreeStackPop(
 				  void *prev,
 				  void **dstData,
@@ -570,6 +575,40 @@ extern AlcKDTNode	       *AlcKDTGetNN(
 				  double *dstNNDist,
 				  AlcErrno *dstErr);
 
+/************************************************************************
+* AlcKDSTree.c
+************************************************************************/
+extern AlcKDSTree		*AlcKDSTreeNew(
+				  int dim,
+				  size_t nPnt,
+				  const double *pnt,
+				  int bktSz,
+				  AlcErrno *dstErr);
+extern AlcErrno			AlcKDSTreeFree(
+				  AlcKDSTree *tree);
+extern size_t			AlcKDSGetNN(
+				  AlcKDSTree *tree,
+				  const double *key,
+				  double maxDist,
+				  double *dstNNDist,
+				  AlcErrno *dstErr);
+extern AlcErrno			AlcKDSGetKNN(
+				  AlcKDSTree *tree,
+				  size_t nQry,
+				  const double *qry,
+				  int k,
+				  double maxDist,
+				  size_t *dstIdx,
+				  double *dstDist);
+extern AlcErrno			AlcKDSGetRadius(
+				  AlcKDSTree *tree,
+				  size_t nQry,
+				  const double *qry,
+				  double radius,
+				  size_t **dstOff,
+				  size_t **dstIdx,
+				  double **dstDist);
+
 /************************************************************************
 * AlcLRUCache.c
 ************************************************************************/
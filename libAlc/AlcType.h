@@ -438,6 +438,60 @@ typedef struct _AlcKDTTree
   AlcBlockStack *freeStack;	/*!< Stack of allocated node blocks */
 } AlcKDTTree;
 
+/*!
+* \def		ALC_KDS_IDX_NONE
+* \ingroup	AlcKDSTree
+* \brief	Point index used by the static kD-tree queries when
+* 		no point was found.
+*/
+#define ALC_KDS_IDX_NONE	((size_t )(-1))
+
+/*!
+* \struct	_AlcKDSNode
+* \ingroup	AlcKDSTree
+* \brief	A node in a static kD-tree. The nodes are stored in
+* 		depth first order so the -ve child of a node is always
+* 		the next node in the node array.
+*               Typedef: ::AlcKDSNode
+*/
+typedef struct _AlcKDSNode
+{
+  int		split;		/*!< The splitting dimension, -ve for a
+  				     leaf node */
+  double	cut;		/*!< Splitting value, points of the -ve
+  				     child are <= and those of the +ve
+				     child are >= this value */
+  size_t	childP;		/*!< Index of the +ve child node */
+  size_t	first;		/*!< Index of the first point of the
+  				     node in the tree's point array */
+  size_t	nPnt;		/*!< Number of points in the node */
+} AlcKDSNode;
+
+/*!
+* \struct	_AlcKDSTree
+* \ingroup	AlcKDSTree
+* \brief	A static kD-tree with double precision keys. The tree
+* 		is built in a single pass from an array of points and
+* 		can not be modified. The points are copied into a
+* 		single array in tree order with leaf nodes holding
+* 		buckets of points.
+*               Typedef: ::AlcKDSTree
+*/
+typedef struct _AlcKDSTree
+{
+  int		dim;		/*!< Dimension of the tree. */
+  int		bktSz;		/*!< Maximum number of points in a leaf
+  				     node */
+  size_t	nPnt;		/*!< Number of points in the tree */
+  size_t	nNode;		/*!< Number of nodes in the tree */
+  AlcKDSNode	*node;		/*!< Array of nodes, node 0 is the
+  				     root */
+  double	*pnt;		/*!< Point coordinates in tree order,
+  				     dim values per point */
+  size_t	*idx;		/*!< Given index of each point in tree
+  				     order */
+} AlcKDSTree;
+
 /*!
 * \struct       _AlcHeapEntryCore
 * \ingroup      AlcHeap
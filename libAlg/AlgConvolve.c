@@ -189,3 +189,109 @@ AlgError	AlgConvolve(int sizeArrayCnv, double *arrayCnv,
   return(errCode);
 }
 
+
+/*!
+* \return	Error code.
+* \ingroup	AlgConvolve
+* \brief	Computes the cyclic convolution of two real 3D arrays
+*		using a single complex FFT. On return the data array
+*		holds the (normalised) convolution and the kernel array
+*		is overwritten. The kernel must be in wrap-around order,
+*		ie with it's origin at array position (0, 0, 0).
+*		Both real arrays are transformed together with the data
+*		as the real and the kernel as the imaginary part, their
+*		transforms are then separated as in AlgCrossCorrelate3D()
+*		and multiplied.
+*		The transforms are fastest when the array dimensions have
+*		no prime factors other than 2, 3, 5 and 7, see
+*		AlgFFTGoodSize().
+* \param	data			Data array (source:
+*					AlcDouble3Malloc) which holds the
+*					convolution on return.
+* \param	krn			Kernel array (source:
+*					AlcDouble3Malloc).
+* \param	nX			Number of columns in each of the
+*					arrays.
+* \param	nY			Number of lines in each of the
+*					arrays.
+* \param	nZ			Number of planes in each of the
+*					arrays.
+*/
+AlgError	AlgConvolveFFT3D(double ***data, double ***krn,
+				 int nX, int nY, int nZ)
+{
+  int		idZ;
+  size_t	nT;
+  double	nrm;
+  double	*re,
+  		*im;
+  AlgError	errCode = ALG_ERR_NONE;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgConvolveFFT3D FE 0x%lx 0x%lx %d %d %d\n",
+	   (unsigned long )data, (unsigned long )krn, nX, nY, nZ));
+  if((data == NULL) || (krn == NULL) ||
+     (nX < 1) || (nY < 1) || (nZ < 1))
+  {
+    errCode = ALG_ERR_FUNC;
+  }
+  else
+  {
+    errCode = AlgFFTDbl3D(data, krn, nX, nY, nZ, ALG_FFT_DIR_FWD);
+  }
+  if(errCode == ALG_ERR_NONE)
+  {
+    /* Form the product spectrum A_k B_k normalised by the number of
+     * elements, again updating each element and it's mirror from the
+     * element with the lower index. */
+    re = **data;
+    im = **krn;
+    nT = (size_t )nX * nY * nZ;
+    nrm = 1.0 / (double )nT;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idZ = 0; idZ < nZ; ++idZ)
+    {
+      int	idX,
+      		idY;
+      size_t	i,
+      		j;
+
+      for(idY = 0; idY < nY; ++idY)
+      {
+	i = ((size_t )idZ * nY + idY) * nX;
+	for(idX = 0; idX < nX; ++idX)
+	{
+	  j = (((size_t )((nZ - idZ) % nZ) * nY + ((nY - idY) % nY)) * nX) +
+	      ((nX - idX) % nX);
+	  if(i <= j)
+	  {
+	    double	aR,
+	    		aI,
+			bR,
+			bI,
+			cR,
+			cI;
+
+	    aR = 0.5 * (re[i] + re[j]);
+	    aI = 0.5 * (im[i] - im[j]);
+	    bR = 0.5 * (im[i] + im[j]);
+	    bI = -0.5 * (re[i] - re[j]);
+	    cR = nrm * ((aR * bR) - (aI * bI));
+	    cI = nrm * ((aR * bI) + (aI * bR));
+	    re[i] = re[j] = cR;
+	    im[i] = cI;
+	    im[j] = -cI;
+	  }
+	  ++i;
+	}
+      }
+    }
+    errCode = AlgFFTDbl3D(data, krn, nX, nY, nZ, ALG_FFT_DIR_INV);
+  }
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgConvolveFFT3D FX %d\n",
+	   (int )errCode));
+  return(errCode);
+}
@@ -141,6 +141,216 @@ AlgError	AlgCrossCorrelate2D(double **data0, double **data1,
   return(errNum);
 }
 
+/*!
+* \return	Error code.
+* \ingroup	AlgCorr
+* \brief	Cross correlates the given 3D double arrays leaving
+*		the result in the first of the two arrays, the second
+*		array is used as workspace.
+*		The cross correlation data are un-normalized and in
+*		wrap-around order, as for AlgCrossCorrelate2D(), but
+*		the arrays may be of any size. The transforms are
+*		fastest when the array dimensions have no prime factors
+*		other than 2, 3, 5 and 7, see AlgFFTGoodSize().
+*		Both real arrays are transformed together using a single
+*		complex transform, with the first array as the real and
+*		the second as the imaginary part, and their transforms
+*		are then separated using
+*		\f$A_k = (Z_k + \overline{Z_{-k}}) / 2\f$ and
+*		\f$B_k = (Z_k - \overline{Z_{-k}}) / 2i\f$.
+* \param	data0			Data for obj0's FFT (source:
+*					AlcDouble3Malloc) which holds the
+*					cross correlation data on return.
+* \param	data1			Data for obj1's FFT (source:
+*					AlcDouble3Malloc).
+* \param	nX			Number of columns in each of the
+*					data arrays.
+* \param	nY			Number of lines in each of the
+*					data arrays.
+* \param	nZ			Number of planes in each of the
+*					data arrays.
+*/
+AlgError	AlgCrossCorrelate3D(double ***data0, double ***data1,
+				    int nX, int nY, int nZ)
+{
+  int		idZ;
+  double	*re,
+  		*im;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((data0 == NULL) || (data1 == NULL) ||
+     (nX < 1) || (nY < 1) || (nZ < 1))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else
+  {
+    errNum = AlgFFTDbl3D(data0, data1, nX, nY, nZ, ALG_FFT_DIR_FWD);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    /* Form the cross spectrum A_k conj(B_k). Each element and its mirror
+     * element are updated by the element with the lower index, since the
+     * cross spectrum of real data is Hermitian. */
+    re = **data0;
+    im = **data1;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idZ = 0; idZ < nZ; ++idZ)
+    {
+      int	idX,
+      		idY;
+      size_t	i,
+      		j;
+
+      for(idY = 0; idY < nY; ++idY)
+      {
+	i = ((size_t )idZ * nY + idY) * nX;
+	for(idX = 0; idX < nX; ++idX)
+	{
+	  j = (((size_t )((nZ - idZ) % nZ) * nY + ((nY - idY) % nY)) * nX) +
+	      ((nX - idX) % nX);
+	  if(i <= j)
+	  {
+	    double	aR,
+	    		aI,
+			bR,
+			bI,
+			cR,
+			cI;
+
+	    aR = 0.5 * (re[i] + re[j]);
+	    aI = 0.5 * (im[i] - im[j]);
+	    bR = 0.5 * (im[i] + im[j]);
+	    bI = -0.5 * (re[i] - re[j]);
+	    cR = (aR * bR) + (aI * bI);
+	    cI = (aI * bR) - (aR * bI);
+	    re[i] = re[j] = cR;
+	    im[i] = cI;
+	    im[j] = -cI;
+	  }
+	  ++i;
+	}
+      }
+    }
+    errNum = AlgFFTDbl3D(data0, data1, nX, nY, nZ, ALG_FFT_DIR_INV);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgCorr
+* \brief	Cross correlates a target, for which the spectrum has
+*		already been computed, with each of two 3D double arrays
+*		leaving the results in the two arrays. This allows a
+*		target to be correlated with many arrays while computing
+*		its transform only once.
+*		The target spectrum must have been computed by
+*		AlgFFTDbl3D() from real data with a zero imaginary part
+*		and is not modified. The two real arrays are transformed
+*		together, as in AlgCrossCorrelate3D(), then the cross
+*		spectra \f$C_k = T_k \overline{A_k}\f$ and
+*		\f$D_k = T_k \overline{B_k}\f$ are formed and, because
+*		both cross correlations are real, they too are inverse
+*		transformed together as \f$C_k + i D_k\f$.
+*		To correlate a single array the second array should be
+*		all zero.
+*		The cross correlation data are un-normalized and in
+*		wrap-around order, as for AlgCrossCorrelate3D().
+* \param	tRe			Real part of the target spectrum.
+* \param	tIm			Imaginary part of the target
+*					spectrum.
+* \param	data0			First data array (source:
+*					AlcDouble3Malloc) which holds its
+*					cross correlation data on return.
+* \param	data1			Second data array (source:
+*					AlcDouble3Malloc) which holds its
+*					cross correlation data on return.
+* \param	nX			Number of columns in each of the
+*					data arrays.
+* \param	nY			Number of lines in each of the
+*					data arrays.
+* \param	nZ			Number of planes in each of the
+*					data arrays.
+*/
+AlgError	AlgCrossCorrelateSpec3D(double ***tRe, double ***tIm,
+					double ***data0, double ***data1,
+					int nX, int nY, int nZ)
+{
+  int		idZ;
+  double	*re,
+  		*im,
+		*sRe,
+		*sIm;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((tRe == NULL) || (tIm == NULL) || (data0 == NULL) || (data1 == NULL) ||
+     (nX < 1) || (nY < 1) || (nZ < 1))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else
+  {
+    errNum = AlgFFTDbl3D(data0, data1, nX, nY, nZ, ALG_FFT_DIR_FWD);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    re = **data0;
+    im = **data1;
+    sRe = **tRe;
+    sIm = **tIm;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idZ = 0; idZ < nZ; ++idZ)
+    {
+      int	idX,
+      		idY;
+      size_t	i,
+      		j;
+
+      for(idY = 0; idY < nY; ++idY)
+      {
+	i = ((size_t )idZ * nY + idY) * nX;
+	for(idX = 0; idX < nX; ++idX)
+	{
+	  j = (((size_t )((nZ - idZ) % nZ) * nY + ((nY - idY) % nY)) * nX) +
+	      ((nX - idX) % nX);
+	  if(i <= j)
+	  {
+	    double	aR,
+	    		aI,
+			bR,
+			bI,
+			cR,
+			cI,
+			dR,
+			dI;
+
+	    aR = 0.5 * (re[i] + re[j]);
+	    aI = 0.5 * (im[i] - im[j]);
+	    bR = 0.5 * (im[i] + im[j]);
+	    bI = -0.5 * (re[i] - re[j]);
+	    cR = (sRe[i] * aR) + (sIm[i] * aI);
+	    cI = (sIm[i] * aR) - (sRe[i] * aI);
+	    dR = (sRe[i] * bR) + (sIm[i] * bI);
+	    dI = (sIm[i] * bR) - (sRe[i] * bI);
+	    re[j] = cR + dI;
+	    im[j] = dR - cI;
+	    re[i] = cR - dI;
+	    im[i] = dR + cI;
+	  }
+	  ++i;
+	}
+      }
+    }
+    errNum = AlgFFTDbl3D(data0, data1, nX, nY, nZ, ALG_FFT_DIR_INV);
+  }
+  return(errNum);
+}
+
 /*!
 * \return	void
 * \ingroup	AlgCorr
@@ -236,6 +446,110 @@ void		AlgCrossCorrPeakXY(int *dstMaxX, int *dstMaxY,
   }
 }
 
+/*!
+* \return	void
+* \ingroup	AlgCorr
+* \brief	Find the maximum correlation value in the given three
+*		dimensional array. As in AlgCrossCorrPeakXY() the
+*		correlation data are in wrap-around order and only
+*		the eight corners of the array, within the given search
+*		range, are searched.
+* \param	dstMaxX			Destination ptr for column
+*					coordinate with maximum value.
+* \param	dstMaxY			Destination ptr for line
+*					coordinate with maximum value.
+* \param	dstMaxZ			Destination ptr for plane
+*					coordinate with maximum value.
+* \param	dstMaxVal		Destination ptr for maximum value.
+* \param	data			Data to search for maximum.
+* \param	nX			Number of columns in data.
+* \param	nY			Number of lines in data.
+* \param	nZ			Number of planes in data.
+* \param	searchX			Maximum number of columns to
+*					search.
+* \param	searchY			Maximum number of lines to
+*					search.
+* \param	searchZ			Maximum number of planes to
+*					search.
+*/
+void		AlgCrossCorrPeakXYZ(int *dstMaxX, int *dstMaxY, int *dstMaxZ,
+				    double *dstMaxVal, double ***data,
+				    int nX, int nY, int nZ,
+				    int searchX, int searchY, int searchZ)
+{
+  int		idX,
+  		idY,
+		idZ,
+		xMax = 0,
+		yMax = 0,
+		zMax = 0;
+  int		lo[3],
+  		hi[3],
+		n[3],
+		s[3];
+  double	maxVal;
+
+  n[0] = nX;
+  n[1] = nY;
+  n[2] = nZ;
+  s[0] = searchX;
+  s[1] = searchY;
+  s[2] = searchZ;
+  /* Offsets in [-search, search - 1], as for AlgCrossCorrPeakXY(), but
+   * limited so that no element is visited twice. */
+  for(idX = 0; idX < 3; ++idX)
+  {
+    lo[idX] = -((s[idX] < (n[idX] / 2))? s[idX]: (n[idX] / 2));
+    hi[idX] = ((s[idX] < ((n[idX] + 1) / 2))? s[idX]: ((n[idX] + 1) / 2)) - 1;
+    if(hi[idX] < 0)
+    {
+      hi[idX] = 0;
+    }
+  }
+  maxVal = ***data;
+  for(idZ = lo[2]; idZ <= hi[2]; ++idZ)
+  {
+    double	**pln;
+
+    pln = *(data + ((idZ < 0)? nZ + idZ: idZ));
+    for(idY = lo[1]; idY <= hi[1]; ++idY)
+    {
+      double	*ln;
+
+      ln = *(pln + ((idY < 0)? nY + idY: idY));
+      for(idX = lo[0]; idX <= hi[0]; ++idX)
+      {
+	double	v;
+
+        v = *(ln + ((idX < 0)? nX + idX: idX));
+	if(v > maxVal)
+	{
+	  maxVal = v;
+	  xMax = idX;
+	  yMax = idY;
+	  zMax = idZ;
+	}
+      }
+    }
+  }
+  if(dstMaxVal)
+  {
+    *dstMaxVal = maxVal;
+  }
+  if(dstMaxX)
+  {
+    *dstMaxX = xMax;
+  }
+  if(dstMaxY)
+  {
+    *dstMaxY = yMax;
+  }
+  if(dstMaxZ)
+  {
+    *dstMaxZ = zMax;
+  }
+}
+
 /*!
 * \return	void
 * \brief	Finds peak value in cross correlation data, only
@@ -0,0 +1,3548 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _AlgFFT_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libAlg/AlgFFT.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Mixed radix fast Fourier transforms of any length, in
+* 		double or single precision.
+* \par
+* 		Transforms are computed using precomputed plans
+* 		(see ::AlgFFTPlan). A plan factors the transform length
+* 		into radix 4, 2, 3, 5 and 7 butterfly stages (with
+* 		any other prime factors handled by a general odd radix
+* 		stage) and holds the digit reversal permutation and
+* 		twiddle factors of the decimation in time transform.
+* 		Lengths with a prime factor greater than 31 are instead
+* 		transformed using Bluestein's algorithm, which computes
+* 		the transform as a convolution using transforms of a
+* 		length with only small prime factors, so that the cost
+* 		of all transforms is \f$O(n \log n)\f$.
+* 		Plans may be shared by any number of threads and are
+* 		kept in a small cache by AlgFFTPlanGet() so that
+* 		repeated transforms of the same length only compute
+* 		them once.
+* \par
+* 		Each one dimensional transform gathers its (possibly
+* 		strided) data into a contiguous split complex workspace,
+* 		in digit reversed order, computes the butterflies in
+* 		place and then scatters the result back. Keeping the
+* 		real and imaginary parts in separate arrays with unit
+* 		stride inner loops allows the compiler to vectorise the
+* 		butterflies. Inverse transforms are computed by
+* 		exchanging the real and imaginary parts of the data on
+* 		input and output.
+* \par
+* 		Transforms are not normalised, so a forward transform
+* 		followed by an inverse transform scales the data by
+* 		the product of the transform lengths.
+* 		Real data of even length \f$N = 2M\f$ are transformed
+* 		using a complex transform of length \f$M\f$ and the
+* 		result is packed in place as
+* 		\f$r_0, r_1, \ldots, r_M, i_1, \ldots, i_{M-1}\f$ as
+* 		in AlgFourReal1D().
+* \par
+* 		The multi-dimensional transforms require the data to
+* 		be contiguous, as allocated by AlcDouble2Malloc(),
+* 		AlcFloat3Malloc(), etc., and transform the lines of each
+* 		axis in parallel.
+* \ingroup      AlgFourier
+*/
+
+#include <Alg.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \def		ALG_FFT_PLAN_CACHE_SZ
+* \brief	Maximum number of plans held in the plan cache.
+*/
+#define ALG_FFT_PLAN_CACHE_SZ	(64)
+
+/*!
+* \def		ALG_FFT_GEN_MAX
+* \brief	Largest prime factor of a length transformed using the
+* 		general butterfly, lengths with larger prime factors are
+* 		transformed using Bluestein's algorithm.
+*/
+#define ALG_FFT_GEN_MAX		(31)
+
+/*!
+* \def		ALG_FFT_BATCH
+* \brief	Maximum number of adjacent strided lines which are gathered
+* 		and transformed together, so that each cache line read
+* 		or written holds data of several lines.
+*/
+#define ALG_FFT_BATCH		(16)
+
+/* Constants of the radix 3, 5 and 7 butterflies. */
+#define ALG_FFT_S3	(0.86602540378443864676)
+#define ALG_FFT_C5_1	(0.30901699437494742410)
+#define ALG_FFT_C5_2	(-0.80901699437494742410)
+#define ALG_FFT_S5_1	(0.95105651629515357212)
+#define ALG_FFT_S5_2	(0.58778525229247312917)
+#define ALG_FFT_C7_1	(0.62348980185873353053)
+#define ALG_FFT_C7_2	(-0.22252093395631440429)
+#define ALG_FFT_C7_3	(-0.90096886790241912624)
+#define ALG_FFT_S7_1	(0.78183148246802980871)
+#define ALG_FFT_S7_2	(0.97492791218182360702)
+#define ALG_FFT_S7_3	(0.43388373911755812048)
+
+static void			AlgFFTPlanDelete(
+				  AlgFFTPlan *plan);
+static int			AlgFFTRadixIsGen(
+				  int p);
+static AlgError			AlgFFTPlanFactor(
+				  AlgFFTPlan *plan);
+static AlgError			AlgFFTPlanBluestein(
+				  AlgFFTPlan *plan);
+static void			AlgFFTStagesD(
+				  AlgFFTPlan *plan,
+				  double *re,
+				  double *im,
+				  double *tmp);
+static void			AlgFFTStagesF(
+				  AlgFFTPlan *plan,
+				  float *re,
+				  float *im,
+				  float *tmp);
+static void			AlgFFTBatchD(
+				  AlgFFTPlan *plan,
+				  double *re,
+				  double *im,
+				  int step,
+				  int nB,
+				  AlgFFTDir dir,
+				  double *wrk);
+static void			AlgFFTBatchF(
+				  AlgFFTPlan *plan,
+				  float *re,
+				  float *im,
+				  int step,
+				  int nB,
+				  AlgFFTDir dir,
+				  float *wrk);
+static void			AlgFFTBluesteinD(
+				  AlgFFTPlan *plan,
+				  double *re,
+				  double *im,
+				  double *tmp);
+static void			AlgFFTBluesteinF(
+				  AlgFFTPlan *plan,
+				  float *re,
+				  float *im,
+				  float *tmp);
+static void			AlgFFTRadix2D(
+				  double *re,
+				  double *im,
+				  int n,
+				  int m,
+				  const double *twRe,
+				  const double *twIm);
+static void			AlgFFTRadix3D(
+				  double *re,
+				  double *im,
+				  int n,
+				  int m,
+				  const double *twRe,
+				  const double *twIm);
+static void			AlgFFTRadix4D(
+				  double *re,
+				  double *im,
+				  int n,
+				  int m,
+				  const double *twRe,
+				  const double *twIm);
+static void			AlgFFTRadix5D(
+				  double *re,
+				  double *im,
+				  int n,
+				  int m,
+				  const double *twRe,
+				  const double *twIm);
+static void			AlgFFTRadix7D(
+				  double *re,
+				  double *im,
+				  int n,
+				  int m,
+				  const double *twRe,
+				  const double *twIm);
+static void			AlgFFTRadixGenD(
+				  double *re,
+				  double *im,
+				  int n,
+				  int m,
+				  int p,
+				  const double *twRe,
+				  const double *twIm,
+				  double *tmp);
+static void			AlgFFTRadix2F(
+				  float *re,
+				  float *im,
+				  int n,
+				  int m,
+				  const float *twRe,
+				  const float *twIm);
+static void			AlgFFTRadix3F(
+				  float *re,
+				  float *im,
+				  int n,
+				  int m,
+				  const float *twRe,
+				  const float *twIm);
+static void			AlgFFTRadix4F(
+				  float *re,
+				  float *im,
+				  int n,
+				  int m,
+				  const float *twRe,
+				  const float *twIm);
+static void			AlgFFTRadix5F(
+				  float *re,
+				  float *im,
+				  int n,
+				  int m,
+				  const float *twRe,
+				  const float *twIm);
+static void			AlgFFTRadix7F(
+				  float *re,
+				  float *im,
+				  int n,
+				  int m,
+				  const float *twRe,
+				  const float *twIm);
+static void			AlgFFTRadixGenF(
+				  float *re,
+				  float *im,
+				  int n,
+				  int m,
+				  int p,
+				  const float *twRe,
+				  const float *twIm,
+				  float *tmp);
+static AlgError			AlgFFTRepCpx(
+				  void *re,
+				  void *im,
+				  int flt,
+				  int nX,
+				  int nY,
+				  int nZ,
+				  int axis,
+				  AlgFFTDir dir);
+static AlgError			AlgFFTRepReal(
+				  void *data,
+				  int flt,
+				  int nX,
+				  int nY,
+				  int nZ,
+				  int axis,
+				  AlgFFTDir dir);
+static int			AlgFFTNumThreads(void);
+
+static AlgFFTPlan		*algFFTPlanCache[ALG_FFT_PLAN_CACHE_SZ];
+static int			algFFTPlanCacheNxt = 0;
+
+/*!
+* \return	The smallest length which is not less than the given length.
+* \ingroup	AlgFourier
+* \brief	Computes a length, not less than the given length, which
+* 		has no prime factors other than 2, 3, 5 and 7 and so can
+* 		be transformed efficiently. Data which are padded for
+* 		transforming should be padded to this length rather than
+* 		to the next power of two.
+* \param	num			Given length.
+* \param	even			If non-zero the length must be even,
+* 					as required for transforms of
+* 					real data.
+*/
+int		AlgFFTGoodSize(int num, int even)
+{
+  int		n,
+  		good = 0;
+
+  if(num < 1)
+  {
+    num = 1;
+  }
+  while(!good)
+  {
+    n = num;
+    if(!even || ((n % 2) == 0))
+    {
+      while((n % 2) == 0)
+      {
+	n /= 2;
+      }
+      while((n % 3) == 0)
+      {
+	n /= 3;
+      }
+      while((n % 5) == 0)
+      {
+	n /= 5;
+      }
+      while((n % 7) == 0)
+      {
+	n /= 7;
+      }
+    }
+    if(n == 1)
+    {
+      good = 1;
+    }
+    else
+    {
+      ++num;
+    }
+  }
+  return(num);
+}
+
+/*!
+* \return	New plan or NULL on error.
+* \ingroup	AlgFourier
+* \brief	Makes a new fast Fourier transform plan for the given
+* 		transform length. The plan should be freed using
+* 		AlgFFTPlanFree(). Most callers should use AlgFFTPlanGet()
+* 		which shares plans through a cache.
+* \param	num			Transform length, which must be
+* 					even for real data.
+* \param	real			Non-zero for a plan for real data.
+* \param	dstErr			Destination error pointer, may be
+* 					NULL.
+*/
+AlgFFTPlan	*AlgFFTPlanNew(int num, int real, AlgError *dstErr)
+{
+  AlgFFTPlan	*plan = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFFTPlanNew FE %d %d\n",
+	   num, real));
+  if((num < 1) || (real && ((num % 2) != 0)))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else if((plan = (AlgFFTPlan *)AlcCalloc(1, sizeof(AlgFFTPlan))) == NULL)
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  else
+  {
+    plan->linkcount = 1;
+    plan->num = num;
+    plan->real = (real != 0);
+  }
+  if((errNum == ALG_ERR_NONE) && real)
+  {
+    int		k,
+    		m;
+
+    /* Real data use a complex plan of half the length and the twiddle
+     * factors exp(-2 pi i k / num) for 0 <= k <= num / 2. */
+    m = num / 2;
+    plan->half = AlgFFTPlanNew(m, 0, &errNum);
+    if(errNum == ALG_ERR_NONE)
+    {
+      plan->wrkSz = plan->half->wrkSz;
+      if(((plan->twRe = (double *)
+                        AlcMalloc(sizeof(double) * 2 * (m + 1))) == NULL) ||
+         ((plan->twReF = (float *)
+	                 AlcMalloc(sizeof(float) * 2 * (m + 1))) == NULL))
+      {
+        errNum = ALG_ERR_MALLOC;
+      }
+    }
+    if(errNum == ALG_ERR_NONE)
+    {
+      plan->twIm = plan->twRe + m + 1;
+      plan->twImF = plan->twReF + m + 1;
+      for(k = 0; k <= m; ++k)
+      {
+	double	a;
+
+	a = (-2.0 * ALG_M_PI * k) / num;
+	*(plan->twRe + k) = cos(a);
+	*(plan->twIm + k) = sin(a);
+	*(plan->twReF + k) = (float )*(plan->twRe + k);
+	*(plan->twImF + k) = (float )*(plan->twIm + k);
+      }
+    }
+  }
+  else if(errNum == ALG_ERR_NONE)
+  {
+    errNum = AlgFFTPlanFactor(plan);
+  }
+  if(errNum != ALG_ERR_NONE)
+  {
+    AlgFFTPlanDelete(plan);
+    plan = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFFTPlanNew FX %p\n",
+	   plan));
+  return(plan);
+}
+
+/*!
+* \return	Plan or NULL on error.
+* \ingroup	AlgFourier
+* \brief	Gets a fast Fourier transform plan for the given transform
+* 		length, either from the plan cache or by making a new
+* 		plan which is then added to the cache. The returned plan
+* 		should be released using AlgFFTPlanFree() when no longer
+* 		required. When the cache is full the least recently added
+* 		plan is dropped from it, but that plan remains valid
+* 		until all it's users have freed it.
+* \param	num			Transform length, which must be
+* 					even for real data.
+* \param	real			Non-zero for a plan for real data.
+* \param	dstErr			Destination error pointer, may be
+* 					NULL.
+*/
+AlgFFTPlan	*AlgFFTPlanGet(int num, int real, AlgError *dstErr)
+{
+  int		idx;
+  AlgFFTPlan	*plan = NULL,
+  		*newPlan = NULL,
+		*oldPlan = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  real = (real != 0);
+#ifdef _OPENMP
+#pragma omp critical (AlgFFTPlanCache)
+  {
+#endif
+    for(idx = 0; idx < ALG_FFT_PLAN_CACHE_SZ; ++idx)
+    {
+      AlgFFTPlan *p;
+
+      p = algFFTPlanCache[idx];
+      if(p && (p->num == num) && (p->real == real))
+      {
+	++(p->linkcount);
+	plan = p;
+	break;
+      }
+    }
+#ifdef _OPENMP
+  }
+#endif
+  if(plan == NULL)
+  {
+    /* Make the plan outside of the critical section and then check that
+     * another thread has not added the same plan in the meantime. */
+    newPlan = AlgFFTPlanNew(num, real, &errNum);
+    if(errNum == ALG_ERR_NONE)
+    {
+#ifdef _OPENMP
+#pragma omp critical (AlgFFTPlanCache)
+      {
+#endif
+	for(idx = 0; idx < ALG_FFT_PLAN_CACHE_SZ; ++idx)
+	{
+	  AlgFFTPlan *p;
+
+	  p = algFFTPlanCache[idx];
+	  if(p && (p->num == num) && (p->real == real))
+	  {
+	    ++(p->linkcount);
+	    plan = p;
+	    break;
+	  }
+	}
+	if(plan == NULL)
+	{
+	  idx = algFFTPlanCacheNxt;
+	  algFFTPlanCacheNxt = (idx + 1) % ALG_FFT_PLAN_CACHE_SZ;
+	  oldPlan = algFFTPlanCache[idx];
+	  if(oldPlan && (--(oldPlan->linkcount) > 0))
+	  {
+	    oldPlan = NULL;
+	  }
+	  algFFTPlanCache[idx] = newPlan;
+	  ++(newPlan->linkcount);
+	  plan = newPlan;
+	  newPlan = NULL;
+	}
+#ifdef _OPENMP
+      }
+#endif
+    }
+  }
+  AlgFFTPlanDelete(newPlan);
+  AlgFFTPlanDelete(oldPlan);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(plan);
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Decrements the usage count of the given plan and frees it
+* 		if it is no longer used.
+* \param	plan			Given plan, may be NULL.
+*/
+void		AlgFFTPlanFree(AlgFFTPlan *plan)
+{
+  int		del = 0;
+
+  if(plan)
+  {
+#ifdef _OPENMP
+#pragma omp critical (AlgFFTPlanCache)
+    {
+#endif
+      del = (--(plan->linkcount) <= 0);
+#ifdef _OPENMP
+    }
+#endif
+    if(del)
+    {
+      AlgFFTPlanDelete(plan);
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Empties the plan cache, freeing all cached plans which
+* 		are not in use.
+*/
+void		AlgFFTPlanCacheFree(void)
+{
+  int		idx;
+  AlgFFTPlan	*plans[ALG_FFT_PLAN_CACHE_SZ];
+
+#ifdef _OPENMP
+#pragma omp critical (AlgFFTPlanCache)
+  {
+#endif
+    for(idx = 0; idx < ALG_FFT_PLAN_CACHE_SZ; ++idx)
+    {
+      plans[idx] = algFFTPlanCache[idx];
+      algFFTPlanCache[idx] = NULL;
+      if(plans[idx] && (--(plans[idx]->linkcount) > 0))
+      {
+        plans[idx] = NULL;
+      }
+    }
+    algFFTPlanCacheNxt = 0;
+#ifdef _OPENMP
+  }
+#endif
+  for(idx = 0; idx < ALG_FFT_PLAN_CACHE_SZ; ++idx)
+  {
+    AlgFFTPlanDelete(plans[idx]);
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Frees the given plan regardless of it's usage count.
+* \param	plan			Given plan, may be NULL.
+*/
+static void	AlgFFTPlanDelete(AlgFFTPlan *plan)
+{
+  if(plan)
+  {
+    AlgFFTPlanFree(plan->half);
+    AlgFFTPlanFree(plan->conv);
+    AlcFree(plan->perm);
+    AlcFree(plan->twRe);
+    AlcFree(plan->twReF);
+    AlcFree(plan);
+  }
+}
+
+/*!
+* \return	Non-zero if the radix requires the general butterfly.
+* \ingroup	AlgFourier
+* \brief	Tests whether there is a specific butterfly for the given
+* 		radix.
+* \param	p			Given radix.
+*/
+static int	AlgFFTRadixIsGen(int p)
+{
+  return((p != 2) && (p != 3) && (p != 4) && (p != 5) && (p != 7));
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Factors the length of the given complex plan into
+* 		butterfly stages and computes the plan's digit reversal
+* 		permutation, twiddle factors and workspace size.
+* 		For a stage of radix \f$p\f$ which combines \f$p\f$
+* 		transforms of length \f$m\f$ the twiddle factors are
+* 		\f$e^{-2 \pi i q k / (p m)}\f$, stored for
+* 		\f$q = 1, \ldots, p - 1\f$ each with
+* 		\f$k = 0, \ldots, m - 1\f$, followed by the \f$p\f$th
+* 		roots of unity if the stage uses the general butterfly.
+* \param	plan			Given plan with it's length set.
+*/
+static AlgError	AlgFFTPlanFactor(AlgFFTPlan *plan)
+{
+  int		i,
+		m,
+		n,
+  		p,
+		s,
+		nTw = 0,
+		blue = 0,
+		maxGen = 0;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  /* Factor the length, radix 4 first then 2, 3, 5, 7 and any other
+   * primes. */
+  n = plan->num;
+  p = 4;
+  while((n > 1) && (errNum == ALG_ERR_NONE))
+  {
+    if((n % p) == 0)
+    {
+      if(plan->nStage >= ALG_FFT_MAX_STAGE)
+      {
+        errNum = ALG_ERR_FUNC;
+      }
+      else
+      {
+	plan->radix[plan->nStage++] = p;
+	n /= p;
+      }
+    }
+    else
+    {
+      switch(p)
+      {
+        case 4:
+	  p = 2;
+	  break;
+	case 2:
+	  p = 3;
+	  break;
+	default:
+	  p += 2;
+	  break;
+      }
+    }
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    m = 1;
+    for(s = 0; s < plan->nStage; ++s)
+    {
+      p = plan->radix[s];
+      nTw += (p - 1) * m;
+      if(AlgFFTRadixIsGen(p))
+      {
+        nTw += p;
+	if(p > maxGen)
+	{
+	  maxGen = p;
+	}
+      }
+      m *= p;
+    }
+    /* The general butterfly is O(p^2) so use Bluestein's algorithm for
+     * lengths with large prime factors. */
+    blue = maxGen > ALG_FFT_GEN_MAX;
+  }
+  if(blue)
+  {
+    errNum = AlgFFTPlanBluestein(plan);
+  }
+  else if(errNum == ALG_ERR_NONE)
+  {
+    plan->wrkSz = 2 * (plan->num + maxGen);
+    if(((plan->perm = (int *)AlcMalloc(sizeof(int) * plan->num)) == NULL) ||
+       ((plan->twRe = (double *)
+                      AlcMalloc(sizeof(double) * 2 * (nTw + 1))) == NULL) ||
+       ((plan->twReF = (float *)
+                       AlcMalloc(sizeof(float) * 2 * (nTw + 1))) == NULL))
+    {
+      errNum = ALG_ERR_MALLOC;
+    }
+  }
+  if((errNum == ALG_ERR_NONE) && !blue)
+  {
+    /* Compute the digit reversal permutation. The lowest digit of an input
+     * index (in the radix of the last stage) selects the highest order
+     * block of the workspace. */
+    for(i = 0; i < plan->num; ++i)
+    {
+      int	pos = 0,
+      		r;
+
+      r = i;
+      m = plan->num;
+      for(s = plan->nStage - 1; s >= 0; --s)
+      {
+        p = plan->radix[s];
+	m /= p;
+	pos += (r % p) * m;
+	r /= p;
+      }
+      *(plan->perm + pos) = i;
+    }
+    /* Compute the twiddle factors of each stage. */
+    plan->twIm = plan->twRe + nTw + 1;
+    plan->twImF = plan->twReF + nTw + 1;
+    nTw = 0;
+    m = 1;
+    for(s = 0; s < plan->nStage; ++s)
+    {
+      int	k,
+      		q,
+		l;
+
+      p = plan->radix[s];
+      l = p * m;
+      for(q = 1; q < p; ++q)
+      {
+        for(k = 0; k < m; ++k)
+	{
+	  double a;
+
+	  a = (-2.0 * ALG_M_PI * ((q * k) % l)) / l;
+	  *(plan->twRe + nTw) = cos(a);
+	  *(plan->twIm + nTw) = sin(a);
+	  ++nTw;
+	}
+      }
+      if(AlgFFTRadixIsGen(p))
+      {
+        for(q = 0; q < p; ++q)
+	{
+	  double a;
+
+	  a = (-2.0 * ALG_M_PI * q) / p;
+	  *(plan->twRe + nTw) = cos(a);
+	  *(plan->twIm + nTw) = sin(a);
+	  ++nTw;
+	}
+      }
+      m = l;
+    }
+    for(i = 0; i < nTw; ++i)
+    {
+      *(plan->twReF + i) = (float )*(plan->twRe + i);
+      *(plan->twImF + i) = (float )*(plan->twIm + i);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Sets up the given complex plan to use Bluestein's
+* 		algorithm, which computes a transform of length \f$n\f$
+* 		as a circular convolution of length \f$M \geq 2n - 1\f$
+* 		using
+* 		\f$X_k = w_k \sum_j (x_j w_j) \overline{w_{k - j}}\f$
+* 		with the chirp \f$w_j = e^{-\pi i j^2 / n}\f$.
+* 		The plan's twiddle factors hold the chirp followed by the
+* 		transform of the convolution kernel
+* 		\f$\overline{w_j}\f$, which is scaled by \f$1/M\f$ so
+* 		that the convolution's inverse transform is normalised.
+* 		The permutation is the identity so that the plan may be
+* 		used in the same way as any other plan.
+* \param	plan			Given plan with it's length set.
+*/
+static AlgError	AlgFFTPlanBluestein(AlgFFTPlan *plan)
+{
+  int		j,
+  		n,
+		m;
+  unsigned int	p;
+  double	s;
+  double	*kRe,
+  		*kIm;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  n = plan->num;
+  /* A power of two convolution length is used unless a good length is
+   * much shorter, since the radix 4 butterflies are the fastest. */
+  m = AlgFFTGoodSize((2 * n) - 1, 0);
+  (void )AlgBitNextPowerOfTwo(&p, m);
+  if((4 * p) <= (5 * (unsigned int )m))
+  {
+    m = p;
+  }
+  plan->nStage = 0;
+  plan->conv = AlgFFTPlanNew(m, 0, &errNum);
+  if(errNum == ALG_ERR_NONE)
+  {
+    plan->wrkSz = (2 * (n + m)) + plan->conv->wrkSz;
+    if(((plan->perm = (int *)AlcMalloc(sizeof(int) * n)) == NULL) ||
+       ((plan->twRe = (double *)
+                      AlcCalloc(2 * (n + m), sizeof(double))) == NULL) ||
+       ((plan->twReF = (float *)
+                       AlcMalloc(sizeof(float) * 2 * (n + m))) == NULL))
+    {
+      errNum = ALG_ERR_MALLOC;
+    }
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    plan->twIm = plan->twRe + n + m;
+    plan->twImF = plan->twReF + n + m;
+    kRe = plan->twRe + n;
+    kIm = plan->twIm + n;
+    for(j = 0; j < n; ++j)
+    {
+      double	a;
+
+      /* Reduce j^2 modulo 2n to keep the chirp accurate for long
+       * transforms. */
+      a = (-ALG_M_PI * (double )(((size_t )j * j) % (2 * (size_t )n))) / n;
+      *(plan->perm + j) = j;
+      *(plan->twRe + j) = cos(a);
+      *(plan->twIm + j) = sin(a);
+      *(kRe + j) = *(plan->twRe + j);
+      *(kIm + j) = -*(plan->twIm + j);
+      if(j > 0)
+      {
+	*(kRe + m - j) = *(kRe + j);
+	*(kIm + m - j) = *(kIm + j);
+      }
+    }
+    errNum = AlgFFTDbl1D(plan->conv, kRe, kIm, 1, ALG_FFT_DIR_FWD, NULL);
+  }
+  if(errNum == ALG_ERR_NONE)
+  {
+    s = 1.0 / m;
+    for(j = 0; j < m; ++j)
+    {
+      *(kRe + j) *= s;
+      *(kIm + j) *= s;
+    }
+    for(j = 0; j < n + m; ++j)
+    {
+      *(plan->twReF + j) = (float )*(plan->twRe + j);
+      *(plan->twImF + j) = (float )*(plan->twIm + j);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the fast Fourier transform of the given one
+* 		dimensional double precision complex data, in place,
+* 		using the given plan.
+* \param	plan			Given complex plan.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	step			Offset in data elements between
+* 					the data to be transformed.
+* \param	dir			Transform direction.
+* \param	wrk			Workspace of at least plan->wrkSz
+* 					elements, may be NULL in which case
+* 					a workspace is allocated.
+*/
+AlgError	AlgFFTDbl1D(AlgFFTPlan *plan, double *re, double *im,
+			    int step, AlgFFTDir dir, double *wrk)
+{
+  int		k,
+  		n;
+  double	*bRe,
+  		*bIm,
+		*sRe,
+		*sIm,
+		*buf = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((plan == NULL) || plan->real || (re == NULL) || (im == NULL))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else if((wrk == NULL) &&
+          ((wrk = buf = (double *)
+	              AlcMalloc(sizeof(double) * plan->wrkSz)) == NULL))
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  else
+  {
+    n = plan->num;
+    bRe = wrk;
+    bIm = wrk + n;
+    /* The inverse transform is the forward transform with the real and
+     * imaginary parts exchanged on input and output. */
+    if(dir == ALG_FFT_DIR_FWD)
+    {
+      sRe = re;
+      sIm = im;
+    }
+    else
+    {
+      sRe = im;
+      sIm = re;
+    }
+    for(k = 0; k < n; ++k)
+    {
+      size_t	off;
+
+      off = (size_t )*(plan->perm + k) * step;
+      *(bRe + k) = *(sRe + off);
+      *(bIm + k) = *(sIm + off);
+    }
+    AlgFFTStagesD(plan, bRe, bIm, bIm + n);
+    for(k = 0; k < n; ++k)
+    {
+      *sRe = *(bRe + k);
+      *sIm = *(bIm + k);
+      sRe += step;
+      sIm += step;
+    }
+  }
+  AlcFree(buf);
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the fast Fourier transform of the given one
+* 		dimensional double precision real data, in place, using
+* 		the given real data plan. The forward transform packs
+* 		the transformed data as
+* 		\f$r_0, r_1, \ldots, r_M, i_1, \ldots, i_{M-1}\f$
+* 		where \f$N = 2M\f$ is the length of the plan and the
+* 		inverse transform expects data with this layout.
+* \param	plan			Given real data plan.
+* \param	data			Given data.
+* \param	step			Offset in data elements between
+* 					the data to be transformed.
+* \param	dir			Transform direction.
+* \param	wrk			Workspace of at least plan->wrkSz
+* 					elements, may be NULL in which case
+* 					a workspace is allocated.
+*/
+AlgError	AlgFFTRealDbl1D(AlgFFTPlan *plan, double *data,
+			        int step, AlgFFTDir dir, double *wrk)
+{
+  int		k,
+  		m;
+  double	*bRe,
+  		*bIm,
+		*buf = NULL;
+  AlgFFTPlan	*hp;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((plan == NULL) || !(plan->real) || (data == NULL))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else if((wrk == NULL) &&
+          ((wrk = buf = (double *)
+	              AlcMalloc(sizeof(double) * plan->wrkSz)) == NULL))
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  else
+  {
+    hp = plan->half;
+    m = hp->num;
+    bRe = wrk;
+    bIm = wrk + m;
+    if(dir == ALG_FFT_DIR_FWD)
+    {
+      double	*d0,
+      		*d1;
+
+      /* Transform z_j = x_{2j} + i x_{2j + 1}. */
+      for(k = 0; k < m; ++k)
+      {
+	size_t	off;
+
+	off = (size_t )*(hp->perm + k) * 2 * step;
+	*(bRe + k) = *(data + off);
+	*(bIm + k) = *(data + off + step);
+      }
+      AlgFFTStagesD(hp, bRe, bIm, bIm + m);
+      /* Unpack X_k = E_k + exp(-2 pi i k / N) O_k, with
+       * E_k = (Z_k + Z*_{M-k}) / 2 and O_k = (Z_k - Z*_{M-k}) / 2i. */
+      *data = *bRe + *bIm;
+      *(data + (size_t )m * step) = *bRe - *bIm;
+      d0 = data + step;
+      d1 = data + (size_t )(m + 1) * step;
+      for(k = 1; k < m; ++k)
+      {
+	double	eR,
+		eI,
+		oR,
+		oI,
+		wR,
+		wI;
+
+	eR = 0.5 * (*(bRe + k) + *(bRe + m - k));
+	eI = 0.5 * (*(bIm + k) - *(bIm + m - k));
+	oR = 0.5 * (*(bIm + k) + *(bIm + m - k));
+	oI = -0.5 * (*(bRe + k) - *(bRe + m - k));
+	wR = *(plan->twRe + k);
+	wI = *(plan->twIm + k);
+	*d0 = eR + (oR * wR) - (oI * wI);
+	*d1 = eI + (oR * wI) + (oI * wR);
+	d0 += step;
+	d1 += step;
+      }
+    }
+    else
+    {
+      /* Pack Z_k = (X_k + X*_{M-k}) + i exp(2 pi i k / N)(X_k - X*_{M-k})
+       * directly into the digit reversed workspace, exchanging the real
+       * and imaginary parts for the inverse transform. */
+      for(k = 0; k < m; ++k)
+      {
+	int	j;
+	double	xR,
+		xI,
+		yR,
+		yI,
+		dR,
+		dI,
+		wR,
+		wI;
+
+	j = *(hp->perm + k);
+	xR = *(data + (size_t )j * step);
+	yR = *(data + (size_t )(m - j) * step);
+	if(j == 0)
+	{
+	  xI = yI = 0.0;
+	}
+	else
+	{
+	  xI = *(data + (size_t )(m + j) * step);
+	  yI = *(data + (size_t )(2 * m - j) * step);
+	}
+	wR = *(plan->twRe + j);
+	wI = -*(plan->twIm + j);
+	dR = xR - yR;
+	dI = xI + yI;
+	*(bIm + k) = xR + yR - ((dR * wI) + (dI * wR));
+	*(bRe + k) = xI - yI + ((dR * wR) - (dI * wI));
+      }
+      AlgFFTStagesD(hp, bRe, bIm, bIm + m);
+      for(k = 0; k < m; ++k)
+      {
+	size_t	off;
+
+	off = (size_t )k * 2 * step;
+        *(data + off) = *(bIm + k);
+        *(data + off + step) = *(bRe + k);
+      }
+    }
+  }
+  AlcFree(buf);
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Computes the fast Fourier transforms of a batch of adjacent
+* 		lines of double precision complex data, in place, using
+* 		the given plan. The data of the lines are gathered into
+* 		digit reversed order with the lines innermost, so that
+* 		strided data are read and written a row at a time.
+* \param	plan			Given complex plan.
+* \param	re			Real parts of the data of the first
+* 					line.
+* \param	im			Imaginary parts of the data of the
+* 					first line.
+* \param	step			Offset in data elements between
+* 					the data of a line.
+* \param	nB			Number of lines, the lines are at
+* 					unit offsets from each other.
+* \param	dir			Transform direction.
+* \param	wrk			Workspace of at least
+* 					plan->wrkSz + 2 nB plan->num elements.
+*/
+static void	AlgFFTBatchD(AlgFFTPlan *plan, double *re, double *im,
+			     int step, int nB, AlgFFTDir dir, double *wrk)
+{
+  int		b,
+  		k,
+		n;
+  double	*bRe,
+  		*bIm,
+		*sRe,
+		*sIm;
+
+  n = plan->num;
+  bRe = wrk;
+  bIm = wrk + ((size_t )nB * n);
+  if(dir == ALG_FFT_DIR_FWD)
+  {
+    sRe = re;
+    sIm = im;
+  }
+  else
+  {
+    sRe = im;
+    sIm = re;
+  }
+  for(k = 0; k < n; ++k)
+  {
+    size_t	off;
+
+    off = (size_t )*(plan->perm + k) * step;
+    for(b = 0; b < nB; ++b)
+    {
+      *(bRe + ((size_t )b * n) + k) = *(sRe + off + b);
+      *(bIm + ((size_t )b * n) + k) = *(sIm + off + b);
+    }
+  }
+  for(b = 0; b < nB; ++b)
+  {
+    AlgFFTStagesD(plan, bRe + ((size_t )b * n), bIm + ((size_t )b * n),
+                  bIm + ((size_t )nB * n));
+  }
+  for(k = 0; k < n; ++k)
+  {
+    for(b = 0; b < nB; ++b)
+    {
+      *(sRe + b) = *(bRe + ((size_t )b * n) + k);
+      *(sIm + b) = *(bIm + ((size_t )b * n) + k);
+    }
+    sRe += step;
+    sIm += step;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Applies the butterfly stages of the given complex plan to
+* 		the given double precision digit reversed data.
+* \param	plan			Given complex plan.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	tmp			Workspace for the general butterfly or
+* 					Bluestein's algorithm.
+*/
+static void	AlgFFTStagesD(AlgFFTPlan *plan, double *re, double *im,
+			      double *tmp)
+{
+  int		m,
+		n,
+  		p,
+		s;
+  const double	*twRe,
+  		*twIm;
+
+  if(plan->conv)
+  {
+    AlgFFTBluesteinD(plan, re, im, tmp);
+  }
+  else
+  {
+    m = 1;
+    n = plan->num;
+    twRe = plan->twRe;
+    twIm = plan->twIm;
+    for(s = 0; s < plan->nStage; ++s)
+    {
+      p = plan->radix[s];
+      switch(p)
+      {
+        case 2:
+          AlgFFTRadix2D(re, im, n, m, twRe, twIm);
+	  break;
+        case 3:
+          AlgFFTRadix3D(re, im, n, m, twRe, twIm);
+	  break;
+        case 4:
+          AlgFFTRadix4D(re, im, n, m, twRe, twIm);
+	  break;
+        case 5:
+          AlgFFTRadix5D(re, im, n, m, twRe, twIm);
+	  break;
+        case 7:
+          AlgFFTRadix7D(re, im, n, m, twRe, twIm);
+	  break;
+        default:
+          AlgFFTRadixGenD(re, im, n, m, p, twRe, twIm, tmp);
+	  twRe += p;
+	  twIm += p;
+	  break;
+      }
+      twRe += (p - 1) * m;
+      twIm += (p - 1) * m;
+      m *= p;
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Computes the transform of the given double precision
+* 		data in place using Bluestein's algorithm, see
+* 		AlgFFTPlanBluestein(). The chirp and kernel products are
+* 		computed while gathering the data into digit reversed
+* 		order so that the butterfly stages of the convolution
+* 		plan may be applied directly.
+* \param	plan			Given Bluestein plan.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	tmp			Workspace of at least
+* 					plan->wrkSz - 2 plan->num elements.
+*/
+static void	AlgFFTBluesteinD(AlgFFTPlan *plan, double *re, double *im,
+				 double *tmp)
+{
+  int		j,
+  		k,
+  		m,
+		n;
+  double	*aRe,
+  		*aIm,
+		*bRe,
+		*bIm;
+  const int	*perm;
+  const double	*wRe,
+  		*wIm,
+		*kRe,
+		*kIm;
+
+  n = plan->num;
+  m = plan->conv->num;
+  perm = plan->conv->perm;
+  aRe = tmp;
+  aIm = tmp + m;
+  bRe = tmp + (2 * m);
+  bIm = tmp + (3 * m);
+  wRe = plan->twRe;
+  wIm = plan->twIm;
+  kRe = wRe + n;
+  kIm = wIm + n;
+  for(k = 0; k < m; ++k)
+  {
+    j = *(perm + k);
+    if(j < n)
+    {
+      *(aRe + k) = (*(re + j) * *(wRe + j)) - (*(im + j) * *(wIm + j));
+      *(aIm + k) = (*(re + j) * *(wIm + j)) + (*(im + j) * *(wRe + j));
+    }
+    else
+    {
+      *(aRe + k) = *(aIm + k) = 0.0;
+    }
+  }
+  AlgFFTStagesD(plan->conv, aRe, aIm, bRe);
+  /* Multiply by the transformed kernel, exchanging the real and
+   * imaginary parts for the inverse transform. */
+  for(k = 0; k < m; ++k)
+  {
+    j = *(perm + k);
+    *(bIm + k) = (*(aRe + j) * *(kRe + j)) - (*(aIm + j) * *(kIm + j));
+    *(bRe + k) = (*(aRe + j) * *(kIm + j)) + (*(aIm + j) * *(kRe + j));
+  }
+  AlgFFTStagesD(plan->conv, bRe, bIm, aRe);
+  for(k = 0; k < n; ++k)
+  {
+    *(re + k) = (*(bIm + k) * *(wRe + k)) - (*(bRe + k) * *(wIm + k));
+    *(im + k) = (*(bIm + k) * *(wIm + k)) + (*(bRe + k) * *(wRe + k));
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Applies a radix 2 butterfly stage to double precision data,
+* 		combining pairs of transforms of length m.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	n			Number of data.
+* \param	m			Length of the transforms combined.
+* \param	twRe			Real parts of the stage twiddles.
+* \param	twIm			Imaginary parts of the stage twiddles.
+*/
+static void	AlgFFTRadix2D(double *re, double *im, int n, int m,
+			      const double *twRe, const double *twIm)
+{
+  int		b,
+  		k;
+
+  if(m == 1)
+  {
+    /* The twiddle factors of the first stage are all one. */
+    for(b = 0; b < n; b += 2)
+    {
+      double	tR,
+      		tI;
+
+      tR = *(re + b + 1);
+      tI = *(im + b + 1);
+      *(re + b + 1) = *(re + b) - tR;
+      *(im + b + 1) = *(im + b) - tI;
+      *(re + b) += tR;
+      *(im + b) += tI;
+    }
+  }
+  else
+  {
+    for(b = 0; b < n; b += 2 * m)
+    {
+      double	*r0,
+    		*r1,
+		*i0,
+		*i1;
+
+      r0 = re + b;
+      r1 = r0 + m;
+      i0 = im + b;
+      i1 = i0 + m;
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+      for(k = 0; k < m; ++k)
+      {
+        double	tR,
+      		tI;
+
+        tR = (*(r1 + k) * *(twRe + k)) - (*(i1 + k) * *(twIm + k));
+        tI = (*(r1 + k) * *(twIm + k)) + (*(i1 + k) * *(twRe + k));
+        *(r1 + k) = *(r0 + k) - tR;
+        *(i1 + k) = *(i0 + k) - tI;
+        *(r0 + k) += tR;
+        *(i0 + k) += tI;
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Applies a radix 3 butterfly stage to double precision data,
+* 		combining triples of transforms of length m.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	n			Number of data.
+* \param	m			Length of the transforms combined.
+* \param	twRe			Real parts of the stage twiddles.
+* \param	twIm			Imaginary parts of the stage twiddles.
+*/
+static void	AlgFFTRadix3D(double *re, double *im, int n, int m,
+			      const double *twRe, const double *twIm)
+{
+  int		b,
+  		k;
+  const double	s3 = ALG_FFT_S3;
+
+  if(m == 1)
+  {
+    /* The twiddle factors of the first stage are all one. */
+    for(b = 0; b < n; b += 3)
+    {
+      double	sR,
+		sI,
+		dR,
+		dI,
+		tR,
+		tI;
+
+      sR = *(re + b + 1) + *(re + b + 2);
+      sI = *(im + b + 1) + *(im + b + 2);
+      dR = s3 * (*(re + b + 1) - *(re + b + 2));
+      dI = s3 * (*(im + b + 1) - *(im + b + 2));
+      tR = *(re + b) - (0.5 * sR);
+      tI = *(im + b) - (0.5 * sI);
+      *(re + b) += sR;
+      *(im + b) += sI;
+      *(re + b + 1) = tR + dI;
+      *(im + b + 1) = tI - dR;
+      *(re + b + 2) = tR - dI;
+      *(im + b + 2) = tI + dR;
+    }
+  }
+  else
+  {
+    for(b = 0; b < n; b += 3 * m)
+    {
+      double	*r0,
+    		*r1,
+    		*r2,
+		*i0,
+		*i1,
+		*i2;
+      const double *w1R,
+		  *w1I,
+		  *w2R,
+		  *w2I;
+
+      r0 = re + b;
+      r1 = r0 + m;
+      r2 = r1 + m;
+      i0 = im + b;
+      i1 = i0 + m;
+      i2 = i1 + m;
+      w1R = twRe;
+      w1I = twIm;
+      w2R = w1R + m;
+      w2I = w1I + m;
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+      for(k = 0; k < m; ++k)
+      {
+        double	a1R,
+      		a1I,
+		a2R,
+		a2I,
+		sR,
+		sI,
+		dR,
+		dI,
+		tR,
+		tI;
+
+        a1R = (*(r1 + k) * *(w1R + k)) - (*(i1 + k) * *(w1I + k));
+        a1I = (*(r1 + k) * *(w1I + k)) + (*(i1 + k) * *(w1R + k));
+        a2R = (*(r2 + k) * *(w2R + k)) - (*(i2 + k) * *(w2I + k));
+        a2I = (*(r2 + k) * *(w2I + k)) + (*(i2 + k) * *(w2R + k));
+        sR = a1R + a2R;
+        sI = a1I + a2I;
+        dR = s3 * (a1R - a2R);
+        dI = s3 * (a1I - a2I);
+        tR = *(r0 + k) - (0.5 * sR);
+        tI = *(i0 + k) - (0.5 * sI);
+        *(r0 + k) += sR;
+        *(i0 + k) += sI;
+        *(r1 + k) = tR + dI;
+        *(i1 + k) = tI - dR;
+        *(r2 + k) = tR - dI;
+        *(i2 + k) = tI + dR;
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Applies a radix 4 butterfly stage to double precision data,
+* 		combining quadruples of transforms of length m.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	n			Number of data.
+* \param	m			Length of the transforms combined.
+* \param	twRe			Real parts of the stage twiddles.
+* \param	twIm			Imaginary parts of the stage twiddles.
+*/
+static void	AlgFFTRadix4D(double *re, double *im, int n, int m,
+			      const double *twRe, const double *twIm)
+{
+  int		b,
+  		k;
+
+  if(m == 1)
+  {
+    /* The twiddle factors of the first stage are all one. */
+    for(b = 0; b < n; b += 4)
+    {
+      double	t0R,
+		t0I,
+		t1R,
+		t1I,
+		t2R,
+		t2I,
+		t3R,
+		t3I;
+
+      t0R = *(re + b) + *(re + b + 2);
+      t0I = *(im + b) + *(im + b + 2);
+      t1R = *(re + b) - *(re + b + 2);
+      t1I = *(im + b) - *(im + b + 2);
+      t2R = *(re + b + 1) + *(re + b + 3);
+      t2I = *(im + b + 1) + *(im + b + 3);
+      t3R = *(re + b + 1) - *(re + b + 3);
+      t3I = *(im + b + 1) - *(im + b + 3);
+      *(re + b) = t0R + t2R;
+      *(im + b) = t0I + t2I;
+      *(re + b + 1) = t1R + t3I;
+      *(im + b + 1) = t1I - t3R;
+      *(re + b + 2) = t0R - t2R;
+      *(im + b + 2) = t0I - t2I;
+      *(re + b + 3) = t1R - t3I;
+      *(im + b + 3) = t1I + t3R;
+    }
+  }
+  else
+  {
+    for(b = 0; b < n; b += 4 * m)
+    {
+      double	*r0,
+    		*r1,
+    		*r2,
+    		*r3,
+		*i0,
+		*i1,
+		*i2,
+		*i3;
+      const double *w1R,
+		  *w1I,
+		  *w2R,
+		  *w2I,
+		  *w3R,
+		  *w3I;
+
+      r0 = re + b;
+      r1 = r0 + m;
+      r2 = r1 + m;
+      r3 = r2 + m;
+      i0 = im + b;
+      i1 = i0 + m;
+      i2 = i1 + m;
+      i3 = i2 + m;
+      w1R = twRe;
+      w1I = twIm;
+      w2R = w1R + m;
+      w2I = w1I + m;
+      w3R = w2R + m;
+      w3I = w2I + m;
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+      for(k = 0; k < m; ++k)
+      {
+        double	a1R,
+      		a1I,
+		a2R,
+		a2I,
+		a3R,
+		a3I,
+		t0R,
+		t0I,
+		t1R,
+		t1I,
+		t2R,
+		t2I,
+		t3R,
+		t3I;
+
+        a1R = (*(r1 + k) * *(w1R + k)) - (*(i1 + k) * *(w1I + k));
+        a1I = (*(r1 + k) * *(w1I + k)) + (*(i1 + k) * *(w1R + k));
+        a2R = (*(r2 + k) * *(w2R + k)) - (*(i2 + k) * *(w2I + k));
+        a2I = (*(r2 + k) * *(w2I + k)) + (*(i2 + k) * *(w2R + k));
+        a3R = (*(r3 + k) * *(w3R + k)) - (*(i3 + k) * *(w3I + k));
+        a3I = (*(r3 + k) * *(w3I + k)) + (*(i3 + k) * *(w3R + k));
+        t0R = *(r0 + k) + a2R;
+        t0I = *(i0 + k) + a2I;
+        t1R = *(r0 + k) - a2R;
+        t1I = *(i0 + k) - a2I;
+        t2R = a1R + a3R;
+        t2I = a1I + a3I;
+        t3R = a1R - a3R;
+        t3I = a1I - a3I;
+        *(r0 + k) = t0R + t2R;
+        *(i0 + k) = t0I + t2I;
+        *(r1 + k) = t1R + t3I;
+        *(i1 + k) = t1I - t3R;
+        *(r2 + k) = t0R - t2R;
+        *(i2 + k) = t0I - t2I;
+        *(r3 + k) = t1R - t3I;
+        *(i3 + k) = t1I + t3R;
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Applies a radix 5 butterfly stage to double precision data,
+* 		combining quintuples of transforms of length m.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	n			Number of data.
+* \param	m			Length of the transforms combined.
+* \param	twRe			Real parts of the stage twiddles.
+* \param	twIm			Imaginary parts of the stage twiddles.
+*/
+static void	AlgFFTRadix5D(double *re, double *im, int n, int m,
+			      const double *twRe, const double *twIm)
+{
+  int		b,
+  		k;
+  const double	c1 = ALG_FFT_C5_1,
+  		c2 = ALG_FFT_C5_2,
+		s1 = ALG_FFT_S5_1,
+		s2 = ALG_FFT_S5_2;
+
+  if(m == 1)
+  {
+    /* The twiddle factors of the first stage are all one. */
+    for(b = 0; b < n; b += 5)
+    {
+      double	s1R,
+		s1I,
+		s2R,
+		s2I,
+		d1R,
+		d1I,
+		d2R,
+		d2I,
+		cR,
+		cI,
+		sR,
+		sI;
+      double	*r,
+      		*i;
+
+      r = re + b;
+      i = im + b;
+      s1R = *(r + 1) + *(r + 4);
+      s1I = *(i + 1) + *(i + 4);
+      d1R = *(r + 1) - *(r + 4);
+      d1I = *(i + 1) - *(i + 4);
+      s2R = *(r + 2) + *(r + 3);
+      s2I = *(i + 2) + *(i + 3);
+      d2R = *(r + 2) - *(r + 3);
+      d2I = *(i + 2) - *(i + 3);
+      cR = *r + (c1 * s1R) + (c2 * s2R);
+      cI = *i + (c1 * s1I) + (c2 * s2I);
+      sR = (s1 * d1R) + (s2 * d2R);
+      sI = (s1 * d1I) + (s2 * d2I);
+      *(r + 1) = cR + sI;
+      *(i + 1) = cI - sR;
+      *(r + 4) = cR - sI;
+      *(i + 4) = cI + sR;
+      cR = *r + (c2 * s1R) + (c1 * s2R);
+      cI = *i + (c2 * s1I) + (c1 * s2I);
+      sR = (s2 * d1R) - (s1 * d2R);
+      sI = (s2 * d1I) - (s1 * d2I);
+      *(r + 2) = cR + sI;
+      *(i + 2) = cI - sR;
+      *(r + 3) = cR - sI;
+      *(i + 3) = cI + sR;
+      *r += s1R + s2R;
+      *i += s1I + s2I;
+    }
+  }
+  else
+  {
+    for(b = 0; b < n; b += 5 * m)
+    {
+      double	*r0,
+    		*r1,
+    		*r2,
+    		*r3,
+    		*r4,
+		*i0,
+		*i1,
+		*i2,
+		*i3,
+		*i4;
+
+      r0 = re + b;
+      r1 = r0 + m;
+      r2 = r1 + m;
+      r3 = r2 + m;
+      r4 = r3 + m;
+      i0 = im + b;
+      i1 = i0 + m;
+      i2 = i1 + m;
+      i3 = i2 + m;
+      i4 = i3 + m;
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+      for(k = 0; k < m; ++k)
+      {
+        double	a1R,
+      		a1I,
+		a2R,
+		a2I,
+		a3R,
+		a3I,
+		a4R,
+		a4I,
+		s1R,
+		s1I,
+		s2R,
+		s2I,
+		d1R,
+		d1I,
+		d2R,
+		d2I,
+		cR,
+		cI,
+		sR,
+		sI;
+
+        a1R = (*(r1 + k) * *(twRe + k)) - (*(i1 + k) * *(twIm + k));
+        a1I = (*(r1 + k) * *(twIm + k)) + (*(i1 + k) * *(twRe + k));
+        a2R = (*(r2 + k) * *(twRe + m + k)) - (*(i2 + k) * *(twIm + m + k));
+        a2I = (*(r2 + k) * *(twIm + m + k)) + (*(i2 + k) * *(twRe + m + k));
+        a3R = (*(r3 + k) * *(twRe + 2 * m + k)) -
+              (*(i3 + k) * *(twIm + 2 * m + k));
+        a3I = (*(r3 + k) * *(twIm + 2 * m + k)) +
+              (*(i3 + k) * *(twRe + 2 * m + k));
+        a4R = (*(r4 + k) * *(twRe + 3 * m + k)) -
+              (*(i4 + k) * *(twIm + 3 * m + k));
+        a4I = (*(r4 + k) * *(twIm + 3 * m + k)) +
+              (*(i4 + k) * *(twRe + 3 * m + k));
+        s1R = a1R + a4R;
+        s1I = a1I + a4I;
+        d1R = a1R - a4R;
+        d1I = a1I - a4I;
+        s2R = a2R + a3R;
+        s2I = a2I + a3I;
+        d2R = a2R - a3R;
+        d2I = a2I - a3I;
+        cR = *(r0 + k) + (c1 * s1R) + (c2 * s2R);
+        cI = *(i0 + k) + (c1 * s1I) + (c2 * s2I);
+        sR = (s1 * d1R) + (s2 * d2R);
+        sI = (s1 * d1I) + (s2 * d2I);
+        *(r1 + k) = cR + sI;
+        *(i1 + k) = cI - sR;
+        *(r4 + k) = cR - sI;
+        *(i4 + k) = cI + sR;
+        cR = *(r0 + k) + (c2 * s1R) + (c1 * s2R);
+        cI = *(i0 + k) + (c2 * s1I) + (c1 * s2I);
+        sR = (s2 * d1R) - (s1 * d2R);
+        sI = (s2 * d1I) - (s1 * d2I);
+        *(r2 + k) = cR + sI;
+        *(i2 + k) = cI - sR;
+        *(r3 + k) = cR - sI;
+        *(i3 + k) = cI + sR;
+        *(r0 + k) += s1R + s2R;
+        *(i0 + k) += s1I + s2I;
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Applies a radix 7 butterfly stage to double precision data,
+* 		combining septuples of transforms of length m.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	n			Number of data.
+* \param	m			Length of the transforms combined.
+* \param	twRe			Real parts of the stage twiddles.
+* \param	twIm			Imaginary parts of the stage twiddles.
+*/
+static void	AlgFFTRadix7D(double *re, double *im, int n, int m,
+			      const double *twRe, const double *twIm)
+{
+  int		b,
+  		k,
+		q;
+  const double	c1 = ALG_FFT_C7_1,
+  		c2 = ALG_FFT_C7_2,
+  		c3 = ALG_FFT_C7_3,
+		s1 = ALG_FFT_S7_1,
+		s2 = ALG_FFT_S7_2,
+		s3 = ALG_FFT_S7_3;
+
+  for(b = 0; b < n; b += 7 * m)
+  {
+    double	*r[7],
+		*i[7];
+
+    r[0] = re + b;
+    i[0] = im + b;
+    for(q = 1; q < 7; ++q)
+    {
+      r[q] = r[q - 1] + m;
+      i[q] = i[q - 1] + m;
+    }
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+    for(k = 0; k < m; ++k)
+    {
+      double	a0R,
+      		a0I,
+		cR,
+		cI,
+		sR,
+		sI;
+      double	aR[7],
+      		aI[7],
+		sumR[4],
+		sumI[4],
+		difR[4],
+		difI[4];
+
+      a0R = *(r[0] + k);
+      a0I = *(i[0] + k);
+      for(q = 1; q < 7; ++q)
+      {
+	const double *wR,
+		*wI;
+
+	wR = twRe + (q - 1) * m + k;
+	wI = twIm + (q - 1) * m + k;
+        aR[q] = (*(r[q] + k) * *wR) - (*(i[q] + k) * *wI);
+        aI[q] = (*(r[q] + k) * *wI) + (*(i[q] + k) * *wR);
+      }
+      for(q = 1; q < 4; ++q)
+      {
+        sumR[q] = aR[q] + aR[7 - q];
+        sumI[q] = aI[q] + aI[7 - q];
+        difR[q] = aR[q] - aR[7 - q];
+        difI[q] = aI[q] - aI[7 - q];
+      }
+      cR = a0R + (c1 * sumR[1]) + (c2 * sumR[2]) + (c3 * sumR[3]);
+      cI = a0I + (c1 * sumI[1]) + (c2 * sumI[2]) + (c3 * sumI[3]);
+      sR = (s1 * difR[1]) + (s2 * difR[2]) + (s3 * difR[3]);
+      sI = (s1 * difI[1]) + (s2 * difI[2]) + (s3 * difI[3]);
+      *(r[1] + k) = cR + sI;
+      *(i[1] + k) = cI - sR;
+      *(r[6] + k) = cR - sI;
+      *(i[6] + k) = cI + sR;
+      cR = a0R + (c2 * sumR[1]) + (c3 * sumR[2]) + (c1 * sumR[3]);
+      cI = a0I + (c2 * sumI[1]) + (c3 * sumI[2]) + (c1 * sumI[3]);
+      sR = (s2 * difR[1]) - (s3 * difR[2]) - (s1 * difR[3]);
+      sI = (s2 * difI[1]) - (s3 * difI[2]) - (s1 * difI[3]);
+      *(r[2] + k) = cR + sI;
+      *(i[2] + k) = cI - sR;
+      *(r[5] + k) = cR - sI;
+      *(i[5] + k) = cI + sR;
+      cR = a0R + (c3 * sumR[1]) + (c1 * sumR[2]) + (c2 * sumR[3]);
+      cI = a0I + (c3 * sumI[1]) + (c1 * sumI[2]) + (c2 * sumI[3]);
+      sR = (s3 * difR[1]) - (s1 * difR[2]) + (s2 * difR[3]);
+      sI = (s3 * difI[1]) - (s1 * difI[2]) + (s2 * difI[3]);
+      *(r[3] + k) = cR + sI;
+      *(i[3] + k) = cI - sR;
+      *(r[4] + k) = cR - sI;
+      *(i[4] + k) = cI + sR;
+      *(r[0] + k) = a0R + sumR[1] + sumR[2] + sumR[3];
+      *(i[0] + k) = a0I + sumI[1] + sumI[2] + sumI[3];
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Applies a general odd radix butterfly stage to double
+* 		precision data, combining p transforms of length m.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	n			Number of data.
+* \param	m			Length of the transforms combined.
+* \param	p			Radix.
+* \param	twRe			Real parts of the stage twiddles
+* 					followed by the p'th roots of unity.
+* \param	twIm			Imaginary parts of the stage twiddles
+* 					followed by the p'th roots of unity.
+* \param	tmp			Workspace for 2p values.
+*/
+static void	AlgFFTRadixGenD(double *re, double *im, int n, int m, int p,
+				const double *twRe, const double *twIm,
+				double *tmp)
+{
+  int		b,
+  		k,
+		q,
+		r;
+  double	*aR,
+  		*aI;
+  const double	*rtR,
+  		*rtI;
+
+  aR = tmp;
+  aI = tmp + p;
+  rtR = twRe + (p - 1) * m;
+  rtI = twIm + (p - 1) * m;
+  for(b = 0; b < n; b += p * m)
+  {
+    for(k = 0; k < m; ++k)
+    {
+      double	*dR,
+      		*dI;
+
+      dR = re + b + k;
+      dI = im + b + k;
+      aR[0] = *dR;
+      aI[0] = *dI;
+      for(q = 1; q < p; ++q)
+      {
+	double	vR,
+		vI,
+		wR,
+		wI;
+
+	vR = *(dR + q * m);
+	vI = *(dI + q * m);
+	wR = *(twRe + (q - 1) * m + k);
+	wI = *(twIm + (q - 1) * m + k);
+	aR[q] = (vR * wR) - (vI * wI);
+	aI[q] = (vR * wI) + (vI * wR);
+      }
+      for(r = 0; r < p; ++r)
+      {
+        int	j = 0;
+	double	sR = 0.0,
+		sI = 0.0;
+
+	for(q = 0; q < p; ++q)
+	{
+	  sR += (aR[q] * *(rtR + j)) - (aI[q] * *(rtI + j));
+	  sI += (aR[q] * *(rtI + j)) + (aI[q] * *(rtR + j));
+	  if((j += r) >= p)
+	  {
+	    j -= p;
+	  }
+	}
+	*(dR + r * m) = sR;
+	*(dI + r * m) = sI;
+      }
+    }
+  }
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the fast Fourier transform of the given one
+* 		dimensional single precision complex data, in place,
+* 		using the given plan.
+* \param	plan			Given complex plan.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	step			Offset in data elements between
+* 					the data to be transformed.
+* \param	dir			Transform direction.
+* \param	wrk			Workspace of at least plan->wrkSz
+* 					elements, may be NULL in which case
+* 					a workspace is allocated.
+*/
+AlgError	AlgFFTFlt1D(AlgFFTPlan *plan, float *re, float *im,
+			    int step, AlgFFTDir dir, float *wrk)
+{
+  int		k,
+  		n;
+  float	*bRe,
+  		*bIm,
+		*sRe,
+		*sIm,
+		*buf = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((plan == NULL) || plan->real || (re == NULL) || (im == NULL))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else if((wrk == NULL) &&
+          ((wrk = buf = (float *)
+	              AlcMalloc(sizeof(float) * plan->wrkSz)) == NULL))
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  else
+  {
+    n = plan->num;
+    bRe = wrk;
+    bIm = wrk + n;
+    /* The inverse transform is the forward transform with the real and
+     * imaginary parts exchanged on input and output. */
+    if(dir == ALG_FFT_DIR_FWD)
+    {
+      sRe = re;
+      sIm = im;
+    }
+    else
+    {
+      sRe = im;
+      sIm = re;
+    }
+    for(k = 0; k < n; ++k)
+    {
+      size_t	off;
+
+      off = (size_t )*(plan->perm + k) * step;
+      *(bRe + k) = *(sRe + off);
+      *(bIm + k) = *(sIm + off);
+    }
+    AlgFFTStagesF(plan, bRe, bIm, bIm + n);
+    for(k = 0; k < n; ++k)
+    {
+      *sRe = *(bRe + k);
+      *sIm = *(bIm + k);
+      sRe += step;
+      sIm += step;
+    }
+  }
+  AlcFree(buf);
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the fast Fourier transform of the given one
+* 		dimensional single precision real data, in place, using
+* 		the given real data plan. The forward transform packs
+* 		the transformed data as
+* 		\f$r_0, r_1, \ldots, r_M, i_1, \ldots, i_{M-1}\f$
+* 		where \f$N = 2M\f$ is the length of the plan and the
+* 		inverse transform expects data with this layout.
+* \param	plan			Given real data plan.
+* \param	data			Given data.
+* \param	step			Offset in data elements between
+* 					the data to be transformed.
+* \param	dir			Transform direction.
+* \param	wrk			Workspace of at least plan->wrkSz
+* 					elements, may be NULL in which case
+* 					a workspace is allocated.
+*/
+AlgError	AlgFFTRealFlt1D(AlgFFTPlan *plan, float *data,
+			        int step, AlgFFTDir dir, float *wrk)
+{
+  int		k,
+  		m;
+  float	*bRe,
+  		*bIm,
+		*buf = NULL;
+  AlgFFTPlan	*hp;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((plan == NULL) || !(plan->real) || (data == NULL))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else if((wrk == NULL) &&
+          ((wrk = buf = (float *)
+	              AlcMalloc(sizeof(float) * plan->wrkSz)) == NULL))
+  {
+    errNum = ALG_ERR_MALLOC;
+  }
+  else
+  {
+    hp = plan->half;
+    m = hp->num;
+    bRe = wrk;
+    bIm = wrk + m;
+    if(dir == ALG_FFT_DIR_FWD)
+    {
+      float	*d0,
+      		*d1;
+
+      /* Transform z_j = x_{2j} + i x_{2j + 1}. */
+      for(k = 0; k < m; ++k)
+      {
+	size_t	off;
+
+	off = (size_t )*(hp->perm + k) * 2 * step;
+	*(bRe + k) = *(data + off);
+	*(bIm + k) = *(data + off + step);
+      }
+      AlgFFTStagesF(hp, bRe, bIm, bIm + m);
+      /* Unpack X_k = E_k + exp(-2 pi i k / N) O_k, with
+       * E_k = (Z_k + Z*_{M-k}) / 2 and O_k = (Z_k - Z*_{M-k}) / 2i. */
+      *data = *bRe + *bIm;
+      *(data + (size_t )m * step) = *bRe - *bIm;
+      d0 = data + step;
+      d1 = data + (size_t )(m + 1) * step;
+      for(k = 1; k < m; ++k)
+      {
+	float	eR,
+		eI,
+		oR,
+		oI,
+		wR,
+		wI;
+
+	eR = 0.5f * (*(bRe + k) + *(bRe + m - k));
+	eI = 0.5f * (*(bIm + k) - *(bIm + m - k));
+	oR = 0.5f * (*(bIm + k) + *(bIm + m - k));
+	oI = -0.5f * (*(bRe + k) - *(bRe + m - k));
+	wR = *(plan->twReF + k);
+	wI = *(plan->twImF + k);
+	*d0 = eR + (oR * wR) - (oI * wI);
+	*d1 = eI + (oR * wI) + (oI * wR);
+	d0 += step;
+	d1 += step;
+      }
+    }
+    else
+    {
+      /* Pack Z_k = (X_k + X*_{M-k}) + i exp(2 pi i k / N)(X_k - X*_{M-k})
+       * directly into the digit reversed workspace, exchanging the real
+       * and imaginary parts for the inverse transform. */
+      for(k = 0; k < m; ++k)
+      {
+	int	j;
+	float	xR,
+		xI,
+		yR,
+		yI,
+		dR,
+		dI,
+		wR,
+		wI;
+
+	j = *(hp->perm + k);
+	xR = *(data + (size_t )j * step);
+	yR = *(data + (size_t )(m - j) * step);
+	if(j == 0)
+	{
+	  xI = yI = 0.0f;
+	}
+	else
+	{
+	  xI = *(data + (size_t )(m + j) * step);
+	  yI = *(data + (size_t )(2 * m - j) * step);
+	}
+	wR = *(plan->twReF + j);
+	wI = -*(plan->twImF + j);
+	dR = xR - yR;
+	dI = xI + yI;
+	*(bIm + k) = xR + yR - ((dR * wI) + (dI * wR));
+	*(bRe + k) = xI - yI + ((dR * wR) - (dI * wI));
+      }
+      AlgFFTStagesF(hp, bRe, bIm, bIm + m);
+      for(k = 0; k < m; ++k)
+      {
+	size_t	off;
+
+	off = (size_t )k * 2 * step;
+        *(data + off) = *(bIm + k);
+        *(data + off + step) = *(bRe + k);
+      }
+    }
+  }
+  AlcFree(buf);
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Computes the fast Fourier transforms of a batch of adjacent
+* 		lines of single precision complex data, in place, using
+* 		the given plan. The data of the lines are gathered into
+* 		digit reversed order with the lines innermost, so that
+* 		strided data are read and written a row at a time.
+* \param	plan			Given complex plan.
+* \param	re			Real parts of the data of the first
+* 					line.
+* \param	im			Imaginary parts of the data of the
+* 					first line.
+* \param	step			Offset in data elements between
+* 					the data of a line.
+* \param	nB			Number of lines, the lines are at
+* 					unit offsets from each other.
+* \param	dir			Transform direction.
+* \param	wrk			Workspace of at least
+* 					plan->wrkSz + 2 nB plan->num elements.
+*/
+static void	AlgFFTBatchF(AlgFFTPlan *plan, float *re, float *im,
+			     int step, int nB, AlgFFTDir dir, float *wrk)
+{
+  int		b,
+  		k,
+		n;
+  float	*bRe,
+  		*bIm,
+		*sRe,
+		*sIm;
+
+  n = plan->num;
+  bRe = wrk;
+  bIm = wrk + ((size_t )nB * n);
+  if(dir == ALG_FFT_DIR_FWD)
+  {
+    sRe = re;
+    sIm = im;
+  }
+  else
+  {
+    sRe = im;
+    sIm = re;
+  }
+  for(k = 0; k < n; ++k)
+  {
+    size_t	off;
+
+    off = (size_t )*(plan->perm + k) * step;
+    for(b = 0; b < nB; ++b)
+    {
+      *(bRe + ((size_t )b * n) + k) = *(sRe + off + b);
+      *(bIm + ((size_t )b * n) + k) = *(sIm + off + b);
+    }
+  }
+  for(b = 0; b < nB; ++b)
+  {
+    AlgFFTStagesF(plan, bRe + ((size_t )b * n), bIm + ((size_t )b * n),
+                  bIm + ((size_t )nB * n));
+  }
+  for(k = 0; k < n; ++k)
+  {
+    for(b = 0; b < nB; ++b)
+    {
+      *(sRe + b) = *(bRe + ((size_t )b * n) + k);
+      *(sIm + b) = *(bIm + ((size_t )b * n) + k);
+    }
+    sRe += step;
+    sIm += step;
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Applies the butterfly stages of the given complex plan to
+* 		the given single precision digit reversed data.
+* \param	plan			Given complex plan.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	tmp			Workspace for the general butterfly or
+* 					Bluestein's algorithm.
+*/
+static void	AlgFFTStagesF(AlgFFTPlan *plan, float *re, float *im,
+			      float *tmp)
+{
+  int		m,
+		n,
+  		p,
+		s;
+  const float	*twRe,
+  		*twIm;
+
+  if(plan->conv)
+  {
+    AlgFFTBluesteinF(plan, re, im, tmp);
+  }
+  else
+  {
+    m = 1;
+    n = plan->num;
+    twRe = plan->twReF;
+    twIm = plan->twImF;
+    for(s = 0; s < plan->nStage; ++s)
+    {
+      p = plan->radix[s];
+      switch(p)
+      {
+        case 2:
+          AlgFFTRadix2F(re, im, n, m, twRe, twIm);
+	  break;
+        case 3:
+          AlgFFTRadix3F(re, im, n, m, twRe, twIm);
+	  break;
+        case 4:
+          AlgFFTRadix4F(re, im, n, m, twRe, twIm);
+	  break;
+        case 5:
+          AlgFFTRadix5F(re, im, n, m, twRe, twIm);
+	  break;
+        case 7:
+          AlgFFTRadix7F(re, im, n, m, twRe, twIm);
+	  break;
+        default:
+          AlgFFTRadixGenF(re, im, n, m, p, twRe, twIm, tmp);
+	  twRe += p;
+	  twIm += p;
+	  break;
+      }
+      twRe += (p - 1) * m;
+      twIm += (p - 1) * m;
+      m *= p;
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Computes the transform of the given single precision
+* 		data in place using Bluestein's algorithm, see
+* 		AlgFFTPlanBluestein(). The chirp and kernel products are
+* 		computed while gathering the data into digit reversed
+* 		order so that the butterfly stages of the convolution
+* 		plan may be applied directly.
+* \param	plan			Given Bluestein plan.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	tmp			Workspace of at least
+* 					plan->wrkSz - 2 plan->num elements.
+*/
+static void	AlgFFTBluesteinF(AlgFFTPlan *plan, float *re, float *im,
+				 float *tmp)
+{
+  int		j,
+  		k,
+  		m,
+		n;
+  float	*aRe,
+  		*aIm,
+		*bRe,
+		*bIm;
+  const int	*perm;
+  const float	*wRe,
+  		*wIm,
+		*kRe,
+		*kIm;
+
+  n = plan->num;
+  m = plan->conv->num;
+  perm = plan->conv->perm;
+  aRe = tmp;
+  aIm = tmp + m;
+  bRe = tmp + (2 * m);
+  bIm = tmp + (3 * m);
+  wRe = plan->twReF;
+  wIm = plan->twImF;
+  kRe = wRe + n;
+  kIm = wIm + n;
+  for(k = 0; k < m; ++k)
+  {
+    j = *(perm + k);
+    if(j < n)
+    {
+      *(aRe + k) = (*(re + j) * *(wRe + j)) - (*(im + j) * *(wIm + j));
+      *(aIm + k) = (*(re + j) * *(wIm + j)) + (*(im + j) * *(wRe + j));
+    }
+    else
+    {
+      *(aRe + k) = *(aIm + k) = 0.0f;
+    }
+  }
+  AlgFFTStagesF(plan->conv, aRe, aIm, bRe);
+  /* Multiply by the transformed kernel, exchanging the real and
+   * imaginary parts for the inverse transform. */
+  for(k = 0; k < m; ++k)
+  {
+    j = *(perm + k);
+    *(bIm + k) = (*(aRe + j) * *(kRe + j)) - (*(aIm + j) * *(kIm + j));
+    *(bRe + k) = (*(aRe + j) * *(kIm + j)) + (*(aIm + j) * *(kRe + j));
+  }
+  AlgFFTStagesF(plan->conv, bRe, bIm, aRe);
+  for(k = 0; k < n; ++k)
+  {
+    *(re + k) = (*(bIm + k) * *(wRe + k)) - (*(bRe + k) * *(wIm + k));
+    *(im + k) = (*(bIm + k) * *(wIm + k)) + (*(bRe + k) * *(wRe + k));
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Applies a radix 2 butterfly stage to single precision data,
+* 		combining pairs of transforms of length m.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	n			Number of data.
+* \param	m			Length of the transforms combined.
+* \param	twRe			Real parts of the stage twiddles.
+* \param	twIm			Imaginary parts of the stage twiddles.
+*/
+static void	AlgFFTRadix2F(float *re, float *im, int n, int m,
+			      const float *twRe, const float *twIm)
+{
+  int		b,
+  		k;
+
+  if(m == 1)
+  {
+    /* The twiddle factors of the first stage are all one. */
+    for(b = 0; b < n; b += 2)
+    {
+      float	tR,
+      		tI;
+
+      tR = *(re + b + 1);
+      tI = *(im + b + 1);
+      *(re + b + 1) = *(re + b) - tR;
+      *(im + b + 1) = *(im + b) - tI;
+      *(re + b) += tR;
+      *(im + b) += tI;
+    }
+  }
+  else
+  {
+    for(b = 0; b < n; b += 2 * m)
+    {
+      float	*r0,
+    		*r1,
+		*i0,
+		*i1;
+
+      r0 = re + b;
+      r1 = r0 + m;
+      i0 = im + b;
+      i1 = i0 + m;
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+      for(k = 0; k < m; ++k)
+      {
+        float	tR,
+      		tI;
+
+        tR = (*(r1 + k) * *(twRe + k)) - (*(i1 + k) * *(twIm + k));
+        tI = (*(r1 + k) * *(twIm + k)) + (*(i1 + k) * *(twRe + k));
+        *(r1 + k) = *(r0 + k) - tR;
+        *(i1 + k) = *(i0 + k) - tI;
+        *(r0 + k) += tR;
+        *(i0 + k) += tI;
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Applies a radix 3 butterfly stage to single precision data,
+* 		combining triples of transforms of length m.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	n			Number of data.
+* \param	m			Length of the transforms combined.
+* \param	twRe			Real parts of the stage twiddles.
+* \param	twIm			Imaginary parts of the stage twiddles.
+*/
+static void	AlgFFTRadix3F(float *re, float *im, int n, int m,
+			      const float *twRe, const float *twIm)
+{
+  int		b,
+  		k;
+  const float	s3 = ALG_FFT_S3;
+
+  if(m == 1)
+  {
+    /* The twiddle factors of the first stage are all one. */
+    for(b = 0; b < n; b += 3)
+    {
+      float	sR,
+		sI,
+		dR,
+		dI,
+		tR,
+		tI;
+
+      sR = *(re + b + 1) + *(re + b + 2);
+      sI = *(im + b + 1) + *(im + b + 2);
+      dR = s3 * (*(re + b + 1) - *(re + b + 2));
+      dI = s3 * (*(im + b + 1) - *(im + b + 2));
+      tR = *(re + b) - (0.5f * sR);
+      tI = *(im + b) - (0.5f * sI);
+      *(re + b) += sR;
+      *(im + b) += sI;
+      *(re + b + 1) = tR + dI;
+      *(im + b + 1) = tI - dR;
+      *(re + b + 2) = tR - dI;
+      *(im + b + 2) = tI + dR;
+    }
+  }
+  else
+  {
+    for(b = 0; b < n; b += 3 * m)
+    {
+      float	*r0,
+    		*r1,
+    		*r2,
+		*i0,
+		*i1,
+		*i2;
+      const float *w1R,
+		  *w1I,
+		  *w2R,
+		  *w2I;
+
+      r0 = re + b;
+      r1 = r0 + m;
+      r2 = r1 + m;
+      i0 = im + b;
+      i1 = i0 + m;
+      i2 = i1 + m;
+      w1R = twRe;
+      w1I = twIm;
+      w2R = w1R + m;
+      w2I = w1I + m;
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+      for(k = 0; k < m; ++k)
+      {
+        float	a1R,
+      		a1I,
+		a2R,
+		a2I,
+		sR,
+		sI,
+		dR,
+		dI,
+		tR,
+		tI;
+
+        a1R = (*(r1 + k) * *(w1R + k)) - (*(i1 + k) * *(w1I + k));
+        a1I = (*(r1 + k) * *(w1I + k)) + (*(i1 + k) * *(w1R + k));
+        a2R = (*(r2 + k) * *(w2R + k)) - (*(i2 + k) * *(w2I + k));
+        a2I = (*(r2 + k) * *(w2I + k)) + (*(i2 + k) * *(w2R + k));
+        sR = a1R + a2R;
+        sI = a1I + a2I;
+        dR = s3 * (a1R - a2R);
+        dI = s3 * (a1I - a2I);
+        tR = *(r0 + k) - (0.5f * sR);
+        tI = *(i0 + k) - (0.5f * sI);
+        *(r0 + k) += sR;
+        *(i0 + k) += sI;
+        *(r1 + k) = tR + dI;
+        *(i1 + k) = tI - dR;
+        *(r2 + k) = tR - dI;
+        *(i2 + k) = tI + dR;
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Applies a radix 4 butterfly stage to single precision data,
+* 		combining quadruples of transforms of length m.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	n			Number of data.
+* \param	m			Length of the transforms combined.
+* \param	twRe			Real parts of the stage twiddles.
+* \param	twIm			Imaginary parts of the stage twiddles.
+*/
+static void	AlgFFTRadix4F(float *re, float *im, int n, int m,
+			      const float *twRe, const float *twIm)
+{
+  int		b,
+  		k;
+
+  if(m == 1)
+  {
+    /* The twiddle factors of the first stage are all one. */
+    for(b = 0; b < n; b += 4)
+    {
+      float	t0R,
+		t0I,
+		t1R,
+		t1I,
+		t2R,
+		t2I,
+		t3R,
+		t3I;
+
+      t0R = *(re + b) + *(re + b + 2);
+      t0I = *(im + b) + *(im + b + 2);
+      t1R = *(re + b) - *(re + b + 2);
+      t1I = *(im + b) - *(im + b + 2);
+      t2R = *(re + b + 1) + *(re + b + 3);
+      t2I = *(im + b + 1) + *(im + b + 3);
+      t3R = *(re + b + 1) - *(re + b + 3);
+      t3I = *(im + b + 1) - *(im + b + 3);
+      *(re + b) = t0R + t2R;
+      *(im + b) = t0I + t2I;
+      *(re + b + 1) = t1R + t3I;
+      *(im + b + 1) = t1I - t3R;
+      *(re + b + 2) = t0R - t2R;
+      *(im + b + 2) = t0I - t2I;
+      *(re + b + 3) = t1R - t3I;
+      *(im + b + 3) = t1I + t3R;
+    }
+  }
+  else
+  {
+    for(b = 0; b < n; b += 4 * m)
+    {
+      float	*r0,
+    		*r1,
+    		*r2,
+    		*r3,
+		*i0,
+		*i1,
+		*i2,
+		*i3;
+      const float *w1R,
+		  *w1I,
+		  *w2R,
+		  *w2I,
+		  *w3R,
+		  *w3I;
+
+      r0 = re + b;
+      r1 = r0 + m;
+      r2 = r1 + m;
+      r3 = r2 + m;
+      i0 = im + b;
+      i1 = i0 + m;
+      i2 = i1 + m;
+      i3 = i2 + m;
+      w1R = twRe;
+      w1I = twIm;
+      w2R = w1R + m;
+      w2I = w1I + m;
+      w3R = w2R + m;
+      w3I = w2I + m;
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+      for(k = 0; k < m; ++k)
+      {
+        float	a1R,
+      		a1I,
+		a2R,
+		a2I,
+		a3R,
+		a3I,
+		t0R,
+		t0I,
+		t1R,
+		t1I,
+		t2R,
+		t2I,
+		t3R,
+		t3I;
+
+        a1R = (*(r1 + k) * *(w1R + k)) - (*(i1 + k) * *(w1I + k));
+        a1I = (*(r1 + k) * *(w1I + k)) + (*(i1 + k) * *(w1R + k));
+        a2R = (*(r2 + k) * *(w2R + k)) - (*(i2 + k) * *(w2I + k));
+        a2I = (*(r2 + k) * *(w2I + k)) + (*(i2 + k) * *(w2R + k));
+        a3R = (*(r3 + k) * *(w3R + k)) - (*(i3 + k) * *(w3I + k));
+        a3I = (*(r3 + k) * *(w3I + k)) + (*(i3 + k) * *(w3R + k));
+        t0R = *(r0 + k) + a2R;
+        t0I = *(i0 + k) + a2I;
+        t1R = *(r0 + k) - a2R;
+        t1I = *(i0 + k) - a2I;
+        t2R = a1R + a3R;
+        t2I = a1I + a3I;
+        t3R = a1R - a3R;
+        t3I = a1I - a3I;
+        *(r0 + k) = t0R + t2R;
+        *(i0 + k) = t0I + t2I;
+        *(r1 + k) = t1R + t3I;
+        *(i1 + k) = t1I - t3R;
+        *(r2 + k) = t0R - t2R;
+        *(i2 + k) = t0I - t2I;
+        *(r3 + k) = t1R - t3I;
+        *(i3 + k) = t1I + t3R;
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Applies a radix 5 butterfly stage to single precision data,
+* 		combining quintuples of transforms of length m.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	n			Number of data.
+* \param	m			Length of the transforms combined.
+* \param	twRe			Real parts of the stage twiddles.
+* \param	twIm			Imaginary parts of the stage twiddles.
+*/
+static void	AlgFFTRadix5F(float *re, float *im, int n, int m,
+			      const float *twRe, const float *twIm)
+{
+  int		b,
+  		k;
+  const float	c1 = ALG_FFT_C5_1,
+  		c2 = ALG_FFT_C5_2,
+		s1 = ALG_FFT_S5_1,
+		s2 = ALG_FFT_S5_2;
+
+  if(m == 1)
+  {
+    /* The twiddle factors of the first stage are all one. */
+    for(b = 0; b < n; b += 5)
+    {
+      float	s1R,
+		s1I,
+		s2R,
+		s2I,
+		d1R,
+		d1I,
+		d2R,
+		d2I,
+		cR,
+		cI,
+		sR,
+		sI;
+      float	*r,
+      		*i;
+
+      r = re + b;
+      i = im + b;
+      s1R = *(r + 1) + *(r + 4);
+      s1I = *(i + 1) + *(i + 4);
+      d1R = *(r + 1) - *(r + 4);
+      d1I = *(i + 1) - *(i + 4);
+      s2R = *(r + 2) + *(r + 3);
+      s2I = *(i + 2) + *(i + 3);
+      d2R = *(r + 2) - *(r + 3);
+      d2I = *(i + 2) - *(i + 3);
+      cR = *r + (c1 * s1R) + (c2 * s2R);
+      cI = *i + (c1 * s1I) + (c2 * s2I);
+      sR = (s1 * d1R) + (s2 * d2R);
+      sI = (s1 * d1I) + (s2 * d2I);
+      *(r + 1) = cR + sI;
+      *(i + 1) = cI - sR;
+      *(r + 4) = cR - sI;
+      *(i + 4) = cI + sR;
+      cR = *r + (c2 * s1R) + (c1 * s2R);
+      cI = *i + (c2 * s1I) + (c1 * s2I);
+      sR = (s2 * d1R) - (s1 * d2R);
+      sI = (s2 * d1I) - (s1 * d2I);
+      *(r + 2) = cR + sI;
+      *(i + 2) = cI - sR;
+      *(r + 3) = cR - sI;
+      *(i + 3) = cI + sR;
+      *r += s1R + s2R;
+      *i += s1I + s2I;
+    }
+  }
+  else
+  {
+    for(b = 0; b < n; b += 5 * m)
+    {
+      float	*r0,
+    		*r1,
+    		*r2,
+    		*r3,
+    		*r4,
+		*i0,
+		*i1,
+		*i2,
+		*i3,
+		*i4;
+
+      r0 = re + b;
+      r1 = r0 + m;
+      r2 = r1 + m;
+      r3 = r2 + m;
+      r4 = r3 + m;
+      i0 = im + b;
+      i1 = i0 + m;
+      i2 = i1 + m;
+      i3 = i2 + m;
+      i4 = i3 + m;
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+      for(k = 0; k < m; ++k)
+      {
+        float	a1R,
+      		a1I,
+		a2R,
+		a2I,
+		a3R,
+		a3I,
+		a4R,
+		a4I,
+		s1R,
+		s1I,
+		s2R,
+		s2I,
+		d1R,
+		d1I,
+		d2R,
+		d2I,
+		cR,
+		cI,
+		sR,
+		sI;
+
+        a1R = (*(r1 + k) * *(twRe + k)) - (*(i1 + k) * *(twIm + k));
+        a1I = (*(r1 + k) * *(twIm + k)) + (*(i1 + k) * *(twRe + k));
+        a2R = (*(r2 + k) * *(twRe + m + k)) - (*(i2 + k) * *(twIm + m + k));
+        a2I = (*(r2 + k) * *(twIm + m + k)) + (*(i2 + k) * *(twRe + m + k));
+        a3R = (*(r3 + k) * *(twRe + 2 * m + k)) -
+              (*(i3 + k) * *(twIm + 2 * m + k));
+        a3I = (*(r3 + k) * *(twIm + 2 * m + k)) +
+              (*(i3 + k) * *(twRe + 2 * m + k));
+        a4R = (*(r4 + k) * *(twRe + 3 * m + k)) -
+              (*(i4 + k) * *(twIm + 3 * m + k));
+        a4I = (*(r4 + k) * *(twIm + 3 * m + k)) +
+              (*(i4 + k) * *(twRe + 3 * m + k));
+        s1R = a1R + a4R;
+        s1I = a1I + a4I;
+        d1R = a1R - a4R;
+        d1I = a1I - a4I;
+        s2R = a2R + a3R;
+        s2I = a2I + a3I;
+        d2R = a2R - a3R;
+        d2I = a2I - a3I;
+        cR = *(r0 + k) + (c1 * s1R) + (c2 * s2R);
+        cI = *(i0 + k) + (c1 * s1I) + (c2 * s2I);
+        sR = (s1 * d1R) + (s2 * d2R);
+        sI = (s1 * d1I) + (s2 * d2I);
+        *(r1 + k) = cR + sI;
+        *(i1 + k) = cI - sR;
+        *(r4 + k) = cR - sI;
+        *(i4 + k) = cI + sR;
+        cR = *(r0 + k) + (c2 * s1R) + (c1 * s2R);
+        cI = *(i0 + k) + (c2 * s1I) + (c1 * s2I);
+        sR = (s2 * d1R) - (s1 * d2R);
+        sI = (s2 * d1I) - (s1 * d2I);
+        *(r2 + k) = cR + sI;
+        *(i2 + k) = cI - sR;
+        *(r3 + k) = cR - sI;
+        *(i3 + k) = cI + sR;
+        *(r0 + k) += s1R + s2R;
+        *(i0 + k) += s1I + s2I;
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Applies a radix 7 butterfly stage to single precision data,
+* 		combining septuples of transforms of length m.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	n			Number of data.
+* \param	m			Length of the transforms combined.
+* \param	twRe			Real parts of the stage twiddles.
+* \param	twIm			Imaginary parts of the stage twiddles.
+*/
+static void	AlgFFTRadix7F(float *re, float *im, int n, int m,
+			      const float *twRe, const float *twIm)
+{
+  int		b,
+  		k,
+		q;
+  const float	c1 = ALG_FFT_C7_1,
+  		c2 = ALG_FFT_C7_2,
+  		c3 = ALG_FFT_C7_3,
+		s1 = ALG_FFT_S7_1,
+		s2 = ALG_FFT_S7_2,
+		s3 = ALG_FFT_S7_3;
+
+  for(b = 0; b < n; b += 7 * m)
+  {
+    float	*r[7],
+		*i[7];
+
+    r[0] = re + b;
+    i[0] = im + b;
+    for(q = 1; q < 7; ++q)
+    {
+      r[q] = r[q - 1] + m;
+      i[q] = i[q - 1] + m;
+    }
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#pragma omp simd
+#endif
+    for(k = 0; k < m; ++k)
+    {
+      float	a0R,
+      		a0I,
+		cR,
+		cI,
+		sR,
+		sI;
+      float	aR[7],
+      		aI[7],
+		sumR[4],
+		sumI[4],
+		difR[4],
+		difI[4];
+
+      a0R = *(r[0] + k);
+      a0I = *(i[0] + k);
+      for(q = 1; q < 7; ++q)
+      {
+	const float *wR,
+		*wI;
+
+	wR = twRe + (q - 1) * m + k;
+	wI = twIm + (q - 1) * m + k;
+        aR[q] = (*(r[q] + k) * *wR) - (*(i[q] + k) * *wI);
+        aI[q] = (*(r[q] + k) * *wI) + (*(i[q] + k) * *wR);
+      }
+      for(q = 1; q < 4; ++q)
+      {
+        sumR[q] = aR[q] + aR[7 - q];
+        sumI[q] = aI[q] + aI[7 - q];
+        difR[q] = aR[q] - aR[7 - q];
+        difI[q] = aI[q] - aI[7 - q];
+      }
+      cR = a0R + (c1 * sumR[1]) + (c2 * sumR[2]) + (c3 * sumR[3]);
+      cI = a0I + (c1 * sumI[1]) + (c2 * sumI[2]) + (c3 * sumI[3]);
+      sR = (s1 * difR[1]) + (s2 * difR[2]) + (s3 * difR[3]);
+      sI = (s1 * difI[1]) + (s2 * difI[2]) + (s3 * difI[3]);
+      *(r[1] + k) = cR + sI;
+      *(i[1] + k) = cI - sR;
+      *(r[6] + k) = cR - sI;
+      *(i[6] + k) = cI + sR;
+      cR = a0R + (c2 * sumR[1]) + (c3 * sumR[2]) + (c1 * sumR[3]);
+      cI = a0I + (c2 * sumI[1]) + (c3 * sumI[2]) + (c1 * sumI[3]);
+      sR = (s2 * difR[1]) - (s3 * difR[2]) - (s1 * difR[3]);
+      sI = (s2 * difI[1]) - (s3 * difI[2]) - (s1 * difI[3]);
+      *(r[2] + k) = cR + sI;
+      *(i[2] + k) = cI - sR;
+      *(r[5] + k) = cR - sI;
+      *(i[5] + k) = cI + sR;
+      cR = a0R + (c3 * sumR[1]) + (c1 * sumR[2]) + (c2 * sumR[3]);
+      cI = a0I + (c3 * sumI[1]) + (c1 * sumI[2]) + (c2 * sumI[3]);
+      sR = (s3 * difR[1]) - (s1 * difR[2]) + (s2 * difR[3]);
+      sI = (s3 * difI[1]) - (s1 * difI[2]) + (s2 * difI[3]);
+      *(r[3] + k) = cR + sI;
+      *(i[3] + k) = cI - sR;
+      *(r[4] + k) = cR - sI;
+      *(i[4] + k) = cI + sR;
+      *(r[0] + k) = a0R + sumR[1] + sumR[2] + sumR[3];
+      *(i[0] + k) = a0I + sumI[1] + sumI[2] + sumI[3];
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	AlgFourier
+* \brief	Applies a general odd radix butterfly stage to float
+* 		precision data, combining p transforms of length m.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	n			Number of data.
+* \param	m			Length of the transforms combined.
+* \param	p			Radix.
+* \param	twRe			Real parts of the stage twiddles
+* 					followed by the p'th roots of unity.
+* \param	twIm			Imaginary parts of the stage twiddles
+* 					followed by the p'th roots of unity.
+* \param	tmp			Workspace for 2p values.
+*/
+static void	AlgFFTRadixGenF(float *re, float *im, int n, int m, int p,
+				const float *twRe, const float *twIm,
+				float *tmp)
+{
+  int		b,
+  		k,
+		q,
+		r;
+  float	*aR,
+  		*aI;
+  const float	*rtR,
+  		*rtI;
+
+  aR = tmp;
+  aI = tmp + p;
+  rtR = twRe + (p - 1) * m;
+  rtI = twIm + (p - 1) * m;
+  for(b = 0; b < n; b += p * m)
+  {
+    for(k = 0; k < m; ++k)
+    {
+      float	*dR,
+      		*dI;
+
+      dR = re + b + k;
+      dI = im + b + k;
+      aR[0] = *dR;
+      aI[0] = *dI;
+      for(q = 1; q < p; ++q)
+      {
+	float	vR,
+		vI,
+		wR,
+		wI;
+
+	vR = *(dR + q * m);
+	vI = *(dI + q * m);
+	wR = *(twRe + (q - 1) * m + k);
+	wI = *(twIm + (q - 1) * m + k);
+	aR[q] = (vR * wR) - (vI * wI);
+	aI[q] = (vR * wI) + (vI * wR);
+      }
+      for(r = 0; r < p; ++r)
+      {
+        int	j = 0;
+	float	sR = 0.0f,
+		sI = 0.0f;
+
+	for(q = 0; q < p; ++q)
+	{
+	  sR += (aR[q] * *(rtR + j)) - (aI[q] * *(rtI + j));
+	  sI += (aR[q] * *(rtI + j)) + (aI[q] * *(rtR + j));
+	  if((j += r) >= p)
+	  {
+	    j -= p;
+	  }
+	}
+	*(dR + r * m) = sR;
+	*(dI + r * m) = sI;
+      }
+    }
+  }
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the fast Fourier transform of the given two
+* 		dimensional double precision complex data, in place.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	nX			Number of data in each row.
+* \param	nY			Number of data in each column.
+* \param	dir			Transform direction.
+*/
+AlgError	AlgFFTDbl2D(double **re, double **im, int nX, int nY,
+			    AlgFFTDir dir)
+{
+  AlgError	errNum = ALG_ERR_FUNC;
+
+  if(re && im)
+  {
+    errNum = AlgFFTDbl3D(&re, &im, nX, nY, 1, dir);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the fast Fourier transform of the given two
+* 		dimensional single precision complex data, in place.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	nX			Number of data in each row.
+* \param	nY			Number of data in each column.
+* \param	dir			Transform direction.
+*/
+AlgError	AlgFFTFlt2D(float **re, float **im, int nX, int nY,
+			    AlgFFTDir dir)
+{
+  AlgError	errNum = ALG_ERR_FUNC;
+
+  if(re && im)
+  {
+    errNum = AlgFFTFlt3D(&re, &im, nX, nY, 1, dir);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the fast Fourier transform of the given two
+* 		dimensional double precision real data, in place. The
+* 		data are packed as in AlgFourReal2D() and both
+* 		dimensions must be even (or one).
+* \param	data			Given data.
+* \param	nX			Number of data in each row.
+* \param	nY			Number of data in each column.
+* \param	dir			Transform direction.
+*/
+AlgError	AlgFFTRealDbl2D(double **data, int nX, int nY,
+				AlgFFTDir dir)
+{
+  AlgError	errNum = ALG_ERR_FUNC;
+
+  if(data)
+  {
+    errNum = AlgFFTRealDbl3D(&data, nX, nY, 1, dir);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the fast Fourier transform of the given two
+* 		dimensional single precision real data, in place. The
+* 		data are packed as in AlgFourReal2D() and both
+* 		dimensions must be even (or one).
+* \param	data			Given data.
+* \param	nX			Number of data in each row.
+* \param	nY			Number of data in each column.
+* \param	dir			Transform direction.
+*/
+AlgError	AlgFFTRealFlt2D(float **data, int nX, int nY,
+				AlgFFTDir dir)
+{
+  AlgError	errNum = ALG_ERR_FUNC;
+
+  if(data)
+  {
+    errNum = AlgFFTRealFlt3D(&data, nX, nY, 1, dir);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the fast Fourier transform of the given three
+* 		dimensional double precision complex data, in place.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	nX			Number of data in each row.
+* \param	nY			Number of data in each column.
+* \param	nZ			Number of data in each plane.
+* \param	dir			Transform direction.
+*/
+AlgError	AlgFFTDbl3D(double ***re, double ***im,
+			    int nX, int nY, int nZ, AlgFFTDir dir)
+{
+  int		idx;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((re == NULL) || (*re == NULL) || (im == NULL) || (*im == NULL))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  for(idx = 0; (errNum == ALG_ERR_NONE) && (idx < 3); ++idx)
+  {
+    errNum = AlgFFTRepCpx(**re, **im, 0, nX, nY, nZ,
+                          (dir == ALG_FFT_DIR_FWD)? idx: 2 - idx, dir);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the fast Fourier transform of the given three
+* 		dimensional single precision complex data, in place.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	nX			Number of data in each row.
+* \param	nY			Number of data in each column.
+* \param	nZ			Number of data in each plane.
+* \param	dir			Transform direction.
+*/
+AlgError	AlgFFTFlt3D(float ***re, float ***im,
+			    int nX, int nY, int nZ, AlgFFTDir dir)
+{
+  int		idx;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((re == NULL) || (*re == NULL) || (im == NULL) || (*im == NULL))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  for(idx = 0; (errNum == ALG_ERR_NONE) && (idx < 3); ++idx)
+  {
+    errNum = AlgFFTRepCpx(**re, **im, 1, nX, nY, nZ,
+                          (dir == ALG_FFT_DIR_FWD)? idx: 2 - idx, dir);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the fast Fourier transform of the given three
+* 		dimensional double precision real data, in place. The
+* 		data are packed as in AlgFourReal3D() and all dimensions
+* 		must be even (or one).
+* \param	data			Given data.
+* \param	nX			Number of data in each row.
+* \param	nY			Number of data in each column.
+* \param	nZ			Number of data in each plane.
+* \param	dir			Transform direction.
+*/
+AlgError	AlgFFTRealDbl3D(double ***data, int nX, int nY, int nZ,
+				AlgFFTDir dir)
+{
+  int		idx;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((data == NULL) || (*data == NULL))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  for(idx = 0; (errNum == ALG_ERR_NONE) && (idx < 3); ++idx)
+  {
+    errNum = AlgFFTRepReal(**data, 0, nX, nY, nZ,
+                           (dir == ALG_FFT_DIR_FWD)? idx: 2 - idx, dir);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the fast Fourier transform of the given three
+* 		dimensional single precision real data, in place. The
+* 		data are packed as in AlgFourReal3D() and all dimensions
+* 		must be even (or one).
+* \param	data			Given data.
+* \param	nX			Number of data in each row.
+* \param	nY			Number of data in each column.
+* \param	nZ			Number of data in each plane.
+* \param	dir			Transform direction.
+*/
+AlgError	AlgFFTRealFlt3D(float ***data, int nX, int nY, int nZ,
+				AlgFFTDir dir)
+{
+  int		idx;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  if((data == NULL) || (*data == NULL))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  for(idx = 0; (errNum == ALG_ERR_NONE) && (idx < 3); ++idx)
+  {
+    errNum = AlgFFTRepReal(**data, 1, nX, nY, nZ,
+                           (dir == ALG_FFT_DIR_FWD)? idx: 2 - idx, dir);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Number of threads which will be used by a parallel region.
+* \ingroup	AlgFourier
+* \brief	Finds the number of threads that a parallel region will
+* 		use.
+*/
+static int	AlgFFTNumThreads(void)
+{
+  int		nThr = 1;
+
+#ifdef _OPENMP
+#pragma omp parallel
+  {
+#pragma omp master
+    {
+      nThr = omp_get_num_threads();
+    }
+  }
+#endif
+  return(nThr);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the one dimensional complex transforms of all
+* 		lines parallel to the given axis of contiguous three
+* 		dimensional data. Lines along the y and z axes are
+* 		adjacent in memory and are transformed in batches of
+* 		up to ALG_FFT_BATCH lines, see AlgFFTBatchD(). The
+* 		batches are transformed in parallel, each thread with
+* 		it's own workspace.
+* \param	re			Real parts of the data.
+* \param	im			Imaginary parts of the data.
+* \param	flt			Non-zero if the data are float, zero
+* 					if they are double.
+* \param	nX			Number of data in each row.
+* \param	nY			Number of data in each column.
+* \param	nZ			Number of data in each plane.
+* \param	axis			Axis of the lines, 0, 1 or 2 for
+* 					x, y or z.
+* \param	dir			Transform direction.
+*/
+static AlgError	AlgFFTRepCpx(void *re, void *im, int flt,
+			     int nX, int nY, int nZ, int axis, AlgFFTDir dir)
+{
+  int		num,
+		nGrp,
+		grpLen,
+		nBat,
+		nThr,
+  		step;
+  size_t	eSz,
+  		wrkSz,
+  		grpOff;
+  char		*wrk = NULL;
+  AlgFFTPlan	*plan = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  /* The lines form groups of grpLen lines at unit offsets from each
+   * other, with the groups grpOff apart. */
+  switch(axis)
+  {
+    case 0:
+      num = nX;
+      step = 1;
+      nGrp = nY * nZ;
+      grpLen = 1;
+      grpOff = nX;
+      break;
+    case 1:
+      num = nY;
+      step = nX;
+      nGrp = nZ;
+      grpLen = nX;
+      grpOff = (size_t )nX * nY;
+      break;
+    default:
+      num = nZ;
+      step = nX * nY;
+      nGrp = 1;
+      grpLen = nX * nY;
+      grpOff = 0;
+      break;
+  }
+  if((nX < 1) || (nY < 1) || (nZ < 1))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else if(num > 1)
+  {
+    eSz = (flt)? sizeof(float): sizeof(double);
+    nThr = AlgFFTNumThreads();
+    nBat = (grpLen + ALG_FFT_BATCH - 1) / ALG_FFT_BATCH;
+    plan = AlgFFTPlanGet(num, 0, &errNum);
+    if(errNum == ALG_ERR_NONE)
+    {
+      wrkSz = plan->wrkSz + (2 * ALG_FFT_BATCH * (size_t )num);
+      if((wrk = (char *)AlcMalloc(eSz * wrkSz * nThr)) == NULL)
+      {
+	errNum = ALG_ERR_MALLOC;
+      }
+    }
+    if(errNum == ALG_ERR_NONE)
+    {
+      int	idB;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr)
+#endif
+      for(idB = 0; idB < nGrp * nBat; ++idB)
+      {
+	int	l0,
+		nB,
+		thrId = 0;
+	size_t	off;
+	char	*tWrk;
+
+#ifdef _OPENMP
+	thrId = omp_get_thread_num();
+#endif
+	tWrk = wrk + (eSz * wrkSz * thrId);
+	l0 = (idB % nBat) * ALG_FFT_BATCH;
+	nB = ALG_MIN(ALG_FFT_BATCH, grpLen - l0);
+	off = ((size_t )(idB / nBat) * grpOff) + l0;
+	if(flt)
+	{
+	  AlgFFTBatchF(plan, (float *)re + off, (float *)im + off,
+		       step, nB, dir, (float *)tWrk);
+	}
+	else
+	{
+	  AlgFFTBatchD(plan, (double *)re + off, (double *)im + off,
+		       step, nB, dir, (double *)tWrk);
+	}
+      }
+    }
+  }
+  AlcFree(wrk);
+  AlgFFTPlanFree(plan);
+  return(errNum);
+}
+
+/*!
+* \return	Error code.
+* \ingroup	AlgFourier
+* \brief	Computes the one dimensional transforms of all lines
+* 		parallel to the given axis of contiguous three
+* 		dimensional real data. Lines along the x axis are
+* 		transformed as real data and packed as in
+* 		AlgFFTRealDbl1D(). Along the other axes the lines
+* 		through the real parts of the x frequencies 0 and
+* 		\f$n_x/2\f$ are transformed as real data while the lines
+* 		through the other x frequencies are transformed as
+* 		complex data with their imaginary parts \f$n_x/2\f$ data
+* 		along the row, in batches of up to ALG_FFT_BATCH lines.
+* 		The lines and batches are transformed in parallel, each
+* 		thread with it's own workspace.
+* \param	data			Given data.
+* \param	flt			Non-zero if the data are float, zero
+* 					if they are double.
+* \param	nX			Number of data in each row.
+* \param	nY			Number of data in each column.
+* \param	nZ			Number of data in each plane.
+* \param	axis			Axis of the lines, 0, 1 or 2 for
+* 					x, y or z.
+* \param	dir			Transform direction.
+*/
+static AlgError	AlgFFTRepReal(void *data, int flt,
+			      int nX, int nY, int nZ, int axis, AlgFFTDir dir)
+{
+  int		num,
+  		half,
+		nGrp,
+		nReal,
+		nItem,
+		nThr,
+  		step;
+  size_t	eSz,
+  		wrkSz,
+		grpOff;
+  char		*wrk = NULL;
+  AlgFFTPlan	*rPlan = NULL,
+  		*cPlan = NULL;
+  AlgError	errNum = ALG_ERR_NONE;
+
+  /* Each group of lines holds nReal real lines, at x = 0 and x = half,
+   * followed by batches of the complex lines. */
+  half = nX / 2;
+  nReal = (half > 0)? 2: 1;
+  switch(axis)
+  {
+    case 0:
+      num = nX;
+      step = 1;
+      nGrp = nY * nZ;
+      grpOff = nX;
+      nReal = 1;
+      break;
+    case 1:
+      num = nY;
+      step = nX;
+      nGrp = nZ;
+      grpOff = (size_t )nX * nY;
+      break;
+    default:
+      num = nZ;
+      step = nX * nY;
+      nGrp = nY;
+      grpOff = nX;
+      break;
+  }
+  nItem = nReal;
+  if((axis != 0) && (half > 1))
+  {
+    nItem += (half + ALG_FFT_BATCH - 2) / ALG_FFT_BATCH;
+  }
+  if((nX < 1) || (nY < 1) || (nZ < 1) || ((nX > 1) && ((nX % 2) != 0)))
+  {
+    errNum = ALG_ERR_FUNC;
+  }
+  else if(num > 1)
+  {
+    eSz = (flt)? sizeof(float): sizeof(double);
+    nThr = AlgFFTNumThreads();
+    rPlan = AlgFFTPlanGet(num, 1, &errNum);
+    if((errNum == ALG_ERR_NONE) && (nItem > nReal))
+    {
+      cPlan = AlgFFTPlanGet(num, 0, &errNum);
+    }
+    if(errNum == ALG_ERR_NONE)
+    {
+      wrkSz = rPlan->wrkSz;
+      if(cPlan)
+      {
+        wrkSz = ALG_MAX(wrkSz, cPlan->wrkSz +
+	                       (2 * ALG_FFT_BATCH * (size_t )num));
+      }
+      if((wrk = (char *)AlcMalloc(eSz * wrkSz * nThr)) == NULL)
+      {
+	errNum = ALG_ERR_MALLOC;
+      }
+    }
+    if(errNum == ALG_ERR_NONE)
+    {
+      int	idI;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr)
+#endif
+      for(idI = 0; idI < nGrp * nItem; ++idI)
+      {
+	int	idX,
+		item,
+		thrId = 0;
+	size_t	off;
+	char	*tWrk;
+
+#ifdef _OPENMP
+	thrId = omp_get_thread_num();
+#endif
+	tWrk = wrk + (eSz * wrkSz * thrId);
+	item = idI % nItem;
+	off = (size_t )(idI / nItem) * grpOff;
+	if(item < nReal)
+	{
+	  idX = (item == 0)? 0: half;
+	  if(flt)
+	  {
+	    (void )AlgFFTRealFlt1D(rPlan, (float *)data + off + idX, step,
+	                           dir, (float *)tWrk);
+	  }
+	  else
+	  {
+	    (void )AlgFFTRealDbl1D(rPlan, (double *)data + off + idX, step,
+	                           dir, (double *)tWrk);
+	  }
+	}
+	else
+	{
+	  int	nB;
+
+	  idX = 1 + ((item - nReal) * ALG_FFT_BATCH);
+	  nB = ALG_MIN(ALG_FFT_BATCH, half - idX);
+	  off += idX;
+	  if(flt)
+	  {
+	    AlgFFTBatchF(cPlan, (float *)data + off,
+			 (float *)data + off + half, step, nB, dir,
+			 (float *)tWrk);
+	  }
+	  else
+	  {
+	    AlgFFTBatchD(cPlan, (double *)data + off,
+			 (double *)data + off + half, step, nB, dir,
+			 (double *)tWrk);
+	  }
+	}
+      }
+    }
+  }
+  AlcFree(wrk);
+  AlgFFTPlanFree(rPlan);
+  AlgFFTPlanFree(cPlan);
+  return(errNum);
+}
@@ -67,13 +67,15 @@ static char _AlgFourier_c[] = "University of Edinburgh $Id$";
 				  libAlg for Woolz.</td>
 		  </tr>
 </table>
-* 		The multi-dimensional transform routines may be supplied
-*		with a use buffers flag, which if set will allocate
-*		buffers sufficient to hold copies of the data to
-*		ensure the transforms are only computed for contiguous
-*		data. Using buffers can result in an order of magnitude
-*		lower run times depending on whether the array fit into
-*		the fastest caches of the CPUs.
+* 		The Fourier transforms are now computed by the mixed
+*		radix code in AlgFFT.c, which transforms data of any
+*		length and precomputes and caches its twiddle factors,
+*		rather than by the Hartley transform which is only used
+*		if a transform plan can not be made. The multi-dimensional
+*		transform routines always copy the lines of data to
+*		contiguous buffers, so their use buffers flag is unused,
+*		and the data arrays must be contiguous as allocated by
+*		AlcDouble2Malloc() and AlcDouble3Malloc().
 * \ingroup      AlgFourier
 * \todo         -
 * \bug          None known.
@@ -86,59 +88,24 @@ static char _AlgFourier_c[] = "University of Edinburgh $Id$";
 #endif
 
 
-/*!
-* \enum 	 _AlgFourDir
-* \brief	 Transform direction: Forward or inverse Fourier transform.
-*/
-typedef enum _AlgFourDir
-{
-  ALG_FOUR_DIR_FWD = 0,
-  ALG_FOUR_DIR_INV = 1
-} AlgFourDir;
-
-/*!
-* \enum         _AlgFourAxis
-* \brief        Axis for partial transform evaluation.
-*/
-typedef enum _AlgFourAxis
-{
-  ALG_FOUR_AXIS_X = 0,
-  ALG_FOUR_AXIS_Y = 1,
-  ALG_FOUR_AXIS_Z = 2
-} AlgFourAxis;
-
-static AlgError			AlgFourRepXY1D(
-				  double **real,
-				  double **imag,
-			          AlgFourAxis axis,
-				  int useBuf,
-			          int numX,
-				  int numY,
-				  AlgFourDir dir);
-static AlgError			AlgFourRepXYReal1D(
-				  double **data,
-				  AlgFourAxis axis,
-				  int useBuf,
-				  int numX,
-				  int numY,
-				  AlgFourDir dir);
-static AlgError			AlgFourRepXYZ1D(
-				  double ***real,
-				  double ***imag,
-			          AlgFourAxis axis,
-				  int useBuf,
-			          int numX,
-				  int numY,
-				  int numZ,
-				  AlgFourDir dir);
-static AlgError			AlgFourRepXYZReal1D(
-				  double ***data,
-				  AlgFourAxis axis,
-				  int useBuf,
-				  int numX,
-				  int numY,
-				  int numZ,
-				  AlgFourDir dir);
+static void			AlgFourHartCpx1D(
+				  double *real,
+				  double *imag,
+				  int num,
+				  int step);
+static void			AlgFourHartCpxInv1D(
+				  double *real,
+				  double *imag,
+				  int num,
+				  int step);
+static void			AlgFourHartReal1D(
+				  double *real,
+				  int num,
+				  int step);
+static void			AlgFourHartRealInv1D(
+				  double *real,
+				  int num,
+				  int step);
 
 /*!
 * \return	void
@@ -666,21 +633,31 @@ void		AlgFourHart1D(double *data, int num, int step)
 * \ingroup      AlgFourier
 * \brief	Computes the Hartley transform of the given two
 *		dimensional data, and does it in place.
+*		If useBuf is zero the columns are transformed in place
+*		using data[0] + x with a step of numX, so the data must
+*		then be contiguous, ie data[y] = data[0] + (y * numX).
 * \param	data			Given data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Allocate private buffers, one for
+* 					each thread, to make columns
+* 					contiguous. This also allows the
+* 					rows to be allocated separately.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 */
 AlgError 	AlgFourHart2D(double **data, int useBuf, int numX, int numY)
 {
+  int		nThr = 1;
   double	*buf = NULL;
   AlgError	errNum = ALG_ERR_NONE;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourHart2D FE %p %d %d %d\n",
 	   data, useBuf, numX, numY));
-  if(useBuf && ((buf = (double*)AlcMalloc(numY * sizeof(double))) == NULL))
+#ifdef _OPENMP
+  nThr = omp_get_max_threads();
+#endif
+  if(useBuf &&
+     ((buf = (double*)AlcMalloc(sizeof(double) * numY * nThr)) == NULL))
   {
     errNum = ALG_ERR_MALLOC;
   }
@@ -736,14 +713,21 @@ AlgError 	AlgFourHart2D(double **data, int useBuf, int numX, int numY)
     {
       if(useBuf)
       {
+	double	*tBuf;
+
+#ifdef _OPENMP
+	tBuf = buf + (numY * omp_get_thread_num());
+#else
+	tBuf = buf;
+#endif
 	for(idY = 0; idY < numY; ++idY)
 	{
-	  buf[idY] = data[idY][idX];
+	  tBuf[idY] = data[idY][idX];
 	}
-	AlgFourHart1D(buf, numY, 1);
+	AlgFourHart1D(tBuf, numY, 1);
 	for(idY = 0; idY < numY; ++idY)
 	{
-	  data[idY][idX] = buf[idY];
+	  data[idY][idX] = tBuf[idY];
 	}
       }
       else
@@ -759,156 +743,90 @@ AlgError 	AlgFourHart2D(double **data, int useBuf, int numX, int numY)
 }
 
 /*!
-* \return	void
+* \return	Error code, set if the transform can not be planned
+*		and the number of data is not a power of two.
 * \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given one
 *		dimensional complex data, and does it in place.
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n}\f$.
+*		The transform is computed by the mixed radix fast
+*		Fourier transform code (see AlgFFT.c) so any number
+*		of data may be transformed.
 * \param	real			Given real data.
 * \param	imag			Given imaginary data.
 * \param	num			Number of data.
 * \param	step			Offset in data elements between
 *					the data to be transformed.
 */
-void		AlgFour1D(double *real, double *imag, int num, int step)
+AlgError	AlgFour1D(double *real, double *imag, int num, int step)
 {
-  double	tD0,
-		tD1,
-		tD2,
-		tD3,
-		tD4;
-  double	*tRp0,
-		*tRp1,
-		*tIp0,
-		*tIp1;
-  int		count;
+  AlgFFTPlan	*plan;
+  AlgError	errNum;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour1D FE %p %p %d %d\n",
 	   real, imag, num, step));
-  tRp0 = real + step;
-  tRp1 = real + ((num - 1) * step);
-  tIp0 = imag + step;
-  tIp1 = imag + ((num - 1) * step);
-  count = (num / 2) - 1;
-  while(count-- > 0)
+  plan = AlgFFTPlanGet(num, 0, &errNum);
+  if(errNum == ALG_ERR_NONE)
   {
-    tD1 = *tRp0;
-    tD0 = *tRp1;
-    tD2 = tD1 - tD0;
-    tD1 += tD0;
-    tD3 = *tIp0;
-    tD0 = *tIp1;
-    tD4 = tD3 - tD0;
-    tD3 += tD0;
-    *tRp0 = (tD1 + tD4) * 0.5;
-    tRp0 += step;
-    *tRp1 = (tD1 - tD4) * 0.5;
-    tRp1 -= step;
-    *tIp0 = (tD3 - tD2) * 0.5;
-    tIp0 += step;
-    *tIp1 = (tD3 + tD2) * 0.5;
-    tIp1 -= step;
+    errNum = AlgFFTDbl1D(plan, real, imag, step, ALG_FFT_DIR_FWD, NULL);
+    AlgFFTPlanFree(plan);
   }
-#ifdef _OPENMP
-#pragma omp parallel sections
-#endif
+  if((errNum != ALG_ERR_NONE) && AlgBitIsPowerOfTwo(num))
   {
-#ifdef _OPENMP
-#pragma omp section
-#endif
-    {
-      AlgFourHart1D(real, num, step);
-    }
-#ifdef _OPENMP
-#pragma omp section
-#endif
-    {
-      AlgFourHart1D(imag, num, step);
-    }
+    errNum = ALG_ERR_NONE;
+    AlgFourHartCpx1D(real, imag, num, step);
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour1D FX\n"));
+  return(errNum);
 }
 
 /*!
-* \return	void
+* \return	Error code, set if the transform can not be planned
+*		and the number of data is not a power of two.
 * \ingroup   	AlgFourier
 * \brief	Computes the inverse Fourier transform of the given
 *		complex one dimensional data, and does it in place.
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n}\f$.
+*		The transform is computed by the mixed radix fast
+*		Fourier transform code (see AlgFFT.c) so any number
+*		of data may be transformed.
 * \param	real			Given real data.
 * \param	imag			Given imaginary data.
 * \param	num			Number of data.
 * \param	step			Offset in data elements between
 *					the data to be transformed.
 */
-void		AlgFourInv1D(double *real, double *imag, int num, int step)
+AlgError	AlgFourInv1D(double *real, double *imag, int num, int step)
 {
-  double	tD0,
-		tD1,
-		tD2,
-		tD3,
-		tD4;
-  double	*tRp0,
-		*tRp1,
-		*tIp0,
-		*tIp1;
-  int		count;
+  AlgFFTPlan	*plan;
+  AlgError	errNum;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv1D FE %p %p %d %d\n",
 	   real, imag, num, step));
-#ifdef _OPENMP
-#pragma omp parallel sections
-#endif
+  plan = AlgFFTPlanGet(num, 0, &errNum);
+  if(errNum == ALG_ERR_NONE)
   {
-#ifdef _OPENMP
-#pragma omp section
-#endif
-    {
-      AlgFourHart1D(real, num, step);
-    }
-#ifdef _OPENMP
-#pragma omp section
-#endif
-    {
-      AlgFourHart1D(imag, num, step);
-    }
+    errNum = AlgFFTDbl1D(plan, real, imag, step, ALG_FFT_DIR_INV, NULL);
+    AlgFFTPlanFree(plan);
   }
-  tRp0 = real + step;
-  tRp1 = real + ((num - 1) * step);
-  tIp0 = imag + step;
-  tIp1 = imag + ((num - 1) * step);
-  count = (num / 2) - 1;
-  while(count-- > 0)
+  if((errNum != ALG_ERR_NONE) && AlgBitIsPowerOfTwo(num))
   {
-    tD1 = *tRp0;
-    tD0 = *tRp1;
-    tD2 = tD1 - tD0;
-    tD1 += tD0;
-
-    tD3 = *tIp0;
-    tD0 = *tIp1;
-    tD4 = tD3 - tD0;
-    tD3 += tD0;
-    *tRp0 = (tD1 - tD4) * 0.5;
-    tRp0 += step;
-    *tRp1 = (tD1 + tD4) * 0.5;
-    tRp1 -= step;
-    *tIp0 = (tD3 + tD2) * 0.5;
-    tIp0 += step;
-    *tIp1 = (tD3 - tD2) * 0.5;
-    tIp1 -= step;
+    errNum = ALG_ERR_NONE;
+    AlgFourHartCpxInv1D(real, imag, num, step);
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv1D FX\n"));
+  return(errNum);
 }
 
 /*!
-* \return	void
+* \return	Error code, set if the transform can not be planned
+*		and the number of data is not a power of two.
 * \ingroup   	AlgFourier
 * \brief	Computes the Fourier transform of the given one
 *		dimensional real data, and does it in place.
@@ -929,54 +847,41 @@ void		AlgFourInv1D(double *real, double *imag, int num, int step)
 *		the arrays computed with AlgFour1D().
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n}\f$.
+*		The transform is computed by the mixed radix fast
+*		Fourier transform code (see AlgFFT.c) so any number
+*		of data may be transformed (provided it is even).
 * \param	real			Given real data.
 * \param	num			Number of data (N).
 * \param	step			Offset in data elements between
 *					the data to be transformed.
 */
-void		AlgFourReal1D(double *real, int num, int step)
+AlgError	AlgFourReal1D(double *real, int num, int step)
 {
-  double	tD0,
-		tD1;
-  double	*tRp0,
-		*tRp1;
-  int		count;
+  AlgFFTPlan	*plan;
+  AlgError	errNum;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal1D FE %p %d %d\n",
 	   real, num, step));
-  tRp0 = real + step;
-  tRp1 = real + ((num - 1) * step);
-  count = num / 2;
-  AlgFourHart1D(real, num, step);
-  while(--count > 0)
+  plan = AlgFFTPlanGet(num, 1, &errNum);
+  if(errNum == ALG_ERR_NONE)
   {
-    tD0 = *tRp0;
-    tD1 = *tRp1;
-    *tRp0 = (tD0 + tD1) * 0.5;
-    *tRp1 = (tD0 - tD1) * 0.5;
-    tRp0 += step;
-    tRp1 -= step;
+    errNum = AlgFFTRealDbl1D(plan, real, step, ALG_FFT_DIR_FWD, NULL);
+    AlgFFTPlanFree(plan);
   }
-  count = (num / 2);
-  tRp0 = real + ((count + 1) * step);
-  tRp1 = real + ((num - 1) * step);
-  while(count > 0)
+  if((errNum != ALG_ERR_NONE) && AlgBitIsPowerOfTwo(num))
   {
-    tD0 = -(*tRp0);
-    tD1 = -(*tRp1);
-    *tRp0 = tD1;
-    *tRp1 = tD0;
-    tRp0 += step;
-    tRp1 -= step;
-    count -= 2;
+    errNum = ALG_ERR_NONE;
+    AlgFourHartReal1D(real, num, step);
   }
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal1D FX\n"));
+  return(errNum);
 }
 
 /*!
-* \return	void
+* \return	Error code, set if the transform can not be planned
+*		and the number of data is not a power of two.
 * \ingroup   	AlgFourier
 * \brief	Computes the inverse Fourier transform of the given one
 *		one dimensional real data, and does it in place.
@@ -984,50 +889,36 @@ void		AlgFourReal1D(double *real, int num, int step)
 *		AlgFourReal1D().
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n}\f$.
+*		The transform is computed by the mixed radix fast
+*		Fourier transform code (see AlgFFT.c) so any number
+*		of data may be transformed (provided it is even).
 * \param	real			Given real/complex data.
 * \param	num			Number of data.
 * \param	step			Offset in data elements between
 *					the data to be transformed.
 */
-void		AlgFourRealInv1D(double *real, int num, int step)
+AlgError	AlgFourRealInv1D(double *real, int num, int step)
 {
-  double	tD0,
-		tD1;
-  double	*tRp0,
-		*tRp1;
-  int		count;
+  AlgFFTPlan	*plan;
+  AlgError	errNum;
 
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv1D FE %p %d %d\n",
 	   real, num, step));
-  count = (num / 2);
-  tRp0 = real + ((count + 1) * step);
-  tRp1 = real + ((num - 1) * step);
-  while(count > 0)
+  plan = AlgFFTPlanGet(num, 1, &errNum);
+  if(errNum == ALG_ERR_NONE)
   {
-    tD0 = -(*tRp0);
-    tD1 = -(*tRp1);
-    *tRp0 = tD1;
-    *tRp1 = tD0;
-    tRp0 += step;
-    tRp1 -= step;
-    count -= 2;
+    errNum = AlgFFTRealDbl1D(plan, real, step, ALG_FFT_DIR_INV, NULL);
+    AlgFFTPlanFree(plan);
   }
-  tRp0 = real + step;
-  tRp1 = real + ((num - 1) * step);
-  count = num / 2;
-  while(--count > 0)
+  if((errNum != ALG_ERR_NONE) && AlgBitIsPowerOfTwo(num))
   {
-    tD0 = *tRp0;
-    tD1 = *tRp1;
-    *tRp0 = (tD0 + tD1);
-    *tRp1 = (tD0 - tD1);
-    tRp0 += step;
-    tRp1 -= step;
+    errNum = ALG_ERR_NONE;
+    AlgFourHartRealInv1D(real, num, step);
   }
-  AlgFourHart1D(real, num, step);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv1D FX\n"));
+  return(errNum);
 }
 
 /*!
@@ -1039,8 +930,9 @@ void		AlgFourRealInv1D(double *real, int num, int step)
 *		of \f$\sqrt{n_x} \sqrt{n_y}\f$.
 * \param	real			Given real data.
 * \param	imag			Given imaginary data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Unused, the data must always be
+* 					contiguous and the lines of data
+* 					are copied to buffers in batches.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 */
@@ -1052,13 +944,7 @@ AlgError	AlgFour2D(double **real, double **imag,
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour2D FE %p %p %d %d %d\n",
 	   real, imag, useBuf, numX, numY));
-  errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
-                          numX, numY, ALG_FOUR_DIR_FWD);
-  if(errNum == ALG_ERR_NONE)
-  {
-    errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
-                            numX, numY, ALG_FOUR_DIR_FWD);
-  }
+  errNum = AlgFFTDbl2D(real, imag, numX, numY, ALG_FFT_DIR_FWD);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour2D FX\n"));
   return(errNum);
@@ -1073,8 +959,9 @@ AlgError	AlgFour2D(double **real, double **imag,
 *		of \f$\sqrt{n_x} \sqrt{n_y}\f$.
 * \param	real			Given real data.
 * \param	imag			Given imaginary data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Unused, the data must always be
+* 					contiguous and the lines of data
+* 					are copied to buffers in batches.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 */
@@ -1086,13 +973,7 @@ AlgError	AlgFourInv2D(double **real, double **imag,
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv2D FE %p %p %d %d %d\n",
 	   real, imag, useBuf, numX, numY));
-  errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
-                          numX, numY, ALG_FOUR_DIR_INV);
-  if(errNum == ALG_ERR_NONE)
-  {
-    errNum = AlgFourRepXY1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
-                            numX, numY, ALG_FOUR_DIR_INV);
-  }
+  errNum = AlgFFTDbl2D(real, imag, numX, numY, ALG_FFT_DIR_INV);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv2D FX\n"));
   return(errNum);
@@ -1117,28 +998,15 @@ AlgError	AlgFourInv2D(double **real, double **imag,
 	...    |...     |...|...         |...    |...     |...|...
 	i(M-1)0|r(2M-1)1|...|r(2M-1)(M-1)|i(M-1)M|i(2M-1)1|...|i(2M-1)(M-1)
 
-*		Using contiguous buffers has a large effect for
-*		data larger than a CPU's fastest cache and little
-*		cost for smaller data arrays.
-*		The times below were measured for on a Lenovo T430s
-*		with a i7-2640M with 4kB cache. Data sizes are the
-*		number of double values. These times include buffer
-*		allocation but not array allocation or file I/O
-*		and are the mean of 5 runs using elapsed (wall
-*		clock) time.
-*	data sz | tm (no buf, 1 thr) | tm (buf, 1 thr) | tm (buf, 2 thr)
- 	--------|--------------------|-----------------|-------------
-          256^2 |     3ms            |    3ms          |    2ms
-          512^2 |    12ms            |    6ms          |    4ms
-         1024^2 |   120ms            |   44ms          |   35ms
-         2048^2 |   600ms            |  170ms          |  110ms
-         4096^2 |  3300ms            |  764ms          |  460ms
-         8192^2 | 17000ms            | 3600ms          | 2100ms
+*		The data must be contiguous, ie real[y] = real[0] +
+*		(y * numX). The columns are gathered into contiguous
+*		buffers in batches of adjacent columns, see AlgFFT.c.
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n_x} \sqrt{n_y}\f$.
 * \param	real			Given real data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Unused, the data must always be
+* 					contiguous and the lines of data
+* 					are copied to buffers in batches.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 */
@@ -1150,13 +1018,7 @@ AlgError	AlgFourReal2D(double **real,
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal2D FE %p %d %d %d\n",
 	   real, useBuf, numX, numY));
-  errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_X, useBuf, numX, numY,
-                              ALG_FOUR_DIR_FWD);
-  if(errNum == ALG_ERR_NONE)
-  {
-    errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_Y, useBuf, numX, numY,
-    				ALG_FOUR_DIR_FWD);
-  }
+  errNum = AlgFFTRealDbl2D(real, numX, numY, ALG_FFT_DIR_FWD);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal2D FX\n"));
   return(errNum);
@@ -1171,8 +1033,9 @@ AlgError	AlgFourReal2D(double **real,
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n_x} \sqrt{n_y}\f$.
 * \param	real			Given real/complex data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Unused, the data must always be
+* 					contiguous and the lines of data
+* 					are copied to buffers in batches.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 */
@@ -1180,16 +1043,11 @@ AlgError	AlgFourRealInv2D(double **real,
 				 int useBuf, int numX, int numY)
 {
   AlgError	errNum;
+
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv2D FE %p %d %d %d\n",
 	   real, useBuf, numX, numY));
-  errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_Y, useBuf, numX, numY,
-                              ALG_FOUR_DIR_INV);
-  if(errNum == ALG_ERR_NONE)
-  {
-    errNum = AlgFourRepXYReal1D(real, ALG_FOUR_AXIS_X, useBuf, numX, numY,
-  				ALG_FOUR_DIR_INV);
-  }
+  errNum = AlgFFTRealDbl2D(real, numX, numY, ALG_FFT_DIR_INV);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv2D FX\n"));
   return(errNum);
@@ -1202,14 +1060,11 @@ AlgError	AlgFourRealInv2D(double **real,
 *		dimensional complex data, and does it in place.
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n_x} \sqrt{n_y} \sqrt{n_z}\f$.
-*
-*		Using contiguous buffers has a large effect for
-*		data larger than a CPU's fastest cache and little
-*		cost for smaller data arrays.
 * \param	real			Given real data.
 * \param	imag			Given imaginary data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Unused, the data must always be
+* 					contiguous and the lines of data
+* 					are copied to buffers in batches.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 * \param	numZ			Number of data in each plane.
@@ -1222,18 +1077,7 @@ AlgError	AlgFour3D(double ***real, double ***imag,
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour3D FE %p %p %d %d %d %d\n",
 	   real, imag, useBuf, numX, numY, numZ));
-  errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
-                           numX, numY, numZ, ALG_FOUR_DIR_FWD);
-  if(errNum == ALG_ERR_NONE)
-  {
-    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
-                             numX, numY, numZ, ALG_FOUR_DIR_FWD);
-  }
-  if(errNum == ALG_ERR_NONE)
-  {
-    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Z, useBuf,
-                             numX, numY, numZ, ALG_FOUR_DIR_FWD);
-  }
+  errNum = AlgFFTDbl3D(real, imag, numX, numY, numZ, ALG_FFT_DIR_FWD);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFour3D FX\n"));
   return(errNum);
@@ -1248,8 +1092,9 @@ AlgError	AlgFour3D(double ***real, double ***imag,
 *		of \f$\sqrt{n_x} \sqrt{n_y} \sqrt{n_z}\f$.
 * \param	real			Given real data.
 * \param	imag			Given imaginary data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Unused, the data must always be
+* 					contiguous and the lines of data
+* 					are copied to buffers in batches.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 * \param	numZ			Number of data in each plane.
@@ -1262,18 +1107,7 @@ AlgError	AlgFourInv3D(double ***real, double ***imag,
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv3D FE %p %p %d %d %d %d\n",
 	   real, imag, useBuf, numX, numY, numZ));
-  errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Z, useBuf,
-                          numX, numY, numZ, ALG_FOUR_DIR_INV);
-  if(errNum == ALG_ERR_NONE)
-  {
-    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_Y, useBuf,
-                            numX, numY, numZ, ALG_FOUR_DIR_INV);
-  }
-  if(errNum == ALG_ERR_NONE)
-  {
-    errNum = AlgFourRepXYZ1D(real, imag, ALG_FOUR_AXIS_X, useBuf,
-                            numX, numY, numZ, ALG_FOUR_DIR_INV);
-  }
+  errNum = AlgFFTDbl3D(real, imag, numX, numY, numZ, ALG_FFT_DIR_INV);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourInv3D FX\n"));
   return(errNum);
@@ -1286,12 +1120,10 @@ AlgError	AlgFourInv3D(double ***real, double ***imag,
 *		dimensional real data, and does it in place.
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n_x} \sqrt{n_y} \sqrt{n_z}\f$.
-*
-*		Using contiguous buffers has a large effect for
-*		data larger than a CPU's fastest cache and little
 * \param	real			Given real data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Unused, the data must always be
+* 					contiguous and the lines of data
+* 					are copied to buffers in batches.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 * \param	numZ			Number of data in each plane.
@@ -1304,18 +1136,7 @@ AlgError	AlgFourReal3D(double ***real,
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal3D FE %p %d %d %d %d\n",
 	   real, useBuf, numX, numY, numZ));
-  errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_X, useBuf,
-                               numX, numY, numZ, ALG_FOUR_DIR_FWD);
-  if(errNum == ALG_ERR_NONE)
-  {
-    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Y, useBuf,
-                                 numX, numY, numZ, ALG_FOUR_DIR_FWD);
-  }
-  if(errNum == ALG_ERR_NONE)
-  {
-    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Z, useBuf,
-    				 numX, numY, numZ, ALG_FOUR_DIR_FWD);
-  }
+  errNum = AlgFFTRealDbl3D(real, numX, numY, numZ, ALG_FFT_DIR_FWD);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourReal3D FX\n"));
   return(errNum);
@@ -1330,8 +1151,9 @@ AlgError	AlgFourReal3D(double ***real,
 *		The transformed values data are scaled by a factor
 *		of \f$\sqrt{n_x} \sqrt{n_y} \sqrt{n_z}\f$.
 * \param	real			Given real/complex data.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
+* \param	useBuf			Unused, the data must always be
+* 					contiguous and the lines of data
+* 					are copied to buffers in batches.
 * \param	numX			Number of data in each row.
 * \param	numY			Number of data in each column.
 * \param	numZ			Number of data in each plane.
@@ -1340,937 +1162,269 @@ AlgError	AlgFourRealInv3D(double ***real,
 				 int useBuf, int numX, int numY, int numZ)
 {
   AlgError	errNum;
+
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv3D FE %p %d %d %d %d\n",
 	   real, useBuf, numX, numY, numZ));
-  errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Z, useBuf,
-                               numX, numY, numZ, ALG_FOUR_DIR_INV);
-  if(errNum == ALG_ERR_NONE)
-  {
-    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_Y, useBuf,
-                                 numX, numY, numZ, ALG_FOUR_DIR_INV);
-  }
-  if(errNum == ALG_ERR_NONE)
-  {
-    errNum = AlgFourRepXYZReal1D(real, ALG_FOUR_AXIS_X, useBuf,
-                                 numX, numY, numZ, ALG_FOUR_DIR_INV);
-  }
+  errNum = AlgFFTRealDbl3D(real, numX, numY, numZ, ALG_FFT_DIR_INV);
   ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
 	  ("AlgFourRealInv3D FX\n"));
   return(errNum);
 }
 
 /*!
-* \return	Error code, may be set if buffers can not be allocated.
-* \brief	Computes repeated Fourier transforms of a 1D complex
-*	 	array within a complex array 2D.
-* \param	real			Given real 2D data array.
-* \param	imag			Given imaginary 2D data array.
-* \param	axis			Axis for partial evaluation.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
-* \param	numX			Number of data columns in given
-*					data array.
-* \param	numY			Number of data rows in given
-*					data array.
-* \param	dir			Forward or inverse transform.
+* \return	void
+* \ingroup   	AlgFourier
+* \brief	Computes the Fourier transform of the given one
+*		dimensional complex data, in place, using the Hartley
+*		transform. See AlgFour1D().
+*		The number of data must be an integral power of two.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	num			Number of data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
 */
-static AlgError	AlgFourRepXY1D(double **real, double **imag,
-			       AlgFourAxis axis, int useBuf,
-			       int numX, int numY, AlgFourDir dir)
+static void	AlgFourHartCpx1D(double *real, double *imag,
+				 int num, int step)
 {
-  AlgError	errNum = ALG_ERR_NONE;
+  double	tD0,
+		tD1,
+		tD2,
+		tD3,
+		tD4;
+  double	*tRp0,
+		*tRp1,
+		*tIp0,
+		*tIp1;
+  int		count;
 
-  if(axis == ALG_FOUR_AXIS_X)                              /* Transform rows */
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourHartCpx1D FE %p %p %d %d\n",
+	   real, imag, num, step));
+  tRp0 = real + step;
+  tRp1 = real + ((num - 1) * step);
+  tIp0 = imag + step;
+  tIp1 = imag + ((num - 1) * step);
+  count = (num / 2) - 1;
+  while(count-- > 0)
   {
-    if(dir == ALG_FOUR_DIR_FWD)
-    {
-      int	idY;
-
-#ifdef _OPENMP
-#pragma omp parallel for private(idY)
-#endif
-      for(idY = 0; idY < numY; ++idY)
-      {
-	AlgFour1D(*(real + idY), *(imag + idY), numX, 1);
-      }
-    }
-    else
-    {
-      int	idY;
-
-#ifdef _OPENMP
-#pragma omp parallel for private(idY)
-#endif
-      for(idY = 0; idY < numY; ++idY)
-      {
-	AlgFourInv1D(*(real + idY), *(imag + idY), numX, 1);
-      }
-    }
+    tD1 = *tRp0;
+    tD0 = *tRp1;
+    tD2 = tD1 - tD0;
+    tD1 += tD0;
+    tD3 = *tIp0;
+    tD0 = *tIp1;
+    tD4 = tD3 - tD0;
+    tD3 += tD0;
+    *tRp0 = (tD1 + tD4) * 0.5;
+    tRp0 += step;
+    *tRp1 = (tD1 - tD4) * 0.5;
+    tRp1 -= step;
+    *tIp0 = (tD3 - tD2) * 0.5;
+    tIp0 += step;
+    *tIp1 = (tD3 + tD2) * 0.5;
+    tIp1 -= step;
   }
-  else /* axis == ALG_FOUR_AXIS_Y */                    /* Transform columns */
-  {
-    if(useBuf)	                           /* Use column buffers if provided */
-    {
-      int	nThr = 1;
-      double	*bufBase = NULL;
-
 #ifdef _OPENMP
-#pragma omp parallel
-      {
-#pragma omp master
-        {
-	  nThr = omp_get_num_threads();
-	}
-      }
-#endif
-      if((bufBase = AlcMalloc(sizeof(double) * numY * 2 * nThr)) == NULL)
-      {
-	errNum = ALG_ERR_MALLOC;
-      }
-      if(errNum == ALG_ERR_NONE)
-      {
-        int	idX;
-
-#ifdef _OPENMP
-#pragma omp parallel for private(idX) num_threads(nThr)
+#pragma omp parallel sections
 #endif
-	for(idX = 0; idX < numX; ++idX)
-	{
-	  int	  idY,
-	  	  thrId = 0;
-	  double  *reBuf,
-		  *imBuf;
-
+  {
 #ifdef _OPENMP
-	  thrId = omp_get_thread_num();
+#pragma omp section
 #endif
-	  reBuf = bufBase + (2 * numY * thrId);
-	  imBuf = reBuf + numY;
-	  /* Copy to buffer. */
-	  for(idY = 0; idY < numY; ++idY)
-	  {
-	    *(reBuf + idY) = *(*(real + idY) + idX);
-	    *(imBuf + idY) = *(*(imag + idY) + idX);
-	  }
-	  /* Transform buffer. */
-	  if(dir == ALG_FOUR_DIR_FWD)
-	  {
-	    AlgFour1D(reBuf, imBuf, numY, 1);
-	  }
-	  else
-	  {
-	    AlgFourInv1D(reBuf, imBuf, numY, 1);
-	  }
-	  /* Copy back from buffer. */
-	  for(idY = 0; idY < numY; ++idY)
-	  {
-	    *(*(real + idY) + idX) = *(reBuf + idY);
-	    *(*(imag + idY) + idX) = *(imBuf + idY);
-	  }
-	}
-	AlcFree(bufBase);
-      }
-    }
-    else              /* If no column buffers transform the columns in place */
     {
-      int	idX;
-
-      if(dir == ALG_FOUR_DIR_FWD)
-      {
-#ifdef _OPENMP
-#pragma omp parallel for private(idX)
-#endif
-	for(idX = 0; idX < numX; ++idX)
-	{
-	  AlgFour1D(*real + idX, *imag + idX, numY, numX);
-        }
-      }
-      else
-      {
+      AlgFourHart1D(real, num, step);
+    }
 #ifdef _OPENMP
-#pragma omp parallel for private(idX)
+#pragma omp section
 #endif
-	for(idX = 0; idX < numX; ++idX)
-	{
-	  AlgFourInv1D(*real + idX, *imag + idX, numY, numX);
-        }
-      }
+    {
+      AlgFourHart1D(imag, num, step);
     }
   }
-  return(errNum);
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourHartCpx1D FX\n"));
 }
 
 /*!
-* \return	Error code, may be set if buffers can not be allocated.
-* \brief	Computes repeated the Fourier transforms of the given
-*	 	one dimensional real data array.
-* \brief	Computes repeated Fourier transforms of a 1D real/
-*	 	complex conjugate array within a 2D real/complex conjugate
-*	 	array.
-* \param	data			Given 2D data array.
-* \param	axis			Axis for partial evaluation.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
-* \param	numX			Number of data columns in given
-*					data array.
-* \param	numY			Number of data rows in given
-*					data array.
-* \param	dir			Forward or inverse transform.
+* \return	void
+* \ingroup   	AlgFourier
+* \brief	Computes the inverse Fourier transform of the given one
+*		dimensional complex data, in place, using the Hartley
+*		transform. See AlgFourInv1D().
+*		The number of data must be an integral power of two.
+* \param	real			Given real data.
+* \param	imag			Given imaginary data.
+* \param	num			Number of data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
 */
-static AlgError	AlgFourRepXYReal1D(double **data, AlgFourAxis axis, int useBuf,
-				   int numX, int numY, AlgFourDir dir)
+static void	AlgFourHartCpxInv1D(double *real, double *imag,
+				    int num, int step)
 {
-  AlgError	errNum = ALG_ERR_NONE;
-
-  if(axis == ALG_FOUR_AXIS_X)			 	   /* Transform rows */
-  {
-    if(dir == ALG_FOUR_DIR_FWD)
-    {
-      int 	idY;
-
-#ifdef _OPENMP
-#pragma omp parallel for private(idY)
-#endif
-      for(idY = 0; idY < numY; ++idY)
-      {
-	AlgFourReal1D(*(data + idY), numX, 1);
-      }
-    }
-    else
-    {
-      int	idY;
-
-#ifdef _OPENMP
-#pragma omp parallel for private(idY)
-#endif
-      for(idY = 0; idY < numY; ++idY)
-      {
-	AlgFourRealInv1D(*(data + idY), numX, 1);
-      }
-    }
-  }
-  else /* axis == ALG_FOUR_AXIS_Y */			/* Transform columns */
-  {
-    int		halfData;
-
-    halfData = numX / 2;
-    if(useBuf)
-    {
-      int	nThr = 1;
-      double	*bufBase = NULL;
+  double	tD0,
+		tD1,
+		tD2,
+		tD3,
+		tD4;
+  double	*tRp0,
+		*tRp1,
+		*tIp0,
+		*tIp1;
+  int		count;
 
-#ifdef _OPENMP
-#pragma omp parallel
-      {
-#pragma omp master
-        {
-          nThr = omp_get_num_threads();
-	}
-      }
-#endif
-      if((bufBase = AlcMalloc(sizeof(double) * numY * 2 * nThr)) == NULL)
-      {
-	errNum = ALG_ERR_MALLOC;
-      }
-      if(errNum == ALG_ERR_NONE)
-      {
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourHartCpxInv1D FE %p %p %d %d\n",
+	   real, imag, num, step));
 #ifdef _OPENMP
 #pragma omp parallel sections
 #endif
-	{
-#ifdef _OPENMP
-#pragma omp section
-#endif
-	  {
-	    int	    idY,
-		    thrId = 0;
-	    double  *reBuf;
-
-#ifdef _OPENMP
-	    thrId = omp_get_thread_num();
-#endif
-	    reBuf = bufBase + (numY * thrId);
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(reBuf + idY) = **(data + idY);
-	    }
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFourReal1D(reBuf, numY, 1);
-	    }
-	    else
-	    {
-	      AlgFourRealInv1D(reBuf, numY, 1);
-	    }
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      **(data + idY) = *(reBuf + idY);
-	    }
-	  }
+  {
 #ifdef _OPENMP
 #pragma omp section
 #endif
-	  {
-	    int	    idY,
-		    thrId = 0;
-	    double  *reBuf;
-
-#ifdef _OPENMP
-	    thrId = omp_get_thread_num();
-#endif
-	    reBuf = bufBase + (numY * thrId);
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(reBuf + idY) = *(*(data + idY) + halfData);
-	    }
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFourReal1D(reBuf, numY, 1);
-	    }
-	    else
-	    {
-	      AlgFourRealInv1D(reBuf, numY, 1);
-	    }
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(*(data + idY) + halfData) = *(reBuf + idY);
-	    }
-	  }
-	}
-	{
-	  int	idX;
-
-#ifdef _OPENMP
-#pragma omp parallel for private(idX)
-#endif
-	  for(idX = 1; idX < halfData; ++idX)
-	  {
-	    int	   idY,
-		   thrId = 0;
-	    double *reBuf,
-		   *imBuf;
-
-#ifdef _OPENMP
-	    thrId = omp_get_thread_num();
-#endif
-	    reBuf = bufBase + (2 * numY * thrId);
-	    imBuf = reBuf + numY;
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(reBuf + idY) = *(*(data + idY) + idX);
-	      *(imBuf + idY) = *(*(data + idY) + halfData + idX);
-	    }
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFour1D(reBuf, imBuf, numY, 1);
-	    }
-	    else
-	    {
-	      AlgFourInv1D(reBuf, imBuf, numY, 1);
-	    }
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(*(data + idY) + idX) = *(reBuf + idY);
-	      *(*(data + idY) + halfData + idX) = *(imBuf + idY);
-	    }
-	  }
-	}
-      }
-    }
-    else
     {
-      /* If no column buffers then just transform the columns in place this
-       * is done by: transforming column 0, transform column numX/2 and then
-       * transforming the remaining columns. */
-      if(dir == ALG_FOUR_DIR_FWD)
-      {
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-	{
-	  int	idX;
-#ifdef _OPENMP
-#pragma omp sections
-#endif
-	  {
-#ifdef _OPENMP
-#pragma omp section
-#endif
-	    {
-	      AlgFourReal1D(*data, numY, numX);
-	    }
-#ifdef _OPENMP
-#pragma omp section
-#endif
-	    {
-	      AlgFourReal1D(*data + halfData, numY, numX);
-	    }
-	  }
-#ifdef _OPENMP
-#pragma omp for private(idX)
-#endif
-	  for(idX = 1; idX < halfData; ++idX)
-	  {
-	    AlgFour1D(*data + idX, *data + halfData + idX, numY, numX);
-	  }
-	}
-      }
-      else
-      {
-        int 	idX;
-
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-	{
-#ifdef _OPENMP
-#pragma omp sections
-#endif
-	  {
-#ifdef _OPENMP
-#pragma omp section
-#endif
-	    {
-	      AlgFourRealInv1D(*data, numY, numX);
-	    }
+      AlgFourHart1D(real, num, step);
+    }
 #ifdef _OPENMP
 #pragma omp section
 #endif
-	    {
-	      AlgFourRealInv1D(*data + halfData, numY, numX);
-	    }
-	  }
-#ifdef _OPENMP
-#pragma omp for private(idX)
-#endif
-	  for(idX = 1; idX < halfData; ++idX)
-	  {
-	    AlgFourInv1D(*data + idX, *data + halfData + idX, numY,
-		numX);
-	  }
-	}
-      }
+    {
+      AlgFourHart1D(imag, num, step);
     }
   }
-  return(errNum);
+  tRp0 = real + step;
+  tRp1 = real + ((num - 1) * step);
+  tIp0 = imag + step;
+  tIp1 = imag + ((num - 1) * step);
+  count = (num / 2) - 1;
+  while(count-- > 0)
+  {
+    tD1 = *tRp0;
+    tD0 = *tRp1;
+    tD2 = tD1 - tD0;
+    tD1 += tD0;
+
+    tD3 = *tIp0;
+    tD0 = *tIp1;
+    tD4 = tD3 - tD0;
+    tD3 += tD0;
+    *tRp0 = (tD1 - tD4) * 0.5;
+    tRp0 += step;
+    *tRp1 = (tD1 + tD4) * 0.5;
+    tRp1 -= step;
+    *tIp0 = (tD3 + tD2) * 0.5;
+    tIp0 += step;
+    *tIp1 = (tD3 - tD2) * 0.5;
+    tIp1 -= step;
+  }
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourHartCpxInv1D FX\n"));
 }
 
 /*!
-* \return	Error code, may be set if buffers can not be allocated.
-* \brief	Computes repeated Fourier transforms of a 1D complex
-*	 	array within a complex array 3D.
-* \param	real			Given 3D real data array.
-* \param	imag			Given 3D imaginary data array.
-* \param	axis			Axis for partial evaluation.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
-* \param	numX			Number of data columns in given
-*					data array.
-* \param	numY			Number of data rows in given
-*					data array.
-* \param	numZ			Number of data planes in given
-*					data array.
-* \param	dir			Forward or inverse transform.
+* \return	void
+* \ingroup   	AlgFourier
+* \brief	Computes the Fourier transform of the given one
+*		dimensional real data, in place, using the Hartley
+*		transform. See AlgFourReal1D().
+*		The number of data must be an integral power of two.
+* \param	real			Given real data.
+* \param	num			Number of data (N).
+* \param	step			Offset in data elements between
+*					the data to be transformed.
 */
-static AlgError	AlgFourRepXYZ1D(double ***real, double ***imag,
-			        AlgFourAxis axis, int useBuf,
-			        int numX, int numY, int numZ, AlgFourDir dir)
+static void	AlgFourHartReal1D(double *real, int num, int step)
 {
-  int		idX,
-  		idY,
-		idZ;
-  AlgError	errNum = ALG_ERR_NONE;
+  double	tD0,
+		tD1;
+  double	*tRp0,
+		*tRp1;
+  int		count;
 
-  switch(axis)
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourHartReal1D FE %p %d %d\n",
+	   real, num, step));
+  tRp0 = real + step;
+  tRp1 = real + ((num - 1) * step);
+  count = num / 2;
+  AlgFourHart1D(real, num, step);
+  while(--count > 0)
   {
-    case ALG_FOUR_AXIS_X:
-      /* Transform rows */
-#ifdef _OPENMP
-#pragma omp parallel for private(idY,idZ)
-#endif
-      for(idZ = 0; idZ < numZ; ++idZ)
-      {
-	for(idY = 0; idY < numY; ++idY)
-	{
-	  if(dir == ALG_FOUR_DIR_FWD)
-	  {
-	    AlgFour1D(*(*(real + idZ) + idY), *(*(imag + idZ) + idY),
-		numX, 1);
-	  }
-	  else
-	  {
-	    AlgFourInv1D(*(*(real + idZ) + idY), *(*(imag + idZ) + idY),
-		numX, 1);
-	  }
-	}
-      }
-      break;
-    case ALG_FOUR_AXIS_Y:
-      /* Transform columns */
-      if(useBuf)
-      {
-	int	nThr = 1;
-	double	*bufBase = NULL;
-
-#ifdef _OPENMP
-#pragma omp parallel
-	{
-#pragma omp master
-	  {
-	    nThr = omp_get_num_threads();
-	  }
-	}
-#endif
-	if((bufBase = AlcMalloc(sizeof(double) * numY * 2 * nThr)) == NULL)
-	{
-	  errNum = ALG_ERR_MALLOC;
-	}
-	if(errNum == ALG_ERR_NONE)
-	{
-#ifdef _OPENMP
-#pragma omp parallel for private(idX,idY,idZ) num_threads(nThr)
-#endif
-	  for(idZ = 0; idZ < numZ; ++idZ)
-	  {
-	    int	    thrId = 0;
-	    double  *reBuf,
-		    *imBuf;
-
-#ifdef _OPENMP
-	    thrId = omp_get_thread_num();
-#endif
-	    reBuf = bufBase + (2 * numY * thrId);
-	    imBuf = reBuf + numY;
-	    for(idX = 0; idX < numX; ++idX)
-	    {
-	      /* Copy to buffer. */
-	      for(idY = 0; idY < numY; ++idY)
-	      {
-		*(reBuf + idY) = *(*(*(real + idZ) + idY) + idX);
-		*(imBuf + idY) = *(*(*(imag + idZ) + idY) + idX);
-	      }
-	      /* Transform buffer. */
-	      if(dir == ALG_FOUR_DIR_FWD)
-	      {
-		AlgFour1D(reBuf, imBuf, numY, 1);
-	      }
-	      else
-	      {
-		AlgFourInv1D(reBuf, imBuf, numY, 1);
-	      }
-	      /* Copy back from buffer. */
-	      for(idY = 0; idY < numY; ++idY)
-	      {
-		*(*(*(real + idZ) + idY) + idX) = *(reBuf + idY);
-		*(*(*(imag + idZ) + idY) + idX) = *(imBuf + idY);
-	      }
-	    }
-	  }
-	  AlcFree(bufBase);
-	}
-      }
-      else
-      {
-#ifdef _OPENMP
-#pragma omp parallel for private(idX,idY,idZ)
-#endif
-	for(idZ = 0; idZ < numZ; ++idZ)
-	{
-	  for(idX = 0; idX < numX; ++idX)
-	  {
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFour1D(**(real + idZ) + idX, **(imag + idZ) + idX,
-		  numY, numX);
-	    }
-	    else
-	    {
-	      AlgFourInv1D(**(real + idZ) + idX, **(imag + idZ) + idX,
-		  numY, numX);
-	    }
-	  }
-	}
-      }
-      break;
-    case ALG_FOUR_AXIS_Z:
-      /* Transform columns */
-      if(useBuf)
-      {
-	int	nThr = 1;
-	double	*bufBase = NULL;
-
-#ifdef _OPENMP
-#pragma omp parallel
-	{
-#pragma omp master
-	  {
-	    nThr = omp_get_num_threads();
-	  }
-	}
-#endif
-	if((bufBase = AlcMalloc(sizeof(double) * numZ * 2 * nThr)) == NULL)
-	{
-	  errNum = ALG_ERR_MALLOC;
-	}
-	if(errNum == ALG_ERR_NONE)
-	{
-#ifdef _OPENMP
-#pragma omp parallel for private(idX,idY,idZ) num_threads(nThr)
-#endif
-	  for(idY = 0; idY < numY; ++idY)
-	  {
-	    int	    thrId = 0;
-	    double  *reBuf,
-		    *imBuf;
-
-#ifdef _OPENMP
-	    thrId = omp_get_thread_num();
-#endif
-	    reBuf = bufBase + (2 * numZ * thrId);
-	    imBuf = reBuf + numZ;
-	    for(idX = 0; idX < numX; ++idX)
-	    {
-	      /* Copy to buffer. */
-	      for(idZ = 0; idZ < numZ; ++idZ)
-	      {
-		*(reBuf + idZ) = *(*(*(real + idZ) + idY) + idX);
-		*(imBuf + idZ) = *(*(*(imag + idZ) + idY) + idX);
-	      }
-	      /* Transform buffer. */
-	      if(dir == ALG_FOUR_DIR_FWD)
-	      {
-		AlgFour1D(reBuf, imBuf, numZ, 1);
-	      }
-	      else
-	      {
-		AlgFourInv1D(reBuf, imBuf, numZ, 1);
-	      }
-	      /* Copy back from buffer. */
-	      for(idZ = 0; idZ < numZ; ++idZ)
-	      {
-		*(*(*(real + idZ) + idY) + idX) = *(reBuf + idZ);
-		*(*(*(imag + idZ) + idY) + idX) = *(imBuf + idZ);
-	      }
-	    }
-	  }
-	  AlcFree(bufBase);
-	}
-      }
-      else
-      {
-#ifdef _OPENMP
-#pragma omp parallel for private(idX,idY)
-#endif
-	for(idY = 0; idY < numY; ++idY)
-	{
-	  for(idX = 0; idX < numX; ++idX)
-	  {
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFour1D(*(*real + idY) + idX, *(*imag + idY) + idX,
-		  numZ, numX * numY);
-	    }
-	    else
-	    {
-	      AlgFourInv1D(*(*real + idY) + idX, *(*imag + idY) + idX,
-		  numZ, numX * numY);
-	    }
-	  }
-	}
-      }
-      break;
-    default:
-      break;
+    tD0 = *tRp0;
+    tD1 = *tRp1;
+    *tRp0 = (tD0 + tD1) * 0.5;
+    *tRp1 = (tD0 - tD1) * 0.5;
+    tRp0 += step;
+    tRp1 -= step;
   }
-  return(errNum);
+  count = (num / 2);
+  tRp0 = real + ((count + 1) * step);
+  tRp1 = real + ((num - 1) * step);
+  while(count > 0)
+  {
+    tD0 = -(*tRp0);
+    tD1 = -(*tRp1);
+    *tRp0 = tD1;
+    *tRp1 = tD0;
+    tRp0 += step;
+    tRp1 -= step;
+    count -= 2;
+  }
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourHartReal1D FX\n"));
 }
 
 /*!
-* \return	Error code, may be set if buffers can not be allocated.
-* \brief	Computes repeated the Fourier transforms of the given
-*	 	one dimensional real data array.
-* \brief	Computes repeated Fourier transforms of a 1D real/
-*	 	complex conjugate array within a 3D real/complex conjugate
-*	 	array.
-* \param	data			Given 2D data array.
-* \param	axis			Axis for partial evaluation.
-* \param	useBuf			Allocate private buffers to make
-* 					columns contiguous.
-* \param	numX			Number of data columns in given
-*					data array.
-* \param	numY			Number of data rows in given
-*					data array.
-* \param	numZ			Number of data planes in given
-*					data array.
-* \param	dir			Forward or inverse transform.
+* \return	void
+* \ingroup   	AlgFourier
+* \brief	Computes the inverse Fourier transform of the given one
+*		dimensional real data, in place, using the Hartley
+*		transform. See AlgFourRealInv1D().
+*		The number of data must be an integral power of two.
+* \param	real			Given real/complex data.
+* \param	num			Number of data.
+* \param	step			Offset in data elements between
+*					the data to be transformed.
 */
-static AlgError	AlgFourRepXYZReal1D(double ***data, AlgFourAxis axis,
-				    int useBuf,
-				    int numX, int numY, int numZ,
-				    AlgFourDir dir)
+static void	AlgFourHartRealInv1D(double *real, int num, int step)
 {
-  int		idX,
-		idY,
-		idZ,
-		halfData;
-  AlgError	errNum = ALG_ERR_NONE;
+  double	tD0,
+		tD1;
+  double	*tRp0,
+		*tRp1;
+  int		count;
 
-  switch(axis)
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourHartRealInv1D FE %p %d %d\n",
+	   real, num, step));
+  count = (num / 2);
+  tRp0 = real + ((count + 1) * step);
+  tRp1 = real + ((num - 1) * step);
+  while(count > 0)
   {
-    case  ALG_FOUR_AXIS_X:
-      /* Transform rows */
-#ifdef _OPENMP
-#pragma omp parallel for private(idX,idY,idZ)
-#endif
-      for(idZ = 0; idZ < numZ; ++idZ)
-      {
-	for(idY = 0; idY < numY; ++idY)
-	{
-	  if(dir == ALG_FOUR_DIR_FWD)
-	  {
-	    AlgFourReal1D(*(*(data + idZ) + idY), numX, 1);
-	  }
-	  else
-	  {
-	    AlgFourRealInv1D(*(*(data + idZ) + idY), numX, 1);
-	  }
-	}
-      }
-      break;
-    case  ALG_FOUR_AXIS_Y:
-      /* Transform columns */
-      halfData = numY / 2;
-      if(useBuf)
-      {
-	int	nThr = 1;
-	double	*bufBase = NULL;
-
-#ifdef _OPENMP
-#pragma omp parallel
-	{
-#pragma omp master
-	  {
-	    nThr = omp_get_num_threads();
-	  }
-	}
-#endif
-	if((bufBase = AlcMalloc(sizeof(double) * numY * 2 * nThr)) == NULL)
-	{
-	  errNum = ALG_ERR_MALLOC;
-	}
-	if(errNum == ALG_ERR_NONE)
-	{
-#ifdef _OPENMP
-#pragma omp parallel for private(idX,idY,idZ)
-#endif
-	  for(idZ = 0; idZ < numZ; ++idZ)
-	  {
-	    int	thrId = 0;
-	    double  *reBuf,
-	    	    *imBuf;
-#ifdef _OPENMP
-	    thrId = omp_get_thread_num();
-#endif
-	    reBuf = bufBase + (2 * numY * thrId);
-	    imBuf = reBuf + numY;
-	    /* Copy to buffer. */
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      *(reBuf + idY) = **(*(data + idZ) + idY);
-	      *(imBuf + idY) = *(*(*(data + idZ) + idY) + halfData);
-	    }
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFourReal1D(reBuf, numY, 1);
-	      AlgFourReal1D(imBuf, numY, 1);
-	    }
-	    else
-	    {
-	      AlgFourRealInv1D(reBuf, numY, 1);
-	      AlgFourRealInv1D(imBuf, numY, 1);
-	    }
-	    /* Copy back from buffer again. */
-	    for(idY = 0; idY < numY; ++idY)
-	    {
-	      **(*(data + idZ) + idY) = *(reBuf + idY);
-	      *(*(*(data + idZ) + idY) + halfData) = *(imBuf + idY);
-	    }
-	    for(idX = 1; idX < halfData; ++idX)
-	    {
-	      /* Copy to buffer. */
-	      for(idY = 0; idY < numY; ++idY)
-	      {
-		*(reBuf + idY) = *(*(*(data + idZ) + idY) + idX);
-		*(imBuf + idY) = *(*(*(data + idZ) + idY) + halfData + idX);
-	      }
-	      if(dir == ALG_FOUR_DIR_FWD)
-	      {
-		AlgFour1D(reBuf, imBuf, numY, 1);
-	      }
-	      else
-	      {
-		AlgFourInv1D(reBuf, imBuf, numY, 1);
-	      }
-	      /* Copy back. */
-	      for(idY = 0; idY < numY; ++idY)
-	      {
-		*(*(*(data + idZ) + idY) + idX) = *(reBuf + idY);
-		*(*(*(data + idZ) + idY) + halfData + idX) = *(imBuf + idY);
-	      }
-	    }
-	  }
-	  AlcFree(bufBase);
-        }
-      }
-      else
-      {
-#ifdef _OPENMP
-#pragma omp parallel for private(idX,idY,idZ)
-#endif
-	for(idZ = 0; idZ < numZ; ++idZ)
-	{
-	  if(dir == ALG_FOUR_DIR_FWD)
-	  {
-	    AlgFourReal1D(**(data + idZ), numY, numX);
-	    AlgFourReal1D(**(data + idZ) + halfData, numY, numX);
-	    for(idX = 1; idX < halfData; ++idX)
-	    {
-	      AlgFour1D(**(data + idZ) + idX,
-		  **(data + idZ) + halfData + idX, numY, numX);
-	    }
-	  }
-	  else
-	  {
-	    AlgFourRealInv1D(**(data + idZ), numY, numX);
-	    AlgFourRealInv1D(**(data + idZ) + halfData, numY, numX);
-	    for(idX = 1; idX < halfData; ++idX)
-	    {
-	      AlgFourInv1D(**(data + idZ) + idX,
-		  **(data + idZ) + halfData + idX, numY, numX);
-	    }
-	  }
-	}
-      }
-      break;
-    case  ALG_FOUR_AXIS_Z:
-      /* Transform planes */
-      halfData = numX / 2;
-      if(useBuf)
-      {
-	int	nThr = 1;
-	double	*bufBase = NULL;
-
-#ifdef _OPENMP
-#pragma omp parallel
-	{
-#pragma omp master
-	  {
-	    nThr = omp_get_num_threads();
-	  }
-	}
-#endif
-	if((bufBase = AlcMalloc(sizeof(double) * numZ * 2 * nThr)) == NULL)
-	{
-	  errNum = ALG_ERR_MALLOC;
-	}
-	if(errNum == ALG_ERR_NONE)
-	{
-#ifdef _OPENMP
-#pragma omp parallel for private(idX,idY,idZ)
-#endif
-	  for(idY = 0; idY < numY; ++idY)
-	  {
-	    int	thrId = 0;
-	    double  *reBuf,
-	    	    *imBuf;
-#ifdef _OPENMP
-	    thrId = omp_get_thread_num();
-#endif
-	    reBuf = bufBase + (2 * numZ * thrId);
-	    imBuf = reBuf + numZ;
-	    /* Copy to buffer. */
-	    for(idZ = 0; idZ < numZ; ++idZ)
-	    {
-	      *(reBuf + idZ) = **(*(data + idZ) + idY);
-	      *(imBuf + idZ) = *(*(*(data + idZ) + idY) + halfData);
-	    }
-	    if(dir == ALG_FOUR_DIR_FWD)
-	    {
-	      AlgFourReal1D(reBuf, numZ, 1);
-	      AlgFourReal1D(imBuf, numZ, 1);
-	    }
-	    else
-	    {
-	      AlgFourRealInv1D(reBuf, numZ, 1);
-	      AlgFourRealInv1D(imBuf, numZ, 1);
-	    }
-	    /* Copy back from buffer. */
-	    for(idZ = 0; idZ < numZ; ++idZ)
-	    {
-	      **(*(data + idZ) + idY) = *(reBuf + idZ);
-	      *(*(*(data + idZ) + idY) + halfData) = *(imBuf + idZ);
-	    }
-	    for(idX = 1; idX < halfData; ++idX)
-	    {
-	      /* Copy to buffer. */
-	      for(idZ = 0; idZ < numZ; ++idZ)
-	      {
-	        *(reBuf + idZ) = *(*(*(data + idZ) + idY) + idX);
-	        *(imBuf + idZ) = *(*(*(data + idZ) + idY) + halfData + idX);
-	      }
-	      if(dir == ALG_FOUR_DIR_FWD)
-	      {
-		AlgFour1D(reBuf, imBuf, numZ, 1);
-	      }
-	      else
-	      {
-		AlgFourInv1D(reBuf, imBuf, numZ, 1);
-	      }
-	      /* Copy back from buffer. */
-	      for(idZ = 0; idZ < numZ; ++idZ)
-	      {
-	        *(*(*(data + idZ) + idY) + idX) = *(reBuf + idZ);
-		*(*(*(data + idZ) + idY) + halfData + idX) = *(imBuf + idZ);
-	      }
-	    }
-
-	  }
-	  AlcFree(bufBase);
-	}
-      }
-      else
-      {
-#ifdef _OPENMP
-#pragma omp parallel for private(idX,idY,idZ)
-#endif
-	for(idY = 0; idY < numY; ++idY)
-	{
-	  if(dir == ALG_FOUR_DIR_FWD)
-	  {
-	    AlgFourReal1D(*(*data + idY), numZ, numX * numY);
-	    AlgFourReal1D(*(*data + idY) + halfData, numZ, numX * numY);
-	    for(idX = 1; idX < halfData; ++idX)
-	    {
-	      AlgFour1D(*(*data + idY) + idX,
-		  *(*data + idY) + halfData + idX, numZ, numX * numY);
-	    }
-	  }
-	  else
-	  {
-	    AlgFourRealInv1D(*(*data + idY), numZ, numX * numY);
-	    AlgFourRealInv1D(*(*data + idY) + halfData, numZ, numX * numY);
-	    for(idX = 1; idX < halfData; ++idX)
-	    {
-	      AlgFourInv1D(*(*data + idY) + idX,
-		  *(*data + idY) + halfData + idX, numZ, numX * numY);
-	    }
-	  }
-	}
-      }
-      break;
-    default:
-      break;
+    tD0 = -(*tRp0);
+    tD1 = -(*tRp1);
+    *tRp0 = tD1;
+    *tRp1 = tD0;
+    tRp0 += step;
+    tRp1 -= step;
+    count -= 2;
   }
-  return(errNum);
+  tRp0 = real + step;
+  tRp1 = real + ((num - 1) * step);
+  count = num / 2;
+  while(--count > 0)
+  {
+    tD0 = *tRp0;
+    tD1 = *tRp1;
+    *tRp0 = (tD0 + tD1);
+    *tRp1 = (tD0 - tD1);
+    tRp0 += step;
+    tRp1 -= step;
+  }
+  AlgFourHart1D(real, num, step);
+  ALG_DBG((ALG_DBG_LVL_FN|ALG_DBG_LVL_1),
+	  ("AlgFourHartRealInv1D FX\n"));
 }
@@ -122,6 +122,12 @@ extern AlgError 		AlgConvolve(
     	   	   		  int sizeArrayDat, 
 				  double *arrayDat,
     				  AlgPadType pad);
+extern AlgError			AlgConvolveFFT3D(
+				  double ***data,
+				  double ***krn,
+				  int nX,
+				  int nY,
+				  int nZ);
 
 /* From AlgCrossCorr.c */
 extern AlgError        		AlgCrossCorrelate2D(
@@ -129,6 +135,20 @@ extern AlgError        		AlgCrossCorrelate2D(
 				  double **data1,
 				  int nX,
 				  int nY);
+extern AlgError			AlgCrossCorrelate3D(
+				  double ***data0,
+				  double ***data1,
+				  int nX,
+				  int nY,
+				  int nZ);
+extern AlgError			AlgCrossCorrelateSpec3D(
+				  double ***tRe,
+				  double ***tIm,
+				  double ***data0,
+				  double ***data1,
+				  int nX,
+				  int nY,
+				  int nZ);
 extern void            		AlgCrossCorrPeakXY(
 				  int *dstMaxX,
 				  int *dstMaxY,
@@ -138,6 +158,18 @@ extern void            		AlgCrossCorrPeakXY(
 				  int nY,
 				  int searchX,
 				  int searchY);
+extern void			AlgCrossCorrPeakXYZ(
+				  int *dstMaxX,
+				  int *dstMaxY,
+				  int *dstMaxZ,
+				  double *dstMaxVal,
+				  double ***data,
+				  int nX,
+				  int nY,
+				  int nZ,
+				  int searchX,
+				  int searchY,
+				  int searchZ);
 extern void            		AlgCrossCorrPeakY(
 				  int *dstMaxY,
 				  double *dstMaxVal,
@@ -148,26 +180,116 @@ extern void            		AlgCrossCorrPeakY(
 extern AlgError			AlgDbgWrite(
 				  char *fmt, ...);
 
+/* From AlgFFT.c */
+extern int			AlgFFTGoodSize(
+				  int num,
+				  int even);
+extern AlgFFTPlan		*AlgFFTPlanNew(
+				  int num,
+				  int real,
+				  AlgError *dstErr);
+extern AlgFFTPlan		*AlgFFTPlanGet(
+				  int num,
+				  int real,
+				  AlgError *dstErr);
+extern void			AlgFFTPlanFree(
+				  AlgFFTPlan *plan);
+extern void			AlgFFTPlanCacheFree(void);
+extern AlgError			AlgFFTDbl1D(
+				  AlgFFTPlan *plan,
+				  double *re,
+				  double *im,
+				  int step,
+				  AlgFFTDir dir,
+				  double *wrk);
+extern AlgError			AlgFFTFlt1D(
+				  AlgFFTPlan *plan,
+				  float *re,
+				  float *im,
+				  int step,
+				  AlgFFTDir dir,
+				  float *wrk);
+extern AlgError			AlgFFTRealDbl1D(
+				  AlgFFTPlan *plan,
+				  double *data,
+				  int step,
+				  AlgFFTDir dir,
+				  double *wrk);
+extern AlgError			AlgFFTRealFlt1D(
+				  AlgFFTPlan *plan,
+				  float *data,
+				  int step,
+				  AlgFFTDir dir,
+				  float *wrk);
+extern AlgError			AlgFFTDbl2D(
+				  double **re,
+				  double **im,
+				  int nX,
+				  int nY,
+				  AlgFFTDir dir);
+extern AlgError			AlgFFTFlt2D(
+				  float **re,
+				  float **im,
+				  int nX,
+				  int nY,
+				  AlgFFTDir dir);
+extern AlgError			AlgFFTRealDbl2D(
+				  double **data,
+				  int nX,
+				  int nY,
+				  AlgFFTDir dir);
+extern AlgError			AlgFFTRealFlt2D(
+				  float **data,
+				  int nX,
+				  int nY,
+				  AlgFFTDir dir);
+extern AlgError			AlgFFTDbl3D(
+				  double ***re,
+				  double ***im,
+				  int nX,
+				  int nY,
+				  int nZ,
+				  AlgFFTDir dir);
+extern AlgError			AlgFFTFlt3D(
+				  float ***re,
+				  float ***im,
+				  int nX,
+				  int nY,
+				  int nZ,
+				  AlgFFTDir dir);
+extern AlgError			AlgFFTRealDbl3D(
+				  double ***data,
+				  int nX,
+				  int nY,
+				  int nZ,
+				  AlgFFTDir dir);
+extern AlgError			AlgFFTRealFlt3D(
+				  float ***data,
+				  int nX,
+				  int nY,
+				  int nZ,
+				  AlgFFTDir dir);
+
 /* From AlgFourier.c */
 extern void     		AlgFourHart1D(
 				  double *data,
 				  int num, 
 				  int step);
-extern void			AlgFour1D(
+extern AlgError			AlgFour1D(
 				  double *real,
 				  double *imag,
 				  int num,
 				  int step);
-extern void			AlgFourInv1D(
+extern AlgError			AlgFourInv1D(
 				  double *real,
 				  double *imag,
 				  int num,
 				  int step);
-extern void			AlgFourReal1D(
+extern AlgError			AlgFourReal1D(
 				  double *real,
 				  int num,
 				  int step);
-extern void			AlgFourRealInv1D(
+extern AlgError			AlgFourRealInv1D(
 				  double *real,
 				  int num,
 				  int step);
@@ -240,6 +240,65 @@ typedef struct _ComplexD
   double	im;
 } ComplexD;
 
+/*!
+* \def		ALG_FFT_MAX_STAGE
+* \brief	Maximum number of butterfly stages in a fast Fourier
+* 		transform plan.
+*/
+#define ALG_FFT_MAX_STAGE	(32)
+
+/*!
+* \enum		_AlgFFTDir
+* \brief	Fast Fourier transform direction.
+* 		Typedef: ::AlgFFTDir.
+*/
+typedef enum _AlgFFTDir
+{
+  ALG_FFT_DIR_FWD	= 0,	/*!< Forward transform, kernel
+  				     \f$e^{-2 \pi i j k / n}\f$. */
+  ALG_FFT_DIR_INV	= 1	/*!< Inverse transform, kernel
+  				     \f$e^{2 \pi i j k / n}\f$. */
+} AlgFFTDir;
+
+/*!
+* \struct	_AlgFFTPlan
+* \brief	A precomputed plan for mixed radix fast Fourier transforms
+* 		of a single length. Plans hold the digit reversal
+* 		permutation and the twiddle factors (in both double and
+* 		single precision) of each butterfly stage so that they
+* 		may be shared by any number of transforms and threads.
+* 		A plan for real data of length \f$n\f$ holds the twiddle
+* 		factors needed to unpack a complex transform of
+* 		length \f$n/2\f$ together with a plan for that transform.
+* 		A plan for a length with a large prime factor has no
+* 		butterfly stages, instead it holds the chirp and
+* 		convolution kernel of Bluestein's algorithm together
+* 		with a plan for the convolution.
+* 		Typedef: ::AlgFFTPlan.
+*/
+typedef struct _AlgFFTPlan
+{
+  int		linkcount;	/*!< Usage count. */
+  int		num;		/*!< Transform length. */
+  int		real;		/*!< Non-zero if the plan is for real data. */
+  int		nStage;		/*!< Number of butterfly stages. */
+  int		radix[ALG_FFT_MAX_STAGE]; /*!< Radix of each stage, in the
+  				     order in which the stages are applied. */
+  int		wrkSz;		/*!< Number of elements required for a
+  				     transform workspace. */
+  int		*perm;		/*!< Digit reversal permutation, the input
+  				     index of each workspace element. */
+  double	*twRe;		/*!< Real parts of the twiddle factors. */
+  double	*twIm;		/*!< Imaginary parts of the twiddle factors. */
+  float		*twReF;		/*!< Single precision copy of twRe. */
+  float		*twImF;		/*!< Single precision copy of twIm. */
+  struct _AlgFFTPlan *half;	/*!< Complex plan for half the length,
+  				     only used for real data. */
+  struct _AlgFFTPlan *conv;	/*!< Complex plan for the convolution of
+  				     Bluestein's algorithm, only used for
+				     lengths with a large prime factor. */
+} AlgFFTPlan;
+
 
 /*
 * \enum		_AlgError
@@ -42,6 +42,92 @@ static char _ReconstructAuto_c[] = "University of Edinburgh $Id$";
 
 #include <Reconstruct.h>
 #include <string.h>
+#include <time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \struct	_RecAutoParWork
+* \ingroup	Reconstruct
+* \brief	Application supplied work function and it's data, used
+*		to serialise calls to the work function from concurrent
+*		pairwise registrations.
+*/
+typedef struct _RecAutoParWork
+{
+  RecWorkFunction	fn;
+  void			*data;
+} RecAutoParWork;
+
+/*!
+* \enum	_RecAutoParTask
+* \ingroup	Reconstruct
+* \brief	Tasks taken from the RecAutoParallel() queue.
+*/
+typedef enum _RecAutoParTask
+{
+  REC_AUTOPAR_TASK_NONE,	/*!< No task is available. */
+  REC_AUTOPAR_TASK_READ,	/*!< Read the next section image. */
+  REC_AUTOPAR_TASK_REGISTER	/*!< Register the next pair of sections. */
+} RecAutoParTask;
+
+/*!
+* \struct	_RecAutoParQueue
+* \ingroup	Reconstruct
+* \brief	Bounded queue of section images shared by the threads of
+*		RecAutoParallel(). Sections are indexed from zero in
+*		section order and all counts other than nSec and maxHeld
+*		are only accessed with the lock set.
+*/
+typedef struct _RecAutoParQueue
+{
+  int			nSec;		/*!< Number of sections. */
+  int			maxHeld;	/*!< Maximum number of section images
+  					     held. */
+  int			nHeld;		/*!< Number of section images held or
+  					     being read. */
+  int			nRead;		/*!< Number of section images read,
+  					     which are always the first
+					     sections. */
+  int			reading;	/*!< Non-zero while a section image is
+  					     being read. */
+  int			nextPair;	/*!< Index of the next section to be
+  					     registered with it's
+					     predecessor. */
+  int			lastUpdated;	/*!< Index of the last section passed
+  					     to the section update
+					     function. */
+  int			firstHeld;	/*!< Index of the first section which
+  					     may still have it's image. */
+  int			stop;		/*!< Non-zero when no more tasks
+  					     should be started. */
+  int			*nUse;		/*!< Number of registrations still to
+  					     use each section image. */
+  int			*done;		/*!< Non-zero for each section once
+  					     registered. */
+  RecSection		**secs;		/*!< Duplicated sections. */
+  RecError		*pErr;		/*!< Error for each section. */
+  char			**pMsg;		/*!< Error message for each
+  					     section. */
+  RecControl		*rCtrl;		/*!< Registration control. */
+  RecPPControl		*ppCtrl;	/*!< Pre-processing control. */
+  int			*cancelFlag;	/*!< Cancel if non-zero. */
+  RecSecUpdateFunction	secFn;		/*!< Section update function. */
+  void			*secData;	/*!< Section update function data. */
+  RecAutoParWork	work;		/*!< Application work function. */
+#ifdef _OPENMP
+  omp_lock_t		lock;		/*!< Lock for the queue. */
+#endif
+} RecAutoParQueue;
+
+static void			RecAutoParRun(
+				  RecAutoParQueue *queue);
+static void			RecAutoParUpdate(
+				  RecAutoParQueue *queue);
+static void			RecAutoParWorkFn(
+				  RecState *state,
+				  void *data);
 
 /*!
 * \return	Non zero if registration fails.
@@ -220,3 +306,446 @@ RecError	RecAuto(RecControl *rCtrl, RecPPControl *ppCtrl,
 	   errFlag));
   return(errFlag);
 }
+
+/*!
+* \return	Non zero if registration fails.
+* \ingroup	Reconstruct
+* \brief	Performs the automatic registration of serial sections,
+*		registering neighbouring pairs of sections concurrently.
+*
+*		This function has the same results as RecAuto(), but
+*		because the pairwise registrations are independent they
+*		are computed in parallel using a bounded queue of section
+*		images. Each thread repeatedly takes the next task from
+*		the queue: either registering the next section with it's
+*		predecessor, once both of their images have been read, or
+*		else reading the next section image, if no other thread
+*		is reading and the queue is not full. So the sections are
+*		read in order by a single producer at a time while the
+*		other threads register pairs as soon as they are
+*		available, and no more than the given number of section
+*		images are held in memory.
+*		Registered sections are passed to the section update
+*		function in section order and each section image is
+*		freed once the section has been updated and both of it's
+*		registrations are complete. Once all sections have been
+*		registered the cumulative transforms of the sections in
+*		the list are recomputed.
+*		Calls to the work function are serialised, but may be
+*		made from any thread, and the section update function is
+*		called with the queue locked.
+*		Cancellation is checked before each section is read and
+*		before each pair is registered.
+* \param	rCtrl			The registration control data
+* 					structure.
+* \param	ppCtrl			Pre-processing control data
+*					structure.
+* \param	secList			Section list.
+* \param	cancelFlag		Cancel if flag pointed to is non-zero.
+* \param	secFn			application supplied section update
+*					function. This function is responsible
+*					for replacing the section in the list,
+*					it may also display it, etc, ....
+* \param	secData			Application supplied data for section
+* 					update function.
+* \param	workFn			Application supplied work function.
+* \param	workData		Application supplied data for the
+*					work function.
+* \param	maxImg			Maximum number of section images to
+*					hold in memory, if less than two then
+*					two more than twice the number of
+*					threads is used.
+* \param	eMsg			Pointer for error message strings.
+*/
+RecError	RecAutoParallel(RecControl *rCtrl, RecPPControl *ppCtrl,
+				HGUDlpList *secList, int *cancelFlag,
+				RecSecUpdateFunction secFn, void *secData,
+				RecWorkFunction workFn, void *workData,
+				int maxImg, char **eMsg)
+{
+  int		idx,
+		nThr = 1;
+  RecState	rState;
+  RecAutoParQueue queue;
+  RecSection	*sec = NULL;
+  HGUDlpListItem *item = NULL,
+  		*firstItem = NULL,
+		*lastItem = NULL;
+  static char	errMsgInvalidListStr[] =
+	     		"Section list or the registration limits are invalid.",
+	     	errMsgMallocStr[] = "Not enough memory available.";
+  RecError	errFlag = REC_ERR_NONE;
+
+  REC_DBG((REC_DBG_AUTO|REC_DBG_LVL_FN|REC_DBG_LVL_1),
+	  ("RecAutoParallel FE 0x%lx 0x%lx 0x%lx 0x%lx 0x%lx 0x%lx 0x%lx "
+	   "0x%lx %d 0x%lx\n",
+	   (unsigned long )rCtrl, (unsigned long )ppCtrl,
+	   (unsigned long )secList, (unsigned long )cancelFlag,
+	   (unsigned long )secFn, (unsigned long )secData,
+	   (unsigned long )workFn, (unsigned long )workData,
+	   maxImg, (unsigned long )eMsg));
+  (void )memset(&queue, 0, sizeof(RecAutoParQueue));
+  if((rCtrl == NULL) || (ppCtrl == NULL) || (secList == NULL))
+  {
+    errFlag = REC_ERR_FUNC;
+  }
+  /* Find the first pair of sections, checking them as RecAuto() does. */
+  if(errFlag == REC_ERR_NONE)
+  {
+    if(((item = RecSecFindItemIndex(secList, NULL, rCtrl->firstIdx,
+     				    HGU_DLPLIST_DIR_TOTAIL)) == NULL) ||
+       ((sec = (RecSection *)HGUDlpListEntryGet(secList, item)) == NULL))
+    {
+      errFlag = REC_ERR_LIST;
+    }
+    else if(RecSecIsEmpty(sec))
+    {
+      if((sec = RecSecNext(secList, item, &item, 1)) == NULL)
+      {
+        errFlag = REC_ERR_LIST;
+      }
+    }
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+    firstItem = item;
+    if(sec->index != rCtrl->firstIdx)
+    {
+      errFlag = REC_ERR_LIST;
+    }
+  }
+  /* Count the sections to be registered. */
+  if(errFlag == REC_ERR_NONE)
+  {
+    queue.nSec = 1;
+    lastItem = item;
+    while((sec != NULL) && (sec->index < rCtrl->lastIdx))
+    {
+      if((sec = RecSecNext(secList, item, &item, 1)) != NULL)
+      {
+	if(sec->index <= rCtrl->lastIdx)
+	{
+	  ++(queue.nSec);
+	  lastItem = item;
+	}
+      }
+    }
+    if((sec == NULL) || (queue.nSec < 2))
+    {
+      errFlag = REC_ERR_LIST;
+    }
+  }
+  /* Duplicate the sections. */
+  if(errFlag == REC_ERR_NONE)
+  {
+    if(((queue.secs = (RecSection **)
+                      AlcCalloc(queue.nSec, sizeof(RecSection *))) == NULL) ||
+       ((queue.nUse = (int *)AlcMalloc(queue.nSec * sizeof(int))) == NULL) ||
+       ((queue.done = (int *)AlcCalloc(queue.nSec, sizeof(int))) == NULL) ||
+       ((queue.pErr = (RecError *)
+                      AlcMalloc(queue.nSec * sizeof(RecError))) == NULL) ||
+       ((queue.pMsg = (char **)AlcCalloc(queue.nSec, sizeof(char *))) == NULL))
+    {
+      errFlag = REC_ERR_MALLOC;
+    }
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+    idx = 0;
+    item = firstItem;
+    sec = (RecSection *)HGUDlpListEntryGet(secList, item);
+    while((errFlag == REC_ERR_NONE) && (idx < queue.nSec))
+    {
+      /* Each section image is used by the registrations with it's
+       * predecessor and it's successor. */
+      queue.nUse[idx] = (idx > 0) + (idx < queue.nSec - 1);
+      queue.pErr[idx] = REC_ERR_NONE;
+      if((queue.secs[idx] = RecSecDup(sec)) == NULL)
+      {
+        errFlag = REC_ERR_MALLOC;
+      }
+      else if(++idx < queue.nSec)
+      {
+        sec = RecSecNext(secList, item, &item, 1);
+      }
+    }
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+    errFlag = RecFileSecObjRead(queue.secs[0], eMsg);
+  }
+  if((errFlag == REC_ERR_NONE) && secFn)
+  {
+    (*secFn)(queue.secs[0], secData);  /* Replaces section with copy in list */
+  }
+  if(errFlag == REC_ERR_NONE)
+  {
+#ifdef _OPENMP
+    nThr = omp_get_max_threads();
+#endif
+    queue.maxHeld = (maxImg < 2)? 2 * (nThr + 1): maxImg;
+    queue.nHeld = 1;
+    queue.nRead = 1;
+    queue.nextPair = 1;
+    queue.rCtrl = rCtrl;
+    queue.ppCtrl = ppCtrl;
+    queue.cancelFlag = cancelFlag;
+    queue.secFn = secFn;
+    queue.secData = secData;
+    queue.work.fn = workFn;
+    queue.work.data = workData;
+#ifdef _OPENMP
+    omp_init_lock(&(queue.lock));
+#pragma omp parallel num_threads(nThr)
+#endif
+    {
+      RecAutoParRun(&queue);
+    }
+#ifdef _OPENMP
+    omp_destroy_lock(&(queue.lock));
+#endif
+    /* Find the first error in section order. */
+    idx = 1;
+    while((errFlag == REC_ERR_NONE) && (idx < queue.nSec))
+    {
+      if((errFlag = queue.pErr[idx]) != REC_ERR_NONE)
+      {
+	if(*eMsg == NULL)
+	{
+	  *eMsg = queue.pMsg[idx];
+	  queue.pMsg[idx] = NULL;
+	}
+      }
+      ++idx;
+    }
+  }
+  /* Compose the cumulative transforms of the registered sections. */
+  if((errFlag == REC_ERR_NONE) && (*cancelFlag == 0))
+  {
+    errFlag = RecSecCumTransfClear(secList, firstItem);
+    if(errFlag == REC_ERR_NONE)
+    {
+      errFlag = RecSecCumTransfSet(secList, lastItem);
+    }
+  }
+  for(idx = 0; idx < queue.nSec; ++idx)
+  {
+    if(queue.secs && queue.secs[idx])
+    {
+      RecSecFree(queue.secs[idx]);
+    }
+    if(queue.pMsg)
+    {
+      AlcFree(queue.pMsg[idx]);
+    }
+  }
+  AlcFree(queue.secs);
+  AlcFree(queue.nUse);
+  AlcFree(queue.done);
+  AlcFree(queue.pErr);
+  AlcFree(queue.pMsg);
+  if(*cancelFlag && (errFlag == REC_ERR_NONE))
+  {
+    errFlag = REC_ERR_CANCEL;
+  }
+  if((errFlag != REC_ERR_NONE) && (*eMsg == NULL))
+  {
+    switch(errFlag)
+    {
+      case REC_ERR_MALLOC:
+        *eMsg = AlcStrDup(errMsgMallocStr);
+        break;
+      case REC_ERR_LIST:
+        *eMsg = AlcStrDup(errMsgInvalidListStr);
+        break;
+      default:
+        break;
+    }
+  }
+  if(workFn && workData)
+  {
+    rState.approach = 0;
+    rState.iteration = 0;
+    rState.lastMethod = REC_MTHD_NONE;
+    rState.transform = NULL;
+    rState.correl = 0.0;
+    rState.errFlag = errFlag;
+    (*workFn)(&rState, workData);
+  }
+  REC_DBG((REC_DBG_AUTO|REC_DBG_LVL_FN|REC_DBG_LVL_1),
+	  ("RecAutoParallel FX %d\n",
+	   errFlag));
+  return(errFlag);
+}
+
+/*!
+* \ingroup	Reconstruct
+* \brief	Runs the tasks of the RecAutoParallel() queue, reading
+*		section images and registering pairs of sections, until
+*		no more tasks remain or the queue is stopped by an error
+*		or cancellation. This function is called by each thread.
+*		When no task is available, because the next section is
+*		being read or the queue is full and waiting for pairs
+*		being registered by other threads, the thread sleeps
+*		briefly before trying again.
+* \param	queue			Shared section image queue.
+*/
+static void	RecAutoParRun(RecAutoParQueue *queue)
+{
+  int		idx = 0,
+		fin = 0;
+  RecAutoParTask task;
+  RecError	errFlag;
+  struct timespec wait;
+
+  wait.tv_sec = 0;
+  wait.tv_nsec = 1000000;
+  while(fin == 0)
+  {
+    task = REC_AUTOPAR_TASK_NONE;
+#ifdef _OPENMP
+    omp_set_lock(&(queue->lock));
+#endif
+    if(*(queue->cancelFlag))
+    {
+      queue->stop = 1;
+    }
+    if(queue->stop == 0)
+    {
+      if(queue->nextPair < queue->nRead)
+      {
+	task = REC_AUTOPAR_TASK_REGISTER;
+	idx = queue->nextPair++;
+      }
+      else if((queue->reading == 0) && (queue->nRead < queue->nSec) &&
+	      (queue->nHeld < queue->maxHeld))
+      {
+	task = REC_AUTOPAR_TASK_READ;
+	idx = queue->nRead;
+	queue->reading = 1;
+	++(queue->nHeld);
+      }
+    }
+    fin = (task == REC_AUTOPAR_TASK_NONE) &&
+          (queue->stop || (queue->nextPair >= queue->nSec));
+#ifdef _OPENMP
+    omp_unset_lock(&(queue->lock));
+#endif
+    switch(task)
+    {
+      case REC_AUTOPAR_TASK_READ:
+	errFlag = RecFileSecObjRead(queue->secs[idx], &(queue->pMsg[idx]));
+#ifdef _OPENMP
+	omp_set_lock(&(queue->lock));
+#endif
+	queue->reading = 0;
+	if(errFlag == REC_ERR_NONE)
+	{
+	  ++(queue->nRead);
+	}
+	else
+	{
+	  RecFileSecObjFree(queue->secs[idx]);
+	  --(queue->nHeld);
+	  queue->pErr[idx] = errFlag;
+	  queue->stop = 1;
+	}
+#ifdef _OPENMP
+	omp_unset_lock(&(queue->lock));
+#endif
+	break;
+      case REC_AUTOPAR_TASK_REGISTER:
+	errFlag = RecRegisterPair(&(queue->secs[idx]->transform),
+				  &(queue->secs[idx]->correl),
+				  &(queue->secs[idx]->iterations),
+				  queue->rCtrl, queue->ppCtrl,
+				  queue->secs[idx - 1]->obj,
+				  queue->secs[idx]->obj,
+				  (queue->work.fn)? RecAutoParWorkFn: NULL,
+				  &(queue->work), &(queue->pMsg[idx]));
+#ifdef _OPENMP
+	omp_set_lock(&(queue->lock));
+#endif
+	queue->pErr[idx] = errFlag;
+	queue->done[idx] = 1;
+	if(errFlag != REC_ERR_NONE)
+	{
+	  queue->stop = 1;
+	}
+	--(queue->nUse[idx - 1]);
+	--(queue->nUse[idx]);
+	RecAutoParUpdate(queue);
+#ifdef _OPENMP
+	omp_unset_lock(&(queue->lock));
+#endif
+	break;
+      default:
+	if(fin == 0)
+	{
+	  (void )nanosleep(&wait, NULL);
+	}
+	break;
+    }
+  }
+}
+
+/*!
+* \ingroup	Reconstruct
+* \brief	Passes the registered sections of the RecAutoParallel()
+*		queue to the section update function in section order,
+*		stopping at the first section which has not been
+*		registered or which failed, then frees the images of the
+*		updated sections which are no longer used. Must be called
+*		with the queue locked.
+* \param	queue			Shared section image queue.
+*/
+static void	RecAutoParUpdate(RecAutoParQueue *queue)
+{
+  int		idx;
+
+  while((queue->lastUpdated + 1 < queue->nSec) &&
+        queue->done[queue->lastUpdated + 1] &&
+	(queue->pErr[queue->lastUpdated + 1] == REC_ERR_NONE))
+  {
+    ++(queue->lastUpdated);
+    if(queue->secFn)
+    {
+      (*(queue->secFn))(queue->secs[queue->lastUpdated], queue->secData);
+    }
+  }
+  for(idx = queue->firstHeld; idx <= queue->lastUpdated; ++idx)
+  {
+    if((queue->nUse[idx] == 0) && queue->secs[idx]->obj)
+    {
+      RecFileSecObjFree(queue->secs[idx]);
+      --(queue->nHeld);
+    }
+  }
+  while((queue->firstHeld < queue->lastUpdated) &&
+        (queue->nUse[queue->firstHeld] == 0))
+  {
+    ++(queue->firstHeld);
+  }
+}
+
+/*!
+* \ingroup	Reconstruct
+* \brief	Work function used by RecAutoParallel() which calls
+*		the application supplied work function within a
+*		critical section.
+* \param	state			Registration state.
+* \param	data			Application work function and it's
+*					data.
+*/
+static void	RecAutoParWorkFn(RecState *state, void *data)
+{
+  RecAutoParWork *work;
+
+  work = (RecAutoParWork *)data;
+#ifdef _OPENMP
+#pragma omp critical (RecAutoParWorkFn)
+#endif
+  {
+    (*(work->fn))(state, work->data);
+  }
+}
@@ -59,6 +59,17 @@ extern RecError			RecAuto(
 				  RecWorkFunction workFn,
 				  void *workData,
 				  char **eMsg);
+extern RecError			RecAutoParallel(
+				  RecControl *rCtrl,
+				  RecPPControl *ppCtrl,
+				  HGUDlpList *secList,
+				  int *cancelFlag,
+				  RecSecUpdateFunction secFn,
+				  void *secData,
+				  RecWorkFunction workFn,
+				  void *workData,
+				  int maxImg,
+				  char **eMsg);
 
 /* From ReconstructConstruct3D.c */
 extern RecError			RecConstruct3DObj(
@@ -44,6 +44,10 @@ static char _Wlz3DSubSection_c[] = "University of Edinburgh $Id$";
 
 #include <Wlz.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 static WlzObject *WlzGetSubSectionFrom3DDomObj(
   WlzObject 		*obj,
   WlzObject		*subDomain,
@@ -51,6 +55,28 @@ static WlzObject *WlzGetSubSectionFrom3DDomObj(
   WlzInterpolationType	interp,
   WlzObject		**maskRtn,
   WlzErrorNum 		*dstErr);
+static WlzErrorNum		WlzGetSubSectionFill(
+				  WlzObject *obj,
+				  WlzObject *secObj,
+				  WlzThreeDViewStruct *viewStr,
+				  WlzInterpolationType interp,
+				  int mask);
+static void			WlzGetSubSectionLnGrey(
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzThreeDViewStruct *viewStr,
+				  WlzInterpolationType interp,
+				  WlzGreyP gP,
+				  size_t off,
+				  int yp,
+				  int xp0,
+				  int xp1);
+static void			WlzGetSubSectionLnMask(
+				  WlzObject *obj,
+				  WlzThreeDViewStruct *viewStr,
+				  WlzUByte *mP,
+				  int yp,
+				  int xp0,
+				  int xp1);
 
 
 WlzObject 	*WlzGetSubSectionFromObject(
@@ -110,13 +136,6 @@ static WlzObject *WlzGetSubSectionFrom3DDomObj(
   WlzDomain		domain;
   WlzValues		values;
   WlzPixelV		pixval;
-  WlzGreyValueWSpace	*gVWSp = NULL;
-  WlzIntervalWSpace	iwsp;
-  WlzGreyWSpace		gwsp;
-  WlzDVertex3		vtx;
-  int			k, xp, yp;
-  WlzDVertex3		tDV0, tDV1;
-  double		tD0;
   int			maskFlg, greyFlg;
   WlzErrorNum		errNum=WLZ_ERR_NONE;
 
@@ -257,241 +276,12 @@ static WlzObject *WlzGetSubSectionFrom3DDomObj(
 
   /* scan object setting values */
   if((errNum == WLZ_ERR_NONE) && greyFlg ){
-    if((gVWSp = WlzGreyValueMakeWSp(obj, &errNum))){
-      errNum = WlzInitGreyScan(newObj, &iwsp, &gwsp);
-      while((errNum == WLZ_ERR_NONE) && 
-	    ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE)){
-	yp = iwsp.linpos - WLZ_NINT(viewStr->minvals.vtY);
-	switch(interp)
-	{
-	  case WLZ_INTERPOLATION_NEAREST:
-	    switch(gVWSp->gType){
-	      case WLZ_GREY_INT:
-	        for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++){
-		  xp = k - WLZ_NINT(viewStr->minvals.vtX);
-		  WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
-		  WlzGreyValueGet(gVWSp, WLZ_NINT(vtx.vtZ), WLZ_NINT(vtx.vtY),
-				  WLZ_NINT(vtx.vtX));
-	          *(gwsp.u_grintptr.inp)++ = gVWSp->gVal[0].inv;
-		}
-		break;
-	      case WLZ_GREY_SHORT:
-	        for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++){
-		  xp = k - WLZ_NINT(viewStr->minvals.vtX);
-		  WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
-		  WlzGreyValueGet(gVWSp, WLZ_NINT(vtx.vtZ), WLZ_NINT(vtx.vtY),
-				  WLZ_NINT(vtx.vtX));
-	          *(gwsp.u_grintptr.shp)++ = gVWSp->gVal[0].shv;
-		}
-		break;
-	      case WLZ_GREY_UBYTE:
-	        for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++){
-		  xp = k - WLZ_NINT(viewStr->minvals.vtX);
-		  WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
-		  WlzGreyValueGet(gVWSp, WLZ_NINT(vtx.vtZ), WLZ_NINT(vtx.vtY),
-				  WLZ_NINT(vtx.vtX));
-	          *(gwsp.u_grintptr.ubp)++ = gVWSp->gVal[0].ubv;
-		}
-		break;
-	      case WLZ_GREY_FLOAT:
-	        for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++){
-		  xp = k - WLZ_NINT(viewStr->minvals.vtX);
-		  WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
-		  WlzGreyValueGet(gVWSp, WLZ_NINT(vtx.vtZ), WLZ_NINT(vtx.vtY),
-				  WLZ_NINT(vtx.vtX));
-	          *(gwsp.u_grintptr.flp)++ = gVWSp->gVal[0].flv;
-		}
-		break;
-	      case WLZ_GREY_DOUBLE:
-	        for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++){
-		  xp = k - WLZ_NINT(viewStr->minvals.vtX);
-		  WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
-		  WlzGreyValueGet(gVWSp, WLZ_NINT(vtx.vtZ), WLZ_NINT(vtx.vtY),
-				  WLZ_NINT(vtx.vtX));
-	          *(gwsp.u_grintptr.dbp)++ = gVWSp->gVal[0].dbv;
-		}
-		break;
-	      case WLZ_GREY_RGBA:
-	        for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++){
-		  xp = k - WLZ_NINT(viewStr->minvals.vtX);
-		  WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
-		  WlzGreyValueGet(gVWSp, WLZ_NINT(vtx.vtZ), WLZ_NINT(vtx.vtY),
-				  WLZ_NINT(vtx.vtX));
-	          *(gwsp.u_grintptr.rgbp)++ = gVWSp->gVal[0].rgbv;
-		}
-		break;
-	      default:
-		break;
-	    }
-	    break;
-	  case WLZ_INTERPOLATION_LINEAR:
-	    switch(gVWSp->gType){
-	      case WLZ_GREY_INT:
-		for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++){
-		  xp = k - WLZ_NINT(viewStr->minvals.vtX);
-		  WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
-		  WlzGreyValueGetCon(gVWSp, floor(vtx.vtZ), floor(vtx.vtY),
-		                     floor(vtx.vtX));
-		  tDV0.vtX = vtx.vtX - floor(vtx.vtX);
-		  tDV0.vtY = vtx.vtY - floor(vtx.vtY);
-		  tDV0.vtZ = vtx.vtZ - floor(vtx.vtZ);
-		  tDV1.vtX = 1.0 - tDV0.vtX;
-		  tDV1.vtY = 1.0 - tDV0.vtY;
-		  tDV1.vtZ = 1.0 - tDV0.vtZ;
-		  tD0 =
-		    ((gVWSp->gVal[0]).inv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[1]).inv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[2]).inv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[3]).inv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[4]).inv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		    ((gVWSp->gVal[5]).inv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		    ((gVWSp->gVal[6]).inv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		    ((gVWSp->gVal[7]).inv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		  tD0 = WLZ_CLAMP(tD0, INT_MIN, INT_MAX);
-		  *(gwsp.u_grintptr.inp)++ = WLZ_NINT(tD0);
-		}
-		break;
-	      case WLZ_GREY_SHORT:
-		for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++){
-		  xp = k - WLZ_NINT(viewStr->minvals.vtX);
-		  WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
-		  WlzGreyValueGetCon(gVWSp, floor(vtx.vtZ), floor(vtx.vtY),
-		                     floor(vtx.vtX));
-		  tDV0.vtX = vtx.vtX - floor(vtx.vtX);
-		  tDV0.vtY = vtx.vtY - floor(vtx.vtY);
-		  tDV0.vtZ = vtx.vtZ - floor(vtx.vtZ);
-		  tDV1.vtX = 1.0 - tDV0.vtX;
-		  tDV1.vtY = 1.0 - tDV0.vtY;
-		  tDV1.vtZ = 1.0 - tDV0.vtZ;
-		  tD0 =
-		    ((gVWSp->gVal[0]).shv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[1]).shv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[2]).shv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[3]).shv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[4]).shv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		    ((gVWSp->gVal[5]).shv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		    ((gVWSp->gVal[6]).shv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		    ((gVWSp->gVal[7]).shv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		  tD0 = WLZ_CLAMP(tD0, SHRT_MIN, SHRT_MAX);
-		  *(gwsp.u_grintptr.shp)++ = WLZ_NINT(tD0);
-		}
-		break;
-	      case WLZ_GREY_UBYTE:
-		for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++){
-		  xp = k - WLZ_NINT(viewStr->minvals.vtX);
-		  WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
-		  WlzGreyValueGetCon(gVWSp, floor(vtx.vtZ), floor(vtx.vtY),
-		                     floor(vtx.vtX));
-		  tDV0.vtX = vtx.vtX - floor(vtx.vtX);
-		  tDV0.vtY = vtx.vtY - floor(vtx.vtY);
-		  tDV0.vtZ = vtx.vtZ - floor(vtx.vtZ);
-		  tDV1.vtX = 1.0 - tDV0.vtX;
-		  tDV1.vtY = 1.0 - tDV0.vtY;
-		  tDV1.vtZ = 1.0 - tDV0.vtZ;
-		  tD0 =
-		    ((gVWSp->gVal[0]).ubv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[1]).ubv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[2]).ubv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[3]).ubv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[4]).ubv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		    ((gVWSp->gVal[5]).ubv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		    ((gVWSp->gVal[6]).ubv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		    ((gVWSp->gVal[7]).ubv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		  tD0 = WLZ_CLAMP(tD0, 0, 255);
-		  *(gwsp.u_grintptr.ubp)++ = WLZ_NINT(tD0);
-		}
-		break;
-	      case WLZ_GREY_FLOAT:
-		for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++){
-		  xp = k - WLZ_NINT(viewStr->minvals.vtX);
-		  WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
-		  WlzGreyValueGetCon(gVWSp, floor(vtx.vtZ), floor(vtx.vtY),
-		                     floor(vtx.vtX));
-		  tDV0.vtX = vtx.vtX - floor(vtx.vtX);
-		  tDV0.vtY = vtx.vtY - floor(vtx.vtY);
-		  tDV0.vtZ = vtx.vtZ - floor(vtx.vtZ);
-		  tDV1.vtX = 1.0 - tDV0.vtX;
-		  tDV1.vtY = 1.0 - tDV0.vtY;
-		  tDV1.vtZ = 1.0 - tDV0.vtZ;
-		  tD0 =
-		    ((gVWSp->gVal[0]).flv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[1]).flv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[2]).flv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[3]).flv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[4]).flv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		    ((gVWSp->gVal[5]).flv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		    ((gVWSp->gVal[6]).flv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		    ((gVWSp->gVal[7]).flv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		  *(gwsp.u_grintptr.flp)++ = WLZ_CLAMP(tD0, FLT_MIN, FLT_MAX);
-		}
-		break;
-	      case WLZ_GREY_DOUBLE:
-		for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++){
-		  xp = k - WLZ_NINT(viewStr->minvals.vtX);
-		  WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
-		  WlzGreyValueGetCon(gVWSp, floor(vtx.vtZ), floor(vtx.vtY),
-		                     floor(vtx.vtX));
-		  tDV0.vtX = vtx.vtX - floor(vtx.vtX);
-		  tDV0.vtY = vtx.vtY - floor(vtx.vtY);
-		  tDV0.vtZ = vtx.vtZ - floor(vtx.vtZ);
-		  tDV1.vtX = 1.0 - tDV0.vtX;
-		  tDV1.vtY = 1.0 - tDV0.vtY;
-		  tDV1.vtZ = 1.0 - tDV0.vtZ;
-		  tD0 =
-		    ((gVWSp->gVal[0]).dbv * tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[1]).dbv * tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[2]).dbv * tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[3]).dbv * tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-		    ((gVWSp->gVal[4]).dbv * tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-		    ((gVWSp->gVal[5]).dbv * tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-		    ((gVWSp->gVal[6]).dbv * tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-		    ((gVWSp->gVal[7]).dbv * tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		  *(gwsp.u_grintptr.dbp)++ = WLZ_NINT(tD0);
-		}
-		break;
-	      default:
-	        errNum = WLZ_ERR_GREY_TYPE;
-		break;
-	    }
-	  default:
-	    errNum = WLZ_ERR_UNIMPLEMENTED;
-	    break;
-	}
-      }
-      if(errNum == WLZ_ERR_EOO)	   /* Reset error from end of intervals */ 
-      {
-	errNum = WLZ_ERR_NONE;
-      }
-      WlzGreyValueFreeWSp(gVWSp);
-    }
+    errNum = WlzGetSubSectionFill(obj, newObj, viewStr, interp, 0);
   }
 
   /* check if mask required */
   if((errNum == WLZ_ERR_NONE) && maskFlg ){
-    errNum = WlzInitGreyScan(mask, &iwsp, &gwsp);
-    while((errNum == WLZ_ERR_NONE) && 
-	  ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE) ){
-	yp = iwsp.linpos - WLZ_NINT(viewStr->minvals.vtY);
-	for(k=iwsp.lftpos; k <= iwsp.rgtpos; k++){
-	  xp = k - WLZ_NINT(viewStr->minvals.vtX);
-	  vtx.vtX = (float )(viewStr->xp_to_x[xp] + viewStr->yp_to_x[yp]);
-	  vtx.vtY = (float )(viewStr->xp_to_y[xp] + viewStr->yp_to_y[yp]);
-	  vtx.vtZ = (float )(viewStr->xp_to_z[xp] + viewStr->yp_to_z[yp]);
-
-	  if( WlzInsideDomain(obj, WLZ_NINT(vtx.vtZ), WLZ_NINT(vtx.vtY),
-			      WLZ_NINT(vtx.vtX), NULL) ){
-	    *(gwsp.u_grintptr.ubp) = 128;
-	  }
-	  else {
-	    *(gwsp.u_grintptr.ubp) = 0;
-	  }
-	  gwsp.u_grintptr.ubp++;
-	}
-    }
-    if(errNum == WLZ_ERR_EOO)	   /* Reset EOO error from end of intervals */ 
-    {
-      errNum = WLZ_ERR_NONE;
-    }
+    errNum = WlzGetSubSectionFill(obj, mask, viewStr, interp, 1);
 
     /* threshold to determine the mask */
     if( errNum == WLZ_ERR_NONE ){
@@ -529,3 +319,397 @@ static WlzObject *WlzGetSubSectionFrom3DDomObj(
   }
   return newObj;
 }
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzSectionTransform
+* \brief	Fills the rectangular values of the given section object
+* 		with either grey values interpolated from the given 3D
+* 		object or with a mask value which is set for points
+* 		inside the domain of the 3D object. The lines of the
+* 		section are filled in parallel, each thread having
+* 		it's own grey value workspace. The tiles of memory
+* 		mapped tiled values are prefetched before the scan.
+* \param	obj			Given 3D domain object.
+* \param	secObj			Section object with a rectangular
+* 					value table to be filled.
+* \param	viewStr			Initialised view structure with valid
+* 					look up tables.
+* \param	interp			Interpolation type, either nearest
+* 					neighbour or linear.
+* \param	mask			If non-zero the section values are
+* 					set to 128 for points inside the
+* 					domain of the given object and 0
+* 					otherwise, rather than grey values.
+*/
+static WlzErrorNum WlzGetSubSectionFill(WlzObject *obj,
+				WlzObject *secObj,
+				WlzThreeDViewStruct *viewStr,
+				WlzInterpolationType interp,
+				int mask)
+{
+  int		idT,
+  		nLn,
+		xOff,
+		yOff,
+		nThr = 1;
+  WlzIntervalDomain *iDom;
+  WlzRectValues	*rVal;
+  WlzGreyValueWSpace **gVWSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  iDom = secObj->domain.i;
+  rVal = secObj->values.r;
+  if((iDom->type != WLZ_INTERVALDOMAIN_RECT) &&
+     (iDom->type != WLZ_INTERVALDOMAIN_INTVL))
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if(WlzGreyTableTypeToTableType(rVal->type, NULL) != WLZ_GREY_TAB_RECT)
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+#ifdef _OPENMP
+  nThr = omp_get_max_threads();
+#endif
+  if((errNum == WLZ_ERR_NONE) && !mask)
+  {
+    if((gVWSp = (WlzGreyValueWSpace **)
+                AlcCalloc(nThr, sizeof(WlzGreyValueWSpace *))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < nThr); ++idT)
+    {
+      gVWSp[idT] = WlzGreyValueMakeWSp(obj, &errNum);
+    }
+    if((errNum == WLZ_ERR_NONE) &&
+       (interp == WLZ_INTERPOLATION_LINEAR) &&
+       (gVWSp[0]->gType == WLZ_GREY_RGBA))
+    {
+      errNum = WLZ_ERR_GREY_TYPE;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && !mask &&
+     WlzGreyTableIsTiled(obj->values.core->type) &&
+     (obj->values.t->fd >= 0))
+  {
+    /* Advise that the tiles cut by the section will be needed so that
+     * they are read ahead of the scan, or read them into the values'
+     * tile cache if they have one. */
+    (void )WlzTiledValuesPrefetch(obj->values.t, viewStr,
+                                  obj->values.t->cache);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idL;
+
+    nLn = iDom->lastln - iDom->line1 + 1;
+    xOff = WLZ_NINT(viewStr->minvals.vtX);
+    yOff = WLZ_NINT(viewStr->minvals.vtY);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(dynamic, 16)
+#endif
+    for(idL = 0; idL < nLn; ++idL)
+    {
+      int	idI,
+      		ln,
+		nItv = 1,
+      		thrId = 0;
+      WlzInterval rItv,
+      		*itv;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      ln = iDom->line1 + idL;
+      if(iDom->type == WLZ_INTERVALDOMAIN_INTVL)
+      {
+        nItv = iDom->intvlines[idL].nintvs;
+	itv = iDom->intvlines[idL].intvs;
+      }
+      else
+      {
+        rItv.ileft = 0;
+	rItv.iright = iDom->lastkl - iDom->kol1;
+	itv = &rItv;
+      }
+      for(idI = 0; idI < nItv; ++idI)
+      {
+        int	kl0,
+		kl1;
+	size_t	off;
+
+	kl0 = iDom->kol1 + itv[idI].ileft;
+	kl1 = iDom->kol1 + itv[idI].iright;
+	off = ((size_t )(ln - rVal->line1) * rVal->width) + kl0 - rVal->kol1;
+	if(mask)
+	{
+	  WlzGetSubSectionLnMask(obj, viewStr, rVal->values.ubp + off,
+	                         ln - yOff, kl0 - xOff, kl1 - xOff);
+	}
+	else
+	{
+	  WlzGetSubSectionLnGrey(gVWSp[thrId], viewStr, interp,
+	  			 rVal->values, off,
+				 ln - yOff, kl0 - xOff, kl1 - xOff);
+	}
+      }
+    }
+  }
+  if(gVWSp)
+  {
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      WlzGreyValueFreeWSp(gVWSp[idT]);
+    }
+    AlcFree(gVWSp);
+  }
+  return(errNum);
+}
+
+#define WLZ_GETSUBSEC_LIN(G,F,W0,W1) \
+		(((G)[0]).F * (W1).vtX * (W1).vtY * (W1).vtZ) + \
+		(((G)[1]).F * (W0).vtX * (W1).vtY * (W1).vtZ) + \
+		(((G)[2]).F * (W1).vtX * (W0).vtY * (W1).vtZ) + \
+		(((G)[3]).F * (W0).vtX * (W0).vtY * (W1).vtZ) + \
+		(((G)[4]).F * (W1).vtX * (W1).vtY * (W0).vtZ) + \
+		(((G)[5]).F * (W0).vtX * (W1).vtY * (W0).vtZ) + \
+		(((G)[6]).F * (W1).vtX * (W0).vtY * (W0).vtZ) + \
+		(((G)[7]).F * (W0).vtX * (W0).vtY * (W0).vtZ)
+
+/*!
+* \ingroup	WlzSectionTransform
+* \brief	Sets the grey values of an interval of a section line,
+* 		with a separate loop for each interpolation and grey type.
+* \param	gVWSp			Grey value workspace for the 3D
+* 					object, which must not be shared
+* 					with any other thread.
+* \param	viewStr			View structure with valid look up
+* 					tables.
+* \param	interp			Interpolation type, either nearest
+* 					neighbour or linear.
+* \param	gP			Section values which are of the same
+* 					grey type as the 3D object.
+* \param	off			Offset into the section values of
+* 					the first value of the interval.
+* \param	yp			Line index into the view structure
+* 					look up tables.
+* \param	xp0			First column index into the view
+* 					structure look up tables.
+* \param	xp1			Last column index into the view
+* 					structure look up tables.
+*/
+static void	WlzGetSubSectionLnGrey(WlzGreyValueWSpace *gVWSp,
+				WlzThreeDViewStruct *viewStr,
+				WlzInterpolationType interp,
+				WlzGreyP gP, size_t off,
+				int yp, int xp0, int xp1)
+{
+  int		xp;
+  double	tD0;
+  WlzDVertex3	vtx,
+  		tDV0,
+		tDV1;
+
+  switch(interp)
+  {
+    case WLZ_INTERPOLATION_NEAREST:
+      switch(gVWSp->gType)
+      {
+	case WLZ_GREY_INT:
+	  gP.inp += off;
+	  for(xp = xp0; xp <= xp1; ++xp)
+	  {
+	    WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
+	    WlzGreyValueGet(gVWSp, WLZ_NINT(vtx.vtZ), WLZ_NINT(vtx.vtY),
+			    WLZ_NINT(vtx.vtX));
+	    *(gP.inp)++ = gVWSp->gVal[0].inv;
+	  }
+	  break;
+	case WLZ_GREY_SHORT:
+	  gP.shp += off;
+	  for(xp = xp0; xp <= xp1; ++xp)
+	  {
+	    WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
+	    WlzGreyValueGet(gVWSp, WLZ_NINT(vtx.vtZ), WLZ_NINT(vtx.vtY),
+			    WLZ_NINT(vtx.vtX));
+	    *(gP.shp)++ = gVWSp->gVal[0].shv;
+	  }
+	  break;
+	case WLZ_GREY_UBYTE:
+	  gP.ubp += off;
+	  for(xp = xp0; xp <= xp1; ++xp)
+	  {
+	    WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
+	    WlzGreyValueGet(gVWSp, WLZ_NINT(vtx.vtZ), WLZ_NINT(vtx.vtY),
+			    WLZ_NINT(vtx.vtX));
+	    *(gP.ubp)++ = gVWSp->gVal[0].ubv;
+	  }
+	  break;
+	case WLZ_GREY_FLOAT:
+	  gP.flp += off;
+	  for(xp = xp0; xp <= xp1; ++xp)
+	  {
+	    WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
+	    WlzGreyValueGet(gVWSp, WLZ_NINT(vtx.vtZ), WLZ_NINT(vtx.vtY),
+			    WLZ_NINT(vtx.vtX));
+	    *(gP.flp)++ = gVWSp->gVal[0].flv;
+	  }
+	  break;
+	case WLZ_GREY_DOUBLE:
+	  gP.dbp += off;
+	  for(xp = xp0; xp <= xp1; ++xp)
+	  {
+	    WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
+	    WlzGreyValueGet(gVWSp, WLZ_NINT(vtx.vtZ), WLZ_NINT(vtx.vtY),
+			    WLZ_NINT(vtx.vtX));
+	    *(gP.dbp)++ = gVWSp->gVal[0].dbv;
+	  }
+	  break;
+	case WLZ_GREY_RGBA:
+	  gP.rgbp += off;
+	  for(xp = xp0; xp <= xp1; ++xp)
+	  {
+	    WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
+	    WlzGreyValueGet(gVWSp, WLZ_NINT(vtx.vtZ), WLZ_NINT(vtx.vtY),
+			    WLZ_NINT(vtx.vtX));
+	    *(gP.rgbp)++ = gVWSp->gVal[0].rgbv;
+	  }
+	  break;
+	default:
+	  break;
+      }
+      break;
+    case WLZ_INTERPOLATION_LINEAR:
+      switch(gVWSp->gType)
+      {
+	case WLZ_GREY_INT:
+	  gP.inp += off;
+	  for(xp = xp0; xp <= xp1; ++xp)
+	  {
+	    WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
+	    WlzGreyValueGetCon(gVWSp, floor(vtx.vtZ), floor(vtx.vtY),
+			       floor(vtx.vtX));
+	    tDV0.vtX = vtx.vtX - floor(vtx.vtX);
+	    tDV0.vtY = vtx.vtY - floor(vtx.vtY);
+	    tDV0.vtZ = vtx.vtZ - floor(vtx.vtZ);
+	    tDV1.vtX = 1.0 - tDV0.vtX;
+	    tDV1.vtY = 1.0 - tDV0.vtY;
+	    tDV1.vtZ = 1.0 - tDV0.vtZ;
+	    tD0 = WLZ_GETSUBSEC_LIN(gVWSp->gVal, inv, tDV0, tDV1);
+	    tD0 = WLZ_CLAMP(tD0, INT_MIN, INT_MAX);
+	    *(gP.inp)++ = WLZ_NINT(tD0);
+	  }
+	  break;
+	case WLZ_GREY_SHORT:
+	  gP.shp += off;
+	  for(xp = xp0; xp <= xp1; ++xp)
+	  {
+	    WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
+	    WlzGreyValueGetCon(gVWSp, floor(vtx.vtZ), floor(vtx.vtY),
+			       floor(vtx.vtX));
+	    tDV0.vtX = vtx.vtX - floor(vtx.vtX);
+	    tDV0.vtY = vtx.vtY - floor(vtx.vtY);
+	    tDV0.vtZ = vtx.vtZ - floor(vtx.vtZ);
+	    tDV1.vtX = 1.0 - tDV0.vtX;
+	    tDV1.vtY = 1.0 - tDV0.vtY;
+	    tDV1.vtZ = 1.0 - tDV0.vtZ;
+	    tD0 = WLZ_GETSUBSEC_LIN(gVWSp->gVal, shv, tDV0, tDV1);
+	    tD0 = WLZ_CLAMP(tD0, SHRT_MIN, SHRT_MAX);
+	    *(gP.shp)++ = (short )WLZ_NINT(tD0);
+	  }
+	  break;
+	case WLZ_GREY_UBYTE:
+	  gP.ubp += off;
+	  for(xp = xp0; xp <= xp1; ++xp)
+	  {
+	    WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
+	    WlzGreyValueGetCon(gVWSp, floor(vtx.vtZ), floor(vtx.vtY),
+			       floor(vtx.vtX));
+	    tDV0.vtX = vtx.vtX - floor(vtx.vtX);
+	    tDV0.vtY = vtx.vtY - floor(vtx.vtY);
+	    tDV0.vtZ = vtx.vtZ - floor(vtx.vtZ);
+	    tDV1.vtX = 1.0 - tDV0.vtX;
+	    tDV1.vtY = 1.0 - tDV0.vtY;
+	    tDV1.vtZ = 1.0 - tDV0.vtZ;
+	    tD0 = WLZ_GETSUBSEC_LIN(gVWSp->gVal, ubv, tDV0, tDV1);
+	    tD0 = WLZ_CLAMP(tD0, 0, 255);
+	    *(gP.ubp)++ = (WlzUByte )WLZ_NINT(tD0);
+	  }
+	  break;
+	case WLZ_GREY_FLOAT:
+	  gP.flp += off;
+	  for(xp = xp0; xp <= xp1; ++xp)
+	  {
+	    WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
+	    WlzGreyValueGetCon(gVWSp, floor(vtx.vtZ), floor(vtx.vtY),
+			       floor(vtx.vtX));
+	    tDV0.vtX = vtx.vtX - floor(vtx.vtX);
+	    tDV0.vtY = vtx.vtY - floor(vtx.vtY);
+	    tDV0.vtZ = vtx.vtZ - floor(vtx.vtZ);
+	    tDV1.vtX = 1.0 - tDV0.vtX;
+	    tDV1.vtY = 1.0 - tDV0.vtY;
+	    tDV1.vtZ = 1.0 - tDV0.vtZ;
+	    tD0 = WLZ_GETSUBSEC_LIN(gVWSp->gVal, flv, tDV0, tDV1);
+	    *(gP.flp)++ = (float )WLZ_CLAMP(tD0, -(FLT_MAX), FLT_MAX);
+	  }
+	  break;
+	case WLZ_GREY_DOUBLE:
+	  gP.dbp += off;
+	  for(xp = xp0; xp <= xp1; ++xp)
+	  {
+	    WLZ_GETSUBSEC_POS(vtx,viewStr,xp,yp);
+	    WlzGreyValueGetCon(gVWSp, floor(vtx.vtZ), floor(vtx.vtY),
+			       floor(vtx.vtX));
+	    tDV0.vtX = vtx.vtX - floor(vtx.vtX);
+	    tDV0.vtY = vtx.vtY - floor(vtx.vtY);
+	    tDV0.vtZ = vtx.vtZ - floor(vtx.vtZ);
+	    tDV1.vtX = 1.0 - tDV0.vtX;
+	    tDV1.vtY = 1.0 - tDV0.vtY;
+	    tDV1.vtZ = 1.0 - tDV0.vtZ;
+	    *(gP.dbp)++ = WLZ_GETSUBSEC_LIN(gVWSp->gVal, dbv, tDV0, tDV1);
+	  }
+	  break;
+	default:
+	  break;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+/*!
+* \ingroup	WlzSectionTransform
+* \brief	Sets the mask values of an interval of a section line
+* 		to 128 for points inside the domain of the given 3D
+* 		object and to 0 otherwise.
+* \param	obj			Given 3D domain object.
+* \param	viewStr			View structure with valid look up
+* 					tables.
+* \param	mP			Mask values for the first point of
+* 					the interval.
+* \param	yp			Line index into the view structure
+* 					look up tables.
+* \param	xp0			First column index into the view
+* 					structure look up tables.
+* \param	xp1			Last column index into the view
+* 					structure look up tables.
+*/
+static void	WlzGetSubSectionLnMask(WlzObject *obj,
+				WlzThreeDViewStruct *viewStr,
+				WlzUByte *mP, int yp, int xp0, int xp1)
+{
+  int		xp;
+  WlzFVertex3	vtx;
+
+  for(xp = xp0; xp <= xp1; ++xp)
+  {
+    vtx.vtX = (float )(viewStr->xp_to_x[xp] + viewStr->yp_to_x[yp]);
+    vtx.vtY = (float )(viewStr->xp_to_y[xp] + viewStr->yp_to_y[yp]);
+    vtx.vtZ = (float )(viewStr->xp_to_z[xp] + viewStr->yp_to_z[yp]);
+    *mP++ = (WlzInsideDomain(obj, WLZ_NINT(vtx.vtZ), WLZ_NINT(vtx.vtY),
+			     WLZ_NINT(vtx.vtX), NULL))? 128: 0;
+  }
+}
@@ -51,6 +51,55 @@ static char _WlzAffineTransform_c[] = "University of Edinburgh $Id$";
 
 #include <Wlz.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \struct	_WlzAffineTransformPln3
+* \ingroup	WlzTransform
+* \brief	Direct access to the values of a single plane of a 3D
+* 		object which has a rectangular domain and rectangular
+* 		or tiled values on the plane.
+* 		Typedef: ::WlzAffineTransformPln3.
+*/
+typedef struct _WlzAffineTransformPln3
+{
+  WlzGreyP	values;			/*!< Rectangular values of the plane
+  					     or the tiles of tiled values,
+					     NULL if the plane can not be
+					     directly accessed. */
+  int		line1;			/*!< First line of the domain. */
+  int		lastln;			/*!< Last line of the domain. */
+  int		kol1;			/*!< First column of the domain. */
+  int		lastkl;			/*!< Last column of the domain. */
+  int		vLine1;			/*!< First line of the rectangular
+  					     values. */
+  int		vKol1;			/*!< First column of the rectangular
+  					     values. */
+  int		width;			/*!< Width of the rectangular
+  					     values. */
+} WlzAffineTransformPln3;
+
+/*!
+* \struct	_WlzAffineTransformSrc3
+* \ingroup	WlzTransform
+* \brief	Direct access to the values of a 3D object which is
+* 		being transformed.
+* 		Typedef: ::WlzAffineTransformSrc3.
+*/
+typedef struct _WlzAffineTransformSrc3
+{
+  WlzGreyType	gType;			/*!< Grey type of the values. */
+  int		plane1;			/*!< First plane of the domain. */
+  int		lastpl;			/*!< Last plane of the domain. */
+  WlzTiledValues *tVal;			/*!< Tiled values, NULL if the
+  					     values are not tiled. */
+  WlzAffineTransformPln3 *pln;		/*!< Per plane direct access, NULL
+  					     if no plane can be directly
+					     accessed. */
+} WlzAffineTransformSrc3;
+
 static int			WlzAffineTransformIsTranslate2(
 				  WlzAffineTransform *trans,
 				  WlzObject *obj,
@@ -98,6 +147,44 @@ static WlzErrorNum 		WlzAffineTransformValues3(WlzObject *newObj,
 				  WlzInterpolationType interp,
 				  void *cbData,
 				  WlzAffineTransformCbFn cbFn);
+static WlzErrorNum 		WlzAffineTransformValues3Pln(
+				  WlzObject *newObj,
+				  WlzAffineTransformSrc3 *src,
+				  WlzGreyValueWSpace *gVWSp,
+				  WlzAffineTransform *invTrans,
+				  WlzInterpolationType interp,
+				  WlzGreyType gType,
+				  WlzPixelV bkdV,
+				  int pIdx,
+				  int pln,
+				  void *cbData,
+				  WlzAffineTransformCbFn cbFn);
+static WlzErrorNum		WlzAffineTransformSrcInit3(
+				  WlzAffineTransformSrc3 *src,
+				  WlzObject *srcObj,
+				  WlzGreyType gType);
+static int			WlzAffineTransformSrcIn3(
+				  WlzAffineTransformSrc3 *src,
+				  WlzIVertex3 pos,
+				  int n);
+static void			WlzAffineTransformSrcGet3(
+				  WlzAffineTransformSrc3 *src,
+				  WlzIVertex3 pos,
+				  WlzGreyV *gV);
+static void			WlzAffineTransformSrcGetCon3(
+				  WlzAffineTransformSrc3 *src,
+				  WlzIVertex3 pos,
+				  WlzGreyV *gV);
+static WlzErrorNum		WlzAffineTransformSetGrey(
+				  WlzGreyP *dP,
+				  WlzGreyType gType,
+				  WlzGreyV *gV);
+static WlzErrorNum		WlzAffineTransformSetGreyLinear3(
+				  WlzGreyP *dP,
+				  WlzGreyType gType,
+				  WlzGreyV *gV,
+				  WlzDVertex3 tDV0,
+				  WlzDVertex3 tDV1);
 static WlzErrorNum 		WlzAffineTransformPrimSet2(
 				  WlzAffineTransform *tr,
 				  WlzAffineTransformPrim prim);
@@ -1382,7 +1469,14 @@ static WlzErrorNum WlzAffineTransformValues2(WlzObject *newObj,
 * \return				Error number.
 * \brief	Creates new value, fills in the values and adds it
 *		to the given new object.
-*		not checked.
+*		The planes of the new object are filled in parallel,
+*		each with it's own grey value workspace, unless the
+*		interpolation is by a callback function (which need
+*		not be thread safe). Values are read directly from
+*		the source object's rectangular or tiled value tables
+*		whenever all the values required are within a
+*		rectangular plane domain, otherwise the grey value
+*		workspace is used.
 * \param	newObj			Partialy transformed object
 *					with a valid domain.
 * \param	srcObj			3D domain object which is being
@@ -1401,31 +1495,17 @@ static WlzErrorNum WlzAffineTransformValues3(WlzObject *newObj,
 					     void *cbData,
 					     WlzAffineTransformCbFn cbFn)
 {
-  int		tI0,
-  		count;
-  double	tD0, x, y, z;
-  WlzIVertex3	idx,
-  		sPos,
-		dPos;
-  WlzDVertex3	tDV0,
-  		tDV1;
+  int		nThr = 1;
   WlzIBox3	bBox;
   WlzPixelV	bkdV;
-  WlzValues	tVal,
-  		dstValues,
-  		emptyValues;
-  WlzObject 	*tObj0;
-  WlzGreyWSpace	gWSp;
-  WlzIntervalWSpace iWSp;
-  WlzGreyValueWSpace *gVWSp = NULL;
+  WlzValues	dstValues;
   WlzAffineTransform *invTrans = NULL;
   WlzGreyType	gType;
-  WlzDomain	dom2D;
-  double	tMat[3][3];
+  WlzAffineTransformSrc3 src;
   WlzErrorNum	errNum = WLZ_ERR_UNIMPLEMENTED;
 
   dstValues.core = NULL;
-  emptyValues.core = NULL;
+  src.pln = NULL;
   /* Make a new voxel value table. */
   bkdV = WlzGetBackground(srcObj, &errNum);
   if(errNum == WLZ_ERR_NONE)
@@ -1451,340 +1531,750 @@ static WlzErrorNum WlzAffineTransformValues3(WlzObject *newObj,
   {
     invTrans = WlzAffineTransformInverse(trans, &errNum);
   }
-  /* For each plane in the new object make a new value table and
-   * then fill it in. */
+  /* Set up direct access to the source values where possible. */
   if(errNum == WLZ_ERR_NONE)
   {
-    gVWSp = WlzGreyValueMakeWSp(srcObj, &errNum);
+    errNum = WlzAffineTransformSrcInit3(&src, srcObj, gType);
   }
+  /* For each plane in the new object make a new value table and
+   * then fill it in. */
   if(errNum == WLZ_ERR_NONE)
   {
-    idx.vtZ = 0;
-    dPos.vtZ = bBox.zMin;
-    tMat[0][0] = invTrans->mat[0][0];
-    tMat[1][0] = invTrans->mat[1][0];
-    tMat[2][0] = invTrans->mat[2][0];
-    while((errNum == WLZ_ERR_NONE) && (dPos.vtZ <= bBox.zMax))
+    int		idZ,
+    		nPln;
+
+#ifdef _OPENMP
+    if(interp != WLZ_INTERPOLATION_CALLBACK)
+    {
+      nThr = omp_get_max_threads();
+    }
+#endif
+    nPln = bBox.zMax - bBox.zMin + 1;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nThr)
+#endif
     {
-      if(((dom2D = *(newObj->domain.p->domains + idx.vtZ)).core != NULL) &&
-         (dom2D.core->type != WLZ_EMPTY_DOMAIN))
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+      WlzGreyValueWSpace *gVWSp;
+
+      /* Each thread has it's own grey value work space for all of
+       * the planes it fills. */
+      gVWSp = WlzGreyValueMakeWSp(srcObj, &errNum2);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+      for(idZ = 0; idZ < nPln; ++idZ)
       {
-	tMat[0][2] = invTrans->mat[0][3] + (invTrans->mat[0][2] * dPos.vtZ);
-	tMat[1][2] = invTrans->mat[1][3] + (invTrans->mat[1][2] * dPos.vtZ);
-	tMat[2][2] = invTrans->mat[2][3] + (invTrans->mat[2][2] * dPos.vtZ);
-	/* Make a 2D domain object for the plane. */
-	tObj0 = WlzMakeMain(WLZ_2D_DOMAINOBJ,
-	    *(newObj->domain.p->domains + idx.vtZ),
-	    emptyValues, NULL, NULL, &errNum);
-	if(errNum == WLZ_ERR_NONE)
-	{
-	  tVal.v = WlzNewValueTb(tObj0,
-	  		         WlzGreyTableType(WLZ_GREY_TAB_RAGR, gType,
-				 		  NULL),
-				 bkdV, &errNum);
-	}
-	if(errNum == WLZ_ERR_NONE)
+	if((errNum == WLZ_ERR_NONE) && (errNum2 == WLZ_ERR_NONE))
 	{
-	  tObj0->values = WlzAssignValues(tVal, &errNum);
+	  errNum2 = WlzAffineTransformValues3Pln(newObj, &src, gVWSp,
+						 invTrans, interp,
+						 gType, bkdV,
+						 idZ, bBox.zMin + idZ,
+						 cbData, cbFn);
 	}
-	if(errNum == WLZ_ERR_NONE)
+      }
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical
 	{
-	  errNum = WlzInitGreyScan(tObj0, &iWSp, &gWSp);
+#endif
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+#ifdef _OPENMP
 	}
-	if(errNum == WLZ_ERR_NONE)
+#endif
+      }
+      WlzGreyValueFreeWSp(gVWSp);
+    }
+  }
+  AlcFree(src.pln);
+  if(invTrans)
+  {
+    (void )WlzFreeAffineTransform(invTrans);
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzTransform
+* \return				Error number.
+* \brief	Creates a new value table for a single plane of the
+* 		given new 3D object and fills in it's values. This
+* 		is the per plane work function of
+* 		WlzAffineTransformValues3().
+*		Along each interval of the new object the source
+*		coordinates are computed from terms which are
+*		constant for the plane and line with a single
+*		multiply-add per coordinate, giving exactly the same
+*		coordinates as the full matrix product.
+* \param	newObj			Partialy transformed object
+*					with a valid domain and a voxel
+*					value table.
+* \param	src			Direct access to the source
+* 					object's values.
+* \param	gVWSp			Grey value work space for the
+* 					source object, used for values
+* 					which can not be accessed
+* 					directly.
+* \param	invTrans		Inverse of the given affine
+* 					transform.
+* \param	interp			Level of interpolation to
+*					use.
+* \param	gType			Grey type of the source object.
+* \param	bkdV			Background value of the source
+* 					object.
+* \param	pIdx			Index of the plane in the new
+* 					object.
+* \param	pln			Plane coordinate of the plane.
+* \param	cbData			Data passed to the directly to
+* 					the callback function.
+* \param	cbFn			Callback function.
+*/
+static WlzErrorNum WlzAffineTransformValues3Pln(WlzObject *newObj,
+					     WlzAffineTransformSrc3 *src,
+					     WlzGreyValueWSpace *gVWSp,
+					     WlzAffineTransform *invTrans,
+					     WlzInterpolationType interp,
+					     WlzGreyType gType,
+					     WlzPixelV bkdV,
+					     int pIdx,
+					     int pln,
+					     void *cbData,
+					     WlzAffineTransformCbFn cbFn)
+{
+  int		count;
+  WlzIVertex3	sPos,
+		dPos;
+  WlzDVertex3	pos,
+  		tDV0,
+  		tDV1;
+  WlzValues	tVal,
+  		emptyValues;
+  WlzObject 	*tObj0 = NULL;
+  WlzGreyWSpace	gWSp;
+  WlzIntervalWSpace iWSp;
+  WlzDomain	dom2D;
+  WlzGreyV	gV[8];
+  double	tMat[3][3];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  emptyValues.core = NULL;
+  dom2D = *(newObj->domain.p->domains + pIdx);
+  if((dom2D.core != NULL) && (dom2D.core->type != WLZ_EMPTY_DOMAIN))
+  {
+    dPos.vtZ = pln;
+    tMat[0][0] = invTrans->mat[0][0];
+    tMat[1][0] = invTrans->mat[1][0];
+    tMat[2][0] = invTrans->mat[2][0];
+    tMat[0][2] = invTrans->mat[0][3] + (invTrans->mat[0][2] * dPos.vtZ);
+    tMat[1][2] = invTrans->mat[1][3] + (invTrans->mat[1][2] * dPos.vtZ);
+    tMat[2][2] = invTrans->mat[2][3] + (invTrans->mat[2][2] * dPos.vtZ);
+    /* Make a 2D domain object for the plane. */
+    tObj0 = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom2D, emptyValues,
+			NULL, NULL, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      tVal.v = WlzNewValueTb(tObj0,
+			     WlzGreyTableType(WLZ_GREY_TAB_RAGR, gType,
+					      NULL),
+			     bkdV, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      tObj0->values = WlzAssignValues(tVal, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WlzInitGreyScan(tObj0, &iWSp, &gWSp);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      /* Fill in the values of the new 2D object. */
+      while((errNum == WLZ_ERR_NONE) &&
+	    ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
+      {
+	dPos.vtX = iWSp.lftpos;
+	dPos.vtY = iWSp.linpos;
+	tMat[0][1] = tMat[0][2] + (invTrans->mat[0][1] * dPos.vtY);
+	tMat[1][1] = tMat[1][2] + (invTrans->mat[1][1] * dPos.vtY);
+	tMat[2][1] = tMat[2][2] + (invTrans->mat[2][1] * dPos.vtY);
+	count = iWSp.rgtpos - iWSp.lftpos + 1;
+	switch(interp)
 	{
-	  /* Fill in the values of the new 2D object. */
-	  while((errNum == WLZ_ERR_NONE) &&
-	      ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
-	  {
-	    dPos.vtX = iWSp.lftpos;
-	    dPos.vtY = iWSp.linpos;
-	    tMat[0][1] = tMat[0][2] + (invTrans->mat[0][1] * dPos.vtY);
-	    tMat[1][1] = tMat[1][2] + (invTrans->mat[1][1] * dPos.vtY);
-	    tMat[2][1] = tMat[2][2] + (invTrans->mat[2][1] * dPos.vtY);
-	    count = iWSp.rgtpos - iWSp.lftpos + 1;
-	    switch(interp)
+	  case WLZ_INTERPOLATION_NEAREST:
+	    while(count-- > 0)
+	    {
+	      sPos.vtX = (int )(tMat[0][1] +
+				(tMat[0][0] * (double )(dPos.vtX)));
+	      sPos.vtY = (int )(tMat[1][1] +
+				(tMat[1][0] * (double )(dPos.vtX)));
+	      sPos.vtZ = (int )(tMat[2][1] +
+				(tMat[2][0] * (double )(dPos.vtX)));
+	      if(WlzAffineTransformSrcIn3(src, sPos, 0))
+	      {
+	        WlzAffineTransformSrcGet3(src, sPos, gV);
+		errNum = WlzAffineTransformSetGrey(&(gWSp.u_grintptr),
+						   gWSp.pixeltype, gV);
+	      }
+	      else
+	      {
+		WlzGreyValueGet(gVWSp, (double )(sPos.vtZ),
+				(double )(sPos.vtY), (double )(sPos.vtX));
+		errNum = WlzAffineTransformSetGrey(&(gWSp.u_grintptr),
+						   gWSp.pixeltype,
+						   gVWSp->gVal);
+	      }
+	      ++(dPos.vtX);
+	    }
+	    break;
+	  case WLZ_INTERPOLATION_LINEAR:
+	    while(count-- > 0)
 	    {
-	      case WLZ_INTERPOLATION_NEAREST:
-		while(count-- > 0)
-		{
-		  sPos.vtX = (int )(tMat[0][1] +
-				    (tMat[0][0] * (double )(dPos.vtX)));
-		  sPos.vtY = (int )(tMat[1][1] +
-				    (tMat[1][0] * (double )(dPos.vtX)));
-		  sPos.vtZ = (int )(tMat[2][1] +
-				    (tMat[2][0] * (double )(dPos.vtX)));
-		  WlzGreyValueGet(gVWSp, (double )(sPos.vtZ),
-				  (double )(sPos.vtY), (double )(sPos.vtX));
-		  switch(gWSp.pixeltype)
-		  {
-		    case WLZ_GREY_INT:
-		      *(gWSp.u_grintptr.inp)++ = (*(gVWSp->gVal)).inv;
-		      break;
-		    case WLZ_GREY_SHORT:
-		      *(gWSp.u_grintptr.shp)++ = (*(gVWSp->gVal)).shv;
-		      break;
-		    case WLZ_GREY_UBYTE:
-		      *(gWSp.u_grintptr.ubp)++ = (*(gVWSp->gVal)).ubv;
-		      break;
-		    case WLZ_GREY_FLOAT:
-		      *(gWSp.u_grintptr.flp)++ = (*(gVWSp->gVal)).flv;
-		      break;
-		    case WLZ_GREY_DOUBLE:
-		      *(gWSp.u_grintptr.dbp)++ = (*(gVWSp->gVal)).dbv;
-		      break;
-		    case WLZ_GREY_RGBA:
-		      *(gWSp.u_grintptr.rgbp)++ = (*(gVWSp->gVal)).rgbv;
-		      break;
-		    default:
-		      errNum = WLZ_ERR_GREY_TYPE;
-		      break;
-		  }
-		  ++(dPos.vtX);
-		}
-		break;
-	      case WLZ_INTERPOLATION_LINEAR:
-		while(count-- > 0)
-		{
-		  x = tMat[0][1] + (tMat[0][0] * dPos.vtX);
-		  y = tMat[1][1] + (tMat[1][0] * dPos.vtX);
-		  z = tMat[2][1] + (tMat[2][0] * dPos.vtX);
-		  WlzGreyValueGetCon(gVWSp, z, y, x);
-		  tDV0.vtX = x - WLZ_NINT(x - 0.5);
-		  tDV0.vtY = y - WLZ_NINT(y - 0.5);
-		  tDV0.vtZ = z - WLZ_NINT(z - 0.5);
-		  tDV1.vtX = 1.0 - tDV0.vtX;
-		  tDV1.vtY = 1.0 - tDV0.vtY;
-		  tDV1.vtZ = 1.0 - tDV0.vtZ;
-		  switch(gWSp.pixeltype)
-		  {
-		    case WLZ_GREY_INT:
-		      tD0 = ((gVWSp->gVal[0]).inv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).inv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).inv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).inv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).inv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).inv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).inv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).inv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0,
-				      (double )(INT_MIN), (double )(INT_MAX));
-		      tI0 = WLZ_NINT(tD0);
-		      *(gWSp.u_grintptr.inp)++ = tI0;
-		      break;
-		    case WLZ_GREY_SHORT:
-		      tD0 = ((gVWSp->gVal[0]).shv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).shv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).shv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).shv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).shv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).shv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).shv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).shv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0,
-				      (double )(SHRT_MIN),
-				      (double )(SHRT_MAX));
-		      tI0 = WLZ_NINT(tD0);
-		      *(gWSp.u_grintptr.shp)++ = (short )tI0;
-		      break;
-		    case WLZ_GREY_UBYTE:
-		      tD0 = ((gVWSp->gVal[0]).ubv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).ubv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).ubv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).ubv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).ubv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).ubv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).ubv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).ubv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      *(gWSp.u_grintptr.ubp)++ = (WlzUByte )tI0;
-		      break;
-		    case WLZ_GREY_FLOAT:
-		      tD0 = ((gVWSp->gVal[0]).flv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).flv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).flv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).flv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).flv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).flv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).flv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).flv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, FLT_MIN, FLT_MAX);
-		      *(gWSp.u_grintptr.flp)++ = (float )tD0;
-		      break;
-		    case WLZ_GREY_DOUBLE:
-		      tD0 = ((gVWSp->gVal[0]).dbv *
-			  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[1]).dbv *
-			 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[2]).dbv *
-			 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[3]).dbv *
-			 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			((gVWSp->gVal[4]).dbv *
-			 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[5]).dbv *
-			 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[6]).dbv *
-			 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			((gVWSp->gVal[7]).dbv *
-			 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      *(gWSp.u_grintptr.dbp)++ = tD0;
-		      break;
-		    case WLZ_GREY_RGBA:
-		      tD0 = (WLZ_RGBA_RED_GET((gVWSp->gVal[0]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[1]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[2]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[3]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[4]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[5]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[6]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_RED_GET((gVWSp->gVal[7]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      WLZ_RGBA_RED_SET(*(gWSp.u_grintptr.rgbp),
-		                       (WlzUByte )tI0);
-		      tD0 = (WLZ_RGBA_GREEN_GET((gVWSp->gVal[0]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[1]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[2]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[3]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[4]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[5]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[6]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_GREEN_GET((gVWSp->gVal[7]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      WLZ_RGBA_GREEN_SET(*(gWSp.u_grintptr.rgbp),
-		                         (WlzUByte )tI0);
-		      tD0 = (WLZ_RGBA_BLUE_GET((gVWSp->gVal[0]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[1]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[2]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[3]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[4]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[5]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[6]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_BLUE_GET((gVWSp->gVal[7]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      WLZ_RGBA_BLUE_SET(*(gWSp.u_grintptr.rgbp),
-		                        (WlzUByte )tI0);
-		      tD0 = (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[0]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[1]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[2]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[3]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[4]).rgbv) *
-			     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[5]).rgbv) *
-			     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[6]).rgbv) *
-			     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
-			    (WLZ_RGBA_ALPHA_GET((gVWSp->gVal[7]).rgbv) *
-			     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
-		      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
-		      tI0 = WLZ_NINT(tD0);
-		      WLZ_RGBA_ALPHA_SET(*(gWSp.u_grintptr.rgbp), (WlzUByte )tI0);
-		      ++(gWSp.u_grintptr.rgbp);
-		      break;
-		    default:
-		      errNum = WLZ_ERR_GREY_TYPE;
-		      break;
-		  }
-		  ++(dPos.vtX);
-		}
-		break;
-	      case WLZ_INTERPOLATION_CALLBACK:
-		errNum = (*cbFn)(cbData, &gWSp, gVWSp, invTrans,
-				 dPos.vtZ, dPos.vtY);
-		break;
-	      default:
-		errNum = WLZ_ERR_INTERPOLATION_TYPE;
-		break;
+	      WlzGreyV	*gVP;
+
+	      pos.vtX = tMat[0][1] + (tMat[0][0] * dPos.vtX);
+	      pos.vtY = tMat[1][1] + (tMat[1][0] * dPos.vtX);
+	      pos.vtZ = tMat[2][1] + (tMat[2][0] * dPos.vtX);
+	      sPos.vtX = (int )(pos.vtX);
+	      sPos.vtY = (int )(pos.vtY);
+	      sPos.vtZ = (int )(pos.vtZ);
+	      if(WlzAffineTransformSrcIn3(src, sPos, 1))
+	      {
+		WlzAffineTransformSrcGetCon3(src, sPos, gV);
+		gVP = gV;
+	      }
+	      else
+	      {
+		WlzGreyValueGetConFull(gVWSp, pos.vtZ, pos.vtY, pos.vtX);
+		gVP = gVWSp->gVal;
+	      }
+	      tDV0.vtX = pos.vtX - WLZ_NINT(pos.vtX - 0.5);
+	      tDV0.vtY = pos.vtY - WLZ_NINT(pos.vtY - 0.5);
+	      tDV0.vtZ = pos.vtZ - WLZ_NINT(pos.vtZ - 0.5);
+	      tDV1.vtX = 1.0 - tDV0.vtX;
+	      tDV1.vtY = 1.0 - tDV0.vtY;
+	      tDV1.vtZ = 1.0 - tDV0.vtZ;
+	      errNum = WlzAffineTransformSetGreyLinear3(&(gWSp.u_grintptr),
+						        gWSp.pixeltype, gVP,
+						        tDV0, tDV1);
+	      ++(dPos.vtX);
 	    }
-	  }
-          (void )WlzEndGreyScan(&iWSp, &gWSp);
+	    break;
+	  case WLZ_INTERPOLATION_CALLBACK:
+	    errNum = (*cbFn)(cbData, &gWSp, gVWSp, invTrans,
+			     dPos.vtZ, dPos.vtY);
+	    break;
+	  default:
+	    errNum = WLZ_ERR_INTERPOLATION_TYPE;
+	    break;
 	}
-	if(errNum == WLZ_ERR_EOO)
+      }
+      (void )WlzEndGreyScan(&iWSp, &gWSp);
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      *(newObj->values.vox->values + pIdx) =
+	WlzAssignValues(tObj0->values, NULL);
+    }
+    if(tObj0)
+    {
+      (void )WlzFreeObj(tObj0);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzTransform
+* \return				Error number.
+* \brief	Sets up direct access to the values of the given 3D
+* 		source object for those planes which have a
+* 		rectangular domain and either rectangular or tiled
+* 		values. If no planes can be directly accessed then
+* 		the per plane access array is not allocated.
+* \param	src			Direct access to be set up.
+* \param	srcObj			3D domain object which is being
+*					transformed.
+* \param	gType			Grey type of the source object.
+*/
+static WlzErrorNum WlzAffineTransformSrcInit3(WlzAffineTransformSrc3 *src,
+					      WlzObject *srcObj,
+					      WlzGreyType gType)
+{
+  int		idP,
+		nPln,
+		direct = 1,
+		nDirect = 0;
+  WlzPlaneDomain *pDom;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  pDom = srcObj->domain.p;
+  src->gType = gType;
+  src->plane1 = pDom->plane1;
+  src->lastpl = pDom->lastpl;
+  src->tVal = NULL;
+  if(WlzGreyTableIsTiled(srcObj->values.core->type))
+  {
+    if((srcObj->values.t->dim != 3) || (srcObj->values.t->tiles.v == NULL))
+    {
+      direct = 0;
+    }
+    src->tVal = srcObj->values.t;
+  }
+  nPln = pDom->lastpl - pDom->plane1 + 1;
+  if(direct == 0)
+  {
+    src->pln = NULL;
+  }
+  else if((src->pln = (WlzAffineTransformPln3 *)
+		      AlcCalloc(nPln, sizeof(WlzAffineTransformPln3))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    for(idP = 0; idP < nPln; ++idP)
+    {
+      WlzIntervalDomain *iDom;
+      WlzAffineTransformPln3 *sPln;
+
+      sPln = src->pln + idP;
+      iDom = (*(pDom->domains + idP)).i;
+      if((iDom != NULL) && (iDom->type == WLZ_INTERVALDOMAIN_RECT))
+      {
+	if(src->tVal)
 	{
-	  errNum = WLZ_ERR_NONE;
+	  sPln->values = src->tVal->tiles;
 	}
-	if(errNum == WLZ_ERR_NONE)
+	else
 	{
-	  *(newObj->values.vox->values + idx.vtZ) =
-	    WlzAssignValues(tObj0->values, NULL);
+	  WlzRectValues *rVal;
+
+	  rVal = (*(srcObj->values.vox->values + idP)).r;
+	  if((rVal != NULL) &&
+	     (WlzGreyTableTypeToTableType(rVal->type,
+					  NULL) == WLZ_GREY_TAB_RECT) &&
+	     (WlzGreyTableTypeToGreyType(rVal->type, NULL) == gType))
+	  {
+	    sPln->values = rVal->values;
+	    sPln->vLine1 = rVal->line1;
+	    sPln->vKol1 = rVal->kol1;
+	    sPln->width = rVal->width;
+	  }
 	}
-	if(tObj0)
+	if(sPln->values.v != NULL)
 	{
-	  (void )WlzFreeObj(tObj0);
+	  ++nDirect;
+	  sPln->line1 = iDom->line1;
+	  sPln->lastln = iDom->lastln;
+	  sPln->kol1 = iDom->kol1;
+	  sPln->lastkl = iDom->lastkl;
 	}
       }
-      ++(idx.vtZ);
-      ++(dPos.vtZ);
+    }
+    if(nDirect == 0)
+    {
+      AlcFree(src->pln);
+      src->pln = NULL;
     }
   }
-  WlzGreyValueFreeWSp(gVWSp);
-  if(invTrans)
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzTransform
+* \return				Non zero if all the values required
+* 					are directly accessible.
+* \brief	Tests whether the single value at the given position
+* 		(n == 0) or the eight values of the 2x2x2 block with it's
+* 		origin at the given position (n == 1) are within
+* 		directly accessible planes of the source.
+* \param	src			Direct access to the source values.
+* \param	pos			Position in the source.
+* \param	n			Size of block - 1.
+*/
+static int	WlzAffineTransformSrcIn3(WlzAffineTransformSrc3 *src,
+					 WlzIVertex3 pos, int n)
+{
+  int		in = 0;
+
+  if((src->pln != NULL) &&
+     (pos.vtZ >= src->plane1) && (pos.vtZ + n <= src->lastpl))
   {
-    (void )WlzFreeAffineTransform(invTrans);
+    WlzAffineTransformPln3 *sPln;
+
+    sPln = src->pln + pos.vtZ - src->plane1;
+    in = (sPln->values.v != NULL) &&
+	 (pos.vtY >= sPln->line1) && (pos.vtY + n <= sPln->lastln) &&
+	 (pos.vtX >= sPln->kol1) && (pos.vtX + n <= sPln->lastkl);
+    if(in && n)
+    {
+      ++sPln;
+      in = (sPln->values.v != NULL) &&
+	   (pos.vtY >= sPln->line1) && (pos.vtY + n <= sPln->lastln) &&
+	   (pos.vtX >= sPln->kol1) && (pos.vtX + n <= sPln->lastkl);
+    }
+  }
+  return(in);
+}
+
+/*!
+* \ingroup	WlzTransform
+* \brief	Gets the value at the given position of the source,
+* 		which must be known to be directly accessible.
+* \param	src			Direct access to the source values.
+* \param	pos			Position in the source.
+* \param	gV			Destination for the value.
+*/
+static void	WlzAffineTransformSrcGet3(WlzAffineTransformSrc3 *src,
+					  WlzIVertex3 pos, WlzGreyV *gV)
+{
+  size_t	off;
+  WlzAffineTransformPln3 *sPln;
+
+  sPln = src->pln + pos.vtZ - src->plane1;
+  if(src->tVal)
+  {
+    size_t	tW;
+    WlzIVertex3	rPos;
+    WlzTiledValues *tVal;
+
+    tVal = src->tVal;
+    tW = tVal->tileWidth;
+    rPos.vtX = pos.vtX - tVal->kol1;
+    rPos.vtY = pos.vtY - tVal->line1;
+    rPos.vtZ = pos.vtZ - tVal->plane1;
+    off = ((((rPos.vtZ / tW) * tVal->nIdx[1]) + (rPos.vtY / tW)) *
+	   tVal->nIdx[0]) + (rPos.vtX / tW);
+    off = (*(tVal->indices + off) * tVal->tileSz) +
+	  ((((rPos.vtZ % tW) * tW) + (rPos.vtY % tW)) * tW) +
+	  (rPos.vtX % tW);
+  }
+  else
+  {
+    off = ((size_t )(pos.vtY - sPln->vLine1) * sPln->width) +
+	  pos.vtX - sPln->vKol1;
+  }
+  switch(src->gType)
+  {
+    case WLZ_GREY_INT:
+      gV->inv = *(sPln->values.inp + off);
+      break;
+    case WLZ_GREY_SHORT:
+      gV->shv = *(sPln->values.shp + off);
+      break;
+    case WLZ_GREY_UBYTE:
+      gV->ubv = *(sPln->values.ubp + off);
+      break;
+    case WLZ_GREY_FLOAT:
+      gV->flv = *(sPln->values.flp + off);
+      break;
+    case WLZ_GREY_DOUBLE:
+      gV->dbv = *(sPln->values.dbp + off);
+      break;
+    case WLZ_GREY_RGBA:
+      gV->rgbv = *(sPln->values.rgbp + off);
+      break;
+    default:
+      break;
+  }
+}
+
+/*!
+* \ingroup	WlzTransform
+* \brief	Gets the eight values of the 2x2x2 block with it's
+* 		origin at the given position of the source, which must
+* 		be known to be directly accessible. The values are
+* 		in the same order as those of WlzGreyValueGetCon().
+* \param	src			Direct access to the source values.
+* \param	pos			Origin of the block in the source.
+* \param	gV			Destination for the eight values.
+*/
+static void	WlzAffineTransformSrcGetCon3(WlzAffineTransformSrc3 *src,
+					     WlzIVertex3 pos, WlzGreyV *gV)
+{
+  int		idK,
+  		idL,
+		idP;
+  WlzIVertex3	nPos;
+
+  for(idP = 0; idP < 2; ++idP)
+  {
+    nPos.vtZ = pos.vtZ + idP;
+    for(idL = 0; idL < 2; ++idL)
+    {
+      nPos.vtY = pos.vtY + idL;
+      for(idK = 0; idK < 2; ++idK)
+      {
+	nPos.vtX = pos.vtX + idK;
+	WlzAffineTransformSrcGet3(src, nPos, gV++);
+      }
+    }
+  }
+}
+
+/*!
+* \ingroup	WlzTransform
+* \return				Error number.
+* \brief	Sets the grey value at the given destination pointer
+* 		and then increments the pointer.
+* \param	dP			Destination pointer.
+* \param	gType			Grey type.
+* \param	gV			Grey value.
+*/
+static WlzErrorNum WlzAffineTransformSetGrey(WlzGreyP *dP, WlzGreyType gType,
+					     WlzGreyV *gV)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(gType)
+  {
+    case WLZ_GREY_INT:
+      *(dP->inp)++ = gV->inv;
+      break;
+    case WLZ_GREY_SHORT:
+      *(dP->shp)++ = gV->shv;
+      break;
+    case WLZ_GREY_UBYTE:
+      *(dP->ubp)++ = gV->ubv;
+      break;
+    case WLZ_GREY_FLOAT:
+      *(dP->flp)++ = gV->flv;
+      break;
+    case WLZ_GREY_DOUBLE:
+      *(dP->dbp)++ = gV->dbv;
+      break;
+    case WLZ_GREY_RGBA:
+      *(dP->rgbp)++ = gV->rgbv;
+      break;
+    default:
+      errNum = WLZ_ERR_GREY_TYPE;
+      break;
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzTransform
+* \return				Error number.
+* \brief	Sets the tri-linear interpolated grey value at the given
+* 		destination pointer and then increments the pointer.
+* \param	dP			Destination pointer.
+* \param	gType			Grey type.
+* \param	gV			The eight grey values, in the order
+* 					of WlzGreyValueGetCon().
+* \param	tDV0			Offsets of the position from the
+* 					origin of the eight values.
+* \param	tDV1			One minus the offsets.
+*/
+static WlzErrorNum WlzAffineTransformSetGreyLinear3(WlzGreyP *dP,
+					WlzGreyType gType, WlzGreyV *gV,
+					WlzDVertex3 tDV0, WlzDVertex3 tDV1)
+{
+  int		tI0;
+  double	tD0;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(gType)
+  {
+    case WLZ_GREY_INT:
+      tD0 = ((gV[0]).inv *
+	  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+	((gV[1]).inv *
+	 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+	((gV[2]).inv *
+	 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+	((gV[3]).inv *
+	 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+	((gV[4]).inv *
+	 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+	((gV[5]).inv *
+	 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+	((gV[6]).inv *
+	 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+	((gV[7]).inv *
+	 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+      tD0 = WLZ_CLAMP(tD0,
+		      (double )(INT_MIN), (double )(INT_MAX));
+      tI0 = WLZ_NINT(tD0);
+      *(dP->inp)++ = tI0;
+      break;
+    case WLZ_GREY_SHORT:
+      tD0 = ((gV[0]).shv *
+	  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+	((gV[1]).shv *
+	 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+	((gV[2]).shv *
+	 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+	((gV[3]).shv *
+	 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+	((gV[4]).shv *
+	 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+	((gV[5]).shv *
+	 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+	((gV[6]).shv *
+	 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+	((gV[7]).shv *
+	 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+      tD0 = WLZ_CLAMP(tD0,
+		      (double )(SHRT_MIN),
+		      (double )(SHRT_MAX));
+      tI0 = WLZ_NINT(tD0);
+      *(dP->shp)++ = (short )tI0;
+      break;
+    case WLZ_GREY_UBYTE:
+      tD0 = ((gV[0]).ubv *
+	  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+	((gV[1]).ubv *
+	 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+	((gV[2]).ubv *
+	 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+	((gV[3]).ubv *
+	 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+	((gV[4]).ubv *
+	 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+	((gV[5]).ubv *
+	 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+	((gV[6]).ubv *
+	 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+	((gV[7]).ubv *
+	 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+      tI0 = WLZ_NINT(tD0);
+      *(dP->ubp)++ = (WlzUByte )tI0;
+      break;
+    case WLZ_GREY_FLOAT:
+      tD0 = ((gV[0]).flv *
+	  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+	((gV[1]).flv *
+	 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+	((gV[2]).flv *
+	 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+	((gV[3]).flv *
+	 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+	((gV[4]).flv *
+	 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+	((gV[5]).flv *
+	 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+	((gV[6]).flv *
+	 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+	((gV[7]).flv *
+	 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+      tD0 = WLZ_CLAMP(tD0, FLT_MIN, FLT_MAX);
+      *(dP->flp)++ = (float )tD0;
+      break;
+    case WLZ_GREY_DOUBLE:
+      tD0 = ((gV[0]).dbv *
+	  tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+	((gV[1]).dbv *
+	 tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+	((gV[2]).dbv *
+	 tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+	((gV[3]).dbv *
+	 tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+	((gV[4]).dbv *
+	 tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+	((gV[5]).dbv *
+	 tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+	((gV[6]).dbv *
+	 tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+	((gV[7]).dbv *
+	 tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+      *(dP->dbp)++ = tD0;
+      break;
+    case WLZ_GREY_RGBA:
+      tD0 = (WLZ_RGBA_RED_GET((gV[0]).rgbv) *
+	     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+	    (WLZ_RGBA_RED_GET((gV[1]).rgbv) *
+	     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+	    (WLZ_RGBA_RED_GET((gV[2]).rgbv) *
+	     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+	    (WLZ_RGBA_RED_GET((gV[3]).rgbv) *
+	     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+	    (WLZ_RGBA_RED_GET((gV[4]).rgbv) *
+	     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+	    (WLZ_RGBA_RED_GET((gV[5]).rgbv) *
+	     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+	    (WLZ_RGBA_RED_GET((gV[6]).rgbv) *
+	     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+	    (WLZ_RGBA_RED_GET((gV[7]).rgbv) *
+	     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+      tI0 = WLZ_NINT(tD0);
+      WLZ_RGBA_RED_SET(*(dP->rgbp),
+		       (WlzUByte )tI0);
+      tD0 = (WLZ_RGBA_GREEN_GET((gV[0]).rgbv) *
+	     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+	    (WLZ_RGBA_GREEN_GET((gV[1]).rgbv) *
+	     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+	    (WLZ_RGBA_GREEN_GET((gV[2]).rgbv) *
+	     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+	    (WLZ_RGBA_GREEN_GET((gV[3]).rgbv) *
+	     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+	    (WLZ_RGBA_GREEN_GET((gV[4]).rgbv) *
+	     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+	    (WLZ_RGBA_GREEN_GET((gV[5]).rgbv) *
+	     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+	    (WLZ_RGBA_GREEN_GET((gV[6]).rgbv) *
+	     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+	    (WLZ_RGBA_GREEN_GET((gV[7]).rgbv) *
+	     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+      tI0 = WLZ_NINT(tD0);
+      WLZ_RGBA_GREEN_SET(*(dP->rgbp),
+			 (WlzUByte )tI0);
+      tD0 = (WLZ_RGBA_BLUE_GET((gV[0]).rgbv) *
+	     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+	    (WLZ_RGBA_BLUE_GET((gV[1]).rgbv) *
+	     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+	    (WLZ_RGBA_BLUE_GET((gV[2]).rgbv) *
+	     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+	    (WLZ_RGBA_BLUE_GET((gV[3]).rgbv) *
+	     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+	    (WLZ_RGBA_BLUE_GET((gV[4]).rgbv) *
+	     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+	    (WLZ_RGBA_BLUE_GET((gV[5]).rgbv) *
+	     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+	    (WLZ_RGBA_BLUE_GET((gV[6]).rgbv) *
+	     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+	    (WLZ_RGBA_BLUE_GET((gV[7]).rgbv) *
+	     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+      tI0 = WLZ_NINT(tD0);
+      WLZ_RGBA_BLUE_SET(*(dP->rgbp),
+			(WlzUByte )tI0);
+      tD0 = (WLZ_RGBA_ALPHA_GET((gV[0]).rgbv) *
+	     tDV1.vtX * tDV1.vtY * tDV1.vtZ) +
+	    (WLZ_RGBA_ALPHA_GET((gV[1]).rgbv) *
+	     tDV0.vtX * tDV1.vtY * tDV1.vtZ) +
+	    (WLZ_RGBA_ALPHA_GET((gV[2]).rgbv) *
+	     tDV1.vtX * tDV0.vtY * tDV1.vtZ) +
+	    (WLZ_RGBA_ALPHA_GET((gV[3]).rgbv) *
+	     tDV0.vtX * tDV0.vtY * tDV1.vtZ) +
+	    (WLZ_RGBA_ALPHA_GET((gV[4]).rgbv) *
+	     tDV1.vtX * tDV1.vtY * tDV0.vtZ) +
+	    (WLZ_RGBA_ALPHA_GET((gV[5]).rgbv) *
+	     tDV0.vtX * tDV1.vtY * tDV0.vtZ) +
+	    (WLZ_RGBA_ALPHA_GET((gV[6]).rgbv) *
+	     tDV1.vtX * tDV0.vtY * tDV0.vtZ) +
+	    (WLZ_RGBA_ALPHA_GET((gV[7]).rgbv) *
+	     tDV0.vtX * tDV0.vtY * tDV0.vtZ);
+      tD0 = WLZ_CLAMP(tD0, 0.0, 255.0);
+      tI0 = WLZ_NINT(tD0);
+      WLZ_RGBA_ALPHA_SET(*(dP->rgbp), (WlzUByte )tI0);
+      ++(dP->rgbp);
+      break;
+    default:
+      errNum = WLZ_ERR_GREY_TYPE;
+      break;
   }
   return(errNum);
 }
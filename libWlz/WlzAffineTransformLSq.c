@@ -44,7 +44,78 @@ static char _WlzAffineTransformLSq_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 #include <Wlz.h>
 
+/*!
+* \def		WLZ_AFFINETRANSFORMLSQ_BLKSZ
+* \ingroup	WlzTransform
+* \brief	Number of vertex pairs accumulated per block. The sums
+*		of the blocks are always combined in the same order so
+*		that results do not depend on the number of threads.
+*/
+#define WLZ_AFFINETRANSFORMLSQ_BLKSZ	(4096)
+
+/*!
+* \struct	_WlzAffineTransformLSqAccData
+* \ingroup	WlzTransform
+* \brief	Data passed to the least squares accumulation functions.
+*		Typedef: ::WlzAffineTransformLSqAccData.
+*/
+typedef struct _WlzAffineTransformLSqAccData
+{
+  WlzVertexP	vT;		/*!< Target vertices. */
+  WlzVertexP	vS;		/*!< Source vertices. */
+  double	*vW;		/*!< Vertex pair weights, may be NULL. */
+  WlzVertex	cen0;		/*!< Centroid of the weighted target
+  				     vertices. */
+  WlzVertex	cen1;		/*!< Centroid of the weighted source
+  				     vertices. */
+} WlzAffineTransformLSqAccData;
 
+/*!
+* \typedef	WlzAffineTransformLSqAccFn
+* \ingroup	WlzTransform
+* \brief	Accumulates sums for the vertex pairs in the range
+*		[i0, i1) into the given array.
+*/
+typedef void	(*WlzAffineTransformLSqAccFn)(
+				  WlzAffineTransformLSqAccData *,
+				  int, int, double *);
+
+static void			WlzAffineTransformLSqAccGen2D(
+				  WlzAffineTransformLSqAccData *dat,
+				  int i0,
+				  int i1,
+				  double *sums);
+static void			WlzAffineTransformLSqAccGen3D(
+				  WlzAffineTransformLSqAccData *dat,
+				  int i0,
+				  int i1,
+				  double *sums);
+static void			WlzAffineTransformLSqAccCen2D(
+				  WlzAffineTransformLSqAccData *dat,
+				  int i0,
+				  int i1,
+				  double *sums);
+static void			WlzAffineTransformLSqAccCen3D(
+				  WlzAffineTransformLSqAccData *dat,
+				  int i0,
+				  int i1,
+				  double *sums);
+static void			WlzAffineTransformLSqAccCov2D(
+				  WlzAffineTransformLSqAccData *dat,
+				  int i0,
+				  int i1,
+				  double *sums);
+static void			WlzAffineTransformLSqAccCov3D(
+				  WlzAffineTransformLSqAccData *dat,
+				  int i0,
+				  int i1,
+				  double *sums);
+static WlzErrorNum		WlzAffineTransformLSqSums(
+				  WlzAffineTransformLSqAccFn fn,
+				  WlzAffineTransformLSqAccData *dat,
+				  int nV,
+				  int nSum,
+				  double *sums);
 static WlzErrorNum 		WlzAffineTransformLSqLinSysSolve(
 				  AlgMatrix aM,
 				  double *bV,
@@ -543,13 +614,13 @@ WlzAffineTransform *WlzAffineTransformLSqGen2D(WlzDVertex2 *vT,
 				WlzErrorNum *dstErr)
 {
   int		idx;
-  double	wSq;
   double	**aA,
 		**trA;
   double	bV[4],
   		sums[12];
   AlgMatrix	aM,
   		trM;
+  WlzAffineTransformLSqAccData dat;
   WlzAffineTransform *tr = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
@@ -571,43 +642,18 @@ WlzAffineTransform *WlzAffineTransformLSqGen2D(WlzDVertex2 *vT,
       sums[idx] = 0;
     }
     /* Accumulate values */
-    if(vW)
-    {
-      for(idx = 0; idx < nV; ++idx)
-      {
-	wSq = vW[idx] * vW[idx];
-	sums[0]  += vS[idx].vtX * vS[idx].vtX * wSq;
-	sums[1]  += vS[idx].vtX * vS[idx].vtY * wSq;
-	sums[2]  += vS[idx].vtX * wSq;
-	sums[3]  += vS[idx].vtY * vS[idx].vtY * wSq;
-	sums[4]  += vS[idx].vtY * wSq;
-	sums[5]  += wSq;
-	sums[6]  += vS[idx].vtX * vT[idx].vtX * wSq;
-	sums[7]  += vS[idx].vtY * vT[idx].vtX * wSq;
-	sums[8]  += vT[idx].vtX * wSq;
-	sums[9]  += vS[idx].vtX * vT[idx].vtY * wSq;
-	sums[10] += vS[idx].vtY * vT[idx].vtY * wSq;
-	sums[11] += vT[idx].vtY * wSq;
-      }
-    }
-    else
+    if(vW == NULL)
     {
       sums[5]  = (double )nV;
-      for(idx = 0; idx < nV; ++idx)
-      {
-	sums[0]  += vS[idx].vtX * vS[idx].vtX;
-	sums[1]  += vS[idx].vtX * vS[idx].vtY;
-	sums[2]  += vS[idx].vtX;
-	sums[3]  += vS[idx].vtY * vS[idx].vtY;
-	sums[4]  += vS[idx].vtY;
-	sums[6]  += vS[idx].vtX * vT[idx].vtX;
-	sums[7]  += vS[idx].vtY * vT[idx].vtX;
-	sums[8]  += vT[idx].vtX;
-	sums[9]  += vS[idx].vtX * vT[idx].vtY;
-	sums[10] += vS[idx].vtY * vT[idx].vtY;
-	sums[11] += vT[idx].vtY;
-      }
     }
+    dat.vT.d2 = vT;
+    dat.vS.d2 = vS;
+    dat.vW = vW;
+    errNum = WlzAffineTransformLSqSums(WlzAffineTransformLSqAccGen2D, &dat,
+    				       nV, 12, sums);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
     /* Allocate workspace */
     if(((aM.rect = AlgMatrixRectNew(3, 3, NULL)) == NULL) ||
        ((trM.rect = AlgMatrixRectNew(4, 4, NULL)) == NULL))
@@ -742,13 +788,13 @@ WlzAffineTransform *WlzAffineTransformLSqGen3D(WlzDVertex3 *vT,
 				WlzErrorNum *dstErr)
 {
   int		idx;
-  double	wSq;
   double	**aA,
 		**trA;
   double	bV[4],
   		sums[22];
   AlgMatrix	aM,
   		trM;
+  WlzAffineTransformLSqAccData dat;
   WlzAffineTransform *tr = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   const double	eps = 0.000000001;
@@ -771,64 +817,18 @@ WlzAffineTransform *WlzAffineTransformLSqGen3D(WlzDVertex3 *vT,
       sums[idx] = 0;
     }
     /* Accumulate values */
-    if(vW)
-    {
-      for(idx = 0; idx < nV; ++idx)
-      {
-	wSq = vW[idx] * vW[idx];
-	sums[0]  += vS[idx].vtX * vS[idx].vtX * wSq;
-	sums[1]  += vS[idx].vtX * vS[idx].vtY * wSq;
-	sums[2]  += vS[idx].vtX * vS[idx].vtZ * wSq;
-	sums[3]  += vS[idx].vtX * wSq;
-	sums[4]  += vS[idx].vtY * vS[idx].vtY * wSq;
-	sums[5]  += vS[idx].vtY * vS[idx].vtZ * wSq;
-	sums[6]  += vS[idx].vtY * wSq;
-	sums[7]  += vS[idx].vtZ * vS[idx].vtZ * wSq;
-	sums[8]  += vS[idx].vtZ * wSq;
-	sums[9]  += wSq;
-	sums[10] += vS[idx].vtX * vT[idx].vtX * wSq;
-	sums[11] += vS[idx].vtY * vT[idx].vtX * wSq;
-	sums[12] += vS[idx].vtZ * vT[idx].vtX * wSq;
-	sums[13] += vT[idx].vtX * wSq;
-	sums[14]  += vS[idx].vtX * vT[idx].vtY * wSq;
-	sums[15]  += vS[idx].vtY * vT[idx].vtY * wSq;
-	sums[16]  += vS[idx].vtZ * vT[idx].vtY * wSq;
-	sums[17]  += vT[idx].vtY * wSq;
-	sums[18]  += vS[idx].vtX * vT[idx].vtZ * wSq;
-	sums[19]  += vS[idx].vtY * vT[idx].vtZ * wSq;
-	sums[20]  += vS[idx].vtZ * vT[idx].vtZ * wSq;
-	sums[21]  += vT[idx].vtZ * wSq;
-
-      }
-    }
-    else
+    if(vW == NULL)
     {
       sums[9]  = (double )nV;
-      for(idx = 0; idx < nV; ++idx)
-      {
-	sums[0]  += vS[idx].vtX * vS[idx].vtX;
-	sums[1]  += vS[idx].vtX * vS[idx].vtY;
-	sums[2]  += vS[idx].vtX * vS[idx].vtZ;
-	sums[3]  += vS[idx].vtX;
-	sums[4]  += vS[idx].vtY * vS[idx].vtY;
-	sums[5]  += vS[idx].vtY * vS[idx].vtZ;
-	sums[6]  += vS[idx].vtY;
-	sums[7]  += vS[idx].vtZ * vS[idx].vtZ;
-	sums[8]  += vS[idx].vtZ;
-	sums[10] += vS[idx].vtX * vT[idx].vtX;
-	sums[11] += vS[idx].vtY * vT[idx].vtX;
-	sums[12] += vS[idx].vtZ * vT[idx].vtX;
-	sums[13] += vT[idx].vtX;
-	sums[14] += vS[idx].vtX * vT[idx].vtY;
-	sums[15] += vS[idx].vtY * vT[idx].vtY;
-	sums[16] += vS[idx].vtZ * vT[idx].vtY;
-	sums[17] += vT[idx].vtY;
-	sums[18] += vS[idx].vtX * vT[idx].vtZ;
-	sums[19] += vS[idx].vtY * vT[idx].vtZ;
-	sums[20] += vS[idx].vtZ * vT[idx].vtZ;
-	sums[21] += vT[idx].vtZ;
-      }
     }
+    dat.vT.d3 = vT;
+    dat.vS.d3 = vS;
+    dat.vW = vW;
+    errNum = WlzAffineTransformLSqSums(WlzAffineTransformLSqAccGen3D, &dat,
+    				       nV, 22, sums);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
     /* Allocate workspace */
     if(((aM.rect = AlgMatrixRectNew(4, 4, NULL)) == NULL) ||
        ((trM.rect = AlgMatrixRectNew(4, 4, NULL)) == NULL))
@@ -944,27 +944,27 @@ WlzAffineTransform *WlzAffineTransformLSqReg2D(WlzDVertex2 *vT,
 		    		WlzDVertex2 *vS, double *vW, int nVtx,
 				WlzErrorNum *dstErr)
 {
-  int		tI0,
-  		idN;
+  int		tI0;
   double	tD0,
   		meanSqD;
-  WlzDVertex2	p0,
-  		p1,
-		cen0,
-  		cen1,
-		rel0,
-		rel1;
+  WlzDVertex2	cen0,
+  		cen1;
   double	wV[2];
+  double	cSums[5],
+  		hSums[4];
   double	**hA,
 		**vA,
   		**trA = NULL;
   AlgMatrix	hM,
   		vM;
+  WlzAffineTransformLSqAccData dat;
   WlzAffineTransform *tr = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   const double	tol = 1.0E-06;
 
   wV[0] = wV[1] = 0.0;
+  WlzValueSetDouble(cSums, 0.0, 5);
+  WlzValueSetDouble(hSums, 0.0, 4);
   hM.core = vM.core = NULL;
   if(((hM.rect = AlgMatrixRectNew(2, 2, NULL)) == NULL) ||
      ((vM.rect = AlgMatrixRectNew(2, 2, NULL)) == NULL) ||
@@ -978,37 +978,19 @@ WlzAffineTransform *WlzAffineTransformLSqReg2D(WlzDVertex2 *vT,
     vA = vM.rect->array;
     /* Compute weighted centroids (cen0 and cen1) and a mean of squares of
      * distance * between the weighted vertices. */
-    if(vW)
-    {
-      WLZ_VTX_2_SCALE(p0, *vT, *vW);
-      WLZ_VTX_2_SCALE(p1, *vS, *vW);
-    }
-    else
-    {
-      p0 = *vT;
-      p1 = *vS;
-    }
-    cen0 = p0;
-    cen1 = p1;
-    WLZ_VTX_2_SUB(rel0, p0, p1);
-    meanSqD = WLZ_VTX_2_DOT(rel0, rel0);
-    for(idN = 1; idN < nVtx; ++idN)
-    {
-      if(vW)
-      {
-	WLZ_VTX_2_SCALE(p0, *(vT + idN), *(vW + idN));
-	WLZ_VTX_2_SCALE(p1, *(vS + idN), *(vW + idN));
-      }
-      else
-      {
-        p0 = *(vT + idN);
-	p1 = *(vS + idN);
-      }
-      WLZ_VTX_2_ADD(cen0, cen0, p0);
-      WLZ_VTX_2_ADD(cen1, cen1, p1);
-      WLZ_VTX_2_SUB(rel0, p0, p1);
-      meanSqD += WLZ_VTX_2_DOT(rel0, rel0);
-    }
+    dat.vT.d2 = vT;
+    dat.vS.d2 = vS;
+    dat.vW = vW;
+    errNum = WlzAffineTransformLSqSums(WlzAffineTransformLSqAccCen2D, &dat,
+    				       nVtx, 5, cSums);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    cen0.vtX = cSums[0];
+    cen0.vtY = cSums[1];
+    cen1.vtX = cSums[2];
+    cen1.vtY = cSums[3];
+    meanSqD = cSums[4];
     tD0 = 1.0 / nVtx;
     meanSqD *= tD0;
     if(meanSqD < tol)
@@ -1022,27 +1004,19 @@ WlzAffineTransform *WlzAffineTransformLSqReg2D(WlzDVertex2 *vT,
       WLZ_VTX_2_SCALE(cen1, cen1, tD0);
       /* Compute the 2x2 matrix hM, which is the sum of tensor products of
        * the weighted vertices relative to their centroids. */
-      for(idN = 0; idN < nVtx; ++idN)
+      dat.cen0.d2 = cen0;
+      dat.cen1.d2 = cen1;
+      errNum = WlzAffineTransformLSqSums(WlzAffineTransformLSqAccCov2D, &dat,
+      					 nVtx, 4, hSums);
+      if(errNum == WLZ_ERR_NONE)
       {
-	if(vW)
-	{
-	  WLZ_VTX_2_SCALE(p0, *(vT + idN), *(vW + idN));
-	  WLZ_VTX_2_SCALE(p1, *(vS + idN), *(vW + idN));
-	}
-	else
-	{
-	  p0 = *(vT + idN);
-	  p1 = *(vS + idN);
-	}
-	WLZ_VTX_2_SUB(rel0, p0, cen0);
-	WLZ_VTX_2_SUB(rel1, p1, cen1);
-	hA[0][0] += rel0.vtX * rel1.vtX;
-	hA[0][1] += rel0.vtX * rel1.vtY;
-	hA[1][0] += rel0.vtY * rel1.vtX;
-	hA[1][1] += rel0.vtY * rel1.vtY;
+	hA[0][0] = hSums[0];
+	hA[0][1] = hSums[1];
+	hA[1][0] = hSums[2];
+	hA[1][1] = hSums[3];
+	/* Compute the SVD of the 2x2 matrix, hM = hM.wV.vM. */
+	errNum = WlzErrorFromAlg(AlgMatrixSVDecomp(hM, wV, vM));
       }
-      /* Compute the SVD of the 2x2 matrix, hM = hM.wV.vM. */
-      errNum = WlzErrorFromAlg(AlgMatrixSVDecomp(hM, wV, vM));
       if(errNum == WLZ_ERR_NONE)
       {
 	/* Compute 2x2 rotation matrix trA = vM'.hM, where vM' is the
@@ -1258,27 +1232,27 @@ WlzAffineTransform  *WlzAffineTransformLSqReg3D(WlzDVertex3 *vT,
 				WlzErrorNum *dstErr)
 {
   int		tI0,
-  		idN,
   		idK,
 		idR;
   double	tD0,
   		meanSqD;
-  WlzDVertex3	p0,
-  		p1,
-		cen0,
-  		cen1,
-		rel0,
-		rel1;
+  WlzDVertex3	cen0,
+  		cen1;
   double	*wV = NULL;
+  double	cSums[7],
+  		hSums[9];
   double	**hA,
 		**vA,
   		**trM = NULL;
   AlgMatrix	hM,
   		vM;
+  WlzAffineTransformLSqAccData dat;
   WlzAffineTransform *tr = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
   const double	tol = 1.0E-06;
 
+  WlzValueSetDouble(cSums, 0.0, 7);
+  WlzValueSetDouble(hSums, 0.0, 9);
   hM.core = vM.core = NULL;
   if(((hM.rect = AlgMatrixRectNew(3, 3, NULL)) == NULL) ||
      ((vM.rect = AlgMatrixRectNew(3, 3, NULL)) == NULL) ||
@@ -1293,37 +1267,21 @@ WlzAffineTransform  *WlzAffineTransformLSqReg3D(WlzDVertex3 *vT,
     vA = vM.rect->array;
     /* Compute weighted centroids (cen0 and cen1) and a mean of squares of
      * distance * between the weighted vertices. */
-    if(vW)
-    {
-      WLZ_VTX_3_SCALE(p0, *vT, *vW);
-      WLZ_VTX_3_SCALE(p1, *vS, *vW);
-    }
-    else
-    {
-      p0 = *vT;
-      p1 = *vS;
-    }
-    cen0 = p0;
-    cen1 = p1;
-    WLZ_VTX_3_SUB(rel0, p0, p1);
-    meanSqD = WLZ_VTX_3_DOT(rel0, rel0);
-    for(idN = 1; idN < nV; ++idN)
-    {
-      if(vW)
-      {
-	WLZ_VTX_3_SCALE(p0, *(vT + idN), *(vW + idN));
-	WLZ_VTX_3_SCALE(p1, *(vS + idN), *(vW + idN));
-      }
-      else
-      {
-        p0 = *(vT + idN);
-	p1 = *(vS + idN);
-      }
-      WLZ_VTX_3_ADD(cen0, cen0, p0);
-      WLZ_VTX_3_ADD(cen1, cen1, p1);
-      WLZ_VTX_3_SUB(rel0, p0, p1);
-      meanSqD += WLZ_VTX_3_DOT(rel0, rel0);
-    }
+    dat.vT.d3 = vT;
+    dat.vS.d3 = vS;
+    dat.vW = vW;
+    errNum = WlzAffineTransformLSqSums(WlzAffineTransformLSqAccCen3D, &dat,
+    				       nV, 7, cSums);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    cen0.vtX = cSums[0];
+    cen0.vtY = cSums[1];
+    cen0.vtZ = cSums[2];
+    cen1.vtX = cSums[3];
+    cen1.vtY = cSums[4];
+    cen1.vtZ = cSums[5];
+    meanSqD = cSums[6];
     tD0 = 1.0 / nV;
     meanSqD *= tD0;
     if(meanSqD < tol)
@@ -1337,32 +1295,24 @@ WlzAffineTransform  *WlzAffineTransformLSqReg3D(WlzDVertex3 *vT,
       WLZ_VTX_3_SCALE(cen1, cen1, tD0);
       /* Compute the 3x3 matrix hM, which is the sum of tensor products of
        * the weighted vertices relative to their centroids. */
-      for(idN = 0; idN < nV; ++idN)
+      dat.cen0.d3 = cen0;
+      dat.cen1.d3 = cen1;
+      errNum = WlzAffineTransformLSqSums(WlzAffineTransformLSqAccCov3D, &dat,
+      					 nV, 9, hSums);
+      if(errNum == WLZ_ERR_NONE)
       {
-	if(vW)
-	{
-	  WLZ_VTX_3_SCALE(p0, *(vT + idN), *(vW + idN));
-	  WLZ_VTX_3_SCALE(p1, *(vS + idN), *(vW + idN));
-	}
-	else
-	{
-	  p0 = *(vT + idN);
-	  p1 = *(vS + idN);
-	}
-	WLZ_VTX_3_SUB(rel0, p0, cen0);
-	WLZ_VTX_3_SUB(rel1, p1, cen1);
-	hA[0][0] += rel0.vtX * rel1.vtX;
-	hA[0][1] += rel0.vtX * rel1.vtY;
-	hA[0][2] += rel0.vtX * rel1.vtZ;
-	hA[1][0] += rel0.vtY * rel1.vtX;
-	hA[1][1] += rel0.vtY * rel1.vtY;
-	hA[1][2] += rel0.vtY * rel1.vtZ;
-	hA[2][0] += rel0.vtZ * rel1.vtX;
-	hA[2][1] += rel0.vtZ * rel1.vtY;
-	hA[2][2] += rel0.vtZ * rel1.vtZ;
+	hA[0][0] = hSums[0];
+	hA[0][1] = hSums[1];
+	hA[0][2] = hSums[2];
+	hA[1][0] = hSums[3];
+	hA[1][1] = hSums[4];
+	hA[1][2] = hSums[5];
+	hA[2][0] = hSums[6];
+	hA[2][1] = hSums[7];
+	hA[2][2] = hSums[8];
+	/* Compute the SVD of the 3x3 matrix, hM = hM.wV.vM. */
+	errNum = WlzErrorFromAlg(AlgMatrixSVDecomp(hM, wV, vM));
       }
-      /* Compute the SVD of the 3x3 matrix, hM = hM.wV.vM. */
-      errNum = WlzErrorFromAlg(AlgMatrixSVDecomp(hM, wV, vM));
       if(errNum == WLZ_ERR_NONE)
       {
 	/* Compute 3x3 rotation matrix trM = vM'.hM, where vM' is the
@@ -2103,6 +2053,448 @@ WlzAffineTransform *WlzAffineTransformLSqDQ3D(int nV, double *vW,
   return(trans);
 }
 
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzTransform
+* \brief	Accumulates the sums required by one of the least squares
+*		functions over all the vertex pairs. The vertex pairs
+*		are split into blocks of WLZ_AFFINETRANSFORMLSQ_BLKSZ
+*		which are accumulated in parallel and then the block
+*		sums are added in block order, so that the result is the
+*		same whatever the number of threads. When there is only
+*		a single block the sums are accumulated directly.
+* \param	fn			Accumulation function.
+* \param	dat			Data for the accumulation function.
+* \param	nV			Number of vertex pairs.
+* \param	nSum			Number of sums.
+* \param	sums			Array of sums which are added to.
+*/
+static WlzErrorNum WlzAffineTransformLSqSums(WlzAffineTransformLSqAccFn fn,
+					WlzAffineTransformLSqAccData *dat,
+					int nV, int nSum, double *sums)
+{
+  int		idB,
+  		idS,
+  		nBlk;
+  double	*bSums = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nBlk = (nV + WLZ_AFFINETRANSFORMLSQ_BLKSZ - 1) /
+         WLZ_AFFINETRANSFORMLSQ_BLKSZ;
+  if(nBlk <= 1)
+  {
+    (*fn)(dat, 0, nV, sums);
+  }
+  else if((bSums = (double *)AlcCalloc(nBlk * nSum,
+  				       sizeof(double))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(idB = 0; idB < nBlk; ++idB)
+    {
+      int	i0,
+      		i1;
+
+      i0 = idB * WLZ_AFFINETRANSFORMLSQ_BLKSZ;
+      i1 = WLZ_MIN(i0 + WLZ_AFFINETRANSFORMLSQ_BLKSZ, nV);
+      (*fn)(dat, i0, i1, bSums + (idB * nSum));
+    }
+    for(idB = 0; idB < nBlk; ++idB)
+    {
+      for(idS = 0; idS < nSum; ++idS)
+      {
+        sums[idS] += bSums[(idB * nSum) + idS];
+      }
+    }
+    AlcFree(bSums);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzTransform
+* \brief	Accumulates the sums for WlzAffineTransformLSqGen2D().
+*		If there are no weights the sum of the weights (index 5)
+*		is not accumulated.
+* \param	dat			Accumulation data.
+* \param	i0			First vertex pair.
+* \param	i1			One past the last vertex pair.
+* \param	sums			Array of 12 sums.
+*/
+static void	WlzAffineTransformLSqAccGen2D(
+				WlzAffineTransformLSqAccData *dat,
+				int i0, int i1, double *sums)
+{
+  int		idx,
+  		idS;
+  double	s[12];
+  double	wSq;
+  double	*vW;
+  WlzDVertex2	*vT,
+  		*vS;
+
+  for(idS = 0; idS < 12; ++idS)
+  {
+    s[idS] = 0.0;
+  }
+  vT = dat->vT.d2;
+  vS = dat->vS.d2;
+  vW = dat->vW;
+  if(vW)
+  {
+    for(idx = i0; idx < i1; ++idx)
+    {
+      wSq = vW[idx] * vW[idx];
+      s[0]  += vS[idx].vtX * vS[idx].vtX * wSq;
+      s[1]  += vS[idx].vtX * vS[idx].vtY * wSq;
+      s[2]  += vS[idx].vtX * wSq;
+      s[3]  += vS[idx].vtY * vS[idx].vtY * wSq;
+      s[4]  += vS[idx].vtY * wSq;
+      s[5]  += wSq;
+      s[6]  += vS[idx].vtX * vT[idx].vtX * wSq;
+      s[7]  += vS[idx].vtY * vT[idx].vtX * wSq;
+      s[8]  += vT[idx].vtX * wSq;
+      s[9]  += vS[idx].vtX * vT[idx].vtY * wSq;
+      s[10] += vS[idx].vtY * vT[idx].vtY * wSq;
+      s[11] += vT[idx].vtY * wSq;
+    }
+  }
+  else
+  {
+    for(idx = i0; idx < i1; ++idx)
+    {
+      s[0]  += vS[idx].vtX * vS[idx].vtX;
+      s[1]  += vS[idx].vtX * vS[idx].vtY;
+      s[2]  += vS[idx].vtX;
+      s[3]  += vS[idx].vtY * vS[idx].vtY;
+      s[4]  += vS[idx].vtY;
+      s[6]  += vS[idx].vtX * vT[idx].vtX;
+      s[7]  += vS[idx].vtY * vT[idx].vtX;
+      s[8]  += vT[idx].vtX;
+      s[9]  += vS[idx].vtX * vT[idx].vtY;
+      s[10] += vS[idx].vtY * vT[idx].vtY;
+      s[11] += vT[idx].vtY;
+    }
+  }
+  for(idS = 0; idS < 12; ++idS)
+  {
+    sums[idS] += s[idS];
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzTransform
+* \brief	Accumulates the sums for WlzAffineTransformLSqGen3D().
+*		If there are no weights the sum of the weights (index 9)
+*		is not accumulated.
+* \param	dat			Accumulation data.
+* \param	i0			First vertex pair.
+* \param	i1			One past the last vertex pair.
+* \param	sums			Array of 22 sums.
+*/
+static void	WlzAffineTransformLSqAccGen3D(
+				WlzAffineTransformLSqAccData *dat,
+				int i0, int i1, double *sums)
+{
+  int		idx,
+  		idS;
+  double	s[22];
+  double	wSq;
+  double	*vW;
+  WlzDVertex3	*vT,
+  		*vS;
+
+  for(idS = 0; idS < 22; ++idS)
+  {
+    s[idS] = 0.0;
+  }
+  vT = dat->vT.d3;
+  vS = dat->vS.d3;
+  vW = dat->vW;
+  if(vW)
+  {
+    for(idx = i0; idx < i1; ++idx)
+    {
+      wSq = vW[idx] * vW[idx];
+      s[0]  += vS[idx].vtX * vS[idx].vtX * wSq;
+      s[1]  += vS[idx].vtX * vS[idx].vtY * wSq;
+      s[2]  += vS[idx].vtX * vS[idx].vtZ * wSq;
+      s[3]  += vS[idx].vtX * wSq;
+      s[4]  += vS[idx].vtY * vS[idx].vtY * wSq;
+      s[5]  += vS[idx].vtY * vS[idx].vtZ * wSq;
+      s[6]  += vS[idx].vtY * wSq;
+      s[7]  += vS[idx].vtZ * vS[idx].vtZ * wSq;
+      s[8]  += vS[idx].vtZ * wSq;
+      s[9]  += wSq;
+      s[10] += vS[idx].vtX * vT[idx].vtX * wSq;
+      s[11] += vS[idx].vtY * vT[idx].vtX * wSq;
+      s[12] += vS[idx].vtZ * vT[idx].vtX * wSq;
+      s[13] += vT[idx].vtX * wSq;
+      s[14] += vS[idx].vtX * vT[idx].vtY * wSq;
+      s[15] += vS[idx].vtY * vT[idx].vtY * wSq;
+      s[16] += vS[idx].vtZ * vT[idx].vtY * wSq;
+      s[17] += vT[idx].vtY * wSq;
+      s[18] += vS[idx].vtX * vT[idx].vtZ * wSq;
+      s[19] += vS[idx].vtY * vT[idx].vtZ * wSq;
+      s[20] += vS[idx].vtZ * vT[idx].vtZ * wSq;
+      s[21] += vT[idx].vtZ * wSq;
+    }
+  }
+  else
+  {
+    for(idx = i0; idx < i1; ++idx)
+    {
+      s[0]  += vS[idx].vtX * vS[idx].vtX;
+      s[1]  += vS[idx].vtX * vS[idx].vtY;
+      s[2]  += vS[idx].vtX * vS[idx].vtZ;
+      s[3]  += vS[idx].vtX;
+      s[4]  += vS[idx].vtY * vS[idx].vtY;
+      s[5]  += vS[idx].vtY * vS[idx].vtZ;
+      s[6]  += vS[idx].vtY;
+      s[7]  += vS[idx].vtZ * vS[idx].vtZ;
+      s[8]  += vS[idx].vtZ;
+      s[10] += vS[idx].vtX * vT[idx].vtX;
+      s[11] += vS[idx].vtY * vT[idx].vtX;
+      s[12] += vS[idx].vtZ * vT[idx].vtX;
+      s[13] += vT[idx].vtX;
+      s[14] += vS[idx].vtX * vT[idx].vtY;
+      s[15] += vS[idx].vtY * vT[idx].vtY;
+      s[16] += vS[idx].vtZ * vT[idx].vtY;
+      s[17] += vT[idx].vtY;
+      s[18] += vS[idx].vtX * vT[idx].vtZ;
+      s[19] += vS[idx].vtY * vT[idx].vtZ;
+      s[20] += vS[idx].vtZ * vT[idx].vtZ;
+      s[21] += vT[idx].vtZ;
+    }
+  }
+  for(idS = 0; idS < 22; ++idS)
+  {
+    sums[idS] += s[idS];
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzTransform
+* \brief	Accumulates the sums of the weighted 2D target and source
+*		vertices (indices 0-1 and 2-3) and the sum of squared
+*		distances between them (index 4) for
+*		WlzAffineTransformLSqReg2D().
+* \param	dat			Accumulation data.
+* \param	i0			First vertex pair.
+* \param	i1			One past the last vertex pair.
+* \param	sums			Array of 5 sums.
+*/
+static void	WlzAffineTransformLSqAccCen2D(
+				WlzAffineTransformLSqAccData *dat,
+				int i0, int i1, double *sums)
+{
+  int		idN,
+  		idS;
+  double	s[5];
+  WlzDVertex2	p0,
+  		p1,
+		rel0;
+
+  for(idS = 0; idS < 5; ++idS)
+  {
+    s[idS] = 0.0;
+  }
+  for(idN = i0; idN < i1; ++idN)
+  {
+    if(dat->vW)
+    {
+      WLZ_VTX_2_SCALE(p0, *(dat->vT.d2 + idN), *(dat->vW + idN));
+      WLZ_VTX_2_SCALE(p1, *(dat->vS.d2 + idN), *(dat->vW + idN));
+    }
+    else
+    {
+      p0 = *(dat->vT.d2 + idN);
+      p1 = *(dat->vS.d2 + idN);
+    }
+    s[0] += p0.vtX;
+    s[1] += p0.vtY;
+    s[2] += p1.vtX;
+    s[3] += p1.vtY;
+    WLZ_VTX_2_SUB(rel0, p0, p1);
+    s[4] += WLZ_VTX_2_DOT(rel0, rel0);
+  }
+  for(idS = 0; idS < 5; ++idS)
+  {
+    sums[idS] += s[idS];
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzTransform
+* \brief	Accumulates the sums of the weighted 3D target and source
+*		vertices (indices 0-2 and 3-5) and the sum of squared
+*		distances between them (index 6) for
+*		WlzAffineTransformLSqReg3D().
+* \param	dat			Accumulation data.
+* \param	i0			First vertex pair.
+* \param	i1			One past the last vertex pair.
+* \param	sums			Array of 7 sums.
+*/
+static void	WlzAffineTransformLSqAccCen3D(
+				WlzAffineTransformLSqAccData *dat,
+				int i0, int i1, double *sums)
+{
+  int		idN,
+  		idS;
+  double	s[7];
+  WlzDVertex3	p0,
+  		p1,
+		rel0;
+
+  for(idS = 0; idS < 7; ++idS)
+  {
+    s[idS] = 0.0;
+  }
+  for(idN = i0; idN < i1; ++idN)
+  {
+    if(dat->vW)
+    {
+      WLZ_VTX_3_SCALE(p0, *(dat->vT.d3 + idN), *(dat->vW + idN));
+      WLZ_VTX_3_SCALE(p1, *(dat->vS.d3 + idN), *(dat->vW + idN));
+    }
+    else
+    {
+      p0 = *(dat->vT.d3 + idN);
+      p1 = *(dat->vS.d3 + idN);
+    }
+    s[0] += p0.vtX;
+    s[1] += p0.vtY;
+    s[2] += p0.vtZ;
+    s[3] += p1.vtX;
+    s[4] += p1.vtY;
+    s[5] += p1.vtZ;
+    WLZ_VTX_3_SUB(rel0, p0, p1);
+    s[6] += WLZ_VTX_3_DOT(rel0, rel0);
+  }
+  for(idS = 0; idS < 7; ++idS)
+  {
+    sums[idS] += s[idS];
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzTransform
+* \brief	Accumulates the 2x2 cross-covariance matrix (row major)
+*		of the weighted 2D target and source vertices relative
+*		to their centroids for WlzAffineTransformLSqReg2D().
+* \param	dat			Accumulation data with centroids.
+* \param	i0			First vertex pair.
+* \param	i1			One past the last vertex pair.
+* \param	sums			Array of 4 sums.
+*/
+static void	WlzAffineTransformLSqAccCov2D(
+				WlzAffineTransformLSqAccData *dat,
+				int i0, int i1, double *sums)
+{
+  int		idN,
+  		idS;
+  double	s[4];
+  WlzDVertex2	p0,
+  		p1,
+		rel0,
+		rel1;
+
+  for(idS = 0; idS < 4; ++idS)
+  {
+    s[idS] = 0.0;
+  }
+  for(idN = i0; idN < i1; ++idN)
+  {
+    if(dat->vW)
+    {
+      WLZ_VTX_2_SCALE(p0, *(dat->vT.d2 + idN), *(dat->vW + idN));
+      WLZ_VTX_2_SCALE(p1, *(dat->vS.d2 + idN), *(dat->vW + idN));
+    }
+    else
+    {
+      p0 = *(dat->vT.d2 + idN);
+      p1 = *(dat->vS.d2 + idN);
+    }
+    WLZ_VTX_2_SUB(rel0, p0, dat->cen0.d2);
+    WLZ_VTX_2_SUB(rel1, p1, dat->cen1.d2);
+    s[0] += rel0.vtX * rel1.vtX;
+    s[1] += rel0.vtX * rel1.vtY;
+    s[2] += rel0.vtY * rel1.vtX;
+    s[3] += rel0.vtY * rel1.vtY;
+  }
+  for(idS = 0; idS < 4; ++idS)
+  {
+    sums[idS] += s[idS];
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzTransform
+* \brief	Accumulates the 3x3 cross-covariance matrix (row major)
+*		of the weighted 3D target and source vertices relative
+*		to their centroids for WlzAffineTransformLSqReg3D().
+* \param	dat			Accumulation data with centroids.
+* \param	i0			First vertex pair.
+* \param	i1			One past the last vertex pair.
+* \param	sums			Array of 9 sums.
+*/
+static void	WlzAffineTransformLSqAccCov3D(
+				WlzAffineTransformLSqAccData *dat,
+				int i0, int i1, double *sums)
+{
+  int		idN,
+  		idS;
+  double	s[9];
+  WlzDVertex3	p0,
+  		p1,
+		rel0,
+		rel1;
+
+  for(idS = 0; idS < 9; ++idS)
+  {
+    s[idS] = 0.0;
+  }
+  for(idN = i0; idN < i1; ++idN)
+  {
+    if(dat->vW)
+    {
+      WLZ_VTX_3_SCALE(p0, *(dat->vT.d3 + idN), *(dat->vW + idN));
+      WLZ_VTX_3_SCALE(p1, *(dat->vS.d3 + idN), *(dat->vW + idN));
+    }
+    else
+    {
+      p0 = *(dat->vT.d3 + idN);
+      p1 = *(dat->vS.d3 + idN);
+    }
+    WLZ_VTX_3_SUB(rel0, p0, dat->cen0.d3);
+    WLZ_VTX_3_SUB(rel1, p1, dat->cen1.d3);
+    s[0] += rel0.vtX * rel1.vtX;
+    s[1] += rel0.vtX * rel1.vtY;
+    s[2] += rel0.vtX * rel1.vtZ;
+    s[3] += rel0.vtY * rel1.vtX;
+    s[4] += rel0.vtY * rel1.vtY;
+    s[5] += rel0.vtY * rel1.vtZ;
+    s[6] += rel0.vtZ * rel1.vtX;
+    s[7] += rel0.vtZ * rel1.vtY;
+    s[8] += rel0.vtZ * rel1.vtZ;
+  }
+  for(idS = 0; idS < 9; ++idS)
+  {
+    sums[idS] += s[idS];
+  }
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzTransform
@@ -39,11 +39,30 @@ static char _WlzAssign_c[] = "University of Edinburgh $Id$";
 * 		which records it's usage by other objects, domains or
 * 		values. To increment a linkcount the appropriate assignment
 * 		function should be used.
+*
+* 		Linkcounts are incremented and decremented using lock
+* 		free atomic compare and swap operations so that objects,
+* 		domains and values may be shared, assigned and freed by
+* 		many threads at once. C11 atomics are used when they are
+* 		available, otherwise the GCC atomic builtins and as a last
+* 		resort an OpenMP critical section.
 * \ingroup	WlzAllocation
 */
 
 #include <Wlz.h>
 
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && \
+    !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define WLZ_LINKCOUNT_C11_ATOMIC
+#elif defined(__GNUC__)
+#define WLZ_LINKCOUNT_GCC_ATOMIC
+#endif
+
+static int			WlzLinkcountUpdate(
+				  int *linkcount,
+				  int inc);
+
 /*!
 * \return	Given object with incremented linkcount or NULL on error.
 * \ingroup	WlzAllocation
@@ -61,17 +80,9 @@ WlzObject	*WlzAssignObject(WlzObject *obj, WlzErrorNum *dstErr)
 
   if(obj)
   {
-    if(obj->linkcount < 0)
-    {
-      errNum = WLZ_ERR_LINKCOUNT_DATA;
-    }
-    else
+    if(WlzLink(&(obj->linkcount), &errNum))
     {
       rtnObj = obj;
-#ifdef _OPENMP
-#pragma omp atomic
-#endif
-      obj->linkcount++;
     }
   }
 #ifdef WLZ_NO_NULL
@@ -102,17 +113,9 @@ WlzDomain 	WlzAssignDomain(WlzDomain domain, WlzErrorNum *dstErr)
   rtnDomain.core = NULL;
   if(domain.core)
   {
-    if(domain.core->linkcount < 0)
-    {
-      errNum = WLZ_ERR_LINKCOUNT_DATA;
-    }
-    else
+    if(WlzLink(&(domain.core->linkcount), &errNum))
     {
       rtnDomain = domain;
-#ifdef _OPENMP
-#pragma omp atomic
-#endif
-      domain.core->linkcount++;
     }
   }
 #ifdef WLZ_NO_NULL
@@ -143,17 +146,9 @@ WlzValues 	WlzAssignValues(WlzValues values, WlzErrorNum	*dstErr)
   rtnValues.core = NULL;
   if(values.core)
   {
-    if(values.core->linkcount < 0)
-    {
-      errNum = WLZ_ERR_LINKCOUNT_DATA;
-    }
-    else
+    if(WlzLink(&(values.core->linkcount), &errNum))
     {
       rtnValues = values;
-#ifdef _OPENMP
-#pragma omp atomic
-#endif
-      values.core->linkcount++;
     }
   }
 #ifdef WLZ_NO_NULL
@@ -185,17 +180,9 @@ WlzProperty WlzAssignProperty(WlzProperty property, WlzErrorNum *dstErr)
   rtnProp.core = NULL;
   if(property.core)
   {
-    if(property.core->linkcount < 0)
-    {
-      errNum = WLZ_ERR_LINKCOUNT_DATA;
-    }
-    else
+    if(WlzLink(&(property.core->linkcount), &errNum))
     {
       rtnProp = property;
-#ifdef _OPENMP
-#pragma omp atomic
-#endif
-      property.core->linkcount++;
     }
   }
 #ifdef WLZ_NO_NULL
@@ -226,17 +213,9 @@ WlzPropertyList *WlzAssignPropertyList(WlzPropertyList *pList,
 
   if(pList)
   {
-    if(pList->linkcount < 0)
-    {
-      errNum = WLZ_ERR_LINKCOUNT_DATA;
-    }
-    else
+    if(WlzLink(&(pList->linkcount), &errNum))
     {
       rtnPList = pList;
-#ifdef _OPENMP
-#pragma omp atomic
-#endif
-      pList->linkcount++;
     }
   }
 #ifdef WLZ_NO_NULL
@@ -269,17 +248,9 @@ WlzAffineTransform *WlzAssignAffineTransform(
 
   if(trans)
   {
-    if(trans->linkcount < 0)
-    {
-      errNum = WLZ_ERR_LINKCOUNT_DATA;
-    }
-    else
+    if(WlzLink(&(trans->linkcount), &errNum))
     {
       rtnTrans = trans;
-#ifdef _OPENMP
-#pragma omp atomic
-#endif
-      ++(trans->linkcount);
     }
   }
 #ifdef WLZ_NO_NULL
@@ -311,16 +282,8 @@ WlzTransform 	WlzAssignTransform(WlzTransform t, WlzErrorNum *dstErr)
   tR.core = NULL;
   if(t.core)
   {
-    if(t.core->linkcount < 0)
+    if(WlzLink(&(t.core->linkcount), &errNum))
     {
-      errNum = WLZ_ERR_LINKCOUNT_DATA;
-    }
-    else
-    {
-#ifdef _OPENMP
-#pragma omp atomic
-#endif
-      ++(t.core->linkcount);
       tR = t;
     }
   }
@@ -348,17 +311,9 @@ WlzThreeDViewStruct *WlzAssign3DViewStruct(
 
   if( viewStr )
   {
-    if(viewStr->linkcount < 0)
-    {
-      errNum = WLZ_ERR_LINKCOUNT_DATA;
-    }
-    else
+    if(WlzLink(&(viewStr->linkcount), &errNum))
     {
       rtnViewStr = viewStr;
-#ifdef _OPENMP
-#pragma omp atomic
-#endif
-      ++(viewStr->linkcount);
     }
   }
 #ifdef WLZ_NO_NULL
@@ -389,17 +344,9 @@ WlzBoundList 	*WlzAssignBoundList(WlzBoundList *blist, WlzErrorNum *dstErr)
 
   if(blist)
   {
-    if(blist->linkcount < 0)
-    {
-      errNum = WLZ_ERR_LINKCOUNT_DATA;
-    }
-    else
+    if(WlzLink(&(blist->linkcount), &errNum))
     {
       rtnBlist = blist;
-#ifdef _OPENMP
-#pragma omp atomic
-#endif
-      ++(blist->linkcount);
     }
   }
 #ifdef WLZ_NO_NULL
@@ -432,17 +379,9 @@ WlzPolygonDomain *WlzAssignPolygonDomain(
 
   if(poly)
   {
-    if(poly->linkcount < 0)
-    {
-      errNum = WLZ_ERR_LINKCOUNT_DATA;
-    }
-    else
+    if(WlzLink(&(poly->linkcount), &errNum))
     {
       rtnPoly = poly;
-#ifdef _OPENMP
-#pragma omp atomic
-#endif
-      ++(poly->linkcount);
     }
   }
 #ifdef WLZ_NO_NULL
@@ -473,31 +412,58 @@ WlzGMModel 	*WlzAssignGMModel(WlzGMModel *model, WlzErrorNum *dstErr)
 
   if(model)
   {
-    if(model->linkcount < 0)
+    if(WlzLink(&(model->linkcount), &errNum))
+    {
+      rtnModel = model;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rtnModel);
+}
+
+/*!
+* \return	Non-zero if the linkcount was incremented.
+* \ingroup      WlzAllocation
+* \brief	Link an object, domain or values by atomically incrementing
+* 		it's linkcount, provided that the linkcount is not negative
+* 		(ie it has not been free'd).
+* \param	linkcount		Given linkcount pointer.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+int		WlzLink(int *linkcount, WlzErrorNum *dstErr)
+{
+  int		linked = 0;
+  WlzErrorNum	errNum = WLZ_ERR_PARAM_NULL;
+
+  if(linkcount)
+  {
+    if(WlzLinkcountUpdate(linkcount, 1) < 0)
     {
       errNum = WLZ_ERR_LINKCOUNT_DATA;
     }
     else
     {
-      rtnModel = model;
-#ifdef _OPENMP
-#pragma omp atomic
-#endif
-      ++(model->linkcount);
+      errNum = WLZ_ERR_NONE;
+      linked = 1;
     }
   }
   if(dstErr)
   {
     *dstErr = errNum;
   }
-  return(rtnModel);
+  return(linked);
 }
 
 /*!
 * \return	Non-zero if object can be free'd.
 * \ingroup      WlzAllocation
-* \brief	Unlink an object, domain or values by decrementing
-*		and testing it's linkcount.
+* \brief	Unlink an object, domain or values by atomically
+* 		decrementing and testing it's linkcount. When the
+* 		linkcount reaches zero it is set to -1 so that only the
+* 		caller which unlinks last can free the object.
 * \param	linkcount		Given linkcount pointer.
 * \param	dstErr			Destination error pointer, may be NULL.
 */
@@ -508,26 +474,19 @@ int		WlzUnlink(int *linkcount, WlzErrorNum *dstErr)
 
   if(linkcount)
   {
-#ifdef _OPENMP
-#pragma omp critical (WlzLinkcount)
+    switch(WlzLinkcountUpdate(linkcount, -1))
     {
-#endif
-      if(*linkcount < 0)
-      {
+      case -1:
 	errNum = WLZ_ERR_LINKCOUNT_DATA;
-      }
-      else
-      {
+	break;
+      case 0:
 	errNum = WLZ_ERR_NONE;
-	  if(--*linkcount <= 0)
-	  {
-	    *linkcount = -1;
-	    canFree = 1;
-	  }
-      }
-#ifdef _OPENMP
+	canFree = 1;
+	break;
+      default:
+	errNum = WLZ_ERR_NONE;
+	break;
     }
-#endif
   }
   if(dstErr)
   {
@@ -535,3 +494,66 @@ int		WlzUnlink(int *linkcount, WlzErrorNum *dstErr)
   }
   return(canFree);
 }
+
+/*!
+* \return	New linkcount, zero if the linkcount has been decremented
+* 		to zero (in which case it is set to -1) or -1 if the
+* 		linkcount was negative and has not been changed.
+* \ingroup      WlzAllocation
+* \brief	Atomically increments or decrements the given linkcount
+* 		unless it is negative. The increment is relaxed since a
+* 		caller must already hold a link, but the decrement
+* 		has acquire and release semantics so that all accesses
+* 		made through other links happen before the object is
+* 		free'd.
+* \param	linkcount		Given linkcount pointer.
+* \param	inc			Increment, either 1 or -1.
+*/
+static int	WlzLinkcountUpdate(int *linkcount, int inc)
+{
+  int		cnt,
+  		newCnt = -1;
+
+#if defined(WLZ_LINKCOUNT_C11_ATOMIC)
+  atomic_int	*aLC;
+
+  aLC = (atomic_int *)linkcount;
+  cnt = atomic_load_explicit(aLC, memory_order_relaxed);
+  while((cnt >= 0) &&
+        !atomic_compare_exchange_weak_explicit(aLC, &cnt,
+		((cnt + inc) > 0)? cnt + inc: -1,
+		(inc > 0)? memory_order_relaxed: memory_order_acq_rel,
+		memory_order_relaxed))
+  {
+    /* Retry with the current linkcount. */
+  }
+#elif defined(WLZ_LINKCOUNT_GCC_ATOMIC)
+  cnt = __atomic_load_n(linkcount, __ATOMIC_RELAXED);
+  while((cnt >= 0) &&
+        !__atomic_compare_exchange_n(linkcount, &cnt,
+		((cnt + inc) > 0)? cnt + inc: -1, 1,
+		(inc > 0)? __ATOMIC_RELAXED: __ATOMIC_ACQ_REL,
+		__ATOMIC_RELAXED))
+  {
+    /* Retry with the current linkcount. */
+  }
+#else
+#ifdef _OPENMP
+#pragma omp critical (WlzLinkcount)
+  {
+#endif
+    cnt = *linkcount;
+    if(cnt >= 0)
+    {
+      *linkcount = ((cnt + inc) > 0)? cnt + inc: -1;
+    }
+#ifdef _OPENMP
+  }
+#endif
+#endif
+  if(cnt >= 0)
+  {
+    newCnt = ((cnt + inc) > 0)? cnt + inc: 0;
+  }
+  return(newCnt);
+}
@@ -45,8 +45,22 @@ static char _WlzContour_c[] = "University of Edinburgh $Id$";
 #include <string.h>
 #include <Wlz.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #define WLZ_CTR_TOLERANCE	(1.0e-06)
 
+/*!
+* \def		WLZ_CONTOUR_SLAB_MIN
+* \ingroup	WlzContour
+* \brief	Minimum number of planes in each of the z-slabs which
+*		are contoured in parallel. Objects with too few planes
+*		to give at least two slabs are contoured by a single
+*		thread.
+*/
+#define WLZ_CONTOUR_SLAB_MIN	(8)
+
 /* #define WLZ_CONTOUR_DEBUG */
 
 /*!
@@ -82,6 +96,92 @@ typedef enum _WlzContourBndSamMethod
   WLZ_CONTOUR_BNDPTS_RANDOM
 } WlzContourBndSamMethod;
 
+/*!
+* \struct	_WlzContourSpxBuf3D
+* \ingroup	WlzContour
+* \brief	Buffer of 3D simplices (triangles) computed for a z-slab
+* 		of an object. The simplices are held in the order in
+* 		which they were computed so that adding them to a model
+* 		gives the same model as adding them directly.
+*		Typedef: ::WlzContourSpxBuf3D.
+*/
+typedef struct _WlzContourSpxBuf3D
+{
+  int		nSpx;			/*!< Number of simplices. */
+  int		maxSpx;			/*!< Number of simplices space has
+  					     been allocated for. */
+  int		useKey;			/*!< Non-zero if simplex vertex keys
+  					     are to be kept. */
+  WlzDVertex3	*vtx;			/*!< Simplex vertices, three per
+  					     simplex. */
+  WlzIVertex3	*key;			/*!< Simplex vertex keys, the two
+  					     lattice points at the ends of
+					     the side on which the vertex
+					     lies, six per simplex. */
+} WlzContourSpxBuf3D;
+
+/*!
+* \struct	_WlzContourIdxMeshWSp3D
+* \ingroup	WlzContour
+* \brief	Workspace for building an indexed triangle mesh from
+* 		keyed simplices. Vertices are merged using an open
+* 		addressing hash table of their keys, so that all the
+* 		simplices with a vertex on the same side of the lattice
+* 		share it. A second hash table of the triangles' sorted
+* 		vertex indices is used to reject repeated triangles.
+*		Typedef: ::WlzContourIdxMeshWSp3D.
+*/
+typedef struct _WlzContourIdxMeshWSp3D
+{
+  WlzIdxMesh3D	*mesh;			/*!< Mesh being built. */
+  int		htSz;			/*!< Number of hash table slots,
+  					     always a power of two. */
+  int		*htTbl;			/*!< Hash table of vertex indices,
+  					     empty slots are -1. */
+  WlzIVertex3	*vtxKey;		/*!< Vertex keys, two per mesh
+  					     vertex. */
+  int		triHtSz;		/*!< Number of triangle hash table
+  					     slots, always a power of two. */
+  int		*triHtTbl;		/*!< Hash table of triangle indices,
+  					     empty slots are -1. */
+} WlzContourIdxMeshWSp3D;
+
+/*!
+* \struct	_WlzContourSlabData3D
+* \ingroup	WlzContour
+* \brief	Data shared by all the z-slabs of a 3D object which is
+* 		being contoured.
+*		Typedef: ::WlzContourSlabData3D.
+*/
+typedef struct _WlzContourSlabData3D
+{
+  WlzObject	*srcObj;		/*!< Given object. */
+  WlzObject	*zObj;			/*!< Partial derivatives through the
+  					     planes, only used for maximal
+					     gradient contours. */
+  WlzRsvFilter	*ftr;			/*!< Derivative filter, only used for
+  					     maximal gradient contours. */
+  double	ctrVal;			/*!< Iso-value or the square of the
+  					     minimum gradient. */
+  WlzIBox3	bBox;			/*!< Bounding box of the given
+  					     object. */
+} WlzContourSlabData3D;
+
+/*!
+* \typedef	WlzContourSlabFn3D
+* \ingroup	WlzContour
+* \brief	Function which contours the z-slab of planes with
+* 		indices pn0 to pn1 (relative to the first plane of
+* 		the object) either directly into the contour's model
+* 		or into the given simplex buffer if it is not NULL.
+*/
+typedef WlzErrorNum	(*WlzContourSlabFn3D)(
+			  WlzContour *ctr,
+			  WlzContourSpxBuf3D *spxBuf,
+			  WlzContourSlabData3D *data,
+			  int pn0,
+			  int pn1);
+
 static WlzContour	*WlzContourIsoObj2D(
 			  WlzObject *srcObj,
 			  double isoVal,
@@ -97,6 +197,54 @@ static WlzContour 	*WlzContourGrdObj3D(
 			  double ftrPrm,
 			  int nrmFlg,
 			  WlzErrorNum *dstErr);
+static WlzErrorNum	WlzContourIsoSlab3D(
+			  WlzContour *ctr,
+			  WlzContourSpxBuf3D *spxBuf,
+			  WlzContourSlabData3D *data,
+			  int pn0,
+			  int pn1);
+static WlzErrorNum	WlzContourGrdSlab3D(
+			  WlzContour *ctr,
+			  WlzContourSpxBuf3D *spxBuf,
+			  WlzContourSlabData3D *data,
+			  int pn0,
+			  int pn1);
+static WlzErrorNum	WlzContourSlabs3D(
+			  WlzContour *ctr,
+			  WlzContourIdxMeshWSp3D *idxWSp,
+			  WlzContourSlabFn3D slabFn,
+			  WlzContourSlabData3D *data,
+			  int pnFst,
+			  int pnLst);
+static WlzErrorNum	WlzContourSpx3DAdd(
+			  WlzContour *ctr,
+			  WlzContourSpxBuf3D *spxBuf,
+			  WlzDVertex3 *spx,
+			  WlzIVertex3 *key);
+static WlzErrorNum	WlzContourIdxMeshAdd3D(
+			  WlzContourIdxMeshWSp3D *wSp,
+			  WlzDVertex3 *spx,
+			  WlzIVertex3 *key);
+static int		WlzContourIdxMeshVtx3D(
+			  WlzContourIdxMeshWSp3D *wSp,
+			  WlzDVertex3 pos,
+			  WlzIVertex3 *key,
+			  WlzErrorNum *dstErr);
+static unsigned int	WlzContourKeyHash(
+			  WlzIVertex3 *key);
+static unsigned int	WlzContourTriHash(
+			  int *vIdx);
+static void		WlzContourTriSort(
+			  int *dst,
+			  int *vIdx);
+static void		WlzContourIsoTetIsn(
+			  WlzDVertex3 *tIsn,
+			  int *tSd,
+			  double *tVal,
+			  WlzDVertex3 *tPos,
+			  int idx,
+			  int v0,
+			  int v1);
 static WlzContour 	*WlzContourBndObj2D(
 			  WlzObject *obj,
 			  WlzErrorNum *dstErr);
@@ -204,6 +352,8 @@ static WlzErrorNum	WlzContourIsoCube2D(
 			  WlzDVertex2 sqOrg);
 static WlzErrorNum 	WlzContourGrdCube3D(
 			  WlzContour *ctr,
+			  WlzContourSpxBuf3D *spxBuf,
+			  int lnkFlg,
 			  WlzUByte ***mBuf,
 			  double ***zBuf,
 			  double ***yBuf,
@@ -212,6 +362,7 @@ static WlzErrorNum 	WlzContourGrdCube3D(
 			  WlzIVertex3 bufPos,
 			  WlzIVertex3 cbOrg);
 static WlzErrorNum	WlzContourIsoCube3D6T(WlzContour *ctr,
+			  WlzContourSpxBuf3D *spxBuf,
 			  double isoVal,
 			  double *pn0ln0,
 			  double *pn0ln1,
@@ -220,6 +371,7 @@ static WlzErrorNum	WlzContourIsoCube3D6T(WlzContour *ctr,
 			  WlzDVertex3 cbOrg);
 static WlzErrorNum	WlzContourIsoTet3D(
 			  WlzContour *ctr,
+			  WlzContourSpxBuf3D *spxBuf,
 			  double *tVal,
 			  WlzDVertex3 *tPos,
 			  WlzDVertex3 cbOrg);
@@ -235,6 +387,7 @@ static WlzErrorNum	WlzContourGrdLink2D(
 			  double **grdYBuf);
 static WlzErrorNum	WlzContourGrdLink3D(
 			  WlzContour *ctr,
+			  WlzContourSpxBuf3D *spxBuf,
 			  WlzUByte ***mBuf,
 			  int *bufIdx,
 			  WlzIVertex3 bufPos,
@@ -332,6 +485,9 @@ WlzContour	*WlzContourObjGrd(WlzObject *srcObj,
 *               The contour width parameter is only used for maximal
 *               gradient contours where it is used to generate a
 *               recursive Deriche filter, see WlzRsvFilter().
+*		3D iso-value and maximal gradient contours are computed
+*		in parallel z-slabs when OpenMP threads are available,
+*		giving the same model as a single thread would.
 * \param	srcObj			Given object from which to
 *                                       compute the contours.
 * \param	ctrMtd			Contour generation method.
@@ -453,6 +609,123 @@ WlzContour	*WlzContourObj(WlzObject *srcObj, WlzContourMethod ctrMtd,
   return(ctr);
 }
 
+/*!
+* \return	New indexed triangle mesh or NULL on error.
+* \ingroup	WlzContour
+* \brief	Creates an iso-value surface from a 3D Woolz object's
+*		values as an indexed triangle mesh, ie an array of
+*		vertices and an array of triangle vertex indices.
+*		This gives the same surface triangles as WlzContourObj()
+*		with WLZ_CONTOUR_MTD_ISO but no geometric model is
+*		built, which makes it much faster and more compact
+*		when only the triangles are wanted, eg for export or
+*		rendering.
+*		Each vertex of the surface lies on a side of the
+*		lattice of voxel centres (or at a voxel centre) and
+*		vertices are merged using a hash table keyed by the
+*		lattice points at the ends of this side.
+*		The planes of the object are contoured in parallel
+*		z-slabs when OpenMP threads are available, giving the
+*		same mesh as a single thread would.
+* \param	srcObj			Given 3D domain object with values
+*					from which to compute the surface.
+* \param	isoVal			The iso-value.
+* \param	dstErr			Destination error pointer, may
+*                                       be NULL.
+*/
+WlzIdxMesh3D	*WlzContourIsoIdxMesh3D(WlzObject *srcObj, double isoVal,
+					WlzErrorNum *dstErr)
+{
+  int		idx,
+  		pnCnt;
+  WlzDomain	srcDom;
+  WlzContourSlabData3D slabDat;
+  WlzContourIdxMeshWSp3D idxWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  idxWSp.mesh = NULL;
+  idxWSp.htSz = 0;
+  idxWSp.htTbl = NULL;
+  idxWSp.vtxKey = NULL;
+  idxWSp.triHtSz = 0;
+  idxWSp.triHtTbl = NULL;
+  if(srcObj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(srcObj->type != WLZ_3D_DOMAINOBJ)
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if((srcDom = srcObj->domain).core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(srcDom.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+  else if((srcObj->values.core == NULL) ||
+          (srcObj->values.vox->values == NULL))
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(WlzGreyTableIsTiled(srcObj->values.core->type))
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    idxWSp.mesh = WlzMakeIdxMesh3D(0, 0, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    slabDat.bBox = WlzBoundingBox3I(srcObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    slabDat.srcObj = srcObj;
+    slabDat.zObj = NULL;
+    slabDat.ftr = NULL;
+    slabDat.ctrVal = isoVal;
+    pnCnt = srcDom.p->lastpl - srcDom.p->plane1 + 1;
+    errNum = WlzContourSlabs3D(NULL, &idxWSp, WlzContourIsoSlab3D, &slabDat,
+    			       1, pnCnt - 1);
+  }
+  /* Scale the vertices using the object's voxel size, as
+   * WlzContourScaleModelVoxSz() does for models. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzDVertex3	*vtx;
+    WlzPlaneDomain *pDom;
+
+    pDom = srcDom.p;
+    for(idx = 0; idx < idxWSp.mesh->nVtx; ++idx)
+    {
+      vtx = idxWSp.mesh->vtx + idx;
+      vtx->vtX = (vtx->vtX * pDom->voxel_size[0]) +
+                 (pDom->kol1 * (1.0 - pDom->voxel_size[0]));
+      vtx->vtY = (vtx->vtY * pDom->voxel_size[1]) +
+                 (pDom->line1 * (1.0 - pDom->voxel_size[1]));
+      vtx->vtZ = (vtx->vtZ * pDom->voxel_size[2]) +
+                 (pDom->plane1 * (1.0 - pDom->voxel_size[2]));
+    }
+  }
+  AlcFree(idxWSp.htTbl);
+  AlcFree(idxWSp.vtxKey);
+  AlcFree(idxWSp.triHtTbl);
+  if((errNum != WLZ_ERR_NONE) && (idxWSp.mesh != NULL))
+  {
+    (void )WlzFreeIdxMesh3D(idxWSp.mesh);
+    idxWSp.mesh = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(idxWSp.mesh);
+}
+
 /*!
 * \return	New contour or NULL on error.
 * \ingroup	WlzContour
@@ -1067,36 +1340,12 @@ static WlzContour *WlzContourIsoObj2D(WlzObject *srcObj, double isoVal,
 static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
 				      WlzErrorNum *dstErr)
 {
-  int		klIdx,
-  		lnIdx,
-		pnIdx,
-		klCnt,
-  		lnCnt,
-		pnCnt,
-  		bufIdx0,
-  		bufIdx1,
-		lastKlIn,
-		thisKlIn;
-  WlzObject	*obj2D = NULL;
-  WlzValues	dummyValues;
-  WlzDomain	dummyDom,
-  		srcDom;
-  WlzIVertex2	bufSz,
-		bufOff;
-  WlzIBox2	bBox2D;
-  WlzIBox3	bBox3D;
-  WlzDVertex3	cbOrg;
-  WlzUByte	*tUP0,
-  		*tUP1,
-		*tUP2,
-		*tUP3;
-  WlzUByte	**itvBuf[2] = {NULL, NULL};
-  double	**valBuf[2] = {NULL, NULL};
+  int		pnCnt;
+  WlzDomain	srcDom;
+  WlzContourSlabData3D slabDat;
   WlzContour 	*ctr = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  dummyDom.core = NULL;
-  dummyValues.core = NULL;
   if((srcDom = srcObj->domain).core == NULL)
   {
     errNum = WLZ_ERR_DOMAIN_NULL;
@@ -1129,22 +1378,106 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    bBox3D = WlzBoundingBox3I(srcObj, &errNum);
+    slabDat.bBox = WlzBoundingBox3I(srcObj, &errNum);
   }
-  /* Make buffers. */
+  /* Sweep down through the object using a pair of plane buffers, with
+   * the pairs of planes split into z-slabs. */
   if(errNum == WLZ_ERR_NONE)
   {
-    bufSz.vtX = bBox3D.xMax - bBox3D.xMin + 1;
-    bufSz.vtY = bBox3D.yMax - bBox3D.yMin + 1;
-    if((AlcBit2Calloc(&(itvBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcBit2Calloc(&(itvBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(valBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(valBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-    {
-      errNum = WLZ_ERR_MEM_ALLOC;
-    }
+    slabDat.srcObj = srcObj;
+    slabDat.zObj = NULL;
+    slabDat.ftr = NULL;
+    slabDat.ctrVal = isoVal;
+    pnCnt = srcDom.p->lastpl - srcDom.p->plane1 + 1;
+    errNum = WlzContourSlabs3D(ctr, NULL, WlzContourIsoSlab3D, &slabDat,
+    			       1, pnCnt - 1);
   }
-  /* Sweep down through the object using a pair of plane buffers. */
+  /* Scale model using object voxel size. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzContourScaleModelVoxSz(ctr->model, srcDom.p);
+  }
+  /* Tidy up on error. */
+  if((errNum != WLZ_ERR_NONE) && (ctr != NULL))
+  {
+    (void )WlzFreeContour(ctr);
+    ctr = NULL;
+  }
+  /* Set error code. */
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(ctr);
+}
+
+/*!
+* \return				Woolz error code.
+* \ingroup	WlzContour
+* \brief	Computes the iso-value surface simplices for a z-slab
+* 		of a 3D object using a pair of plane buffers. The
+* 		simplices are computed between each plane with index
+* 		pn0 to pn1 and the plane before it.
+* \param	ctr			Contour being built.
+* \param	spxBuf			Buffer for the simplices, if NULL
+* 					the simplices are added directly
+* 					to the contour's model.
+* \param	data			Slab data with the given object,
+* 					it's bounding box and the
+* 					iso-value.
+* \param	pn0			Index of the first plane, must be
+* 					greater than zero.
+* \param	pn1			Index of the last plane.
+*/
+static WlzErrorNum WlzContourIsoSlab3D(WlzContour *ctr,
+				       WlzContourSpxBuf3D *spxBuf,
+				       WlzContourSlabData3D *data,
+				       int pn0, int pn1)
+{
+  int		klIdx,
+  		lnIdx,
+		pnIdx,
+		klCnt,
+  		lnCnt,
+  		bufIdx0,
+  		bufIdx1,
+		lastKlIn,
+		thisKlIn;
+  double	isoVal;
+  WlzObject	*srcObj,
+  		*obj2D = NULL;
+  WlzValues	dummyValues;
+  WlzDomain	dummyDom;
+  WlzIVertex2	bufSz,
+		bufOff;
+  WlzIBox2	bBox2D;
+  WlzIBox3	bBox3D;
+  WlzDVertex3	cbOrg;
+  WlzUByte	*tUP0,
+  		*tUP1,
+		*tUP2,
+		*tUP3;
+  WlzUByte	**itvBuf[2] = {NULL, NULL};
+  double	**valBuf[2] = {NULL, NULL};
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dummyDom.core = NULL;
+  dummyValues.core = NULL;
+  srcObj = data->srcObj;
+  isoVal = data->ctrVal;
+  bBox3D = data->bBox;
+  /* Make buffers. */
+  bufSz.vtX = bBox3D.xMax - bBox3D.xMin + 1;
+  bufSz.vtY = bBox3D.yMax - bBox3D.yMin + 1;
+  if((AlcBit2Calloc(&(itvBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcBit2Calloc(&(itvBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(valBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(valBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* Sweep down through the slab using a pair of plane buffers, starting
+   * with the plane before the first plane of the slab. */
   if(errNum == WLZ_ERR_NONE)
   {
     obj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, dummyDom, dummyValues,
@@ -1152,9 +1485,8 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    pnIdx = 0;
-    pnCnt = srcObj->domain.p->lastpl - srcObj->domain.p->plane1 + 1;
-    while((errNum == WLZ_ERR_NONE) && (pnCnt-- > 0))
+    pnIdx = pn0 - 1;
+    while((errNum == WLZ_ERR_NONE) && (pnIdx <= pn1))
     {
       cbOrg.vtZ = bBox3D.zMin + pnIdx;
       bufIdx0 = (pnIdx + 1) % 2;
@@ -1178,7 +1510,7 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
       {
 	/* Compute the intersection of the iso-value plane with each cube
 	 * of values. */
-	if(pnIdx > 0)
+	if(pnIdx >= pn0)
 	{
 	  klCnt = bBox2D.xMax - bBox2D.xMin; 			  /* NOT + 1 */
 	  lnIdx = bBox2D.yMin - bBox3D.yMin;
@@ -1205,7 +1537,7 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
 	      if(lastKlIn && thisKlIn)
 	      {
                 cbOrg.vtX = bBox3D.xMin + klIdx;
-		errNum = WlzContourIsoCube3D6T(ctr, isoVal,
+		errNum = WlzContourIsoCube3D6T(ctr, spxBuf, isoVal,
 				       *(valBuf[bufIdx0] + lnIdx) + klIdx,
 				       *(valBuf[bufIdx0] + lnIdx + 1) + klIdx,
 				       *(valBuf[bufIdx1] + lnIdx) + klIdx,
@@ -1225,17 +1557,6 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
     obj2D->values = dummyValues;
     (void )WlzFreeObj(obj2D);
   }
-  /* Scale model using object voxel size. */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    errNum = WlzContourScaleModelVoxSz(ctr->model, srcDom.p);
-  }
-  /* Tidy up on error. */
-  if((errNum != WLZ_ERR_NONE) && (ctr != NULL))
-  {
-    (void )WlzFreeContour(ctr);
-    ctr = NULL;
-  }
   /* Free buffers. */
   for(pnIdx = 0; pnIdx < 2; ++pnIdx)
   {
@@ -1248,12 +1569,7 @@ static WlzContour *WlzContourIsoObj3D(WlzObject *srcObj, double isoVal,
       Alc2Free((void **)valBuf[pnIdx]);
     }
   }
-  /* Set error code. */
-  if(dstErr)
-  {
-    *dstErr = errNum;
-  }
-  return(ctr);
+  return(errNum);
 }
 
 /*!
@@ -1692,49 +2008,14 @@ static WlzContour *WlzContourGrdObj3D(WlzObject *srcObj,
 				      WlzErrorNum *dstErr)
 {
   /* TODO use nrmFlg */
-  int		cnt,
-  		idX,
-		idY,
-		idZ,
-		pnIdx,
-  		pnCnt,
-		cbInObj;
-  double	gV,
-  		sGV,
-		grdLoSq;
+  int		pnCnt;
   WlzDomain	srcDom;
-  WlzUByte	*iMP,
-	  	*iMC,
-	  	*iMN;
   WlzRsvFilter	*ftr = NULL;
-  WlzObject	*srcObj2D = NULL,
-  		*xObj2D = NULL,
-  		*yObj2D = NULL,
-		*zObj2D = NULL,
-  		*zObj = NULL;
+  WlzObject	*zObj = NULL;
   WlzContour 	*ctr = NULL;
-  WlzIVertex3	bufPos,
-  		cbOrg;
-  WlzIVertex2	bufSz,
-  		bufOff,
-		bufOrg;
-  WlzIBox2	bBox2D;
-  WlzIBox3	bBox3D;
-  int		bufIdx[3],
-  		iBufClr[3];
-  WlzUByte	**iBuf[3],
-  		**mBuf[3];
-  double	**xBuf[3],
-  		**yBuf[3],
-		**zBuf[3];
+  WlzContourSlabData3D slabDat;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  iBufClr[0] = iBufClr[1] = iBufClr[2] = 1;
-  iBuf[0] = iBuf[1] = iBuf[2] = NULL;
-  mBuf[0] = mBuf[1] = mBuf[2] = NULL;
-  xBuf[0] = xBuf[1] = xBuf[2] = NULL;
-  yBuf[0] = yBuf[1] = yBuf[2] = NULL;
-  zBuf[0] = zBuf[1] = zBuf[2] = NULL;
   if(srcObj->values.core == NULL)
   {
     errNum = WLZ_ERR_VALUES_NULL;
@@ -1766,11 +2047,7 @@ static WlzContour *WlzContourGrdObj3D(WlzObject *srcObj,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-    bBox3D = WlzBoundingBox3I(srcObj, &errNum);
-    bufSz.vtX = bBox3D.xMax - bBox3D.xMin + 1;
-    bufSz.vtY = bBox3D.yMax - bBox3D.yMin + 1;
-    bufOrg.vtX = bBox3D.xMin;
-    bufOrg.vtY = bBox3D.yMin;
+    slabDat.bBox = WlzBoundingBox3I(srcObj, &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -1788,42 +2065,155 @@ static WlzContour *WlzContourGrdObj3D(WlzObject *srcObj,
 	     		     &errNum), NULL);
     }
   }
+  /* Work down through the object, with the planes split into
+   * z-slabs. */
   if(errNum == WLZ_ERR_NONE)
   {
-    /* Create buffers. */
-    if((AlcUnchar2Calloc(&(mBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcUnchar2Calloc(&(mBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcUnchar2Calloc(&(mBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcBit2Calloc(&(iBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcBit2Calloc(&(iBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcBit2Calloc(&(iBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(xBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(xBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(xBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(yBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(yBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(yBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(zBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(zBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc(&(zBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-    {
-      errNum = WLZ_ERR_MEM_ALLOC;
-    }
+    slabDat.srcObj = srcObj;
+    slabDat.zObj = zObj;
+    slabDat.ftr = ftr;
+    /* Enforce a minimum gradient. */
+    if((slabDat.ctrVal = grdLo * grdLo) < 1.0)
+    {
+      slabDat.ctrVal = 1.0;
+    }
+    pnCnt = srcDom.p->lastpl - srcDom.p->plane1 + 1;
+    errNum = WlzContourSlabs3D(ctr, NULL, WlzContourGrdSlab3D, &slabDat,
+    			       0, pnCnt - 1);
+  }
+  /* Scale model using object voxel size. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzContourScaleModelVoxSz(ctr->model, srcDom.p);
+  }
+  /* Tidy up on error. */
+  if((errNum != WLZ_ERR_NONE) && (ctr != NULL))
+  {
+    (void )WlzFreeContour(ctr);
+    ctr = NULL;
+  }
+  /* Free temporary objects. */
+  if(zObj)
+  {
+    (void )WlzFreeObj(zObj);
+  }
+  if(ftr)
+  {
+    WlzRsvFilterFreeFilter(ftr);
+  }
+  /* Set error code. */
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(ctr);
+}
+
+/*!
+* \return				Woolz error code.
+* \ingroup	WlzContour
+* \brief	Computes the maximal gradient surface simplices for
+* 		a z-slab of a 3D object using three plane buffers.
+* 		The simplices are those found when each of the planes
+* 		with index pn0 to pn1 is read. Because simplices link
+* 		maximal gradient voxels with those of the previous
+* 		plane, the three planes before the slab are also read
+* 		and the maximal gradient voxels found for the plane
+* 		before the slab without adding any simplices.
+* \param	ctr			Contour being built.
+* \param	spxBuf			Buffer for the simplices, if NULL
+* 					the simplices are added directly
+* 					to the contour's model.
+* \param	data			Slab data with the given object,
+* 					it's bounding box, the partial
+* 					derivatives through the planes,
+* 					the derivative filter and the
+* 					square of the minimum gradient.
+* \param	pn0			Index of the first plane.
+* \param	pn1			Index of the last plane.
+*/
+static WlzErrorNum WlzContourGrdSlab3D(WlzContour *ctr,
+				       WlzContourSpxBuf3D *spxBuf,
+				       WlzContourSlabData3D *data,
+				       int pn0, int pn1)
+{
+  int		cnt,
+  		idX,
+		idY,
+		idZ,
+		pnIdx,
+		cbInObj;
+  double	gV,
+  		sGV,
+		grdLoSq;
+  WlzUByte	*iMP,
+	  	*iMC,
+	  	*iMN;
+  WlzObject	*srcObj,
+  		*zObj,
+		*srcObj2D = NULL,
+  		*xObj2D = NULL,
+  		*yObj2D = NULL,
+		*zObj2D = NULL;
+  WlzRsvFilter	*ftr;
+  WlzIVertex3	bufPos,
+  		cbOrg;
+  WlzIVertex2	bufSz,
+  		bufOff,
+		bufOrg;
+  WlzIBox2	bBox2D;
+  WlzIBox3	bBox3D;
+  int		bufIdx[3],
+  		iBufClr[3];
+  WlzUByte	**iBuf[3],
+  		**mBuf[3];
+  double	**xBuf[3],
+  		**yBuf[3],
+		**zBuf[3];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  iBufClr[0] = iBufClr[1] = iBufClr[2] = 1;
+  iBuf[0] = iBuf[1] = iBuf[2] = NULL;
+  mBuf[0] = mBuf[1] = mBuf[2] = NULL;
+  xBuf[0] = xBuf[1] = xBuf[2] = NULL;
+  yBuf[0] = yBuf[1] = yBuf[2] = NULL;
+  zBuf[0] = zBuf[1] = zBuf[2] = NULL;
+  srcObj = data->srcObj;
+  zObj = data->zObj;
+  ftr = data->ftr;
+  grdLoSq = data->ctrVal;
+  bBox3D = data->bBox;
+  bufSz.vtX = bBox3D.xMax - bBox3D.xMin + 1;
+  bufSz.vtY = bBox3D.yMax - bBox3D.yMin + 1;
+  bufOrg.vtX = bBox3D.xMin;
+  bufOrg.vtY = bBox3D.yMin;
+  /* Create buffers. */
+  if((AlcUnchar2Calloc(&(mBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcUnchar2Calloc(&(mBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcUnchar2Calloc(&(mBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcBit2Calloc(&(iBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcBit2Calloc(&(iBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcBit2Calloc(&(iBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(xBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(xBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(xBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(yBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(yBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(yBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(zBuf[0]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(zBuf[1]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble2Malloc(&(zBuf[2]), bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
   }
-  /* Work down through the object. */
+  /* Work down through the slab, starting three planes before it. */
   if(errNum == WLZ_ERR_NONE)
   {
-    /* Enforce a minimum gradient. */
-    if((grdLoSq = grdLo * grdLo) < 1.0)
-    {
-      grdLoSq = 1.0;
-    }
-    pnIdx = 0;
-    pnCnt = srcDom.p->lastpl - srcDom.p->plane1 + 1;
-    while((errNum == WLZ_ERR_NONE) && (pnCnt-- > 0))
+    pnIdx = WLZ_MAX(pn0 - 3, 0);
+    while((errNum == WLZ_ERR_NONE) && (pnIdx <= pn1))
     { 
 #ifdef WLZ_CONTOUR_DEBUG
-    (void )fprintf(stderr, "WLZ_CONTOUR_DEBUG pnCnt = %d\n", pnCnt);
+    (void )fprintf(stderr, "WLZ_CONTOUR_DEBUG pnIdx = %d\n", pnIdx);
 #endif /* WLZ_CONTOUR_DEBUG */
       bufIdx[0] = (pnIdx + 3 - 2) % 3;
       bufIdx[1] = (pnIdx + 3 - 1) % 3;
@@ -1896,8 +2286,10 @@ static WlzContour *WlzContourGrdObj3D(WlzObject *srcObj,
 	  errNum = WlzToArray2D((void ***)&(zBuf[bufIdx[2]]), zObj2D,
 				bufSz, bufOrg, 0, WLZ_GREY_DOUBLE);
 	}
-	/* Check to see if there are 3 consecutive non-empty planes. */
-	if((errNum == WLZ_ERR_NONE) &&
+	/* Check to see if there are 3 consecutive non-empty planes and
+	 * that the maximal gradient voxels are needed for this plane,
+	 * which they are not for planes read only to fill the buffers. */
+	if((errNum == WLZ_ERR_NONE) && (pnIdx >= pn0 - 1) &&
 	   (iBufClr[bufIdx[0]] == 0) && (iBufClr[bufIdx[1]] == 0))
 	{
 	  /* Form mask in the previous plane interval mask for the previous,
@@ -1950,7 +2342,8 @@ static WlzContour *WlzContourGrdObj3D(WlzObject *srcObj,
 		 * simplicies and add them to the model. */
 		if(sGV >= grdLoSq)
 		{
-		  errNum = WlzContourGrdCube3D(ctr, mBuf, zBuf, yBuf, xBuf,
+		  errNum = WlzContourGrdCube3D(ctr, spxBuf, pnIdx >= pn0,
+		  			       mBuf, zBuf, yBuf, xBuf,
 		  			       bufIdx, bufPos, cbOrg);
 		}
 #ifdef WLZ_CONTOUR_DEBUG
@@ -1990,30 +2383,7 @@ static WlzContour *WlzContourGrdObj3D(WlzObject *srcObj,
       ++pnIdx;
     }
   }
-  /* Scale model using object voxel size. */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    errNum = WlzContourScaleModelVoxSz(ctr->model, srcDom.p);
-  }
-  /* Tidy up on error. */
-  if((errNum != WLZ_ERR_NONE) && (ctr != NULL))
-  {
-    (void )WlzFreeContour(ctr);
-    ctr = NULL;
-  }
-  /* Free buffer and temporary objects. */
-  if(xObj2D)
-  {
-    (void )WlzFreeObj(xObj2D);
-  }
-  if(yObj2D)
-  {
-    (void )WlzFreeObj(yObj2D);
-  }
-  if(zObj)
-  {
-    (void )WlzFreeObj(zObj);
-  }
+  /* Free buffers. */
   for(idZ = 0; idZ < 3; ++idZ)
   {
     if(iBuf[idZ])
@@ -2037,16 +2407,501 @@ static WlzContour *WlzContourGrdObj3D(WlzObject *srcObj,
       Alc2Free((void **)(zBuf[idZ]));
     }
   }
-  if(ftr)
+  return(errNum);
+}
+
+/*!
+* \return				Woolz error code.
+* \ingroup	WlzContour
+* \brief	Contours the planes with indices pnFst to pnLst of a
+* 		3D object using the given slab function, adding the
+* 		simplices either to the contour's model or to an
+* 		indexed triangle mesh.
+*
+*		When more than one thread is available and there are
+*		enough planes, the planes are split into z-slabs which
+*		are contoured in parallel into per-slab simplex
+*		buffers. The buffers are then added to the contour's
+*		model in slab order, with the model's vertex hash
+*		table merging the vertices on the planes shared by
+*		adjacent slabs. Because the simplices are added in the
+*		same order as they would be by a single thread the
+*		model is the same whatever the number of threads.
+*		Simplices for an indexed triangle mesh are always
+*		buffered, with their vertices keyed so that they can
+*		be merged by the mesh workspace.
+* \param	ctr			Contour being built, may be NULL
+* 					when building an indexed mesh.
+* \param	idxWSp			Indexed triangle mesh workspace,
+* 					NULL unless building an indexed
+* 					mesh.
+* \param	slabFn			Function which contours a z-slab.
+* \param	data			Slab data passed to the slab
+* 					function.
+* \param	pnFst			Index of the first plane.
+* \param	pnLst			Index of the last plane.
+*/
+static WlzErrorNum WlzContourSlabs3D(WlzContour *ctr,
+				     WlzContourIdxMeshWSp3D *idxWSp,
+				     WlzContourSlabFn3D slabFn,
+				     WlzContourSlabData3D *data,
+				     int pnFst, int pnLst)
+{
+  int		idS,
+  		nThr = 1,
+		nSlab,
+		slabSz;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(pnLst >= pnFst)
   {
-    WlzRsvFilterFreeFilter(ftr);
+#ifdef _OPENMP
+    nThr = omp_get_max_threads();
+#endif
+    /* Use several slabs per thread so that the threads stay busy while
+     * the buffered simplices are being added to the model or mesh. */
+    nSlab = WLZ_MIN((pnLst - pnFst + 1) / WLZ_CONTOUR_SLAB_MIN, 4 * nThr);
+    if((idxWSp == NULL) && ((nThr < 2) || (nSlab < 2)))
+    {
+      errNum = (*slabFn)(ctr, NULL, data, pnFst, pnLst);
+    }
+    else
+    {
+      nSlab = WLZ_MAX(nSlab, 1);
+      slabSz = (pnLst - pnFst + nSlab) / nSlab;
+      nSlab = (pnLst - pnFst + slabSz) / slabSz;
+#ifdef _OPENMP
+#pragma omp parallel for ordered schedule(dynamic, 1)
+#endif
+      for(idS = 0; idS < nSlab; ++idS)
+      {
+	int	pn0,
+		pn1;
+	WlzContourSpxBuf3D spxBuf;
+	WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+	spxBuf.nSpx = spxBuf.maxSpx = 0;
+	spxBuf.useKey = (idxWSp != NULL);
+	spxBuf.vtx = NULL;
+	spxBuf.key = NULL;
+	pn0 = pnFst + (idS * slabSz);
+	pn1 = WLZ_MIN(pn0 + slabSz - 1, pnLst);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum2 = (*slabFn)(ctr, &spxBuf, data, pn0, pn1);
+	}
+#ifdef _OPENMP
+#pragma omp ordered
+#endif
+	{
+	  int	idx;
+
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    for(idx = 0; (errNum2 == WLZ_ERR_NONE) && (idx < spxBuf.nSpx);
+		++idx)
+	    {
+	      errNum2 = (idxWSp)?
+	                WlzContourIdxMeshAdd3D(idxWSp,
+			                       spxBuf.vtx + (3 * idx),
+					       spxBuf.key + (6 * idx)):
+	                WlzGMModelConstructSimplex3D(ctr->model,
+	      					     spxBuf.vtx + (3 * idx));
+	    }
+	    errNum = errNum2;
+	  }
+	}
+	AlcFree(spxBuf.vtx);
+	AlcFree(spxBuf.key);
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return				Woolz error code.
+* \ingroup	WlzContour
+* \brief	Adds a 3D simplex (triangle) either to the given
+* 		simplex buffer or, if the buffer is NULL, directly to
+* 		the contour's model.
+* \param	ctr			Contour being built.
+* \param	spxBuf			Simplex buffer, may be NULL.
+* \param	spx			The three vertices of the simplex.
+* \param	key			The keys of the three vertices of
+* 					the simplex, only used if the
+* 					buffer keeps keys.
+*/
+static WlzErrorNum WlzContourSpx3DAdd(WlzContour *ctr,
+				      WlzContourSpxBuf3D *spxBuf,
+				      WlzDVertex3 *spx,
+				      WlzIVertex3 *key)
+{
+  int		idx;
+  WlzDVertex3	*vtx;
+  WlzIVertex3	*vKey;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(spxBuf == NULL)
+  {
+    errNum = WlzGMModelConstructSimplex3D(ctr->model, spx);
+  }
+  else
+  {
+    if(spxBuf->useKey && (key == NULL))
+    {
+      errNum = WLZ_ERR_PARAM_NULL;
+    }
+    else if(spxBuf->nSpx >= spxBuf->maxSpx)
+    {
+      spxBuf->maxSpx = (2 * spxBuf->maxSpx) + 1024;
+      if((vtx = (WlzDVertex3 *)AlcRealloc(spxBuf->vtx,
+      			3 * spxBuf->maxSpx * sizeof(WlzDVertex3))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+        spxBuf->vtx = vtx;
+	if(spxBuf->useKey)
+	{
+	  if((vKey = (WlzIVertex3 *)AlcRealloc(spxBuf->key,
+			    6 * spxBuf->maxSpx * sizeof(WlzIVertex3))) == NULL)
+	  {
+	    errNum = WLZ_ERR_MEM_ALLOC;
+	  }
+	  else
+	  {
+	    spxBuf->key = vKey;
+	  }
+	}
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      vtx = spxBuf->vtx + (3 * spxBuf->nSpx);
+      for(idx = 0; idx < 3; ++idx)
+      {
+        vtx[idx] = spx[idx];
+      }
+      if(spxBuf->useKey)
+      {
+        vKey = spxBuf->key + (6 * spxBuf->nSpx);
+	for(idx = 0; idx < 6; ++idx)
+	{
+	  vKey[idx] = key[idx];
+	}
+      }
+      ++(spxBuf->nSpx);
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return				Woolz error code.
+* \ingroup	WlzContour
+* \brief	Adds a keyed 3D simplex (triangle) to the indexed
+* 		triangle mesh being built, merging vertices with the
+* 		same key. Simplices which have fewer than three
+* 		distinct vertices after merging are not added and
+* 		neither are simplices with the same three vertices as
+* 		a triangle already in the mesh (as happens for adjacent
+* 		tetrahedra when the iso-surface passes through lattice
+* 		points). This matches the merging of simplices done by
+* 		WlzGMModelConstructSimplex3D().
+* 		The triangle hash table is doubled in size whenever it
+* 		becomes half full.
+* \param	wSp			Indexed triangle mesh workspace.
+* \param	spx			The three vertices of the simplex.
+* \param	key			The keys of the three vertices of
+* 					the simplex.
+*/
+static WlzErrorNum WlzContourIdxMeshAdd3D(WlzContourIdxMeshWSp3D *wSp,
+				          WlzDVertex3 *spx,
+					  WlzIVertex3 *key)
+{
+  int		idx,
+  		idT,
+		slot;
+  int		*tri;
+  int		vIdx[3],
+  		sIdx[3],
+		tIdx[3];
+  WlzIdxMesh3D	*mesh;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  mesh = wSp->mesh;
+  for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < 3); ++idx)
+  {
+    vIdx[idx] = WlzContourIdxMeshVtx3D(wSp, spx[idx], key + (2 * idx),
+    				       &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) &&
+     (vIdx[0] != vIdx[1]) && (vIdx[1] != vIdx[2]) && (vIdx[2] != vIdx[0]))
+  {
+    /* Grow the triangles and triangle hash table if needed. */
+    if(mesh->nTri >= mesh->maxTri)
+    {
+      mesh->maxTri = (2 * mesh->maxTri) + 1024;
+      if((tri = (int *)AlcRealloc(mesh->tri,
+      				  3 * mesh->maxTri * sizeof(int))) == NULL)
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	mesh->tri = tri;
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && (2 * (mesh->nTri + 1) > wSp->triHtSz))
+    {
+      int	*htTbl;
+
+      wSp->triHtSz = (wSp->triHtSz > 0)? 2 * wSp->triHtSz: 4096;
+      if((htTbl = (int *)AlcRealloc(wSp->triHtTbl,
+				    wSp->triHtSz * sizeof(int))) == NULL)
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	/* Rehash all the triangles. */
+	wSp->triHtTbl = htTbl;
+	for(slot = 0; slot < wSp->triHtSz; ++slot)
+	{
+	  htTbl[slot] = -1;
+	}
+	for(idT = 0; idT < mesh->nTri; ++idT)
+	{
+	  WlzContourTriSort(tIdx, mesh->tri + (3 * idT));
+	  slot = WlzContourTriHash(tIdx) & (wSp->triHtSz - 1);
+	  while(htTbl[slot] >= 0)
+	  {
+	    slot = (slot + 1) & (wSp->triHtSz - 1);
+	  }
+	  htTbl[slot] = idT;
+	}
+      }
+    }
+    /* Look for a triangle with the same vertices and add this one if
+     * there is none. */
+    if(errNum == WLZ_ERR_NONE)
+    {
+      WlzContourTriSort(sIdx, vIdx);
+      slot = WlzContourTriHash(sIdx) & (wSp->triHtSz - 1);
+      while((idT = wSp->triHtTbl[slot]) >= 0)
+      {
+	WlzContourTriSort(tIdx, mesh->tri + (3 * idT));
+	if((tIdx[0] == sIdx[0]) && (tIdx[1] == sIdx[1]) &&
+	   (tIdx[2] == sIdx[2]))
+	{
+	  break;
+	}
+	slot = (slot + 1) & (wSp->triHtSz - 1);
+      }
+      if(idT < 0)
+      {
+	idT = mesh->nTri++;
+	wSp->triHtTbl[slot] = idT;
+	tri = mesh->tri + (3 * idT);
+	tri[0] = vIdx[0];
+	tri[1] = vIdx[1];
+	tri[2] = vIdx[2];
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return				Index of the vertex in the mesh.
+* \ingroup	WlzContour
+* \brief	Finds the mesh vertex with the given key, adding a new
+* 		vertex at the given position if there is none.
+* 		The hash table is doubled in size whenever it becomes
+* 		half full.
+* \param	wSp			Indexed triangle mesh workspace.
+* \param	pos			Position for a new vertex.
+* \param	key			The vertex key, the two lattice
+* 					points at the ends of the side on
+* 					which the vertex lies.
+* \param	dstErr			Destination error pointer, may be
+* 					NULL.
+*/
+static int	WlzContourIdxMeshVtx3D(WlzContourIdxMeshWSp3D *wSp,
+				       WlzDVertex3 pos, WlzIVertex3 *key,
+				       WlzErrorNum *dstErr)
+{
+  int		idV = -1,
+  		slot;
+  unsigned int	hash;
+  WlzIVertex3	*vKey;
+  WlzIdxMesh3D	*mesh;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  mesh = wSp->mesh;
+  /* Grow the vertices, keys and hash table if needed. */
+  if(mesh->nVtx >= mesh->maxVtx)
+  {
+    WlzDVertex3	*vtx;
+
+    mesh->maxVtx = (2 * mesh->maxVtx) + 1024;
+    if((vtx = (WlzDVertex3 *)AlcRealloc(mesh->vtx,
+    				mesh->maxVtx * sizeof(WlzDVertex3))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      mesh->vtx = vtx;
+      if((vKey = (WlzIVertex3 *)AlcRealloc(wSp->vtxKey,
+			     2 * mesh->maxVtx * sizeof(WlzIVertex3))) == NULL)
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	wSp->vtxKey = vKey;
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (2 * (mesh->nVtx + 1) > wSp->htSz))
+  {
+    int		*htTbl;
+
+    wSp->htSz = (wSp->htSz > 0)? 2 * wSp->htSz: 4096;
+    if((htTbl = (int *)AlcRealloc(wSp->htTbl,
+    				  wSp->htSz * sizeof(int))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      /* Rehash all the vertices. */
+      wSp->htTbl = htTbl;
+      for(slot = 0; slot < wSp->htSz; ++slot)
+      {
+        htTbl[slot] = -1;
+      }
+      for(idV = 0; idV < mesh->nVtx; ++idV)
+      {
+	vKey = wSp->vtxKey + (2 * idV);
+	hash = WlzContourKeyHash(vKey);
+	slot = hash & (wSp->htSz - 1);
+	while(htTbl[slot] >= 0)
+	{
+	  slot = (slot + 1) & (wSp->htSz - 1);
+	}
+	htTbl[slot] = idV;
+      }
+      idV = -1;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    hash = WlzContourKeyHash(key);
+    slot = hash & (wSp->htSz - 1);
+    while((idV = wSp->htTbl[slot]) >= 0)
+    {
+      vKey = wSp->vtxKey + (2 * idV);
+      if((vKey[0].vtX == key[0].vtX) && (vKey[0].vtY == key[0].vtY) &&
+         (vKey[0].vtZ == key[0].vtZ) && (vKey[1].vtX == key[1].vtX) &&
+	 (vKey[1].vtY == key[1].vtY) && (vKey[1].vtZ == key[1].vtZ))
+      {
+        break;
+      }
+      slot = (slot + 1) & (wSp->htSz - 1);
+    }
+    if(idV < 0)
+    {
+      idV = mesh->nVtx++;
+      wSp->htTbl[slot] = idV;
+      mesh->vtx[idV] = pos;
+      vKey = wSp->vtxKey + (2 * idV);
+      vKey[0] = key[0];
+      vKey[1] = key[1];
+    }
   }
-  /* Set error code. */
   if(dstErr)
   {
     *dstErr = errNum;
   }
-  return(ctr);
+  return(idV);
+}
+
+/*!
+* \return				Hash value.
+* \ingroup	WlzContour
+* \brief	Computes a hash value for a vertex key.
+* \param	key			The two lattice points of the
+* 					vertex key.
+*/
+static unsigned int WlzContourKeyHash(WlzIVertex3 *key)
+{
+  unsigned int	hash;
+
+  hash = ((unsigned int )(key[0].vtX) * 73856093U) ^
+         ((unsigned int )(key[0].vtY) * 19349663U) ^
+	 ((unsigned int )(key[0].vtZ) * 83492791U);
+  hash = (hash * 31U) +
+         (((unsigned int )(key[1].vtX) * 73856093U) ^
+          ((unsigned int )(key[1].vtY) * 19349663U) ^
+	  ((unsigned int )(key[1].vtZ) * 83492791U));
+  hash ^= hash >> 16;
+  return(hash);
+}
+
+/*!
+* \return				Hash value.
+* \ingroup	WlzContour
+* \brief	Computes a hash value for the sorted vertex indices of
+* 		a triangle.
+* \param	vIdx			The three sorted vertex indices.
+*/
+static unsigned int WlzContourTriHash(int *vIdx)
+{
+  unsigned int	hash;
+
+  hash = ((unsigned int )(vIdx[0]) * 73856093U) ^
+         ((unsigned int )(vIdx[1]) * 19349663U) ^
+	 ((unsigned int )(vIdx[2]) * 83492791U);
+  hash ^= hash >> 16;
+  return(hash);
+}
+
+/*!
+* \ingroup	WlzContour
+* \brief	Sorts the three vertex indices of a triangle into
+* 		increasing order.
+* \param	dst			Destination for the sorted indices.
+* \param	vIdx			The three vertex indices.
+*/
+static void	WlzContourTriSort(int *dst, int *vIdx)
+{
+  int		tmp;
+
+  dst[0] = vIdx[0];
+  dst[1] = vIdx[1];
+  dst[2] = vIdx[2];
+  if(dst[0] > dst[1])
+  {
+    tmp = dst[0];
+    dst[0] = dst[1];
+    dst[1] = tmp;
+  }
+  if(dst[1] > dst[2])
+  {
+    tmp = dst[1];
+    dst[1] = dst[2];
+    dst[2] = tmp;
+  }
+  if(dst[0] > dst[1])
+  {
+    tmp = dst[0];
+    dst[0] = dst[1];
+    dst[1] = tmp;
+  }
 }
 
 /*!
@@ -2987,6 +3842,9 @@ static WlzContour *WlzContourBndObj3D(WlzObject *obj, double ctrVal,
  
 \endverbatim
 * \param	ctr			Contour being built.
+* \param	spxBuf			Buffer for the simplices, if NULL
+*					the simplices are added directly
+*					to the contour's model.
 * \param	mBuf			Buffers containing non-zero
 *                                       values for maximal gradient
 *                                       voxels.
@@ -2997,6 +3855,7 @@ static WlzContour *WlzContourBndObj3D(WlzObject *obj, double ctrVal,
 *                                       neighbourhoods origin.
 */
 static WlzErrorNum	WlzContourGrdLink3D(WlzContour *ctr,
+					    WlzContourSpxBuf3D *spxBuf,
 					    WlzUByte ***mBuf,
 					    int *bufIdx, WlzIVertex3 bufPos,
 					    WlzIVertex3 cbOrg)
@@ -3092,7 +3951,7 @@ static WlzErrorNum	WlzContourGrdLink3D(WlzContour *ctr,
         WLZ_VTX_3_ADD(sIsn[1], cbOrg, tIV0);
         WLZ_VTX_3_ADD(sIsn[2], cbOrg, tIV1);
 	++spxCnt;;
-	errNum = WlzGMModelConstructSimplex3D(ctr->model, sIsn);
+	errNum = WlzContourSpx3DAdd(ctr, spxBuf, sIsn, NULL);
       }
       ++idN;
     }
@@ -3364,7 +4223,7 @@ static WlzErrorNum WlzContourBndPlane3D(WlzContour *ctr, double isoVal,
 	dPn1Ln0[1] = iPn1Ln0[1];
 	dPn1Ln1[0] = iPn1Ln1[0];
 	dPn1Ln1[1] = iPn1Ln1[1];
-        errNum = WlzContourIsoCube3D6T(ctr, isoVal,
+        errNum = WlzContourIsoCube3D6T(ctr, NULL, isoVal,
 				       dPn0Ln0, dPn0Ln1, dPn1Ln0, dPn1Ln1,
 				       cbOrg);
       }
@@ -3478,7 +4337,7 @@ static WlzErrorNum WlzContourBndEmptyPlane3D(WlzContour *ctr, double isoVal,
 	dPn0Ln0[1] = iPn0Ln0[1];
 	dPn0Ln1[0] = iPn0Ln1[0];
 	dPn0Ln1[1] = iPn0Ln1[1];
-        errNum = WlzContourIsoCube3D6T(ctr, isoVal,
+        errNum = WlzContourIsoCube3D6T(ctr, NULL, isoVal,
 				       dPn0Ln0, dPn0Ln1, dPn1Ln0, dPn1Ln1,
 				       cbOrg);
       }
@@ -3947,7 +4806,7 @@ static WlzErrorNum WlzContourIsoCube3D24(WlzContour *ctr,
       tI3 = tVxLUT[tIdx][3];
       tVal[1] = cVal[tI1]; tVal[2] = cVal[tI2]; tVal[3] = cVal[tI3];
       tPos[1] = cPos[tI1]; tPos[2] = cPos[tI2]; tPos[3] = cPos[tI3];
-      errNum = WlzContourIsoTet3D(ctr, tVal, tPos, cbOrg);
+      errNum = WlzContourIsoTet3D(ctr, NULL, tVal, tPos, cbOrg);
       ++tIdx;
     }
   }
@@ -3977,6 +4836,13 @@ static WlzErrorNum WlzContourIsoCube3D24(WlzContour *ctr,
 *               non-zero.
 *               The buffer position wrt z is always modulo 3.
 * \param	ctr			Contour being built.
+* \param	spxBuf			Buffer for the simplices, if NULL
+*					the simplices are added directly
+*					to the contour's model.
+* \param	lnkFlg			Link the voxel with it's
+*					neighbours to form simplices if
+*					non-zero, otherwise only mark
+*					it as a maximal gradient voxel.
 * \param	mBuf			Buffer with maximal voxels
 *                                       marked non-zero.
 * \param	zBuf			Z gradients.
@@ -3987,6 +4853,8 @@ static WlzErrorNum WlzContourIsoCube3D24(WlzContour *ctr,
 * \param	cbOrg			Origin of the cube.
 */
 static WlzErrorNum WlzContourGrdCube3D(WlzContour *ctr,
+				       WlzContourSpxBuf3D *spxBuf,
+				       int lnkFlg,
 				       WlzUByte ***mBuf,
 				       double ***zBuf, double ***yBuf,
 				       double ***xBuf,
@@ -4203,7 +5071,10 @@ static WlzErrorNum WlzContourGrdCube3D(WlzContour *ctr,
                    modCGV * cGV.vtX, modCGV * cGV.vtY, modCGV * cGV.vtZ);
 #endif /* WLZ_CONTOUR_DEBUG */
     *(*(*(mBuf + aCC.vtZ) + aCC.vtY) + aCC.vtX) = 1;
-    errNum = WlzContourGrdLink3D(ctr, mBuf, bufIdx, bufPos, cbOrg);
+    if(lnkFlg)
+    {
+      errNum = WlzContourGrdLink3D(ctr, spxBuf, mBuf, bufIdx, bufPos, cbOrg);
+    }
   }
 #ifdef WLZ_CONTOUR_DEBUG
   else
@@ -4266,6 +5137,9 @@ static WlzErrorNum WlzContourGrdCube3D(WlzContour *ctr,
 
 \endverbatim
 * \param	ctr			Contour being built.
+* \param	spxBuf			Buffer for the simplices, if NULL
+*					the simplices are added directly
+*					to the contour's model.
 * \param	isoVal			Iso-value to use.
 * \param	vPn0Ln0			Ptr to 2 data values at
 *                                       z = zPos, y = yPos and
@@ -4282,6 +5156,7 @@ static WlzErrorNum WlzContourGrdCube3D(WlzContour *ctr,
 * \param	cbOrg			The cube's origin.
 */
 static WlzErrorNum WlzContourIsoCube3D6T(WlzContour *ctr,
+				WlzContourSpxBuf3D *spxBuf,
 				double isoVal,
 				double *vPn0Ln0, double *vPn0Ln1,
 				double *vPn1Ln0, double *vPn1Ln1,
@@ -4348,7 +5223,7 @@ static WlzErrorNum WlzContourIsoCube3D6T(WlzContour *ctr,
 	tVal[vIdx] = cVal[tI0];
 	tPos[vIdx] = cPos[tI0];
       }
-      errNum = WlzContourIsoTet3D(ctr, tVal, tPos, cbOrg);
+      errNum = WlzContourIsoTet3D(ctr, spxBuf, tVal, tPos, cbOrg);
       ++tIdx;
     }
   }
@@ -4364,6 +5239,9 @@ static WlzErrorNum WlzContourIsoCube3D6T(WlzContour *ctr,
 *		The triangle vertices are always ordered such that
 *		when viewed from the +ve side they are in CCW order.
 * \param	ctr			Contour being built.
+* \param	spxBuf			Buffer for the simplices, if NULL
+*					the simplices are added directly
+*					to the contour's model.
 * \param	tVal			Values wrt the iso-value at the
 *                                       verticies of the tetrahedron.
 * \param	tPos			Positions of the tetrahedron
@@ -4371,18 +5249,23 @@ static WlzErrorNum WlzContourIsoCube3D6T(WlzContour *ctr,
 * \param	cbOrg			The cube's origin.
 */
 static WlzErrorNum WlzContourIsoTet3D(WlzContour *ctr,
+				      WlzContourSpxBuf3D *spxBuf,
 				      double *tVal,
 				      WlzDVertex3 *tPos,
 				      WlzDVertex3 cbOrg)
 {
   int		idx,
 		iCode,
-  		isnCnt;
+  		isnCnt,
+		keyFlg;
   double	tD0,
   		tD1;
   WlzDVertex3	*tVP0;
   WlzDVertex3	tV0;
   int		lev[4];     /* Rel. tetra node value: 2 -> +, 1 -> 0, 0 -> - */
+  int		tSd[8];	       /* Tetrahedron vertices of intersected sides */
+  WlzIVertex3	sKey[6],
+  		tKey[8];
   WlzDVertex3	sIsn[3],
   		tIsn[4];
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -4401,12 +5284,9 @@ static WlzErrorNum WlzContourIsoTet3D(WlzContour *ctr,
       break;
     case    2: /* S01S03S02 */
       isnCnt = 3;
-      *(tIsn + 0) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 2);
       break;
     case   10: /* No intersection */
       break;
@@ -4414,39 +5294,28 @@ static WlzErrorNum WlzContourIsoTet3D(WlzContour *ctr,
       break;
     case   12: /* V1S03S02 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 1);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 2);
       break;
     case   20: /* S01S12S13 */
       isnCnt = 3;
-      *(tIsn + 0) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 3);
       break;
     case   21: /* V0S12S13 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 0);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 3);
       break;
     case   22: /* S02S12S13S03 */
       isnCnt = 4;
-      *(tIsn + 0) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
-      *(tIsn + 3) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 3, 0, 3);
       break;
     case  100: /* No intersection. */
       break;
@@ -4454,128 +5323,97 @@ static WlzErrorNum WlzContourIsoTet3D(WlzContour *ctr,
       break;
     case  102: /* V2S01S03 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 2);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 2, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 3);
       break;
     case  110: /* No intersection. */
       break;
     case  111: /* V1V0V2 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 1);
-      *(tIsn + 1) = *(tPos + 0);
-      *(tIsn + 2) = *(tPos + 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 2, 2);
       break;
     case  112: /* V2V1S03 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 2);
-      *(tIsn + 1) = *(tPos + 1);
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 2, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 3);
       break;
     case  120: /* V2S13S01 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 2);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 2, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 1);
       break;
     case  121: /* V0V2S13 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 0);
-      *(tIsn + 1) = *(tPos + 2);
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 2, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 3);
       break;
     case  122: /* V2S13S03 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 2);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 2, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 3);
       break;
     case  200: /* S02S23S12 */
       isnCnt = 3;
-      *(tIsn + 0) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 2, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 2);
       break;
     case  201: /* V0S23S12 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 0);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 2, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 2);
       break;
     case  202: /* S01S03S23S12 */
       isnCnt = 4;
-      *(tIsn + 0) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
-      *(tIsn + 3) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 2, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 3, 1, 2);
       break;
     case  210: /* V1S02S23 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 1);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 2, 3);
       break;
     case  211: /* V1V0S23 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 1);
-      *(tIsn + 1) = *(tPos + 0);
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 2, 3);
       break;
     case  212: /* V1S03S23 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 1);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 2, 3);
       break;
     case  220: /* S01S02S23S13 */
       isnCnt = 4;
-      *(tIsn + 0) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
-      *(tIsn + 3) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 2, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 3, 1, 3);
       break;
     case  221: /* V0S23S13 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 0);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 2, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 3);
       break;
     case  222: /* S03S23S13 */
       isnCnt = 3;
-      *(tIsn + 0) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 2, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 3);
       break;
     case 1000: /* No intersection */
       break;
@@ -4583,140 +5421,122 @@ static WlzErrorNum WlzContourIsoTet3D(WlzContour *ctr,
       break;
     case 1002: /* V3S02S01 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 3);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 3, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 1);
       break;
     case 1010: /* No intersection */
       break;
     case 1011: /* V0V1V3 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 0);
-      *(tIsn + 1) = *(tPos + 1);
-      *(tIsn + 2) = *(tPos + 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 3, 3);
       break;
     case 1012: /* V1V3S02 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 1);
-      *(tIsn + 1) = *(tPos + 3);
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 3, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 2);
       break;
     case 1020: /* V3S01S12 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 3);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 3, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 2);
       break;
     case 1021: /* V3V0S12 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 3);
-      *(tIsn + 1) = *(tPos + 0);
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 3, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 2);
       break;
     case 1022: /* V3S02S12 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 3);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 3, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 2);
       break;
       break;
     case 1100: /* No intersection */
       break;
     case 1101: /* V0V3V2 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 0);
-      *(tIsn + 1) = *(tPos + 3);
-      *(tIsn + 2) = *(tPos + 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 3, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 2, 2);
       break;
     case 1102: /* V3V2S01 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 3);
-      *(tIsn + 1) = *(tPos + 2);
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 3, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 2, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 1);
       break;
     case 1110: /* V1V2V3 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 1);
-      *(tIsn + 1) = *(tPos + 2);
-      *(tIsn + 2) = *(tPos + 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 2, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 3, 3);
       break;
     case 1111: /* No intersection */
       break;
     case 1112: /* V2V1V3 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 2);
-      *(tIsn + 1) = *(tPos + 1);
-      *(tIsn + 2) = *(tPos + 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 2, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 3, 3);
       break;
     case 1120: /* V2V3S01 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 2);
-      *(tIsn + 1) = *(tPos + 3);
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 2, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 3, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 1);
       break;
     case 1121: /* V0V2V3 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 0);
-      *(tIsn + 1) = *(tPos + 2);
-      *(tIsn + 2) = *(tPos + 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 2, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 3, 3);
       break;
     case 1122: /* No intersection */
       break;
     case 1200: /* V3S12S02 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 3);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 3, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 2);
       break;
     case 1201: /* V0V3S12 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 0);
-      *(tIsn + 1) = *(tPos + 3);
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 3, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 2);
       break;
     case 1202: /* V3S12S01 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 3);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 3, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 1);
       break;
     case 1210: /* V3V1S02 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 3);
-      *(tIsn + 1) = *(tPos + 1);
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 3, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 2);
       break;
     case 1211: /* V0V3V1 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 0);
-      *(tIsn + 1) = *(tPos + 3);
-      *(tIsn + 2) = *(tPos + 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 3, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 1);
       break;
     case 1212: /* No intersection */
       break;
     case 1220: /* V3S01S02 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 3);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 3, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 2);
       break;
     case 1221: /* No intersection */
       break;
@@ -4724,128 +5544,97 @@ static WlzErrorNum WlzContourIsoTet3D(WlzContour *ctr,
       break;
     case 2000: /* S03S13S23 */
       isnCnt = 3;
-      *(tIsn + 0) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 2, 3);
       break;
     case 2001: /* V0S13S23 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 0);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 2, 3);
       break;
     case 2002: /* S01S13S23S02 */
       isnCnt = 4;
-      *(tIsn + 0) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
-      *(tIsn + 3) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 2, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 3, 0, 2);
       break;
     case 2010: /* V1S23S03 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 1);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 2, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 3);
       break;
     case 2011: /* V0V1S23 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 0);
-      *(tIsn + 1) = *(tPos + 1);
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 2, 3);
       break;
     case 2012: /* V1S23S02 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 1);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 2, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 2);
       break;
     case 2020: /* S01S12S23S03 */
       isnCnt = 4;
-      *(tIsn + 0) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
-      *(tIsn + 3) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 2, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 3, 0, 3);
       break;
     case 2021: /* V0S12S23 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 0);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 2, 3);
       break;
     case 2022: /* S02S12S23 */
       isnCnt = 3;
-      *(tIsn + 0) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 2), *(tVal + 3),
-					 *(tPos + 2), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 2, 3);
       break;
     case 2100: /* V2S03S13 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 2);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 2, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 3);
       break;
     case 2101: /* V2V0S13 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 2);
-      *(tIsn + 1) = *(tPos + 0);
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 2, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 3);
       break;
     case 2102: /* V2S01S13 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 2);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 2, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 3);
       break;
     case 2110: /* V1V2S03 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 1);
-      *(tIsn + 1) = *(tPos + 2);
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 2, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 3);
       break;
     case 2111: /* V0V1V2 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 0);
-      *(tIsn + 1) = *(tPos + 1);
-      *(tIsn + 2) = *(tPos + 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 2, 2);
       break;
     case 2112: /* No intersection */
       break;
     case 2120: /* V2S03S01 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 2);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 2, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 1);
       break;
     case 2121: /* No intersection */
       break;
@@ -4853,39 +5642,28 @@ static WlzErrorNum WlzContourIsoTet3D(WlzContour *ctr,
       break;
     case 2200: /* S02S03S13S12 */
       isnCnt = 4;
-      *(tIsn + 0) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
-      *(tIsn + 3) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 3, 1, 2);
       break;
     case 2201: /* V0S13S12 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 0);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 0);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 2);
       break;
     case 2202: /* S01S13S12 */
       isnCnt = 3;
-      *(tIsn + 0) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 3),
-					 *(tPos + 1), *(tPos + 3));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 1), *(tVal + 2),
-					 *(tPos + 1), *(tPos + 2));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 1, 3);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 1, 2);
       break;
     case 2210: /* V1S02S03 */
       isnCnt = 3;
-      *(tIsn + 0) = *(tPos + 1);
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 1, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 3);
       break;
     case 2211: /* No intersection */
       break;
@@ -4893,12 +5671,9 @@ static WlzErrorNum WlzContourIsoTet3D(WlzContour *ctr,
       break;
     case 2220: /* S01S02S03 */
       isnCnt = 3;
-      *(tIsn + 0) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 1),
-					 *(tPos + 0), *(tPos + 1));
-      *(tIsn + 1) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 2),
-					 *(tPos + 0), *(tPos + 2));
-      *(tIsn + 2) = WlzContourItpTetSide(*(tVal + 0), *(tVal + 3),
-					 *(tPos + 0), *(tPos + 3));
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 0, 0, 1);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 1, 0, 2);
+      WlzContourIsoTetIsn(tIsn, tSd, tVal, tPos, 2, 0, 3);
       break;
     case 2221: /* No intersection */
       break;
@@ -4917,6 +5692,34 @@ static WlzErrorNum WlzContourIsoTet3D(WlzContour *ctr,
       tVP0->vtZ += cbOrg.vtZ;
       ++tVP0;
     }
+    /* Key each intersection by the lattice points at the ends of the
+     * intersected side, in increasing order. Intersections at a vertex
+     * of the tetrahedron have both ends at the vertex. */
+    keyFlg = (spxBuf != NULL) && (spxBuf->useKey != 0);
+    if(keyFlg)
+    {
+      for(idx = 0; idx < isnCnt; ++idx)
+      {
+	WlzIVertex3 *k;
+
+	k = tKey + (2 * idx);
+	WLZ_VTX_3_ADD(tV0, cbOrg, tPos[tSd[2 * idx]]);
+	WLZ_VTX_3_NINT(k[0], tV0);
+	WLZ_VTX_3_ADD(tV0, cbOrg, tPos[tSd[(2 * idx) + 1]]);
+	WLZ_VTX_3_NINT(k[1], tV0);
+	if((k[1].vtZ < k[0].vtZ) ||
+	   ((k[1].vtZ == k[0].vtZ) &&
+	    ((k[1].vtY < k[0].vtY) ||
+	     ((k[1].vtY == k[0].vtY) && (k[1].vtX < k[0].vtX)))))
+	{
+	  WlzIVertex3 t;
+
+	  t = k[0];
+	  k[0] = k[1];
+	  k[1] = t;
+	}
+      }
+    }
     if(isnCnt == 4)
     {
       /* Split quadrilaterals into triangles along the shortest diagonal.
@@ -4939,15 +5742,33 @@ static WlzErrorNum WlzContourIsoTet3D(WlzContour *ctr,
 	sIsn[2] = tIsn[3];
 	tIsn[2] = tIsn[3];
       }
-      if((errNum = WlzGMModelConstructSimplex3D(ctr->model,
-      						tIsn)) == WLZ_ERR_NONE)
+      if(keyFlg)
+      {
+        /* Split the keys in the same way. */
+        idx = (tD0 < tD1)? 0: 2;
+	sKey[0] = tKey[idx];
+	sKey[1] = tKey[idx + 1];
+	sKey[2] = tKey[4];
+	sKey[3] = tKey[5];
+	sKey[4] = tKey[6];
+	sKey[5] = tKey[7];
+	if(idx != 0)
+	{
+	  tKey[4] = tKey[6];
+	  tKey[5] = tKey[7];
+	}
+      }
+      if((errNum = WlzContourSpx3DAdd(ctr, spxBuf, tIsn,
+      				      (keyFlg)? tKey: NULL)) == WLZ_ERR_NONE)
       {
-        errNum = WlzGMModelConstructSimplex3D(ctr->model, sIsn);
+        errNum = WlzContourSpx3DAdd(ctr, spxBuf, sIsn,
+				    (keyFlg)? sKey: NULL);
       }
     }
     else
     {
-      errNum = WlzGMModelConstructSimplex3D(ctr->model, tIsn);
+      errNum = WlzContourSpx3DAdd(ctr, spxBuf, tIsn,
+      				  (keyFlg)? tKey: NULL);
     }
 #ifdef WLZ_CONTOUR_DEBUG
     (void )fprintf(stderr,
@@ -4993,6 +5814,35 @@ static WlzDVertex2 WlzContourItpTriSide(double valOrg, double valDst,
   return(itp);
 }
 
+/*!
+* \ingroup	WlzContour
+* \brief	Sets an intersection of a tetrahedron with the
+* 		iso-value surface. The intersection is either on the
+* 		side between two vertices of the tetrahedron, or at a
+* 		vertex if the two vertex indices are the same. The
+* 		indices of the two vertices are also recorded.
+* \param	tIsn			Intersections of the tetrahedron.
+* \param	tSd			Tetrahedron vertex indices of the
+* 					intersections, two per intersection.
+* \param	tVal			Values wrt the iso-value at the
+*                                       verticies of the tetrahedron.
+* \param	tPos			Positions of the tetrahedron
+*                                       verticies wrt the cube's origin.
+* \param	idx			Index of the intersection.
+* \param	v0			Index of the first vertex.
+* \param	v1			Index of the second vertex.
+*/
+static void	WlzContourIsoTetIsn(WlzDVertex3 *tIsn, int *tSd,
+				    double *tVal, WlzDVertex3 *tPos,
+				    int idx, int v0, int v1)
+{
+  tIsn[idx] = (v0 == v1)? tPos[v0]:
+  			  WlzContourItpTetSide(tVal[v0], tVal[v1],
+			  		       tPos[v0], tPos[v1]);
+  tSd[2 * idx] = v0;
+  tSd[(2 * idx) + 1] = v1;
+}
+
 /*!
 * \return				Position of intersection with
 *                                       side.
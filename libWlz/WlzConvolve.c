@@ -40,8 +40,126 @@ static char _WlzConvolve_c[] = "University of Edinburgh $Id$";
 */
 
 #include <stdlib.h>
+#include <math.h>
 #include <Wlz.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \def		WLZ_CONVOLVE_FFT_MAX
+* \ingroup	WlzValuesFilters
+* \brief	Maximum number of elements in each padded FFT array for
+*		the FFT method to be chosen automatically. The FFT method
+*		needs two double arrays of this size, ie 256Mb at the
+*		limit, while the direct and separable methods only hold
+*		the planes needed by the kernel.
+*/
+#define WLZ_CONVOLVE_FFT_MAX	(1<<24)
+
+/*!
+* \struct	_WlzConvolveWSp
+* \ingroup	WlzValuesFilters
+* \brief	Work space for the convolution of a 2D or 3D domain
+* 		object's values by a (possibly 3D) kernel.
+*		Typedef: ::WlzConvolveWSp.
+*/
+typedef struct _WlzConvolveWSp
+{
+  WlzIVertex3	kSz;			/*!< Kernel size, all components
+  					     odd. */
+  WlzIVertex3	kRad;			/*!< Kernel half size, ie
+  					     (kSz - 1) / 2. */
+  double	*krn;			/*!< Kernel values with column
+  					     index varying fastest and then
+					     line index. */
+  double	*sep;			/*!< Separable kernel with the
+  					     column, line and then plane
+					     vectors, or NULL if the kernel
+					     is not separable. */
+  double	div;			/*!< Divisor applied to the
+  					     convolution sums. */
+  double	offset;			/*!< Offset added after division. */
+  int		modFlg;			/*!< Take the absolute value after
+  					     the offset if non-zero. */
+  int		intFlg;			/*!< Use integer division (with
+  					     truncation) if non-zero. */
+  double	bkg;			/*!< Background value used outside
+  					     of the object's domain. */
+  WlzGreyType	gType;			/*!< Grey type of the object. */
+  WlzIBox3	bBox;			/*!< Bounding box of the object. */
+  WlzIVertex3	bSz;			/*!< Size of the bounding box. */
+  WlzIVertex2	pSz;			/*!< Size of the kernel padded
+  					     plane buffers. */
+  int		nThr;			/*!< Number of threads. */
+} WlzConvolveWSp;
+
+static int			WlzConvolveKrnSeparable(
+				  WlzConvolveWSp *wSp);
+static WlzConvolveMethod	WlzConvolveChooseMethod(
+				  WlzConvolveWSp *wSp,
+				  WlzConvolveMethod method,
+				  WlzIVertex3 *dstFSz);
+static void			WlzConvolveScale(
+				  WlzConvolveWSp *wSp,
+				  double *buf,
+				  size_t n);
+static void			WlzConvolvePlaneDirect(
+				  WlzConvolveWSp *wSp,
+				  double **src,
+				  double *dst);
+static void			WlzConvolvePlaneSepXY(
+				  WlzConvolveWSp *wSp,
+				  double *src,
+				  double *dst,
+				  double *rowBuf);
+static void			WlzConvolvePlaneSepZ(
+				  WlzConvolveWSp *wSp,
+				  double **src,
+				  double *dst);
+static WlzObject		*WlzConvolvePlaneObj(
+				  WlzObject *obj,
+				  int pln,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzConvolveReadPlane(
+				  WlzConvolveWSp *wSp,
+				  WlzObject *obj,
+				  int pln,
+				  double *buf,
+				  int bufW,
+				  WlzIVertex2 bufOff);
+static WlzErrorNum		WlzConvolveWritePlane(
+				  WlzConvolveWSp *wSp,
+				  WlzObject *obj,
+				  int pln,
+				  double *buf);
+static WlzErrorNum		WlzConvolveLoadPlane(
+				  WlzConvolveWSp *wSp,
+				  WlzObject *obj,
+				  int pln,
+				  double *dst,
+				  double *raw,
+				  double *rowBuf,
+				  int sepFlg);
+static WlzErrorNum		WlzConvolveObjSpace(
+				  WlzConvolveWSp *wSp,
+				  WlzObject *inObj,
+				  WlzObject *outObj,
+				  int sepFlg);
+static WlzErrorNum		WlzConvolveObjFFT(
+				  WlzConvolveWSp *wSp,
+				  WlzObject *inObj,
+				  WlzObject *outObj,
+				  WlzIVertex3 fSz);
+static WlzObject		*WlzConvolveObjEng(
+				  WlzObject *inObj,
+				  WlzConvolveWSp *wSp,
+				  WlzConvolveMethod method,
+				  int newObjFlag,
+				  WlzErrorNum *dstErr);
+
+
 /*!
 * \return	Convolved pixel value.
 * \ingroup	WlzValuesFilters
@@ -103,13 +221,34 @@ int 		WlzConvolveSeqParFn(WlzSeqParWSpace *spWSpace,
 /*!
 * \return	Convolved object or NULL on error.
 * \ingroup	WlzValuesFilters
-* \brief	Performs a general space-domain convolution using WlzSeqPar().
-*		Only objects with WLZ_EMPTY_OBJ and WLZ_2D_DOMAINOBJ
-*               types are valid. WLZ_2D_DOMAINOBJ ojects must have
-*               non null domain and values fields, and only integral
-*               values (ie int, short or WlzUByte) are valid.
+* \brief	Performs a general space-domain convolution of a 2D or
+*		3D domain object's values by the given 2D convolution
+*		mask. For 3D objects the mask is applied to each of
+*		the planes.
+*		Objects with WLZ_EMPTY_OBJ, WLZ_2D_DOMAINOBJ and
+*		WLZ_3D_DOMAINOBJ types are valid. Domain objects must
+*		have non null domain and values fields and the values
+*		must be of a scalar grey type (ie int, short, WlzUByte,
+*		float or double) in a non-tiled value table.
+*		Values outside of the object's domain are taken to be
+*		the object's background value. The mask is applied
+*		without reflection, so that the mask element at
+*		column \f$i\f$, line \f$j\f$ multiplies the value with
+*		offset \f$(i - (x_{size} - 1)/2, j - (y_{size} - 1)/2)\f$
+*		from the current pixel.
+*		For WLZ_CONVOLVE_INT masks the mask values are int and
+*		when the object values are integral the scaled values
+*		are computed with integer division. For
+*		WLZ_CONVOLVE_FLOAT masks the mask values are double
+*		(the mask is cast to int * in the convolution data
+*		structure). Results are rounded and clamped to the
+*		grey type of the given object.
+*		The convolution is computed using WlzConvolveObjKernel()'s
+*		engine with the method chosen automatically.
 * \param	inObj			Given object.
-* \param	conv			Convolution data structure.
+* \param	conv			Convolution data structure, the
+*					mask dimensions must be odd and the
+*					divisor must be non-zero.
 * \param	newObjFlag		If zero the convolution is done
 *					in place, else a new object is created.
 * \param	dstErr			Destination error pointer, may be NULL.
@@ -117,11 +256,12 @@ int 		WlzConvolveSeqParFn(WlzSeqParWSpace *spWSpace,
 WlzObject 	*WlzConvolveObj(WlzObject *inObj, WlzConvolution *conv,
 			        int newObjFlag, WlzErrorNum *dstErr)
 {
-  int		bkgIntVal,
-  		convSize;
+  int		idx,
+  		nKrn;
+  double	*krn = NULL;
   WlzObject 	*outObj = NULL;
+  WlzConvolveWSp wSp;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
-  WlzPixelV	bkgVal;
 
   WLZ_DBG((WLZ_DBG_LVL_FN|WLZ_DBG_LVL_1),
   	  ("WlzConvolveObj FE %p %p %d\n",
@@ -130,57 +270,52 @@ WlzObject 	*WlzConvolveObj(WlzObject *inObj, WlzConvolution *conv,
   {
     errNum = WLZ_ERR_OBJECT_NULL;
   }
-  else if(inObj->domain.core == NULL)
+  else if((conv->type != WLZ_CONVOLVE_INT) &&
+          (conv->type != WLZ_CONVOLVE_FLOAT))
   {
-    errNum = WLZ_ERR_DOMAIN_NULL;
+    errNum = WLZ_ERR_GREY_DATA;
   }
-  else if(inObj->values.core == NULL)
+  else if(inObj->type == WLZ_EMPTY_OBJ)
   {
-    errNum = WLZ_ERR_VALUES_NULL;
+    outObj = (newObjFlag)? WlzMakeEmpty(&errNum): inObj;
   }
-  else if(WlzGreyTableIsTiled(inObj->values.core->type))
+  else if((conv->cv == NULL) || (conv->divscale == 0) ||
+          (conv->xsize < 1) || ((conv->xsize & 1) == 0) ||
+          (conv->ysize < 1) || ((conv->ysize & 1) == 0))
   {
-    errNum = WLZ_ERR_VALUES_TYPE;
-  }
-  else if(conv->type != WLZ_CONVOLVE_INT)
-  {
-    errNum = WLZ_ERR_GREY_DATA;
+    errNum = WLZ_ERR_PARAM_DATA;
   }
   else
   {
-    switch(inObj->type)
+    nKrn = conv->xsize * conv->ysize;
+    if((krn = (double *)AlcMalloc(nKrn * sizeof(double))) == NULL)
     {
-      case WLZ_EMPTY_OBJ:
-	outObj = (newObjFlag)? WlzMakeEmpty(&errNum): inObj;
-	break;
-      case WLZ_2D_DOMAINOBJ:
-	bkgVal = WlzGetBackground(inObj, &errNum);
-	switch(bkgVal.type)
-	{
-	  case WLZ_GREY_INT:
-	    bkgIntVal = bkgVal.v.inv;
-	    break;
-	  case WLZ_GREY_SHORT:
-	    bkgIntVal = bkgVal.v.shv;
-	    break;
-	  case WLZ_GREY_UBYTE:
-	    bkgIntVal = bkgVal.v.ubv;
-	    break;
-	  default:
-	    errNum = WLZ_ERR_GREY_DATA;
-	    break;
-	}
-	if(errNum == WLZ_ERR_NONE)
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      if(conv->type == WLZ_CONVOLVE_INT)
+      {
+	for(idx = 0; idx < nKrn; ++idx)
 	{
-	  convSize = (WLZ_MAX(conv->xsize, conv->ysize) - 1) / 2;
-	  outObj = WlzSeqPar(inObj, newObjFlag, 0, WLZ_RASTERDIR_ILIC,
-			     convSize, bkgIntVal,
-			     (void *)conv, WlzConvolveSeqParFn, &errNum);
+	  krn[idx] = conv->cv[idx];
 	}
-	break;
-      default:
-        errNum = WLZ_ERR_OBJECT_TYPE;
-	break;
+      }
+      else
+      {
+        WlzValueCopyDoubleToDouble(krn, (double *)(conv->cv), nKrn);
+      }
+      wSp.kSz.vtX = conv->xsize;
+      wSp.kSz.vtY = conv->ysize;
+      wSp.kSz.vtZ = 1;
+      wSp.krn = krn;
+      wSp.div = conv->divscale;
+      wSp.offset = conv->offset;
+      wSp.modFlg = conv->modflag;
+      wSp.intFlg = (conv->type == WLZ_CONVOLVE_INT);
+      outObj = WlzConvolveObjEng(inObj, &wSp, WLZ_CONVOLVE_METHOD_AUTO,
+      				 newObjFlag, &errNum);
+      AlcFree(krn);
     }
   }
   if( dstErr )
@@ -193,6 +328,89 @@ WlzObject 	*WlzConvolveObj(WlzObject *inObj, WlzConvolution *conv,
   return(outObj);
 }
 
+/*!
+* \return	Convolved object or NULL on error.
+* \ingroup	WlzValuesFilters
+* \brief	Convolves the values of a 2D or 3D domain object with the
+*		given 3D kernel of double values. Values outside of the
+*		object's domain are taken to be the object's background
+*		value and the convolved values are rounded and clamped
+*		to the grey type of the given object, which must be a
+*		scalar grey type (ie int, short, WlzUByte, float or
+*		double) in a non-tiled value table.
+*		As for WlzConvolveObj() the kernel is applied without
+*		reflection, ie the kernel element at (i, j, k) multiplies
+*		the value offset by
+*		\f$(i - r_x, j - r_y, k - r_z)\f$ from the current voxel,
+*		where \f$r = (s - 1) / 2\f$ for kernel size \f$s\f$.
+*		A 2D object is treated as a single plane with background
+*		valued planes above and below it.
+*		The convolution may be computed by one of the methods:
+*		<ul>
+*		<li> WLZ_CONVOLVE_METHOD_DIRECT: the full kernel is
+*		     applied to each line of the object's bounding box
+*		     in turn, skipping zero kernel values.
+*		<li> WLZ_CONVOLVE_METHOD_SEPARABLE: if the kernel has
+*		     rank one it is factored into column, line and plane
+*		     vectors which are applied in turn, otherwise the
+*		     direct method is used.
+*		<li> WLZ_CONVOLVE_METHOD_FFT: the convolution is computed
+*		     using the FFT of the padded bounding box, which
+*		     requires memory for two double arrays the size of
+*		     the padded bounding box.
+*		<li> WLZ_CONVOLVE_METHOD_AUTO: the method is chosen using
+*		     an estimate of the cost of each method, but the FFT
+*		     method is only chosen if it's arrays are not too
+*		     large and the space domain methods are used if
+*		     it's arrays can not be allocated.
+*		</ul>
+*		The direct and separable methods only keep the planes
+*		needed by the kernel in memory.
+* \param	inObj			Given object.
+* \param	kSz			Size of the kernel, all components
+*					must be odd.
+* \param	krn			Kernel values with the column index
+*					varying fastest, then the line index
+*					and then the plane index.
+* \param	method			Convolution method.
+* \param	newObjFlag		If zero the convolution is done
+*					in place, else a new object is created.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzConvolveObjKernel(WlzObject *inObj, WlzIVertex3 kSz,
+				      double *krn, WlzConvolveMethod method,
+				      int newObjFlag, WlzErrorNum *dstErr)
+{
+  WlzObject	*outObj = NULL;
+  WlzConvolveWSp wSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(inObj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(inObj->type == WLZ_EMPTY_OBJ)
+  {
+    outObj = (newObjFlag)? WlzMakeEmpty(&errNum): inObj;
+  }
+  else
+  {
+    wSp.kSz = kSz;
+    wSp.krn = krn;
+    wSp.div = 1.0;
+    wSp.offset = 0.0;
+    wSp.modFlg = 0;
+    wSp.intFlg = 0;
+    outObj = WlzConvolveObjEng(inObj, &wSp, method, newObjFlag, &errNum);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(outObj);
+}
+
+
 /*!
 * \return	Sum of convolution values.
 * \ingroup	WlzValuesFilters
@@ -241,3 +459,990 @@ int		WlzConvolutionNormalise(WlzConvolution *conv)
   }
   return(sum);
 }
+
+/*!
+* \return	Convolved object or NULL on error.
+* \ingroup	WlzValuesFilters
+* \brief	Convolution engine for WlzConvolveObj() and
+*		WlzConvolveObjKernel(). The kernel, its size and the
+*		scaling parameters must be set in the given work space,
+*		all other fields are set by this function.
+* \param	inObj			Given 2D or 3D domain object.
+* \param	wSp			Convolution work space.
+* \param	method			Requested convolution method.
+* \param	newObjFlag		If zero the convolution is done
+*					in place, else a new object is created.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzConvolveObjEng(WlzObject *inObj, WlzConvolveWSp *wSp,
+				    WlzConvolveMethod method, int newObjFlag,
+				    WlzErrorNum *dstErr)
+{
+  int		autoFlg;
+  WlzIVertex3	fSz;
+  WlzObjectType	tType;
+  WlzPixelV	bgdV,
+  		dBgdV;
+  WlzObject	*outObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  wSp->sep = NULL;
+  if(inObj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if((inObj->type != WLZ_2D_DOMAINOBJ) &&
+          (inObj->type != WLZ_3D_DOMAINOBJ))
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if(inObj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(inObj->values.core == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(WlzGreyTableIsTiled(inObj->values.core->type))
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else if((wSp->krn == NULL) || (wSp->div == 0.0) ||
+          (wSp->kSz.vtX < 1) || ((wSp->kSz.vtX & 1) == 0) ||
+          (wSp->kSz.vtY < 1) || ((wSp->kSz.vtY & 1) == 0) ||
+          (wSp->kSz.vtZ < 1) || ((wSp->kSz.vtZ & 1) == 0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    wSp->gType = WlzGreyTypeFromObj(inObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(wSp->gType)
+    {
+      case WLZ_GREY_INT:   /* FALLTHROUGH */
+      case WLZ_GREY_SHORT: /* FALLTHROUGH */
+      case WLZ_GREY_UBYTE:
+        break;
+      case WLZ_GREY_FLOAT: /* FALLTHROUGH */
+      case WLZ_GREY_DOUBLE:
+        wSp->intFlg = 0;
+	break;
+      default:
+        errNum = WLZ_ERR_GREY_DATA;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bgdV = WlzGetBackground(inObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    dBgdV = bgdV;
+    errNum = WlzValueConvertPixel(&dBgdV, bgdV, WLZ_GREY_DOUBLE);
+    wSp->bkg = dBgdV.v.dbv;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    wSp->bBox = WlzBoundingBox3I(inObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(inObj->type == WLZ_2D_DOMAINOBJ)
+    {
+      wSp->bBox.zMin = wSp->bBox.zMax = 0;
+    }
+    wSp->kRad.vtX = (wSp->kSz.vtX - 1) / 2;
+    wSp->kRad.vtY = (wSp->kSz.vtY - 1) / 2;
+    wSp->kRad.vtZ = (wSp->kSz.vtZ - 1) / 2;
+    wSp->bSz.vtX = wSp->bBox.xMax - wSp->bBox.xMin + 1;
+    wSp->bSz.vtY = wSp->bBox.yMax - wSp->bBox.yMin + 1;
+    wSp->bSz.vtZ = wSp->bBox.zMax - wSp->bBox.zMin + 1;
+    wSp->pSz.vtX = wSp->bSz.vtX + (2 * wSp->kRad.vtX);
+    wSp->pSz.vtY = wSp->bSz.vtY + (2 * wSp->kRad.vtY);
+    wSp->nThr = 1;
+#ifdef _OPENMP
+    wSp->nThr = omp_get_max_threads();
+#endif
+    if((wSp->sep = (double *)AlcMalloc(sizeof(double) *
+    				       (wSp->kSz.vtX + wSp->kSz.vtY +
+				        wSp->kSz.vtZ))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else if(WlzConvolveKrnSeparable(wSp) == 0)
+    {
+      AlcFree(wSp->sep);
+      wSp->sep = NULL;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    autoFlg = method == WLZ_CONVOLVE_METHOD_AUTO;
+    method = WlzConvolveChooseMethod(wSp, method, &fSz);
+    if(newObjFlag)
+    {
+      tType = WlzGreyTableType(WLZ_GREY_TAB_RAGR, wSp->gType, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        outObj = WlzNewObjectValues(inObj, tType, bgdV, 0, bgdV, &errNum);
+      }
+    }
+    else
+    {
+      outObj = inObj;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(method == WLZ_CONVOLVE_METHOD_FFT)
+    {
+      errNum = WlzConvolveObjFFT(wSp, inObj, outObj, fSz);
+      /* If the FFT method was chosen automatically but there isn't
+       * enough memory for it, fall back to the space domain. */
+      if(autoFlg && (errNum == WLZ_ERR_MEM_ALLOC))
+      {
+        method = (wSp->sep)? WLZ_CONVOLVE_METHOD_SEPARABLE:
+			     WLZ_CONVOLVE_METHOD_DIRECT;
+	errNum = WLZ_ERR_NONE;
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && (method != WLZ_CONVOLVE_METHOD_FFT))
+    {
+      errNum = WlzConvolveObjSpace(wSp, inObj, outObj,
+				   method == WLZ_CONVOLVE_METHOD_SEPARABLE);
+    }
+  }
+  AlcFree(wSp->sep);
+  wSp->sep = NULL;
+  if((errNum != WLZ_ERR_NONE) && (outObj != NULL))
+  {
+    if(outObj != inObj)
+    {
+      (void )WlzFreeObj(outObj);
+    }
+    outObj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(outObj);
+}
+
+/*!
+* \return	Non-zero if the kernel is separable.
+* \ingroup	WlzValuesFilters
+* \brief	Tests whether the work space's kernel has rank one, in
+*		which case the column, line and plane vectors of the
+*		kernel are set in the work space's separable kernel
+*		array. The vectors are taken through the kernel element
+*		with the greatest magnitude, with the line and plane
+*		vectors normalised by this element.
+* \param	wSp			Convolution work space with the
+*					kernel and an allocated separable
+*					kernel array.
+*/
+static int	WlzConvolveKrnSeparable(WlzConvolveWSp *wSp)
+{
+  int		idX,
+  		idY,
+		idZ,
+		mX,
+		mY,
+		mZ,
+		sepFlg = 0;
+  size_t	idx,
+  		idM = 0,
+		nK;
+  double	p,
+  		tol;
+  double	*kX,
+  		*kY,
+		*kZ;
+  const double	eps = 1.0e-12;
+
+  nK = (size_t )(wSp->kSz.vtX) * wSp->kSz.vtY * wSp->kSz.vtZ;
+  for(idx = 1; idx < nK; ++idx)
+  {
+    if(fabs(wSp->krn[idx]) > fabs(wSp->krn[idM]))
+    {
+      idM = idx;
+    }
+  }
+  p = wSp->krn[idM];
+  if(p != 0.0)
+  {
+    sepFlg = 1;
+    mX = idM % wSp->kSz.vtX;
+    mY = (idM / wSp->kSz.vtX) % wSp->kSz.vtY;
+    mZ = idM / ((size_t )(wSp->kSz.vtX) * wSp->kSz.vtY);
+    kX = wSp->sep;
+    kY = kX + wSp->kSz.vtX;
+    kZ = kY + wSp->kSz.vtY;
+    for(idX = 0; idX < wSp->kSz.vtX; ++idX)
+    {
+      kX[idX] = wSp->krn[(mZ * wSp->kSz.vtY + mY) * wSp->kSz.vtX + idX];
+    }
+    for(idY = 0; idY < wSp->kSz.vtY; ++idY)
+    {
+      kY[idY] = wSp->krn[(mZ * wSp->kSz.vtY + idY) * wSp->kSz.vtX + mX] / p;
+    }
+    for(idZ = 0; idZ < wSp->kSz.vtZ; ++idZ)
+    {
+      kZ[idZ] = wSp->krn[(idZ * wSp->kSz.vtY + mY) * wSp->kSz.vtX + mX] / p;
+    }
+    idx = 0;
+    tol = eps * fabs(p);
+    for(idZ = 0; sepFlg && (idZ < wSp->kSz.vtZ); ++idZ)
+    {
+      for(idY = 0; sepFlg && (idY < wSp->kSz.vtY); ++idY)
+      {
+	for(idX = 0; sepFlg && (idX < wSp->kSz.vtX); ++idX)
+	{
+	  sepFlg = fabs(wSp->krn[idx++] - (kZ[idZ] * kY[idY] * kX[idX])) <=
+	           tol;
+	}
+      }
+    }
+  }
+  return(sepFlg);
+}
+
+/*!
+* \return	Convolution method to use.
+* \ingroup	WlzValuesFilters
+* \brief	Chooses the convolution method. If the given method is
+*		WLZ_CONVOLVE_METHOD_AUTO then the number of multiply-adds
+*		per voxel for the direct method (the number of non-zero
+*		kernel values) and the separable method (the sum of the
+*		kernel dimensions) are compared with an estimate of the
+*		equivalent cost of the FFT method. The FFT method is
+*		only chosen automatically if the padded FFT arrays have
+*		no more than WLZ_CONVOLVE_FFT_MAX elements. A separable
+*		method is only returned if the kernel is separable. The
+*		padded FFT array size is always set.
+* \param	wSp			Convolution work space.
+* \param	method			Requested method.
+* \param	dstFSz			Destination pointer for the padded
+*					FFT array size.
+*/
+static WlzConvolveMethod WlzConvolveChooseMethod(WlzConvolveWSp *wSp,
+						 WlzConvolveMethod method,
+						 WlzIVertex3 *dstFSz)
+{
+  size_t	idx,
+  		nK,
+  		nNZ = 0;
+  double	cDir,
+  		cSep,
+		cFFT,
+		nF;
+  WlzIVertex3	fSz;
+  const double	fftCost = 8.0;	  /* Approximate multiply-add equivalent of
+  				   * the FFT per element per log2(n). */
+
+  fSz.vtX = AlgFFTGoodSize(wSp->bSz.vtX + (2 * wSp->kRad.vtX), 0);
+  fSz.vtY = AlgFFTGoodSize(wSp->bSz.vtY + (2 * wSp->kRad.vtY), 0);
+  fSz.vtZ = AlgFFTGoodSize(wSp->bSz.vtZ + (2 * wSp->kRad.vtZ), 0);
+  switch(method)
+  {
+    case WLZ_CONVOLVE_METHOD_DIRECT:
+      break;
+    case WLZ_CONVOLVE_METHOD_SEPARABLE:
+      if(wSp->sep == NULL)
+      {
+        method = WLZ_CONVOLVE_METHOD_DIRECT;
+      }
+      break;
+    case WLZ_CONVOLVE_METHOD_FFT:
+      break;
+    default:
+      nK = (size_t )(wSp->kSz.vtX) * wSp->kSz.vtY * wSp->kSz.vtZ;
+      for(idx = 0; idx < nK; ++idx)
+      {
+        if(wSp->krn[idx] != 0.0)
+	{
+	  ++nNZ;
+	}
+      }
+      cDir = nNZ;
+      cSep = (wSp->sep)?
+             wSp->kSz.vtX + wSp->kSz.vtY + wSp->kSz.vtZ: cDir;
+      nF = (double )(fSz.vtX) * fSz.vtY * fSz.vtZ;
+      cFFT = fftCost * log(nF) / log(2.0) * nF /
+             ((double )(wSp->bSz.vtX) * wSp->bSz.vtY * wSp->bSz.vtZ);
+      if(cSep < cDir)
+      {
+        method = WLZ_CONVOLVE_METHOD_SEPARABLE;
+	cDir = cSep;
+      }
+      else
+      {
+        method = WLZ_CONVOLVE_METHOD_DIRECT;
+      }
+      if((cFFT < cDir) && (nF <= WLZ_CONVOLVE_FFT_MAX))
+      {
+        method = WLZ_CONVOLVE_METHOD_FFT;
+      }
+      break;
+  }
+  *dstFSz = fSz;
+  return(method);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesFilters
+* \brief	Applies the divisor, offset and modulus of the work space
+*		to the given convolution sums.
+* \param	wSp			Convolution work space.
+* \param	buf			Buffer of convolution sums.
+* \param	n			Number of values in the buffer.
+*/
+static void	WlzConvolveScale(WlzConvolveWSp *wSp, double *buf, size_t n)
+{
+  size_t	idx;
+  double	v;
+
+  if(wSp->intFlg)
+  {
+    for(idx = 0; idx < n; ++idx)
+    {
+      v = floor(buf[idx] + 0.5) / wSp->div;
+      v = ((v < 0.0)? ceil(v): floor(v)) + wSp->offset;
+      buf[idx] = (wSp->modFlg)? fabs(v): v;
+    }
+  }
+  else
+  {
+    for(idx = 0; idx < n; ++idx)
+    {
+      v = (buf[idx] / wSp->div) + wSp->offset;
+      buf[idx] = (wSp->modFlg)? fabs(v): v;
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesFilters
+* \brief	Convolves the given padded planes with the full kernel
+*		to give a single plane of convolution sums for the
+*		bounding box. The sums for each line are accumulated
+*		one kernel value at a time over the whole line.
+* \param	wSp			Convolution work space.
+* \param	src			Array of kSz.vtZ padded planes, each
+*					of pSz.vtX by pSz.vtY values.
+* \param	dst			Destination plane of bSz.vtX by
+*					bSz.vtY values.
+*/
+static void	WlzConvolvePlaneDirect(WlzConvolveWSp *wSp, double **src,
+				       double *dst)
+{
+  int		idY;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(wSp->nThr)
+#endif
+  for(idY = 0; idY < wSp->bSz.vtY; ++idY)
+  {
+    int		idX,
+    		kX,
+		kY,
+		kZ,
+		nX;
+    double	w;
+    double	*d,
+    		*k,
+		*s;
+
+    nX = wSp->bSz.vtX;
+    d = dst + (size_t )idY * nX;
+    for(idX = 0; idX < nX; ++idX)
+    {
+      d[idX] = 0.0;
+    }
+    k = wSp->krn;
+    for(kZ = 0; kZ < wSp->kSz.vtZ; ++kZ)
+    {
+      for(kY = 0; kY < wSp->kSz.vtY; ++kY)
+      {
+        for(kX = 0; kX < wSp->kSz.vtX; ++kX)
+	{
+	  if((w = *k++) != 0.0)
+	  {
+	    s = src[kZ] + ((size_t )(idY + kY) * wSp->pSz.vtX) + kX;
+	    for(idX = 0; idX < nX; ++idX)
+	    {
+	      d[idX] += w * s[idX];
+	    }
+	  }
+	}
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesFilters
+* \brief	Convolves a padded plane with the column and line vectors
+*		of a separable kernel.
+* \param	wSp			Convolution work space.
+* \param	src			Padded plane of pSz.vtX by pSz.vtY
+*					values.
+* \param	dst			Destination plane of bSz.vtX by
+*					bSz.vtY values.
+* \param	rowBuf			Buffer of pSz.vtX values for each
+*					thread.
+*/
+static void	WlzConvolvePlaneSepXY(WlzConvolveWSp *wSp, double *src,
+				      double *dst, double *rowBuf)
+{
+  int		idY;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(wSp->nThr)
+#endif
+  for(idY = 0; idY < wSp->bSz.vtY; ++idY)
+  {
+    int		idX,
+    		kX,
+		kY,
+		nX,
+		pX,
+		thrId = 0;
+    double	w;
+    double	*d,
+    		*r,
+		*s,
+		*sX,
+		*sY;
+
+#ifdef _OPENMP
+    thrId = omp_get_thread_num();
+#endif
+    nX = wSp->bSz.vtX;
+    pX = wSp->pSz.vtX;
+    sX = wSp->sep;
+    sY = sX + wSp->kSz.vtX;
+    r = rowBuf + (size_t )thrId * pX;
+    s = src + (size_t )idY * pX;
+    w = sY[0];
+    for(idX = 0; idX < pX; ++idX)
+    {
+      r[idX] = w * s[idX];
+    }
+    for(kY = 1; kY < wSp->kSz.vtY; ++kY)
+    {
+      if((w = sY[kY]) != 0.0)
+      {
+	s = src + (size_t )(idY + kY) * pX;
+	for(idX = 0; idX < pX; ++idX)
+	{
+	  r[idX] += w * s[idX];
+	}
+      }
+    }
+    d = dst + (size_t )idY * nX;
+    for(idX = 0; idX < nX; ++idX)
+    {
+      d[idX] = 0.0;
+    }
+    for(kX = 0; kX < wSp->kSz.vtX; ++kX)
+    {
+      if((w = sX[kX]) != 0.0)
+      {
+	s = r + kX;
+	for(idX = 0; idX < nX; ++idX)
+	{
+	  d[idX] += w * s[idX];
+	}
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesFilters
+* \brief	Convolves planes which have already been convolved with
+*		the column and line vectors of a separable kernel with
+*		the kernel's plane vector.
+* \param	wSp			Convolution work space.
+* \param	src			Array of kSz.vtZ planes, each of
+*					bSz.vtX by bSz.vtY values.
+* \param	dst			Destination plane of bSz.vtX by
+*					bSz.vtY values.
+*/
+static void	WlzConvolvePlaneSepZ(WlzConvolveWSp *wSp, double **src,
+				     double *dst)
+{
+  int		idY;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(wSp->nThr)
+#endif
+  for(idY = 0; idY < wSp->bSz.vtY; ++idY)
+  {
+    int		idX,
+		kZ,
+		nX;
+    size_t	off;
+    double	w;
+    double	*d,
+		*s,
+		*sZ;
+
+    nX = wSp->bSz.vtX;
+    sZ = wSp->sep + wSp->kSz.vtX + wSp->kSz.vtY;
+    off = (size_t )idY * nX;
+    d = dst + off;
+    for(idX = 0; idX < nX; ++idX)
+    {
+      d[idX] = 0.0;
+    }
+    for(kZ = 0; kZ < wSp->kSz.vtZ; ++kZ)
+    {
+      if((w = sZ[kZ]) != 0.0)
+      {
+	s = src[kZ] + off;
+	for(idX = 0; idX < nX; ++idX)
+	{
+	  d[idX] += w * s[idX];
+	}
+      }
+    }
+  }
+}
+
+/*!
+* \return	New 2D object or NULL if the plane is empty or on error.
+* \ingroup	WlzValuesFilters
+* \brief	Makes a 2D object for the given plane of a 2D or 3D
+*		domain object, sharing it's domain and values. The plane
+*		coordinate is ignored for 2D objects.
+* \param	obj			Given 2D or 3D domain object.
+* \param	pln			Plane coordinate.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzConvolvePlaneObj(WlzObject *obj, int pln,
+				      WlzErrorNum *dstErr)
+{
+  int		idP;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzObject	*pObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  if(obj->type == WLZ_2D_DOMAINOBJ)
+  {
+    dom = obj->domain;
+    val = obj->values;
+  }
+  else
+  {
+    idP = pln - obj->domain.p->plane1;
+    if((idP >= 0) && (pln <= obj->domain.p->lastpl))
+    {
+      dom = obj->domain.p->domains[idP];
+      val = obj->values.vox->values[idP];
+    }
+  }
+  if((dom.core != NULL) && (dom.core->type != WLZ_EMPTY_DOMAIN) &&
+     (val.core != NULL))
+  {
+    pObj = WlzAssignObject(
+	   WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL,
+		       &errNum), NULL);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(pObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Reads the values of a plane of the given object into a
+*		buffer which has already been filled with the background
+*		value. The value at the bounding box origin is placed at
+*		the given offset in the buffer.
+* \param	wSp			Convolution work space.
+* \param	obj			Given 2D or 3D domain object.
+* \param	pln			Plane coordinate.
+* \param	buf			Buffer for the values.
+* \param	bufW			Width of the buffer lines.
+* \param	bufOff			Column and line offset of the
+*					bounding box origin in the buffer.
+*/
+static WlzErrorNum WlzConvolveReadPlane(WlzConvolveWSp *wSp, WlzObject *obj,
+				        int pln, double *buf, int bufW,
+					WlzIVertex2 bufOff)
+{
+  WlzGreyP	dP;
+  WlzObject	*pObj;
+  WlzIntervalWSpace iWSp;
+  WlzGreyWSpace	gWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  pObj = WlzConvolvePlaneObj(obj, pln, &errNum);
+  if((errNum == WLZ_ERR_NONE) && (pObj != NULL))
+  {
+    errNum = WlzInitGreyScan(pObj, &iWSp, &gWSp);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+      {
+	dP.dbp = buf +
+		 ((size_t )(iWSp.linpos - wSp->bBox.yMin + bufOff.vtY) *
+		  bufW) + iWSp.lftpos - wSp->bBox.xMin + bufOff.vtX;
+	WlzValueCopyGreyToGrey(dP, 0, WLZ_GREY_DOUBLE,
+			       gWSp.u_grintptr, 0, gWSp.pixeltype,
+			       iWSp.colrmn);
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+	errNum = WLZ_ERR_NONE;
+      }
+      (void )WlzEndGreyScan(&iWSp, &gWSp);
+    }
+  }
+  (void )WlzFreeObj(pObj);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Writes the values of a plane of the bounding box into
+*		the given object, rounding and clamping them to the
+*		object's grey type.
+* \param	wSp			Convolution work space.
+* \param	obj			Given 2D or 3D domain object.
+* \param	pln			Plane coordinate.
+* \param	buf			Buffer of bSz.vtX by bSz.vtY values.
+*/
+static WlzErrorNum WlzConvolveWritePlane(WlzConvolveWSp *wSp, WlzObject *obj,
+				         int pln, double *buf)
+{
+  double	*sP;
+  WlzObject	*pObj;
+  WlzIntervalWSpace iWSp;
+  WlzGreyWSpace	gWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  pObj = WlzConvolvePlaneObj(obj, pln, &errNum);
+  if((errNum == WLZ_ERR_NONE) && (pObj != NULL))
+  {
+    errNum = WlzInitGreyScan(pObj, &iWSp, &gWSp);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+      {
+	sP = buf + ((size_t )(iWSp.linpos - wSp->bBox.yMin) * wSp->bSz.vtX) +
+	     iWSp.lftpos - wSp->bBox.xMin;
+	switch(gWSp.pixeltype)
+	{
+	  case WLZ_GREY_INT:
+	    WlzValueClampDoubleIntoInt(gWSp.u_grintptr.inp, sP, iWSp.colrmn);
+	    break;
+	  case WLZ_GREY_SHORT:
+	    WlzValueClampDoubleIntoShort(gWSp.u_grintptr.shp, sP,
+					 iWSp.colrmn);
+	    break;
+	  case WLZ_GREY_UBYTE:
+	    WlzValueClampDoubleIntoUByte(gWSp.u_grintptr.ubp, sP,
+					 iWSp.colrmn);
+	    break;
+	  case WLZ_GREY_FLOAT:
+	    WlzValueClampDoubleIntoFloat(gWSp.u_grintptr.flp, sP,
+					 iWSp.colrmn);
+	    break;
+	  case WLZ_GREY_DOUBLE:
+	    WlzValueCopyDoubleToDouble(gWSp.u_grintptr.dbp, sP, iWSp.colrmn);
+	    break;
+	  default:
+	    errNum = WLZ_ERR_GREY_TYPE;
+	    break;
+	}
+      }
+      if(errNum == WLZ_ERR_EOO)
+      {
+	errNum = WLZ_ERR_NONE;
+      }
+      (void )WlzEndGreyScan(&iWSp, &gWSp);
+    }
+  }
+  (void )WlzFreeObj(pObj);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Reads a plane of the given object into a padded plane
+*		buffer and if the kernel is separable convolves it
+*		with the kernel's column and line vectors. Planes outside
+*		of the object's bounding box have the background value.
+* \param	wSp			Convolution work space.
+* \param	obj			Given 2D or 3D domain object.
+* \param	pln			Plane coordinate.
+* \param	dst			Destination buffer, a padded plane
+*					of pSz.vtX by pSz.vtY values if not
+*					separable or else a plane of
+*					bSz.vtX by bSz.vtY values.
+* \param	raw			Buffer for a padded plane, only used
+*					if separable.
+* \param	rowBuf			Buffer of pSz.vtX values for each
+*					thread, only used if separable.
+* \param	sepFlg			Non-zero if the kernel is separable.
+*/
+static WlzErrorNum WlzConvolveLoadPlane(WlzConvolveWSp *wSp, WlzObject *obj,
+					int pln, double *dst, double *raw,
+					double *rowBuf, int sepFlg)
+{
+  size_t	idx,
+  		nP;
+  double	*buf;
+  WlzIVertex2	bufOff;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  buf = (sepFlg)? raw: dst;
+  nP = (size_t )(wSp->pSz.vtX) * wSp->pSz.vtY;
+  for(idx = 0; idx < nP; ++idx)
+  {
+    buf[idx] = wSp->bkg;
+  }
+  if((pln >= wSp->bBox.zMin) && (pln <= wSp->bBox.zMax))
+  {
+    bufOff.vtX = wSp->kRad.vtX;
+    bufOff.vtY = wSp->kRad.vtY;
+    errNum = WlzConvolveReadPlane(wSp, obj, pln, buf, wSp->pSz.vtX, bufOff);
+  }
+  if((errNum == WLZ_ERR_NONE) && sepFlg)
+  {
+    WlzConvolvePlaneSepXY(wSp, raw, dst, rowBuf);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Convolves the given object plane by plane in the spatial
+*		domain using either the direct or separable method.
+*		A ring buffer holds the kSz.vtZ planes (convolved with
+*		the column and line vectors if separable) needed for
+*		each output plane, so each input plane is only read and
+*		filtered once. Because all input planes needed for an
+*		output plane have been read before it is written the
+*		output object may be the input object.
+* \param	wSp			Convolution work space.
+* \param	inObj			Given 2D or 3D domain object.
+* \param	outObj			Object for the convolved values.
+* \param	sepFlg			Use the separable method if non-zero.
+*/
+static WlzErrorNum WlzConvolveObjSpace(WlzConvolveWSp *wSp,
+				       WlzObject *inObj, WlzObject *outObj,
+				       int sepFlg)
+{
+  int		idR,
+  		nR,
+		pln,
+		pln0;
+  size_t	nD,
+  		nS;
+  double	*dst = NULL,
+  		*raw = NULL,
+		*rowBuf = NULL,
+		*ringBuf = NULL;
+  double	**ring = NULL,
+  		**src = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nR = wSp->kSz.vtZ;
+  pln0 = wSp->bBox.zMin - wSp->kRad.vtZ;
+  nD = (size_t )(wSp->bSz.vtX) * wSp->bSz.vtY;
+  nS = (sepFlg)? nD: (size_t )(wSp->pSz.vtX) * wSp->pSz.vtY;
+  if(((ring = (double **)AlcMalloc(sizeof(double *) * nR)) == NULL) ||
+     ((src = (double **)AlcMalloc(sizeof(double *) * nR)) == NULL) ||
+     ((ringBuf = (double *)AlcMalloc(sizeof(double) * nR * nS)) == NULL) ||
+     ((dst = (double *)AlcMalloc(sizeof(double) * nD)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else if(sepFlg)
+  {
+    if(((raw = (double *)AlcMalloc(sizeof(double) *
+    				   wSp->pSz.vtX * wSp->pSz.vtY)) == NULL) ||
+       ((rowBuf = (double *)AlcMalloc(sizeof(double) *
+       				      wSp->nThr * wSp->pSz.vtX)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idR = 0; idR < nR; ++idR)
+    {
+      ring[idR] = ringBuf + (idR * nS);
+    }
+    /* Fill all but one of the ring buffer planes with the planes
+     * preceding the first output plane. */
+    for(pln = pln0; (errNum == WLZ_ERR_NONE) &&
+                    (pln < wSp->bBox.zMin + wSp->kRad.vtZ); ++pln)
+    {
+      errNum = WlzConvolveLoadPlane(wSp, inObj, pln,
+      				    ring[(pln - pln0) % nR], raw, rowBuf,
+				    sepFlg);
+    }
+    for(pln = wSp->bBox.zMin; (errNum == WLZ_ERR_NONE) &&
+                              (pln <= wSp->bBox.zMax); ++pln)
+    {
+      errNum = WlzConvolveLoadPlane(wSp, inObj, pln + wSp->kRad.vtZ,
+				    ring[(pln + wSp->kRad.vtZ - pln0) % nR],
+				    raw, rowBuf, sepFlg);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	for(idR = 0; idR < nR; ++idR)
+	{
+	  src[idR] = ring[(pln - wSp->kRad.vtZ + idR - pln0) % nR];
+	}
+	if(sepFlg)
+	{
+	  WlzConvolvePlaneSepZ(wSp, src, dst);
+	}
+	else
+	{
+	  WlzConvolvePlaneDirect(wSp, src, dst);
+	}
+	WlzConvolveScale(wSp, dst, nD);
+	errNum = WlzConvolveWritePlane(wSp, outObj, pln, dst);
+      }
+    }
+  }
+  AlcFree(ring);
+  AlcFree(src);
+  AlcFree(ringBuf);
+  AlcFree(dst);
+  AlcFree(raw);
+  AlcFree(rowBuf);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Convolves the given object using the FFT of it's padded
+*		bounding box, see AlgConvolveFFT3D().
+* \param	wSp			Convolution work space.
+* \param	inObj			Given 2D or 3D domain object.
+* \param	outObj			Object for the convolved values.
+* \param	fSz			Size of the FFT arrays which must
+*					be at least the size of the bounding
+*					box plus the kernel size less one.
+*/
+static WlzErrorNum WlzConvolveObjFFT(WlzConvolveWSp *wSp,
+				     WlzObject *inObj, WlzObject *outObj,
+				     WlzIVertex3 fSz)
+{
+  int		idY,
+  		kX,
+		kY,
+		kZ,
+		pln;
+  size_t	idx,
+  		nD,
+		nF;
+  double	w;
+  double	*dst = NULL;
+  double	***dat = NULL,
+  		***krn = NULL;
+  WlzIVertex2	bufOff;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nD = (size_t )(wSp->bSz.vtX) * wSp->bSz.vtY;
+  nF = (size_t )(fSz.vtX) * fSz.vtY * fSz.vtZ;
+  if((AlcDouble3Malloc(&dat, fSz.vtZ, fSz.vtY, fSz.vtX) != ALC_ER_NONE) ||
+     (AlcDouble3Malloc(&krn, fSz.vtZ, fSz.vtY, fSz.vtX) != ALC_ER_NONE) ||
+     ((dst = (double *)AlcMalloc(sizeof(double) * nD)) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idx = 0; idx < nF; ++idx)
+    {
+      dat[0][0][idx] = wSp->bkg;
+      krn[0][0][idx] = 0.0;
+    }
+    bufOff.vtX = wSp->kRad.vtX;
+    bufOff.vtY = wSp->kRad.vtY;
+    for(pln = wSp->bBox.zMin; (errNum == WLZ_ERR_NONE) &&
+                              (pln <= wSp->bBox.zMax); ++pln)
+    {
+      errNum = WlzConvolveReadPlane(wSp, inObj, pln,
+      				    dat[pln - wSp->bBox.zMin +
+				        wSp->kRad.vtZ][0],
+				    fSz.vtX, bufOff);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Place the reflected kernel in wrap-around order. */
+    idx = 0;
+    for(kZ = 0; kZ < wSp->kSz.vtZ; ++kZ)
+    {
+      for(kY = 0; kY < wSp->kSz.vtY; ++kY)
+      {
+	for(kX = 0; kX < wSp->kSz.vtX; ++kX)
+	{
+	  if((w = wSp->krn[idx++]) != 0.0)
+	  {
+	    krn[(fSz.vtZ - kZ + wSp->kRad.vtZ) % fSz.vtZ]
+	       [(fSz.vtY - kY + wSp->kRad.vtY) % fSz.vtY]
+	       [(fSz.vtX - kX + wSp->kRad.vtX) % fSz.vtX] = w;
+	  }
+	}
+      }
+    }
+    errNum = WlzErrorFromAlg(
+    	     AlgConvolveFFT3D(dat, krn, fSz.vtX, fSz.vtY, fSz.vtZ));
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(pln = wSp->bBox.zMin; (errNum == WLZ_ERR_NONE) &&
+                              (pln <= wSp->bBox.zMax); ++pln)
+    {
+      for(idY = 0; idY < wSp->bSz.vtY; ++idY)
+      {
+        WlzValueCopyDoubleToDouble(dst + (size_t )idY * wSp->bSz.vtX,
+				   dat[pln - wSp->bBox.zMin + wSp->kRad.vtZ]
+				      [idY + wSp->kRad.vtY] + wSp->kRad.vtX,
+				   wSp->bSz.vtX);
+      }
+      WlzConvolveScale(wSp, dst, nD);
+      errNum = WlzConvolveWritePlane(wSp, outObj, pln, dst);
+    }
+  }
+  if(dat)
+  {
+    (void )Alc3Free((void ***)dat);
+  }
+  if(krn)
+  {
+    (void )Alc3Free((void ***)krn);
+  }
+  AlcFree(dst);
+  return(errNum);
+}
@@ -58,13 +58,9 @@ WlzObject *WlzDiffDomain(
   WlzObject *obj2,
   WlzErrorNum	*dstErr)
 {
-  WlzIntervalWSpace	iwsp2, iwsp1;
-  WlzInterval		*intp;
-  WlzInterval 		*jntp;
   WlzDomain 		diffdom;
+  WlzDomain		doms[2];
   WlzValues		values;
-  WlzIntervalDomain 	*idom1;
-  int 			k1, dfinished, intervalcount;
   WlzObject 		*diff=NULL;
   WlzErrorNum		errNum=WLZ_ERR_NONE;
 
@@ -134,196 +130,23 @@ WlzObject *WlzDiffDomain(
   }
 
   /*
-   * make a new interval table that is big enough
+   * compute the difference domain using the interval set operation
+   * engine and attach the values of obj1
    */
   if( errNum == WLZ_ERR_NONE ){
-    idom1 = obj1->domain.i;
-    k1 = idom1->kol1;
-    if( (intp = (WlzInterval *)
-	 AlcCalloc(WlzIntervalCount(idom1, NULL) +
-		   WlzIntervalCount(obj2->domain.i, NULL),
-		   sizeof(WlzInterval))) == NULL ){
-      errNum = WLZ_ERR_MEM_ALLOC;
-    }
-    jntp = intp;
-  }
-
-  if( errNum == WLZ_ERR_NONE ){
-    if( (diffdom.i = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
-					   idom1->line1, idom1->lastln,
-					   k1, idom1->lastkl,
-					   &errNum)) == NULL ){
-      AlcFree((void *) intp);
-    }
-    else {
-      diffdom.i->freeptr = AlcFreeStackPush(diffdom.i->freeptr, (void *)intp,
-					    NULL);
-    }
-  }
-
-  if( errNum == WLZ_ERR_NONE ){
-    if( (diff = WlzMakeMain(WLZ_2D_DOMAINOBJ, diffdom, obj1->values,
-			    NULL, NULL, &errNum)) == NULL ){
-      WlzFreeIntervalDomain(diffdom.i);
-    }
-  }
-
-  /*
-   * initialise interval scanning
-   */
-  if( errNum == WLZ_ERR_NONE ){
-    errNum = WlzInitRasterScan(obj1, &iwsp1, WLZ_RASTERDIR_ILIC);
+    doms[0] = obj1->domain;
+    doms[1] = obj2->domain;
+    diffdom = WlzDomainSetOp2D(2, doms, WLZ_BO_SUBTRACT, &errNum);
   }
   if( errNum == WLZ_ERR_NONE ){
-    errNum = WlzInitRasterScan(obj2, &iwsp2, WLZ_RASTERDIR_ILIC);
-    dfinished = 0;
-    intervalcount = 0;
-  }
-
-  /*
-   * scan object constructing intervals after subtraction of obj2
-   */
-  if( (errNum == WLZ_ERR_NONE) &&
-     ((errNum = WlzNextInterval(&iwsp2)) == WLZ_ERR_NONE) ){
-
-    while( (errNum = WlzNextInterval(&iwsp1)) == WLZ_ERR_NONE ){
-      /*
-       * case 1 - interval in obj1 succedes interval in obj2 -
-       *	    get next interval of obj2
-       */
-      while( (errNum == WLZ_ERR_NONE) && (dfinished == 0) &&
-	     (iwsp1.linpos > iwsp2.linpos ||
-	      (iwsp1.linpos == iwsp2.linpos &&
-	       iwsp1.lftpos > iwsp2.rgtpos))){
-	switch( errNum = WlzNextInterval(&iwsp2) ){
-	case WLZ_ERR_NONE:
-	  dfinished = 0;
-	  break;
-	case WLZ_ERR_EOO:
-	  errNum = WLZ_ERR_NONE;
-	  dfinished = 1;
-	  break;
-	default:
-	  break;
-	}
-      }
-      if( errNum != WLZ_ERR_NONE ){
-	break;
-      }
-      /*
-     * case 2 - interval in obj1 precedes interval in obj2
-     *	    or obj2 finished - just copy interval
-     */
-      if( (dfinished != 0) ||
-	 (iwsp1.linpos < iwsp2.linpos ||
-	  ((iwsp1.linpos == iwsp2.linpos) &&
-	   (iwsp1.rgtpos < iwsp2.lftpos))
-	   )
-	){
-	jntp->ileft = iwsp1.lftpos - k1;
-	jntp->iright = iwsp1.rgtpos - k1;
-	intervalcount++;
-	jntp++;
-      }
-      /*
-     * case 3 - intervals overlap.
-     * there may be more than one obj2 interval.
-     */
-      else {
-	/*
-	 * test left end of obj1 interval < left
-	 * end of obj2 interval, when complete
-	 * interval can be constructed immediately
-	 */
-	if (iwsp2.lftpos > iwsp1.lftpos) {
-	  jntp->ileft = iwsp1.lftpos - k1;
-	  jntp->iright = iwsp2.lftpos -1 - k1;
-	  intervalcount++;
-	  jntp++;
-	}
-	do {
-	  /*
-	   * if right end of obj2 interval <
-	   * right end of obj1 interval can
-	   * plant left end of new interval
-	   */
-	  if (iwsp2.rgtpos < iwsp1.rgtpos) {
-	    jntp->ileft = iwsp2.rgtpos +1 - k1;
-	    switch( errNum = WlzNextInterval(&iwsp2) ){
-	    case WLZ_ERR_NONE:
-	      dfinished = 0;
-	      break;
-	    case WLZ_ERR_EOO:
-	      errNum = WLZ_ERR_NONE;
-	      dfinished = 1;
-	      break;
-	    default:
-	      break;
-	    }
-	    if( errNum != WLZ_ERR_NONE ){
-	      break;
-	    }
-	    
-	    /*
-	     * check if next obj2 interval
-	     * still overlaps this obj1 interval
-	     */
-	    if( (dfinished == 0) &&
-	       (iwsp1.linpos == iwsp2.linpos) &&
-	       (iwsp1.rgtpos >= iwsp2.lftpos))
-	      jntp->iright = iwsp2.lftpos -1 -k1;
-	    else
-	      jntp->iright = iwsp1.rgtpos - k1;
-	    intervalcount++;
-	    jntp++;
-	  }
-	} while( (dfinished == 0) && 
-		(iwsp1.linpos == iwsp2.linpos) &&
-		(iwsp1.rgtpos > iwsp2.rgtpos) );
-      }
-      if( errNum != WLZ_ERR_NONE ){
-	break;
-      }
-
-      /*
-     * is this obj1 interval the last in the line ?
-     * if so, load up the new intervals into the
-     * diff domain.
-     */
-      if (iwsp1.intrmn == 0) {
-	errNum = WlzMakeInterval(iwsp1.linpos, diffdom.i,
-				 intervalcount, intp);
-	intervalcount = 0;
-	intp = jntp;
-      }
-      if( errNum != WLZ_ERR_NONE ){
-	break;
-      }
-    }
-  }
-  if(errNum == WLZ_ERR_EOO) 	        /* Reset error from end of intervals */ 
-  {
-    errNum = WLZ_ERR_NONE;
-  }
-
-  /* this checks the area and returns NULL if zero
-     in principle it should return an "empty object" */
-  if(errNum == WLZ_ERR_NONE) {
-    if(WlzIntervalCount(diffdom.i, NULL) == 0){
-      WlzFreeObj(diff);
-      diffdom.i = NULL;
-      values.v = NULL;
+    if( diffdom.core == NULL ){
       diff = WlzMakeEmpty(&errNum);
     }
-    else {
-      WlzStandardIntervalDomain(diff->domain.i);
+    else if( (diff = WlzMakeMain(WLZ_2D_DOMAINOBJ, diffdom, obj1->values,
+				 NULL, NULL, &errNum)) == NULL ){
+      (void )WlzFreeDomain(diffdom);
     }
   }
-  else {
-    WlzFreeObj(diff);
-    diff = NULL;
-  }
-
   if( dstErr ){
     *dstErr = errNum;
   }
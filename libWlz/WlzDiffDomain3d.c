@@ -61,13 +61,13 @@ WlzObject *WlzDiffDomain3d(
   WlzErrorNum	*dstErr)
 {
   /* local variables */
-  WlzObject		*newobj, *obj, o1, o2;
-  WlzPlaneDomain	*newpdom, *oldpdom1, *oldpdom2;
+  WlzObject		*newobj;
+  WlzPlaneDomain	*newpdom;
   WlzVoxelValues	*newvdom, *oldvdom;
   WlzDomain		domain,
-  			nullDom;
+  			doms[2];
   WlzValues		values;
-  int			i, j, p;
+  int			i, p;
   WlzErrorNum		errNum=WLZ_ERR_NONE;
 
     /* Don't need to check objects because WlzDiffDomain3d is only accessed
@@ -75,107 +75,56 @@ WlzObject *WlzDiffDomain3d(
        in WlzProto.h and the procedure must not be called directly.
        We do need to check the planedomain type however */
   newobj = NULL;
-  nullDom.core = NULL;
+  newvdom = NULL;
+  domain.core = NULL;
   if( obj1->domain.core->type != WLZ_2D_DOMAINOBJ ){
     errNum = WLZ_ERR_DOMAIN_TYPE;
   }
-
   if( (errNum == WLZ_ERR_NONE) &&
      (obj1->domain.core->type != obj2->domain.core->type) ){
     errNum = WLZ_ERR_DOMAIN_TYPE;
   }
 
-  /* make a new object with same number of planes as obj1 */
+  /* find the new domains, the planes are computed in parallel */
   if( errNum == WLZ_ERR_NONE ){
-    oldpdom1 = (WlzPlaneDomain *) obj1->domain.p;
-    newpdom = WlzMakePlaneDomain(oldpdom1->type,
-				 oldpdom1->plane1, oldpdom1->lastpl,
-				 oldpdom1->line1, oldpdom1->lastln,
-				 oldpdom1->kol1, oldpdom1->lastkl,
-				 &errNum);
-    if( newpdom ){
-      for(i=0; i < 3; i++){
-	newpdom->voxel_size[i] = oldpdom1->voxel_size[i];
-      }
-    }
+    doms[0] = obj1->domain;
+    doms[1] = obj2->domain;
+    domain = WlzDomainSetOp3D(2, doms, WLZ_BO_SUBTRACT, &errNum);
   }
-
-  if( errNum == WLZ_ERR_NONE ){
-    if( obj1->values.core != NULL ){
-      oldvdom = obj1->values.vox;
-      newvdom = WlzMakeVoxelValueTb(oldvdom->type, oldvdom->plane1,
-				    oldvdom->lastpl,
-				    oldvdom->bckgrnd, NULL, &errNum);
-      if( newvdom ){
-	for(i=0; i < oldvdom->lastpl - oldvdom->plane1 + 1; i++){
-	  newvdom->values[i] = WlzAssignValues(oldvdom->values[i], NULL);
-	}
-      }
-    }
-    else {
-      newvdom = NULL;
-    }
+  if( (errNum == WLZ_ERR_NONE) && (domain.core == NULL) ){
+    return WlzMakeEmpty(dstErr);
   }
-    
-  /* find the new domains */
-  if( errNum == WLZ_ERR_NONE ){
-    oldpdom2 = obj2->domain.p;
-    o1.type = o2.type = WLZ_2D_DOMAINOBJ;
-    o1.linkcount = o2.linkcount = 0;
-    o1.values.core = o2.values.core = NULL;
-    o1.plist = o2.plist = NULL;
-    o1.assoc = o2.assoc = NULL;
-
-    for(p=newpdom->plane1, i=0; p <= newpdom->lastpl; p++, i++){
-
-      /* test for non-overlapping planes and make a copy */
-      if( p < oldpdom2->plane1 || p > oldpdom2->lastpl ){
-	newpdom->domains[i] = (oldpdom1->domains[i].core == NULL)? nullDom:
-	  WlzAssignDomain(WlzCopyDomain(oldpdom1->type, oldpdom1->domains[i],
-					&errNum), NULL);
-	continue;
-      }
 
-      /* test for NULL domain in obj1
-	 this will become an error - replaced by WLZ_EMPTY_DOMAIN */
-      if( oldpdom1->domains[i].core == NULL ){
-	newpdom->domains[i].core = NULL;
-	continue;
-      }
-
-      /* get corresponding planes */
-      j = p - oldpdom2->plane1;
-      o1.domain = oldpdom1->domains[i];
-      o2.domain = oldpdom2->domains[j];
-
-      /* test for NULL domain in obj2
-	 this will become an error - replaced by WLZ_EMPTY_DOMAIN */
-      if( oldpdom2->domains[j].core == NULL ){
-	newpdom->domains[i] =  (oldpdom1->domains[i].core == NULL)? nullDom:
-	  WlzAssignDomain(WlzCopyDomain(oldpdom1->type, oldpdom1->domains[i],
-					&errNum), NULL);
-	continue;
-      }
-
-      /* find difference domain */
-      if((obj = WlzDiffDomain( &o1, &o2, &errNum)) != NULL){
-	newpdom->domains[i] = WlzAssignDomain(obj->domain, NULL);
-	WlzFreeObj( obj );
-      }
-      else {
-	break;
+  /* share the values of obj1 on the planes of the difference */
+  if( (errNum == WLZ_ERR_NONE) && (obj1->values.core != NULL) ){
+    newpdom = domain.p;
+    oldvdom = obj1->values.vox;
+    newvdom = WlzMakeVoxelValueTb(oldvdom->type, newpdom->plane1,
+				  newpdom->lastpl,
+				  oldvdom->bckgrnd, NULL, &errNum);
+    if( newvdom ){
+      for(p=newpdom->plane1, i=0; p <= newpdom->lastpl; p++, i++){
+	if( newpdom->domains[i].core &&
+	    (p >= oldvdom->plane1) && (p <= oldvdom->lastpl) ){
+	  newvdom->values[i] =
+	    WlzAssignValues(oldvdom->values[p - oldvdom->plane1], NULL);
+	}
       }
     }
   }
-
   if( errNum == WLZ_ERR_NONE ){
-    WlzStandardPlaneDomain( newpdom, newvdom );
-    domain.p = newpdom;
     values.vox = newvdom;
     newobj = WlzMakeMain(WLZ_3D_DOMAINOBJ, domain, values,
 			 NULL, NULL, &errNum);
   }
-
+  if( newobj == NULL ){
+    if( newvdom ){
+      (void )WlzFreeVoxelValueTb(newvdom);
+    }
+    if( domain.core ){
+      (void )WlzFreePlaneDomain(domain.p);
+    }
+  }
   if( dstErr ){
     *dstErr = errNum;
   }
@@ -403,12 +403,11 @@ WlzErrorNum 	WlzDistMetricDirVertex2D(int n0, WlzDVertex2 *vx0,
 		mDist,
   		sDist,
 		iDist;
-  int		*iWSp = NULL;
-  double	*nnDist = NULL;
-  double	vxD2[2];
+  size_t	*nnIdx = NULL;
+  double	*qry = NULL,
+  		*nnDist = NULL;
   WlzVertexP	tVP;
-  AlcKDTNode    *tNode;
-  AlcKDTTree    *tTree = NULL;
+  AlcKDSTree    *tTree = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if((vx0 == NULL) || (vx1 == NULL))
@@ -419,24 +418,32 @@ WlzErrorNum 	WlzDistMetricDirVertex2D(int n0, WlzDVertex2 *vx0,
   {
     errNum = WLZ_ERR_PARAM_DATA;
   }
-  else if((iWSp = (int *)AlcMalloc(n1 * sizeof(int))) == NULL)
+  else if(((qry = (double *)
+		  AlcMalloc(sizeof(double) * 2 * n0)) == NULL) ||
+	  ((nnIdx = (size_t *)AlcMalloc(sizeof(size_t) * n0)) == NULL) ||
+	  ((nnDist = (double *)AlcMalloc(sizeof(double) * n0)) == NULL))
   {
     errNum = WLZ_ERR_MEM_ALLOC;
   }
-  else
+  if(errNum == WLZ_ERR_NONE)
   {
-    if(dstDistN)
-    {
-      if((nnDist = (double *)AlcMalloc(n0 * sizeof(double))) == NULL)
-      {
-        errNum = WLZ_ERR_MEM_ALLOC;
-      }
-    }
+    tVP.d2 = vx1;
+    tTree = WlzVerticesBuildKDSTree(WLZ_VERTEX_D2, n1, tVP, &errNum);
   }
+  /* Find the nearest neighbours of all the first vertices in a single
+   * batched query. */
   if(errNum == WLZ_ERR_NONE)
   {
-    tVP.d2 = vx1;
-    tTree = WlzVerticesBuildTree(WLZ_VERTEX_D2, n1, tVP, iWSp, &errNum);
+    for(id0 = 0; id0 < n0; ++id0)
+    {
+      *(qry + (2 * id0)) = (vx0 + id0)->vtX;
+      *(qry + (2 * id0) + 1) = (vx0 + id0)->vtY;
+    }
+    if(AlcKDSGetKNN(tTree, n0, qry, 1, DBL_MAX,
+                    nnIdx, nnDist) != ALC_ER_NONE)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -445,20 +452,15 @@ WlzErrorNum 	WlzDistMetricDirVertex2D(int n0, WlzDVertex2 *vx0,
     sDist = mDist = 0.0;
     for(id0 = 0; id0 < n0; ++id0)
     {
-      vxD2[0] = (vx0 + id0)->vtX;
-      vxD2[1] = (vx0 + id0)->vtY;
-      tNode = AlcKDTGetNN(tTree, vxD2, DBL_MAX, &cDist, NULL);
-      if(tNode)
+      if(*(nnIdx + id0) != ALC_KDS_IDX_NONE)
       {
+	cDist = *(nnDist + id0);
 	sDist += cDist;
 	if(cDist > mDist)
 	{
 	  mDist = cDist;
 	}
-	if(nnDist)
-	{
-	  *(nnDist + cCnt) = cDist;
-	}
+	*(nnDist + cCnt) = cDist;
 	if(cDist < iDist)
 	{
 	  iDist = cDist;
@@ -492,9 +494,10 @@ WlzErrorNum 	WlzDistMetricDirVertex2D(int n0, WlzDVertex2 *vx0,
       *dstDistI = iDist;
     }
   }
-  AlcFree(iWSp);
+  AlcFree(qry);
+  AlcFree(nnIdx);
   AlcFree(nnDist);
-  AlcKDTTreeFree(tTree);
+  (void )AlcKDSTreeFree(tTree);
   return(errNum);
 }
 
@@ -536,12 +539,11 @@ WlzErrorNum	WlzDistMetricDirVertex3D(int n0, WlzDVertex3 *vx0,
 		mDist,
   		sDist,
 		iDist;
-  int		*iWSp = NULL;
-  double	*nnDist = NULL;
-  double	vxD3[3];
+  size_t	*nnIdx = NULL;
+  double	*qry = NULL,
+  		*nnDist = NULL;
   WlzVertexP	tVP;
-  AlcKDTNode    *tNode;
-  AlcKDTTree    *tTree = NULL;
+  AlcKDSTree    *tTree = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if((vx0 == NULL) || (vx1 == NULL))
@@ -552,24 +554,33 @@ WlzErrorNum	WlzDistMetricDirVertex3D(int n0, WlzDVertex3 *vx0,
   {
     errNum = WLZ_ERR_PARAM_DATA;
   }
-  else if((iWSp = (int *)AlcMalloc(n1 * sizeof(int))) == NULL)
+  else if(((qry = (double *)
+		  AlcMalloc(sizeof(double) * 3 * n0)) == NULL) ||
+	  ((nnIdx = (size_t *)AlcMalloc(sizeof(size_t) * n0)) == NULL) ||
+	  ((nnDist = (double *)AlcMalloc(sizeof(double) * n0)) == NULL))
   {
     errNum = WLZ_ERR_MEM_ALLOC;
   }
-  else
+  if(errNum == WLZ_ERR_NONE)
   {
-    if(dstDistN)
-    {
-      if((nnDist = (double *)AlcMalloc(n0 * sizeof(double))) == NULL)
-      {
-        errNum = WLZ_ERR_MEM_ALLOC;
-      }
-    }
+    tVP.d3 = vx1;
+    tTree = WlzVerticesBuildKDSTree(WLZ_VERTEX_D3, n1, tVP, &errNum);
   }
+  /* Find the nearest neighbours of all the first vertices in a single
+   * batched query. */
   if(errNum == WLZ_ERR_NONE)
   {
-    tVP.d3 = vx1;
-    tTree = WlzVerticesBuildTree(WLZ_VERTEX_D3, n1, tVP, iWSp, &errNum);
+    for(id0 = 0; id0 < n0; ++id0)
+    {
+      *(qry + (3 * id0)) = (vx0 + id0)->vtX;
+      *(qry + (3 * id0) + 1) = (vx0 + id0)->vtY;
+      *(qry + (3 * id0) + 2) = (vx0 + id0)->vtZ;
+    }
+    if(AlcKDSGetKNN(tTree, n0, qry, 1, DBL_MAX,
+                    nnIdx, nnDist) != ALC_ER_NONE)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -578,21 +589,15 @@ WlzErrorNum	WlzDistMetricDirVertex3D(int n0, WlzDVertex3 *vx0,
     sDist = mDist = 0.0;
     for(id0 = 0; id0 < n0; ++id0)
     {
-      vxD3[0] = (vx0 + id0)->vtX;
-      vxD3[1] = (vx0 + id0)->vtY;
-      vxD3[2] = (vx0 + id0)->vtZ;
-      tNode = AlcKDTGetNN(tTree, vxD3, DBL_MAX, &cDist, NULL);
-      if(tNode)
+      if(*(nnIdx + id0) != ALC_KDS_IDX_NONE)
       {
+	cDist = *(nnDist + id0);
 	sDist += cDist;
 	if(cDist > mDist)
 	{
 	  mDist = cDist;
 	}
-	if(nnDist)
-	{
-	  *(nnDist + cCnt) = cDist;
-	}
+	*(nnDist + cCnt) = cDist;
 	if(cDist < iDist)
 	{
 	  iDist = cDist;
@@ -626,9 +631,10 @@ WlzErrorNum	WlzDistMetricDirVertex3D(int n0, WlzDVertex3 *vx0,
       *dstDistI = iDist;
     }
   }
-  AlcFree(iWSp);
+  AlcFree(qry);
+  AlcFree(nnIdx);
   AlcFree(nnDist);
-  AlcKDTTreeFree(tTree);
+  (void )AlcKDSTreeFree(tTree);
   return(errNum);
 }
 
@@ -43,9 +43,80 @@ static char _WlzDistTransform_c[] = "University of Edinburgh $Id$";
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <float.h>
+#include <limits.h>
 #include <Wlz.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \def		WLZ_DIST_EUCLIDEAN_INF
+* \ingroup	WlzMorphologyOps
+* \brief	Squared distance used for positions which have no reference
+* 		position on the line(s) processed so far.
+*/
+#define WLZ_DIST_EUCLIDEAN_INF	(UINT_MAX)
+
+/*!
+* \struct	_WlzDistEuclideanWSp
+* \ingroup	WlzMorphologyOps
+* \brief	Workspace for the exact Euclidean distance transform.
+* 		Squared distances are computed in a single plane array
+* 		per thread. For 3D objects the reference positions
+* 		through the planes are held as runs of consecutive
+* 		reference planes along each column of the bounding box.
+*/
+typedef struct _WlzDistEuclideanWSp
+{
+  int		dim;			/*!< Dimension, 2 or 3. */
+  WlzIBox3	box;			/*!< Bounding box of the distance
+  					     and reference objects. */
+  WlzIVertex3	sz;			/*!< Size of the bounding box. */
+  WlzDomain	refDom;			/*!< Reference domain. */
+  size_t	*colOff;		/*!< Index of the first run of each
+  					     column through the planes,
+					     with an extra index for the
+					     end of the last column
+					     (3D only). */
+  int		*colRun;		/*!< First and last planes of each
+  					     run (3D only). */
+  WlzUInt	**bufP;			/*!< Plane array for each thread. */
+  WlzUInt	**bufF;			/*!< Line buffers for each thread. */
+  WlzUInt	**bufG;			/*!< Line buffers for each thread. */
+  int		**bufV;			/*!< Parabola root buffers for each
+  					     thread. */
+  double	**bufZ;			/*!< Parabola boundary buffers for
+  					     each thread. */
+} WlzDistEuclideanWSp;
+
+static void			WlzDistEuclideanLn(
+				  WlzUInt *f,
+				  int n,
+				  WlzUInt *g,
+				  int *v,
+				  double *z);
+static WlzErrorNum		WlzDistEuclidean(
+				  WlzObject *dstObj,
+				  WlzObject *refObj);
+static WlzErrorNum		WlzDistEuclideanRuns(
+				  WlzDistEuclideanWSp *wSp,
+				  WlzPlaneDomain *pDom);
+static WlzErrorNum		WlzDistEuclideanPln(
+				  WlzDistEuclideanWSp *wSp,
+				  int pln,
+				  int nThr,
+				  int thrId,
+				  WlzDomain dom,
+				  WlzValues val);
+static WlzErrorNum		WlzDistEuclideanItv(
+				  WlzUInt *buf,
+				  WlzIBox3 box,
+				  int pln,
+				  WlzDomain dom,
+				  WlzValues val);
 static WlzObject 		*WlzDistSample(
 				  WlzObject *obj,
 				  int dim,
@@ -84,6 +155,25 @@ static WlzObject 		*WlzDistSample(
 *		See: G. Borgefors. "Distance Transformations in Arbitrary
 *		Dimensions" CVGIP 27:321-345, 1984.
 *
+*		An exact Euclidean distance transform is computed without
+*		dilation when the distance function is WLZ_EUCLIDEAN_DISTANCE.
+*		The squared distances are found using separable passes along
+*		the lines, columns and (in 3D) planes of the bounding box
+*		of the foreground and reference objects, with each pass
+*		computing the lower envelope of parabolas rooted at the
+*		positions found by the previous pass. The cost is linear
+*		in the number of pixels/voxels within the bounding box
+*		and is independent of the distances. Unlike the other
+*		distance functions the distances are not constrained to
+*		paths within the foreground domain, they are the rounded
+*		Euclidean distances to the nearest reference position.
+*		See: P. F. Felzenszwalb and D. P. Huttenlocher. "Distance
+*		Transforms of Sampled Functions" Theory of Computing
+*		8:415-428, 2012 and A. Meijster, J. B. T. M. Roerdink and
+*		W. H. Hesselink. "A General Algorithm for Computing Distance
+*		Transforms in Linear Time" Mathematical Morphology and its
+*		Applications to Image and Signal Processing 331-340, 2000.
+*
 * 		An approximate Euclidean distance transform may be computed
 * 		by: Scaling the given foreground and reference objects using
 * 		the given approximation scale parameter, dilating the
@@ -209,6 +299,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	  case WLZ_4_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_8_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_OCTAGONAL_DISTANCE: /* FALLTHROUGH */
+	  case WLZ_EUCLIDEAN_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_APX_EUCLIDEAN_DISTANCE:
 	    dim = 2;
 	    break;
@@ -224,6 +315,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	  case WLZ_18_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_26_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_OCTAGONAL_DISTANCE: /* FALLTHROUGH */
+	  case WLZ_EUCLIDEAN_DISTANCE: /* FALLTHROUGH */
 	  case WLZ_APX_EUCLIDEAN_DISTANCE:
 	    dim = 3;
 	    break;
@@ -267,7 +359,7 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
 	}
 	break;
       case WLZ_EUCLIDEAN_DISTANCE:
-	errNum = WLZ_ERR_UNIMPLEMENTED;
+	notDone = 0;
 	break;
       default:
         errNum = WLZ_ERR_PARAM_DATA;
@@ -371,6 +463,11 @@ WlzObject 	*WlzDistanceTransform(WlzObject *forObj, WlzObject *refObj,
     bothObj[0] = sForObj;
     errNum = WlzGreySetValue(dstObj, dstV);
   }
+  /* Compute exact Euclidean distances directly. */
+  if((errNum == WLZ_ERR_NONE) && (dFn == WLZ_EUCLIDEAN_DISTANCE))
+  {
+    errNum = WlzDistEuclidean(dstObj, sRefObj);
+  }
   /* Dilate the reference object while setting the distances in each
    * dilated shell. */
   while((errNum == WLZ_ERR_NONE) && notDone)
@@ -569,3 +666,657 @@ static WlzObject *WlzDistSample(WlzObject *obj, int dim, double scale,
   }
   return(sObj);
 }
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Sets the values of the given distance object to the exact
+* 		Euclidean distances from the given reference object.
+* 		The squared distances are computed one plane at a time
+* 		in an array which covers a single plane of the bounding
+* 		box of both objects. For 3D objects the array is first
+* 		set to the squared distances through the planes, which
+* 		are found from the runs of reference planes along each
+* 		column (see WlzDistEuclideanRuns()). The lower envelope
+* 		passes are then made along the columns and lines of the
+* 		plane. Planes of the distance object with an empty
+* 		domain are skipped. The planes of a 3D object are done
+* 		in parallel, while the columns and lines of a 2D object
+* 		are done in parallel.
+* \param	dstObj			Distance object with integer values
+* 					which are set to the distances.
+* \param	refObj			Reference object which must be a
+* 					domain object of the same type as the
+* 					distance object.
+*/
+static WlzErrorNum WlzDistEuclidean(WlzObject *dstObj, WlzObject *refObj)
+{
+  int		idT,
+		empty = 0,
+  		nThr = 1,
+		nBuf;
+  size_t	nPl = 0;
+  WlzIBox3	box1;
+  WlzDistEuclideanWSp wSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  wSp.dim = 2;
+  wSp.colOff = NULL;
+  wSp.colRun = NULL;
+  wSp.bufP = NULL;
+  wSp.bufF = NULL;
+  wSp.bufG = NULL;
+  wSp.bufV = NULL;
+  wSp.bufZ = NULL;
+  wSp.refDom.core = NULL;
+  if(refObj->type != dstObj->type)
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if(refObj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    /* With no reference all distances are left as zero. */
+    empty = WlzIsEmpty(refObj, &errNum);
+  }
+  /* Find the bounding box of the distance and reference objects. */
+  if((errNum == WLZ_ERR_NONE) && !empty)
+  {
+    wSp.box = WlzBoundingBox3I(dstObj, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      box1 = WlzBoundingBox3I(refObj, &errNum);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && !empty)
+  {
+    wSp.dim = (dstObj->type == WLZ_2D_DOMAINOBJ)? 2: 3;
+    wSp.refDom = refObj->domain;
+    if(wSp.dim == 2)
+    {
+      wSp.box.zMin = wSp.box.zMax = 0;
+    }
+    else
+    {
+      wSp.box.zMin = ALG_MIN(wSp.box.zMin, box1.zMin);
+      wSp.box.zMax = ALG_MAX(wSp.box.zMax, box1.zMax);
+    }
+    wSp.box.xMin = ALG_MIN(wSp.box.xMin, box1.xMin);
+    wSp.box.yMin = ALG_MIN(wSp.box.yMin, box1.yMin);
+    wSp.box.xMax = ALG_MAX(wSp.box.xMax, box1.xMax);
+    wSp.box.yMax = ALG_MAX(wSp.box.yMax, box1.yMax);
+    wSp.sz.vtX = wSp.box.xMax - wSp.box.xMin + 1;
+    wSp.sz.vtY = wSp.box.yMax - wSp.box.yMin + 1;
+    wSp.sz.vtZ = wSp.box.zMax - wSp.box.zMin + 1;
+    nPl = (size_t )(wSp.sz.vtX) * wSp.sz.vtY;
+    /* All squared distances within the box must be less than the value
+     * used for an unknown distance. */
+    if(((double )(wSp.sz.vtX) * wSp.sz.vtX) +
+       ((double )(wSp.sz.vtY) * wSp.sz.vtY) +
+       ((double )(wSp.sz.vtZ) * wSp.sz.vtZ) >=
+       (double )WLZ_DIST_EUCLIDEAN_INF)
+    {
+      errNum = WLZ_ERR_DOMAIN_DATA;
+    }
+  }
+  /* Find the runs of reference planes along each column. */
+  if((errNum == WLZ_ERR_NONE) && !empty && (wSp.dim == 3))
+  {
+    errNum = WlzDistEuclideanRuns(&wSp, refObj->domain.p);
+  }
+  /* Allocate a plane array and line buffers for each thread. */
+  if((errNum == WLZ_ERR_NONE) && !empty)
+  {
+#ifdef _OPENMP
+    nThr = omp_get_max_threads();
+#endif
+    nBuf = ALG_MAX(wSp.sz.vtX, wSp.sz.vtY);
+    if(((wSp.bufP = (WlzUInt **)AlcCalloc(nThr, sizeof(WlzUInt *))) == NULL) ||
+       ((wSp.bufF = (WlzUInt **)AlcCalloc(nThr, sizeof(WlzUInt *))) == NULL) ||
+       ((wSp.bufG = (WlzUInt **)AlcCalloc(nThr, sizeof(WlzUInt *))) == NULL) ||
+       ((wSp.bufV = (int **)AlcCalloc(nThr, sizeof(int *))) == NULL) ||
+       ((wSp.bufZ = (double **)AlcCalloc(nThr, sizeof(double *))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      for(idT = 0; idT < nThr; ++idT)
+      {
+	/* A 2D object has a single plane which is shared by the threads. */
+        if((((idT == 0) || (wSp.dim == 3)) &&
+	    ((wSp.bufP[idT] = (WlzUInt *)
+	                      AlcMalloc(nPl * sizeof(WlzUInt))) == NULL)) ||
+	   ((wSp.bufF[idT] = (WlzUInt *)
+	                     AlcMalloc(nBuf * sizeof(WlzUInt))) == NULL) ||
+	   ((wSp.bufG[idT] = (WlzUInt *)
+	                     AlcMalloc(nBuf * sizeof(WlzUInt))) == NULL) ||
+	   ((wSp.bufV[idT] = (int *)AlcMalloc(nBuf * sizeof(int))) == NULL) ||
+	   ((wSp.bufZ[idT] = (double *)
+	                     AlcMalloc((nBuf + 1) * sizeof(double))) == NULL))
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	  break;
+	}
+      }
+    }
+  }
+  /* Compute the distances one plane at a time. */
+  if((errNum == WLZ_ERR_NONE) && !empty)
+  {
+    if(wSp.dim == 2)
+    {
+      errNum = WlzDistEuclideanPln(&wSp, 0, nThr, 0,
+      				   dstObj->domain, dstObj->values);
+    }
+    else
+    {
+      int	idP,
+      		nP;
+      WlzPlaneDomain *pDom;
+      WlzVoxelValues *vVal;
+
+      pDom = dstObj->domain.p;
+      vVal = dstObj->values.vox;
+      nP = pDom->lastpl - pDom->plane1 + 1;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(dynamic)
+#endif
+      for(idP = 0; idP < nP; ++idP)
+      {
+	WlzDomain dom;
+	WlzValues val;
+
+	dom = pDom->domains[idP];
+	val = vVal->values[idP];
+        if((errNum == WLZ_ERR_NONE) &&
+	   (dom.core != NULL) && (dom.core->type != WLZ_EMPTY_DOMAIN) &&
+	   (val.core != NULL))
+	{
+	  int	  thrId = 0;
+	  WlzErrorNum errNum2;
+
+#ifdef _OPENMP
+	  thrId = omp_get_thread_num();
+#endif
+	  errNum2 = WlzDistEuclideanPln(&wSp, pDom->plane1 + idP, 1, thrId,
+	                                dom, val);
+	  if(errNum2 != WLZ_ERR_NONE)
+	  {
+#ifdef _OPENMP
+#pragma omp critical
+	    {
+#endif
+	      if(errNum == WLZ_ERR_NONE)
+	      {
+	        errNum = errNum2;
+	      }
+#ifdef _OPENMP
+	    }
+#endif
+	  }
+	}
+      }
+    }
+  }
+  if(wSp.bufF)
+  {
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      AlcFree(wSp.bufP[idT]);
+      AlcFree(wSp.bufF[idT]);
+      AlcFree(wSp.bufG[idT]);
+      AlcFree(wSp.bufV[idT]);
+      AlcFree(wSp.bufZ[idT]);
+    }
+  }
+  AlcFree(wSp.bufP);
+  AlcFree(wSp.bufF);
+  AlcFree(wSp.bufG);
+  AlcFree(wSp.bufV);
+  AlcFree(wSp.bufZ);
+  AlcFree(wSp.colOff);
+  AlcFree(wSp.colRun);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Finds the runs of consecutive reference planes along each
+* 		column through the planes of the bounding box. The runs
+* 		of a column are held in plane order, so the space needed
+* 		is that of the intervals of the reference domain
+* 		through the planes rather than that of the bounding box.
+* \param	wSp			Workspace with the bounding box set,
+* 					in which the column offsets and runs
+* 					are allocated and set.
+* \param	pDom			Reference plane domain.
+*/
+static WlzErrorNum WlzDistEuclideanRuns(WlzDistEuclideanWSp *wSp,
+					WlzPlaneDomain *pDom)
+{
+  int		idP,
+		nP,
+  		pass,
+		pln;
+  size_t	idx,
+		nPl,
+  		nRun;
+  int		*colLast = NULL;
+  WlzObject	*obj;
+  WlzIntervalWSpace iWSp;
+  WlzValues	nullVal;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nullVal.core = NULL;
+  nP = pDom->lastpl - pDom->plane1 + 1;
+  nPl = (size_t )(wSp->sz.vtX) * wSp->sz.vtY;
+  if(((colLast = (int *)AlcMalloc(nPl * sizeof(int))) == NULL) ||
+     ((wSp->colOff = (size_t *)AlcCalloc(nPl + 1, sizeof(size_t))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* The first pass counts the runs of each column and the second
+   * sets them, using the column offsets as cursors. */
+  for(pass = 0; (errNum == WLZ_ERR_NONE) && (pass < 2); ++pass)
+  {
+    if(pass == 1)
+    {
+      for(idx = 0; idx < nPl; ++idx)
+      {
+        wSp->colOff[idx + 1] += wSp->colOff[idx];
+      }
+      nRun = wSp->colOff[nPl];
+      if((wSp->colRun = (int *)
+                        AlcMalloc((2 * nRun + 1) * sizeof(int))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    for(idx = 0; idx < nPl; ++idx)
+    {
+      colLast[idx] = wSp->box.zMin - 2;
+    }
+    for(idP = 0; (errNum == WLZ_ERR_NONE) && (idP < nP); ++idP)
+    {
+      WlzDomain	dom;
+
+      obj = NULL;
+      dom = pDom->domains[idP];
+      pln = pDom->plane1 + idP;
+      if((dom.core != NULL) && (dom.core->type != WLZ_EMPTY_DOMAIN))
+      {
+	obj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, nullVal, NULL, NULL,
+			  &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = WlzInitRasterScan(obj, &iWSp, WLZ_RASTERDIR_ILIC);
+	}
+      }
+      if((errNum == WLZ_ERR_NONE) && (obj != NULL))
+      {
+	while((errNum = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE)
+	{
+	  int	idK;
+	  size_t r,
+	  	 off;
+
+	  off = ((size_t )(iWSp.linpos - wSp->box.yMin) * wSp->sz.vtX) +
+	        iWSp.lftpos - wSp->box.xMin;
+	  for(idK = 0; idK < iWSp.colrmn; ++idK)
+	  {
+	    idx = off + idK;
+	    if(colLast[idx] != pln - 1)
+	    {
+	      if(pass == 0)
+	      {
+	        ++(wSp->colOff[idx + 1]);
+	      }
+	      else
+	      {
+	        r = 2 * (wSp->colOff[idx])++;
+		wSp->colRun[r] = wSp->colRun[r + 1] = pln;
+	      }
+	    }
+	    else if(pass == 1)
+	    {
+	      wSp->colRun[2 * wSp->colOff[idx] - 1] = pln;
+	    }
+	    colLast[idx] = pln;
+	  }
+	}
+	if(errNum == WLZ_ERR_EOO)
+	{
+	  errNum = WLZ_ERR_NONE;
+	}
+      }
+      (void )WlzFreeObj(obj);
+    }
+  }
+  /* The cursors have been advanced to the offsets of the next columns. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idx = nPl; idx > 0; --idx)
+    {
+      wSp->colOff[idx] = wSp->colOff[idx - 1];
+    }
+    wSp->colOff[0] = 0;
+  }
+  AlcFree(colLast);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the squared distances for a single plane in
+* 		the plane array of the given thread and then sets the
+* 		distance values within the given domain.
+* \param	wSp			Workspace.
+* \param	pln			Plane coordinate, zero for 2D.
+* \param	nThr			Number of threads to use within
+* 					the plane.
+* \param	thrId			Index of the plane array and line
+* 					buffers to be used when nThr is one,
+* 					otherwise zero.
+* \param	dom			Domain of the distance object for the
+* 					plane.
+* \param	val			Values of the distance object for the
+* 					plane.
+*/
+static WlzErrorNum WlzDistEuclideanPln(WlzDistEuclideanWSp *wSp, int pln,
+				       int nThr, int thrId,
+				       WlzDomain dom, WlzValues val)
+{
+  int		idC,
+		idL,
+		nL;
+  size_t	idx,
+		nPl;
+  WlzUInt	*ary;
+  WlzIBox3	box;
+  WlzValues	nullVal;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nullVal.core = NULL;
+  ary = wSp->bufP[thrId];
+  nPl = (size_t )(wSp->sz.vtX) * wSp->sz.vtY;
+  box = wSp->box;
+  box.zMin = box.zMax = pln;
+  if(wSp->dim == 2)
+  {
+    /* Zero within the reference domain and unknown elsewhere. */
+    for(idx = 0; idx < nPl; ++idx)
+    {
+      ary[idx] = WLZ_DIST_EUCLIDEAN_INF;
+    }
+    errNum = WlzDistEuclideanItv(ary, box, pln, wSp->refDom, nullVal);
+  }
+  else
+  {
+    /* Squared distances through the planes to the nearest run of
+     * reference planes in the same column. */
+    for(idx = 0; idx < nPl; ++idx)
+    {
+      size_t	r0,
+		r1,
+		rL,
+		rH;
+      int	d = -1;
+
+      r0 = rL = wSp->colOff[idx];
+      r1 = rH = wSp->colOff[idx + 1];
+      while(rL < rH)
+      {
+        size_t	rM;
+
+	rM = (rL + rH) / 2;
+	if(wSp->colRun[2 * rM + 1] < pln)
+	{
+	  rL = rM + 1;
+	}
+	else
+	{
+	  rH = rM;
+	}
+      }
+      if(rL < r1)
+      {
+        d = (wSp->colRun[2 * rL] > pln)? wSp->colRun[2 * rL] - pln: 0;
+      }
+      if((rL > r0) &&
+         ((d < 0) || (pln - wSp->colRun[2 * rL - 1] < d)))
+      {
+        d = pln - wSp->colRun[2 * rL - 1];
+      }
+      ary[idx] = (d < 0)? WLZ_DIST_EUCLIDEAN_INF: (WlzUInt )d * d;
+    }
+  }
+  /* Squared distances along each column of the plane. */
+  if((errNum == WLZ_ERR_NONE) && (wSp->sz.vtY > 1))
+  {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) if(nThr > 1)
+#endif
+    for(idC = 0; idC < wSp->sz.vtX; ++idC)
+    {
+      int	idY,
+      		tId;
+      WlzUInt	*col;
+
+      tId = thrId;
+#ifdef _OPENMP
+      if(nThr > 1)
+      {
+        tId = omp_get_thread_num();
+      }
+#endif
+      col = ary + idC;
+      for(idY = 0; idY < wSp->sz.vtY; ++idY)
+      {
+        wSp->bufF[tId][idY] = col[idY * wSp->sz.vtX];
+      }
+      WlzDistEuclideanLn(wSp->bufF[tId], wSp->sz.vtY, wSp->bufG[tId],
+                         wSp->bufV[tId], wSp->bufZ[tId]);
+      for(idY = 0; idY < wSp->sz.vtY; ++idY)
+      {
+        col[idY * wSp->sz.vtX] = wSp->bufG[tId][idY];
+      }
+    }
+  }
+  /* Squared distances along each line of the plane which is within the
+   * distance domain. */
+  if((errNum == WLZ_ERR_NONE) && (wSp->sz.vtX > 1))
+  {
+    int		ln0;
+
+    ln0 = dom.i->line1 - wSp->box.yMin;
+    nL = dom.i->lastln - dom.i->line1 + 1;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) if(nThr > 1)
+#endif
+    for(idL = 0; idL < nL; ++idL)
+    {
+      int	tId;
+      WlzUInt	*ln;
+
+      tId = thrId;
+#ifdef _OPENMP
+      if(nThr > 1)
+      {
+        tId = omp_get_thread_num();
+      }
+#endif
+      ln = ary + ((size_t )(ln0 + idL) * wSp->sz.vtX);
+      (void )memcpy(wSp->bufF[tId], ln, wSp->sz.vtX * sizeof(WlzUInt));
+      WlzDistEuclideanLn(wSp->bufF[tId], wSp->sz.vtX, ln,
+                         wSp->bufV[tId], wSp->bufZ[tId]);
+    }
+  }
+  /* Set the distance values from the squared distances. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzDistEuclideanItv(ary, box, pln, dom, val);
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzMorphologyOps
+* \brief	Computes the one dimensional squared distance transform
+* 		of the given sampled function as the lower envelope of the
+* 		parabolas rooted at the sample positions which have known
+* 		values.
+* \param	f			Given sampled function with
+* 					WLZ_DIST_EUCLIDEAN_INF at positions
+* 					with no known distance.
+* \param	n			Number of samples.
+* \param	g			Destination for the transformed
+* 					function.
+* \param	v			Workspace for the parabola roots,
+* 					must have room for n values.
+* \param	z			Workspace for the parabola boundaries,
+* 					must have room for n + 1 values.
+*/
+static void	WlzDistEuclideanLn(WlzUInt *f, int n, WlzUInt *g,
+				   int *v, double *z)
+{
+  int		j,
+  		q,
+		k = -1;
+  double	s;
+
+  for(q = 0; q < n; ++q)
+  {
+    if(f[q] != WLZ_DIST_EUCLIDEAN_INF)
+    {
+      if(k < 0)
+      {
+        k = 0;
+	z[0] = -DBL_MAX;
+      }
+      else
+      {
+	do
+	{
+	  j = v[k];
+	  s = (((double )(f[q]) + ((double )q * q)) -
+	       ((double )(f[j]) + ((double )j * j))) / (2.0 * (q - j));
+	} while((s <= z[k]) && (--k >= 0));
+	++k;
+	z[k] = s;
+      }
+      v[k] = q;
+      z[k + 1] = DBL_MAX;
+    }
+  }
+  if(k < 0)
+  {
+    for(q = 0; q < n; ++q)
+    {
+      g[q] = WLZ_DIST_EUCLIDEAN_INF;
+    }
+  }
+  else
+  {
+    k = 0;
+    for(q = 0; q < n; ++q)
+    {
+      while(z[k + 1] < q)
+      {
+        ++k;
+      }
+      j = q - v[k];
+      g[q] = ((WlzUInt )j * j) + f[v[k]];
+    }
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzMorphologyOps
+* \brief	Scans the intervals of the given 2D domain. If the given
+* 		values are null the squared distance array is set to zero
+* 		within the intervals, otherwise the given integer values
+* 		are set to the rounded square root of the squared
+* 		distances.
+* 		Nothing is done for a null or empty domain.
+* \param	buf			Squared distance array.
+* \param	box			Bounding box of the array.
+* \param	pln			Plane coordinate of the domain.
+* \param	dom			Given 2D domain.
+* \param	val			Given 2D values or null.
+*/
+static WlzErrorNum WlzDistEuclideanItv(WlzUInt *buf, WlzIBox3 box, int pln,
+				       WlzDomain dom, WlzValues val)
+{
+  int		idK,
+  		nK;
+  size_t	off;
+  WlzUInt	*ln;
+  WlzObject	*obj;
+  WlzGreyWSpace	gWSp;
+  WlzIntervalWSpace iWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((dom.core == NULL) || (dom.core->type == WLZ_EMPTY_DOMAIN))
+  {
+    obj = NULL;
+  }
+  else
+  {
+    obj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL, &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) && (obj != NULL))
+  {
+    off = (size_t )(pln - box.zMin) * (box.yMax - box.yMin + 1);
+    nK = box.xMax - box.xMin + 1;
+    if(val.core == NULL)
+    {
+      errNum = WlzInitRasterScan(obj, &iWSp, WLZ_RASTERDIR_ILIC);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	while((errNum = WlzNextInterval(&iWSp)) == WLZ_ERR_NONE)
+	{
+	  ln = buf + ((off + iWSp.linpos - box.yMin) * nK) +
+	       iWSp.lftpos - box.xMin;
+	  for(idK = 0; idK < iWSp.colrmn; ++idK)
+	  {
+	    ln[idK] = 0;
+	  }
+	}
+      }
+    }
+    else
+    {
+      errNum = WlzInitGreyScan(obj, &iWSp, &gWSp);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+	{
+	  int	*gP;
+
+	  gP = gWSp.u_grintptr.inp;
+	  ln = buf + ((off + iWSp.linpos - box.yMin) * nK) +
+	       iWSp.lftpos - box.xMin;
+	  for(idK = 0; idK < iWSp.colrmn; ++idK)
+	  {
+	    gP[idK] = (ln[idK] == WLZ_DIST_EUCLIDEAN_INF)?
+	              0: WLZ_NINT(sqrt((double )(ln[idK])));
+	  }
+	}
+	(void )WlzEndGreyScan(&iWSp, &gWSp);
+      }
+    }
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  (void )WlzFreeObj(obj);
+  return(errNum);
+}
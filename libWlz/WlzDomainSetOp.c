@@ -0,0 +1,1089 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzDomainSetOp_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzDomainSetOp.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Set operations (union, intersection, difference and
+* 		exclusive or) on the domains of N 2D or 3D objects
+* 		using a single multiway interval merge.
+* \ingroup	WlzDomainOps
+*/
+
+#include <stdlib.h>
+#include <limits.h>
+#include <Wlz.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Lines with at most this many sources are merged using a linear search
+ * of the sources rather than a heap. */
+#define WLZ_DOMAINSETOP_LINSRCH	(8)
+
+/*!
+* \struct	_WlzDomainSetOpCur
+* \ingroup	WlzDomainOps
+* \brief	Cursor on the intervals of a single source domain within
+* 		the current line. The cursor is either waiting to enter
+* 		its current interval or waiting to leave it, pos is the
+* 		absolute column at which this next event occurs.
+*		Typedef: ::WlzDomainSetOpCur.
+*/
+typedef struct _WlzDomainSetOpCur
+{
+  int			w;		/*!< Weight of the source domain. */
+  int			in;		/*!< Non-zero when inside current
+  					     interval. */
+  int			pos;		/*!< Column of the next event. */
+  int			kol1;		/*!< Column origin of the source
+  					     domain's intervals. */
+  WlzInterval		*itv;		/*!< Current interval. */
+  WlzInterval		*lst;		/*!< One past the last interval of
+  					     the line. */
+} WlzDomainSetOpCur;
+
+/*!
+* \struct	_WlzDomainSetOpWSp
+* \ingroup	WlzDomainOps
+* \brief	Work space for a set operation on 2D interval domains.
+* 		Each source is given a weight and a column is in the
+* 		result when the sum of the weights of the sources
+* 		covering it is in the range [sMin, sMax], or when the
+* 		sum is odd for an exclusive or.
+*		Typedef: ::WlzDomainSetOpWSp.
+*/
+typedef struct _WlzDomainSetOpWSp
+{
+  int			n;		/*!< Number of source domains. */
+  WlzBinaryOperatorType	op;		/*!< Set operation. */
+  int			sMin;		/*!< Minimum weight sum. */
+  int			sMax;		/*!< Maximum weight sum. */
+  int			kol1;		/*!< First column of the result. */
+  int			lastkl;		/*!< Last column of the result. */
+  int			*cnt;		/*!< Weight differences indexed by
+  					     column relative to kol1, all
+					     zero between lines. */
+  WlzIntervalDomain	**dom;		/*!< Source domains, NULL for
+  					     empty domains. */
+  WlzInterval		*rItv;		/*!< The interval of each
+  					     rectangular source domain. */
+  WlzDomainSetOpCur	*cur;		/*!< Cursors of the sources which
+  					     have intervals on the line. */
+  int			*heap;		/*!< Min-heap of cursor indices
+  					     keyed by cursor position. */
+} WlzDomainSetOpWSp;
+
+static void			WlzDomainSetOpHeapDown(
+				  int *heap,
+				  int nH,
+				  int idx,
+				  WlzDomainSetOpCur *cur);
+static int			WlzDomainSetOpLine(
+				  WlzDomainSetOpWSp *wSp,
+				  int ln,
+				  WlzInterval *dst);
+static int			WlzDomainSetOpEvent(
+				  WlzDomainSetOpWSp *wSp,
+				  WlzDomainSetOpCur *c,
+				  int *sum,
+				  int *done);
+static int			WlzDomainSetOpLineDense(
+				  WlzDomainSetOpWSp *wSp,
+				  int nA,
+				  int lo,
+				  int hi,
+				  WlzInterval *dst);
+static WlzErrorNum		WlzDomainSetOpCheck(
+				  WlzBinaryOperatorType op);
+static WlzDomain		WlzDomainSetOpItv(
+				  int n,
+				  WlzDomain *doms,
+				  WlzBinaryOperatorType op,
+				  WlzErrorNum *dstErr);
+
+/*!
+* \return	Standardised domain of the set operation, with a NULL
+* 		core pointer if the result is empty.
+* \ingroup	WlzDomainOps
+* \brief	Computes a set operation on the given 2D domains. The
+* 		operation must be one of:
+* 		<ul>
+* 		<li> WLZ_BO_OR (union of all domains)
+* 		<li> WLZ_BO_AND (intersection of all domains)
+* 		<li> WLZ_BO_SUBTRACT (the first domain less the union of
+* 		     the rest)
+* 		<li> WLZ_BO_XOR (those pixels which are in an odd number
+* 		     of domains, the exclusive or when n == 2).
+* 		</ul>
+* 		All the domains are scanned together line by line
+* 		using a multiway merge of their intervals, so the cost
+* 		is proportional to the number of intervals rather than
+* 		the number of domains. A counting pass sizes the result
+* 		intervals before a single merge pass writes them.
+* \param	n			Number of domains.
+* \param	doms			Array of interval domains, a NULL
+* 					core pointer or a domain of type
+* 					WLZ_EMPTY_DOMAIN is an empty domain.
+* \param	op			Set operation.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzDomain	WlzDomainSetOp2D(int n, WlzDomain *doms,
+				 WlzBinaryOperatorType op, WlzErrorNum *dstErr)
+{
+  int		i;
+  WlzDomain	rDom;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  rDom.core = NULL;
+  if((n < 1) || (doms == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    errNum = WlzDomainSetOpCheck(op);
+  }
+  for(i = 0; (errNum == WLZ_ERR_NONE) && (i < n); ++i)
+  {
+    if(doms[i].core)
+    {
+      switch(doms[i].core->type)
+      {
+	case WLZ_INTERVALDOMAIN_INTVL: /* FALLTHROUGH */
+	case WLZ_INTERVALDOMAIN_RECT:  /* FALLTHROUGH */
+	case WLZ_EMPTY_DOMAIN:
+	  break;
+	default:
+	  errNum = WLZ_ERR_DOMAIN_TYPE;
+	  break;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rDom = WlzDomainSetOpItv(n, doms, op, &errNum);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rDom);
+}
+
+/*!
+* \return	Standardised plane domain of the set operation, with a
+* 		NULL core pointer if the result is empty.
+* \ingroup	WlzDomainOps
+* \brief	Computes a set operation on the given 3D domains, see
+* 		WlzDomainSetOp2D() for the operations. The planes are
+* 		independent and are computed in parallel. The voxel
+* 		size is taken from the first non-empty domain.
+* \param	n			Number of domains.
+* \param	doms			Array of plane domains, a NULL
+* 					core pointer or a domain of type
+* 					WLZ_EMPTY_DOMAIN is an empty domain.
+* \param	op			Set operation.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzDomain	WlzDomainSetOp3D(int n, WlzDomain *doms,
+				 WlzBinaryOperatorType op, WlzErrorNum *dstErr)
+{
+  int		i,
+  		idx = 0,
+		nDom = 0,
+		nPln = 0,
+		plane1 = 0,
+		lastpl = -1;
+  WlzPlaneDomain *pDom,
+  		*rPDom = NULL;
+  WlzDomain	rDom;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  rDom.core = NULL;
+  if((n < 1) || (doms == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    errNum = WlzDomainSetOpCheck(op);
+  }
+  /* Find the plane bounds of the result. */
+  for(i = 0; (errNum == WLZ_ERR_NONE) && (i < n); ++i)
+  {
+    if((doms[i].core == NULL) || (doms[i].core->type == WLZ_EMPTY_DOMAIN))
+    {
+      if((op == WLZ_BO_AND) || ((op == WLZ_BO_SUBTRACT) && (i == 0)))
+      {
+        nDom = 0;
+	break;
+      }
+    }
+    else if(doms[i].core->type != WLZ_PLANEDOMAIN_DOMAIN)
+    {
+      errNum = WLZ_ERR_DOMAIN_TYPE;
+    }
+    else
+    {
+      pDom = doms[i].p;
+      if(nDom++ == 0)
+      {
+        idx = i;
+        plane1 = pDom->plane1;
+	lastpl = pDom->lastpl;
+      }
+      else if((op == WLZ_BO_OR) || (op == WLZ_BO_XOR))
+      {
+        plane1 = ALG_MIN(plane1, pDom->plane1);
+        lastpl = ALG_MAX(lastpl, pDom->lastpl);
+      }
+      else if(op == WLZ_BO_AND)
+      {
+        plane1 = ALG_MAX(plane1, pDom->plane1);
+        lastpl = ALG_MIN(lastpl, pDom->lastpl);
+      }
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (nDom > 0) && (plane1 <= lastpl))
+  {
+    pDom = doms[idx].p;
+    if((rPDom = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
+    				   plane1, lastpl, 0, 0, 0, 0,
+				   &errNum)) != NULL)
+    {
+      rPDom->voxel_size[0] = pDom->voxel_size[0];
+      rPDom->voxel_size[1] = pDom->voxel_size[1];
+      rPDom->voxel_size[2] = pDom->voxel_size[2];
+    }
+  }
+  if(rPDom != NULL)
+  {
+    int		pln;
+
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:nPln)
+#endif
+    for(pln = plane1; pln <= lastpl; ++pln)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+	int		j;
+	WlzDomain	dom2D;
+	WlzDomain	*doms2D;
+	WlzErrorNum	errNum2D = WLZ_ERR_NONE;
+
+	dom2D.core = NULL;
+	if((doms2D = (WlzDomain *)AlcMalloc(n * sizeof(WlzDomain))) == NULL)
+	{
+	  errNum2D = WLZ_ERR_MEM_ALLOC;
+	}
+	else
+	{
+	  for(j = 0; j < n; ++j)
+	  {
+	    WlzPlaneDomain *pDom2D;
+
+	    doms2D[j].core = NULL;
+	    if(((pDom2D = doms[j].p) != NULL) &&
+	       (pDom2D->type == WLZ_PLANEDOMAIN_DOMAIN) &&
+	       (pln >= pDom2D->plane1) && (pln <= pDom2D->lastpl))
+	    {
+	      doms2D[j] = pDom2D->domains[pln - pDom2D->plane1];
+	    }
+	  }
+	  dom2D = WlzDomainSetOpItv(n, doms2D, op, &errNum2D);
+	  AlcFree(doms2D);
+	}
+	if(dom2D.core != NULL)
+	{
+	  rPDom->domains[pln - plane1] = WlzAssignDomain(dom2D, NULL);
+	  ++nPln;
+	}
+	if(errNum2D != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical (WlzDomainSetOp3D)
+#endif
+	  {
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2D;
+	    }
+	  }
+	}
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && (nPln > 0))
+    {
+      errNum = WlzStandardPlaneDomain(rPDom, NULL);
+    }
+    if((errNum == WLZ_ERR_NONE) && (nPln > 0))
+    {
+      rDom.p = rPDom;
+    }
+    else
+    {
+      (void )WlzFreePlaneDomain(rPDom);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rDom);
+}
+
+/*!
+* \return	New domain object without values, an empty object if
+* 		the result is empty or NULL on error.
+* \ingroup	WlzDomainOps
+* \brief	Computes a set operation on the domains of the given
+* 		objects, see WlzDomainSetOp2D() for the operations.
+* 		The non-empty objects must all be 2D or all be 3D
+* 		domain objects, empty objects are allowed.
+* \param	n			Number of objects.
+* \param	objs			Array of objects.
+* \param	op			Set operation.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzDomainSetOp(int n, WlzObject **objs,
+				WlzBinaryOperatorType op, WlzErrorNum *dstErr)
+{
+  int		i;
+  WlzObjectType	oType = WLZ_EMPTY_OBJ;
+  WlzDomain	rDom;
+  WlzValues	nullVal;
+  WlzDomain	*doms = NULL;
+  WlzObject	*rObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  rDom.core = NULL;
+  nullVal.core = NULL;
+  if((n < 1) || (objs == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((doms = (WlzDomain *)AlcMalloc(n * sizeof(WlzDomain))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  for(i = 0; (errNum == WLZ_ERR_NONE) && (i < n); ++i)
+  {
+    doms[i].core = NULL;
+    if(objs[i] == NULL)
+    {
+      errNum = WLZ_ERR_OBJECT_NULL;
+    }
+    else if(objs[i]->type != WLZ_EMPTY_OBJ)
+    {
+      if((objs[i]->type != WLZ_2D_DOMAINOBJ) &&
+         (objs[i]->type != WLZ_3D_DOMAINOBJ))
+      {
+        errNum = WLZ_ERR_OBJECT_TYPE;
+      }
+      else if((oType != WLZ_EMPTY_OBJ) && (objs[i]->type != oType))
+      {
+        errNum = WLZ_ERR_OBJECT_TYPE;
+      }
+      else if(objs[i]->domain.core == NULL)
+      {
+        errNum = WLZ_ERR_DOMAIN_NULL;
+      }
+      else
+      {
+	oType = objs[i]->type;
+        doms[i] = objs[i]->domain;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzDomainSetOpCheck(op);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(oType)
+    {
+      case WLZ_2D_DOMAINOBJ:
+        rDom = WlzDomainSetOp2D(n, doms, op, &errNum);
+	break;
+      case WLZ_3D_DOMAINOBJ:
+        rDom = WlzDomainSetOp3D(n, doms, op, &errNum);
+	break;
+      default:
+        break;
+    }
+  }
+  AlcFree(doms);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(rDom.core == NULL)
+    {
+      rObj = WlzMakeEmpty(&errNum);
+    }
+    else if((rObj = WlzMakeMain(oType, rDom, nullVal, NULL, NULL,
+    				&errNum)) == NULL)
+    {
+      if(oType == WLZ_3D_DOMAINOBJ)
+      {
+        (void )WlzFreePlaneDomain(rDom.p);
+      }
+      else
+      {
+        (void )WlzFreeDomain(rDom);
+      }
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzDomainOps
+* \brief	Checks that the given operator is a set operation.
+* \param	op			Given operator.
+*/
+static WlzErrorNum WlzDomainSetOpCheck(WlzBinaryOperatorType op)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(op)
+  {
+    case WLZ_BO_OR:       /* FALLTHROUGH */
+    case WLZ_BO_AND:      /* FALLTHROUGH */
+    case WLZ_BO_SUBTRACT: /* FALLTHROUGH */
+    case WLZ_BO_XOR:
+      break;
+    default:
+      errNum = WLZ_ERR_PARAM_DATA;
+      break;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Domain of the set operation, with a NULL core pointer
+* 		if the result is empty.
+* \ingroup	WlzDomainOps
+* \brief	Computes a set operation on unchecked 2D domains. The
+* 		line and column bounds of the result are found from
+* 		those of the sources. A counting pass then sums the
+* 		number of source intervals on each line: because the
+* 		result can only change at the 2n distinct end points of
+* 		n intervals this bounds the number of result intervals
+* 		on the line. The intervals are allocated as a single
+* 		block using these counts and each line is then merged
+* 		directly into its place in the block.
+* \param	n			Number of domains.
+* \param	doms			Array of interval domains, a NULL
+* 					core pointer or a domain of type
+* 					WLZ_EMPTY_DOMAIN is an empty domain.
+* \param	op			Set operation.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzDomain WlzDomainSetOpItv(int n, WlzDomain *doms,
+				   WlzBinaryOperatorType op,
+				   WlzErrorNum *dstErr)
+{
+  int		i,
+		ln,
+		nLn,
+		nDom = 0,
+  		nItv = 0,
+  		line1 = 0,
+		lastln = -1,
+		kol1 = 0,
+		lastkl = -1;
+  int		*lnOff = NULL;
+  WlzInterval	*itv = NULL;
+  WlzIntervalDomain *iDom,
+  		*rIDom = NULL;
+  WlzDomain	rDom;
+  WlzDomainSetOpWSp wSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  rDom.core = NULL;
+  wSp.n = n;
+  wSp.op = op;
+  wSp.cur = NULL;
+  wSp.cnt = NULL;
+  wSp.heap = NULL;
+  wSp.rItv = NULL;
+  switch(op)
+  {
+    case WLZ_BO_OR:
+      wSp.sMin = 1;
+      wSp.sMax = INT_MAX;
+      break;
+    case WLZ_BO_AND:      /* FALLTHROUGH */
+    case WLZ_BO_SUBTRACT:
+      wSp.sMin = wSp.sMax = n;
+      break;
+    default:
+      wSp.sMin = wSp.sMax = 0;
+      break;
+  }
+  if(((wSp.dom = (WlzIntervalDomain **)
+                 AlcMalloc(n * sizeof(WlzIntervalDomain *))) == NULL) ||
+     ((wSp.rItv = (WlzInterval *)
+                  AlcMalloc(n * sizeof(WlzInterval))) == NULL) ||
+     ((wSp.cur = (WlzDomainSetOpCur *)
+                 AlcMalloc(n * sizeof(WlzDomainSetOpCur))) == NULL) ||
+     ((wSp.heap = (int *)AlcMalloc(n * sizeof(int))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  /* Find the line and column bounds of the result. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(i = 0; i < n; ++i)
+    {
+      wSp.dom[i] = NULL;
+      if((doms[i].core == NULL) || (doms[i].core->type == WLZ_EMPTY_DOMAIN))
+      {
+	if((op == WLZ_BO_AND) || ((op == WLZ_BO_SUBTRACT) && (i == 0)))
+	{
+	  nDom = 0;
+	  break;
+	}
+      }
+      else
+      {
+	iDom = wSp.dom[i] = doms[i].i;
+	wSp.rItv[i].ileft = 0;
+	wSp.rItv[i].iright = iDom->lastkl - iDom->kol1;
+	if(nDom++ == 0)
+	{
+	  line1 = iDom->line1;
+	  lastln = iDom->lastln;
+	  kol1 = iDom->kol1;
+	  lastkl = iDom->lastkl;
+	}
+	else if((op == WLZ_BO_OR) || (op == WLZ_BO_XOR))
+	{
+	  line1 = ALG_MIN(line1, iDom->line1);
+	  lastln = ALG_MAX(lastln, iDom->lastln);
+	  kol1 = ALG_MIN(kol1, iDom->kol1);
+	  lastkl = ALG_MAX(lastkl, iDom->lastkl);
+	}
+	else if(op == WLZ_BO_AND)
+	{
+	  line1 = ALG_MAX(line1, iDom->line1);
+	  lastln = ALG_MIN(lastln, iDom->lastln);
+	  kol1 = ALG_MAX(kol1, iDom->kol1);
+	  lastkl = ALG_MIN(lastkl, iDom->lastkl);
+	}
+      }
+    }
+    if((nDom == 0) || (line1 > lastln) || (kol1 > lastkl))
+    {
+      lastln = line1 - 1;
+    }
+  }
+  /* Count the source intervals on each line, which bounds the number
+   * of result intervals on the line, and so find the offset of each
+   * line's intervals in the result. */
+  nLn = lastln - line1 + 1;
+  if((errNum == WLZ_ERR_NONE) && (nLn > 0))
+  {
+    wSp.kol1 = kol1;
+    wSp.lastkl = lastkl;
+    if(((lnOff = (int *)AlcMalloc(nLn * sizeof(int))) == NULL) ||
+       ((wSp.cnt = (int *)AlcCalloc(lastkl - kol1 + 2, sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      for(ln = line1; ln <= lastln; ++ln)
+      {
+	lnOff[ln - line1] = nItv;
+        nItv += WlzDomainSetOpLine(&wSp, ln, NULL);
+      }
+    }
+  }
+  /* Make the result domain and merge each line's intervals into it. */
+  if((errNum == WLZ_ERR_NONE) && (nItv > 0))
+  {
+    if((rIDom = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
+				      line1, lastln, kol1, lastkl,
+				      &errNum)) != NULL)
+    {
+      if((itv = (WlzInterval *)AlcMalloc(nItv * sizeof(WlzInterval))) == NULL)
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+	rIDom->freeptr = AlcFreeStackPush(rIDom->freeptr, (void *)itv, NULL);
+      }
+    }
+  }
+  if(rIDom != NULL)
+  {
+    int		nRItv = 0,
+    		rLn0 = INT_MAX,
+		rLn1 = INT_MIN,
+		rKl0 = INT_MAX,
+		rKl1 = INT_MIN;
+
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(ln = line1; ln <= lastln; ++ln)
+      {
+	WlzInterval *lnItv;
+
+	lnItv = itv + lnOff[ln - line1];
+	i = WlzDomainSetOpLine(&wSp, ln, lnItv);
+	(void )WlzMakeInterval(ln, rIDom, i, lnItv);
+	if(i > 0)
+	{
+	  nRItv += i;
+	  rLn0 = ALG_MIN(rLn0, ln);
+	  rLn1 = ln;
+	  rKl0 = ALG_MIN(rKl0, lnItv[0].ileft);
+	  rKl1 = ALG_MAX(rKl1, lnItv[i - 1].iright);
+	}
+      }
+      /* Only standardise the domain if the result is not already tight
+       * within the bounds found from the sources. */
+      if((nRItv > 0) &&
+         ((rLn0 != line1) || (rLn1 != lastln) ||
+	  (rKl0 != 0) || (rKl1 != lastkl - kol1)))
+      {
+	errNum = WlzStandardIntervalDomain(rIDom);
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && (nRItv > 0))
+    {
+      rDom.i = rIDom;
+    }
+    else
+    {
+      (void )WlzFreeIntervalDomain(rIDom);
+    }
+  }
+  AlcFree(lnOff);
+  AlcFree(wSp.dom);
+  AlcFree(wSp.rItv);
+  AlcFree(wSp.cur);
+  AlcFree(wSp.cnt);
+  AlcFree(wSp.heap);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rDom);
+}
+
+/*!
+* \return	Number of intervals of the result on the line or, if
+* 		the destination is NULL, the number of source
+* 		intervals which bounds it.
+* \ingroup	WlzDomainOps
+* \brief	Computes the set operation for a single line. A cursor
+* 		is set up for each source with intervals on the line
+* 		and then, if the span of these intervals is small
+* 		compared to their number, the weights are accumulated
+* 		in a dense array by WlzDomainSetOpLineDense(). Otherwise
+* 		the interval end points are merged in column order while
+* 		maintaining the sum of the weights of the sources
+* 		covering the current column. The next column is found
+* 		by a linear search of the cursors when there are few of
+* 		them and using a min-heap of the cursors otherwise.
+* 		Since the sum is only tested after all the events at a
+* 		column have been processed, abutting intervals are
+* 		merged.
+* \param	wSp			Work space.
+* \param	ln			The line.
+* \param	dst			Destination for the result intervals,
+* 					if NULL the source intervals are
+* 					only counted.
+*/
+static int	WlzDomainSetOpLine(WlzDomainSetOpWSp *wSp, int ln,
+				   WlzInterval *dst)
+{
+  int		i,
+  		lo,
+		hi,
+  		pos,
+		nI,
+		nE = 0,
+		nA = 0,
+		nH,
+		sum = 0,
+		inR = 0,
+		inS = 0,
+		done = 0,
+		lft = 0,
+		nR = 0;
+  int		*heap;
+  WlzInterval	*itv;
+  WlzIntervalDomain *iDom;
+  WlzDomainSetOpCur *cur;
+
+  /* Set up a cursor for each source with intervals on this line. */
+  lo = INT_MAX;
+  hi = INT_MIN;
+  for(i = 0; i < wSp->n; ++i)
+  {
+    nI = 0;
+    if(((iDom = wSp->dom[i]) != NULL) &&
+       (ln >= iDom->line1) && (ln <= iDom->lastln))
+    {
+      if(iDom->type == WLZ_INTERVALDOMAIN_RECT)
+      {
+        nI = 1;
+	itv = wSp->rItv + i;
+      }
+      else
+      {
+	WlzIntervalLine *itvLn;
+
+	itvLn = iDom->intvlines + ln - iDom->line1;
+        nI = itvLn->nintvs;
+	itv = itvLn->intvs;
+      }
+    }
+    if(nI > 0)
+    {
+      nE += nI;
+      if(dst)
+      {
+	cur = wSp->cur + nA;
+	cur->w = ((wSp->op == WLZ_BO_SUBTRACT) && (i == 0))? wSp->n: 1;
+	cur->in = 0;
+	cur->kol1 = iDom->kol1;
+	cur->itv = itv;
+	cur->lst = itv + nI;
+	cur->pos = iDom->kol1 + itv->ileft;
+	lo = ALG_MIN(lo, cur->pos);
+	hi = ALG_MAX(hi, iDom->kol1 + itv[nI - 1].iright);
+	wSp->heap[nA] = nA;
+	++nA;
+      }
+    }
+    else if((wSp->op == WLZ_BO_AND) ||
+            ((wSp->op == WLZ_BO_SUBTRACT) && (i == 0)))
+    {
+      return(0);
+    }
+  }
+  if(dst == NULL)
+  {
+    return(nE);
+  }
+  lo = ALG_MAX(lo, wSp->kol1);
+  hi = ALG_MIN(hi, wSp->lastkl);
+  if((nA == 0) || (lo > hi))
+  {
+    return(0);
+  }
+  /* With a single source on the line the result is either empty or a copy
+   * of its intervals clipped to the bounds. */
+  if(nA == 1)
+  {
+    cur = wSp->cur;
+    for(itv = cur->itv; itv < cur->lst; ++itv)
+    {
+      int	l,
+      		r;
+
+      l = ALG_MAX(cur->kol1 + itv->ileft, lo);
+      r = ALG_MIN(cur->kol1 + itv->iright, hi);
+      if(l <= r)
+      {
+	dst[nR].ileft = l - wSp->kol1;
+	dst[nR].iright = r - wSp->kol1;
+	++nR;
+      }
+    }
+    return(nR);
+  }
+  if(hi - lo < 8 * nE)
+  {
+    return(WlzDomainSetOpLineDense(wSp, nA, lo, hi, dst));
+  }
+  heap = wSp->heap;
+  cur = wSp->cur;
+  nH = nA;
+  if(nA > WLZ_DOMAINSETOP_LINSRCH)
+  {
+    for(i = nH / 2 - 1; i >= 0; --i)
+    {
+      WlzDomainSetOpHeapDown(heap, nH, i, cur);
+    }
+  }
+  /* Sweep through the events in column order. */
+  while((nH > 0) && (done == 0))
+  {
+    if(nA <= WLZ_DOMAINSETOP_LINSRCH)
+    {
+      /* Few sources so search them all, exhausted cursors being left
+       * at INT_MAX. */
+      pos = cur[0].pos;
+      for(i = 1; i < nA; ++i)
+      {
+        pos = ALG_MIN(pos, cur[i].pos);
+      }
+      for(i = 0; i < nA; ++i)
+      {
+	WlzDomainSetOpCur *c;
+
+	c = cur + i;
+        while(c->pos == pos)
+	{
+	  if(c->in == 0)
+	  {
+	    c->in = 1;
+	    sum += c->w;
+	    c->pos = c->kol1 + c->itv->iright + 1;
+	  }
+	  else
+	  {
+	    c->in = 0;
+	    sum -= c->w;
+	    if(++(c->itv) < c->lst)
+	    {
+	      c->pos = c->kol1 + c->itv->ileft;
+	    }
+	    else
+	    {
+	      c->pos = INT_MAX;
+	      --nH;
+	      done |= (wSp->op == WLZ_BO_AND) ||
+	              ((wSp->op == WLZ_BO_SUBTRACT) && (c->w > 1));
+	    }
+	  }
+	}
+      }
+    }
+    else
+    {
+      pos = cur[heap[0]].pos;
+      do
+      {
+	if(WlzDomainSetOpEvent(wSp, cur + heap[0], &sum, &done))
+	{
+	  heap[0] = heap[--nH];
+	}
+	WlzDomainSetOpHeapDown(heap, nH, 0, cur);
+      } while((nH > 0) && (cur[heap[0]].pos == pos));
+    }
+    inS = (wSp->op == WLZ_BO_XOR)? (sum & 1):
+    				   (sum >= wSp->sMin) && (sum <= wSp->sMax);
+    if(inS != inR)
+    {
+      if(inS)
+      {
+        lft = pos;
+      }
+      else
+      {
+	dst[nR].ileft = lft - wSp->kol1;
+	dst[nR].iright = pos - 1 - wSp->kol1;
+	++nR;
+      }
+      inR = inS;
+    }
+  }
+  return(nR);
+}
+
+/*!
+* \return	Non-zero if the cursor has passed its last interval.
+* \ingroup	WlzDomainOps
+* \brief	Processes the next event of a cursor, either entering
+* 		or leaving its current interval, updating the sum of
+* 		the weights and advancing the cursor as required.
+* \param	wSp			Work space.
+* \param	c			The cursor.
+* \param	sum			Sum of the weights to update.
+* \param	done			Set non-zero if no further result
+* 					intervals are possible on the line.
+*/
+static int	WlzDomainSetOpEvent(WlzDomainSetOpWSp *wSp,
+				    WlzDomainSetOpCur *c,
+				    int *sum, int *done)
+{
+  int		fin = 0;
+
+  if(c->in == 0)
+  {
+    c->in = 1;
+    *sum += c->w;
+    c->pos = c->kol1 + c->itv->iright + 1;
+  }
+  else
+  {
+    c->in = 0;
+    *sum -= c->w;
+    if(++(c->itv) < c->lst)
+    {
+      c->pos = c->kol1 + c->itv->ileft;
+    }
+    else
+    {
+      fin = 1;
+      if((wSp->op == WLZ_BO_AND) ||
+	 ((wSp->op == WLZ_BO_SUBTRACT) && (c->w > 1)))
+      {
+	*done = 1;
+      }
+    }
+  }
+  return(fin);
+}
+
+/*!
+* \return	Number of intervals of the result on the line.
+* \ingroup	WlzDomainOps
+* \brief	Computes the set operation for a single line in which
+* 		the intervals are dense. The weight of each source is
+* 		added at the start and subtracted after the end of its
+* 		intervals in the work space's difference array, which
+* 		is then summed along the columns, being cleared as it
+* 		goes, to find the result intervals. Intervals are
+* 		clipped to the columns lo to hi.
+* \param	wSp			Work space with cursors set up for
+* 					the line.
+* \param	nA			Number of cursors.
+* \param	lo			First column to consider.
+* \param	hi			Last column to consider.
+* \param	dst			Destination for the result intervals.
+*/
+static int	WlzDomainSetOpLineDense(WlzDomainSetOpWSp *wSp,
+					int nA, int lo, int hi,
+					WlzInterval *dst)
+{
+  int		i,
+  		l,
+		r,
+		k,
+		k1,
+		sum = 0,
+		inR = 0,
+		inS,
+		lft = 0,
+		nR = 0;
+  int		*cnt;
+  WlzInterval	*itv;
+  WlzDomainSetOpCur *cur;
+
+  k1 = wSp->kol1;
+  cnt = wSp->cnt;
+  for(i = 0; i < nA; ++i)
+  {
+    cur = wSp->cur + i;
+    for(itv = cur->itv; itv < cur->lst; ++itv)
+    {
+      l = cur->kol1 + itv->ileft;
+      r = cur->kol1 + itv->iright;
+      if((l <= hi) && (r >= lo))
+      {
+        cnt[ALG_MAX(l, lo) - k1] += cur->w;
+	if(r < hi)
+	{
+	  cnt[r + 1 - k1] -= cur->w;
+	}
+      }
+    }
+  }
+  for(k = lo; k <= hi; ++k)
+  {
+    sum += cnt[k - k1];
+    cnt[k - k1] = 0;
+    inS = (wSp->op == WLZ_BO_XOR)? (sum & 1):
+    				   (sum >= wSp->sMin) && (sum <= wSp->sMax);
+    if(inS != inR)
+    {
+      if(inS)
+      {
+        lft = k;
+      }
+      else
+      {
+	dst[nR].ileft = lft - k1;
+	dst[nR].iright = k - 1 - k1;
+	++nR;
+      }
+      inR = inS;
+    }
+  }
+  if(inR)
+  {
+    dst[nR].ileft = lft - k1;
+    dst[nR].iright = hi - k1;
+    ++nR;
+  }
+  return(nR);
+}
+
+/*!
+* \ingroup	WlzDomainOps
+* \brief	Restores the min-heap property below the given heap
+* 		entry.
+* \param	heap			Heap of cursor indices.
+* \param	nH			Number of entries in the heap.
+* \param	idx			Index of the heap entry.
+* \param	cur			Cursors keyed by their position.
+*/
+static void	WlzDomainSetOpHeapDown(int *heap, int nH, int idx,
+				       WlzDomainSetOpCur *cur)
+{
+  int		c,
+  		t;
+
+  while((c = 2 * idx + 1) < nH)
+  {
+    if((c + 1 < nH) && (cur[heap[c + 1]].pos < cur[heap[c]].pos))
+    {
+      ++c;
+    }
+    if(cur[heap[idx]].pos <= cur[heap[c]].pos)
+    {
+      break;
+    }
+    t = heap[idx];
+    heap[idx] = heap[c];
+    heap[c] = t;
+    idx = c;
+  }
+}
@@ -753,7 +753,36 @@ WlzErrorNum	WlzFreeContour(WlzContour *ctr)
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzAllocation
-* \brief	Frees an indexed valuetable.
+* \brief	Frees an indexed triangle mesh.
+* \param	mesh			Given mesh.
+*/
+WlzErrorNum	WlzFreeIdxMesh3D(WlzIdxMesh3D *mesh)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    AlcFree(mesh->vtx);
+    AlcFree(mesh->tri);
+    AlcFree(mesh);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAllocation
+* \brief	Frees an indexed valuetable if it's linkcount allows.
+* 		As for the other valuetables the linkcount is decremented
+* 		and the valuetable is only free'd when it is no longer
+* 		linked, ie a valuetable which has not been assigned or
+* 		which has been assigned just once is free'd. A valuetable
+* 		which is shared (eg by several objects) is now free'd by
+* 		the last holder rather than the first.
 * \param	ixv			Given indexed valuetable.
 */
 WlzErrorNum	WlzFreeIndexedValues(WlzIndexedValues *ixv)
@@ -768,7 +797,7 @@ WlzErrorNum	WlzFreeIndexedValues(WlzIndexedValues *ixv)
   {
     errNum = WLZ_ERR_VALUES_TYPE;
   }
-  else
+  else if(WlzUnlink(&(ixv->linkcount), &errNum))
   {
     (void )AlcVectorFree(ixv->values);
     if(ixv->rank > 0)
@@ -783,7 +812,9 @@ WlzErrorNum	WlzFreeIndexedValues(WlzIndexedValues *ixv)
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzAllocation
-* \brief	Frees a points valuetable.
+* \brief	Frees a points valuetable if it's linkcount allows.
+* 		As for WlzFreeIndexedValues() the valuetable is only
+* 		free'd when it is no longer linked.
 * \param	pv			Given  points valuetable.
 */
 WlzErrorNum	WlzFreePointValues(WlzPointValues *pv)
@@ -798,7 +829,7 @@ WlzErrorNum	WlzFreePointValues(WlzPointValues *pv)
   {
     errNum = WLZ_ERR_VALUES_TYPE;
   }
-  else
+  else if(WlzUnlink(&(pv->linkcount), &errNum))
   {
     (void )AlcFree(pv->values.v);
     if(pv->rank > 0)
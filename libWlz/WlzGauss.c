@@ -35,19 +35,101 @@ static char _WlzGauss_c[] = "University of Edinburgh $Id$";
 * License along with this program; if not, write to the Free
 * Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
 * Boston, MA  02110-1301, USA.
-* \brief	Gaussian filter fo 2D objects with values.
-* 		Uses WlzSepTrans() and for colour images can only
-* 		do smoothing correctly (i.e. derivative zero).
+* \brief	Gaussian filters for objects with values.
+* 		WlzGauss2() filters 2D objects using WlzSepTrans() and
+* 		for colour images can only do smoothing correctly (i.e.
+* 		derivative zero). WlzGaussObj() filters 2D and 3D
+* 		objects using a recursive filter for which the cost
+* 		is independent of the Gaussian width.
 * \ingroup	WlzValuesFilters
 */
 
 #include <stdlib.h>
 #include <limits.h>
 #include <float.h>
+#include <math.h>
 #include <Wlz.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #define AFACTOR	100
 
+/*!
+* \def		WLZ_GAUSSRSV_BLOCK_WIDTH
+* \ingroup	WlzValuesFilters
+* \brief	Number of adjacent lines filtered together when filtering
+*		through the columns or planes of a volume.
+*/
+#define WLZ_GAUSSRSV_BLOCK_WIDTH	(64)
+
+/*!
+* \struct	_WlzGaussRsvCoef
+* \ingroup	WlzValuesFilters
+* \brief	Coefficients of a third order recursive Gaussian filter
+*		along a single direction, with the filter
+*		\f$y_n = b x_n + a_0 y_{n-1} + a_1 y_{n-2} + a_2 y_{n-3}\f$
+*		applied causally and then anti-causally.
+*		Typedef: ::WlzGaussRsvCoef.
+*/
+typedef struct _WlzGaussRsvCoef
+{
+  int		smooth;			/*!< Non-zero if smoothing is to
+  					     be done. */
+  int		order;			/*!< Derivative order. */
+  double	b;			/*!< Input coefficient. */
+  double	a[3];			/*!< Feedback coefficients. */
+  double	m[3][3];		/*!< Matrix mapping the last three
+  					     causal values to the first three
+					     anti-causal values. */
+} WlzGaussRsvCoef;
+
+static void			WlzGaussRsvLines(
+				  WlzGaussRsvCoef *coef,
+				  double *d,
+				  size_t stp,
+				  int n,
+				  int w,
+				  double *tmp);
+static void			WlzGaussRsvSmooth(
+				  WlzGaussRsvCoef *coef,
+				  double *d,
+				  size_t stp,
+				  int n,
+				  int w,
+				  double *zero);
+static void			WlzGaussRsvDiff(
+				  int order,
+				  double *d,
+				  size_t stp,
+				  int n,
+				  int w,
+				  double *prv);
+static WlzObject		*WlzGaussObjPlane(
+				  WlzObject *obj,
+				  int pln,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzGaussRsvCoefSet(
+				  WlzGaussRsvCoef *coef,
+				  double sigma,
+				  int order);
+static WlzErrorNum		WlzGaussRsvPass(
+				  WlzGaussRsvCoef *coef,
+				  double *vol,
+				  WlzIVertex3 vSz,
+				  int axis,
+				  int nThr);
+static WlzErrorNum		WlzGaussObjRead(
+				  WlzObject *obj,
+				  WlzIBox3 bBox,
+				  double bkg,
+				  double *vol);
+static WlzErrorNum		WlzGaussObjWrite(
+				  WlzObject *obj,
+				  WlzIBox3 bBox,
+				  double *vol);
+
 /* function:     WlzGauss2    */
 /*! 
 * \ingroup      WlzValuesFilters
@@ -994,3 +1076,758 @@ WlzErrorNum Wlz1DConv(
 
   return WLZ_ERR_NONE;
 }
+
+/*!
+* \return	New filtered object or NULL on error.
+* \ingroup	WlzValuesFilters
+* \brief	Applies a Gaussian filter (or a derivative of a Gaussian)
+*		to the values of a 2D or 3D domain object, with a cost
+*		which is independent of the Gaussian's width.
+*		The filter is a third order recursive (IIR) filter
+*		applied forwards and then backwards along each of the
+*		lines, columns and (for 3D objects) planes of the
+*		object's bounding box. The coefficients are those of
+*		Young and van Vliet (Signal Processing 44 1995) and the
+*		backwards pass is initialised as described by Triggs
+*		and Sdika (IEEE Trans. Signal Processing 54 2006), so
+*		there is no truncation of the filter at the bounding
+*		box. Derivatives are computed using central differences
+*		of the smoothed values.
+*		Values outside of the object's domain are taken to be
+*		the object's background value. Filtering along each
+*		direction is done in parallel over the lines of the
+*		bounding box, with the column and plane directions
+*		filtered in blocks of adjacent columns for efficient
+*		memory access.
+*		The grey type of the returned object is promoted as
+*		for WlzRsvFilterObj(): WlzUByte values give short
+*		values, otherwise the grey type is unchanged.
+* \param	gObj			Given 2D or 3D domain object with
+*					int, short, WlzUByte, float or
+*					double values.
+* \param	sigma			Gaussian sigma in each direction,
+*					values less than 0.5 give no
+*					smoothing in that direction. The
+*					z component is ignored for 2D
+*					objects.
+* \param	order			Order of the derivative in each
+*					direction, with values 0, 1 or 2.
+*					The z component is ignored for 2D
+*					objects.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzGaussObj(WlzObject *gObj, WlzDVertex3 sigma,
+			     WlzIVertex3 order, WlzErrorNum *dstErr)
+{
+  int		idA,
+  		dim = 0,
+		nThr = 1,
+		derFlg = 0;
+  size_t	nV;
+  double	bkg = 0.0;
+  double	*vol = NULL;
+  WlzGreyType	gType = WLZ_GREY_ERROR,
+  		rGType = WLZ_GREY_ERROR;
+  WlzIBox3	bBox;
+  WlzIVertex3	vSz;
+  WlzPixelV	bgdV,
+  		rBgdV;
+  WlzGaussRsvCoef coef[3];
+  WlzObject	*rObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(gObj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if((gObj->type != WLZ_2D_DOMAINOBJ) &&
+          (gObj->type != WLZ_3D_DOMAINOBJ))
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if(gObj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if(gObj->values.core == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(WlzGreyTableIsTiled(gObj->values.core->type))
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else
+  {
+    dim = (gObj->type == WLZ_2D_DOMAINOBJ)? 2: 3;
+    if(dim == 2)
+    {
+      sigma.vtZ = 0.0;
+      order.vtZ = 0;
+    }
+    if((order.vtX < 0) || (order.vtX > 2) ||
+       (order.vtY < 0) || (order.vtY > 2) ||
+       (order.vtZ < 0) || (order.vtZ > 2))
+    {
+      errNum = WLZ_ERR_PARAM_DATA;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    gType = WlzGreyTypeFromObj(gObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(gType)
+    {
+      case WLZ_GREY_UBYTE: /* FALLTHROUGH */
+      case WLZ_GREY_SHORT:
+        rGType = WLZ_GREY_SHORT;
+	break;
+      case WLZ_GREY_INT:   /* FALLTHROUGH */
+      case WLZ_GREY_FLOAT: /* FALLTHROUGH */
+      case WLZ_GREY_DOUBLE:
+        rGType = gType;
+	break;
+      default:
+        errNum = WLZ_ERR_GREY_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bgdV = WlzGetBackground(gObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rBgdV = bgdV;
+    errNum = WlzValueConvertPixel(&rBgdV, bgdV, WLZ_GREY_DOUBLE);
+    bkg = rBgdV.v.dbv;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bBox = WlzBoundingBox3I(gObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(dim == 2)
+    {
+      bBox.zMin = bBox.zMax = 0;
+    }
+    vSz.vtX = bBox.xMax - bBox.xMin + 1;
+    vSz.vtY = bBox.yMax - bBox.yMin + 1;
+    vSz.vtZ = bBox.zMax - bBox.zMin + 1;
+    nV = (size_t )(vSz.vtX) * vSz.vtY * vSz.vtZ;
+    if((vol = (double *)AlcMalloc(sizeof(double) * nV)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzGaussObjRead(gObj, bBox, bkg, vol);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+    nThr = omp_get_max_threads();
+#endif
+    derFlg = (order.vtX != 0) || (order.vtY != 0) || (order.vtZ != 0);
+    for(idA = 0; (errNum == WLZ_ERR_NONE) && (idA < 3); ++idA)
+    {
+      errNum = WlzGaussRsvCoefSet(coef + idA,
+                                  (idA == 0)? sigma.vtX:
+				  (idA == 1)? sigma.vtY: sigma.vtZ,
+				  (idA == 0)? order.vtX:
+				  (idA == 1)? order.vtY: order.vtZ);
+    }
+    for(idA = 0; (errNum == WLZ_ERR_NONE) && (idA < dim); ++idA)
+    {
+      if(coef[idA].smooth || coef[idA].order)
+      {
+        errNum = WlzGaussRsvPass(coef + idA, vol, vSz, idA, nThr);
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* The filters were applied to the values less the background, so
+     * restore the (smoothed) background unless a derivative was
+     * computed. */
+    if(derFlg)
+    {
+      bkg = 0.0;
+    }
+    else
+    {
+      size_t	idx;
+
+      for(idx = 0; idx < nV; ++idx)
+      {
+        vol[idx] += bkg;
+      }
+    }
+    rBgdV.type = WLZ_GREY_DOUBLE;
+    rBgdV.v.dbv = bkg;
+    errNum = WlzValueConvertPixel(&rBgdV, rBgdV, rGType);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    WlzObjectType tType;
+
+    tType = WlzGreyTableType(WLZ_GREY_TAB_RAGR, rGType, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      rObj = WlzNewObjectValues(gObj, tType, rBgdV, 0, rBgdV, &errNum);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzGaussObjWrite(rObj, bBox, vol);
+  }
+  AlcFree(vol);
+  if((errNum != WLZ_ERR_NONE) && (rObj != NULL))
+  {
+    (void )WlzFreeObj(rObj);
+    rObj = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Sets the coefficients of a third order recursive
+*		Gaussian filter using the method of Young and van Vliet
+*		and computes the matrix which maps the final three values
+*		of the causal pass to the initial three values of the
+*		anti-causal pass, for data which are zero beyond the
+*		end of the line (Triggs and Sdika). Rather than use the
+*		closed form of the matrix, it is computed by running the
+*		filter over a zero tail long enough for the filter
+*		response to have decayed to negligible values.
+* \param	coef			Coefficients to set.
+* \param	sigma			Gaussian sigma, if less than 0.5
+*					then no smoothing is done.
+* \param	order			Derivative order.
+*/
+static WlzErrorNum WlzGaussRsvCoefSet(WlzGaussRsvCoef *coef, double sigma,
+				      int order)
+{
+  int		idI,
+  		idK,
+		nT;
+  double	b0,
+  		q,
+		q2,
+		q3;
+  double	*w = NULL,
+  		*y = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  coef->order = order;
+  coef->smooth = sigma >= 0.5;
+  if(coef->smooth)
+  {
+    q = (sigma >= 2.5)? (0.98711 * sigma) - 0.96330:
+                        3.97156 - (4.14554 * sqrt(1.0 - (0.26891 * sigma)));
+    q2 = q * q;
+    q3 = q2 * q;
+    b0 = 1.57825 + (2.44413 * q) + (1.4281 * q2) + (0.422205 * q3);
+    coef->a[0] = ((2.44413 * q) + (2.85619 * q2) + (1.26661 * q3)) / b0;
+    coef->a[1] = -((1.4281 * q2) + (1.26661 * q3)) / b0;
+    coef->a[2] = (0.422205 * q3) / b0;
+    coef->b = 1.0 - (coef->a[0] + coef->a[1] + coef->a[2]);
+    /* The filter's impulse response decays by more than a factor of
+     * exp(-1/q) per sample, so a tail of 40q samples is ample. */
+    nT = 3 + (int )(40.0 * q) + 16;
+    if(((w = (double *)AlcMalloc(sizeof(double) * nT)) == NULL) ||
+       ((y = (double *)AlcMalloc(sizeof(double) * nT)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(coef->smooth && (errNum == WLZ_ERR_NONE))
+  {
+    for(idK = 0; idK < 3; ++idK)
+    {
+      /* Causal values w[0], w[1], w[2] are the final three values of the
+       * line (in order of increasing index), continued over the zero
+       * tail. */
+      for(idI = 0; idI < 3; ++idI)
+      {
+        w[idI] = (idI == 2 - idK)? 1.0: 0.0;
+      }
+      for(idI = 3; idI < nT; ++idI)
+      {
+        w[idI] = (coef->a[0] * w[idI - 1]) + (coef->a[1] * w[idI - 2]) +
+		 (coef->a[2] * w[idI - 3]);
+      }
+      y[nT - 1] = y[nT - 2] = y[nT - 3] = 0.0;
+      for(idI = nT - 4; idI >= 0; --idI)
+      {
+        y[idI] = (coef->b * w[idI]) + (coef->a[0] * y[idI + 1]) +
+		 (coef->a[1] * y[idI + 2]) + (coef->a[2] * y[idI + 3]);
+      }
+      /* Column idK of the matrix, ie the response to a unit value at
+       * the idK'th from last causal value. */
+      for(idI = 0; idI < 3; ++idI)
+      {
+        coef->m[idI][idK] = y[2 - idI];
+      }
+    }
+  }
+  AlcFree(w);
+  AlcFree(y);
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesFilters
+* \brief	Applies a recursive Gaussian filter and/or a central
+*		difference derivative to adjacent lines of data. The
+*		lines are filtered together, with the w adjacent values
+*		at each position along the lines being contiguous, which
+*		allows the inner loops to be vectorised when filtering
+*		through columns or planes.
+* \param	coef			Filter coefficients.
+* \param	d			Data, the first value of the first
+*					line.
+* \param	stp			Step between successive values along
+*					a line.
+* \param	n			Number of values along each line.
+* \param	w			Number of adjacent lines.
+* \param	tmp			Temporary buffer of at least 5w
+*					values.
+*/
+static void	WlzGaussRsvLines(WlzGaussRsvCoef *coef, double *d,
+				 size_t stp, int n, int w, double *tmp)
+{
+  int		idI,
+  		idJ;
+  double	*pad;
+
+  if(coef->smooth)
+  {
+    if(n < 3)
+    {
+      /* Too short for the anti-causal initialisation, so filter a copy
+       * padded with zeros, which is consistent with the data being zero
+       * beyond the end of the line. */
+      pad = tmp + w;
+      for(idI = 0; idI < 3; ++idI)
+      {
+	for(idJ = 0; idJ < w; ++idJ)
+	{
+	  pad[(idI * w) + idJ] = (idI < n)? d[(idI * stp) + idJ]: 0.0;
+	}
+      }
+      WlzGaussRsvSmooth(coef, pad, w, 3, w, tmp);
+      for(idI = 0; idI < n; ++idI)
+      {
+	for(idJ = 0; idJ < w; ++idJ)
+	{
+	  d[(idI * stp) + idJ] = pad[(idI * w) + idJ];
+	}
+      }
+    }
+    else
+    {
+      WlzGaussRsvSmooth(coef, d, stp, n, w, tmp);
+    }
+  }
+  if(coef->order)
+  {
+    WlzGaussRsvDiff(coef->order, d, stp, n, w, tmp);
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesFilters
+* \brief	Applies the causal and then the anti-causal recursive
+*		Gaussian filter in place to adjacent lines of at least
+*		three values, which are assumed to be zero beyond the
+*		ends of the lines.
+* \param	coef			Filter coefficients.
+* \param	d			Data, the first value of the first
+*					line.
+* \param	stp			Step between successive values along
+*					a line.
+* \param	n			Number of values along each line,
+*					must be at least 3.
+* \param	w			Number of adjacent lines.
+* \param	zero			Buffer for w zero values.
+*/
+static void	WlzGaussRsvSmooth(WlzGaussRsvCoef *coef, double *d,
+				  size_t stp, int n, int w, double *zero)
+{
+  int		idI,
+  		idJ;
+  double	a0,
+  		a1,
+		a2,
+		b,
+		w0,
+		w1,
+		w2;
+  double	*p0,
+  		*p1,
+		*p2,
+		*p3;
+
+  b = coef->b;
+  a0 = coef->a[0];
+  a1 = coef->a[1];
+  a2 = coef->a[2];
+  for(idJ = 0; idJ < w; ++idJ)
+  {
+    zero[idJ] = 0.0;
+  }
+  /* Causal pass. */
+  for(idI = 0; idI < n; ++idI)
+  {
+    p0 = d + (idI * stp);
+    p1 = (idI > 0)? p0 - stp: zero;
+    p2 = (idI > 1)? p0 - (2 * stp): zero;
+    p3 = (idI > 2)? p0 - (3 * stp): zero;
+    for(idJ = 0; idJ < w; ++idJ)
+    {
+      p0[idJ] = (b * p0[idJ]) + (a0 * p1[idJ]) + (a1 * p2[idJ]) +
+                (a2 * p3[idJ]);
+    }
+  }
+  /* Initialise the anti-causal pass from the last three causal values. */
+  p0 = d + ((n - 1) * stp);
+  p1 = p0 - stp;
+  p2 = p1 - stp;
+  for(idJ = 0; idJ < w; ++idJ)
+  {
+    w0 = p0[idJ];
+    w1 = p1[idJ];
+    w2 = p2[idJ];
+    p0[idJ] = (coef->m[0][0] * w0) + (coef->m[0][1] * w1) +
+              (coef->m[0][2] * w2);
+    p1[idJ] = (coef->m[1][0] * w0) + (coef->m[1][1] * w1) +
+              (coef->m[1][2] * w2);
+    p2[idJ] = (coef->m[2][0] * w0) + (coef->m[2][1] * w1) +
+              (coef->m[2][2] * w2);
+  }
+  /* Anti-causal pass. */
+  for(idI = n - 4; idI >= 0; --idI)
+  {
+    p0 = d + (idI * stp);
+    p1 = p0 + stp;
+    p2 = p1 + stp;
+    p3 = p2 + stp;
+    for(idJ = 0; idJ < w; ++idJ)
+    {
+      p0[idJ] = (b * p0[idJ]) + (a0 * p1[idJ]) + (a1 * p2[idJ]) +
+                (a2 * p3[idJ]);
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesFilters
+* \brief	Computes first or second derivatives in place along
+*		adjacent lines using central differences, with the
+*		values replicated beyond the ends of the lines.
+* \param	order			Derivative order, 1 or 2.
+* \param	d			Data, the first value of the first
+*					line.
+* \param	stp			Step between successive values along
+*					a line.
+* \param	n			Number of values along each line.
+* \param	w			Number of adjacent lines.
+* \param	prv			Buffer for w values.
+*/
+static void	WlzGaussRsvDiff(int order, double *d, size_t stp, int n,
+				int w, double *prv)
+{
+  int		idI,
+  		idJ;
+  double	c;
+  double	*p0,
+  		*p1;
+
+  for(idJ = 0; idJ < w; ++idJ)
+  {
+    prv[idJ] = d[idJ];
+  }
+  for(idI = 0; idI < n; ++idI)
+  {
+    p0 = d + (idI * stp);
+    p1 = (idI < n - 1)? p0 + stp: p0;
+    if(order == 1)
+    {
+      for(idJ = 0; idJ < w; ++idJ)
+      {
+        c = p0[idJ];
+	p0[idJ] = 0.5 * (p1[idJ] - prv[idJ]);
+	prv[idJ] = c;
+      }
+    }
+    else
+    {
+      for(idJ = 0; idJ < w; ++idJ)
+      {
+        c = p0[idJ];
+	p0[idJ] = p1[idJ] - (2.0 * c) + prv[idJ];
+	prv[idJ] = c;
+      }
+    }
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Filters a volume of values along one of it's directions.
+*		Lines are filtered in parallel, with lines through the
+*		columns or planes of the volume filtered in blocks of
+*		adjacent lines.
+* \param	coef			Filter coefficients.
+* \param	vol			Volume of values with column index
+*					varying fastest and then line index.
+* \param	vSz			Volume size.
+* \param	axis			Direction in which to filter: 0 for
+*					along lines, 1 through columns and 2
+*					through planes.
+* \param	nThr			Number of threads to use.
+*/
+static WlzErrorNum WlzGaussRsvPass(WlzGaussRsvCoef *coef, double *vol,
+				   WlzIVertex3 vSz, int axis, int nThr)
+{
+  int		idT,
+  		nB,
+  		nT;
+  size_t	pSz;
+  double	*tmp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const int	bW = WLZ_GAUSSRSV_BLOCK_WIDTH;
+
+  pSz = (size_t )(vSz.vtX) * vSz.vtY;
+  nB = (vSz.vtX + bW - 1) / bW;
+  nT = (axis == 0)? vSz.vtY * vSz.vtZ:
+       (axis == 1)? vSz.vtZ * nB: vSz.vtY * nB;
+  if((tmp = (double *)AlcMalloc(sizeof(double) * nThr * 5 * bW)) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(dynamic)
+#endif
+    for(idT = 0; idT < nT; ++idT)
+    {
+      int	idB,
+      		thrId = 0;
+      double	*tP;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      tP = tmp + ((size_t )thrId * 5 * bW);
+      switch(axis)
+      {
+        case 0:
+	  WlzGaussRsvLines(coef, vol + ((size_t )idT * vSz.vtX), 1,
+	  		   vSz.vtX, 1, tP);
+	  break;
+	case 1:
+	  idB = idT % nB;
+	  WlzGaussRsvLines(coef,
+	  		   vol + ((idT / nB) * pSz) + (idB * bW), vSz.vtX,
+			   vSz.vtY, WLZ_MIN(bW, vSz.vtX - (idB * bW)), tP);
+	  break;
+	default:
+	  idB = idT % nB;
+	  WlzGaussRsvLines(coef,
+	  		   vol + ((size_t )(idT / nB) * vSz.vtX) + (idB * bW),
+			   pSz, vSz.vtZ, WLZ_MIN(bW, vSz.vtX - (idB * bW)), tP);
+	  break;
+      }
+    }
+    AlcFree(tmp);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	New 2D object or NULL if the plane is empty or on error.
+* \ingroup	WlzValuesFilters
+* \brief	Makes a 2D object for the given plane of a 2D or 3D
+*		domain object, sharing it's domain and values. The plane
+*		coordinate is ignored for 2D objects.
+* \param	obj			Given 2D or 3D domain object.
+* \param	pln			Plane coordinate.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzGaussObjPlane(WlzObject *obj, int pln,
+				   WlzErrorNum *dstErr)
+{
+  int		idP;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzObject	*pObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  if(obj->type == WLZ_2D_DOMAINOBJ)
+  {
+    dom = obj->domain;
+    val = obj->values;
+  }
+  else
+  {
+    idP = pln - obj->domain.p->plane1;
+    if((idP >= 0) && (pln <= obj->domain.p->lastpl))
+    {
+      dom = obj->domain.p->domains[idP];
+      val = obj->values.vox->values[idP];
+    }
+  }
+  if((dom.core != NULL) && (dom.core->type != WLZ_EMPTY_DOMAIN) &&
+     (val.core != NULL))
+  {
+    pObj = WlzAssignObject(
+	   WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL,
+		       &errNum), NULL);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(pObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Reads the values of the given object less the background
+*		value into a volume covering it's bounding box, with
+*		zero values outside of the object's domain.
+* \param	obj			Given 2D or 3D domain object.
+* \param	bBox			Bounding box of the object.
+* \param	bkg			Background value.
+* \param	vol			Volume for the values.
+*/
+static WlzErrorNum WlzGaussObjRead(WlzObject *obj, WlzIBox3 bBox,
+				   double bkg, double *vol)
+{
+  int		idI,
+  		pln;
+  size_t	idx,
+  		nV,
+		pSz,
+		off;
+  WlzGreyP	dP;
+  WlzObject	*pObj;
+  WlzIntervalWSpace iWSp;
+  WlzGreyWSpace	gWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  pSz = (size_t )(bBox.xMax - bBox.xMin + 1) * (bBox.yMax - bBox.yMin + 1);
+  nV = pSz * (bBox.zMax - bBox.zMin + 1);
+  for(idx = 0; idx < nV; ++idx)
+  {
+    vol[idx] = 0.0;
+  }
+  for(pln = bBox.zMin; (errNum == WLZ_ERR_NONE) && (pln <= bBox.zMax);
+      ++pln)
+  {
+    pObj = WlzGaussObjPlane(obj, pln, &errNum);
+    if((errNum == WLZ_ERR_NONE) && (pObj != NULL))
+    {
+      errNum = WlzInitGreyScan(pObj, &iWSp, &gWSp);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+	{
+	  off = ((pln - bBox.zMin) * pSz) +
+	        ((size_t )(iWSp.linpos - bBox.yMin) *
+		 (bBox.xMax - bBox.xMin + 1)) +
+		iWSp.lftpos - bBox.xMin;
+	  dP.dbp = vol + off;
+	  WlzValueCopyGreyToGrey(dP, 0, WLZ_GREY_DOUBLE,
+				 gWSp.u_grintptr, 0, gWSp.pixeltype,
+				 iWSp.colrmn);
+	  for(idI = 0; idI < iWSp.colrmn; ++idI)
+	  {
+	    dP.dbp[idI] -= bkg;
+	  }
+	}
+	if(errNum == WLZ_ERR_EOO)
+	{
+	  errNum = WLZ_ERR_NONE;
+	}
+	(void )WlzEndGreyScan(&iWSp, &gWSp);
+      }
+    }
+    (void )WlzFreeObj(pObj);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesFilters
+* \brief	Writes values from a volume covering the given object's
+*		bounding box into the object, clamping them to the
+*		object's grey type.
+* \param	obj			Given 2D or 3D domain object.
+* \param	bBox			Bounding box of the object.
+* \param	vol			Volume of values.
+*/
+static WlzErrorNum WlzGaussObjWrite(WlzObject *obj, WlzIBox3 bBox,
+				    double *vol)
+{
+  int		pln;
+  size_t	pSz,
+		off;
+  WlzGreyP	sP;
+  WlzObject	*pObj;
+  WlzIntervalWSpace iWSp;
+  WlzGreyWSpace	gWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  pSz = (size_t )(bBox.xMax - bBox.xMin + 1) * (bBox.yMax - bBox.yMin + 1);
+  for(pln = bBox.zMin; (errNum == WLZ_ERR_NONE) && (pln <= bBox.zMax);
+      ++pln)
+  {
+    pObj = WlzGaussObjPlane(obj, pln, &errNum);
+    if((errNum == WLZ_ERR_NONE) && (pObj != NULL))
+    {
+      errNum = WlzInitGreyScan(pObj, &iWSp, &gWSp);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+	{
+	  off = ((pln - bBox.zMin) * pSz) +
+	        ((size_t )(iWSp.linpos - bBox.yMin) *
+		 (bBox.xMax - bBox.xMin + 1)) +
+		iWSp.lftpos - bBox.xMin;
+	  sP.dbp = vol + off;
+	  WlzValueClampGreyIntoGrey(gWSp.u_grintptr, 0, gWSp.pixeltype,
+	  			    sP, 0, WLZ_GREY_DOUBLE, iWSp.colrmn);
+	}
+	if(errNum == WLZ_ERR_EOO)
+	{
+	  errNum = WLZ_ERR_NONE;
+	}
+	(void )WlzEndGreyScan(&iWSp, &gWSp);
+      }
+    }
+    (void )WlzFreeObj(pObj);
+  }
+  return(errNum);
+}
@@ -111,6 +111,16 @@ static void			WlzGreyValueGet3DConTiled(
 				  int plane,
 				  int line,
 				  int kol);
+static void			WlzGreyValueGet3DConFull(
+				  WlzGreyValueWSpace *gVWSp,
+				  int plane,
+				  int line,
+				  int kol);
+static void			WlzGreyValueGet3DConTiledFull(
+				  WlzGreyValueWSpace *gVWSp,
+				  int plane,
+				  int line,
+				  int kol);
 static void			WlzGreyValueGetTransCon(
 				  WlzGreyValueWSpace *gVWSp,
 				  int plane,
@@ -577,6 +587,56 @@ void		WlzGreyValueGetCon(WlzGreyValueWSpace *gVWSp,
   }
 }
 
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Gets the four/eight connected grey values/pointers for
+*               the given point in the same order as
+*               WlzGreyValueGetCon(). For 3D objects the values
+*               found depend only on the given point and not on the
+*               previous use of the work space, so this function
+*               should be used where the same results are needed
+*               regardless of the order in which points are visited,
+*               eg when each thread of a parallel loop has it's own
+*               work space.
+* \param	gVWSp			Grey value work space.
+* \param	plane			Plane (z) coordinate of point.
+* \param	line			Line (y) coordinate of point.
+* \param	kol			Column (x) coordinate of point.
+*/
+void		WlzGreyValueGetConFull(WlzGreyValueWSpace *gVWSp,
+			               double plane, double line, double kol)
+{
+  if(gVWSp)
+  {
+    if(gVWSp->invTrans)
+    {
+      WlzGreyValueGetTransCon(gVWSp, (int )plane, (int )line, (int )kol);
+    }
+    else
+    {
+      switch(gVWSp->objType)
+      {
+	case WLZ_2D_DOMAINOBJ:
+	  WlzGreyValueGet2DCon(gVWSp, line, kol);
+	  break;
+	case WLZ_3D_DOMAINOBJ:
+	  if(gVWSp->gTabType == WLZ_GREY_TAB_TILED)
+	  {
+	    WlzGreyValueGet3DConTiledFull(gVWSp, plane, line, kol);
+	  }
+	  else
+	  {
+	    WlzGreyValueGet3DConFull(gVWSp, plane, line, kol);
+	  }
+	  break;
+	default:
+	  break;
+      }
+    }
+  }
+}
+
 /*!
 * \return	The workspace's object's grey type.
 * \ingroup	WlzAccess
@@ -1757,6 +1817,249 @@ static void	WlzGreyValueGet3DConTiled(WlzGreyValueWSpace *gVWSp,
   gVWSp->bkdFlag = 0xff & (~valMsk);
 }
 
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Gets eight grey value/pointers for the given point
+*               from the 3D values and domain in the work space.
+*               Unlike WlzGreyValueGet3DCon() the four connected
+*               values of both planes are always found using
+*               WlzGreyValueGet2DCon(), so the values found do not
+*               depend on the previous use of the work space, and
+*               the first and last planes are used.
+* \param	gVWSp			Grey value work space.
+* \param	plane			Plane coordinate of point.
+* \param	line			Line coordinate of point.
+* \param	kol			Column coordinate of point.
+*/
+static void	WlzGreyValueGet3DConFull(WlzGreyValueWSpace *gVWSp,
+				   int plane, int line, int kol)
+{
+  int		tI0,
+		planeOff,
+		planeRel,
+		planeSet;
+  unsigned	bkdFlag = 0;
+  WlzDomain	*domP;
+  WlzValues	*valP;
+  WlzGreyP	saveGPtr[4];
+  WlzGreyV	saveGVal[4];
+
+  planeOff = 0;
+  while(planeOff < 2)
+  {
+    planeSet = 0;
+    planeRel = plane - gVWSp->domain.p->plane1;
+    if((planeRel >= 0) && (plane <= gVWSp->domain.p->lastpl))
+    {
+      domP = gVWSp->domain.p->domains + planeRel;
+      valP = gVWSp->values.vox->values + planeRel;
+      planeSet = ((*domP).core != NULL) && ((*valP).core != NULL);
+    }
+    if(planeSet)
+    {
+      if(plane != gVWSp->plane)
+      {
+	gVWSp->plane = plane;
+	gVWSp->iDom2D = (*domP).i;
+	gVWSp->values2D = (*valP);
+	gVWSp->gTabType2D = gVWSp->gTabTypes3D[planeRel];
+      }
+      WlzGreyValueGet2DCon(gVWSp, line, kol);
+      bkdFlag |= gVWSp->bkdFlag << (planeOff * 4);
+    }
+    else
+    {
+      WlzGreyValueSetBkdPN(gVWSp->gVal, gVWSp->gPtr,
+			   gVWSp->gType, gVWSp->gBkd, 4);
+      bkdFlag |= 0xf << (planeOff * 4);
+    }
+    if(planeOff == 0)
+    {
+      tI0 = 4;
+      while(--tI0 >= 0)
+      {
+	saveGPtr[tI0] = gVWSp->gPtr[tI0];
+	saveGVal[tI0] = gVWSp->gVal[tI0];
+      }
+    }
+    ++plane;
+    ++planeOff;
+  }
+  tI0 = 4;
+  while(--tI0 >= 0)
+  {
+    gVWSp->gPtr[tI0 + 4] = gVWSp->gPtr[tI0];
+    gVWSp->gPtr[tI0] = saveGPtr[tI0];
+    gVWSp->gVal[tI0 + 4] = gVWSp->gVal[tI0];
+    gVWSp->gVal[tI0] = saveGVal[tI0];
+  }
+  /* Background pointers must point to the moved background values. */
+  tI0 = 8;
+  while(--tI0 >= 0)
+  {
+    if(bkdFlag & (1 << tI0))
+    {
+      gVWSp->gPtr[tI0].v = gVWSp->gVal + tI0;
+    }
+  }
+  gVWSp->bkdFlag = bkdFlag;
+}
+
+/*!
+* \return	void
+* \ingroup	WlzAccess
+* \brief	Gets eight grey value/pointers for the given point
+*               from the 3D tiled values and domain in the work space.
+*               Unlike WlzGreyValueGet3DConTiled() the range tests
+*               are those of the non-fast code and every interval of
+*               a line is examined.
+* \param	gVWSp			Grey value work space.
+* \param	plane			Plane coordinate of point.
+* \param	line			Line coordinate of point.
+* \param	kol			Column coordinate of point.
+*/
+static void	WlzGreyValueGet3DConTiledFull(WlzGreyValueWSpace *gVWSp,
+				   int plane, int line, int kol)
+{
+  int		idK,
+  		idL,
+		idP;
+  unsigned	valMsk = 0;
+
+  /* First set bit mask for which voxels are inside the domain. */
+  for(idP = 0; idP < 2; ++idP)
+  {
+    int		idV,
+    		pl,
+    		plRel;
+
+    pl = plane + idP;
+    plRel = pl - gVWSp->domain.p->plane1;
+#ifdef WLZ_FAST_CODE
+    if((unsigned int )plRel <=
+       (unsigned int )(gVWSp->domain.p->lastpl - gVWSp->domain.p->plane1))
+#else
+    if((plRel >= 0) && (pl <= gVWSp->domain.p->lastpl))
+#endif
+    {
+      WlzDomain *dom;
+
+      dom = gVWSp->domain.p->domains + plRel;
+      if((dom != NULL) && ((*dom).i != NULL))
+      {
+        WlzIntervalDomain *iDom;
+
+        iDom = (*dom).i;
+	for(idL = 0; idL < 2; ++idL)
+	{
+	  int	ln,
+	  	lnRel;
+
+	  ln = line + idL;
+	  lnRel = ln - iDom->line1;
+#ifdef WLZ_FAST_CODE
+	  if((unsigned int )lnRel <=
+	     (unsigned int )(iDom->lastln - iDom->line1))
+#else
+	  if((ln >= iDom->line1) && (ln <= iDom->lastln))
+#endif
+	  {
+#ifdef WLZ_FAST_CODE
+	    if((unsigned int )(kol - iDom->kol1 + 1) <=
+	       (unsigned int )(iDom->lastkl - iDom->kol1 + 1))
+#else
+	    if((kol + 1 >= iDom->kol1) && (kol <= iDom->lastkl))
+#endif
+	    {
+	      idV = ((idP << 1) + idL) << 1;
+	      if(iDom->type == WLZ_INTERVALDOMAIN_RECT)
+	      {
+	        valMsk |= ((kol >= iDom->kol1) |
+		          ((kol < iDom->lastkl) << 1)) << idV;
+
+	      }
+	      else /* iDom->type == WLZ_INTERVALDOMAIN_INTVL */
+	      {
+		int	idI,
+			klRel;
+		WlzIntervalLine *itvLn;
+		WlzInterval *itv;
+
+		itvLn = iDom->intvlines + lnRel;
+		itv = itvLn->intvs;
+		klRel = kol - iDom->kol1;
+		for(idI = 0; idI < itvLn->nintvs; ++idI)
+		{
+		  if(klRel + 1 < itv->ileft)
+		  {
+		    break;
+		  }
+		  else if(klRel <= itv->iright)
+		  {
+		    valMsk |= ((klRel >= itv->ileft) |
+		               ((klRel < itv->iright) << 1)) << idV;
+		  }
+		  ++itv;
+		}
+	      }
+	    }
+	  }
+	}
+      }
+    }
+  }
+  /* Now set grey values and pointers knowing which are within the domain. */
+  if(valMsk == 0)
+  {
+    WlzGreyValueSetBkdPN(gVWSp->gVal, gVWSp->gPtr,
+                         gVWSp->gType, gVWSp->gBkd, 8);
+  }
+  else
+  {
+    int		idV;
+    WlzIVertex3	rPos,
+    		tIdx,
+		tOff;
+    size_t 	offset;
+    WlzTiledValues *tVal;
+
+    idV = 0;
+    tVal = gVWSp->values.t;
+    for(idP = 0; idP < 2; ++idP)
+    {
+      rPos.vtZ = plane - tVal->plane1 + idP;
+      tIdx.vtZ = (rPos.vtZ / tVal->tileWidth) * tVal->nIdx[1];
+      tOff.vtZ = (rPos.vtZ % tVal->tileWidth) * tVal->tileWidth;
+      for(idL = 0; idL < 2; ++idL)
+      {
+        rPos.vtY = line - tVal->line1 + idL;
+	tIdx.vtY = (tIdx.vtZ + (rPos.vtY / tVal->tileWidth)) * tVal->nIdx[0];
+	tOff.vtY = (tOff.vtZ + (rPos.vtY % tVal->tileWidth)) * tVal->tileWidth;
+	for(idK = 0; idK < 2; ++idK)
+	{
+	  if((valMsk & (1 << idV)) == 0)
+	  {
+	    WlzGreyValueSetBkdPN(gVWSp->gVal + idV, gVWSp->gPtr + idV,
+	                         gVWSp->gType, gVWSp->gBkd, 1);
+	  }
+	  else
+	  {
+            rPos.vtX = kol - tVal->kol1 + idK;
+	    tIdx.vtX = tIdx.vtY + (rPos.vtX / tVal->tileWidth);
+            tOff.vtX = tOff.vtY + (rPos.vtX % tVal->tileWidth);
+            offset = *(tVal->indices + tIdx.vtX) * tVal->tileSz + tOff.vtX;
+	    WlzGreyValueSetGreyP(gVWSp->gVal + idV, gVWSp->gPtr + idV,
+	                         gVWSp->gType, tVal->tiles, offset);
+	  }
+	  ++idV;
+	}
+      }
+    }
+  }
+  gVWSp->bkdFlag = 0xff & (~valMsk);
+}
+
 /*!
 * \return	void
 * \ingroup	WlzAccess
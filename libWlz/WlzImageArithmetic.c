@@ -41,10 +41,13 @@ static char _WlzImageArithmetic_c[] = "University of Edinburgh $Id$";
 */
 
 #include <stdarg.h>
+#include <limits.h>
 #include <float.h>
 #include <Wlz.h>
 
 typedef	void (*WlzBinaryOperatorFn)(WlzGreyP, WlzGreyP, int);
+typedef void (*WlzImageArithmeticKerFn)(WlzGreyP, WlzGreyP, WlzGreyP, int,
+					WlzBinaryOperatorType, int);
 
 static WlzErrorNum		WlzImageArithmeticPromoteGTypes(
 				  WlzBinaryOperatorType op,
@@ -520,6 +523,328 @@ static void	WlzBufMagD(WlzGreyP gP1, WlzGreyP gP0, int count)
   }
 }
 
+/*
+* Typed kernels which fuse the load, operator and store for intervals
+* in which both operands have the same grey type. Each kernel loops
+* directly over the interval's grey values with a fixed operator,
+* operand, working and result type so that the loops may be
+* vectorised by the compiler. The operators give exactly the same
+* values as the buffer functions above, the result is either cast
+* (as when copying from the buffers) or clamped into the range of
+* the result type.
+*/
+#define WLZ_IMGARITH_ADD(A,B)	((A)+(B))
+#define WLZ_IMGARITH_SUB(A,B)	((A)-(B))
+#define WLZ_IMGARITH_MUL(A,B)	((A)*(B))
+#define WLZ_IMGARITH_MAX(A,B)	(((A)>(B))?(A):(B))
+#define WLZ_IMGARITH_MIN(A,B)	(((A)<(B))?(A):(B))
+#define WLZ_IMGARITH_DIV_I(A,B)	((B)?((A)/(B)):(A))
+#define WLZ_IMGARITH_MOD_I(A,B)	((B)?((A)%(B)):0)
+#define WLZ_IMGARITH_EQ_I(A,B)	((A)==(B))
+#define WLZ_IMGARITH_NE_I(A,B)	((A)!=(B))
+#define WLZ_IMGARITH_GT_I(A,B)	((A)>(B))
+#define WLZ_IMGARITH_GE_I(A,B)	((A)>=(B))
+#define WLZ_IMGARITH_LT_I(A,B)	((A)<(B))
+#define WLZ_IMGARITH_LE_I(A,B)	((A)<=(B))
+#define WLZ_IMGARITH_AND_I(A,B)	((A)&(B))
+#define WLZ_IMGARITH_OR_I(A,B)	((A)|(B))
+#define WLZ_IMGARITH_XOR_I(A,B)	((A)^(B))
+#define WLZ_IMGARITH_MAG_I(A,B) \
+	(((A)||(B))?WLZ_NINT(sqrt((double )((A)*(A)+(B)*(B)))):0)
+/* The floating point EQ, NE, GT and LT operators below do not give the
+ * obvious comparisons (eg EQ is 1.0 when the values differ) and MOD
+ * divides. This is intentional, they reproduce the values of
+ * WlzBufEQD(), WlzBufModD() etc so that the kernels give exactly the
+ * same results as the buffer functions. */
+#define WLZ_IMGARITH_DIV_D(A,B) \
+	((fabs(B)>DBL_EPSILON)?((A)/(B)):(A))
+#define WLZ_IMGARITH_MOD_D(A,B) \
+	((fabs(B)>DBL_EPSILON)?((A)/(B)):(0.0))
+#define WLZ_IMGARITH_EQ_D(A,B) \
+	((fabs((A)-(B))>DBL_EPSILON)?(1.0):(0.0))
+#define WLZ_IMGARITH_NE_D(A,B) \
+	((fabs((A)-(B))<DBL_EPSILON)?(1.0):(0.0))
+#define WLZ_IMGARITH_GT_D(A,B) \
+	((fabs((A)-(B))>0.0)?(1.0):(0.0))
+#define WLZ_IMGARITH_LT_D(A,B) \
+	((fabs((A)-(B))<0.0)?(1.0):(0.0))
+#define WLZ_IMGARITH_AND_D(A,B) \
+	((double )((unsigned int )(A)&(unsigned int )(B)))
+#define WLZ_IMGARITH_OR_D(A,B) \
+	((double )((unsigned int )(A)|(unsigned int )(B)))
+#define WLZ_IMGARITH_XOR_D(A,B) \
+	((double )((unsigned int )(A)^(unsigned int )(B)))
+#define WLZ_IMGARITH_MAG_D(A,B) \
+	((((A)*(A)+(B)*(B))>DBL_EPSILON)?sqrt((A)*(A)+(B)*(B)):(0.0))
+
+#define WLZ_IMGARITH_CAST_UB(V)	((WlzUByte )(V))
+#define WLZ_IMGARITH_CAST_S(V)	((short )(V))
+#define WLZ_IMGARITH_CAST_I(V)	((int )(V))
+#define WLZ_IMGARITH_CAST_F(V)	((float )(V))
+#define WLZ_IMGARITH_CAST_D(V)	(V)
+#define WLZ_IMGARITH_CLAMP_UB(V) ((WlzUByte )WLZ_CLAMP((V),0,255))
+#define WLZ_IMGARITH_CLAMP_S(V) ((short )WLZ_CLAMP((V),SHRT_MIN,SHRT_MAX))
+#define WLZ_IMGARITH_CLAMP_F(V) ((float )WLZ_CLAMP((V),-FLT_MAX,FLT_MAX))
+
+/*!
+* \def		WLZ_IMGARITH_LOOP(D,S0,S1,N,W,X,C)
+* \brief	Applies operator X, working in type W, to the N values
+*		of S0 and S1 with the results stored in D using the
+*		cast or clamp C.
+*/
+#define WLZ_IMGARITH_LOOP(D,S0,S1,N,W,X,C) \
+{ \
+  int	i_; \
+  W	r_; \
+ \
+  for(i_ = 0; i_ < (N); ++i_) \
+  { \
+    r_ = X((W )((S0)[i_]),(W )((S1)[i_])); \
+    (D)[i_] = C(r_); \
+  } \
+}
+
+/*!
+* \def		WLZ_IMGARITH_SWITCH_I(OP,DA,DL,S0,S1,N,CA,CL)
+* \brief	Applies operator OP working in int. Arithmetic results
+*		(add, subtract, multiply, divide and magnitude) are stored
+*		in DA using CA and all others in DL using CL.
+*/
+#define WLZ_IMGARITH_SWITCH_I(OP,DA,DL,S0,S1,N,CA,CL) \
+switch(OP) \
+{ \
+  case WLZ_BO_ADD: \
+    WLZ_IMGARITH_LOOP(DA,S0,S1,N,int,WLZ_IMGARITH_ADD,CA) break; \
+  case WLZ_BO_SUBTRACT: \
+    WLZ_IMGARITH_LOOP(DA,S0,S1,N,int,WLZ_IMGARITH_SUB,CA) break; \
+  case WLZ_BO_MULTIPLY: \
+    WLZ_IMGARITH_LOOP(DA,S0,S1,N,int,WLZ_IMGARITH_MUL,CA) break; \
+  case WLZ_BO_DIVIDE: \
+    WLZ_IMGARITH_LOOP(DA,S0,S1,N,int,WLZ_IMGARITH_DIV_I,CA) break; \
+  case WLZ_BO_MODULUS: \
+    WLZ_IMGARITH_LOOP(DL,S0,S1,N,int,WLZ_IMGARITH_MOD_I,CL) break; \
+  case WLZ_BO_EQ: \
+    WLZ_IMGARITH_LOOP(DL,S0,S1,N,int,WLZ_IMGARITH_EQ_I,CL) break; \
+  case WLZ_BO_NE: \
+    WLZ_IMGARITH_LOOP(DL,S0,S1,N,int,WLZ_IMGARITH_NE_I,CL) break; \
+  case WLZ_BO_GT: \
+    WLZ_IMGARITH_LOOP(DL,S0,S1,N,int,WLZ_IMGARITH_GT_I,CL) break; \
+  case WLZ_BO_GE: \
+    WLZ_IMGARITH_LOOP(DL,S0,S1,N,int,WLZ_IMGARITH_GE_I,CL) break; \
+  case WLZ_BO_LT: \
+    WLZ_IMGARITH_LOOP(DL,S0,S1,N,int,WLZ_IMGARITH_LT_I,CL) break; \
+  case WLZ_BO_LE: \
+    WLZ_IMGARITH_LOOP(DL,S0,S1,N,int,WLZ_IMGARITH_LE_I,CL) break; \
+  case WLZ_BO_AND: \
+    WLZ_IMGARITH_LOOP(DL,S0,S1,N,int,WLZ_IMGARITH_AND_I,CL) break; \
+  case WLZ_BO_OR: \
+    WLZ_IMGARITH_LOOP(DL,S0,S1,N,int,WLZ_IMGARITH_OR_I,CL) break; \
+  case WLZ_BO_XOR: \
+    WLZ_IMGARITH_LOOP(DL,S0,S1,N,int,WLZ_IMGARITH_XOR_I,CL) break; \
+  case WLZ_BO_MAX: \
+    WLZ_IMGARITH_LOOP(DL,S0,S1,N,int,WLZ_IMGARITH_MAX,CL) break; \
+  case WLZ_BO_MIN: \
+    WLZ_IMGARITH_LOOP(DL,S0,S1,N,int,WLZ_IMGARITH_MIN,CL) break; \
+  case WLZ_BO_MAGNITUDE: \
+    WLZ_IMGARITH_LOOP(DA,S0,S1,N,int,WLZ_IMGARITH_MAG_I,CA) break; \
+  default: \
+    break; \
+}
+
+/*!
+* \def		WLZ_IMGARITH_SWITCH_D(OP,D,S0,S1,N,C)
+* \brief	Applies operator OP working in double with all results
+*		stored in D using C. As for the buffer functions the
+*		greater than or equal and less than or equal operators
+*		share the greater than and less than loops.
+*/
+#define WLZ_IMGARITH_SWITCH_D(OP,D,S0,S1,N,C) \
+switch(OP) \
+{ \
+  case WLZ_BO_ADD: \
+    WLZ_IMGARITH_LOOP(D,S0,S1,N,double,WLZ_IMGARITH_ADD,C) break; \
+  case WLZ_BO_SUBTRACT: \
+    WLZ_IMGARITH_LOOP(D,S0,S1,N,double,WLZ_IMGARITH_SUB,C) break; \
+  case WLZ_BO_MULTIPLY: \
+    WLZ_IMGARITH_LOOP(D,S0,S1,N,double,WLZ_IMGARITH_MUL,C) break; \
+  case WLZ_BO_DIVIDE: \
+    WLZ_IMGARITH_LOOP(D,S0,S1,N,double,WLZ_IMGARITH_DIV_D,C) break; \
+  case WLZ_BO_MODULUS: \
+    WLZ_IMGARITH_LOOP(D,S0,S1,N,double,WLZ_IMGARITH_MOD_D,C) break; \
+  case WLZ_BO_EQ: \
+    WLZ_IMGARITH_LOOP(D,S0,S1,N,double,WLZ_IMGARITH_EQ_D,C) break; \
+  case WLZ_BO_NE: \
+    WLZ_IMGARITH_LOOP(D,S0,S1,N,double,WLZ_IMGARITH_NE_D,C) break; \
+  case WLZ_BO_GT: /* FALLTHROUGH */ \
+  case WLZ_BO_GE: \
+    WLZ_IMGARITH_LOOP(D,S0,S1,N,double,WLZ_IMGARITH_GT_D,C) break; \
+  case WLZ_BO_LT: /* FALLTHROUGH */ \
+  case WLZ_BO_LE: \
+    WLZ_IMGARITH_LOOP(D,S0,S1,N,double,WLZ_IMGARITH_LT_D,C) break; \
+  case WLZ_BO_AND: \
+    WLZ_IMGARITH_LOOP(D,S0,S1,N,double,WLZ_IMGARITH_AND_D,C) break; \
+  case WLZ_BO_OR: \
+    WLZ_IMGARITH_LOOP(D,S0,S1,N,double,WLZ_IMGARITH_OR_D,C) break; \
+  case WLZ_BO_XOR: \
+    WLZ_IMGARITH_LOOP(D,S0,S1,N,double,WLZ_IMGARITH_XOR_D,C) break; \
+  case WLZ_BO_MAX: \
+    WLZ_IMGARITH_LOOP(D,S0,S1,N,double,WLZ_IMGARITH_MAX,C) break; \
+  case WLZ_BO_MIN: \
+    WLZ_IMGARITH_LOOP(D,S0,S1,N,double,WLZ_IMGARITH_MIN,C) break; \
+  case WLZ_BO_MAGNITUDE: \
+    WLZ_IMGARITH_LOOP(D,S0,S1,N,double,WLZ_IMGARITH_MAG_D,C) break; \
+  default: \
+    break; \
+}
+
+/*
+* \return	<void>
+* \brief	Typed kernels, one for each operand grey type, which
+*		apply the given operator to an interval of values.
+*		The result type is that given by
+*		WlzImageArithmeticPromoteGTypes() for operands of
+*		the kernel's type.
+* \param	gD			Result values.
+* \param	gP0			First operand values.
+* \param	gP1			Second operand values.
+* \param	n			Number of values.
+* \param	op			Binary operator.
+* \param	clampFlg		Clamp results into the range of
+*					the result type if non-zero,
+*					otherwise cast.
+*/
+static void	WlzImageArithmeticKerUByte(WlzGreyP gD, WlzGreyP gP0,
+					   WlzGreyP gP1, int n,
+					   WlzBinaryOperatorType op,
+					   int clampFlg)
+{
+  WlzUByte	*s0,
+  		*s1;
+
+  s0 = gP0.ubp;
+  s1 = gP1.ubp;
+  if(clampFlg)
+  {
+    WLZ_IMGARITH_SWITCH_I(op, gD.shp, gD.ubp, s0, s1, n,
+			  WLZ_IMGARITH_CLAMP_S, WLZ_IMGARITH_CLAMP_UB)
+  }
+  else
+  {
+    WLZ_IMGARITH_SWITCH_I(op, gD.shp, gD.ubp, s0, s1, n,
+			  WLZ_IMGARITH_CAST_S, WLZ_IMGARITH_CAST_UB)
+  }
+}
+
+static void	WlzImageArithmeticKerShort(WlzGreyP gD, WlzGreyP gP0,
+					   WlzGreyP gP1, int n,
+					   WlzBinaryOperatorType op,
+					   int clampFlg)
+{
+  short		*s0,
+  		*s1;
+
+  s0 = gP0.shp;
+  s1 = gP1.shp;
+  if(clampFlg)
+  {
+    WLZ_IMGARITH_SWITCH_I(op, gD.shp, gD.shp, s0, s1, n,
+			  WLZ_IMGARITH_CLAMP_S, WLZ_IMGARITH_CLAMP_S)
+  }
+  else
+  {
+    WLZ_IMGARITH_SWITCH_I(op, gD.shp, gD.shp, s0, s1, n,
+			  WLZ_IMGARITH_CAST_S, WLZ_IMGARITH_CAST_S)
+  }
+}
+
+static void	WlzImageArithmeticKerInt(WlzGreyP gD, WlzGreyP gP0,
+					 WlzGreyP gP1, int n,
+					 WlzBinaryOperatorType op,
+					 int clampFlg)
+{
+  int		*s0,
+  		*s1;
+
+  s0 = gP0.inp;
+  s1 = gP1.inp;
+  WLZ_IMGARITH_SWITCH_I(op, gD.inp, gD.inp, s0, s1, n,
+			WLZ_IMGARITH_CAST_I, WLZ_IMGARITH_CAST_I)
+}
+
+static void	WlzImageArithmeticKerFloat(WlzGreyP gD, WlzGreyP gP0,
+					   WlzGreyP gP1, int n,
+					   WlzBinaryOperatorType op,
+					   int clampFlg)
+{
+  float		*s0,
+  		*s1;
+
+  s0 = gP0.flp;
+  s1 = gP1.flp;
+  if(clampFlg)
+  {
+    WLZ_IMGARITH_SWITCH_D(op, gD.flp, s0, s1, n, WLZ_IMGARITH_CLAMP_F)
+  }
+  else
+  {
+    WLZ_IMGARITH_SWITCH_D(op, gD.flp, s0, s1, n, WLZ_IMGARITH_CAST_F)
+  }
+}
+
+static void	WlzImageArithmeticKerDouble(WlzGreyP gD, WlzGreyP gP0,
+					    WlzGreyP gP1, int n,
+					    WlzBinaryOperatorType op,
+					    int clampFlg)
+{
+  double	*s0,
+  		*s1;
+
+  s0 = gP0.dbp;
+  s1 = gP1.dbp;
+  WLZ_IMGARITH_SWITCH_D(op, gD.dbp, s0, s1, n, WLZ_IMGARITH_CAST_D)
+}
+
+/*!
+* \return	Typed kernel or NULL if there is no kernel for the
+*		grey types.
+* \ingroup	WlzArithmetic
+* \brief	Selects the typed kernel for the given promoted grey
+*		types. A kernel is only available when both operands
+*		have the same grey type, otherwise the buffered
+*		functions must be used.
+* \param	gType			Grey types as set by
+*					WlzImageArithmeticPromoteGTypes().
+*/
+static WlzImageArithmeticKerFn WlzImageArithmeticKerSet(WlzGreyType gType[])
+{
+  WlzImageArithmeticKerFn kerFn = NULL;
+
+  if(gType[0] == gType[1])
+  {
+    switch(gType[0])
+    {
+      case WLZ_GREY_UBYTE:
+	kerFn = WlzImageArithmeticKerUByte;
+	break;
+      case WLZ_GREY_SHORT:
+	kerFn = WlzImageArithmeticKerShort;
+	break;
+      case WLZ_GREY_INT:
+	kerFn = WlzImageArithmeticKerInt;
+	break;
+      case WLZ_GREY_FLOAT:
+	kerFn = WlzImageArithmeticKerFloat;
+	break;
+      case WLZ_GREY_DOUBLE:
+	kerFn = WlzImageArithmeticKerDouble;
+	break;
+      default:
+	break;
+    }
+  }
+  return(kerFn);
+}
+
 /*!
 * \return	Pointer to appropriate function or NULL on error.
 * \ingroup	WlzArithmetic
@@ -724,11 +1049,15 @@ static WlzErrorNum	WlzImageArithmeticPromoteGTypes(
 *					  <li>
 *                                         < 0 || > 2: Error condition.
 *					</ul>
+* \param	clampFlg		Clamp values into the range of the
+*					destination grey type if non-zero,
+*					otherwise values are cast.
 */
 static WlzErrorNum WlzImageArithmetic2D(WlzObject *obj0, WlzObject *obj1,
 				        WlzObject *obj2,
 				        WlzBinaryOperatorType op,
-				        int overwrite)
+				        int overwrite,
+					int clampFlg)
 {
   int		idx,
   		tI0;
@@ -740,6 +1069,7 @@ static WlzErrorNum WlzImageArithmetic2D(WlzObject *obj0, WlzObject *obj1,
   WlzIntervalWSpace iWsp[3];
   WlzGreyWSpace	gWsp[3];
   WlzBinaryOperatorFn binOpFn;
+  WlzImageArithmeticKerFn kerFn;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   obj[0] = obj[1] = NULL;
@@ -795,6 +1125,17 @@ static WlzErrorNum WlzImageArithmetic2D(WlzObject *obj0, WlzObject *obj1,
       buf[1].dbp = &(bgd[2].v.dbv);
     }
     binOpFn(buf[1], buf[0], 1);
+    if(clampFlg)
+    {
+      WlzPixelV	tBgd;
+      WlzGreyP	tGP;
+
+      tBgd.type = gType[2];
+      tGP.dbp = &(tBgd.v.dbv);
+      WlzValueClampGreyIntoGrey(tGP, 0, gType[2], buf[1], 0, gType[3], 1);
+      bgd[2] = tBgd;
+    }
+    buf[0].inp = buf[1].inp = NULL;
     switch(overwrite)
     {
       case 0:
@@ -817,6 +1158,10 @@ static WlzErrorNum WlzImageArithmetic2D(WlzObject *obj0, WlzObject *obj1,
     }
   }
   if(errNum == WLZ_ERR_NONE)
+  {
+    kerFn = WlzImageArithmeticKerSet(gType);
+  }
+  if((errNum == WLZ_ERR_NONE) && (kerFn == NULL))
   {
     /* Make buffers */
     tI0 = obj2->domain.i->lastkl - obj2->domain.i->kol1 + 1;
@@ -854,16 +1199,33 @@ static WlzErrorNum WlzImageArithmetic2D(WlzObject *obj0, WlzObject *obj1,
 	((errNum = WlzNextGreyInterval(iWsp + 2)) == WLZ_ERR_NONE))
   {
     tI0 = iWsp[0].rgtpos - iWsp[0].lftpos + 1;
-    WlzValueCopyGreyToGrey(buf[0], 0, gType[3],
-			   gWsp[0].u_grintptr, 0, gWsp[0].pixeltype,
-			   tI0);
-    WlzValueCopyGreyToGrey(buf[1], 0, gType[3],
-			   gWsp[1].u_grintptr, 0, gWsp[1].pixeltype,
-			   tI0);
-    binOpFn(buf[1], buf[0], tI0);
-    WlzValueCopyGreyToGrey(gWsp[2].u_grintptr, 0, gWsp[2].pixeltype,
-			   buf[1], 0, gType[3],
-			   tI0);
+    if(kerFn)
+    {
+      kerFn(gWsp[2].u_grintptr, gWsp[0].u_grintptr, gWsp[1].u_grintptr,
+            tI0, op, clampFlg);
+    }
+    else
+    {
+      WlzValueCopyGreyToGrey(buf[0], 0, gType[3],
+			     gWsp[0].u_grintptr, 0, gWsp[0].pixeltype,
+			     tI0);
+      WlzValueCopyGreyToGrey(buf[1], 0, gType[3],
+			     gWsp[1].u_grintptr, 0, gWsp[1].pixeltype,
+			     tI0);
+      binOpFn(buf[1], buf[0], tI0);
+      if(clampFlg)
+      {
+	WlzValueClampGreyIntoGrey(gWsp[2].u_grintptr, 0, gWsp[2].pixeltype,
+				  buf[1], 0, gType[3],
+				  tI0);
+      }
+      else
+      {
+	WlzValueCopyGreyToGrey(gWsp[2].u_grintptr, 0, gWsp[2].pixeltype,
+			       buf[1], 0, gType[3],
+			       tI0);
+      }
+    }
   }
   if(errNum == WLZ_ERR_EOO)
   {
@@ -917,30 +1279,30 @@ static WlzErrorNum WlzImageArithmetic2D(WlzObject *obj0, WlzObject *obj1,
 *                                         < 0 || > 2: Error condition.
 *					  </li>
 *					</ul>
+* \param	clampFlg		Clamp values into the range of the
+*					destination grey type if non-zero,
+*					otherwise values are cast.
 */
 static WlzErrorNum WlzImageArithmetic3D(WlzObject *obj0, WlzObject *obj1,
 				        WlzObject *obj2,
 				        WlzBinaryOperatorType op,
-				        int overwrite)
+				        int overwrite,
+					int clampFlg)
 {
   int		tI0,
 		oIdx,
-		nPlanes,
-		bgdFlag = 0;
+		pln,
+		nPlanes;
   int		pIdx[3],
   		vIdx[3];
   WlzGreyType	gType[4];
-  WlzObject	*tObj;
-  WlzObject	*obj[3],
-  		*obj2D[3];
+  WlzObject	*obj[3];
   WlzPixelV	bgd[3];
   WlzPlaneDomain *pDom[3];
   WlzVoxelValues *vVal[3];
-  WlzValues	tVal,
-		nullValues;
+  WlzValues	tVal;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  nullValues.core = NULL;
   obj[0] = obj[1] = obj[2] = NULL;
   if ((obj0->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN) ||
       (obj1->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN) ||
@@ -1000,76 +1362,99 @@ static WlzErrorNum WlzImageArithmetic3D(WlzObject *obj0, WlzObject *obj1,
       }
       if(errNum == WLZ_ERR_NONE)
       {
+	/* The planes are independent, each has it's own value table
+	 * in the new voxel value table. */
 	nPlanes = pDom[2]->lastpl - pDom[2]->plane1 + 1;
-	pIdx[2] = 0;
-	while((pIdx[2] < nPlanes) && (errNum == WLZ_ERR_NONE))
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+	for(pln = 0; pln < nPlanes; ++pln)
 	{
-	  switch(overwrite)
+	  if(errNum == WLZ_ERR_NONE)
 	  {
-	    case 0: 					/* No values shared. */
-	      (void )WlzFreeValues(*(vVal[2]->values + pIdx[2]));
-	      *(vVal[2]->values + pIdx[2]) = nullValues;
-	      tObj = WlzMakeMain(WLZ_2D_DOMAINOBJ,
-	      			 *(pDom[2]->domains + pIdx[2]),
-				 nullValues, NULL, NULL, &errNum);
-	      if(errNum == WLZ_ERR_NONE)
+	    int		idx;
+	    int		pIdx2D[3],
+	    		vIdx2D[3];
+	    WlzObject	*tObj;
+	    WlzObject	*obj2D[3];
+	    WlzValues	nullValues;
+	    WlzErrorNum	errNum2D = WLZ_ERR_NONE;
+
+	    nullValues.core = NULL;
+	    for(idx = 0; idx < 2; ++idx)
+	    {
+	      pIdx2D[idx] = pIdx[idx] + pln;
+	      vIdx2D[idx] = vIdx[idx] + pln;
+	    }
+	    pIdx2D[2] = vIdx2D[2] = pln;
+	    switch(overwrite)
+	    {
+	      case 0: 					/* No values shared. */
+		(void )WlzFreeValues(*(vVal[2]->values + pln));
+		*(vVal[2]->values + pln) = nullValues;
+		tObj = WlzMakeMain(WLZ_2D_DOMAINOBJ,
+				   *(pDom[2]->domains + pln),
+				   nullValues, NULL, NULL, &errNum2D);
+		if(errNum2D == WLZ_ERR_NONE)
+		{
+		  *(vVal[2]->values + pln) = WlzAssignValues(tObj->values,
+							     NULL);
+		}
+		WlzFreeObj(tObj);
+		break;
+	      case 1: 				 /* Values shared with obj0. */
+		(void )WlzFreeValues(*(vVal[2]->values + pln));
+		*(vVal[2]->values + pln) = WlzAssignValues(
+		  *(vVal[0]->values + vIdx2D[0]), NULL);
+		break;
+	      case 2: 				 /* Values shared with obj1. */
+		(void )WlzFreeValues(*(vVal[2]->values + pln));
+		*(vVal[2]->values + pln) = WlzAssignValues(
+		  *(vVal[1]->values + vIdx2D[1]), NULL);
+		break;
+	    }
+	    obj2D[2] = obj2D[1] = obj2D[0] = NULL;
+	    for(idx = 0; (idx < 3) && (errNum2D == WLZ_ERR_NONE); ++idx)
+	    {
+	      obj2D[idx] = WlzMakeMain(WLZ_2D_DOMAINOBJ,
+				       *(pDom[idx]->domains + pIdx2D[idx]),
+				       *(vVal[idx]->values + vIdx2D[idx]),
+				       NULL, NULL, &errNum2D);
+	    }
+	    if(errNum2D == WLZ_ERR_NONE)
+	    {
+	      if((obj2D[2] != NULL) &&
+		 (obj2D[2]->type == WLZ_2D_DOMAINOBJ) &&
+		 (obj2D[2]->domain.core != NULL))
 	      {
-	        *(vVal[2]->values + pIdx[2]) = WlzAssignValues(tObj->values,
-							       NULL);
+		errNum2D = WlzImageArithmetic2D(obj2D[0], obj2D[1], obj2D[2],
+						op, overwrite, clampFlg);
 	      }
-	      WlzFreeObj(tObj);
-	      break;
-	    case 1: 				 /* Values shared with obj0. */
-	      (void )WlzFreeValues(*(vVal[2]->values + pIdx[2]));
-	      *(vVal[2]->values + pIdx[2]) = WlzAssignValues(
-	        *(vVal[0]->values + vIdx[0]), NULL);
-	      break;
-	    case 2: 				 /* Values shared with obj1. */
-	      (void )WlzFreeValues(*(vVal[2]->values + pIdx[2]));
-	      *(vVal[2]->values + pIdx[2]) = WlzAssignValues(
-	        *(vVal[1]->values + vIdx[1]), NULL);
-	      break;
-	  }
-	  obj2D[2] = obj2D[1] = obj2D[0] = NULL;
-	  for(oIdx = 0; (oIdx < 3) && (errNum == WLZ_ERR_NONE); ++oIdx)
-	  {
-	    obj2D[oIdx] = WlzMakeMain(WLZ_2D_DOMAINOBJ,
-	    			      *(pDom[oIdx]->domains + pIdx[oIdx]),
-	    			      *(vVal[oIdx]->values + vIdx[oIdx]),
-				      NULL, NULL, &errNum);
-	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    if((obj2D[2] != NULL) &&
-	       (obj2D[2]->type == WLZ_2D_DOMAINOBJ) &&
-	       (obj2D[2]->domain.core != NULL))
+	    }
+	    if(errNum2D == WLZ_ERR_NONE)
 	    {
-	      errNum = WlzImageArithmetic2D(obj2D[0], obj2D[1], obj2D[2],
-					    op, overwrite);
-	      if(errNum == WLZ_ERR_NONE)
+	      (void )WlzFreeValues(*(vVal[2]->values + pln));
+	      *(vVal[2]->values + pln) = WlzAssignValues(obj2D[2]->values,
+							 NULL);
+	    }
+	    (void )WlzFreeObj(obj2D[0]);
+	    (void )WlzFreeObj(obj2D[1]);
+	    (void )WlzFreeObj(obj2D[2]);
+	    if(errNum2D != WLZ_ERR_NONE)
+	    {
+#ifdef _OPENMP
+#pragma omp critical (WlzImageArithmetic3D)
 	      {
-		if((bgdFlag == 0) && (obj2D[2]->type == WLZ_2D_DOMAINOBJ))
+#endif
+		if(errNum == WLZ_ERR_NONE)
 		{
-		  bgd[2] = WlzGetBackground(obj0, &errNum);
-		  bgdFlag = 1;
+		  errNum = errNum2D;
 		}
+#ifdef _OPENMP
 	      }
+#endif
 	    }
 	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    (void )WlzFreeValues(*(vVal[2]->values + pIdx[2]));
-	    *(vVal[2]->values + pIdx[2]) = WlzAssignValues(obj2D[2]->values,
-	    						   NULL);
-	  }
-	  (void )WlzFreeObj(obj2D[0]);
-	  (void )WlzFreeObj(obj2D[1]);
-	  (void )WlzFreeObj(obj2D[2]);
-	  ++pIdx[0];
-	  ++vIdx[0];
-	  ++pIdx[1];
-	  ++vIdx[1];
-	  ++pIdx[2];
 	}
       }
     }
@@ -1079,6 +1464,7 @@ static WlzErrorNum WlzImageArithmetic3D(WlzObject *obj0, WlzObject *obj1,
 
 /*!
 * \return	New object or NULL on error.
+* \ingroup	WlzArithmetic
 * \brief	Performs arithmetic on a pair of domain objects.
 *               If the overwrite flag is set and the grey values of
 *               the object to be overwritten are of the wrong type then
@@ -1104,13 +1490,17 @@ static WlzErrorNum WlzImageArithmetic3D(WlzObject *obj0, WlzObject *obj1,
 *                                         < 0 || > 2: Error condition.
 *					  </li>
 *					</ul>
+* \param	clampFlg		Clamp values into the range of the
+*					destination grey type if non-zero,
+*					otherwise values are cast.
 * \param	dstErr			Destination error pointer, may
 *                                       be NULL.
 */
-WlzObject	*WlzImageArithmetic(WlzObject *obj0, WlzObject *obj1,
-				    WlzBinaryOperatorType op,
-				    int overwrite,
-				    WlzErrorNum *dstErr)
+static WlzObject *WlzImageArithmeticObj(WlzObject *obj0, WlzObject *obj1,
+				        WlzBinaryOperatorType op,
+				        int overwrite,
+					int clampFlg,
+				        WlzErrorNum *dstErr)
 {
   WlzObject	*obj2 = NULL,
   		*dstObj = NULL;
@@ -1161,11 +1551,11 @@ WlzObject	*WlzImageArithmetic(WlzObject *obj0, WlzObject *obj1,
 		break;
 	      case WLZ_2D_DOMAINOBJ:
 		errNum =  WlzImageArithmetic2D(obj0, obj1, obj2, op,
-					       overwrite);
+					       overwrite, clampFlg);
 		break;
 	      case WLZ_3D_DOMAINOBJ:
 		errNum = WlzImageArithmetic3D(obj0, obj1, obj2, op,
-					      overwrite);
+					      overwrite, clampFlg);
 		break;
 	      default:
 	        errNum = WLZ_ERR_OBJECT_TYPE;
@@ -1191,3 +1581,83 @@ WlzObject	*WlzImageArithmetic(WlzObject *obj0, WlzObject *obj1,
   }
   return(dstObj);
 }
+
+/*!
+* \return	New object or NULL on error.
+* \brief	Performs arithmetic on a pair of domain objects.
+*               If the overwrite flag is set and the grey values of
+*               the object to be overwritten are of the wrong type then
+*               the returned object has new values as though the
+*               overwrite flag was not set. Values which are outside
+*		the range of the new object's grey type are cast to it.
+* \param	obj0			First object.
+* \param	obj1			Second object.
+* \param	op			Binary operator.
+* \param	overwrite		Allow the destination object
+*                                       to share values with one of
+*                                       the given objects if non zero.
+*					<ul>
+*					  <li>
+*                                         0: No values shared.
+*					  </li>
+*					  <li>
+*                                         1: Values shared with obj0.
+*					  </li>
+*					  <li>
+*                                         2: Values shared with obj1.
+*					  </li>
+*					  <li>
+*                                         < 0 || > 2: Error condition.
+*					  </li>
+*					</ul>
+* \param	dstErr			Destination error pointer, may
+*                                       be NULL.
+*/
+WlzObject	*WlzImageArithmetic(WlzObject *obj0, WlzObject *obj1,
+				    WlzBinaryOperatorType op,
+				    int overwrite,
+				    WlzErrorNum *dstErr)
+{
+  return(WlzImageArithmeticObj(obj0, obj1, op, overwrite, 0, dstErr));
+}
+
+/*!
+* \return	New object or NULL on error.
+* \ingroup	WlzArithmetic
+* \brief	Performs arithmetic on a pair of domain objects as
+*		WlzImageArithmetic() but with values which are outside
+*		the range of the new object's grey type clamped into
+*		it. Eg the product of two WlzUByte objects has short
+*		values, so a product of 255 * 255 is clamped to 32767
+*		rather than wrapping (the difference of two WlzUByte
+*		objects always fits into a short and is unchanged).
+* \param	obj0			First object.
+* \param	obj1			Second object.
+* \param	op			Binary operator.
+* \param	overwrite		Allow the destination object
+*                                       to share values with one of
+*                                       the given objects if non zero.
+*					<ul>
+*					  <li>
+*                                         0: No values shared.
+*					  </li>
+*					  <li>
+*                                         1: Values shared with obj0.
+*					  </li>
+*					  <li>
+*                                         2: Values shared with obj1.
+*					  </li>
+*					  <li>
+*                                         < 0 || > 2: Error condition.
+*					  </li>
+*					</ul>
+* \param	dstErr			Destination error pointer, may
+*                                       be NULL.
+*/
+WlzObject	*WlzImageArithmeticClamp(WlzObject *obj0, WlzObject *obj1,
+					 WlzBinaryOperatorType op,
+					 int overwrite,
+					 WlzErrorNum *dstErr)
+{
+  return(WlzImageArithmeticObj(obj0, obj1, op, overwrite, 1, dstErr));
+}
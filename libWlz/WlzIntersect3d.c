@@ -154,6 +154,12 @@ WlzObject *WlzIntersect3d(WlzObject	**objs,
     return WlzMakeEmpty(wlzErr);
   }
 
+  /* without grey values only the domain is needed and the set
+     operation engine computes all the planes in parallel */
+  if( uvt == 0 ){
+    return WlzDomainSetOp(n, objs, WLZ_BO_AND, wlzErr);
+  }
+
   /* allocate space for a working object array */
   if( (objlist = (WlzObject **) AlcMalloc(sizeof(WlzObject *) * n)) == NULL){
     if(wlzErr) {
@@ -70,8 +70,7 @@ WlzObject *WlzIntersectN(
   WlzErrorNum *dstErr)
 {
   WlzObject 		*obj = NULL;
-  WlzIntervalDomain 	*idom;
-  WlzInterval 		*itvl, *jtvl;
+  WlzDomain		*doms;
   WlzIntervalWSpace 	*iwsp;
   WlzIntervalWSpace 	*biwsp,*tiwsp,niwsp;
   WlzGreyWSpace 	*gwsp,ngwsp;
@@ -81,9 +80,7 @@ WlzObject *WlzIntersectN(
   WlzPixelV		backg;
   WlzGreyP		greyptr;
   WlzGreyV		gv;
-  int 			i, j, k, l, inttot, change, lwas, nints;
-  int 			line1, lastln;
-  int 			kol1, lastkl;
+  int 			i, k, l;
   WlzErrorNum		errNum = WLZ_ERR_NONE;
 
   /*
@@ -200,264 +197,54 @@ WlzObject *WlzIntersectN(
   }
 
   /*
-   * Find the line and column bounds of the intersection.
+   * Compute the intersection of the domains using the interval set
+   * operation engine.
    */
-  line1 = objs[0]->domain.i->line1;
-  lastln = objs[0]->domain.i->lastln;
-  kol1 = objs[0]->domain.i->kol1;
-  lastkl = objs[0]->domain.i->lastkl;
-  for (i=1; i<n; i++) {
-    idom = objs[i]->domain.i;
-    if (line1 < idom->line1)
-    {
-      line1 = idom->line1;
-    }
-    if (lastln > idom->lastln)
-    {
-      lastln = idom->lastln;
-    }
-    if (kol1 < idom->kol1)
-    {
-      kol1 = idom->kol1;
-    }
-    if (lastkl > idom->lastkl)
-    {
-      lastkl = idom->lastkl;
-    }
-  }
-  if( lastkl < kol1 || lastln < line1 ){
-    return WlzMakeEmpty(dstErr);
-  }
-
-  /*
-   * Count the individual intervals so that sufficient space
-   * for the intersection may be allocated.
-   */
-  inttot=0;
-  for (i=0; (i < n) && (errNum == WLZ_ERR_NONE); i++) {
-    inttot += WlzIntervalCount(objs[i]->domain.i, &errNum);
+  if( (doms = (WlzDomain *) AlcMalloc(n * sizeof(WlzDomain))) == NULL ){
+    errNum = WLZ_ERR_MEM_ALLOC;
   }
-  if(errNum != WLZ_ERR_NONE) {
-    if(dstErr) {
-      *dstErr = errNum;
+  else {
+    for (i=0; i<n; i++) {
+      doms[i] = objs[i]->domain;
     }
-    return NULL;
+    domain = WlzDomainSetOp2D(n, doms, WLZ_BO_AND, &errNum);
+    AlcFree((void *) doms);
   }
-
-  /*
-   * Set up domain, value table structures, and object.
-   */
-
-  if( (idom = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
-				    line1, lastln, 0, lastkl-kol1,
-				    &errNum)) == NULL ){
+  if(errNum != WLZ_ERR_NONE) {
     if(dstErr) {
       *dstErr = errNum;
     }
     return NULL;
   }
-  if( (itvl = (WlzInterval *)
-       AlcMalloc (inttot * sizeof(WlzInterval))) == NULL ){
-    WlzFreeIntervalDomain(idom);
-    errNum = WLZ_ERR_MEM_ALLOC;
-    if(dstErr) {
-      *dstErr = errNum;
-    }
-    return NULL;
+  if( domain.core == NULL ){
+    return WlzMakeEmpty(dstErr);
   }
-
-  idom->freeptr = AlcFreeStackPush(idom->freeptr, (void *)itvl, NULL);
-  lwas = line1;
-  jtvl = itvl;
-  nints = 0;
-  domain.i = idom;
   values.v = NULL;
   if( (obj = WlzMakeMain(WLZ_2D_DOMAINOBJ,
 			 domain, values, NULL, NULL, &errNum)) == NULL ){
-    WlzFreeIntervalDomain(idom);
+    (void )WlzFreeDomain(domain);
     if(dstErr) {
       *dstErr = errNum;
     }
     return NULL;
   }
-
   /*
    * allocate space for workspaces
    */
-  if( (iwsp = (WlzIntervalWSpace *)
-       AlcMalloc(n * sizeof(WlzIntervalWSpace))) == NULL ){
-    WlzFreeObj( obj );
-    errNum = WLZ_ERR_MEM_ALLOC;
-    if(dstErr) {
-      *dstErr = errNum;
-    }
-    return NULL;
-  }
-  biwsp = iwsp;
-  tiwsp = biwsp + n;
-
-  /*
-   * Construct the intersection object's table of intervals.
-   * Initialise scanning on each object/workspace combination.
-   * Scan synchronously, setting up the intersection of
-   * overlapping intervals.  Needs a clear head !!
-   */
-  for (i=0; (i < n) && (errNum == WLZ_ERR_NONE); i++) {
-    errNum = WlzInitRasterScan(objs[i],iwsp,WLZ_RASTERDIR_ILIC);
-    if(errNum == WLZ_ERR_NONE) {
-      errNum = WlzNextInterval(iwsp++);
-    }
-  }
-  if(errNum != WLZ_ERR_NONE) {
-    WlzFreeObj( obj );
-    if(dstErr) {
-      *dstErr = errNum;
-    }
-    return NULL;
-  }
-
-  l = lwas;
-  for (;;) {
-    /*
-     * find next line of intersection
-     */
-    do {
-      change = 0;
-      for (iwsp=biwsp; iwsp<tiwsp; iwsp++) {
-	if (iwsp->linpos > l) {
-	  l = iwsp->linpos;
-        }
-      }
-      for (iwsp=biwsp; iwsp<tiwsp; iwsp++) {
-	while (iwsp->linpos < l) {
-	  if ((errNum = WlzNextInterval(iwsp)) != WLZ_ERR_NONE) {
-	    if(errNum == WLZ_ERR_EOO)
-	    {
-	      errNum = WLZ_ERR_NONE;
-	    }
-	    goto firstfinished;
-	  }
-	  if (iwsp->linpos > l) {
-	    change = 1;
-	  }
-	}
-      }
-    } while (change != 0);
-    /*
-     * find next interval of intersection
-     */
-    kol1 = biwsp->lftpos;
-    lastkl = biwsp->rgtpos;
-    while(errNum == WLZ_ERR_NONE) {
-      do {
-	change = 0;
-	for (iwsp=biwsp; iwsp<tiwsp; iwsp++)
-	  if (iwsp->lftpos > lastkl) {
-	    kol1 = iwsp->lftpos;
-	    lastkl = iwsp->rgtpos;
-	  } else if (iwsp->lftpos > kol1)
-	    kol1 = iwsp->lftpos;
-	for (iwsp=biwsp; iwsp<tiwsp; iwsp++) {
-	  while (iwsp->rgtpos < kol1) {
-	    if ((errNum = WlzNextInterval(iwsp)) != WLZ_ERR_NONE) {
-	      if(errNum == WLZ_ERR_EOO)
-	      {
-	        errNum = WLZ_ERR_NONE;
-	      }
-	      goto firstfinished;
-	    }
-	    if (iwsp->linpos != l) {
-	      l = iwsp->linpos;
-	      goto jumpline;
-	    }
-	    if (iwsp->lftpos > kol1)
-	      change = 1;
-	  }
-	}
-      } while ((change != 0) && (errNum == WLZ_ERR_NONE));
-      if(errNum == WLZ_ERR_NONE)
-      {
-	for (iwsp=biwsp; iwsp < tiwsp; iwsp++) {
-	  if (iwsp->rgtpos <= lastkl) {
-	    lastkl = iwsp->rgtpos;
-	  }
-	}
-	if (lastkl >= kol1) {
-	  itvl->ileft = kol1 - idom->kol1;
-	  itvl->iright = lastkl - idom->kol1;
-	  if (l == lwas) {
-	    nints++;
-	  } else {
-	    errNum = WlzMakeInterval(lwas,idom,nints,jtvl);
-	    for (j = lwas+1; (j < l) && (errNum == WLZ_ERR_NONE); j++) {
-	      errNum = WlzMakeInterval(j,idom,0,NULL);
-	    }
-	    if(errNum == WLZ_ERR_NONE) {
-	      lwas = l;
-	      nints = 1;
-	      jtvl = itvl;
-	    }
-	  }
-	  itvl++;
-	}
-	kol1 = lastkl+1;
+  biwsp = NULL;
+  if( uvt != 0 ){
+    if( (iwsp = (WlzIntervalWSpace *)
+	 AlcMalloc(n * sizeof(WlzIntervalWSpace))) == NULL ){
+      WlzFreeObj( obj );
+      errNum = WLZ_ERR_MEM_ALLOC;
+      if(dstErr) {
+	*dstErr = errNum;
       }
+      return NULL;
     }
-
-  jumpline:
-    ;
-  }
-
-firstfinished:
-  if(errNum != WLZ_ERR_NONE) {
-    WlzFreeObj(obj);
-    if(dstErr) {
-      *dstErr = errNum;
-    }
-    return NULL;
-  }
-
-  errNum = WlzMakeInterval(lwas,idom,nints,jtvl);
-  for (j = lwas+1; (j <= lastln) && (errNum == WLZ_ERR_NONE); j++) {
-    errNum = WlzMakeInterval(j,idom,0,NULL);
-  }
-  if(errNum != WLZ_ERR_NONE)
-  {
-    WlzFreeObj(obj);
-    AlcFree((void *) biwsp);
-    if(dstErr)
-    {
-      *dstErr = errNum;
-    }
-    return NULL;
-  }
-
-  /*
-   * standardise the interval list (remove leading and trailing
-   * empty lines, set kol1 so that at least one interval commences
-   * at zero, set lastkl correctly)
-   */
-  (void )WlzStandardIntervalDomain(idom);
-
-  /* check for error or empty */
-  nints = WlzIntervalCount(idom, &errNum);
-  if( nints < 0 ){
-    /* error */
-    WlzFreeObj(obj);
-    AlcFree((void *) biwsp);
-    if(dstErr)
-    {
-      *dstErr = errNum;
-    }
-    return NULL;
+    biwsp = iwsp;
+    tiwsp = biwsp + n;
   }
-  else if( nints == 0 ){
-    /* empty object */
-    WlzFreeObj(obj);
-    AlcFree((void *) biwsp);
-    return WlzMakeEmpty(dstErr);
-  }
-
   if (uvt != 0) {
     WlzGreyType	grey_type;
     if( (gwsp = (WlzGreyWSpace *)
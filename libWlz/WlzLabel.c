@@ -139,7 +139,8 @@ extern WlzErrorNum		WlzLabel3d(
 * 		this version requires that there is sufficient space in the
 * 		objects array defined by maxNumObjs and this is not extended.
 * 		This should be changed in future so that the array is extended
-* 		as required.
+* 		as required. WlzLabelUF() has no such limit and is much
+* 		faster for 3D objects.
 * \param	obj			Input object to be segmented.
 * \param	mm			Number of objects for return.
 * \param	dstArrayObjs		Object array for, allocated in this
@@ -287,7 +287,8 @@ static WlzObject *find3Dobj(
 
   /* check for overlaps in the plane below */
   if( p != 0 ){
-    for(i=0; i < narray[p-1]; i++){
+    i = 0;
+    while( i < narray[p-1] ){
       if( WlzHasIntersection(obj, objarray[p-1][i], &errNum) ){
 	tobj = objarray[p-1][i];
 	removeObj(narray, objarray, tobj, p-1);
@@ -299,6 +300,12 @@ static WlzObject *find3Dobj(
 	WlzFreeObj(current_3D);
 	WlzFreeObj(new_3D);
 	current_3D = temp_3D;
+	/* Objects in this plane have been removed, possibly also by the
+	 * recursive search, so start again from the first. */
+	i = 0;
+      }
+      else {
+	i++;
       }
     }
   }
@@ -306,7 +313,8 @@ static WlzObject *find3Dobj(
   /* check for overlaps in the plane above */
   nplanes = pladm->lastpl - pladm->plane1 + 1;
   if( p < (nplanes-1) ){
-    for(i=0; i < narray[p+1]; i++){
+    i = 0;
+    while( i < narray[p+1] ){
       if( WlzHasIntersection(obj, objarray[p+1][i], &errNum) ){
 	tobj = objarray[p+1][i];
 	removeObj(narray, objarray, tobj, p+1);
@@ -318,6 +326,11 @@ static WlzObject *find3Dobj(
 	WlzFreeObj(current_3D);
 	WlzFreeObj(new_3D);
 	current_3D = temp_3D;
+	/* As above, start again from the first. */
+	i = 0;
+      }
+      else {
+	i++;
       }
     }
   }
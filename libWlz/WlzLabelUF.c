@@ -0,0 +1,1182 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzLabelUF_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzLabelUF.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Segments a 2D or 3D domain into connected components
+* 		using a two pass union-find interval labeller.
+* \ingroup	WlzBinaryOps
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <Wlz.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \struct	_WlzLabelUFWSp
+* \ingroup	WlzBinaryOps
+* \brief	Work space for the union-find labeller. The intervals of
+* 		the object are held in a single array in raster order
+* 		with the intervals of each row (a line of a plane) being
+* 		contiguous.
+*		Typedef: ::WlzLabelUFWSp.
+*/
+typedef struct _WlzLabelUFWSp
+{
+  int		dim;			/*!< Dimension of the object, 2 or
+  					     3. */
+  int		pln1;			/*!< First plane. */
+  int		nPln;			/*!< Number of planes. */
+  int		ln1;			/*!< First line. */
+  int		nLn;			/*!< Number of lines in each plane. */
+  int		nRow;			/*!< Number of rows, ie nPln * nLn. */
+  int		nItv;			/*!< Number of intervals. */
+  int		*rowOff;		/*!< Offsets of the first interval of
+  					     each row, with nRow + 1
+					     entries. */
+  WlzInterval	*itv;			/*!< Intervals with absolute column
+  					     coordinates. */
+  int		*lbl;			/*!< Union-find parents and then the
+  					     component labels of the
+					     intervals. */
+  int		nLbl;			/*!< Number of components. */
+  WlzIBox3	*box;			/*!< Bounding box of each
+  					     component. */
+  int		*map;			/*!< Map from component labels to
+  					     the labels of the components kept,
+					     -1 for ignored components. */
+  int		nKeep;			/*!< Number of components kept. */
+  int		nBlk;			/*!< Number of row blocks. */
+  int		*blkRow;		/*!< First row of each block, with
+  					     nBlk + 1 entries. */
+  int		tLn;			/*!< Column tolerance for intervals
+  					     on the previous line. */
+  int		tPl;			/*!< Column tolerance for intervals
+  					     on the same line of the previous
+					     plane. */
+  int		tDg;			/*!< Column tolerance for intervals
+  					     on the adjacent lines of the
+					     previous plane, -1 if these are
+					     not connected. */
+} WlzLabelUFWSp;
+
+static int			WlzLabelUFFind(
+				  int *prt,
+				  int i);
+static int			WlzLabelUFRoot(
+				  int *prt,
+				  int i);
+static int			WlzLabelUFRowItv(
+				  WlzLabelUFWSp *wSp,
+				  WlzObject *obj,
+				  int row,
+				  WlzInterval *dst);
+static void			WlzLabelUFUnion(
+				  int *prt,
+				  int i,
+				  int j);
+static void			WlzLabelUFUnionRows(
+				  WlzLabelUFWSp *wSp,
+				  int r,
+				  int q,
+				  int tol);
+static void			WlzLabelUFRowUnions(
+				  WlzLabelUFWSp *wSp,
+				  int r,
+				  int qMin,
+				  int qMax);
+static void			WlzLabelUFFreeWSp(
+				  WlzLabelUFWSp *wSp);
+static WlzErrorNum		WlzLabelUFEng(
+				  WlzLabelUFWSp *wSp,
+				  WlzObject *obj,
+				  int ignlns,
+				  WlzConnectType connect);
+static WlzIntervalDomain	*WlzLabelUFMakeIDom(
+				  WlzLabelUFWSp *wSp,
+				  int *grp,
+				  int *grpRow,
+				  int n,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzLabelUFMakeObj(
+				  WlzLabelUFWSp *wSp,
+				  WlzObject *obj,
+				  int *grp,
+				  int *grpRow,
+				  int n,
+				  WlzErrorNum *dstErr);
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Segments a domain into connected parts using a union-find
+* 		interval labeller. Unlike WlzLabel() the number of
+* 		objects is not limited and the object array is allocated
+* 		to fit the components found.
+* 		Connectivity may be 4- or 8-connected for 2D objects
+* 		and 6-, 18- or 26-connected for 3D objects. For 3D objects
+* 		WLZ_4_CONNECTED and WLZ_8_CONNECTED are interpreted as
+* 		by WlzLabel(), with the intervals of each plane being
+* 		4- or 8-connected and intervals of adjacent planes
+* 		connected only if they overlap, so WLZ_4_CONNECTED is
+* 		the same as WLZ_6_CONNECTED. For 2D objects
+* 		WLZ_6_CONNECTED is taken to be WLZ_4_CONNECTED and the
+* 		others WLZ_8_CONNECTED.
+* 		The objects are returned in the raster order of their
+* 		first interval. 2D objects share the values of the given
+* 		object and 3D objects share its plane value tables.
+* 		For empty objects no objects are returned.
+* 		The labelling is done in two passes, each of which is
+* 		parallel over blocks of lines (2D) or planes (3D). In the
+* 		first pass the intervals of each block are merged
+* 		using a union-find forest, with the blocks then joined
+* 		sequentially along their boundaries. In the second pass
+* 		each interval is given the label of its root.
+* \param	obj			Input object to be segmented.
+* \param	dstNObj			Destination pointer for the number
+* 					of objects, set to zero on error.
+* \param	dstObjs			Destination pointer for the array of
+* 					objects, allocated in this function.
+* \param	ignlns			Ignore components with a line or
+* 					column extent \f$\leq\f$ ignlns.
+* \param	connect			Connectivity to determine connected
+* 					regions.
+*/
+WlzErrorNum			WlzLabelUF(
+				  WlzObject *obj,
+				  int *dstNObj,
+				  WlzObject ***dstObjs,
+				  int ignlns,
+				  WlzConnectType connect)
+{
+  int		k,
+  		i,
+		r;
+  int		*grp = NULL,
+  		*grpRow = NULL,
+		*grpOff = NULL;
+  WlzObject	**objs = NULL;
+  WlzLabelUFWSp	wSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  (void )memset(&wSp, 0, sizeof(WlzLabelUFWSp));
+  if((dstNObj == NULL) || (dstObjs == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    *dstNObj = 0;
+    *dstObjs = NULL;
+    if((obj == NULL) || (obj->type != WLZ_EMPTY_OBJ))
+    {
+      errNum = WlzLabelUFEng(&wSp, obj, ignlns, connect);
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && (wSp.nKeep > 0))
+  {
+    /* Group the intervals by component, keeping the raster order within
+     * each component. */
+    if(((grpOff = (int *)AlcCalloc(wSp.nKeep + 1, sizeof(int))) == NULL) ||
+       ((objs = (WlzObject **)
+		AlcCalloc(wSp.nKeep, sizeof(WlzObject *))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      for(i = 0; i < wSp.nItv; ++i)
+      {
+	if((k = wSp.map[wSp.lbl[i]]) >= 0)
+	{
+	  ++(grpOff[k + 1]);
+	}
+      }
+      for(k = 0; k < wSp.nKeep; ++k)
+      {
+	grpOff[k + 1] += grpOff[k];
+      }
+      i = grpOff[wSp.nKeep];
+      if(((grp = (int *)AlcMalloc(i * sizeof(int))) == NULL) ||
+	 ((grpRow = (int *)AlcMalloc(i * sizeof(int))) == NULL))
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      for(r = 0; r < wSp.nRow; ++r)
+      {
+	for(i = wSp.rowOff[r]; i < wSp.rowOff[r + 1]; ++i)
+	{
+	  if((k = wSp.map[wSp.lbl[i]]) >= 0)
+	  {
+	    grp[grpOff[k]] = i;
+	    grpRow[grpOff[k]++] = r;
+	  }
+	}
+      }
+      /* Restore the group offsets shifted by the fill. */
+      for(k = wSp.nKeep; k > 0; --k)
+      {
+	grpOff[k] = grpOff[k - 1];
+      }
+      grpOff[0] = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 16)
+#endif
+      for(k = 0; k < wSp.nKeep; ++k)
+      {
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  int		o;
+	  WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+	  o = grpOff[k];
+	  objs[k] = WlzLabelUFMakeObj(&wSp, obj, grp + o, grpRow + o,
+				      grpOff[k + 1] - o, &errNum2);
+	  if(errNum2 != WLZ_ERR_NONE)
+	  {
+#ifdef _OPENMP
+#pragma omp critical
+	    {
+#endif
+	      if(errNum == WLZ_ERR_NONE)
+	      {
+		errNum = errNum2;
+	      }
+#ifdef _OPENMP
+	    }
+#endif
+	  }
+	}
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      *dstNObj = wSp.nKeep;
+      *dstObjs = objs;
+    }
+    else if(objs)
+    {
+      for(k = 0; k < wSp.nKeep; ++k)
+      {
+	(void )WlzFreeObj(objs[k]);
+      }
+      AlcFree(objs);
+    }
+    AlcFree(grp);
+    AlcFree(grpRow);
+    AlcFree(grpOff);
+  }
+  WlzLabelUFFreeWSp(&wSp);
+  return(errNum);
+}
+
+/*!
+* \return	New label object or NULL on error.
+* \ingroup	WlzBinaryOps
+* \brief	Segments a domain into connected parts as WlzLabelUF() but
+* 		rather than returning an object for each component, returns
+* 		a single object with the domain of the given object and
+* 		WLZ_GREY_INT values which are the component labels. The
+* 		components are labelled from 1 in the raster order of their
+* 		first interval, with the values of ignored components set
+* 		to zero.
+* 		For empty objects an empty object is returned.
+* \param	obj			Input object to be segmented.
+* \param	ignlns			Ignore components with a line or
+* 					column extent \f$\leq\f$ ignlns.
+* \param	connect			Connectivity to determine connected
+* 					regions, see WlzLabelUF().
+* \param	dstNLbl			Destination pointer for the number of
+* 					labels, may be NULL.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject			*WlzLabelUFImage(
+				  WlzObject *obj,
+				  int ignlns,
+				  WlzConnectType connect,
+				  int *dstNLbl,
+				  WlzErrorNum *dstErr)
+{
+  int		r;
+  WlzPixelV	bgdV;
+  WlzObject	*lObj = NULL;
+  WlzLabelUFWSp	wSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((obj != NULL) && (obj->type == WLZ_EMPTY_OBJ))
+  {
+    lObj = WlzMakeEmpty(&errNum);
+    wSp.nKeep = 0;
+  }
+  else
+  {
+    errNum = WlzLabelUFEng(&wSp, obj, ignlns, connect);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      bgdV.type = WLZ_GREY_INT;
+      bgdV.v.inv = 0;
+      lObj = WlzNewObjectValues(obj,
+			        WlzGreyTableType(WLZ_GREY_TAB_RAGR,
+						 WLZ_GREY_INT, NULL),
+			        bgdV, 0, bgdV, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for(r = 0; r < wSp.nRow; ++r)
+      {
+	int		i,
+		  	x,
+			k;
+	int		*gP;
+	WlzRagRValues	*vTb;
+	WlzValueLine	*vLn;
+
+	if(wSp.rowOff[r] < wSp.rowOff[r + 1])
+	{
+	  vTb = (wSp.dim == 2)? lObj->values.v:
+	  			lObj->values.vox->values[r / wSp.nLn].v;
+	  vLn = vTb->vtblines + (wSp.ln1 + (r % wSp.nLn)) - vTb->line1;
+	  gP = vLn->values.inp - (vTb->kol1 + vLn->vkol1);
+	  for(i = wSp.rowOff[r]; i < wSp.rowOff[r + 1]; ++i)
+	  {
+	    k = wSp.map[wSp.lbl[i]] + 1;
+	    for(x = wSp.itv[i].ileft; x <= wSp.itv[i].iright; ++x)
+	    {
+	      gP[x] = k;
+	    }
+	  }
+	}
+      }
+    }
+    WlzLabelUFFreeWSp(&wSp);
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreeObj(lObj);
+    lObj = NULL;
+  }
+  else if(dstNLbl)
+  {
+    *dstNLbl = wSp.nKeep;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(lObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzBinaryOps
+* \brief	Labels the intervals of the given object, setting the
+* 		component label of each interval, the bounding box of
+* 		each component and the map from component labels to
+* 		those of the components kept. The work space must be
+* 		freed using WlzLabelUFFreeWSp() whatever the error code.
+* \param	wSp			Work space to be initialised.
+* \param	obj			Given 2D or 3D domain object.
+* \param	ignlns			Ignore components with a line or
+* 					column extent \f$\leq\f$ ignlns.
+* \param	connect			Connectivity.
+*/
+static WlzErrorNum		WlzLabelUFEng(
+				  WlzLabelUFWSp *wSp,
+				  WlzObject *obj,
+				  int ignlns,
+				  WlzConnectType connect)
+{
+  int		b,
+  		c,
+		i,
+		p,
+		r,
+		nUnit,
+		nThr = 1;
+  int		*rt = NULL,
+  		*blkCnt = NULL;
+  WlzDomain	dom;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  (void )memset(wSp, 0, sizeof(WlzLabelUFWSp));
+  if(obj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else if(obj->domain.core == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else
+  {
+    switch(obj->type)
+    {
+      case WLZ_2D_DOMAINOBJ:
+	switch(obj->domain.core->type)
+	{
+	  case WLZ_INTERVALDOMAIN_INTVL: /* FALLTHROUGH */
+	  case WLZ_INTERVALDOMAIN_RECT:
+	    wSp->dim = 2;
+	    wSp->pln1 = 0;
+	    wSp->nPln = 1;
+	    wSp->ln1 = obj->domain.i->line1;
+	    wSp->nLn = obj->domain.i->lastln - obj->domain.i->line1 + 1;
+	    break;
+	  default:
+	    errNum = WLZ_ERR_DOMAIN_TYPE;
+	    break;
+	}
+	break;
+      case WLZ_3D_DOMAINOBJ:
+	if(obj->domain.core->type != WLZ_PLANEDOMAIN_DOMAIN)
+	{
+	  errNum = WLZ_ERR_PLANEDOMAIN_TYPE;
+	}
+	else
+	{
+	  wSp->dim = 3;
+	  wSp->pln1 = obj->domain.p->plane1;
+	  wSp->nPln = obj->domain.p->lastpl - obj->domain.p->plane1 + 1;
+	  wSp->ln1 = obj->domain.p->line1;
+	  wSp->nLn = obj->domain.p->lastln - obj->domain.p->line1 + 1;
+	  for(p = 0; p < wSp->nPln; ++p)
+	  {
+	    dom = obj->domain.p->domains[p];
+	    if(dom.core != NULL)
+	    {
+	      switch(dom.core->type)
+	      {
+		case WLZ_EMPTY_DOMAIN:
+		  break;
+		case WLZ_INTERVALDOMAIN_INTVL: /* FALLTHROUGH */
+		case WLZ_INTERVALDOMAIN_RECT:
+		  if((dom.i->line1 < obj->domain.p->line1) ||
+		     (dom.i->lastln > obj->domain.p->lastln))
+		  {
+		    errNum = WLZ_ERR_DOMAIN_DATA;
+		  }
+		  break;
+		default:
+		  errNum = WLZ_ERR_DOMAIN_TYPE;
+		  break;
+	      }
+	    }
+	  }
+	}
+	break;
+      case WLZ_TRANS_OBJ:
+	errNum = WLZ_ERR_UNIMPLEMENTED;
+	break;
+      default:
+	errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(connect)
+    {
+      case WLZ_4_CONNECTED: /* FALLTHROUGH */
+      case WLZ_6_CONNECTED:
+	wSp->tLn = 0;
+	wSp->tPl = 0;
+	wSp->tDg = -1;
+	break;
+      case WLZ_8_CONNECTED:
+        /* In 3D, as for WlzLabel(), 8-connected within planes and
+	 * only overlapping intervals connected between planes. */
+	wSp->tLn = 1;
+	wSp->tPl = 0;
+	wSp->tDg = -1;
+	break;
+      case WLZ_18_CONNECTED:
+	wSp->tLn = 1;
+	wSp->tPl = 1;
+	wSp->tDg = 0;
+	break;
+      case WLZ_26_CONNECTED:
+	wSp->tLn = 1;
+	wSp->tPl = 1;
+	wSp->tDg = 1;
+	break;
+      default:
+	errNum = WLZ_ERR_PARAM_DATA;
+	break;
+    }
+  }
+  /* Divide the rows into blocks of lines (2D) or planes (3D), so that
+   * rows in a block only connect to rows in the same or earlier blocks. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    wSp->nRow = wSp->nPln * wSp->nLn;
+#ifdef _OPENMP
+    nThr = omp_get_max_threads();
+#endif
+    nUnit = (wSp->dim == 2)? wSp->nLn: wSp->nPln;
+    wSp->nBlk = (nThr > 1)? WLZ_MIN(nUnit, 4 * nThr): 1;
+    if(((wSp->rowOff = (int *)
+		       AlcMalloc((wSp->nRow + 1) * sizeof(int))) == NULL) ||
+       ((wSp->blkRow = (int *)
+		       AlcMalloc((wSp->nBlk + 1) * sizeof(int))) == NULL) ||
+       ((blkCnt = (int *)AlcCalloc(wSp->nBlk + 1, sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      for(b = 0; b <= wSp->nBlk; ++b)
+      {
+	wSp->blkRow[b] = (int )(((long )nUnit * b) / wSp->nBlk) *
+	                 ((wSp->dim == 2)? 1: wSp->nLn);
+      }
+    }
+  }
+  /* Count and then gather the intervals of each row. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(r = 0; r < wSp->nRow; ++r)
+    {
+      wSp->rowOff[r + 1] = WlzLabelUFRowItv(wSp, obj, r, NULL);
+    }
+    wSp->rowOff[0] = 0;
+    for(r = 0; r < wSp->nRow; ++r)
+    {
+      wSp->rowOff[r + 1] += wSp->rowOff[r];
+    }
+    wSp->nItv = wSp->rowOff[wSp->nRow];
+    if(((wSp->itv = (WlzInterval *)
+		    AlcMalloc((wSp->nItv + 1) * sizeof(WlzInterval))) == NULL) ||
+       ((wSp->lbl = (int *)
+		    AlcMalloc((wSp->nItv + 1) * sizeof(int))) == NULL) ||
+       ((rt = (int *)AlcMalloc((wSp->nItv + 1) * sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* First pass: build a union-find forest of the intervals within each
+   * block in parallel and then join the blocks along their boundaries.
+   * Roots are always the lowest index of their set, so parents never
+   * point outside of the block while the blocks are being processed. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(b = 0; b < wSp->nBlk; ++b)
+    {
+      int	r0,
+      		i0;
+
+      for(r0 = wSp->blkRow[b]; r0 < wSp->blkRow[b + 1]; ++r0)
+      {
+	(void )WlzLabelUFRowItv(wSp, obj, r0, wSp->itv + wSp->rowOff[r0]);
+	for(i0 = wSp->rowOff[r0]; i0 < wSp->rowOff[r0 + 1]; ++i0)
+	{
+	  wSp->lbl[i0] = i0;
+	}
+	WlzLabelUFRowUnions(wSp, r0, wSp->blkRow[b], r0);
+      }
+    }
+    /* Only the first line (2D) or plane (3D) of a block can connect
+     * to the previous block. */
+    for(b = 1; b < wSp->nBlk; ++b)
+    {
+      int	rE;
+
+      rE = wSp->blkRow[b] + ((wSp->dim == 2)? 1: wSp->nLn);
+      for(r = wSp->blkRow[b]; r < rE; ++r)
+      {
+	WlzLabelUFRowUnions(wSp, r, 0, wSp->blkRow[b]);
+      }
+    }
+  }
+  /* Second pass: find the root of every interval, number the roots in
+   * order and then give every interval the number of its root. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(b = 0; b < wSp->nBlk; ++b)
+    {
+      int	i0,
+      		n = 0;
+
+      for(i0 = wSp->rowOff[wSp->blkRow[b]];
+          i0 < wSp->rowOff[wSp->blkRow[b + 1]]; ++i0)
+      {
+	if((rt[i0] = WlzLabelUFRoot(wSp->lbl, i0)) == i0)
+	{
+	  ++n;
+	}
+      }
+      blkCnt[b + 1] = n;
+    }
+    for(b = 0; b < wSp->nBlk; ++b)
+    {
+      blkCnt[b + 1] += blkCnt[b];
+    }
+    wSp->nLbl = blkCnt[wSp->nBlk];
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for(b = 0; b < wSp->nBlk; ++b)
+    {
+      int	i0,
+      		n;
+
+      n = blkCnt[b];
+      for(i0 = wSp->rowOff[wSp->blkRow[b]];
+          i0 < wSp->rowOff[wSp->blkRow[b + 1]]; ++i0)
+      {
+	if(rt[i0] == i0)
+	{
+	  wSp->lbl[i0] = n++;
+	}
+      }
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for(i = 0; i < wSp->nItv; ++i)
+    {
+      if(rt[i] != i)
+      {
+	wSp->lbl[i] = wSp->lbl[rt[i]];
+      }
+    }
+  }
+  AlcFree(rt);
+  AlcFree(blkCnt);
+  /* Find the component bounding boxes and the components to keep. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(((wSp->box = (WlzIBox3 *)
+		    AlcMalloc((wSp->nLbl + 1) * sizeof(WlzIBox3))) == NULL) ||
+       ((wSp->map = (int *)AlcMalloc((wSp->nLbl + 1) * sizeof(int))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(c = 0; c < wSp->nLbl; ++c)
+    {
+      wSp->map[c] = 0;
+    }
+    for(r = 0; r < wSp->nRow; ++r)
+    {
+      int	ln,
+      		pl;
+
+      pl = wSp->pln1 + (r / wSp->nLn);
+      ln = wSp->ln1 + (r % wSp->nLn);
+      for(i = wSp->rowOff[r]; i < wSp->rowOff[r + 1]; ++i)
+      {
+	WlzIBox3 *bx;
+
+	c = wSp->lbl[i];
+	bx = wSp->box + c;
+	if(wSp->map[c] == 0)
+	{
+	  wSp->map[c] = 1;
+	  bx->xMin = wSp->itv[i].ileft;
+	  bx->xMax = wSp->itv[i].iright;
+	  bx->yMin = bx->yMax = ln;
+	  bx->zMin = bx->zMax = pl;
+	}
+	else
+	{
+	  bx->xMin = WLZ_MIN(bx->xMin, wSp->itv[i].ileft);
+	  bx->xMax = WLZ_MAX(bx->xMax, wSp->itv[i].iright);
+	  bx->yMin = WLZ_MIN(bx->yMin, ln);
+	  bx->yMax = WLZ_MAX(bx->yMax, ln);
+	  bx->zMax = pl;
+	}
+      }
+    }
+    wSp->nKeep = 0;
+    for(c = 0; c < wSp->nLbl; ++c)
+    {
+      WlzIBox3 *bx;
+
+      bx = wSp->box + c;
+      wSp->map[c] = ((bx->yMax - bx->yMin < ignlns) ||
+		     (bx->xMax - bx->xMin < ignlns))? -1: wSp->nKeep++;
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Frees the arrays of a union-find labeller work space.
+* \param	wSp			Given work space.
+*/
+static void			WlzLabelUFFreeWSp(
+				  WlzLabelUFWSp *wSp)
+{
+  AlcFree(wSp->rowOff);
+  AlcFree(wSp->blkRow);
+  AlcFree(wSp->itv);
+  AlcFree(wSp->lbl);
+  AlcFree(wSp->box);
+  AlcFree(wSp->map);
+}
+
+/*!
+* \return	Number of intervals in the row.
+* \ingroup	WlzBinaryOps
+* \brief	Counts the intervals of the given row of the object and
+* 		if the destination is non-NULL sets them with absolute
+* 		column coordinates.
+* \param	wSp			Work space.
+* \param	obj			Given object, already checked.
+* \param	row			Row index.
+* \param	dst			Destination for the intervals, may be
+* 					NULL.
+*/
+static int			WlzLabelUFRowItv(
+				  WlzLabelUFWSp *wSp,
+				  WlzObject *obj,
+				  int row,
+				  WlzInterval *dst)
+{
+  int		i,
+  		ln,
+  		n = 0;
+  WlzDomain	dom;
+  WlzIntervalLine *itvLn;
+
+  dom = (wSp->dim == 2)? obj->domain:
+  			 obj->domain.p->domains[row / wSp->nLn];
+  ln = wSp->ln1 + (row % wSp->nLn);
+  if((dom.core != NULL) && (dom.core->type != WLZ_EMPTY_DOMAIN) &&
+     (ln >= dom.i->line1) && (ln <= dom.i->lastln))
+  {
+    if(dom.core->type == WLZ_INTERVALDOMAIN_RECT)
+    {
+      n = 1;
+      if(dst)
+      {
+        dst->ileft = dom.i->kol1;
+	dst->iright = dom.i->lastkl;
+      }
+    }
+    else
+    {
+      itvLn = dom.i->intvlines + ln - dom.i->line1;
+      n = itvLn->nintvs;
+      if(dst)
+      {
+	for(i = 0; i < n; ++i)
+	{
+	  dst[i].ileft = itvLn->intvs[i].ileft + dom.i->kol1;
+	  dst[i].iright = itvLn->intvs[i].iright + dom.i->kol1;
+	}
+      }
+    }
+  }
+  return(n);
+}
+
+/*!
+* \return	Root of the set.
+* \ingroup	WlzBinaryOps
+* \brief	Finds the root of the set containing the given element,
+* 		halving the path as it goes.
+* \param	prt			Parent array.
+* \param	i			Given element.
+*/
+static int			WlzLabelUFFind(
+				  int *prt,
+				  int i)
+{
+  while(prt[i] != i)
+  {
+    prt[i] = prt[prt[i]];
+    i = prt[i];
+  }
+  return(i);
+}
+
+/*!
+* \return	Root of the set.
+* \ingroup	WlzBinaryOps
+* \brief	Finds the root of the set containing the given element
+* 		without modifying the parent array, so that it may be
+* 		called concurrently.
+* \param	prt			Parent array.
+* \param	i			Given element.
+*/
+static int			WlzLabelUFRoot(
+				  int *prt,
+				  int i)
+{
+  while(prt[i] != i)
+  {
+    i = prt[i];
+  }
+  return(i);
+}
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Joins the sets containing the two elements, the root of
+* 		the joined set being the lower of the two roots.
+* \param	prt			Parent array.
+* \param	i			First element.
+* \param	j			Second element.
+*/
+static void			WlzLabelUFUnion(
+				  int *prt,
+				  int i,
+				  int j)
+{
+  i = WlzLabelUFFind(prt, i);
+  j = WlzLabelUFFind(prt, j);
+  if(i < j)
+  {
+    prt[j] = i;
+  }
+  else if(j < i)
+  {
+    prt[i] = j;
+  }
+}
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Joins the sets of the intervals of row r with those of the
+* 		intervals of row q which overlap them, with intervals
+* 		being taken to overlap if their column gap is no more
+* 		than the given tolerance.
+* \param	wSp			Work space.
+* \param	r			First row.
+* \param	q			Second row.
+* \param	tol			Column tolerance.
+*/
+static void			WlzLabelUFUnionRows(
+				  WlzLabelUFWSp *wSp,
+				  int r,
+				  int q,
+				  int tol)
+{
+  int		i,
+  		j,
+		iE,
+		jE;
+  WlzInterval	*itv;
+
+  itv = wSp->itv;
+  i = wSp->rowOff[r];
+  iE = wSp->rowOff[r + 1];
+  j = wSp->rowOff[q];
+  jE = wSp->rowOff[q + 1];
+  while((i < iE) && (j < jE))
+  {
+    if(itv[j].iright + tol < itv[i].ileft)
+    {
+      ++j;
+    }
+    else if(itv[i].iright + tol < itv[j].ileft)
+    {
+      ++i;
+    }
+    else
+    {
+      WlzLabelUFUnion(wSp->lbl, i, j);
+      if(itv[i].iright < itv[j].iright)
+      {
+        ++i;
+      }
+      else
+      {
+        ++j;
+      }
+    }
+  }
+}
+
+/*!
+* \ingroup	WlzBinaryOps
+* \brief	Joins the sets of the intervals of the given row with those
+* 		of the connected intervals in the preceding rows which have
+* 		indices in the range [qMin, qMax).
+* \param	wSp			Work space.
+* \param	r			Given row.
+* \param	qMin			Minimum row index.
+* \param	qMax			Maximum row index plus one.
+*/
+static void			WlzLabelUFRowUnions(
+				  WlzLabelUFWSp *wSp,
+				  int r,
+				  int qMin,
+				  int qMax)
+{
+  int		l,
+  		q;
+
+  if(wSp->rowOff[r] < wSp->rowOff[r + 1])
+  {
+    l = r % wSp->nLn;
+    if((l > 0) && ((q = r - 1) >= qMin) && (q < qMax))
+    {
+      WlzLabelUFUnionRows(wSp, r, q, wSp->tLn);
+    }
+    if(r >= wSp->nLn)
+    {
+      if(((q = r - wSp->nLn) >= qMin) && (q < qMax))
+      {
+	WlzLabelUFUnionRows(wSp, r, q, wSp->tPl);
+      }
+      if(wSp->tDg >= 0)
+      {
+	if((l > 0) && ((q = r - wSp->nLn - 1) >= qMin) && (q < qMax))
+	{
+	  WlzLabelUFUnionRows(wSp, r, q, wSp->tDg);
+	}
+	if((l < wSp->nLn - 1) && ((q = r - wSp->nLn + 1) >= qMin) &&
+	   (q < qMax))
+	{
+	  WlzLabelUFUnionRows(wSp, r, q, wSp->tDg);
+	}
+      }
+    }
+  }
+}
+
+/*!
+* \return	New interval domain or NULL on error.
+* \ingroup	WlzBinaryOps
+* \brief	Makes an interval domain from the given intervals, which
+* 		must be in raster order and all be in a single plane.
+* \param	wSp			Work space.
+* \param	grp			Indices of the intervals.
+* \param	grpRow			Rows of the intervals.
+* \param	n			Number of intervals.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzIntervalDomain	*WlzLabelUFMakeIDom(
+				  WlzLabelUFWSp *wSp,
+				  int *grp,
+				  int *grpRow,
+				  int n,
+				  WlzErrorNum *dstErr)
+{
+  int		j,
+  		j0,
+		kl0,
+		kl1;
+  WlzInterval	*itv0,
+  		*itv1 = NULL;
+  WlzIntervalDomain *iDom = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  kl0 = wSp->itv[grp[0]].ileft;
+  kl1 = wSp->itv[grp[0]].iright;
+  for(j = 1; j < n; ++j)
+  {
+    itv0 = wSp->itv + grp[j];
+    kl0 = WLZ_MIN(kl0, itv0->ileft);
+    kl1 = WLZ_MAX(kl1, itv0->iright);
+  }
+  iDom = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
+			       wSp->ln1 + (grpRow[0] % wSp->nLn),
+			       wSp->ln1 + (grpRow[n - 1] % wSp->nLn),
+			       kl0, kl1, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((itv1 = (WlzInterval *)AlcMalloc(n * sizeof(WlzInterval))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      iDom->freeptr = AlcFreeStackPush(iDom->freeptr, (void *)itv1, NULL);
+      if(iDom->freeptr == NULL)
+      {
+	AlcFree(itv1);
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    j0 = 0;
+    for(j = 0; j < n; ++j)
+    {
+      itv0 = wSp->itv + grp[j];
+      itv1[j].ileft = itv0->ileft - kl0;
+      itv1[j].iright = itv0->iright - kl0;
+      if((j == n - 1) || (grpRow[j + 1] != grpRow[j]))
+      {
+	(void )WlzMakeInterval(wSp->ln1 + (grpRow[j] % wSp->nLn), iDom,
+			       j - j0 + 1, itv1 + j0);
+        j0 = j + 1;
+      }
+    }
+  }
+  else if(iDom)
+  {
+    (void )WlzFreeIntervalDomain(iDom);
+    iDom = NULL;
+  }
+  *dstErr = errNum;
+  return(iDom);
+}
+
+/*!
+* \return	New object or NULL on error.
+* \ingroup	WlzBinaryOps
+* \brief	Makes the object of a single component from its intervals
+* 		which must be in raster order.
+* \param	wSp			Work space.
+* \param	obj			Given object being labelled.
+* \param	grp			Indices of the intervals.
+* \param	grpRow			Rows of the intervals.
+* \param	n			Number of intervals.
+* \param	dstErr			Destination error pointer.
+*/
+static WlzObject		*WlzLabelUFMakeObj(
+				  WlzLabelUFWSp *wSp,
+				  WlzObject *obj,
+				  int *grp,
+				  int *grpRow,
+				  int n,
+				  WlzErrorNum *dstErr)
+{
+  int		j,
+  		j0,
+		p,
+		p0;
+  WlzIBox3	*bx;
+  WlzDomain	dom,
+  		dom2;
+  WlzValues	val;
+  WlzObject	*cObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  if(wSp->dim == 2)
+  {
+    dom.i = WlzLabelUFMakeIDom(wSp, grp, grpRow, n, &errNum);
+    val = obj->values;
+  }
+  else
+  {
+    bx = wSp->box + wSp->lbl[grp[0]];
+    dom.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
+			       bx->zMin, bx->zMax, bx->yMin, bx->yMax,
+			       bx->xMin, bx->xMax, &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      dom.p->voxel_size[0] = obj->domain.p->voxel_size[0];
+      dom.p->voxel_size[1] = obj->domain.p->voxel_size[1];
+      dom.p->voxel_size[2] = obj->domain.p->voxel_size[2];
+      j0 = 0;
+      for(j = 0; (errNum == WLZ_ERR_NONE) && (j < n); ++j)
+      {
+	p = grpRow[j] / wSp->nLn;
+	if((j == n - 1) || (grpRow[j + 1] / wSp->nLn != p))
+	{
+	  dom2.i = WlzLabelUFMakeIDom(wSp, grp + j0, grpRow + j0,
+				      j - j0 + 1, &errNum);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    dom.p->domains[wSp->pln1 + p - bx->zMin] =
+	        WlzAssignDomain(dom2, NULL);
+	  }
+	  j0 = j + 1;
+	}
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && (obj->values.core != NULL))
+    {
+      if(WlzGreyTableIsTiled(obj->values.core->type))
+      {
+        val = obj->values;
+      }
+      else
+      {
+	val.vox = WlzMakeVoxelValueTb(WLZ_VOXELVALUETABLE_GREY,
+				      bx->zMin, bx->zMax,
+				      WlzGetBackground(obj, NULL),
+				      NULL, &errNum);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  p0 = bx->zMin - obj->values.vox->plane1;
+	  for(p = 0; p <= bx->zMax - bx->zMin; ++p)
+	  {
+	    val.vox->values[p] = WlzAssignValues(
+	    			 obj->values.vox->values[p0 + p], NULL);
+	  }
+	}
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    cObj = WlzAssignObject(
+	   WlzMakeMain(obj->type, dom, val, NULL, NULL, &errNum), NULL);
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    if(val.core && (val.core != obj->values.core))
+    {
+      (void )WlzFreeVoxelValueTb(val.vox);
+    }
+    if(dom.core)
+    {
+      (void )WlzFreeDomain(dom);
+    }
+  }
+  *dstErr = errNum;
+  return(cObj);
+}
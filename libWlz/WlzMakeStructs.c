@@ -2365,6 +2365,58 @@ WlzContour	*WlzMakeContour(WlzErrorNum *dstErr)
   return(ctr);
 }
 
+/*!
+* \return	New indexed triangle mesh or NULL on error.
+* \ingroup	WlzAllocation
+* \brief	Makes a new indexed triangle mesh with space allocated
+*		for the given numbers of vertices and triangles.
+* \param	maxVtx			Number of vertices to allocate
+*					space for, may be zero.
+* \param	maxTri			Number of triangles to allocate
+*					space for, may be zero.
+* \param	dstErr			Destination error pointer, may
+*					be NULL.
+*/
+WlzIdxMesh3D	*WlzMakeIdxMesh3D(int maxVtx, int maxTri, WlzErrorNum *dstErr)
+{
+  WlzIdxMesh3D	*mesh = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((maxVtx < 0) || (maxTri < 0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((mesh = (WlzIdxMesh3D *)
+                  AlcCalloc(1, sizeof(WlzIdxMesh3D))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else if(((maxVtx > 0) &&
+           ((mesh->vtx = (WlzDVertex3 *)
+	                 AlcMalloc(maxVtx * sizeof(WlzDVertex3))) == NULL)) ||
+          ((maxTri > 0) &&
+	   ((mesh->tri = (int *)
+	                 AlcMalloc(3 * maxTri * sizeof(int))) == NULL)))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    mesh->maxVtx = maxVtx;
+    mesh->maxTri = maxTri;
+  }
+  else if(mesh)
+  {
+    (void )WlzFreeIdxMesh3D(mesh);
+    mesh = NULL;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(mesh);
+}
+
 /*!
 * \return	New index value table or NULL on error.
 * \ingroup	WlzAllocation
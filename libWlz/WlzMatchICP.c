@@ -121,7 +121,7 @@ typedef struct _WlzMatchICPTPPair2D
 } WlzMatchICPTPPair2D;
 
 static WlzErrorNum		WlzMatchICPRegShellLst(
-				  AlcKDTTree *tTree,
+				  AlcKDSTree *tTree,
 				  WlzGMModel *tGM,
 				  WlzGMModel *sGM,
 				  WlzMatchICPShellList *sLst,
@@ -148,9 +148,11 @@ static WlzErrorNum		WlzMatchICPRegShellLst(
 				  WlzRegICPUsrWgtFn usrWgtFn,
 				  void *usrWgtData,
 				  double delta,
-				  double minDistWgt);
+				  double minDistWgt,
+				  double subFrac,
+				  double trTol);
 static WlzAffineTransform 	*WlzMatchICPRegModel(
-				  AlcKDTTree *tTree,
+				  AlcKDSTree *tTree,
 				  WlzTransformType trType,
 				  WlzVertexType vType,
 				  int sgnNrm,
@@ -171,9 +173,11 @@ static WlzAffineTransform 	*WlzMatchICPRegModel(
 				  void *usrWgtData,
 				  double delta,
 				  double minDistWgt,
+				  double subFrac,
+				  double trTol,
 				  WlzErrorNum *dstErr);
 static WlzAffineTransform 	*WlzMatchICPRegShell(
-				  AlcKDTTree *tTree,
+				  AlcKDSTree *tTree,
 				  WlzGMModel *tGM,
 				  WlzGMShell *sS,
 				  WlzAffineTransform *globTr,
@@ -200,11 +204,13 @@ static WlzAffineTransform 	*WlzMatchICPRegShell(
 				  void *usrWgtData,
 				  double delta,
 				  double minDistWgt,
+				  double subFrac,
+				  double trTol,
 				  WlzErrorNum *dstErr);
 static int			WlzMatchICPGetPoints(
 				  WlzGMModel *tGM,
 				  WlzGMModel *sGM,
-				  AlcKDTTree *tTree,
+				  AlcKDSTree *tTree,
 				  WlzMatchICPShell *mS,
 				  int minSegSpx,
 				  double maxMnDisp,
@@ -219,7 +225,7 @@ static int			WlzMatchICPGetPoints(
 static int			WlzMatchICPGetPoints2D(
 				  WlzGMModel *tGM,
 				  WlzGMModel *sGM,
-				  AlcKDTTree *tTree,
+				  AlcKDSTree *tTree,
 				  WlzMatchICPShell *mS,
 				  int minSpx,
 				  double maxMnDisp,
@@ -287,7 +293,7 @@ static WlzErrorNum		WlzMatchICPFilterPtsRmDup2D(
 static int			WlzMatchICPGetMSPoints2D(
 				  WlzGMModel *tGM,
 				  WlzGMModel *sGM,
-				  AlcKDTTree *tTree,
+				  AlcKDSTree *tTree,
 				  WlzMatchICPShell *mS,
 				  WlzDVertex2 *tVx,
 				  int minSpx,
@@ -327,7 +333,7 @@ static int			WlzMatchICPDblSortFnD(
 				  int id1);
 static double			WlzMatchICPWeightMatches2D(
 				  WlzAffineTransform *curTr,
-				  AlcKDTTree *tree,
+				  AlcKDSTree *tree,
 				  WlzDVertex2 *tVx,
 				  WlzDVertex2 *sVx,
 				  WlzDVertex2 tMVx,
@@ -338,7 +344,7 @@ static double			WlzMatchICPWeightMatches2D(
 				  int nScatter);
 static double			WlzMatchICPWeightMatches3D(
 				  WlzAffineTransform *curTr,
-				  AlcKDTTree *tree,
+				  AlcKDSTree *tree,
 				  WlzDVertex3 *tVx,
 				  WlzDVertex3 *sVx,
 				  WlzDVertex3 tMVx,
@@ -443,6 +449,13 @@ static void			WlzMatchICPShellListElmUnlink(
 *					to be returned.
 * \param	delta			Tolerance for mean value of
 *					registration metric.
+* \param	subFrac			Initial fraction of the source
+*					vertices used in each registration,
+*					see WlzRegICPTreeAndVertices(). A
+*					value of 1.0 disables subsampling.
+* \param	trTol			Tolerance for the transform update,
+*					a value of 0.0 disables early
+*					termination.
 */
 WlzErrorNum	WlzMatchICPObjs(WlzObject *tObj, WlzObject *sObj,
 				WlzAffineTransform *initTr,
@@ -452,7 +465,7 @@ WlzErrorNum	WlzMatchICPObjs(WlzObject *tObj, WlzObject *sObj,
 				double maxDisp, double maxAng, 
 				double maxDeform,
 				int matchImpNN, double matchImpThr,
-				double delta)
+				double delta, double subFrac, double trTol)
 {
   WlzMatchICPWeightCbData cbData;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -510,7 +523,7 @@ WlzErrorNum	WlzMatchICPObjs(WlzObject *tObj, WlzObject *sObj,
 				      maxDisp, maxAng, maxDeform,
     				      matchImpNN, matchImpThr,
 				      WlzMatchICPWeightMatches, &cbData,
-				      delta);
+				      delta, subFrac, trTol);
 	      break;
 	    default:
 	      errNum = WLZ_ERR_DOMAIN_TYPE;
@@ -595,6 +608,13 @@ WlzErrorNum	WlzMatchICPObjs(WlzObject *tObj, WlzObject *sObj,
 * \param	usrWgtData		User supplied weighting data.
 * \param	delta			Tolerance for mean value of
 *					registration metric.
+* \param	subFrac			Initial fraction of the source
+*					vertices used in each registration,
+*					see WlzRegICPTreeAndVertices(). A
+*					value of 1.0 disables subsampling.
+* \param	trTol			Tolerance for the transform update,
+*					a value of 0.0 disables early
+*					termination.
 */
 WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
 			       WlzAffineTransform *initTr,
@@ -605,7 +625,7 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
 			       double maxDeform,
 			       int matchImpNN, double matchImpThr,
 			       WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
-			       double delta)
+			       double delta, double subFrac, double trTol)
 {
   int		idS,
 		n0,
@@ -635,7 +655,7 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
   WlzVertexType	vType,
   		tVType;
   WlzTransformType trType;
-  AlcKDTTree	*tTree = NULL;
+  AlcKDSTree	*tTree = NULL;
   WlzAffineTransform *tTr,
   		*globTr = NULL;
   WlzGMShell 	*cSS,
@@ -754,7 +774,7 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
   /* Build a kD-tree from the vertices of the the model. */
   if(errNum == WLZ_ERR_NONE)
   {
-    tTree = WlzVerticesBuildTree(vType, nTV, tVx, vIBuf, &errNum);
+    tTree = WlzVerticesBuildKDSTree(vType, nTV, tVx, &errNum);
   }
   /* Register the vertices of the source model to those of the target. */
   if(errNum == WLZ_ERR_NONE)
@@ -765,7 +785,7 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
 				 vIBuf, tVBuf, sVBuf, wBuf,
 				 maxItr, initTr, &convFlg,
 				 usrWgtFn, usrWgtData,
-				 delta, 0.25,
+				 delta, 0.25, subFrac, trTol,
 				 &errNum), NULL);
     if((errNum == WLZ_ERR_NONE) && (convFlg == 0))
     {
@@ -797,7 +817,7 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
 			        maxItr, maxDisp, maxAng, maxDeform,
 				globTr, &convFlg,
 				usrWgtFn, usrWgtData,
-				delta, 0.0, &errNum), NULL);
+				delta, 0.0, subFrac, trTol, &errNum), NULL);
       nSS = cSS->next;
       if((errNum == WLZ_ERR_NONE) && (convFlg == 1))
       {
@@ -890,7 +910,7 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
 		trType, vType, sgnNrm, nTV, tVx, tNr, nSV, sVx, sNr,
 		vIBuf, tVBuf, sVBuf, wBuf, maxItr,
 		maxDisp, maxAng, maxDeform, minSpx, tTr,
-		usrWgtFn, usrWgtData, delta, 0.0);
+		usrWgtFn, usrWgtData, delta, 0.0, subFrac, trTol);
 	  }
 	}
       }
@@ -954,7 +974,7 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
 	      trType, vType, sgnNrm, nTV, tVx, tNr, nSV, sVx, sNr,
 	      vIBuf, tVBuf, sVBuf, wBuf, maxItr,
 	      maxDisp, maxAng, maxDeform, minSpx, tTr,
-	      usrWgtFn, usrWgtData, delta, 0.0);
+	      usrWgtFn, usrWgtData, delta, 0.0, subFrac, trTol);
 	}
       }
       if(errNum == WLZ_ERR_NONE)
@@ -1056,7 +1076,7 @@ WlzErrorNum  	WlzMatchICPCtr(WlzContour *tCtr, WlzContour *sCtr,
   AlcFree(sVx.v);
   AlcFree(sNr.v);
   (void )WlzFreeAffineTransform(globTr);
-  (void )AlcKDTTreeFree(tTree);
+  (void )AlcKDSTreeFree(tTree);
 
   return(errNum);
 }
@@ -1121,7 +1141,7 @@ static WlzErrorNum WlzMatchICPMoveListElmToQueue(AlcCPQQueue *queue,
 */
 double		WlzMatchICPWeightMatches(WlzVertexType vType,
 					 WlzAffineTransform *curTr,
-					 AlcKDTTree *tree,
+					 AlcKDSTree *tree,
 					 WlzVertexP tVx, WlzVertexP sVx,
 					 WlzVertex tMVx, WlzVertex sMVx,
 					 double wVx, double wNr,
@@ -1203,8 +1223,13 @@ double		WlzMatchICPWeightMatches(WlzVertexType vType,
 * \param	delta			Tolerance for mean value of
 *					registration metric.
 * \param	minDistWgt		Minimum distance weight.
+* \param	subFrac			Initial fraction of the source
+*					vertices used, see
+*					WlzRegICPTreeAndVertices().
+* \param	trTol			Tolerance for the transform update,
+*					see WlzRegICPTreeAndVertices().
 */
-static WlzErrorNum	WlzMatchICPRegShellLst(AlcKDTTree *tTree,
+static WlzErrorNum	WlzMatchICPRegShellLst(AlcKDSTree *tTree,
 				WlzGMModel *tGM,
 				WlzGMModel *sGM,
 				WlzMatchICPShellList *sLst,
@@ -1219,7 +1244,8 @@ static WlzErrorNum	WlzMatchICPRegShellLst(AlcKDTTree *tTree,
 				double maxDeform, int minSpx,
 				WlzAffineTransform *gInitTr,
 				WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
-				double delta, double minDistWgt)
+				double delta, double minDistWgt,
+				double subFrac, double trTol)
 {
   int		convFlg,
   		remFlg;
@@ -1248,7 +1274,7 @@ static WlzErrorNum	WlzMatchICPRegShellLst(AlcKDTTree *tTree,
 			        maxItr, maxDisp, maxAng, maxDeform,
 				initTr, &convFlg,
 				usrWgtFn, usrWgtData,
-				delta, minDistWgt, &errNum),
+				delta, minDistWgt, subFrac, trTol, &errNum),
 	    NULL);
       remFlg = !convFlg;
       if(errNum == WLZ_ERR_ALG_CONVERGENCE)
@@ -1325,10 +1351,15 @@ static WlzErrorNum	WlzMatchICPRegShellLst(AlcKDTTree *tTree,
 * \param	delta			Tolerance for mean value of
 *					registration metric.
 * \param	minDistWgt		Minimum distance weight.
+* \param	subFrac			Initial fraction of the source
+*					vertices used, see
+*					WlzRegICPTreeAndVertices().
+* \param	trTol			Tolerance for the transform update,
+*					see WlzRegICPTreeAndVertices().
 * \param	dstErr			Destination error pointer,
 *					may be NULL.
 */
-static WlzAffineTransform *WlzMatchICPRegModel(AlcKDTTree *tTree,
+static WlzAffineTransform *WlzMatchICPRegModel(AlcKDSTree *tTree,
 				WlzTransformType trType,
 				WlzVertexType vType, int sgnNrm,
 				int nTV, WlzVertexP tVx, WlzVertexP tNr,
@@ -1338,6 +1369,7 @@ static WlzAffineTransform *WlzMatchICPRegModel(AlcKDTTree *tTree,
 				WlzAffineTransform *initTr, int *dstConv,
 				WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
 				double delta, double minDistWgt,
+				double subFrac, double trTol,
 				WlzErrorNum *dstErr)
 {
   int		idV,
@@ -1353,7 +1385,7 @@ static WlzAffineTransform *WlzMatchICPRegModel(AlcKDTTree *tTree,
   			     nTV, tVx, tNr, nSV, iBuf, sVx, sNr,
 			     tVBuf, sVBuf, wBuf, maxItr, initTr,
 			     &conv, usrWgtFn, usrWgtData,
-			     delta, minDistWgt, &errNum);
+			     delta, minDistWgt, subFrac, trTol, &errNum);
   if(dstConv)
   {
     *dstConv = conv;
@@ -1412,10 +1444,15 @@ static WlzAffineTransform *WlzMatchICPRegModel(AlcKDTTree *tTree,
 * \param	delta			Tolerance for mean value of
 *					registration metric.
 * \param	minDistWgt		Minimum distance weight.
+* \param	subFrac			Initial fraction of the source
+*					vertices used, see
+*					WlzRegICPTreeAndVertices().
+* \param	trTol			Tolerance for the transform update,
+*					see WlzRegICPTreeAndVertices().
 * \param	dstErr			Destination error pointer,
 *					may be NULL.
 */
-static WlzAffineTransform *WlzMatchICPRegShell(AlcKDTTree *tTree,
+static WlzAffineTransform *WlzMatchICPRegShell(AlcKDSTree *tTree,
 				WlzGMModel *tGM, WlzGMShell *sS,
 				WlzAffineTransform *globTr,
 				WlzTransformType trType,
@@ -1430,6 +1467,7 @@ static WlzAffineTransform *WlzMatchICPRegShell(AlcKDTTree *tTree,
 				WlzAffineTransform *initTr, int *dstConv,
 				WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
 				double delta, double minDistWgt,
+				double subFrac, double trTol,
 				WlzErrorNum *dstErr)
 {
   int		nSSV,
@@ -1495,7 +1533,7 @@ static WlzAffineTransform *WlzMatchICPRegShell(AlcKDTTree *tTree,
 			  tVBuf, sVBuf, wBuf,
 			  maxItr, initTr, &conv,
 			  usrWgtFn, usrWgtData,
-			  delta, minDistWgt, &errNum);
+			  delta, minDistWgt, subFrac, trTol, &errNum);
   if((errNum == WLZ_ERR_ALG_CONVERGENCE) && (conv == 0))
   {
     /* Failure to register a shell is not an error if the shell is
@@ -1543,7 +1581,7 @@ static WlzAffineTransform *WlzMatchICPRegShell(AlcKDTTree *tTree,
 *					may be NULL.
 */
 static int	WlzMatchICPGetPoints(WlzGMModel *tGM, WlzGMModel *sGM,
-				     AlcKDTTree *tTree, WlzMatchICPShell *mS,
+				     AlcKDSTree *tTree, WlzMatchICPShell *mS,
 				     int minSegSpx, double maxMnDisp,
 				     WlzVertexType vType, WlzVertexP tVx,
 				     WlzVertexP tNr, WlzVertexP sNr,
@@ -1605,7 +1643,7 @@ static int	WlzMatchICPGetPoints(WlzGMModel *tGM, WlzGMModel *sGM,
 *					may be NULL.
 */
 static int	WlzMatchICPGetPoints2D(WlzGMModel *tGM, WlzGMModel *sGM,
-				       AlcKDTTree *tTree, WlzMatchICPShell *mS,
+				       AlcKDSTree *tTree, WlzMatchICPShell *mS,
 				       int minSegSpx, double maxMnDisp,
 				       WlzDVertex2 *tVx, 
 				       WlzDVertex2 *tNr, WlzDVertex2 *sNr,
@@ -1621,7 +1659,7 @@ static int	WlzMatchICPGetPoints2D(WlzGMModel *tGM, WlzGMModel *sGM,
   		tSV;
   double	cDist;
   double	vxD2[2];
-  AlcKDTNode	*tNode;
+  size_t	tIdx;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   if(mS && ((sS = mS->shell) != NULL) && (sS->child == sS->child->next))
@@ -1641,9 +1679,10 @@ static int	WlzMatchICPGetPoints2D(WlzGMModel *tGM, WlzGMModel *sGM,
       tSV = WlzAffineTransformVertexD2(mS->tr, sV, NULL);
       vxD2[0] = tSV.vtX;
       vxD2[1] = tSV.vtY;
-      tNode = AlcKDTGetNN(tTree, vxD2, DBL_MAX, &cDist, NULL);
+      tIdx = AlcKDSGetNN(tTree, vxD2, DBL_MAX, &cDist, NULL);
+      if(tIdx != ALC_KDS_IDX_NONE)
       {
-        tV = *(tVx + tNode->idx);
+        tV = *(tVx + tIdx);
 	*(sMatch + 0) = sV;
 	*(tMatch + 0) = tV;
         nMatch = 1;
@@ -1687,7 +1726,7 @@ static int	WlzMatchICPGetPoints2D(WlzGMModel *tGM, WlzGMModel *sGM,
 					may be NULL.
 */
 static int	WlzMatchICPGetMSPoints2D(WlzGMModel *tGM, WlzGMModel *sGM,
-				AlcKDTTree *tTree,
+				AlcKDSTree *tTree,
 				WlzMatchICPShell *mS, WlzDVertex2 *tVx,
 				int minSegSpx, double maxMnDisp,
 				WlzDVertex2 *sMatch,
@@ -1711,7 +1750,7 @@ static int	WlzMatchICPGetMSPoints2D(WlzGMModel *tGM, WlzGMModel *sGM,
   WlzGMEdgeT	*fET,
   		*lET,
 		*tET0;
-  AlcKDTNode	*tNode;
+  size_t	tIdx;
   double	vxD2[2];
   WlzDVertex2	sPos,
   		tSPos,
@@ -1759,11 +1798,11 @@ static int	WlzMatchICPGetMSPoints2D(WlzGMModel *tGM, WlzGMModel *sGM,
 	tSPos = WlzAffineTransformVertexD2(mS->tr, sPos, NULL);
 	vxD2[0] = tSPos.vtX;
 	vxD2[1] = tSPos.vtY;
-	tNode = AlcKDTGetNN(tTree, vxD2, DBL_MAX, &d, NULL);
-	if(tNode)
+	tIdx = AlcKDSGetNN(tTree, vxD2, DBL_MAX, &d, NULL);
+	if(tIdx != ALC_KDS_IDX_NONE)
 	{
 	  dist += d;
-	  tPos = *(tVx + tNode->idx);
+	  tPos = *(tVx + tIdx);
 	  tV = WlzGMModelMatchVertexG2D(tGM, tPos);
 	  if(tV == NULL)
 	  {
@@ -2872,7 +2911,7 @@ static WlzErrorNum WlzMatchICPRemoveVertices(WlzMatchICPCbData *cbData,
 *					sensitivity.
 */
 static double	WlzMatchICPWeightMatches2D(WlzAffineTransform *curTr,
-				       	AlcKDTTree *tree,
+				       	AlcKDSTree *tree,
 				       	WlzDVertex2 *tVx, WlzDVertex2 *sVx,
 					WlzDVertex2 tMVx, WlzDVertex2 sMVx,
 				       	WlzGMModel *tGM, WlzGMModel *sGM,
@@ -2890,7 +2929,7 @@ static double	WlzMatchICPWeightMatches2D(WlzAffineTransform *curTr,
   		*tMS0;
   WlzGMVertex	*tMV,
   		*tMV0;
-  AlcKDTNode	*tNode;
+  size_t	tIdx;
   double	vxD[2];
   const double	delta = 5.0; /* TODO Make delta a parameter. */
 
@@ -2914,9 +2953,10 @@ static double	WlzMatchICPWeightMatches2D(WlzAffineTransform *curTr,
       * target model. */
       vxD[0] = sMTVx0.vtX;
       vxD[1] = sMTVx0.vtY;
-      if((tNode = AlcKDTGetNN(tree, vxD, DBL_MAX, NULL, NULL)) != NULL)
+      if((tIdx = AlcKDSGetNN(tree, vxD, DBL_MAX, NULL, NULL)) !=
+          ALC_KDS_IDX_NONE)
       {
-	tMVx0 = *(tVx + tNode->idx);
+	tMVx0 = *(tVx + tIdx);
 	tMV0 = WlzGMModelMatchVertexG2D(tGM, tMVx0);
 	if(tMV0)
 	{
@@ -2971,7 +3011,7 @@ static double	WlzMatchICPWeightMatches2D(WlzAffineTransform *curTr,
 *					sensitivity.
 */
 static double	WlzMatchICPWeightMatches3D(WlzAffineTransform *curTr,
-				       	AlcKDTTree *tree,
+				       	AlcKDSTree *tree,
 				       	WlzDVertex3 *tVx, WlzDVertex3 *sVx,
 					WlzDVertex3 tMVx, WlzDVertex3 sMVx,
 				       	WlzGMModel *tGM, WlzGMModel *sGM,
@@ -190,7 +190,7 @@ static WlzObject *WlzObjToBoundaryPrv(
       break;
 
     case WLZ_TRANS_OBJ:
-      if( (bobj = WlzObjToBoundary(obj->values.obj, wrap, &errNum))
+      if( (bobj = WlzObjToBoundaryPrv(obj->values.obj, wrap, &errNum))
 	 == NULL ){
 	break;
       }
@@ -240,7 +240,7 @@ static WlzObject *WlzObjToBoundaryPrv(
 	      if( (*domains).core ){
 		if( (obj1 = WlzMakeMain(objType, *domains, values,
 					NULL, NULL, &errNum)) &&
-		   (obj2 = WlzObjToBoundary(obj1, wrap, &errNum)) ){
+		   (obj2 = WlzObjToBoundaryPrv(obj1, wrap, &errNum)) ){
 		  *rtnDomains = WlzAssignDomain(obj2->domain, NULL);
 		  WlzFreeObj(obj2);
 		  WlzFreeObj(obj1);
@@ -0,0 +1,661 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzObjectCache_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzObjectCache.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+* 
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	A shared, size bounded cache of objects read from files.
+* 		Objects are identified by their file path, size and
+* 		modification time and are held in a least recent use
+* 		removal cache
+* 		(see AlcLRUCacheNew()) which is limited both by the number
+* 		of objects and by the total size of their domains and
+* 		values.
+* \ingroup	WlzIO
+*/
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <string.h>
+#include <Wlz.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \def		WLZ_OBJECTCACHE_MTIME_NS
+* \ingroup	WlzIO
+* \brief	Nanoseconds of the modification time of the given file
+* 		status, zero where this is not available.
+*/
+#if defined (DARWIN)
+#define WLZ_OBJECTCACHE_MTIME_NS(S) ((long )((S).st_mtimespec.tv_nsec))
+#elif defined (_WIN32) || defined (__MINGW32__)
+#define WLZ_OBJECTCACHE_MTIME_NS(S) (0L)
+#else
+#define WLZ_OBJECTCACHE_MTIME_NS(S) ((long )((S).st_mtim.tv_nsec))
+#endif
+
+/*!
+* \struct	_WlzObjectCacheEntry
+* \ingroup	WlzIO
+* \brief	An entry of a ::WlzObjectCache.
+* 		Typedef: ::WlzObjectCacheEntry.
+*/
+typedef struct _WlzObjectCacheEntry
+{
+  char		*path;			/*!< File path of the object. */
+  time_t	mtime;			/*!< Modification time of the file
+  					     when the object was read. */
+  long		mtimeNs;		/*!< Nanoseconds of the modification
+  					     time. */
+  off_t		fileSz;			/*!< Size of the file when the
+  					     object was read. */
+  size_t	sz;			/*!< Size charged for the entry. */
+  WlzObject	*obj;			/*!< The object, one link to which
+  					     is owned by the cache. */
+} WlzObjectCacheEntry;
+
+static int			WlzObjectCacheCmpFn(
+				  const void *e0,
+				  const void *e1);
+static unsigned int 		WlzObjectCacheKeyFn(
+				  AlcLRUCache *lru,
+				  void *e);
+static void			WlzObjectCacheUnlinkFn(
+				  AlcLRUCache *lru,
+				  void *e);
+static size_t			WlzObjectCacheObjSz(
+				  WlzObject *obj,
+				  WlzErrorNum *dstErr);
+static size_t			WlzObjectCacheValSz(
+				  WlzValues val,
+				  WlzErrorNum *dstErr);
+static int			WlzObjectCacheFileCmp(
+				  WlzObjectCacheEntry *ent,
+				  struct stat *statBuf);
+static void			WlzObjectCacheLock(
+				  WlzObjectCache *cache);
+static void			WlzObjectCacheUnlock(
+				  WlzObjectCache *cache);
+
+/*!
+* \return	New object cache or NULL on error.
+* \ingroup	WlzIO
+* \brief	Creates a new object cache which maps file paths (along
+* 		with the file's size and modification time) to objects.
+* 		The cache should be freed using WlzObjectCacheFree().
+* \param	maxItem			Maximum number of objects in the
+* 					cache, must be greater than zero.
+* \param	maxSz			Maximum total size (bytes) of the
+* 					cached objects, zero for no limit.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObjectCache	*WlzObjectCacheNew(unsigned int maxItem, size_t maxSz,
+				   WlzErrorNum *dstErr)
+{
+  WlzObjectCache *cache = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(maxItem == 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((cache = (WlzObjectCache *)
+                   AlcCalloc(1, sizeof(WlzObjectCache))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else if((cache->lru = AlcLRUCacheNew(maxItem, maxSz,
+                                       WlzObjectCacheKeyFn,
+				       WlzObjectCacheCmpFn,
+				       WlzObjectCacheUnlinkFn, NULL)) == NULL)
+  {
+    AlcFree(cache);
+    cache = NULL;
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+#ifdef _OPENMP
+  else if((cache->lock = AlcMalloc(sizeof(omp_lock_t))) == NULL)
+  {
+    AlcLRUCacheFree(cache->lru, 1);
+    AlcFree(cache);
+    cache = NULL;
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    omp_init_lock((omp_lock_t *)(cache->lock));
+  }
+#endif
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(cache);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Frees an object cache, unlinking all the objects in it.
+* 		Objects previously returned by WlzObjectCacheGet() remain
+* 		valid until they are freed by the caller.
+* \param	cache			The object cache.
+*/
+WlzErrorNum	WlzObjectCacheFree(WlzObjectCache *cache)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(cache == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    AlcLRUCacheFree(cache->lru, 1);
+#ifdef _OPENMP
+    if(cache->lock)
+    {
+      omp_destroy_lock((omp_lock_t *)(cache->lock));
+      AlcFree(cache->lock);
+    }
+#endif
+    AlcFree(cache);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Object read from the given file or NULL on error.
+* \ingroup	WlzIO
+* \brief	Gets the object read from the given file, using the cache
+* 		when the file has not been modified since the object was
+* 		read, ie when neither it's size nor it's modification time
+* 		(including nanoseconds where available) has changed.
+* 		On a cache miss the object is read using WlzReadObj() and
+* 		added to the cache, which may evict the least recently
+* 		used objects. Cache entries are charged the byte size of
+* 		their interval domains and value tables.
+*
+* 		The returned object has been assigned and must be freed
+* 		by the caller using WlzFreeObj(). As it may be shared
+* 		with other callers it must not be modified.
+*
+* 		When built with OpenMP this function may be called
+* 		concurrently from multiple OpenMP threads, each cache
+* 		having it's own OpenMP lock. Without OpenMP the cache is
+* 		not thread safe. Files are read without holding the lock
+* 		so that a miss does not block hits on other objects.
+* \param	cache			The object cache.
+* \param	path			File path of the object.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzObjectCacheGet(WlzObjectCache *cache, const char *path,
+				   WlzErrorNum *dstErr)
+{
+  int		hit = 0;
+  FILE		*fP = NULL;
+  WlzObject	*obj = NULL,
+  		*rtnObj = NULL;
+  WlzObjectCacheEntry *ent = NULL;
+  struct stat	statBuf;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((cache == NULL) || (path == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(stat(path, &statBuf) != 0)
+  {
+    errNum = WLZ_ERR_FILE_OPEN;
+  }
+  else
+  {
+    WlzObjectCacheEntry key;
+
+    key.path = (char *)path;
+    WlzObjectCacheLock(cache);
+    ent = (WlzObjectCacheEntry *)AlcLRUCEntryGet(cache->lru, &key);
+    if(ent)
+    {
+      if(WlzObjectCacheFileCmp(ent, &statBuf) == 0)
+      {
+	hit = 1;
+	++(cache->hits);
+	rtnObj = WlzAssignObject(ent->obj, NULL);
+      }
+      else
+      {
+	/* The file has been modified since it was read. */
+	AlcLRUCEntryRemove(cache->lru, &key);
+      }
+    }
+    if(!hit)
+    {
+      ++(cache->misses);
+    }
+    WlzObjectCacheUnlock(cache);
+    ent = NULL;
+  }
+  if((errNum == WLZ_ERR_NONE) && !hit)
+  {
+    if((fP = fopen(path, "r")) == NULL)
+    {
+      errNum = WLZ_ERR_FILE_OPEN;
+    }
+    else
+    {
+      obj = WlzAssignObject(WlzReadObj(fP, &errNum), NULL);
+      (void )fclose(fP);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if(((ent = (WlzObjectCacheEntry *)
+                 AlcCalloc(1, sizeof(WlzObjectCacheEntry))) == NULL) ||
+	 ((ent->path = AlcStrDup(path)) == NULL))
+      {
+	errNum = WLZ_ERR_MEM_ALLOC;
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      ent->mtime = statBuf.st_mtime;
+      ent->mtimeNs = WLZ_OBJECTCACHE_MTIME_NS(statBuf);
+      ent->fileSz = statBuf.st_size;
+      ent->sz = WlzObjectCacheObjSz(obj, &errNum);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      int	newFlg = 0;
+      unsigned int n0;
+      AlcLRUCItem *item;
+
+      ent->obj = WlzAssignObject(obj, NULL);
+      WlzObjectCacheLock(cache);
+      n0 = cache->lru->numItem;
+      item = AlcLRUCEntryAdd(cache->lru, ent->sz, ent, &newFlg);
+      if(item && !newFlg &&
+	 (WlzObjectCacheFileCmp((WlzObjectCacheEntry *)(item->entry),
+				&statBuf) < 0))
+      {
+	/* Another thread has cached an older version of the file, replace
+	 * it so that there is only ever one entry for a path. */
+	AlcLRUCEntryRemove(cache->lru, ent);
+	n0 = cache->lru->numItem;
+	item = AlcLRUCEntryAdd(cache->lru, ent->sz, ent, &newFlg);
+      }
+      if(newFlg)
+      {
+	cache->evictions += n0 + 1 - cache->lru->numItem;
+	ent = NULL;
+      }
+      else if(item)
+      {
+	/* Another thread has read and cached the same (or a newer)
+	 * version of the object, use it in preference to this one. */
+	(void )WlzFreeObj(obj);
+	obj = WlzAssignObject(((WlzObjectCacheEntry *)(item->entry))->obj,
+			      NULL);
+      }
+      rtnObj = WlzAssignObject(obj, NULL);
+      WlzObjectCacheUnlock(cache);
+    }
+    /* Free the entry if it was not added to the cache and release this
+     * function's link to the object. */
+    if(ent)
+    {
+      (void )WlzFreeObj(ent->obj);
+      AlcFree(ent->path);
+      AlcFree(ent);
+    }
+    (void )WlzFreeObj(obj);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rtnObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Gets the current statistics of an object cache. Any of
+* 		the destination pointers may be NULL.
+* \param	cache			The object cache.
+* \param	dstHits			Destination pointer for the number
+* 					of cache hits.
+* \param	dstMisses		Destination pointer for the number
+* 					of cache misses.
+* \param	dstEvictions		Destination pointer for the number
+* 					of objects evicted to keep within
+* 					the cache limits.
+* \param	dstNumItem		Destination pointer for the current
+* 					number of cached objects.
+* \param	dstSz			Destination pointer for the current
+* 					total size of the cached objects.
+*/
+WlzErrorNum	WlzObjectCacheStats(WlzObjectCache *cache,
+				    WlzLong *dstHits, WlzLong *dstMisses,
+				    WlzLong *dstEvictions,
+				    unsigned int *dstNumItem, size_t *dstSz)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(cache == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    WlzObjectCacheLock(cache);
+    if(dstHits)
+    {
+      *dstHits = cache->hits;
+    }
+    if(dstMisses)
+    {
+      *dstMisses = cache->misses;
+    }
+    if(dstEvictions)
+    {
+      *dstEvictions = cache->evictions;
+    }
+    if(dstNumItem)
+    {
+      *dstNumItem = cache->lru->numItem;
+    }
+    if(dstSz)
+    {
+      *dstSz = cache->lru->curSz;
+    }
+    WlzObjectCacheUnlock(cache);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Non-zero value if the cache entries are different.
+* \ingroup	WlzIO
+* \brief	Compares the file paths of the given cache entries which
+* 		are cast to (WlzObjectCacheEntry *). Modification times
+* 		are not compared so that there is at most one entry for
+* 		any file path.
+* \param	e0			First cache entry pointer.
+* \param	e1			Second cache entry pointer.
+*/
+static int	WlzObjectCacheCmpFn(const void *e0, const void *e1)
+{
+  int		cmp;
+
+  cmp = strcmp(((const WlzObjectCacheEntry *)e0)->path,
+               ((const WlzObjectCacheEntry *)e1)->path);
+  return(cmp);
+}
+
+/*!
+* \return	Numeric key for the entry.
+* \ingroup	WlzIO
+* \brief	Computes a hash key from the file path of the given
+* 		cache entry.
+* \param	lru			The cache (not used).
+* \param	e			Cast to (WlzObjectCacheEntry *) to
+* 					get the cache entry.
+*/
+static unsigned int WlzObjectCacheKeyFn(AlcLRUCache *lru, void *e)
+{
+  unsigned int	key;
+
+  key = AlcStrSFHash(((WlzObjectCacheEntry *)e)->path);
+  return(key);
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Called when an entry is about to be removed from the
+* 		cache, this function frees the cache's link to the entry's
+* 		object and then the entry itself.
+* \param	lru			The cache (not used).
+* \param	e			Cast to (WlzObjectCacheEntry *) to
+* 					get the cache entry.
+*/
+static void	WlzObjectCacheUnlinkFn(AlcLRUCache *lru, void *e)
+{
+  WlzObjectCacheEntry *ent;
+
+  if((ent = (WlzObjectCacheEntry *)e) != NULL)
+  {
+    (void )WlzFreeObj(ent->obj);
+    AlcFree(ent->path);
+    AlcFree(ent);
+  }
+}
+
+/*!
+* \return	Size in bytes.
+* \ingroup	WlzIO
+* \brief	Computes the size charged to a cache entry for the given
+* 		object. This is the size of the object's intervals and
+* 		grey values.
+* \param	obj			Given object.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static size_t	WlzObjectCacheObjSz(WlzObject *obj, WlzErrorNum *dstErr)
+{
+  int		pIdx;
+  WlzLong	nItv = 0;
+  size_t	sz = sizeof(WlzObject);
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(obj->type)
+  {
+    case WLZ_2D_DOMAINOBJ: /* FALLTHROUGH */
+    case WLZ_3D_DOMAINOBJ:
+      if(obj->domain.core == NULL)
+      {
+        errNum = WLZ_ERR_DOMAIN_NULL;
+      }
+      else
+      {
+        nItv = WlzIntervalCountObj(obj, &errNum);
+	sz += nItv * sizeof(WlzInterval);
+      }
+      if((errNum == WLZ_ERR_NONE) && (obj->values.core != NULL))
+      {
+	if((obj->type == WLZ_2D_DOMAINOBJ) ||
+	   WlzGreyTableIsTiled(obj->values.core->type))
+	{
+	  sz += WlzObjectCacheValSz(obj->values, &errNum);
+	}
+	else
+	{
+	  WlzVoxelValues *vox;
+
+	  vox = obj->values.vox;
+	  for(pIdx = 0; (errNum == WLZ_ERR_NONE) &&
+	                (pIdx <= vox->lastpl - vox->plane1); ++pIdx)
+	  {
+	    if(vox->values[pIdx].core)
+	    {
+	      sz += WlzObjectCacheValSz(vox->values[pIdx], &errNum);
+	    }
+	  }
+	}
+      }
+      break;
+    default:
+      break;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(sz);
+}
+
+/*!
+* \return	Size in bytes.
+* \ingroup	WlzIO
+* \brief	Computes the size of the grey values of the given 2D or
+* 		tiled value table.
+* \param	val			Given value table.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static size_t	WlzObjectCacheValSz(WlzValues val, WlzErrorNum *dstErr)
+{
+  int		lIdx,
+  		iIdx,
+		nLn;
+  size_t	nVal = 0;
+  WlzGreyType	gType;
+  WlzObjectType	tType = WLZ_NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  gType = WlzGreyTableTypeToGreyType(val.core->type, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tType = WlzGreyTableTypeToTableType(val.core->type, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(tType)
+    {
+      case WLZ_GREY_TAB_RAGR:
+	nLn = val.v->lastln - val.v->line1 + 1;
+	for(lIdx = 0; lIdx < nLn; ++lIdx)
+	{
+	  WlzValueLine *vLn;
+
+	  vLn = val.v->vtblines + lIdx;
+	  if(vLn->vlastkl >= vLn->vkol1)
+	  {
+	    nVal += vLn->vlastkl - vLn->vkol1 + 1;
+	  }
+	}
+	break;
+      case WLZ_GREY_TAB_RECT:
+	nVal = (size_t )(val.r->width) * (val.r->lastln - val.r->line1 + 1);
+	break;
+      case WLZ_GREY_TAB_INTL:
+	nLn = val.i->lastln - val.i->line1 + 1;
+	for(lIdx = 0; lIdx < nLn; ++lIdx)
+	{
+	  WlzValueIntervalLine *vil;
+
+	  vil = val.i->vil + lIdx;
+	  for(iIdx = 0; iIdx < vil->nintvs; ++iIdx)
+	  {
+	    nVal += vil->vtbint[iIdx].vlastkl - vil->vtbint[iIdx].vkol1 + 1;
+	  }
+	}
+	break;
+      case WLZ_GREY_TAB_TILED:
+	nVal = val.t->numTiles * val.t->tileSz;
+	break;
+      default:
+	errNum = WLZ_ERR_VALUES_TYPE;
+	break;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(nVal * WlzGreySize(gType));
+}
+
+/*!
+* \return	Zero if the file is unchanged since the object of the
+* 		cache entry was read, negative if the entry is for an
+* 		older version of the file and positive otherwise.
+* \ingroup	WlzIO
+* \brief	Compares the modification time and size of the file from
+* 		which the object of the given cache entry was read with
+* 		the given file status. Entries with the same modification
+* 		time but a different size are taken to be older so that
+* 		they are replaced.
+* \param	ent			Given cache entry.
+* \param	statBuf			Current status of the file.
+*/
+static int	WlzObjectCacheFileCmp(WlzObjectCacheEntry *ent,
+				      struct stat *statBuf)
+{
+  int		cmp = 0;
+  long		ns;
+
+  ns = WLZ_OBJECTCACHE_MTIME_NS(*statBuf);
+  if(ent->mtime != statBuf->st_mtime)
+  {
+    cmp = (ent->mtime < statBuf->st_mtime)? -1: 1;
+  }
+  else if(ent->mtimeNs != ns)
+  {
+    cmp = (ent->mtimeNs < ns)? -1: 1;
+  }
+  else if(ent->fileSz != statBuf->st_size)
+  {
+    cmp = -1;
+  }
+  return(cmp);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzIO
+* \brief	Acquires the given cache's lock, this does nothing when
+* 		built without OpenMP.
+* \param	cache			The object cache.
+*/
+static void	WlzObjectCacheLock(WlzObjectCache *cache)
+{
+#ifdef _OPENMP
+  omp_set_lock((omp_lock_t *)(cache->lock));
+#endif
+}
+
+/*!
+* \return	void
+* \ingroup	WlzIO
+* \brief	Releases the given cache's lock, this does nothing when
+* 		built without OpenMP.
+* \param	cache			The object cache.
+*/
+static void	WlzObjectCacheUnlock(WlzObjectCache *cache)
+{
+#ifdef _OPENMP
+  omp_unset_lock((omp_lock_t *)(cache->lock));
+#endif
+}
@@ -0,0 +1,874 @@
+#if defined(__GNUC__)
+#ident "University of Edinburgh $Id$"
+#else
+static char _WlzPlaneStream_c[] = "University of Edinburgh $Id$";
+#endif
+/*!
+* \file         libWlz/WlzPlaneStream.c
+* \author       agent
+* \date         October 2026
+* \version      $Id$
+* \par
+* Address:
+*               MRC Human Genetics Unit,
+*               MRC Institute of Genetics and Molecular Medicine,
+*               University of Edinburgh,
+*               Western General Hospital,
+*               Edinburgh, EH4 2XU, UK.
+* \par
+* Copyright (C), [2026],
+* The University Court of the University of Edinburgh,
+* Old College, Edinburgh, UK.
+*
+* This program is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be
+* useful but WITHOUT ANY WARRANTY; without even the implied
+* warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+* PURPOSE.  See the GNU General Public License for more
+* details.
+*
+* You should have received a copy of the GNU General Public
+* License along with this program; if not, write to the Free
+* Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+* Boston, MA  02110-1301, USA.
+* \brief	Sliding window processing of 3D domain objects which are
+* 		read and written one plane at a time, allowing objects
+* 		which are larger than the available memory to be filtered.
+* \ingroup	WlzIO
+*/
+
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+#include <Wlz.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \struct	_WlzPlaneStreamGaussPrm
+* \ingroup	WlzIO
+* \brief	Parameters of the streamed Gaussian filter.
+*		Typedef: ::WlzPlaneStreamGaussPrm.
+*/
+typedef struct _WlzPlaneStreamGaussPrm
+{
+  WlzDVertex3	sigma;			/*!< Gaussian sigma values. */
+  WlzIVertex3	order;			/*!< Derivative orders. */
+} WlzPlaneStreamGaussPrm;
+
+/*!
+* \struct	_WlzPlaneStreamRankPrm
+* \ingroup	WlzIO
+* \brief	Parameters of the streamed rank filter.
+*		Typedef: ::WlzPlaneStreamRankPrm.
+*/
+typedef struct _WlzPlaneStreamRankPrm
+{
+  int		fSz;			/*!< Filter size. */
+  double	rank;			/*!< Required rank. */
+} WlzPlaneStreamRankPrm;
+
+/*!
+* \struct	_WlzPlaneStreamThrPrm
+* \ingroup	WlzIO
+* \brief	Parameters of the streamed threshold.
+*		Typedef: ::WlzPlaneStreamThrPrm.
+*/
+typedef struct _WlzPlaneStreamThrPrm
+{
+  WlzPixelV	thrV;			/*!< Threshold value. */
+  WlzThresholdType hilo;		/*!< Threshold type. */
+} WlzPlaneStreamThrPrm;
+
+static WlzObject		*WlzPlaneStreamWindow(
+				  WlzObject *obj,
+				  int pl0,
+				  int pl1,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzPlaneStreamPlaneObj(
+				  WlzObject *obj,
+				  int pl,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzPlaneStreamExtract(
+				  WlzObject *obj,
+				  int pl0,
+				  int pl1,
+				  WlzObject **dst);
+static WlzErrorNum		WlzPlaneStreamReadTo(
+				  WlzPlaneStream *str,
+				  int idP);
+static WlzErrorNum		WlzPlaneStreamCompute(
+				  WlzPlaneStream *str,
+				  int idP0,
+				  int idP1,
+				  int rad,
+				  WlzPlaneStreamFn fn,
+				  void *fnData,
+				  WlzObject **dst);
+static WlzErrorNum		WlzPlaneStreamWriteN(
+				  WlzPlaneStream *str,
+				  int nPl,
+				  WlzObject **buf);
+static void			WlzPlaneStreamRelease(
+				  WlzPlaneStream *str,
+				  int idP0,
+				  int idP1);
+static WlzErrorNum		WlzPlaneStreamFile(
+				  FILE *inFP,
+				  FILE *outFP,
+				  int defDom,
+				  int nWin,
+				  int rad,
+				  WlzPlaneStreamFn fn,
+				  void *fnData);
+static WlzErrorNum		WlzPlaneStreamGaussFn(
+				  WlzObject *win,
+				  int pl0,
+				  int pl1,
+				  WlzObject **dst,
+				  void *data);
+static WlzErrorNum		WlzPlaneStreamRankFn(
+				  WlzObject *win,
+				  int pl0,
+				  int pl1,
+				  WlzObject **dst,
+				  void *data);
+static WlzErrorNum		WlzPlaneStreamThresholdFn(
+				  WlzObject *win,
+				  int pl0,
+				  int pl1,
+				  WlzObject **dst,
+				  void *data);
+static WlzErrorNum		WlzPlaneStreamScalarFnFn(
+				  WlzObject *win,
+				  int pl0,
+				  int pl1,
+				  WlzObject **dst,
+				  void *data);
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Reads planes from an input plane stream, applies a window
+* 		operator to them and writes the resulting planes to an
+* 		output plane stream, with at most a window of planes
+* 		being held in memory.
+*
+* 		The planes are processed in steps. At each step the given
+* 		operator is called with a 3D object made up of a window of
+* 		input planes and must compute the output planes for the
+* 		central part of the window, which are all of the window's
+* 		planes except for the given radius at either end (except
+* 		at the ends of the object). Within each step the input
+* 		planes for the next step are read ahead, the operator is
+* 		applied to the current window and the output planes of
+* 		the previous step are written behind, with these three
+* 		tasks being done concurrently when OpenMP is available.
+* 		Nested parallelism is enabled for the duration of this
+* 		function so that operators which are themselves parallel
+* 		still use multiple threads.
+*
+* 		Both streams must be positioned at their first plane and
+* 		have the same plane bounds.
+* \param	inStr			Input plane stream.
+* \param	outStr			Output plane stream.
+* \param	nWin			Number of planes in the window, if
+* 					less than one a default of four times
+* 					the radius plus one (and at least
+* 					eight planes) is used. The window is
+* 					never less than twice the radius plus
+* 					one planes.
+* \param	rad			Radius of the operator in planes,
+* 					ie the number of planes either side
+* 					of an output plane that are needed
+* 					to compute it.
+* \param	fn			Window operator.
+* \param	fnData			Data passed to the window operator.
+*/
+WlzErrorNum	WlzPlaneStreamProcess(WlzPlaneStream *inStr,
+				      WlzPlaneStream *outStr,
+				      int nWin, int rad,
+				      WlzPlaneStreamFn fn, void *fnData)
+{
+  int		idS,
+		nPl,
+  		nStp,
+		stp,
+		rel = 0;
+  WlzPlaneDomain *iDom,
+  		*oDom;
+  WlzObject	**buf[2];
+  WlzErrorNum	errNum = WLZ_ERR_NONE,
+  		errR = WLZ_ERR_NONE,
+		errC = WLZ_ERR_NONE,
+		errW = WLZ_ERR_NONE;
+#ifdef _OPENMP
+  int		maxLvl;
+#endif
+
+  buf[0] = buf[1] = NULL;
+  if((inStr == NULL) || (inStr->obj == NULL) ||
+     (outStr == NULL) || (outStr->obj == NULL) || (fn == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if((inStr->write != 0) || (outStr->write == 0) ||
+          (inStr->nxtPl != 0) || (outStr->nxtPl != 0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    iDom = inStr->obj->domain.p;
+    oDom = outStr->obj->domain.p;
+    if((iDom->plane1 != oDom->plane1) || (iDom->lastpl != oDom->lastpl))
+    {
+      errNum = WLZ_ERR_PLANE_DATA;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rad = ALG_MAX(rad, 0);
+    if(nWin < 1)
+    {
+      nWin = ALG_MAX((4 * rad) + 1, 8);
+    }
+    nWin = ALG_MAX(nWin, (2 * rad) + 1);
+    stp = nWin - (2 * rad);
+    nPl = iDom->lastpl - iDom->plane1 + 1;
+    nStp = (nPl + stp - 1) / stp;
+    if(((buf[0] = (WlzObject **)
+                  AlcCalloc(2 * stp, sizeof(WlzObject *))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      buf[1] = buf[0] + stp;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzPlaneStreamReadTo(inStr, ALG_MIN(stp + rad, nPl) - 1);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+    maxLvl = omp_get_max_active_levels();
+    if(maxLvl < 2)
+    {
+      omp_set_max_active_levels(2);
+    }
+#endif
+    for(idS = 0; (idS <= nStp) && (errNum == WLZ_ERR_NONE); ++idS)
+    {
+      int	idP0,
+      		idP1;
+
+      idP0 = idS * stp;
+      idP1 = ALG_MIN(idP0 + stp, nPl) - 1;
+#ifdef _OPENMP
+#pragma omp parallel sections num_threads(3)
+      {
+#pragma omp section
+        {
+#endif
+	  if(idS + 1 < nStp)
+	  {
+	    errR = WlzPlaneStreamReadTo(inStr,
+	                                ALG_MIN(idP1 + stp + rad, nPl - 1));
+	  }
+#ifdef _OPENMP
+        }
+#pragma omp section
+        {
+#endif
+	  if(idS < nStp)
+	  {
+	    errC = WlzPlaneStreamCompute(inStr, idP0, idP1, rad, fn, fnData,
+	                                 buf[idS % 2]);
+	  }
+#ifdef _OPENMP
+        }
+#pragma omp section
+        {
+#endif
+	  if(idS > 0)
+	  {
+	    errW = WlzPlaneStreamWriteN(outStr, stp, buf[(idS + 1) % 2]);
+	  }
+#ifdef _OPENMP
+        }
+      }
+#endif
+      errNum = (errR != WLZ_ERR_NONE)? errR:
+               (errC != WLZ_ERR_NONE)? errC: errW;
+      /* Release the input planes which are not in the next window. */
+      if(errNum == WLZ_ERR_NONE)
+      {
+        int	idR;
+
+	idR = ALG_MIN(idP1 + 1 - rad, nPl);
+	if(idR > rel)
+	{
+	  WlzPlaneStreamRelease(inStr, rel, idR - 1);
+	  rel = idR;
+	}
+      }
+    }
+#ifdef _OPENMP
+    omp_set_max_active_levels(maxLvl);
+#endif
+  }
+  if(buf[0])
+  {
+    int		idB;
+
+    for(idB = 0; idB < 2 * stp; ++idB)
+    {
+      (void )WlzFreeObj(buf[0][idB]);
+    }
+    AlcFree(buf[0]);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Applies a Gaussian filter to a 3D domain object which is
+* 		read from the given input file and written to the given
+* 		output file one plane at a time, see WlzGaussObj().
+* 		The window radius is four times the Gaussian's z sigma
+* 		(plus the z derivative order) which makes the result an
+* 		approximation to that of filtering the whole object, but
+* 		one which differs from it by a negligible amount.
+* \param	inFP			Input file.
+* \param	outFP			Output file.
+* \param	nWin			Number of planes in the window, if
+* 					less than one a default is used,
+* 					see WlzPlaneStreamProcess().
+* \param	sigma			Gaussian sigma values.
+* \param	order			Derivative orders.
+*/
+WlzErrorNum	WlzPlaneStreamGauss(FILE *inFP, FILE *outFP, int nWin,
+				    WlzDVertex3 sigma, WlzIVertex3 order)
+{
+  int		rad;
+  WlzPlaneStreamGaussPrm prm;
+
+  prm.sigma = sigma;
+  prm.order = order;
+  rad = (int )ceil(4.0 * ALG_MAX(sigma.vtZ, 0.0)) + ALG_MAX(order.vtZ, 0);
+  return(WlzPlaneStreamFile(inFP, outFP, 0, nWin, rad,
+  			    WlzPlaneStreamGaussFn, &prm));
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Applies a rank filter to a 3D domain object which is read
+* 		from the given input file and written to the given output
+* 		file one plane at a time, see WlzRankFilter(). The result
+* 		is identical to that of filtering the whole object.
+* \param	inFP			Input file.
+* \param	outFP			Output file.
+* \param	nWin			Number of planes in the window, if
+* 					less than one a default is used,
+* 					see WlzPlaneStreamProcess().
+* \param	fSz			Filter size.
+* \param	rank			Required rank with 0.0 the minimum,
+* 					0.5 the median and 1.0 the maximum.
+*/
+WlzErrorNum	WlzPlaneStreamRankFilter(FILE *inFP, FILE *outFP, int nWin,
+					 int fSz, double rank)
+{
+  WlzPlaneStreamRankPrm prm;
+
+  prm.fSz = fSz;
+  prm.rank = rank;
+  return(WlzPlaneStreamFile(inFP, outFP, 0, nWin, fSz / 2,
+  			    WlzPlaneStreamRankFn, &prm));
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Thresholds a 3D domain object which is read from the given
+* 		input file and written to the given output file one plane
+* 		at a time, see WlzThreshold(). The domain of the output
+* 		object is only known once all of its planes have been
+* 		computed, so its values are spooled to a temporary file.
+* \param	inFP			Input file.
+* \param	outFP			Output file.
+* \param	thrV			Threshold value.
+* \param	hilo			Threshold type.
+*/
+WlzErrorNum	WlzPlaneStreamThreshold(FILE *inFP, FILE *outFP,
+					WlzPixelV thrV, WlzThresholdType hilo)
+{
+  WlzPlaneStreamThrPrm prm;
+
+  prm.thrV = thrV;
+  prm.hilo = hilo;
+  return(WlzPlaneStreamFile(inFP, outFP, 1, 0, 0,
+  			    WlzPlaneStreamThresholdFn, &prm));
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Applies a scalar function to the values of a 3D domain
+* 		object which is read from the given input file and written
+* 		to the given output file one plane at a time, see
+* 		WlzScalarFn().
+* \param	inFP			Input file.
+* \param	outFP			Output file.
+* \param	fn			Scalar function.
+*/
+WlzErrorNum	WlzPlaneStreamScalarFn(FILE *inFP, FILE *outFP, WlzFnType fn)
+{
+  return(WlzPlaneStreamFile(inFP, outFP, 0, 0, 0,
+  			    WlzPlaneStreamScalarFnFn, &fn));
+}
+
+/*!
+* \return	New 3D domain object or NULL on error.
+* \ingroup	WlzIO
+* \brief	Makes a 3D domain object for the given range of planes
+* 		of the given object, sharing the object's plane domains
+* 		and values.
+* \param	obj			Given 3D domain object.
+* \param	pl0			First plane of the window.
+* \param	pl1			Last plane of the window.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzPlaneStreamWindow(WlzObject *obj, int pl0, int pl1,
+				       WlzErrorNum *dstErr)
+{
+  int		idP,
+  		off;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzPlaneDomain *pDom;
+  WlzVoxelValues *vox;
+  WlzObject	*win = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  pDom = obj->domain.p;
+  off = pl0 - pDom->plane1;
+  dom.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN, pl0, pl1,
+			     pDom->line1, pDom->lastln,
+			     pDom->kol1, pDom->lastkl, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    dom.p->voxel_size[0] = pDom->voxel_size[0];
+    dom.p->voxel_size[1] = pDom->voxel_size[1];
+    dom.p->voxel_size[2] = pDom->voxel_size[2];
+    for(idP = 0; idP <= pl1 - pl0; ++idP)
+    {
+      dom.p->domains[idP] = WlzAssignDomain(pDom->domains[off + idP], NULL);
+    }
+    if(obj->values.core != NULL)
+    {
+      vox = obj->values.vox;
+      val.vox = WlzMakeVoxelValueTb(WLZ_VOXELVALUETABLE_GREY, pl0, pl1,
+      				    vox->bckgrnd, NULL, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	for(idP = 0; idP <= pl1 - pl0; ++idP)
+	{
+	  val.vox->values[idP] = WlzAssignValues(vox->values[off + idP],
+	  					 NULL);
+	}
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    win = WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, val, NULL, NULL, &errNum);
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    (void )WlzFreePlaneDomain(dom.p);
+    if(val.core)
+    {
+      (void )WlzFreeVoxelValueTb(val.vox);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(win);
+}
+
+/*!
+* \return	New 2D domain object or NULL if the plane is empty or
+* 		on error.
+* \ingroup	WlzIO
+* \brief	Makes a 2D domain object which shares the domain and
+* 		values of the given plane of the given 3D object.
+* \param	obj			Given 3D domain object.
+* \param	pl			Given plane.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzPlaneStreamPlaneObj(WlzObject *obj, int pl,
+					 WlzErrorNum *dstErr)
+{
+  int		idP;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzObject	*pObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  idP = pl - obj->domain.p->plane1;
+  dom = obj->domain.p->domains[idP];
+  val.core = NULL;
+  if((obj->values.core != NULL) &&
+     (WlzGreyTableIsTiled(obj->values.core->type) == 0))
+  {
+    val = obj->values.vox->values[idP];
+  }
+  if(dom.core != NULL)
+  {
+    pObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL, &errNum);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(pObj);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Sets 2D domain objects for the given range of planes of
+* 		the given 3D object.
+* \param	obj			Given 3D domain object.
+* \param	pl0			First plane.
+* \param	pl1			Last plane.
+* \param	dst			Destination for the 2D objects.
+*/
+static WlzErrorNum WlzPlaneStreamExtract(WlzObject *obj, int pl0, int pl1,
+					 WlzObject **dst)
+{
+  int		pl;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((obj == NULL) || (obj->type != WLZ_3D_DOMAINOBJ) ||
+     (obj->domain.core == NULL))
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else if((pl0 < obj->domain.p->plane1) || (pl1 > obj->domain.p->lastpl))
+  {
+    errNum = WLZ_ERR_PLANE_DATA;
+  }
+  for(pl = pl0; (errNum == WLZ_ERR_NONE) && (pl <= pl1); ++pl)
+  {
+    dst[pl - pl0] = WlzAssignObject(
+    		    WlzPlaneStreamPlaneObj(obj, pl, &errNum), NULL);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Reads planes from the given stream until the plane with
+* 		the given index (relative to the first plane) has been
+* 		read.
+* \param	str			Given input plane stream.
+* \param	idP			Index of the last plane to read.
+*/
+static WlzErrorNum WlzPlaneStreamReadTo(WlzPlaneStream *str, int idP)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  while((errNum == WLZ_ERR_NONE) && (str->nxtPl <= idP))
+  {
+    errNum = WlzPlaneStreamReadPlane(str);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Applies the window operator to compute the output planes
+* 		in the given range.
+* \param	str			Given input plane stream which must
+* 					hold all the planes within the radius
+* 					of the range.
+* \param	idP0			Index of the first output plane.
+* \param	idP1			Index of the last output plane.
+* \param	rad			Radius of the operator in planes.
+* \param	fn			Window operator.
+* \param	fnData			Data passed to the window operator.
+* \param	dst			Destination for the output planes.
+*/
+static WlzErrorNum WlzPlaneStreamCompute(WlzPlaneStream *str,
+					 int idP0, int idP1, int rad,
+					 WlzPlaneStreamFn fn, void *fnData,
+					 WlzObject **dst)
+{
+  int		pl1,
+  		lastpl;
+  WlzObject	*win;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  pl1 = str->obj->domain.p->plane1;
+  lastpl = str->obj->domain.p->lastpl;
+  win = WlzAssignObject(
+        WlzPlaneStreamWindow(str->obj,
+			     ALG_MAX(pl1 + idP0 - rad, pl1),
+			     ALG_MIN(pl1 + idP1 + rad, lastpl),
+			     &errNum), NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = (*fn)(win, pl1 + idP0, pl1 + idP1, dst, fnData);
+  }
+  (void )WlzFreeObj(win);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Writes (up to) the given number of planes to the given
+* 		output stream, freeing the objects in the buffer.
+* \param	str			Given output plane stream.
+* \param	nPl			Number of planes in the buffer.
+* \param	buf			Buffer of 2D objects.
+*/
+static WlzErrorNum WlzPlaneStreamWriteN(WlzPlaneStream *str, int nPl,
+					WlzObject **buf)
+{
+  int		idB,
+  		nRem;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nRem = str->obj->domain.p->lastpl - str->obj->domain.p->plane1 + 1 -
+         str->nxtPl;
+  nPl = ALG_MIN(nPl, nRem);
+  for(idB = 0; (errNum == WLZ_ERR_NONE) && (idB < nPl); ++idB)
+  {
+    errNum = WlzPlaneStreamWritePlane(str, buf[idB]);
+    (void )WlzFreeObj(buf[idB]);
+    buf[idB] = NULL;
+  }
+  return(errNum);
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Frees the values of the given range of planes of an input
+* 		plane stream.
+* \param	str			Given input plane stream.
+* \param	idP0			Index of the first plane.
+* \param	idP1			Index of the last plane.
+*/
+static void	WlzPlaneStreamRelease(WlzPlaneStream *str, int idP0, int idP1)
+{
+  int		idP;
+  WlzVoxelValues *vox;
+
+  if((vox = str->obj->values.vox) != NULL)
+  {
+    for(idP = idP0; idP <= idP1; ++idP)
+    {
+      (void )WlzFreeValues(vox->values[idP]);
+      vox->values[idP].core = NULL;
+    }
+  }
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Opens plane streams on the given files, processes them
+* 		using WlzPlaneStreamProcess() and then closes them.
+* \param	inFP			Input file.
+* \param	outFP			Output file.
+* \param	defDom			Non-zero if the output plane domains
+* 					are computed by the operator.
+* \param	nWin			Number of planes in the window.
+* \param	rad			Radius of the operator in planes.
+* \param	fn			Window operator.
+* \param	fnData			Data passed to the window operator.
+*/
+static WlzErrorNum WlzPlaneStreamFile(FILE *inFP, FILE *outFP, int defDom,
+				      int nWin, int rad,
+				      WlzPlaneStreamFn fn, void *fnData)
+{
+  WlzPlaneStream *inStr = NULL,
+  		*outStr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE,
+  		errNum2;
+
+  inStr = WlzPlaneStreamOpenRead(inFP, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    outStr = WlzPlaneStreamOpenWrite(outFP, inStr->obj->domain.p,
+    				     WlzGetBackground(inStr->obj, NULL),
+				     defDom, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzPlaneStreamProcess(inStr, outStr, nWin, rad, fn, fnData);
+  }
+  if(outStr)
+  {
+    errNum2 = WlzPlaneStreamClose(outStr);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = errNum2;
+    }
+  }
+  if(inStr)
+  {
+    (void )WlzPlaneStreamClose(inStr);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Window operator for WlzPlaneStreamGauss().
+* \param	win			Window object.
+* \param	pl0			First output plane.
+* \param	pl1			Last output plane.
+* \param	dst			Destination for the output planes.
+* \param	data			Gaussian filter parameters.
+*/
+static WlzErrorNum WlzPlaneStreamGaussFn(WlzObject *win, int pl0, int pl1,
+					 WlzObject **dst, void *data)
+{
+  WlzObject	*rObj;
+  WlzPlaneStreamGaussPrm *prm;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  prm = (WlzPlaneStreamGaussPrm *)data;
+  rObj = WlzAssignObject(WlzGaussObj(win, prm->sigma, prm->order,
+  				     &errNum), NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzPlaneStreamExtract(rObj, pl0, pl1, dst);
+  }
+  (void )WlzFreeObj(rObj);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Window operator for WlzPlaneStreamRankFilter(). The window
+* 		is copied because WlzRankFilter() filters in place and the
+* 		planes of the window are shared with the next window.
+* \param	win			Window object.
+* \param	pl0			First output plane.
+* \param	pl1			Last output plane.
+* \param	dst			Destination for the output planes.
+* \param	data			Rank filter parameters.
+*/
+static WlzErrorNum WlzPlaneStreamRankFn(WlzObject *win, int pl0, int pl1,
+					WlzObject **dst, void *data)
+{
+  WlzObject	*rObj;
+  WlzPlaneStreamRankPrm *prm;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  prm = (WlzPlaneStreamRankPrm *)data;
+  rObj = WlzAssignObject(WlzCopyObject(win, &errNum), NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzRankFilter(rObj, prm->fSz, prm->rank);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzPlaneStreamExtract(rObj, pl0, pl1, dst);
+  }
+  (void )WlzFreeObj(rObj);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Window operator for WlzPlaneStreamThreshold().
+* \param	win			Window object.
+* \param	pl0			First output plane.
+* \param	pl1			Last output plane.
+* \param	dst			Destination for the output planes.
+* \param	data			Threshold parameters.
+*/
+static WlzErrorNum WlzPlaneStreamThresholdFn(WlzObject *win,
+					     int pl0, int pl1,
+					     WlzObject **dst, void *data)
+{
+  int		pl;
+  WlzObject	*pObj,
+  		*tObj;
+  WlzPlaneStreamThrPrm *prm;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  prm = (WlzPlaneStreamThrPrm *)data;
+  for(pl = pl0; (errNum == WLZ_ERR_NONE) && (pl <= pl1); ++pl)
+  {
+    tObj = NULL;
+    pObj = WlzAssignObject(WlzPlaneStreamPlaneObj(win, pl, &errNum), NULL);
+    if((errNum == WLZ_ERR_NONE) && (pObj != NULL))
+    {
+      tObj = WlzAssignObject(WlzThreshold(pObj, prm->thrV, prm->hilo,
+      					  &errNum), NULL);
+    }
+    dst[pl - pl0] = tObj;
+    (void )WlzFreeObj(pObj);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Window operator for WlzPlaneStreamScalarFn().
+* \param	win			Window object.
+* \param	pl0			First output plane.
+* \param	pl1			Last output plane.
+* \param	dst			Destination for the output planes.
+* \param	data			Pointer to the scalar function type.
+*/
+static WlzErrorNum WlzPlaneStreamScalarFnFn(WlzObject *win,
+					    int pl0, int pl1,
+					    WlzObject **dst, void *data)
+{
+  int		pl;
+  WlzObject	*pObj,
+  		*fObj;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  for(pl = pl0; (errNum == WLZ_ERR_NONE) && (pl <= pl1); ++pl)
+  {
+    fObj = NULL;
+    pObj = WlzAssignObject(WlzPlaneStreamPlaneObj(win, pl, &errNum), NULL);
+    if((errNum == WLZ_ERR_NONE) && (pObj != NULL))
+    {
+      fObj = WlzAssignObject(WlzScalarFn(pObj, *(WlzFnType *)data,
+      					 &errNum), NULL);
+    }
+    dst[pl - pl0] = fObj;
+    (void )WlzFreeObj(pObj);
+  }
+  return(errNum);
+}
@@ -961,6 +961,9 @@ extern WlzPolygonDomain 	*WlzAssignPolygonDomain(
 extern WlzGMModel		*WlzAssignGMModel(
 				  WlzGMModel *model,
 				  WlzErrorNum *dstErr);
+extern int 			WlzLink(
+				  int *linkcount,
+				  WlzErrorNum *dstErr);
 extern int 			WlzUnlink(
 				  int *linkcount,
 				  WlzErrorNum *dstErr);
@@ -2145,6 +2148,10 @@ extern WlzContour		*WlzContourObj(
 				  double ctrWth,
 				  int nrmFlg,
 				  WlzErrorNum *dstErr);
+extern WlzIdxMesh3D		*WlzContourIsoIdxMesh3D(
+				  WlzObject *srcObj,
+				  double isoVal,
+				  WlzErrorNum *dstErr);
 extern WlzContour		*WlzContourObjGrd(
 				  WlzObject *srcObj,
 				  double ctrLo,
@@ -2297,6 +2304,13 @@ extern WlzObject		*WlzConvolveObj(
 				  WlzConvolution *conv,
 				  int newObjFlg,
 				  WlzErrorNum	*dstErr);
+extern WlzObject		*WlzConvolveObjKernel(
+				  WlzObject *inObj,
+				  WlzIVertex3 kSz,
+				  double *krn,
+				  WlzConvolveMethod method,
+				  int newObjFlag,
+				  WlzErrorNum *dstErr);
 extern int			WlzConvolveSeqParFn(
 				  WlzSeqParWSpace *spWSpace,
 				  void *spData);
@@ -2476,6 +2490,25 @@ extern WlzObject 		*WlzDomainFill(
 				  WlzObject *obj,
 				  WlzErrorNum *dstErr);
 
+/************************************************************************
+* WlzDomainSetOp.c							*
+************************************************************************/
+extern WlzDomain		WlzDomainSetOp2D(
+				  int n,
+				  WlzDomain *doms,
+				  WlzBinaryOperatorType op,
+				  WlzErrorNum *dstErr);
+extern WlzDomain		WlzDomainSetOp3D(
+				  int n,
+				  WlzDomain *doms,
+				  WlzBinaryOperatorType op,
+				  WlzErrorNum *dstErr);
+extern WlzObject		*WlzDomainSetOp(
+				  int n,
+				  WlzObject **objs,
+				  WlzBinaryOperatorType op,
+				  WlzErrorNum *dstErr);
+
 /************************************************************************
 * WlzDomainUtils.c							*
 ************************************************************************/
@@ -2605,6 +2638,8 @@ extern WlzErrorNum		WlzFree3DWarpTrans(
 				  Wlz3DWarpTrans *obj);
 extern WlzErrorNum		WlzFreeContour(
 				  WlzContour *ctr);
+extern WlzErrorNum		WlzFreeIdxMesh3D(
+				  WlzIdxMesh3D *mesh);
 extern WlzErrorNum 		WlzFreeIndexedValues(
 				  WlzIndexedValues *ixv);
 extern WlzErrorNum		WlzFreePointValues(
@@ -2640,6 +2675,11 @@ extern WlzObject		*WlzGauss2(
 				  int x_deriv,
 				  int y_deriv,
 				  WlzErrorNum *dstErr);
+extern WlzObject		*WlzGaussObj(
+				  WlzObject *gObj,
+				  WlzDVertex3 sigma,
+				  WlzIVertex3 order,
+				  WlzErrorNum *dstErr);
 #ifndef WLZ_EXT_BIND
 extern WlzErrorNum		Wlz1DConv(
 				  WlzSepTransWSpace *stwspc,
@@ -3691,6 +3731,11 @@ extern void            		WlzGreyValueGetCon(
 				  double plane,
 				  double line,
 				  double kol);
+extern void            		WlzGreyValueGetConFull(
+				  WlzGreyValueWSpace *gVWSp,
+				  double plane,
+				  double line,
+				  double kol);
 extern WlzGreyType     		WlzGreyValueGetGreyType(
 				  WlzGreyValueWSpace *gVWSp,
 				  WlzErrorNum *dstErr);
@@ -3835,6 +3880,12 @@ extern WlzObject 		*WlzImageArithmetic(
 			          WlzBinaryOperatorType op,
 			          int overwrite,
 				  WlzErrorNum *dstErr);
+extern WlzObject 		*WlzImageArithmeticClamp(
+				  WlzObject *obj0,
+				  WlzObject *obj1,
+			          WlzBinaryOperatorType op,
+			          int overwrite,
+				  WlzErrorNum *dstErr);
 
 /************************************************************************
 * WlzIndexObj.c
@@ -4177,6 +4228,22 @@ extern WlzErrorNum 		WlzLabel(
 				  int ignlns,
 				  WlzConnectType connect);
 
+/************************************************************************
+* WlzLabelUF.c								*
+************************************************************************/
+extern WlzErrorNum		WlzLabelUF(
+				  WlzObject *obj,
+				  int *dstNObj,
+				  WlzObject ***dstObjs,
+				  int ignlns,
+				  WlzConnectType connect);
+extern WlzObject		*WlzLabelUFImage(
+				  WlzObject *obj,
+				  int ignlns,
+				  WlzConnectType connect,
+				  int *dstNLbl,
+				  WlzErrorNum *dstErr);
+
 /************************************************************************
 * WlzLaplacian.c							*
 ************************************************************************/
@@ -4527,6 +4594,10 @@ extern WlzIntervalDomain	*WlzNewIDomain(
 				  WlzErrorNum *dstErr);
 extern WlzContour		*WlzMakeContour(
 				  WlzErrorNum *dstErr);
+extern WlzIdxMesh3D		*WlzMakeIdxMesh3D(
+				  int maxVtx,
+				  int maxTri,
+				  WlzErrorNum *dstErr);
 extern WlzIndexedValues		*WlzMakeIndexedValues(
 				  WlzObject *dObj,
 				  int rank,
@@ -4563,7 +4634,9 @@ extern WlzErrorNum		WlzMatchICPObjs(
 				  double maxDeform,
 				  int matchImpNN,
 				  double matchImpThr,
-				  double delta);
+				  double delta,
+				  double subFrac,
+				  double trTol);
 extern WlzErrorNum  		WlzMatchICPCtr(
 				  WlzContour *tCtr,
 				  WlzContour *sCtr,
@@ -4582,11 +4655,13 @@ extern WlzErrorNum  		WlzMatchICPCtr(
 				  double matchImpThr,
                                   WlzRegICPUsrWgtFn usrWgtFn,
                                   void *usrWgtData,
-				  double delta);
+				  double delta,
+				  double subFrac,
+				  double trTol);
 extern double          		WlzMatchICPWeightMatches(
 				  WlzVertexType vType,
 				  WlzAffineTransform *curTr,
-				  AlcKDTTree *tree,
+				  AlcKDSTree *tree,
 				  WlzVertexP tVx,
 				  WlzVertexP sVx,
 				  WlzVertex tMVx,
@@ -5189,6 +5264,29 @@ extern WlzErrorNum		WlzNObjGreyStats(
 				  WlzObject **dstSumObj,
 				  WlzObject **dstSSqObj);
 
+/************************************************************************
+* WlzObjectCache.c							*
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern WlzObjectCache		*WlzObjectCacheNew(
+				  unsigned int maxItem,
+				  size_t maxSz,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzObjectCacheFree(
+				  WlzObjectCache *cache);
+extern WlzObject		*WlzObjectCacheGet(
+				  WlzObjectCache *cache,
+				  const char *path,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzObjectCacheStats(
+				  WlzObjectCache *cache,
+				  WlzLong *dstHits,
+				  WlzLong *dstMisses,
+				  WlzLong *dstEvictions,
+				  unsigned int *dstNumItem,
+				  size_t *dstSz);
+#endif /* WLZ_EXT_BIND */
+
 /************************************************************************
 * WlzObjToBoundary.c							*
 ************************************************************************/
@@ -5239,6 +5337,40 @@ extern WlzObject 		*WlzPolarSample(
 				  int outFlg,
 				  WlzErrorNum *dstErr);
 
+/************************************************************************
+* WlzPlaneStream.c							*
+************************************************************************/
+#ifndef WLZ_EXT_BIND
+extern WlzErrorNum		WlzPlaneStreamProcess(
+				  WlzPlaneStream *inStr,
+				  WlzPlaneStream *outStr,
+				  int nWin,
+				  int rad,
+				  WlzPlaneStreamFn fn,
+				  void *fnData);
+extern WlzErrorNum		WlzPlaneStreamGauss(
+				  FILE *inFP,
+				  FILE *outFP,
+				  int nWin,
+				  WlzDVertex3 sigma,
+				  WlzIVertex3 order);
+extern WlzErrorNum		WlzPlaneStreamRankFilter(
+				  FILE *inFP,
+				  FILE *outFP,
+				  int nWin,
+				  int fSz,
+				  double rank);
+extern WlzErrorNum		WlzPlaneStreamThreshold(
+				  FILE *inFP,
+				  FILE *outFP,
+				  WlzPixelV thrV,
+				  WlzThresholdType hilo);
+extern WlzErrorNum		WlzPlaneStreamScalarFn(
+				  FILE *inFP,
+				  FILE *outFP,
+				  WlzFnType fn);
+#endif /* !WLZ_EXT_BIND */
+
 /************************************************************************
 * WlzPolyToObj.c							*
 ************************************************************************/
@@ -5369,10 +5501,18 @@ extern WlzObjectType		WlzReadObjType(
 extern WlzObject		*WlzReadObj(
 				  FILE *fP,
 			          WlzErrorNum *dstErr);
+extern WlzObject		*WlzReadObjMapped(
+				  FILE *fP,
+			          WlzErrorNum *dstErr);
 #ifndef WLZ_EXT_BIND
 extern WlzMeshTransform3D 	*WlzReadMeshTransform3D(
 				  FILE *fP,
 				  WlzErrorNum *dstErr);
+extern WlzPlaneStream		*WlzPlaneStreamOpenRead(
+				  FILE *fP,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzPlaneStreamReadPlane(
+				  WlzPlaneStream *str);
 #endif /* !WLZ_EXT_BIND */
 
 /************************************************************************
@@ -5442,6 +5582,8 @@ extern WlzAffineTransform	*WlzRegICPObjs(
 				  int maxItr,
 				  double delta,
 				  double minDistWgt,
+				  double subFrac,
+				  double trTol,
 				  WlzErrorNum *dstErr);
 extern WlzAffineTransform	*WlzRegICPObjsGrd(
 				  WlzObject *tObj,
@@ -5456,6 +5598,8 @@ extern WlzAffineTransform	*WlzRegICPObjsGrd(
 				  int maxItr,
 				  double delta,
 				  double minDistWgt,
+				  double subFrac,
+				  double trTol,
 				  WlzErrorNum *dstErr);
 #ifndef WLZ_EXT_BIND
 extern WlzAffineTransform	*WlzRegICPVertices(
@@ -5475,8 +5619,27 @@ extern WlzAffineTransform	*WlzRegICPVertices(
 				  double delta,
 				  double minDistWgt,
 				  WlzErrorNum *dstErr);
+extern WlzAffineTransform	*WlzRegICPVerticesSched(
+				  WlzVertexP tVx,
+				  WlzVertexP tNr,
+				  int tCnt,
+				  WlzVertexP sVx,
+				  WlzVertexP sNr,
+				  int sCnt,
+				  WlzVertexType vType,
+				  int sgnNrm,
+				  WlzAffineTransform *initTr,
+				  WlzTransformType trType,
+				  int *dstConv,
+				  int *dstItr,
+				  int maxItr,
+				  double delta,
+				  double minDistWgt,
+				  double subFrac,
+				  double trTol,
+				  WlzErrorNum *dstErr);
 extern WlzAffineTransform	*WlzRegICPTreeAndVertices(
-				  AlcKDTTree *tree,
+				  AlcKDSTree *tree,
 				  WlzTransformType trType,
 				  WlzVertexType vType,
 				  int sgnNrm,
@@ -5497,6 +5660,8 @@ extern WlzAffineTransform	*WlzRegICPTreeAndVertices(
 				  void *usrWgtData,
 				  double delta,
 				  double minDistWgt,
+				  double subFrac,
+				  double trTol,
 				  WlzErrorNum *dstErr); 
 #endif /* WLZ_EXT_BIND */
 
@@ -5610,6 +5775,11 @@ extern WlzErrorNum 		WlzScalarBinaryOp(
 				  WlzPixelV pval,
 				  WlzObject *o3,
 				  WlzBinaryOperatorType op);
+extern WlzErrorNum 		WlzScalarBinaryOpClamp(
+				  WlzObject *o1,
+				  WlzPixelV pval,
+				  WlzObject *o3,
+				  WlzBinaryOperatorType op);
 
 /************************************************************************
 * WlzScalarFeatures2D.c
@@ -6176,6 +6346,21 @@ extern void			WlzTiledValueBufferFlush(
 extern void			WlzTiledValueBufferFill(
 				  WlzTiledValueBuffer *tvb,
 				  WlzTiledValues *tv);
+extern size_t			*WlzTiledValuesViewTiles(
+				  WlzTiledValues *tVal,
+				  WlzThreeDViewStruct *view,
+				  size_t *dstNTiles,
+				  WlzErrorNum *dstErr);
+extern WlzTiledValuesCache	*WlzMakeTiledValuesCache(
+				  WlzTiledValues *tVal,
+				  unsigned int maxTiles,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzFreeTiledValuesCache(
+				  WlzTiledValuesCache *tc);
+extern WlzErrorNum		WlzTiledValuesPrefetch(
+				  WlzTiledValues *tVal,
+				  WlzThreeDViewStruct *view,
+				  WlzTiledValuesCache *tc);
 #endif /* WLZ_EXT_BIND */
 
 /************************************************************************
@@ -6731,6 +6916,11 @@ extern AlcKDTTree      		*WlzVerticesBuildTree(
 				  WlzVertexP vtx,
 				  int *shfBuf,
 				  WlzErrorNum *dstErr);
+extern AlcKDSTree      		*WlzVerticesBuildKDSTree(
+				  WlzVertexType vType,
+				  int nV,
+				  WlzVertexP vtx,
+				  WlzErrorNum *dstErr);
 extern int			WlzVertexQSortFnI2(
 				  void *p0,
 				  void *p1);
@@ -6783,6 +6973,12 @@ extern WlzObject 		*WlzWindow(
 				  WlzIVertex2 origin,
 				  WlzIVertex2 radius,
 				  WlzErrorNum	*dstErr);
+extern WlzObject		*WlzWindow3D(
+				  WlzObject *srcObj,
+				  WlzWindowFnType winFn,
+				  WlzIVertex3 origin,
+				  WlzIVertex3 radius,
+				  WlzErrorNum *dstErr);
 extern WlzWindowFnType 		WlzWindowFnValue(
 				  const char *winFnName);
 extern const char 		*WlzWindowFnName(
@@ -6799,6 +6995,17 @@ extern WlzErrorNum 		WlzWriteObj(
 extern WlzErrorNum  		WlzWriteMeshTransform3D(
 				  FILE *fp,
 			          WlzMeshTransform3D *obj);
+extern WlzPlaneStream		*WlzPlaneStreamOpenWrite(
+				  FILE *fP,
+				  WlzPlaneDomain *pDom,
+				  WlzPixelV bgdV,
+				  int defDom,
+				  WlzErrorNum *dstErr);
+extern WlzErrorNum		WlzPlaneStreamWritePlane(
+				  WlzPlaneStream *str,
+				  WlzObject *obj);
+extern WlzErrorNum		WlzPlaneStreamClose(
+				  WlzPlaneStream *str);
 #endif /* !WLZ_EXT_BIND */
 				  
 /************************************************************************
@@ -42,11 +42,107 @@ static char _WlzRank_c[] = "University of Edinburgh $Id$";
 */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <float.h>
 #include <limits.h>
 #include <string.h>
 #include <Wlz.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \def		WLZ_RANK_HIST_EMPTY
+* \ingroup	WlzValuesFilters
+* \brief	Histogram bin index used for positions which are not within
+* 		the domain of the object being filtered.
+*/
+#define WLZ_RANK_HIST_EMPTY	(USHRT_MAX)
+
+/*!
+* \def		WLZ_RANK_HIST_COL_BINS
+* \ingroup	WlzValuesFilters
+* \brief	Maximum number of histogram bins for which column
+* 		histograms are used. With more bins the cost of updating
+* 		the kernel histogram from the column histograms exceeds
+* 		that of updating it directly for all practical filter
+* 		sizes.
+*/
+#define WLZ_RANK_HIST_COL_BINS	(256)
+
+/*!
+* \def		WLZ_RANK_HIST_COL_MEM
+* \ingroup	WlzValuesFilters
+* \brief	Maximum number of bytes which may be used by each thread
+* 		for column histograms, planes are filtered in strips of
+* 		columns so that this is not exceeded.
+*/
+#define WLZ_RANK_HIST_COL_MEM	(1<<26)
+
+/*!
+* \struct	_WlzRankHistBuf
+* \ingroup	WlzValuesFilters
+* \brief	Buffer of histogram bin indices for all positions within
+* 		the bounding box of an object which is being rank filtered
+* 		using histograms, together with the filter parameters.
+* 		Typedef: ::WlzRankHistBuf.
+*/
+typedef struct _WlzRankHistBuf
+{
+  unsigned short *bin;		/*!< Bin indices of the values, with
+  				     WLZ_RANK_HIST_EMPTY for positions
+				     outside the domain. */
+  WlzIVertex3	org;		/*!< Origin of the buffer. */
+  WlzIVertex3	sz;		/*!< Size of the buffer. */
+  WlzIVertex3	lo;		/*!< Offset from a position to the start of
+  				     it's neighbourhood. */
+  WlzIVertex3	hi;		/*!< Offset from a position to the end of
+  				     it's neighbourhood. */
+  int		minVal;		/*!< Grey value of the first bin. */
+  int		nFin;		/*!< Number of fine histogram bins. */
+  int		nCrs;		/*!< Number of coarse histogram bins. */
+  int		crsSh;		/*!< Shift from fine to coarse bin index. */
+  int		fSz;		/*!< Rank filter size. */
+  int		useCol;		/*!< Non-zero if column histograms are
+  				     used. */
+  int		stripW;		/*!< Width of the strips of columns in
+  				     which planes are filtered. */
+  double	rank;		/*!< Required rank. */
+  WlzGreyType	gType;		/*!< Grey type of the object. */
+} WlzRankHistBuf;
+
+/*!
+* \struct	_WlzRankHistWSp
+* \ingroup	WlzValuesFilters
+* \brief	Per thread workspace for rank filtering using histograms.
+* 		The neighbourhood (kernel) histogram is held at two levels
+* 		so that ranks may be found quickly. When column histograms
+* 		are used there is a histogram for each column of the
+* 		current strip which covers the lines and planes of the
+* 		neighbourhood.
+* 		Typedef: ::WlzRankHistWSp.
+*/
+typedef struct _WlzRankHistWSp
+{
+  int		cnt;		/*!< Number of values in the kernel
+  				     histogram. */
+  int		*kFin;		/*!< Kernel fine histogram. */
+  int		*kCrs;		/*!< Kernel coarse histogram. */
+  int		*luc;		/*!< Kernel column at which the fine bins
+  				     of each coarse bin were last
+				     updated. */
+  int		colOrg;		/*!< Buffer column of the first column
+  				     histogram. */
+  int		colFst;		/*!< First buffer column of the strip
+  				     which is within the buffer. */
+  int		colLst;		/*!< Last buffer column of the strip
+  				     which is within the buffer. */
+  int		*cCnt;		/*!< Column value counts. */
+  int		*cFin;		/*!< Column fine histograms. */
+  int		*cCrs;		/*!< Column coarse histograms. */
+} WlzRankHistWSp;
+
 static WlzErrorNum 		WlzRankFilterDomObj2D(
 				  WlzObject *gObj,
 				  int fSz,
@@ -83,6 +179,69 @@ static void			WlzRankFilterValues(
 				  void *values,
 				  int nValues,
 				  double rank);
+static int			WlzRankFilterHistUse(
+				  WlzObject *gObj,
+				  int fSz,
+				  WlzRankHistBuf *buf,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzRankFilterHist(
+				  WlzObject *gObj,
+				  WlzRankHistBuf *buf);
+static WlzErrorNum		WlzRankFilterHistFill(
+				  WlzRankHistBuf *buf,
+				  WlzDomain dom,
+				  WlzValues val,
+				  int pln);
+static WlzErrorNum		WlzRankFilterHistPl(
+				  WlzRankHistBuf *buf,
+				  WlzRankHistWSp *wSp,
+				  WlzDomain dom,
+				  WlzValues val,
+				  int pln);
+static void			WlzRankFilterHistColLn(
+				  WlzRankHistBuf *buf,
+				  WlzRankHistWSp *wSp,
+				  int pln,
+				  int ln,
+				  int inc);
+static void			WlzRankFilterHistKerVal(
+				  WlzRankHistBuf *buf,
+				  WlzRankHistWSp *wSp,
+				  int pln,
+				  int ln0,
+				  int ln1,
+				  int kol0,
+				  int kol1,
+				  int inc);
+static void			WlzRankFilterHistKerClr(
+				  WlzRankHistBuf *buf,
+				  WlzRankHistWSp *wSp,
+				  int pln,
+				  int ln,
+				  int kol,
+				  int valid);
+static void			WlzRankFilterHistKerCol(
+				  WlzRankHistBuf *buf,
+				  WlzRankHistWSp *wSp,
+				  int kol,
+				  int inc);
+static void			WlzRankFilterHistKerMove(
+				  WlzRankHistBuf *buf,
+				  WlzRankHistWSp *wSp,
+				  int kol);
+static void			WlzRankFilterHistFine(
+				  WlzRankHistBuf *buf,
+				  WlzRankHistWSp *wSp,
+				  int crs,
+				  int kol);
+static int			WlzRankFilterHistRank(
+				  WlzRankHistBuf *buf,
+				  WlzRankHistWSp *wSp,
+				  int kol);
+static WlzRankHistWSp		*WlzRankFilterHistMakeWSp(
+				  WlzRankHistBuf *buf);
+static void			WlzRankFilterHistFreeWSp(
+				  WlzRankHistWSp *wSp);
 
 /*!
 * \return	Woolz error code.
@@ -92,6 +251,23 @@ static void			WlzRankFilterValues(
 *		ranked value of the values in it's immediate neighborhood,
 *		where the neighborhood is a simple axis aligned cuboid
 *		with the size.
+*
+*		Objects with integral grey values (WLZ_GREY_UBYTE,
+*		WLZ_GREY_SHORT and WLZ_GREY_INT), for which the range of
+*		values is less than USHRT_MAX, are filtered using sliding
+*		histograms. When the range of values is small (as for
+*		WLZ_GREY_UBYTE values) the neighbourhood histogram is
+*		updated from column histograms which are themselves
+*		updated as the neighbourhood moves down through the lines,
+*		so that the cost per pixel/voxel does not depend on the
+*		filter size (see S. Perreault and P. Hebert. "Median
+*		Filtering in Constant Time" IEEE Trans. IP 16:2389-2394,
+*		2007). For larger ranges of values the neighbourhood
+*		histogram is updated directly from the values which enter
+*		and leave it (see T. S. Huang, G. J. Yang and G. Y. Tang.
+*		"A Fast Two-Dimensional Median Filtering Algorithm" IEEE
+*		Trans. ASSP 27:13-18, 1979). Planes of 3D objects are
+*		filtered in parallel.
 * \param	gObj			Given object.
 * \param	fSz			Rank filter size.
 * \param	rank			Required rank with values:
@@ -134,17 +310,30 @@ WlzErrorNum	WlzRankFilter(WlzObject *gObj, int fSz, double rank)
     }
     switch(gObj->type)
     {
-      case WLZ_2D_DOMAINOBJ:
-	errNum = WlzRankFilterDomObj2D(gObj, fSz, rank);
-	break;
+      case WLZ_2D_DOMAINOBJ: /* FALLTHROUGH */
       case WLZ_3D_DOMAINOBJ:
-	errNum = WlzRankFilterDomObj3D(gObj, fSz, rank);
-	break;
+        break;
       default:
 	errNum = WLZ_ERR_OBJECT_TYPE;
 	break;
     }
   }
+  if((errNum == WLZ_ERR_NONE) && (fSz > 1))
+  {
+    WlzRankHistBuf buf;
+
+    buf.rank = rank;
+    if(WlzRankFilterHistUse(gObj, fSz, &buf, &errNum))
+    {
+      errNum = WlzRankFilterHist(gObj, &buf);
+    }
+    else if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = (gObj->type == WLZ_2D_DOMAINOBJ)?
+               WlzRankFilterDomObj2D(gObj, fSz, rank):
+	       WlzRankFilterDomObj3D(gObj, fSz, rank);
+    }
+  }
   return(errNum);
 }
 
@@ -985,6 +1174,956 @@ static void	WlzRankFilterValues(WlzGreyValueWSpace *gVWSp,
   }
 }
 
+/*!
+* \return	Non-zero if the object should be filtered using histograms.
+* \ingroup      WlzValuesFilters
+* \brief	Decides whether the given object can be rank filtered using
+* 		histograms and if so sets up the given buffer (but does not
+* 		allocate the bin indices). Histograms are used for integral
+* 		grey types when the number of bins required is less than
+* 		WLZ_RANK_HIST_EMPTY. Column histograms are used, whatever
+* 		the filter size, when the number of bins is no more than
+* 		WLZ_RANK_HIST_COL_BINS and the width of the strips in
+* 		which the planes are then filtered is chosen so that the
+* 		column histograms of each strip are within
+* 		WLZ_RANK_HIST_COL_MEM.
+* \param	gObj			Given 2D or 3D domain object with
+* 					non-tiled values.
+* \param	fSz			Rank filter size.
+* \param	buf			Buffer to be set up, the rank must
+* 					already be set.
+* \param	dstErr			Destination error pointer.
+*/
+static int	WlzRankFilterHistUse(WlzObject *gObj, int fSz,
+				     WlzRankHistBuf *buf,
+				     WlzErrorNum *dstErr)
+{
+  int		use = 0;
+  WlzPixelV	min,
+  		max;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  buf->bin = NULL;
+  buf->gType = WlzGreyTypeFromObj(gObj, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    switch(buf->gType)
+    {
+      case WLZ_GREY_UBYTE: /* FALLTHROUGH */
+      case WLZ_GREY_SHORT: /* FALLTHROUGH */
+      case WLZ_GREY_INT:
+        errNum = WlzGreyRange(gObj, &min, &max);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  (void )WlzValueConvertPixel(&min, min, WLZ_GREY_INT);
+	  (void )WlzValueConvertPixel(&max, max, WLZ_GREY_INT);
+	  use = ((double )(max.v.inv) - min.v.inv + 1.0) <
+	        (double )WLZ_RANK_HIST_EMPTY;
+	}
+	break;
+      default:
+        break;
+    }
+  }
+  if((errNum == WLZ_ERR_NONE) && use)
+  {
+    int		nB;
+    size_t	nCol;
+
+    buf->minVal = min.v.inv;
+    buf->nFin = max.v.inv - min.v.inv + 1;
+    /* Coarse bins cover approximately the square root of the number of
+     * fine bins. */
+    nB = 0;
+    while((buf->nFin - 1) >> nB)
+    {
+      ++nB;
+    }
+    buf->crsSh = (nB + 1) / 2;
+    buf->nCrs = ((buf->nFin - 1) >> buf->crsSh) + 1;
+    buf->fSz = fSz;
+    buf->lo.vtX = buf->lo.vtY = buf->lo.vtZ = fSz / 2;
+    buf->hi.vtX = buf->hi.vtY = buf->hi.vtZ = fSz - 1 - (fSz / 2);
+    if(gObj->type == WLZ_2D_DOMAINOBJ)
+    {
+      WlzIntervalDomain *iDom;
+
+      iDom = gObj->domain.i;
+      buf->org.vtX = iDom->kol1;
+      buf->org.vtY = iDom->line1;
+      buf->org.vtZ = 0;
+      buf->sz.vtX = iDom->lastkl - iDom->kol1 + 1;
+      buf->sz.vtY = iDom->lastln - iDom->line1 + 1;
+      buf->sz.vtZ = 1;
+      buf->lo.vtZ = buf->hi.vtZ = 0;
+    }
+    else
+    {
+      WlzPlaneDomain *pDom;
+
+      pDom = gObj->domain.p;
+      buf->org.vtX = pDom->kol1;
+      buf->org.vtY = pDom->line1;
+      buf->org.vtZ = pDom->plane1;
+      buf->sz.vtX = pDom->lastkl - pDom->kol1 + 1;
+      buf->sz.vtY = pDom->lastln - pDom->line1 + 1;
+      buf->sz.vtZ = pDom->lastpl - pDom->plane1 + 1;
+    }
+    buf->useCol = buf->nFin <= WLZ_RANK_HIST_COL_BINS;
+    buf->stripW = buf->sz.vtX;
+    if(buf->useCol)
+    {
+      nCol = WLZ_RANK_HIST_COL_MEM /
+	     ((buf->nFin + buf->nCrs + 1) * sizeof(int));
+      if(nCol < (size_t )(buf->sz.vtX + fSz - 1))
+      {
+	buf->stripW = (nCol > (size_t )fSz)? (int )(nCol - fSz + 1): 1;
+      }
+    }
+  }
+  *dstErr = errNum;
+  return(use && (errNum == WLZ_ERR_NONE));
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup      WlzValuesFilters
+* \brief	Rank filters the given object in place using histograms.
+* 		The histogram bin indices of all the object's values are
+* 		first copied into a buffer, the planes of the object are
+* 		then filtered independently.
+* \param	gObj			Given 2D or 3D domain object with
+* 					non-tiled integral grey values.
+* \param	buf			Buffer set up by
+* 					WlzRankFilterHistUse().
+*/
+static WlzErrorNum WlzRankFilterHist(WlzObject *gObj, WlzRankHistBuf *buf)
+{
+  int		idT,
+  		nPl,
+  		nThr = 1;
+  size_t	idx,
+  		nBin;
+  WlzDomain	*doms;
+  WlzValues	*vals;
+  WlzRankHistWSp **wSp = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(gObj->type == WLZ_2D_DOMAINOBJ)
+  {
+    nPl = 1;
+    doms = &(gObj->domain);
+    vals = &(gObj->values);
+  }
+  else
+  {
+    nPl = buf->sz.vtZ;
+    doms = gObj->domain.p->domains;
+    vals = gObj->values.vox->values;
+#ifdef _OPENMP
+    nThr = omp_get_max_threads();
+#endif
+  }
+  nBin = (size_t )(buf->sz.vtX) * buf->sz.vtY * buf->sz.vtZ;
+  if(((buf->bin = (unsigned short *)
+                  AlcMalloc(nBin * sizeof(unsigned short))) == NULL) ||
+     ((wSp = (WlzRankHistWSp **)
+             AlcCalloc(nThr, sizeof(WlzRankHistWSp *))) == NULL))
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  for(idT = 0; (errNum == WLZ_ERR_NONE) && (idT < nThr); ++idT)
+  {
+    if((wSp[idT] = WlzRankFilterHistMakeWSp(buf)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idP;
+
+    for(idx = 0; idx < nBin; ++idx)
+    {
+      buf->bin[idx] = WLZ_RANK_HIST_EMPTY;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr)
+#endif
+    for(idP = 0; idP < nPl; ++idP)
+    {
+      if((errNum == WLZ_ERR_NONE) && (doms[idP].core != NULL))
+      {
+	WlzErrorNum errNum2;
+
+	errNum2 = WlzRankFilterHistFill(buf, doms[idP], vals[idP],
+					buf->org.vtZ + idP);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical
+	  {
+#endif
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+#ifdef _OPENMP
+	  }
+#endif
+	}
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    int		idP;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(dynamic)
+#endif
+    for(idP = 0; idP < nPl; ++idP)
+    {
+      if((errNum == WLZ_ERR_NONE) && (doms[idP].core != NULL))
+      {
+	int	thrId = 0;
+	WlzErrorNum errNum2;
+
+#ifdef _OPENMP
+	thrId = omp_get_thread_num();
+#endif
+	errNum2 = WlzRankFilterHistPl(buf, wSp[thrId], doms[idP], vals[idP],
+				      buf->org.vtZ + idP);
+	if(errNum2 != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical
+	  {
+#endif
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2;
+	    }
+#ifdef _OPENMP
+	  }
+#endif
+	}
+      }
+    }
+  }
+  if(wSp)
+  {
+    for(idT = 0; idT < nThr; ++idT)
+    {
+      WlzRankFilterHistFreeWSp(wSp[idT]);
+    }
+    AlcFree(wSp);
+  }
+  AlcFree(buf->bin);
+  buf->bin = NULL;
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup      WlzValuesFilters
+* \brief	Sets the histogram bin indices in the given buffer for the
+* 		values of a single plane.
+* \param	buf			Histogram buffer.
+* \param	dom			Domain of the plane.
+* \param	val			Values of the plane.
+* \param	pln			Plane coordinate.
+*/
+static WlzErrorNum WlzRankFilterHistFill(WlzRankHistBuf *buf,
+				         WlzDomain dom, WlzValues val, int pln)
+{
+  int		idK;
+  unsigned short *bP;
+  WlzObject	*obj;
+  WlzGreyWSpace	gWSp;
+  WlzIntervalWSpace iWSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  obj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzInitGreyScan(obj, &iWSp, &gWSp);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
+    {
+      bP = buf->bin +
+           ((((size_t )(pln - buf->org.vtZ) * buf->sz.vtY) +
+	     iWSp.linpos - buf->org.vtY) * buf->sz.vtX) +
+	   iWSp.lftpos - buf->org.vtX;
+      switch(gWSp.pixeltype)
+      {
+        case WLZ_GREY_UBYTE:
+	  for(idK = 0; idK < iWSp.colrmn; ++idK)
+	  {
+	    bP[idK] = gWSp.u_grintptr.ubp[idK] - buf->minVal;
+	  }
+	  break;
+        case WLZ_GREY_SHORT:
+	  for(idK = 0; idK < iWSp.colrmn; ++idK)
+	  {
+	    bP[idK] = gWSp.u_grintptr.shp[idK] - buf->minVal;
+	  }
+	  break;
+        case WLZ_GREY_INT:
+	  for(idK = 0; idK < iWSp.colrmn; ++idK)
+	  {
+	    bP[idK] = gWSp.u_grintptr.inp[idK] - buf->minVal;
+	  }
+	  break;
+	default:
+	  break;
+      }
+    }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  (void )WlzFreeObj(obj);
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup      WlzValuesFilters
+* \brief	Rank filters the values of a single plane using the
+* 		histogram bin indices in the given buffer. The kernel
+* 		histogram is kept across the intervals of the plane,
+* 		being moved from one interval to the next rather than
+* 		rebuilt for each interval.
+*
+* 		When column histograms are used the plane is filtered in
+* 		strips of columns. Within a strip there is a histogram for
+* 		each column, covering the lines and planes of the
+* 		neighbourhood, which is updated by removing a single line
+* 		and adding another as the neighbourhood moves down through
+* 		the lines. The coarse kernel histogram is updated from the
+* 		column histograms as the neighbourhood moves along the
+* 		lines, while the fine kernel histogram is only brought up
+* 		to date for the coarse bins in which the ranked values are
+* 		found. Otherwise the kernel histogram is updated directly
+* 		from the values which enter and leave it as it moves
+* 		down through the lines and along them.
+* \param	buf			Histogram buffer.
+* \param	wSp			Histogram workspace.
+* \param	dom			Domain of the plane.
+* \param	val			Values of the plane.
+* \param	pln			Plane coordinate.
+*/
+static WlzErrorNum WlzRankFilterHistPl(WlzRankHistBuf *buf,
+				       WlzRankHistWSp *wSp,
+				       WlzDomain dom, WlzValues val, int pln)
+{
+  int		x0,
+		nBL;
+  WlzObject	*obj;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  nBL = buf->lo.vtY + buf->hi.vtY + 1;
+  pln -= buf->org.vtZ;
+  obj = WlzMakeMain(WLZ_2D_DOMAINOBJ, dom, val, NULL, NULL, &errNum);
+  for(x0 = 0; (errNum == WLZ_ERR_NONE) && (x0 < buf->sz.vtX);
+      x0 += buf->stripW)
+  {
+    int		x1,
+    		idL,
+		kol = 0,
+		kerLn = 0,
+		colLn = 0,
+		colValid = 0,
+		kerValid = 0;
+    WlzGreyWSpace gWSp;
+    WlzIntervalWSpace iWSp;
+
+    /* Set up the strip. */
+    x1 = ALG_MIN(x0 + buf->stripW - 1, buf->sz.vtX - 1);
+    wSp->colOrg = x0 - buf->lo.vtX;
+    wSp->colFst = ALG_MAX(wSp->colOrg, 0);
+    wSp->colLst = ALG_MIN(x1 + buf->hi.vtX, buf->sz.vtX - 1);
+    errNum = WlzInitGreyScan(obj, &iWSp, &gWSp);
+    while((errNum == WLZ_ERR_NONE) &&
+          ((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE))
+    {
+      int	a,
+      		b,
+		ln;
+
+      ln = iWSp.linpos - buf->org.vtY;
+      a = ALG_MAX(iWSp.lftpos - buf->org.vtX, x0);
+      b = ALG_MIN(iWSp.rgtpos - buf->org.vtX, x1);
+      if(a <= b)
+      {
+	int	idK;
+
+	if(buf->useCol)
+	{
+	  /* Bring the column histograms down to the line of the
+	   * interval. */
+	  if(!colValid || (ln - colLn >= nBL))
+	  {
+	    int	nCol;
+
+	    nCol = wSp->colLst - wSp->colOrg + 1;
+	    (void )memset(wSp->cFin, 0,
+			  (size_t )nCol * buf->nFin * sizeof(int));
+	    (void )memset(wSp->cCrs, 0,
+			  (size_t )nCol * buf->nCrs * sizeof(int));
+	    (void )memset(wSp->cCnt, 0, nCol * sizeof(int));
+	    for(idL = ln - buf->lo.vtY; idL <= ln + buf->hi.vtY; ++idL)
+	    {
+	      WlzRankFilterHistColLn(buf, wSp, pln, idL, 1);
+	    }
+	  }
+	  else
+	  {
+	    for(idL = colLn + 1; idL <= ln; ++idL)
+	    {
+	      WlzRankFilterHistColLn(buf, wSp, pln,
+	      			     idL - buf->lo.vtY - 1, -1);
+	      WlzRankFilterHistColLn(buf, wSp, pln, idL + buf->hi.vtY, 1);
+	    }
+	  }
+	  colValid = 1;
+	  colLn = ln;
+	  /* Move the kernel to the start of the interval, sliding it along
+	   * the line if it overlaps it's previous position, otherwise
+	   * rebuilding the coarse histogram and marking all the fine
+	   * bins as out of date. */
+	  if(kerValid && (ln == kerLn) && (a - kol < buf->fSz))
+	  {
+	    while(kol < a)
+	    {
+	      WlzRankFilterHistKerMove(buf, wSp, ++kol);
+	    }
+	  }
+	  else
+	  {
+	    wSp->cnt = 0;
+	    (void )memset(wSp->kCrs, 0, buf->nCrs * sizeof(int));
+	    for(idK = a - buf->lo.vtX; idK <= a + buf->hi.vtX; ++idK)
+	    {
+	      WlzRankFilterHistKerCol(buf, wSp, idK, 1);
+	    }
+	    for(idK = 0; idK < buf->nCrs; ++idK)
+	    {
+	      wSp->luc[idK] = a - buf->fSz;
+	    }
+	  }
+	}
+	else
+	{
+	  /* Move the kernel down to the line of the interval and then
+	   * along it to the start of the interval. */
+	  if(kerValid && (ln - kerLn < nBL))
+	  {
+	    for(idL = kerLn + 1; idL <= ln; ++idL)
+	    {
+	      WlzRankFilterHistKerVal(buf, wSp, pln,
+				      idL - buf->lo.vtY - 1,
+				      idL - buf->lo.vtY - 1,
+				      kol - buf->lo.vtX, kol + buf->hi.vtX, -1);
+	      WlzRankFilterHistKerVal(buf, wSp, pln,
+				      idL + buf->hi.vtY, idL + buf->hi.vtY,
+				      kol - buf->lo.vtX, kol + buf->hi.vtX, 1);
+	    }
+	    kerLn = ln;
+	  }
+	  if(kerValid && (ln == kerLn) && (abs(a - kol) < buf->fSz))
+	  {
+	    int	inc;
+
+	    inc = (a > kol)? 1: -1;
+	    while(kol != a)
+	    {
+	      int c0,
+	          c1;
+
+	      c0 = (inc > 0)? kol - buf->lo.vtX: kol + buf->hi.vtX;
+	      c1 = (inc > 0)? kol + buf->hi.vtX + 1: kol - buf->lo.vtX - 1;
+	      WlzRankFilterHistKerVal(buf, wSp, pln,
+				      ln - buf->lo.vtY, ln + buf->hi.vtY,
+				      c0, c0, -1);
+	      WlzRankFilterHistKerVal(buf, wSp, pln,
+				      ln - buf->lo.vtY, ln + buf->hi.vtY,
+				      c1, c1, 1);
+	      kol += inc;
+	    }
+	  }
+	  else
+	  {
+	    WlzRankFilterHistKerClr(buf, wSp, pln, kerLn, kol, kerValid);
+	    WlzRankFilterHistKerVal(buf, wSp, pln,
+	    			    ln - buf->lo.vtY, ln + buf->hi.vtY,
+				    a - buf->lo.vtX, a + buf->hi.vtX, 1);
+	  }
+	}
+	kol = a;
+	kerLn = ln;
+	kerValid = 1;
+	/* Move the kernel along the interval setting the ranked values. */
+	for(idK = a - iWSp.lftpos + buf->org.vtX;
+	    idK <= b - iWSp.lftpos + buf->org.vtX; ++idK)
+	{
+	  int	v;
+
+	  if(kol < idK + iWSp.lftpos - buf->org.vtX)
+	  {
+	    ++kol;
+	    if(buf->useCol)
+	    {
+	      WlzRankFilterHistKerMove(buf, wSp, kol);
+	    }
+	    else
+	    {
+	      WlzRankFilterHistKerVal(buf, wSp, pln,
+				      ln - buf->lo.vtY, ln + buf->hi.vtY,
+				      kol - buf->lo.vtX - 1,
+				      kol - buf->lo.vtX - 1, -1);
+	      WlzRankFilterHistKerVal(buf, wSp, pln,
+				      ln - buf->lo.vtY, ln + buf->hi.vtY,
+				      kol + buf->hi.vtX, kol + buf->hi.vtX, 1);
+	    }
+	  }
+	  v = buf->minVal + WlzRankFilterHistRank(buf, wSp, kol);
+	  switch(gWSp.pixeltype)
+	  {
+	    case WLZ_GREY_UBYTE:
+	      gWSp.u_grintptr.ubp[idK] = (WlzUByte )v;
+	      break;
+	    case WLZ_GREY_SHORT:
+	      gWSp.u_grintptr.shp[idK] = (short )v;
+	      break;
+	    case WLZ_GREY_INT:
+	      gWSp.u_grintptr.inp[idK] = v;
+	      break;
+	    default:
+	      break;
+	  }
+	}
+      }
+    }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
+    if(errNum == WLZ_ERR_EOO)
+    {
+      errNum = WLZ_ERR_NONE;
+    }
+  }
+  (void )WlzFreeObj(obj);
+  return(errNum);
+}
+
+/*!
+* \return	void
+* \ingroup      WlzValuesFilters
+* \brief	Adds (or removes) the values within a box of lines and
+* 		columns, through all planes of the kernel, directly to
+* 		(or from) the kernel histogram. Positions outside the
+* 		buffer are ignored.
+* \param	buf			Histogram buffer.
+* \param	wSp			Histogram workspace.
+* \param	pln			Plane of the kernel centre relative to
+* 					the buffer.
+* \param	ln0			First line relative to the buffer.
+* \param	ln1			Last line relative to the buffer.
+* \param	kol0			First column relative to the buffer.
+* \param	kol1			Last column relative to the buffer.
+* \param	inc			Increment, 1 to add or -1 to remove.
+*/
+static void	WlzRankFilterHistKerVal(WlzRankHistBuf *buf,
+					WlzRankHistWSp *wSp, int pln,
+					int ln0, int ln1, int kol0, int kol1,
+					int inc)
+{
+  int		idK,
+  		idY,
+  		idZ,
+		z0,
+		z1;
+  unsigned short b;
+  unsigned short *bP;
+
+  z0 = ALG_MAX(pln - buf->lo.vtZ, 0);
+  z1 = ALG_MIN(pln + buf->hi.vtZ, buf->sz.vtZ - 1);
+  ln0 = ALG_MAX(ln0, 0);
+  ln1 = ALG_MIN(ln1, buf->sz.vtY - 1);
+  kol0 = ALG_MAX(kol0, 0);
+  kol1 = ALG_MIN(kol1, buf->sz.vtX - 1);
+  for(idZ = z0; idZ <= z1; ++idZ)
+  {
+    for(idK = kol0; idK <= kol1; ++idK)
+    {
+      bP = buf->bin + (((size_t )idZ * buf->sz.vtY) * buf->sz.vtX) + idK;
+      for(idY = ln0; idY <= ln1; ++idY)
+      {
+	if((b = bP[(size_t )idY * buf->sz.vtX]) != WLZ_RANK_HIST_EMPTY)
+	{
+	  wSp->kFin[b] += inc;
+	  wSp->kCrs[b >> buf->crsSh] += inc;
+	  wSp->cnt += inc;
+	}
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup      WlzValuesFilters
+* \brief	Empties a kernel histogram which is updated directly from
+* 		the values, either by removing the values of it's previous
+* 		position or by clearing all the bins, whichever is the
+* 		cheaper.
+* \param	buf			Histogram buffer.
+* \param	wSp			Histogram workspace.
+* \param	pln			Plane of the kernel centre relative to
+* 					the buffer.
+* \param	ln			Previous line of the kernel centre
+* 					relative to the buffer.
+* \param	kol			Previous column of the kernel centre
+* 					relative to the buffer.
+* \param	valid			Non-zero if the kernel histogram holds
+* 					the values at it's previous position.
+*/
+static void	WlzRankFilterHistKerClr(WlzRankHistBuf *buf,
+					WlzRankHistWSp *wSp, int pln,
+					int ln, int kol, int valid)
+{
+  double	nKer;
+
+  nKer = (double )(buf->fSz) * buf->fSz *
+         (buf->lo.vtZ + buf->hi.vtZ + 1);
+  if(valid && (nKer < buf->nFin + buf->nCrs))
+  {
+    WlzRankFilterHistKerVal(buf, wSp, pln,
+			    ln - buf->lo.vtY, ln + buf->hi.vtY,
+			    kol - buf->lo.vtX, kol + buf->hi.vtX, -1);
+  }
+  else
+  {
+    wSp->cnt = 0;
+    (void )memset(wSp->kFin, 0, buf->nFin * sizeof(int));
+    (void )memset(wSp->kCrs, 0, buf->nCrs * sizeof(int));
+  }
+}
+
+/*!
+* \return	void
+* \ingroup      WlzValuesFilters
+* \brief	Adds (or removes) the values of a single line, through all
+* 		planes of the kernel, to (or from) the column histograms
+* 		of the current strip. Lines outside the buffer are ignored.
+* \param	buf			Histogram buffer.
+* \param	wSp			Histogram workspace.
+* \param	pln			Plane of the kernel centre relative to
+* 					the buffer.
+* \param	ln			Line relative to the buffer.
+* \param	inc			Increment, 1 to add or -1 to remove.
+*/
+static void	WlzRankFilterHistColLn(WlzRankHistBuf *buf,
+				       WlzRankHistWSp *wSp,
+				       int pln, int ln, int inc)
+{
+  int		idK,
+  		idZ,
+		z0,
+		z1;
+  unsigned short b;
+  int		*fP,
+  		*cP,
+		*nP;
+  unsigned short *bP;
+
+  if((ln >= 0) && (ln < buf->sz.vtY))
+  {
+    z0 = ALG_MAX(pln - buf->lo.vtZ, 0);
+    z1 = ALG_MIN(pln + buf->hi.vtZ, buf->sz.vtZ - 1);
+    for(idZ = z0; idZ <= z1; ++idZ)
+    {
+      bP = buf->bin + (((size_t )idZ * buf->sz.vtY) + ln) * buf->sz.vtX;
+      fP = wSp->cFin + ((size_t )(wSp->colFst - wSp->colOrg) * buf->nFin);
+      cP = wSp->cCrs + ((size_t )(wSp->colFst - wSp->colOrg) * buf->nCrs);
+      nP = wSp->cCnt + (wSp->colFst - wSp->colOrg);
+      for(idK = wSp->colFst; idK <= wSp->colLst; ++idK)
+      {
+	if((b = bP[idK]) != WLZ_RANK_HIST_EMPTY)
+	{
+	  fP[b] += inc;
+	  cP[b >> buf->crsSh] += inc;
+	  *nP += inc;
+	}
+	fP += buf->nFin;
+	cP += buf->nCrs;
+	++nP;
+      }
+    }
+  }
+}
+
+/*!
+* \return	void
+* \ingroup      WlzValuesFilters
+* \brief	Adds (or removes) the column histogram of a single column
+* 		to (or from) the coarse kernel histogram. Columns outside
+* 		the current strip are ignored.
+* \param	buf			Histogram buffer.
+* \param	wSp			Histogram workspace.
+* \param	kol			Column relative to the buffer.
+* \param	inc			Increment, 1 to add or -1 to remove.
+*/
+static void	WlzRankFilterHistKerCol(WlzRankHistBuf *buf,
+				        WlzRankHistWSp *wSp,
+				        int kol, int inc)
+{
+  int		idB;
+  int		*cP;
+
+  if((kol >= wSp->colFst) && (kol <= wSp->colLst))
+  {
+    kol -= wSp->colOrg;
+    cP = wSp->cCrs + ((size_t )kol * buf->nCrs);
+    for(idB = 0; idB < buf->nCrs; ++idB)
+    {
+      wSp->kCrs[idB] += inc * cP[idB];
+    }
+    wSp->cnt += inc * wSp->cCnt[kol];
+  }
+}
+
+/*!
+* \return	void
+* \ingroup      WlzValuesFilters
+* \brief	Moves the coarse kernel histogram one column to the right
+* 		by removing the column which leaves the kernel and adding
+* 		the column which enters it.
+* \param	buf			Histogram buffer.
+* \param	wSp			Histogram workspace.
+* \param	kol			New column of the kernel centre
+* 					relative to the buffer.
+*/
+static void	WlzRankFilterHistKerMove(WlzRankHistBuf *buf,
+					 WlzRankHistWSp *wSp, int kol)
+{
+  int		cI,
+  		cO;
+
+  cO = kol - buf->lo.vtX - 1;
+  cI = kol + buf->hi.vtX;
+  if((cO >= wSp->colFst) && (cI <= wSp->colLst))
+  {
+    int		idB;
+    int		*iP,
+    		*oP;
+
+    cO -= wSp->colOrg;
+    cI -= wSp->colOrg;
+    oP = wSp->cCrs + ((size_t )cO * buf->nCrs);
+    iP = wSp->cCrs + ((size_t )cI * buf->nCrs);
+    for(idB = 0; idB < buf->nCrs; ++idB)
+    {
+      wSp->kCrs[idB] += iP[idB] - oP[idB];
+    }
+    wSp->cnt += wSp->cCnt[cI] - wSp->cCnt[cO];
+  }
+  else
+  {
+    WlzRankFilterHistKerCol(buf, wSp, cO, -1);
+    WlzRankFilterHistKerCol(buf, wSp, cI, 1);
+  }
+}
+
+/*!
+* \return	void
+* \ingroup      WlzValuesFilters
+* \brief	Brings the fine kernel histogram bins of a single coarse
+* 		bin up to date for the given kernel column. If the kernel
+* 		has moved less than it's width since these bins were last
+* 		updated then the fine bins of the columns which have left
+* 		and entered the kernel are removed and added, otherwise
+* 		the fine bins are rebuilt from all the kernel's columns.
+* \param	buf			Histogram buffer.
+* \param	wSp			Histogram workspace.
+* \param	crs			Coarse bin index.
+* \param	kol			Column of the kernel centre relative
+* 					to the buffer.
+*/
+static void	WlzRankFilterHistFine(WlzRankHistBuf *buf,
+				      WlzRankHistWSp *wSp,
+				      int crs, int kol)
+{
+  int		idB,
+  		idK,
+		b0,
+		nB;
+  int		*kP,
+  		*cP;
+
+  b0 = crs << buf->crsSh;
+  nB = ALG_MIN(1 << buf->crsSh, buf->nFin - b0);
+  kP = wSp->kFin + b0;
+  cP = wSp->cFin + b0;
+  if(kol - wSp->luc[crs] < buf->fSz)
+  {
+    for(idK = wSp->luc[crs] + 1; idK <= kol; ++idK)
+    {
+      int	cI,
+      		cO;
+      int	*iP,
+      		*oP;
+
+      cO = idK - buf->lo.vtX - 1;
+      cI = idK + buf->hi.vtX;
+      oP = (cO >= wSp->colFst)?
+           cP + ((size_t )(cO - wSp->colOrg) * buf->nFin): NULL;
+      iP = (cI <= wSp->colLst)?
+           cP + ((size_t )(cI - wSp->colOrg) * buf->nFin): NULL;
+      if(oP && iP)
+      {
+	for(idB = 0; idB < nB; ++idB)
+	{
+	  kP[idB] += iP[idB] - oP[idB];
+	}
+      }
+      else
+      {
+	if(oP)
+	{
+	  for(idB = 0; idB < nB; ++idB)
+	  {
+	    kP[idB] -= oP[idB];
+	  }
+	}
+	if(iP)
+	{
+	  for(idB = 0; idB < nB; ++idB)
+	  {
+	    kP[idB] += iP[idB];
+	  }
+	}
+      }
+    }
+  }
+  else
+  {
+    int		k0,
+    		k1;
+
+    (void )memset(kP, 0, nB * sizeof(int));
+    k0 = ALG_MAX(kol - buf->lo.vtX, wSp->colFst);
+    k1 = ALG_MIN(kol + buf->hi.vtX, wSp->colLst);
+    for(idK = k0; idK <= k1; ++idK)
+    {
+      int	*iP;
+
+      iP = cP + ((size_t )(idK - wSp->colOrg) * buf->nFin);
+      for(idB = 0; idB < nB; ++idB)
+      {
+	kP[idB] += iP[idB];
+      }
+    }
+  }
+  wSp->luc[crs] = kol;
+}
+
+/*!
+* \return	Bin index of the value with the required rank.
+* \ingroup      WlzValuesFilters
+* \brief	Finds the bin index of the value with the required rank
+* 		in the kernel histogram, searching the coarse bins and then
+* 		the fine bins within the coarse bin found, which are first
+* 		brought up to date when column histograms are used. The
+* 		rank index is computed in the same way as for the other
+* 		grey types.
+* \param	buf			Histogram buffer.
+* \param	wSp			Histogram workspace.
+* \param	kol			Column of the kernel centre relative
+* 					to the buffer.
+*/
+static int	WlzRankFilterHistRank(WlzRankHistBuf *buf,
+				      WlzRankHistWSp *wSp, int kol)
+{
+  int		idB,
+  		lstB,
+  		idC = 0,
+  		sum = 0,
+		rankI;
+
+  rankI = (int )floor(wSp->cnt * buf->rank);
+  while((idC < buf->nCrs - 1) && (sum + wSp->kCrs[idC] <= rankI))
+  {
+    sum += wSp->kCrs[idC++];
+  }
+  if(buf->useCol)
+  {
+    WlzRankFilterHistFine(buf, wSp, idC, kol);
+  }
+  idB = idC << buf->crsSh;
+  lstB = ALG_MIN(((idC + 1) << buf->crsSh), buf->nFin) - 1;
+  while((idB < lstB) && (sum + wSp->kFin[idB] <= rankI))
+  {
+    sum += wSp->kFin[idB++];
+  }
+  return(idB);
+}
+
+/*!
+* \return	New histogram workspace or NULL on allocation failure.
+* \ingroup      WlzValuesFilters
+* \brief	Allocates a histogram workspace for the given buffer.
+* \param	buf			Histogram buffer.
+*/
+static WlzRankHistWSp *WlzRankFilterHistMakeWSp(WlzRankHistBuf *buf)
+{
+  size_t	nCol;
+  WlzRankHistWSp *wSp;
+
+  nCol = buf->stripW + buf->fSz - 1;
+  if((wSp = (WlzRankHistWSp *)AlcCalloc(1, sizeof(WlzRankHistWSp))) != NULL)
+  {
+    if(((wSp->kFin = (int *)AlcMalloc(buf->nFin * sizeof(int))) == NULL) ||
+       ((wSp->kCrs = (int *)AlcMalloc(buf->nCrs * sizeof(int))) == NULL) ||
+       (buf->useCol &&
+        (((wSp->luc = (int *)AlcMalloc(buf->nCrs * sizeof(int))) == NULL) ||
+         ((wSp->cCnt = (int *)AlcMalloc(nCol * sizeof(int))) == NULL) ||
+         ((wSp->cFin = (int *)
+		       AlcMalloc(nCol * buf->nFin * sizeof(int))) == NULL) ||
+         ((wSp->cCrs = (int *)
+		       AlcMalloc(nCol * buf->nCrs * sizeof(int))) == NULL))))
+    {
+      WlzRankFilterHistFreeWSp(wSp);
+      wSp = NULL;
+    }
+  }
+  return(wSp);
+}
+
+/*!
+* \return	void
+* \ingroup      WlzValuesFilters
+* \brief	Frees a histogram workspace.
+* \param	wSp			Histogram workspace, may be NULL.
+*/
+static void	WlzRankFilterHistFreeWSp(WlzRankHistWSp *wSp)
+{
+  if(wSp)
+  {
+    AlcFree(wSp->kFin);
+    AlcFree(wSp->kCrs);
+    AlcFree(wSp->luc);
+    AlcFree(wSp->cCnt);
+    AlcFree(wSp->cFin);
+    AlcFree(wSp->cCrs);
+    AlcFree(wSp);
+  }
+}
+
 /* #define WLZ_RANK_TEST */
 #ifdef WLZ_RANK_TEST
 
@@ -48,6 +48,7 @@ static char _WlzReadObj_c[] = "University of Edinburgh $Id$";
 #include <errno.h>
 #include <unistd.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #endif
 
 /* #define WLZ_DEBUG_READOBJ */
@@ -66,17 +67,21 @@ static WlzPlaneDomain 		*WlzReadPlaneDomain(
 static WlzErrorNum		WlzReadGreyValues(
 				  FILE *fp,
 				  WlzObjectType type,
-				  WlzObject *obj);
+				  WlzObject *obj,
+				  int map);
 static WlzErrorNum		WlzReadRectVtb(
 				  FILE *fp,
 				  WlzObject *obj,
-				  WlzObjectType type);
+				  WlzObjectType type,
+				  int map);
 static WlzErrorNum 		WlzReadDomObjValues2D(
 				  FILE *fP,
-				  WlzObject *obj);
+				  WlzObject *obj,
+				  int map);
 static WlzErrorNum 		WlzReadDomObjValues3D(
 				  FILE *fP,
-				  WlzObject *obj);
+				  WlzObject *obj,
+				  int map);
 static WlzErrorNum 		WlzReadTiledValues(
 				  FILE *fP,
 				  WlzObject *obj,
@@ -85,7 +90,8 @@ static WlzErrorNum 		WlzReadTiledValues(
 				  int map);
 static WlzErrorNum		WlzReadVoxelValues(
 				  FILE *fp,
-				  WlzObject *obj);
+				  WlzObject *obj,
+				  int map);
 static WlzProperty	 	WlzReadProperty(
 				  FILE *fp,
 				  WlzErrorNum *);
@@ -146,6 +152,38 @@ static WlzErrorNum 		WlzReadDouble(
 				  FILE *fP,
 				  double *iP,
 				  size_t nI);
+static WlzObject		*WlzReadObjWithMap(
+				  FILE *fP,
+				  int map,
+				  WlzErrorNum *dstErr);
+#ifdef WLZ_USE_MMAP
+static void			*WlzReadMapGreyBlock(
+				  FILE *fP,
+				  WlzGreyType gType,
+				  WlzGreyType packing,
+				  size_t nG,
+				  void **freeptr);
+static void			WlzReadMapFree(
+				  void *data);
+#endif /* WLZ_USE_MMAP */
+static WlzErrorNum		WlzReadGreyBlock(
+				  FILE *fP,
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  WlzGreyType packing,
+				  size_t nG);
+static void			WlzReadSwapWords(
+				  WlzUInt *wP,
+				  size_t nW);
+static void			WlzReadSwapShorts(
+				  unsigned short *sP,
+				  size_t nS);
+static void			WlzReadSwapFloats(
+				  WlzUInt *wP,
+				  size_t nW);
+static void			WlzReadSwapDoubles(
+				  WlzUInt *wP,
+				  size_t nD);
 static WlzErrorNum 		WlzReadVertex2D(
 				  FILE *fP,
 				  WlzDVertex2 *vP,
@@ -291,6 +329,33 @@ static WlzErrorNum 		WlzReadBox3D(
 		(T).dbv = (S).dbv;
 #endif /* __x86 || __alpha */
 
+/* This macro is non-zero if grey values of the given type are stored in
+ * the Woolz file format with the architecture's native byte order, in
+ * which case they may be used directly from a memory mapped file. */
+#if defined (__sparc) || defined (__mips) || defined (__ppc)
+#define WLZ_READ_GREY_NATIVE(G) \
+		((G) == WLZ_GREY_UBYTE)
+#endif /* __sparc || __mips */
+#if defined (__x86) || defined (__alpha)
+#define WLZ_READ_GREY_NATIVE(G) \
+		(((G) != WLZ_GREY_FLOAT) && ((G) != WLZ_GREY_ERROR))
+#endif /* __x86 || __alpha */
+
+#ifdef WLZ_USE_MMAP
+/*!
+* \struct	_WlzReadMapping
+* \ingroup	WlzIO
+* \brief	A memory mapped region of a file which is owned by the
+* 		free stack of a value table.
+* 		Typedef: ::WlzReadMapping.
+*/
+typedef struct _WlzReadMapping
+{
+  void			*addr;		/*!< Start of the mapped region. */
+  size_t		len;		/*!< Length of the mapped region. */
+} WlzReadMapping;
+#endif /* WLZ_USE_MMAP */
+
 /*!
 * \return	The word value.
 * \ingroup	WlzIO
@@ -360,6 +425,310 @@ static double 	getdouble(FILE *fp)
   return(out.dbv);
 }
 
+/*!
+* \ingroup	WlzIO
+* \brief	Converts a buffer of 4 byte words in place from the Woolz
+* 		file byte order to the native byte order. This is the
+* 		block equivalent of WLZ_SWAP_IN_WORD(). The loop is written
+* 		using whole word shifts and masks so that it may be
+* 		vectorised by the compiler.
+* \param	wP			Buffer of words.
+* \param	nW			Number of words in the buffer.
+*/
+static void	WlzReadSwapWords(WlzUInt *wP, size_t nW)
+{
+#if defined (__sparc) || defined (__mips) || defined (__ppc)
+  size_t	i;
+
+  for(i = 0; i < nW; ++i)
+  {
+    WlzUInt	w;
+
+    w = wP[i];
+    wP[i] = (w << 24) | ((w & 0x0000ff00) << 8) |
+            ((w & 0x00ff0000) >> 8) | (w >> 24);
+  }
+#endif /* __sparc || __mips */
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Converts a buffer of 2 byte shorts in place from the Woolz
+* 		file byte order to the native byte order. This is the
+* 		block equivalent of WLZ_SWAP_IN_SHORT().
+* \param	sP			Buffer of shorts.
+* \param	nS			Number of shorts in the buffer.
+*/
+static void	WlzReadSwapShorts(unsigned short *sP, size_t nS)
+{
+#if defined (__sparc) || defined (__mips) || defined (__ppc)
+  size_t	i;
+
+  for(i = 0; i < nS; ++i)
+  {
+    unsigned short s;
+
+    s = sP[i];
+    sP[i] = (unsigned short )((s << 8) | (s >> 8));
+  }
+#endif /* __sparc || __mips */
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Converts a buffer of 4 byte floats in place from the Woolz
+* 		(DEC VAX) file format to native floats. This is the block
+* 		equivalent of WLZ_SWAP_IN_FLOAT(): the 16 bit halves are
+* 		reordered and the most significant byte of the result is
+* 		decremented. Because the decrement is applied to the most
+* 		significant byte of the word any borrow is discarded, which
+* 		gives the same result as the byte arithmetic of the macro.
+* \param	wP			Buffer of floats accessed as words.
+* \param	nW			Number of floats in the buffer.
+*/
+static void	WlzReadSwapFloats(WlzUInt *wP, size_t nW)
+{
+  size_t	i;
+
+  for(i = 0; i < nW; ++i)
+  {
+    WlzUInt	w;
+
+    w = wP[i];
+#if defined (__sparc) || defined (__mips) || defined (__ppc)
+    w = ((w & 0x00ff00ff) << 8) | ((w & 0xff00ff00) >> 8);
+#endif /* __sparc || __mips */
+#if defined (__x86) || defined (__alpha)
+    w = (w << 16) | (w >> 16);
+#endif /* __x86 || __alpha */
+    wP[i] = w - 0x01000000;
+  }
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Converts a buffer of 8 byte doubles in place from the Woolz
+* 		file byte order to the native byte order. This is the block
+* 		equivalent of WLZ_SWAP_IN_DOUBLE().
+* \param	wP			Buffer of doubles accessed as pairs of
+* 					words.
+* \param	nD			Number of doubles in the buffer.
+*/
+static void	WlzReadSwapDoubles(WlzUInt *wP, size_t nD)
+{
+#if defined (__sparc) || defined (__mips) || defined (__ppc)
+  size_t	i;
+
+  WlzReadSwapWords(wP, 2 * nD);
+  for(i = 0; i < nD; ++i)
+  {
+    WlzUInt	w;
+
+    w = wP[2 * i];
+    wP[2 * i] = wP[2 * i + 1];
+    wP[2 * i + 1] = w;
+  }
+#endif /* __sparc || __mips */
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Reads a block of grey values, stored in the file using the
+* 		given packing, into a buffer of values of the given grey
+* 		type using a single read. The values are read directly into
+* 		the destination buffer and then converted in place. When
+* 		the packing is narrower than the grey type the packed
+* 		values are read into the tail of the buffer and then
+* 		widened from the start of the buffer, so no workspace is
+* 		needed.
+* 		Valid grey type and packing combinations are those written
+* 		by WlzWriteObj(): int values may be packed as int, short
+* 		or unsigned byte; short values as short or unsigned byte
+* 		and all other grey types are only packed as themselves.
+* \param	fP			Input file.
+* \param	gP			Destination buffer which must have
+* 					room for at least nG values of the
+* 					given grey type.
+* \param	gType			Grey type of the destination buffer.
+* \param	packing			Grey type of the values in the file.
+* \param	nG			Number of values to read.
+*/
+static WlzErrorNum WlzReadGreyBlock(FILE *fP, WlzGreyP gP,
+				    WlzGreyType gType, WlzGreyType packing,
+				    size_t nG)
+{
+  size_t	i,
+  		gSz,
+		pSz;
+  WlzGreyP	pP;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(nG == 0)
+  {
+    return(WLZ_ERR_NONE);
+  }
+  gSz = WlzGreySize(gType);
+  pSz = WlzGreySize(packing);
+  if((gSz == 0) || (pSz == 0) || (pSz > gSz) ||
+     ((pSz < gSz) && (gType != WLZ_GREY_INT) && (gType != WLZ_GREY_SHORT)) ||
+     ((pSz == gSz) && (packing != gType)))
+  {
+    return(WLZ_ERR_GREY_TYPE);
+  }
+  pP.ubp = gP.ubp + (nG * (gSz - pSz));
+  if(fread(pP.v, pSz, nG, fP) != nG)
+  {
+    errNum = WLZ_ERR_READ_INCOMPLETE;
+  }
+  else
+  {
+    switch(packing)
+    {
+      case WLZ_GREY_INT:  /* FALLTHROUGH */
+      case WLZ_GREY_RGBA:
+	WlzReadSwapWords(pP.rgbp, nG);
+	break;
+      case WLZ_GREY_SHORT:
+	WlzReadSwapShorts((unsigned short *)(pP.shp), nG);
+	break;
+      case WLZ_GREY_FLOAT:
+	WlzReadSwapFloats(pP.rgbp, nG);
+	break;
+      case WLZ_GREY_DOUBLE:
+	WlzReadSwapDoubles(pP.rgbp, nG);
+	break;
+      default:
+	break;
+    }
+    if(pSz < gSz)
+    {
+      /* Widen in place, each value is read before its destination can
+       * overwrite any packed value which has not yet been read. */
+      switch(gType)
+      {
+	case WLZ_GREY_INT:
+	  if(packing == WLZ_GREY_SHORT)
+	  {
+	    for(i = 0; i < nG; ++i)
+	    {
+	      gP.inp[i] = pP.shp[i];
+	    }
+	  }
+	  else
+	  {
+	    for(i = 0; i < nG; ++i)
+	    {
+	      gP.inp[i] = pP.ubp[i];
+	    }
+	  }
+	  break;
+	case WLZ_GREY_SHORT:
+	  for(i = 0; i < nG; ++i)
+	  {
+	    gP.shp[i] = pP.ubp[i];
+	  }
+	  break;
+	default:
+	  break;
+      }
+    }
+  }
+  return(errNum);
+}
+
+#ifdef WLZ_USE_MMAP
+/*!
+* \return	Pointer to the mapped grey values or NULL if the values
+* 		could not be mapped.
+* \ingroup	WlzIO
+* \brief	Attempts to memory map a block of grey values from the
+* 		current position of the given file. This is only possible
+* 		if the values are unpacked, stored using the native byte
+* 		order, aligned for their grey type within the file and
+* 		the file is a regular file which is long enough to hold
+* 		them. On success the file position is moved past the
+* 		values and the mapping is pushed onto the given free
+* 		stack, otherwise the file position is unchanged so that
+* 		the values may be read.
+* \param	fP			Input file.
+* \param	gType			Grey type of the values.
+* \param	packing			Grey type of the values in the file.
+* \param	nG			Number of grey values.
+* \param	freeptr			Free stack which is to own the
+* 					mapping.
+*/
+static void	*WlzReadMapGreyBlock(FILE *fP, WlzGreyType gType,
+				     WlzGreyType packing, size_t nG,
+				     void **freeptr)
+{
+  int		fd;
+  long		off,
+  		pgSz;
+  size_t	gSz;
+  struct stat	st;
+  void		*fStk;
+  WlzReadMapping *map = NULL;
+  WlzUByte	*gP = NULL;
+
+  if((nG > 0) && (packing == gType) && WLZ_READ_GREY_NATIVE(gType) &&
+     ((fd = fileno(fP)) >= 0) && ((off = ftell(fP)) >= 0) &&
+     ((pgSz = sysconf(_SC_PAGESIZE)) > 0) &&
+     (fstat(fd, &st) == 0) && S_ISREG(st.st_mode))
+  {
+    gSz = WlzGreySize(gType);
+    if(((off % gSz) == 0) && ((off + (nG * gSz)) <= st.st_size) &&
+       ((map = (WlzReadMapping *)AlcMalloc(sizeof(WlzReadMapping))) != NULL))
+    {
+      long	mOff;
+
+      mOff = off - (off % pgSz);
+      map->len = (off - mOff) + (nG * gSz);
+      map->addr = mmap(NULL, map->len, PROT_READ | PROT_WRITE,
+		       MAP_PRIVATE | MAP_FILE | MAP_NORESERVE, fd, mOff);
+      if(map->addr != MAP_FAILED)
+      {
+	if((fseek(fP, off + (nG * gSz), SEEK_SET) == 0) &&
+	   ((fStk = AlcFreeStackPushFn(*freeptr, map, WlzReadMapFree,
+				       NULL)) != NULL))
+	{
+	  *freeptr = fStk;
+	  gP = (WlzUByte *)(map->addr) + (off - mOff);
+	}
+	else
+	{
+	  (void )munmap(map->addr, map->len);
+	  (void )fseek(fP, off, SEEK_SET);
+	}
+      }
+      if(gP == NULL)
+      {
+	AlcFree(map);
+      }
+    }
+  }
+  return(gP);
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Unmaps and frees a memory mapped region of a file. This
+* 		is called when the free stack which owns the mapping is
+* 		freed.
+* \param	data			The mapping.
+*/
+static void	WlzReadMapFree(void *data)
+{
+  WlzReadMapping *map;
+
+  if((map = (WlzReadMapping *)data) != NULL)
+  {
+    (void )munmap(map->addr, map->len);
+    AlcFree(map);
+  }
+}
+#endif /* WLZ_USE_MMAP */
+
 /*!
 * \return	Woolz object type as read from file.
 * \ingroup	WlzIO
@@ -400,6 +769,195 @@ WlzObjectType	WlzReadObjType(FILE *fP, WlzErrorNum *dstErr)
   return(type);
 }
 
+/*!
+* \return	New plane stream or NULL on error.
+* \ingroup	WlzIO
+* \brief	Opens a plane stream for reading a 3D domain object from
+* 		the given input file one plane at a time. The object type,
+* 		plane domain and the voxel value table header are read
+* 		immediately but the values of each plane are only read
+* 		by WlzPlaneStreamReadPlane(), allowing objects which are
+* 		far larger than the available memory to be processed.
+* 		The stream must be closed using WlzPlaneStreamClose(),
+* 		which does not close the file.
+* \param	fP			Input file.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzPlaneStream	*WlzPlaneStreamOpenRead(FILE *fP, WlzErrorNum *dstErr)
+{
+  WlzObjectType	type;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzPixelV	bgdV;
+  WlzObject	*obj = NULL;
+  WlzPlaneStream *str = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  type = WlzReadObjType(fP, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(type == (WlzObjectType )EOF)
+    {
+      errNum = WLZ_ERR_READ_EOF;
+    }
+    else if(type != WLZ_3D_DOMAINOBJ)
+    {
+      errNum = WLZ_ERR_OBJECT_TYPE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((dom.p = WlzReadPlaneDomain(fP, &errNum)) == NULL)
+    {
+      if(errNum == WLZ_ERR_NONE)
+      {
+        errNum = WLZ_ERR_DOMAIN_NULL;
+      }
+    }
+    else if(dom.p->type != WLZ_PLANEDOMAIN_DOMAIN)
+    {
+      errNum = WLZ_ERR_DOMAIN_TYPE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    obj = WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, val, NULL, NULL, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    type = (WlzObjectType )getc(fP);
+    if(type == (WlzObjectType )EOF)
+    {
+      errNum = WLZ_ERR_READ_INCOMPLETE;
+    }
+    else if(type == WLZ_VOXELVALUETABLE_GREY)
+    {
+      bgdV.type = WLZ_GREY_INT;
+      bgdV.v.inv = getword(fP);
+      val.vox = WlzMakeVoxelValueTb(WLZ_VOXELVALUETABLE_GREY,
+				    dom.p->plane1, dom.p->lastpl,
+				    bgdV, obj, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+        obj->values = WlzAssignValues(val, NULL);
+      }
+    }
+    else if(type != WLZ_NULL)
+    {
+      /* Tiled values are not read plane by plane. */
+      errNum = WLZ_ERR_VALUES_TYPE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((str = (WlzPlaneStream *)
+              AlcCalloc(1, sizeof(WlzPlaneStream))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      str->fP = fP;
+      str->obj = WlzAssignObject(obj, NULL);
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    if(obj)
+    {
+      (void )WlzFreeObj(obj);
+    }
+    else if(dom.core)
+    {
+      (void )WlzFreePlaneDomain(dom.p);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(str);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Reads the values of the next plane of a plane stream
+* 		opened by WlzPlaneStreamOpenRead() into the stream's
+* 		object. Once the values of the last plane have been read
+* 		the object's property list is also read. The values of a
+* 		plane remain in the stream's object until they are freed
+* 		by the caller.
+* \param	str			Given plane stream.
+*/
+WlzErrorNum	WlzPlaneStreamReadPlane(WlzPlaneStream *str)
+{
+  int		idP,
+  		nPl;
+  WlzObjectType	gtt;
+  WlzValues	nullVal;
+  WlzObject	*tObj = NULL;
+  WlzPlaneDomain *pDom;
+  WlzVoxelValues *vox;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((str == NULL) || (str->obj == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(str->write)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    idP = str->nxtPl;
+    pDom = str->obj->domain.p;
+    nPl = pDom->lastpl - pDom->plane1 + 1;
+    if(idP >= nPl)
+    {
+      errNum = WLZ_ERR_READ_EOF;
+    }
+    else if(str->obj->values.core != NULL)
+    {
+      nullVal.core = NULL;
+      vox = str->obj->values.vox;
+      tObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, pDom->domains[idP], nullVal,
+      			 NULL, NULL, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	gtt = (WlzObjectType )getc(str->fP);
+	errNum = WlzReadGreyValues(str->fP, gtt, tObj, 0);
+      }
+      if((errNum == WLZ_ERR_NONE) && (tObj->values.core != NULL))
+      {
+	vox->values[idP] = WlzAssignValues(tObj->values, NULL);
+	if(str->bgdSet == 0)
+	{
+	  vox->bckgrnd = WlzGetBackground(tObj, NULL);
+	  str->bgdSet = 1;
+	}
+      }
+      (void )WlzFreeObj(tObj);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if(feof(str->fP))
+      {
+        errNum = WLZ_ERR_READ_INCOMPLETE;
+      }
+      else if(++(str->nxtPl) >= nPl)
+      {
+	str->obj->plist = WlzAssignPropertyList(
+			  WlzReadPropertyList(str->fP, NULL), NULL);
+      }
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	New Woolz object or NULL on error.
 * \ingroup	WlzIO
@@ -411,6 +969,54 @@ WlzObjectType	WlzReadObjType(FILE *fP, WlzErrorNum *dstErr)
 * \param	dstErr			Destination error pointer, may be NULL.
 */
 WlzObject 	*WlzReadObj(FILE *fp, WlzErrorNum *dstErr)
+{
+  return(WlzReadObjWithMap(fp, 0, dstErr));
+}
+
+/*!
+* \return	New Woolz object or NULL on error.
+* \ingroup	WlzIO
+* \brief	Reads a woolz object from the given input stream, as
+* 		WlzReadObj() does, but with the values of 2D and 3D
+* 		domain objects which have rectangular value tables
+* 		memory mapped from the file rather than being read
+* 		into allocated memory, whenever this is possible.
+* 		A table can only be mapped if its values are stored
+* 		in the file unpacked, using the native byte order (so
+* 		never for float values) and are suitably aligned within
+* 		the file; all other value tables are read as by
+* 		WlzReadObj(). Mapping allows large objects to be opened
+* 		almost instantly and the pages of the file to be shared
+* 		between processes.
+*
+* 		The mapping is private, so values may be modified without
+* 		the file being changed (modified pages are copied). Each
+* 		mapping is owned by the free stack (freeptr) of it's value
+* 		table and is unmapped when the table is freed. The file
+* 		stream may be closed once the object has been read, but
+* 		the file should not be truncated or rewritten while the
+* 		object exists.
+* \param	fP			Input file, this must be a regular
+* 					file opened for reading.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject 	*WlzReadObjMapped(FILE *fP, WlzErrorNum *dstErr)
+{
+  return(WlzReadObjWithMap(fP, 1, dstErr));
+}
+
+/*!
+* \return	New Woolz object or NULL on error.
+* \ingroup	WlzIO
+* \brief	Reads a woolz object from the given input stream, see
+* 		WlzReadObj() and WlzReadObjMapped().
+* \param	fp			Input file.
+* \param	map			If non zero rectangular value tables
+* 					of domain objects are memory mapped
+* 					when possible.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+static WlzObject *WlzReadObjWithMap(FILE *fp, int map, WlzErrorNum *dstErr)
 {
   WlzObjectType		type;
   WlzObject 		*obj;
@@ -448,7 +1054,7 @@ WlzObject 	*WlzReadObj(FILE *fp, WlzErrorNum *dstErr)
 	   ((obj = WlzMakeMain(type, domain, values, NULL, NULL,
 			       &errNum)) != NULL))
 	{
-	  if((errNum = WlzReadDomObjValues2D(fp, obj)) == WLZ_ERR_NONE)
+	  if((errNum = WlzReadDomObjValues2D(fp, obj, map)) == WLZ_ERR_NONE)
 	  {
 	    obj->plist = WlzAssignPropertyList(WlzReadPropertyList(fp, NULL),
 					       NULL);
@@ -463,7 +1069,7 @@ WlzObject 	*WlzReadObj(FILE *fp, WlzErrorNum *dstErr)
 	   ((obj = WlzMakeMain(type, domain, values, NULL, NULL,
 			       &errNum)) != NULL ))
 	{
-	  if((errNum = WlzReadDomObjValues3D(fp, obj)) == WLZ_ERR_NONE)
+	  if((errNum = WlzReadDomObjValues3D(fp, obj, map)) == WLZ_ERR_NONE)
 	  {
 	    obj->plist = WlzAssignPropertyList(WlzReadPropertyList(fp, NULL),
 					       NULL);
@@ -672,17 +1278,7 @@ static WlzErrorNum WlzReadInt(FILE *fP, int *iP, size_t nI)
   }
   else
   {
-    int		i;
-
-    for(i = 0; i < nI; ++i)
-    {
-      WlzGreyV	in,
-		out;
-
-      in.inv = iP[i];
-      WLZ_SWAP_IN_WORD(out, in);
-      iP[i] = out.inv;
-    }
+    WlzReadSwapWords((WlzUInt *)iP, nI);
   }
   return(errNum);
 }
@@ -709,17 +1305,7 @@ static WlzErrorNum WlzReadShort(FILE *fP, short *iP, size_t nI)
   }
   else
   {
-    int		i;
-
-    for(i = 0; i < nI; ++i)
-    {
-      WlzGreyV	in,
-		out;
-
-      in.shv = iP[i];
-      WLZ_SWAP_IN_SHORT(out, in);
-      iP[i] = out.shv;
-    }
+    WlzReadSwapShorts((unsigned short *)iP, nI);
   }
   return(errNum);
 }
@@ -767,17 +1353,7 @@ static WlzErrorNum WlzReadFloat(FILE *fP, float *iP, size_t nI)
   }
   else
   {
-    int		i;
-
-    for(i = 0; i < nI; ++i)
-    {
-      WlzGreyV	in,
-		out;
-
-      in.flv = iP[i];
-      WLZ_SWAP_IN_FLOAT(out, in);
-      iP[i] = out.flv;
-    }
+    WlzReadSwapFloats((WlzUInt *)iP, nI);
   }
   return(errNum);
 }
@@ -804,17 +1380,7 @@ static WlzErrorNum WlzReadDouble(FILE *fP, double *iP, size_t nI)
   }
   else
   {
-    int		i;
-
-    for(i = 0; i < nI; ++i)
-    {
-      WlzGreyV	in,
-		out;
-
-      in.dbv = iP[i];
-      WLZ_SWAP_IN_DOUBLE(out, in);
-      iP[i] = out.dbv;
-    }
+    WlzReadSwapDoubles((WlzUInt *)iP, nI);
   }
   return(errNum);
 }
@@ -1462,23 +2028,28 @@ static WlzPlaneDomain *WlzReadPlaneDomain(FILE *fp,
 * \return	Woolz error code.
 * \ingroup	WlzIO
 * \brief	Reads a Woolz grey-value table from the given file.
+* 		The grey values of each interval are read using a single
+* 		block read (see WlzReadGreyBlock()) rather than one read
+* 		per value.
 * \param	fp			Input file.
 * \param	type			Type encoding grey and table type.
 * \param	obj			Object defining the domain of the
 *					grey values.
+* \param	map			If non zero rectangular value tables
+* 					are memory mapped when possible.
 */
 static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
-				     WlzObject *obj)
+				     WlzObject *obj, int map)
 {
   WlzGreyType		gtype;
   WlzIntervalWSpace 	iwsp;
   WlzValues		values;
   WlzGreyType		packing;
   int 			l1, ll, k1, kstart = 0;
-  int 			i;
   WlzPixelV 		backgrnd;
   WlzGreyP		v, g;
-  size_t		table_size;
+  size_t		gSz,
+  			table_size;
   WlzErrorNum		errNum=WLZ_ERR_NONE;
 
   if( type == (WlzObjectType )EOF )
@@ -1521,392 +2092,138 @@ static WlzErrorNum WlzReadGreyValues(FILE *fp, WlzObjectType type,
     return errNum;
   }
 
-  l1 = obj->domain.i->line1;
-  ll = obj->domain.i->lastln;
-  k1 = obj->domain.i->kol1;
-  backgrnd.type = gtype;
   switch (type) {
 
-  case WLZ_VALUETABLE_RAGR_INT:
-
-    packing = (WlzGreyType) getc(fp);
-
-    backgrnd.v.inv = getword(fp);
-
-    /* create the value table */
-    if( (values.v = WlzMakeValueTb(type, l1, ll, k1,
-				   backgrnd, obj, &errNum)) == NULL ){
-      return errNum;
-    }
-    values.v->width = obj->domain.i->lastkl - k1 + 1;
-    obj->values = WlzAssignValues(values, NULL);
-
-    /* allocate space for the pixel values, preset to background value */
-    table_size = WlzLineArea(obj, NULL) * sizeof(int);
-    if( (v.inp = (int *) AlcMalloc(table_size)) == NULL){
-      WlzFreeValueTb(values.v);
-      obj->values.v = NULL;
-      return WLZ_ERR_MEM_ALLOC;
-    }
-    memset((void *) v.inp, backgrnd.v.inv, table_size);
-    values.v->freeptr = AlcFreeStackPush(values.v->freeptr, (void *)v.inp,
-    				         NULL);
-
-    if( (errNum = WlzInitRasterScan(obj, &iwsp,
-    				    WLZ_RASTERDIR_ILIC)) == WLZ_ERR_NONE ){
-      while((errNum = WlzNextInterval(&iwsp)) == WLZ_ERR_NONE) {
-	if (iwsp.nwlpos){
-	  kstart = iwsp.lftpos;
-	}
-	switch (packing) {
-	case WLZ_GREY_INT:
-	  g.inp = v.inp+iwsp.lftpos-kstart;
-	  for (i=0; i<iwsp.colrmn; i++){
-	    *g.inp++ = getword(fp);
-	  }
-	  break;
-	case WLZ_GREY_SHORT:
-	  g.inp = v.inp+iwsp.lftpos-kstart;
-	  for (i=0; i<iwsp.colrmn; i++){
-	    *g.inp++ = getshort(fp);
-	  }
-	  break;
-	case WLZ_GREY_UBYTE:
-	  g.inp = v.inp+iwsp.lftpos-kstart;
-	  for (i=0; i<iwsp.colrmn; i++){
-
-		  *g.inp++ = getc(fp);
-
-	  }
-	  break;
-	default:
-	  errNum = WLZ_ERR_GREY_TYPE;
-	  break;
-	}
-	if (iwsp.intrmn == 0) {
-	  (void) WlzMakeValueLine(values.v, iwsp.linpos, kstart,
-				  iwsp.rgtpos, v.inp);
-	  v.inp += (iwsp.rgtpos - kstart + 1);
-	}
-      }
-      if (feof(fp) != 0){
-	WlzFreeValueTb(values.v);
-	obj->values.v = NULL;
-	errNum = WLZ_ERR_READ_INCOMPLETE;
-      }
-      else if( errNum == WLZ_ERR_EOO ){
-	errNum = WLZ_ERR_NONE;
-      }
-    }
-    return errNum;
-
-  case WLZ_VALUETABLE_RAGR_SHORT:
-
-    packing = (WlzGreyType) getc(fp);
-
-    backgrnd.v.shv = (short )getword(fp);
-
-    /* create the value table */
-    if( (values.v = WlzMakeValueTb(type, l1, ll, k1,
-				   backgrnd, obj, &errNum)) == NULL ){
-      return errNum;
-    }
-    values.v->width = obj->domain.i->lastkl - k1 + 1;
-    obj->values = WlzAssignValues(values, NULL);
+  case WLZ_VALUETABLE_RAGR_INT:    /* FALLTHROUGH */
+  case WLZ_VALUETABLE_RAGR_SHORT:  /* FALLTHROUGH */
+  case WLZ_VALUETABLE_RAGR_UBYTE:  /* FALLTHROUGH */
+  case WLZ_VALUETABLE_RAGR_FLOAT:  /* FALLTHROUGH */
+  case WLZ_VALUETABLE_RAGR_DOUBLE: /* FALLTHROUGH */
+  case WLZ_VALUETABLE_RAGR_RGBA:
+    break;
 
-    /* allocate space for the pixel values, preset to background value */
-    table_size = WlzLineArea(obj, NULL) * sizeof(short);
-    if( (v.shp = (short *) AlcMalloc(table_size)) == NULL){
-      WlzFreeValueTb(values.v);
-      obj->values.v = NULL;
-      return WLZ_ERR_MEM_ALLOC;
-    }
-    memset((void *) v.shp, (int) backgrnd.v.shv, table_size);
-    values.v->freeptr = AlcFreeStackPush(values.v->freeptr, (void *)v.shp,
-    					 NULL);
+  case WLZ_VALUETABLE_RECT_INT:    /* FALLTHROUGH */
+  case WLZ_VALUETABLE_RECT_SHORT:  /* FALLTHROUGH */
+  case WLZ_VALUETABLE_RECT_UBYTE:  /* FALLTHROUGH */
+  case WLZ_VALUETABLE_RECT_FLOAT:  /* FALLTHROUGH */
+  case WLZ_VALUETABLE_RECT_DOUBLE: /* FALLTHROUGH */
+  case WLZ_VALUETABLE_RECT_RGBA:
+    return WlzReadRectVtb(fp, obj, type, map);
 
-    if( (errNum = WlzInitRasterScan(obj, &iwsp,
-    				    WLZ_RASTERDIR_ILIC)) == WLZ_ERR_NONE ){
-      while((errNum = WlzNextInterval(&iwsp)) == WLZ_ERR_NONE) {
-	if (iwsp.nwlpos){
-	  kstart = iwsp.lftpos;
-	}
-	switch (packing) {
-	case WLZ_GREY_SHORT:
-	  g.shp = v.shp+iwsp.lftpos-kstart;
-	  for (i=0; i<iwsp.colrmn; i++){
-	    *g.shp++ = (short )getshort(fp);
-	  }
-	  break;
-	case WLZ_GREY_UBYTE:
-	  g.shp = v.shp+iwsp.lftpos-kstart;
-	  for (i=0; i<iwsp.colrmn; i++){
+  default:
+    /* this can't happen because the domain type has been checked
+       by WlzGreyValuesTableType */
+    return WLZ_ERR_VALUES_TYPE;
+  }
 
-		  *g.shp++ = (short )getc(fp);
+  l1 = obj->domain.i->line1;
+  ll = obj->domain.i->lastln;
+  k1 = obj->domain.i->kol1;
+  backgrnd.type = gtype;
+  packing = (WlzGreyType) getc(fp);
+  switch(gtype)
+  {
+    case WLZ_GREY_INT:
+      backgrnd.v.inv = getword(fp);
+      break;
+    case WLZ_GREY_SHORT:
+      backgrnd.v.shv = (short )getword(fp);
+      break;
+    case WLZ_GREY_UBYTE:
+      /* The packing is always that of the grey type for unsigned byte,
+       * float, double and RGBA values. */
+      backgrnd.v.ubv = (WlzUByte )getword(fp);
+      packing = gtype;
+      break;
+    case WLZ_GREY_FLOAT:
+      backgrnd.v.flv = getfloat(fp);
+      packing = gtype;
+      break;
+    case WLZ_GREY_DOUBLE:
+      backgrnd.v.dbv = getdouble(fp);
+      packing = gtype;
+      break;
+    case WLZ_GREY_RGBA:
+      backgrnd.v.rgbv = getword(fp);
+      packing = gtype;
+      break;
+    default:
+      return WLZ_ERR_GREY_TYPE;
+  }
 
-	  }
-	  break;
-	default:
-	  errNum = WLZ_ERR_GREY_TYPE;
-	  break;
-	}
-	if (iwsp.intrmn == 0) {
-	  (void) WlzMakeValueLine(values.v, iwsp.linpos, kstart,
-				  iwsp.rgtpos, v.inp);
-	  v.shp += (iwsp.rgtpos - kstart + 1);
-	}
-      }
-      if( feof(fp) != 0 ){
-	WlzFreeValueTb(values.v);
-	obj->values.v = NULL;
-	errNum = WLZ_ERR_READ_INCOMPLETE;
-      }
-      else if( errNum == WLZ_ERR_EOO ){
-	errNum = WLZ_ERR_NONE;
-      }
-    }
+  /* create the value table */
+  if( (values.v = WlzMakeValueTb(type, l1, ll, k1,
+				 backgrnd, obj, &errNum)) == NULL ){
     return errNum;
+  }
+  values.v->width = obj->domain.i->lastkl - k1 + 1;
+  obj->values = WlzAssignValues(values, NULL);
 
-  case WLZ_VALUETABLE_RAGR_UBYTE:
-
-    packing = (WlzGreyType) getc(fp);
-
-    backgrnd.v.ubv = (WlzUByte )getword(fp);
-
-    /* create the value table */
-    if( (values.v = WlzMakeValueTb(type, l1, ll, k1,
-				   backgrnd, obj, &errNum)) == NULL ){
-      return errNum;
-    }
-    values.v->width = obj->domain.i->lastkl - k1 + 1;
-    obj->values = WlzAssignValues(values, NULL);
-
-    /* allocate space for the pixel values, preset to background value */
-    table_size = WlzLineArea(obj, NULL) * sizeof(WlzUByte);
-    if( (v.ubp = (WlzUByte *) AlcMalloc(table_size)) == NULL){
-      WlzFreeValueTb(values.v);
-      obj->values.v = NULL;
-      return WLZ_ERR_MEM_ALLOC;
-    }
-    memset((void *) v.ubp, (int) backgrnd.v.ubv, table_size);
-    values.v->freeptr = AlcFreeStackPush(values.v->freeptr, (void *)v.ubp,
-    					 NULL);
-
-    if( (errNum = WlzInitRasterScan(obj, &iwsp,
-    				    WLZ_RASTERDIR_ILIC)) == WLZ_ERR_NONE ){
-      while((errNum = WlzNextInterval(&iwsp)) == WLZ_ERR_NONE) {
-	if (iwsp.nwlpos){
-	  kstart = iwsp.lftpos;
-	}
-	g.ubp = v.ubp+iwsp.lftpos-kstart;
-	for (i=0; i<iwsp.colrmn; i++){
-
-	  *g.ubp++ = (WlzUByte )getc(fp);
-
-	}
-	if (iwsp.intrmn == 0) {
-	  (void) WlzMakeValueLine(values.v, iwsp.linpos, kstart,
-				  iwsp.rgtpos, v.inp);
-	  v.ubp += (iwsp.rgtpos - kstart + 1);
-	}
-      }
-      if (feof(fp) != 0){
-	WlzFreeValueTb(values.v);
-	obj->values.v = NULL;
-	errNum = WLZ_ERR_READ_INCOMPLETE;
-      }
-      else if( errNum == WLZ_ERR_EOO ){
-	errNum = WLZ_ERR_NONE;
-      }
-    }
-    return( WLZ_ERR_NONE );
-
-  case WLZ_VALUETABLE_RAGR_FLOAT:
-
-    packing = (WlzGreyType) getc(fp);
-
-    backgrnd.v.flv = getfloat(fp);
-
-    /* create the value table */
-    if( (values.v = WlzMakeValueTb(type, l1, ll, k1,
-				   backgrnd, obj, &errNum)) == NULL ){
-      return errNum;
-    }
-    values.v->width = obj->domain.i->lastkl - k1 + 1;
-    obj->values = WlzAssignValues(values, NULL);
-
-    /* allocate space for the pixel values, preset to background */
-    table_size = WlzLineArea(obj, NULL) * sizeof(float);
-    if( (v.flp = (float *) AlcMalloc(table_size)) == NULL){
-      WlzFreeValueTb(values.v);
-      obj->values.v = NULL;
-      return WLZ_ERR_MEM_ALLOC;
-    }
-    memset((void *) v.flp, (int) backgrnd.v.flv, table_size);
-    values.v->freeptr = AlcFreeStackPush(values.v->freeptr, (void *)v.flp,
-    					 NULL);
+  /* allocate space for the pixel values, preset to background value */
+  gSz = WlzGreySize(gtype);
+  table_size = WlzLineArea(obj, NULL);
+  if( (v.v = AlcMalloc(table_size * gSz)) == NULL){
+    WlzFreeValueTb(values.v);
+    obj->values.v = NULL;
+    return WLZ_ERR_MEM_ALLOC;
+  }
+  WlzValueSetGrey(v, 0, backgrnd.v, gtype, table_size);
+  values.v->freeptr = AlcFreeStackPush(values.v->freeptr, v.v, NULL);
 
-    if( (errNum = WlzInitRasterScan(obj, &iwsp,
-    				    WLZ_RASTERDIR_ILIC)) == WLZ_ERR_NONE ){
-      while((errNum = WlzNextInterval(&iwsp)) == WLZ_ERR_NONE) {
-	if (iwsp.nwlpos){
-	  kstart = iwsp.lftpos;
-	}
-	g.flp = v.flp+iwsp.lftpos-kstart;
-	for (i=0; i<iwsp.colrmn; i++){
-	  *g.flp++ = getfloat(fp);
-	}
-	if (iwsp.intrmn == 0) {
-	  (void) WlzMakeValueLine(values.v, iwsp.linpos, kstart,
-				  iwsp.rgtpos, v.inp);
-	  v.flp += (iwsp.rgtpos - kstart + 1);
-	}
+  if( (errNum = WlzInitRasterScan(obj, &iwsp,
+				  WLZ_RASTERDIR_ILIC)) == WLZ_ERR_NONE ){
+    while((errNum = WlzNextInterval(&iwsp)) == WLZ_ERR_NONE) {
+      if (iwsp.nwlpos){
+	kstart = iwsp.lftpos;
       }
-      if (feof(fp) != 0){
-	WlzFreeValueTb(values.v);
-	obj->values.v = NULL;
-	errNum = WLZ_ERR_READ_INCOMPLETE;
+      g.ubp = v.ubp + (iwsp.lftpos - kstart) * gSz;
+      if((errNum = WlzReadGreyBlock(fp, g, gtype, packing,
+                                    iwsp.colrmn)) != WLZ_ERR_NONE) {
+	break;
       }
-      else if( errNum == WLZ_ERR_EOO ){
-	errNum = WLZ_ERR_NONE;
+      if (iwsp.intrmn == 0) {
+	(void) WlzMakeValueLine(values.v, iwsp.linpos, kstart,
+				iwsp.rgtpos, v.inp);
+	v.ubp += (iwsp.rgtpos - kstart + 1) * gSz;
       }
     }
-    return errNum;
-
-  case WLZ_VALUETABLE_RAGR_DOUBLE:
-
-    packing = (WlzGreyType) getc(fp);
-
-    backgrnd.v.dbv = getdouble(fp);
-
-    /* create the value table */
-    if( (values.v = WlzMakeValueTb(type, l1, ll, k1,
-				   backgrnd, obj, &errNum)) == NULL ){
-      return errNum;
-    }
-    values.v->width = obj->domain.i->lastkl - k1 + 1;
-    obj->values = WlzAssignValues(values, NULL);
-
-    /* allocate space for the pixel values, preset to background */
-    table_size = WlzLineArea(obj, NULL) * sizeof(double);
-    if( (v.dbp = (double *) AlcMalloc(table_size)) == NULL){
-      WlzFreeValueTb(values.v);
-      obj->values.v = NULL;
-      return WLZ_ERR_MEM_ALLOC;
-    }
-    memset((void *) v.dbp, (int) backgrnd.v.dbv, table_size);
-    values.v->freeptr = AlcFreeStackPush(values.v->freeptr, (void *)v.dbp,
-    					 NULL);
-
-    if( (errNum = WlzInitRasterScan(obj, &iwsp,
-    				    WLZ_RASTERDIR_ILIC)) == WLZ_ERR_NONE ){
-      while((errNum = WlzNextInterval(&iwsp)) == WLZ_ERR_NONE) {
-	if (iwsp.nwlpos){
-	  kstart = iwsp.lftpos;
-	}
-	g.dbp = v.dbp+iwsp.lftpos-kstart;
-	for (i=0; i<iwsp.colrmn; i++){
-	  *g.dbp++ = getdouble(fp);
-	}
-	if (iwsp.intrmn == 0) {
-	  (void) WlzMakeValueLine(values.v, iwsp.linpos, kstart,
-				  iwsp.rgtpos, v.inp);
-	  v.dbp += (iwsp.rgtpos - kstart + 1);
-	}
-      }
-      if (feof(fp) != 0){
-	WlzFreeValueTb(values.v);
-	obj->values.v = NULL;
-	errNum = WLZ_ERR_READ_INCOMPLETE;
-      }
-      else if( errNum == WLZ_ERR_EOO ){
-	errNum = WLZ_ERR_NONE;
-      }
+    if (feof(fp) != 0){
+      errNum = WLZ_ERR_READ_INCOMPLETE;
     }
-    return errNum;
-
-  case WLZ_VALUETABLE_RAGR_RGBA:
-    packing = (WlzGreyType) getc(fp);
-    backgrnd.v.rgbv = getword(fp);
-
-    /* create the value table */
-    if( (values.v = WlzMakeValueTb(type, l1, ll, k1,
-				   backgrnd, obj, &errNum)) == NULL ){
-      return errNum;
+    else if( errNum == WLZ_ERR_EOO ){
+      errNum = WLZ_ERR_NONE;
     }
-    values.v->width = obj->domain.i->lastkl - k1 + 1;
-    obj->values = WlzAssignValues(values, NULL);
-
-    /* allocate space for the pixel values, preset to background */
-    table_size = WlzLineArea(obj, NULL) * sizeof(WlzUInt);
-    if( (v.rgbp = (WlzUInt *) AlcMalloc(table_size)) == NULL){
-      WlzFreeValueTb(values.v);
+    if(errNum != WLZ_ERR_NONE){
+      (void )WlzFreeValueTb(values.v);
       obj->values.v = NULL;
-      return WLZ_ERR_MEM_ALLOC;
-    }
-    memset((void *) v.rgbp, (int) backgrnd.v.rgbv, table_size);
-    values.v->freeptr = AlcFreeStackPush(values.v->freeptr, (void *)v.rgbp,
-    					 NULL);
-
-    if( (errNum = WlzInitRasterScan(obj, &iwsp,
-    				    WLZ_RASTERDIR_ILIC)) == WLZ_ERR_NONE ){
-      while((errNum = WlzNextInterval(&iwsp)) == WLZ_ERR_NONE) {
-	if (iwsp.nwlpos){
-	  kstart = iwsp.lftpos;
-	}
-	g.rgbp = v.rgbp+iwsp.lftpos-kstart;
-	for (i=0; i<iwsp.colrmn; i++){
-	  *g.rgbp++ = getword(fp);
-	}
-	if (iwsp.intrmn == 0) {
-	  (void) WlzMakeValueLine(values.v, iwsp.linpos, kstart,
-				  iwsp.rgtpos, v.inp);
-	  v.rgbp += (iwsp.rgtpos - kstart + 1);
-	}
-      }
-      if (feof(fp) != 0){
-	WlzFreeValueTb(values.v);
-	obj->values.v = NULL;
-	errNum = WLZ_ERR_READ_INCOMPLETE;
-      }
-      else if( errNum == WLZ_ERR_EOO ){
-	errNum = WLZ_ERR_NONE;
-      }
     }
-    return errNum;
-
-  case WLZ_VALUETABLE_RECT_INT:
-  case WLZ_VALUETABLE_RECT_SHORT:
-  case WLZ_VALUETABLE_RECT_UBYTE:
-  case WLZ_VALUETABLE_RECT_FLOAT:
-  case WLZ_VALUETABLE_RECT_DOUBLE:
-  case WLZ_VALUETABLE_RECT_RGBA:
-    return WlzReadRectVtb(fp, obj, type);
-
-  default:
-    /* this can't happen because the domain type has been checked
-       by WlzGreyValuesTableType */
-    return WLZ_ERR_VALUES_TYPE;
   }
-
+  return errNum;
 }
 
 /*!
 * \return	Wolz error code.
 * \ingroup	WlzIO
-* \brief	Reads a Woolz rectangular grey table.
+* \brief	Reads a Woolz rectangular grey table. All the values of
+* 		the table are read using a single block read (see
+* 		WlzReadGreyBlock()) or, if requested and possible, are
+* 		memory mapped from the file (see WlzReadMapGreyBlock()).
 * \param	fp			Input file.
 * \param	obj			Object defining the domain of the
 *					grey values.
 * \param	type			Grey table type - encodes greytype.
+* \param	map			If non zero the values are memory
+* 					mapped when possible.
 */
 static WlzErrorNum WlzReadRectVtb(FILE 		*fp,
 				  WlzObject 	*obj,
-				  WlzObjectType type)
+				  WlzObjectType type,
+				  int		map)
 {
   WlzGreyP		values;
-  int 			i, num;
-  WlzGreyType		packing;
+  size_t 		num;
+  WlzGreyType		gType,
+  			packing;
   WlzIntervalDomain 	*idmn;
   WlzValues		vtb;
   WlzPixelV		bgd;
@@ -1918,45 +2235,60 @@ static WlzErrorNum WlzReadRectVtb(FILE 		*fp,
     return( WLZ_ERR_DOMAIN_NULL );
   }
 
-  bgd.type = WlzGreyTableTypeToGreyType( type, NULL );
+  gType = WlzGreyTableTypeToGreyType( type, NULL );
+  bgd.type = gType;
   bgd.v.inv = 0;
   if((vtb.r = WlzMakeRectValueTb(type, idmn->line1, idmn->lastln,
 				 idmn->kol1, idmn->lastkl-idmn->kol1 + 1,
 				 bgd, NULL, &errNum)) == NULL ){
     return errNum;
   }
-  num = vtb.r->width * (vtb.r->lastln - vtb.r->line1 + 1);
+  num = (size_t )(vtb.r->width) * (vtb.r->lastln - vtb.r->line1 + 1);
 
   /* test on pixel type to read background */
-  switch( WlzGreyTableTypeToGreyType( type, NULL ) ){
+  switch( gType ){
   case WLZ_GREY_INT:
     vtb.r->bckgrnd.v.inv = getword(fp);
-    values.inp = (int *) AlcMalloc(num*sizeof(int));
     break;
   case WLZ_GREY_SHORT:
     vtb.r->bckgrnd.v.shv = (short )getword(fp);
-    values.shp = (short *) AlcMalloc(num*sizeof(short));
     break;
   case WLZ_GREY_UBYTE:
+    /* The packing is always that of the grey type for unsigned byte,
+     * float, double and RGBA values. */
     vtb.r->bckgrnd.v.ubv = (WlzUByte )getword(fp);
-    values.ubp = (WlzUByte *) AlcMalloc(num*sizeof(WlzUByte));
+    packing = gType;
     break;
   case WLZ_GREY_FLOAT:
     vtb.r->bckgrnd.v.flv = getfloat(fp);
-    values.flp = (float *) AlcMalloc(num*sizeof(float));
+    packing = gType;
     break;
   case WLZ_GREY_DOUBLE:
     vtb.r->bckgrnd.v.dbv = getdouble(fp);
-    values.dbp = (double *) AlcMalloc(num*sizeof(double));
+    packing = gType;
     break;
   case WLZ_GREY_RGBA:
     vtb.r->bckgrnd.v.rgbv = getword(fp);
-    values.rgbp = (WlzUInt *) AlcMalloc(num*sizeof(WlzUInt));
+    packing = gType;
     break;
   default:
+    WlzFreeValueTb(vtb.v);
     return WLZ_ERR_GREY_TYPE;
     break;
   }
+  values.v = NULL;
+#ifdef WLZ_USE_MMAP
+  if(map){
+    values.v = WlzReadMapGreyBlock(fp, gType, packing, num,
+				   &(vtb.r->freeptr));
+    if(values.v != NULL){
+      vtb.r->values = values;
+      obj->values = WlzAssignValues(vtb, NULL);
+      return WLZ_ERR_NONE;
+    }
+  }
+#endif /* WLZ_USE_MMAP */
+  values.v = AlcMalloc(num * WlzGreySize(gType));
 
   if( values.inp == NULL ){
     WlzFreeValueTb(vtb.v);
@@ -1966,80 +2298,15 @@ static WlzErrorNum WlzReadRectVtb(FILE 		*fp,
   vtb.r->values = values;
   obj->values = WlzAssignValues(vtb, NULL);
 
-  switch( WlzGreyTableTypeToGreyType( type, NULL ) ) {
-
-  case WLZ_GREY_INT:
-    switch (packing) {
-    case WLZ_GREY_INT:
-      for (i=0 ; i<num ; i++)
-	*values.inp++ = getword(fp);
-      break;
-    case WLZ_GREY_SHORT:
-      for (i=0 ; i<num ; i++){
-        short shv = (short )getshort(fp);
-	*values.inp++ = shv;
-/*fprintf(stderr, "%d\n", shv);*/}
-      break;
-    case WLZ_GREY_UBYTE:
-		for (i=0 ; i<num ; i++){
-
-	*values.inp++ = getc(fp);
-
-		}
-      break;
-    default:
-      break;
-    }
-    break;
-
-  case WLZ_GREY_SHORT:
-    switch (packing) {
-    case WLZ_GREY_SHORT:
-      for (i=0 ; i<num ; i++)
-	*values.shp++ = (short )getshort(fp);
-      break;
-    case WLZ_GREY_UBYTE:
-		for (i=0 ; i<num ; i++){
-
-	*values.shp++ = (short )getc(fp);
-
-		}
-      break;
-    default:
-      break;
-    }
-    break;
-
-  case WLZ_GREY_UBYTE:
-    fread(values.ubp, sizeof(WlzUByte), num, fp);
-    break;
-
-  case WLZ_GREY_FLOAT:
-    for (i=0 ; i<num ; i++)
-      *values.flp++ = getfloat(fp);
-    break;
-
-  case WLZ_GREY_DOUBLE:
-    for (i=0 ; i<num ; i++)
-      *values.dbp++ = getdouble(fp);
-    break;
-
-  case WLZ_GREY_RGBA:
-    for (i=0 ; i<num ; i++)
-      *values.rgbp++ = getword(fp);
-    break;
-
-  default:
-    return  WLZ_ERR_GREY_TYPE;
-    break;
+  errNum = WlzReadGreyBlock(fp, values, gType, packing, num);
+  if((errNum == WLZ_ERR_NONE) && (feof(fp) != 0)){
+    errNum = WLZ_ERR_READ_INCOMPLETE;
   }
-  if( feof(fp) != 0 ){
+  if(errNum != WLZ_ERR_NONE){
     WlzFreeValueTb(vtb.v);
     obj->values.core = NULL;
-    return  WLZ_ERR_READ_INCOMPLETE;
   }
-
-  return WLZ_ERR_NONE;
+  return errNum;
 }
 
 /*!
@@ -2052,8 +2319,10 @@ static WlzErrorNum WlzReadRectVtb(FILE 		*fp,
 * \param	obj			Object defining the domain of the
 *					grey values. The domain is known to
 *					be non NULL.
+* \param	map			If non zero rectangular value tables
+* 					are memory mapped when possible.
 */
-static WlzErrorNum WlzReadDomObjValues2D(FILE *fP, WlzObject *obj)
+static WlzErrorNum WlzReadDomObjValues2D(FILE *fP, WlzObject *obj, int map)
 {
   WlzObjectType	type;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -2080,7 +2349,7 @@ static WlzErrorNum WlzReadDomObjValues2D(FILE *fP, WlzObject *obj)
 	errNum = WlzReadTiledValues(fP, obj, 2, type, 1);
 	break;
       default:
-        errNum = WlzReadGreyValues(fP, type, obj);
+        errNum = WlzReadGreyValues(fP, type, obj, map);
 	break;
     }
   }
@@ -2097,8 +2366,10 @@ static WlzErrorNum WlzReadDomObjValues2D(FILE *fP, WlzObject *obj)
 * \param	obj			Object defining the domain of the
 *					grey values. The domain is known to
 *					be non NULL.
+* \param	map			If non zero rectangular value tables
+* 					are memory mapped when possible.
 */
-static WlzErrorNum WlzReadDomObjValues3D(FILE *fP, WlzObject *obj)
+static WlzErrorNum WlzReadDomObjValues3D(FILE *fP, WlzObject *obj, int map)
 {
   WlzObjectType	type;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -2117,7 +2388,7 @@ static WlzErrorNum WlzReadDomObjValues3D(FILE *fP, WlzObject *obj)
     switch(type)
     {
       case WLZ_VOXELVALUETABLE_GREY:
-        errNum = WlzReadVoxelValues(fP, obj);
+        errNum = WlzReadVoxelValues(fP, obj, map);
 	break;
       case WLZ_VALUETABLE_TILED_INT:    /* FALLTHROUGH */
       case WLZ_VALUETABLE_TILED_SHORT:  /* FALLTHROUGH */
@@ -2368,8 +2639,10 @@ static WlzErrorNum WlzReadTiledValues(FILE *fP, WlzObject *obj,
 * \param	fp			Input file.
 * \param	obj			Object defining the domain of the
 *					grey values.
+* \param	map			If non zero rectangular value tables
+* 					are memory mapped when possible.
 */
-static WlzErrorNum WlzReadVoxelValues(FILE *fp, WlzObject *obj)
+static WlzErrorNum WlzReadVoxelValues(FILE *fp, WlzObject *obj, int map)
 {
   int 			i, nplanes;
   WlzObject 		*tmpobj;
@@ -2410,7 +2683,8 @@ static WlzErrorNum WlzReadVoxelValues(FILE *fp, WlzObject *obj)
       WlzObjectType gtt;
 
       gtt = (WlzObjectType )getc(fp);
-      if( (errNum = WlzReadGreyValues(fp, gtt, tmpobj)) == WLZ_ERR_NONE ){
+      if( (errNum = WlzReadGreyValues(fp, gtt, tmpobj,
+      				      map)) == WLZ_ERR_NONE ){
 	*values = WlzAssignValues(tmpobj->values, NULL);
 	/* reset voxel-table background */
 	if( (*values).core != NULL ){
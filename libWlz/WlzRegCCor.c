@@ -40,12 +40,41 @@ static char _WlzRegCCor_c[] = "University of Edinburgh $Id$";
 * \ingroup	WlzRegistration
 */
 
+#include <string.h>
 #include <float.h>
 #include <limits.h>
 #include <Wlz.h>
 
 /* #define WLZ_REGCCOR_DEBUG */
-static WlzObject 		*WlzRegCCorNormaliseObj2D(
+
+/*!
+* \struct	_WlzRegCCorRot3DWSp
+* \ingroup	WlzRegistration
+* \brief	Workspace for the 3D rotation search which holds the
+*		preprocessed target object, its spectrum and the arrays
+*		for a pair of candidate rotations.
+*		Typedef: ::WlzRegCCorRot3DWSp.
+*/
+typedef struct _WlzRegCCorRot3DWSp
+{
+  WlzObject	*tPObj;		/*!< Preprocessed target object. */
+  WlzIBox3	tPBox;		/*!< Bounding box of the preprocessed
+  				     target object. */
+  WlzObject	*sObj;		/*!< Source object. */
+  WlzAffineTransform *initTr;	/*!< Initial affine transform. */
+  WlzDVertex3	centre;		/*!< Centre of rotation. */
+  WlzDVertex3	maxTran;	/*!< Maximum translation. */
+  WlzWindowFnType winFn;	/*!< Window function. */
+  int		noise;		/*!< Use Gaussian noise if non-zero. */
+  WlzIVertex3	aOrg;		/*!< Origin of the arrays. */
+  WlzIVertex3	aSz;		/*!< Size of the arrays. */
+  double	tSSq;		/*!< Sum of squares of the target array. */
+  double	***tAr[2];	/*!< Real and imaginary parts of the
+  				     target spectrum. */
+  double	***sAr[2];	/*!< Arrays for a pair of candidates. */
+} WlzRegCCorRot3DWSp;
+
+static WlzObject 		*WlzRegCCorNormaliseObj(
 				  WlzObject *obj,
 				  int inv,
 				  WlzErrorNum *dstErr);
@@ -98,6 +127,76 @@ static double			WlzRegCCorObjs2DRot(
 				  WlzWindowFnType winFn,
 				  int noise,
 				  WlzErrorNum *dstErr);
+static WlzObject 		*WlzRegCCorPProcessObj3D(
+				  WlzObject *obj,
+				  WlzWindowFnType winFn,
+				  WlzIVertex3 centre,
+				  WlzIVertex3 radius,
+				  WlzErrorNum *dstErr);
+static WlzObject		*WlzRegCCorSampleObj3D(
+				  WlzObject *obj,
+				  int samFac,
+				  WlzErrorNum *dstErr);
+static WlzAffineTransform	*WlzRegCCorScaleTr3D(
+				  WlzAffineTransform *tr,
+				  double scale,
+				  WlzErrorNum *dstErr);
+static WlzAffineTransform	*WlzRegCCorRotTr3D(
+				  WlzDVertex3 centre,
+				  double *ang,
+				  WlzErrorNum *dstErr);
+static WlzAffineTransform 	*WlzRegCCorObjs3D(
+				  WlzObject *tObj,
+				  WlzObject *sObj,
+				  WlzAffineTransform *initTr,
+				  WlzTransformType trType,
+				  WlzDVertex3 maxTran,
+				  double maxRot,
+				  int maxItr,
+				  WlzWindowFnType winFn,
+				  int noise,
+				  int *dstConv,
+				  double *dstCCor,
+				  WlzErrorNum *dstErr);
+static WlzAffineTransform 	*WlzRegCCorObjs3D1(
+				  WlzObject *tObj,
+				  WlzObject *sObj,
+				  WlzAffineTransform *initTr,
+				  WlzTransformType trType,
+				  WlzDVertex3 maxTran,
+				  double maxRot,
+				  int maxItr,
+				  WlzWindowFnType winFn,
+				  int noise,
+				  int *dstConv,
+				  double *dstCCor,
+				  WlzErrorNum *dstErr);
+static WlzDVertex3		WlzRegCCorObjs3DTran(
+				  WlzObject *tObj,
+				  WlzObject *sObj,
+				  WlzAffineTransform *initTr,
+				  WlzDVertex3 maxTran,
+				  WlzWindowFnType winFn,
+				  int noise,
+				  double *dstCCor,
+				  WlzErrorNum *dstErr);
+static WlzAffineTransform	*WlzRegCCorObjs3DRot(
+				  WlzObject *tObj,
+				  WlzObject *sObj,
+				  WlzAffineTransform *initTr,
+				  WlzDVertex3 maxTran,
+				  double maxRot,
+				  WlzWindowFnType winFn,
+				  int noise,
+				  WlzErrorNum *dstErr);
+static WlzErrorNum		WlzRegCCorObjs3DRotTarget(
+				  WlzRegCCorRot3DWSp *wSp,
+				  WlzIBox3 aBox);
+static WlzErrorNum		WlzRegCCorObjs3DRotCCor(
+				  WlzRegCCorRot3DWSp *wSp,
+				  double (*cAng)[3],
+				  int nC,
+				  double *cCor);
 
 /*!
 * \return	Affine transform which brings the two objects into register.
@@ -126,6 +225,16 @@ static double			WlzRegCCorObjs2DRot(
 *		The objects are assumed to have high foreground values and
 *		low background values. If this is no the case the invert
 *		grey values parameter should be set.
+*
+*		Both 2D and 3D domain objects may be registered. 3D
+*		objects are padded to arrays with sizes that have only
+*		small prime factors (see AlgFFTGoodSize()) rather than
+*		powers of two, their translation is found using a 3D
+*		frequency domain cross correlation and their rotation
+*		(if required) by a coarse to fine search about the x, y
+*		and z axes. For 3D objects the maximum translation in z
+*		is the greater of the given maximum translations in x
+*		and y and the maximum rotation applies about each axis.
 * \param	tObj			The target object.
 * \param	sObj			The source object to be registered
 *					with target object.
@@ -160,6 +269,7 @@ WlzAffineTransform *WlzRegCCorObjs(WlzObject *tObj, WlzObject *sObj,
 				   WlzErrorNum *dstErr)
 {
   WlzIVertex2	dummy;
+  WlzDVertex3	maxTran3;
   WlzObject	*tPObj = NULL,
   		*sPObj = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -188,11 +298,11 @@ WlzAffineTransform *WlzRegCCorObjs(WlzObject *tObj, WlzObject *sObj,
     {
       case WLZ_2D_DOMAINOBJ:
 	tPObj = WlzAssignObject(
-	        WlzRegCCorNormaliseObj2D(tObj,  inv, &errNum), NULL);
+	        WlzRegCCorNormaliseObj(tObj,  inv, &errNum), NULL);
 	if(errNum == WLZ_ERR_NONE)
 	{
 	  sPObj = WlzAssignObject(
-	          WlzRegCCorNormaliseObj2D(sObj,  inv, &errNum), NULL);
+	          WlzRegCCorNormaliseObj(sObj,  inv, &errNum), NULL);
 	}
 	if(errNum == WLZ_ERR_NONE)
 	{
@@ -201,6 +311,24 @@ WlzAffineTransform *WlzRegCCorObjs(WlzObject *tObj, WlzObject *sObj,
 				   dstConv, dstCCor, &errNum);
 	}
         break;
+      case WLZ_3D_DOMAINOBJ:
+	tPObj = WlzAssignObject(
+	        WlzRegCCorNormaliseObj(tObj,  inv, &errNum), NULL);
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  sPObj = WlzAssignObject(
+	          WlzRegCCorNormaliseObj(sObj,  inv, &errNum), NULL);
+	}
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  maxTran3.vtX = maxTran.vtX;
+	  maxTran3.vtY = maxTran.vtY;
+	  maxTran3.vtZ = WLZ_MAX(maxTran.vtX, maxTran.vtY);
+	  regTr = WlzRegCCorObjs3D(tPObj, sPObj, initTr, trType,
+				   maxTran3, maxRot, maxItr, winFn, noise,
+				   dstConv, dstCCor, &errNum);
+	}
+        break;
       default:
 	errNum = WLZ_ERR_OBJECT_TYPE;
 	break;
@@ -225,7 +353,7 @@ WlzAffineTransform *WlzRegCCorObjs(WlzObject *tObj, WlzObject *sObj,
 * \param	dstErr			Destination error pointer,
 *                                       may be NULL.
 */
-static WlzObject *WlzRegCCorNormaliseObj2D(WlzObject *obj, int inv,
+static WlzObject *WlzRegCCorNormaliseObj(WlzObject *obj, int inv,
 					WlzErrorNum *dstErr)
 {
   WlzGreyType	gType;
@@ -1199,3 +1327,1142 @@ static double	WlzRegCCorObjs2DRot(WlzObject *tObj, WlzObject *sObj,
   }
   return(dstRot);
 }
+
+/*!
+* \return	Returns a preprocessed object for registration.
+* \ingroup	WlzRegistration
+* \brief	Applies the window function to the given 3D object, see
+*		WlzRegCCorPProcessObj2D().
+* \param	obj			Given object.
+* \param	winFn			Window function.
+* \param	centre			Centre for window function, only
+*					used if window function is not
+*					WLZ_WINDOWFN_NONE.
+* \param	radius			Radius for window function, only
+*					used if window function is not
+*					WLZ_WINDOWFN_NONE.
+* \param	dstErr			Destination error pointer,
+*                                       may be NULL.
+*/
+static WlzObject *WlzRegCCorPProcessObj3D(WlzObject *obj,
+				WlzWindowFnType winFn,
+				WlzIVertex3 centre, WlzIVertex3 radius,
+				WlzErrorNum *dstErr)
+{
+  WlzObject	*obj0 = NULL;
+  WlzErrorNum   errNum = WLZ_ERR_NONE;
+
+  if(winFn == WLZ_WINDOWFN_NONE)
+  {
+    obj0 = obj;
+  }
+  else
+  {
+    obj0 = WlzWindow3D(obj, winFn, centre, radius, &errNum);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(obj0);
+}
+
+/*!
+* \return	Subsampled object.
+* \ingroup	WlzRegistration
+* \brief	Subsamples the given 3D object for the registration
+*		resolution pyramid. Because WlzSampleObj() only supports
+*		point sampling of 3D objects, the object is first smoothed
+*		using WlzGaussObj() with sigma half the sampling factor.
+* \param	obj			Given 3D domain object.
+* \param	samFac			Sampling factor which is applied
+*					in all directions.
+* \param	dstErr			Destination error pointer,
+*                                       may be NULL.
+*/
+static WlzObject *WlzRegCCorSampleObj3D(WlzObject *obj, int samFac,
+					WlzErrorNum *dstErr)
+{
+  WlzIVertex3	order,
+  		samFacV;
+  WlzDVertex3	sigma;
+  WlzObject	*gObj = NULL,
+  		*samObj = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  sigma.vtX = sigma.vtY = sigma.vtZ = 0.5 * samFac;
+  order.vtX = order.vtY = order.vtZ = 0;
+  gObj = WlzAssignObject(
+	 WlzGaussObj(obj, sigma, order, &errNum), NULL);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    samFacV.vtX = samFacV.vtY = samFacV.vtZ = samFac;
+    samObj = WlzSampleObj(gObj, samFacV, WLZ_SAMPLEFN_POINT, &errNum);
+  }
+  (void )WlzFreeObj(gObj);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(samObj);
+}
+
+/*!
+* \return	New 3D affine transform.
+* \ingroup	WlzRegistration
+* \brief	Makes a copy of the given 3D affine transform with it's
+*		translation scaled, as required when using the transform
+*		with subsampled objects.
+* \param	tr			Given 3D affine transform, may be
+*					NULL which is equivalent to an
+*					identity transform.
+* \param	scale			Translation scale factor.
+* \param	dstErr			Destination error pointer,
+*                                       may be NULL.
+*/
+static WlzAffineTransform *WlzRegCCorScaleTr3D(WlzAffineTransform *tr,
+					       double scale,
+					       WlzErrorNum *dstErr)
+{
+  int		idx;
+  WlzAffineTransform *newTr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tr == NULL)
+  {
+    newTr = WlzAffineTransformFromTranslation(WLZ_TRANSFORM_3D_AFFINE,
+    					      0.0, 0.0, 0.0, &errNum);
+  }
+  else if(WlzAffineTransformDimension(tr, &errNum) != 3)
+  {
+    if(errNum == WLZ_ERR_NONE)
+    {
+      errNum = WLZ_ERR_TRANSFORM_TYPE;
+    }
+  }
+  else
+  {
+    newTr = WlzAffineTransformCopy(tr, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idx = 0; idx < 3; ++idx)
+    {
+      newTr->mat[idx][3] *= scale;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(newTr);
+}
+
+/*!
+* \return	New 3D affine transform.
+* \ingroup	WlzRegistration
+* \brief	Makes a 3D affine transform which rotates about the
+*		given centre.
+* \param	centre			Centre of rotation.
+* \param	ang			Angles of rotation about the x, y
+*					and z axes.
+* \param	dstErr			Destination error pointer,
+*                                       may be NULL.
+*/
+static WlzAffineTransform *WlzRegCCorRotTr3D(WlzDVertex3 centre,
+					     double *ang,
+					     WlzErrorNum *dstErr)
+{
+  WlzAffineTransform *tr0 = NULL,
+  		*tr1 = NULL,
+		*tr2 = NULL,
+		*rotTr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  tr0 = WlzAffineTransformFromTranslation(WLZ_TRANSFORM_3D_AFFINE,
+  					  -(centre.vtX), -(centre.vtY),
+					  -(centre.vtZ), &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tr1 = WlzAffineTransformFromRotation(WLZ_TRANSFORM_3D_AFFINE,
+    					 ang[0], ang[1], ang[2], &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tr2 = WlzAffineTransformProduct(tr0, tr1, &errNum);
+  }
+  (void )WlzFreeAffineTransform(tr0);
+  (void )WlzFreeAffineTransform(tr1);
+  tr0 = NULL;
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tr0 = WlzAffineTransformFromTranslation(WLZ_TRANSFORM_3D_AFFINE,
+					    centre.vtX, centre.vtY,
+					    centre.vtZ, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rotTr = WlzAffineTransformProduct(tr2, tr0, &errNum);
+  }
+  (void )WlzFreeAffineTransform(tr0);
+  (void )WlzFreeAffineTransform(tr2);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rotTr);
+}
+
+/*!
+* \return	Affine transform which brings the two objects into register.
+* \ingroup	WlzRegistration
+* \brief	Registers the two given 3D domain objects using a
+*               frequency domain cross correlation.  An affine transform
+*               is computed, which when applied to the source object
+*               takes it into register with the target object.
+*               As for WlzRegCCorObjs2D() a resolution pyramid is used,
+*               progressing from low resolution towards the full
+*               resolution objects, but because each subsampling of a
+*               3D object reduces the number of voxels by the cube of
+*               the sampling factor a factor of two is used between
+*               levels, see WlzRegCCorSampleObj3D().
+* \param	tObj			The target object. Must have
+*                                       been assigned.
+* \param	sObj			The source object to be
+*                                       registered with target object.
+* \param	initTr			Initial 3D affine transform
+*                                       to be applied to the source
+*                                       object prior to registration.
+*                                       May be NULL.
+* \param	trType			Required transform type.
+* \param	maxTran			Maximum translation.
+* \param	maxRot			Maximum rotation.
+* \param	maxItr			Maximum number of iterations,
+*                                       if \f$\leq\f$ 0 then infinite
+*                                       iterations are allowed.
+* \param	winFn			Window function.
+* \param	noise			Use Gaussian noise if non-zero.
+* \param	dstConv			Destination ptr for the
+*                                       convergence flag (non zero
+*                                       on convergence), may be NULL.
+* \param	dstCCor			Destination ptr for the cross
+*                                       correlation value, may be NULL.
+* \param	dstErr			Destination error pointer,
+*                                       may be NULL.
+*/
+static WlzAffineTransform *WlzRegCCorObjs3D(WlzObject *tObj, WlzObject *sObj,
+					    WlzAffineTransform *initTr,
+					    WlzTransformType trType,
+					    WlzDVertex3 maxTran, double maxRot,
+					    int maxItr,
+					    WlzWindowFnType winFn, int noise,
+					    int *dstConv, double *dstCCor,
+					    WlzErrorNum *dstErr)
+{
+  int		tI1,
+		samIdx,
+		conv = 1,
+  		nSam = 0;
+  double	sMaxRot,
+  		cCor = 0.0;
+  WlzDVertex3	sMaxTran;
+  WlzIBox3	sBox,
+  		tBox;
+  int		*samFac = NULL;
+  WlzObject	**sTObj = NULL,
+  		**sSObj = NULL;
+  WlzAffineTransform *curTr = NULL,
+  		*samRegTr0 = NULL,
+  		*samRegTr1 = NULL,
+		*regTr = NULL;
+  WlzPixelV	zeroBgd;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const int	samFacStep = 2,
+  		maxSam = 16,
+  		minSamSz = 32;
+
+  zeroBgd.type = WLZ_GREY_INT;
+  zeroBgd.v.inv = 0;
+  /* Compute the number of x2 subsampling operations to use. */
+  sBox = WlzBoundingBox3I(sObj, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tBox = WlzBoundingBox3I(tObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tI1 = WLZ_MIN(sBox.xMax - sBox.xMin, tBox.xMax - tBox.xMin);
+    tI1 = WLZ_MIN(tI1, WLZ_MIN(sBox.yMax - sBox.yMin, tBox.yMax - tBox.yMin));
+    tI1 = WLZ_MIN(tI1, WLZ_MIN(sBox.zMax - sBox.zMin, tBox.zMax - tBox.zMin));
+    nSam = 1;
+    ++tI1;
+    while((nSam < maxSam) && (tI1 > minSamSz))
+    {
+      ++nSam;
+      tI1 /= samFacStep;
+    }
+  }
+  /* Allocate space for subsampled objects. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(((samFac = (int *)AlcMalloc(nSam * sizeof(int))) == NULL) ||
+       ((sTObj = (WlzObject **)AlcCalloc(nSam,
+    				         sizeof(WlzObject *))) == NULL) ||
+       ((sSObj = (WlzObject **)AlcCalloc(nSam,
+       					 sizeof(WlzObject *))) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  /* Compute subsampled objects and make sure the background value is zero. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    samIdx = 0;
+    *samFac = 1;
+    *(sTObj + 0) = WlzAssignObject(tObj, NULL);
+    *(sSObj + 0) = WlzAssignObject(sObj, NULL);
+    while((errNum == WLZ_ERR_NONE) && (++samIdx < nSam))
+    {
+      *(samFac + samIdx) = *(samFac + samIdx - 1) * samFacStep;
+      *(sTObj + samIdx) = WlzAssignObject(
+      			  WlzRegCCorSampleObj3D(*(sTObj + samIdx - 1),
+					        samFacStep, &errNum), NULL);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	(void )WlzSetBackground(*(sTObj + samIdx), zeroBgd);
+        *(sSObj + samIdx) = WlzAssignObject(
+			    WlzRegCCorSampleObj3D(*(sSObj + samIdx - 1),
+					          samFacStep, &errNum), NULL);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        (void )WlzSetBackground(*(sSObj + samIdx), zeroBgd);
+      }
+    }
+  }
+  /* Register the subsampled objects starting with the lowest resolution
+   * (highest subsampling) and progressing to the unsampled objects. At
+   * each resolution the current transform has it's translation scaled by
+   * the inverse of the sampling factor. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    curTr = WlzRegCCorScaleTr3D(initTr, 1.0, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    samIdx = nSam - 1;
+    sMaxRot = maxRot;
+    sMaxTran.vtX =  maxTran.vtX / *(samFac + samIdx);
+    sMaxTran.vtY =  maxTran.vtY / *(samFac + samIdx);
+    sMaxTran.vtZ =  maxTran.vtZ / *(samFac + samIdx);
+    while((errNum == WLZ_ERR_NONE) && conv && (samIdx >= 0))
+    {
+      samRegTr0 = WlzRegCCorScaleTr3D(curTr, 1.0 / *(samFac + samIdx),
+      				      &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	samRegTr1 = WlzRegCCorObjs3D1(*(sTObj + samIdx), *(sSObj + samIdx),
+				      samRegTr0, trType, sMaxTran, sMaxRot,
+				      maxItr, winFn, noise,
+				      &conv, &cCor, &errNum);
+      }
+      (void )WlzFreeAffineTransform(samRegTr0);
+      samRegTr0 = NULL;
+      if(errNum == WLZ_ERR_NONE)
+      {
+	(void )WlzFreeAffineTransform(curTr);
+	curTr = WlzRegCCorScaleTr3D(samRegTr1, *(samFac + samIdx), &errNum);
+      }
+      (void )WlzFreeAffineTransform(samRegTr1);
+      samRegTr1 = NULL;
+      /* Set registration limits. */
+      sMaxRot = WLZ_M_PI / 24.0;
+      sMaxTran.vtX = samFacStep * 3;
+      sMaxTran.vtY = samFacStep * 3;
+      sMaxTran.vtZ = samFacStep * 3;
+      --samIdx;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(dstConv)
+    {
+      *dstConv = conv;
+    }
+    if(dstCCor)
+    {
+      *dstCCor = cCor;
+    }
+    regTr = curTr;
+  }
+  else
+  {
+    (void )WlzFreeAffineTransform(curTr);
+  }
+  AlcFree(samFac);
+  /* Free subsampled objects. */
+  if(sTObj)
+  {
+    for(samIdx = 0; samIdx < nSam; ++samIdx)
+    {
+      (void )WlzFreeObj(*(sTObj + samIdx));
+    }
+    AlcFree(sTObj);
+  }
+  if(sSObj)
+  {
+    for(samIdx = 0; samIdx < nSam; ++samIdx)
+    {
+      (void )WlzFreeObj(*(sSObj + samIdx));
+    }
+    AlcFree(sSObj);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(regTr);
+}
+
+/*!
+* \return	Affine transform which brings the two objects into register.
+* \ingroup	WlzRegistration
+* \brief	Registers the two given 3D domain objects at a single
+*		resolution, alternating between rotation and translation
+*		until the translation is less than half a voxel, see
+*		WlzRegCCorObjs2D1().
+* \param	tObj			The target object. Must have
+*                                       been assigned.
+* \param	sObj			The source object to be
+*                                       registered with target object.
+* \param	initTr			Initial 3D affine transform
+*                                       to be applied to the source
+*                                       object prior to registration.
+* \param	trType			Required transform type.
+* \param	maxTran			Maximum translation.
+* \param	maxRot			Maximum rotation.
+* \param	maxItr			Maximum number of iterations,
+*                                       if \f$\leq\f$ 0 then infinite
+*                                       iterations are allowed.
+* \param	winFn			Window function.
+* \param	noise			Use Gaussian noise if non-zero.
+* \param	dstConv			Destination ptr for the
+*                                       convergence flag (non zero
+*                                       on convergence), may be NULL.
+* \param	dstCCor			Destination ptr for the cross
+*                                       correlation value, may be NULL.
+* \param	dstErr			Destination error pointer,
+*                                       may be NULL.
+*/
+static WlzAffineTransform *WlzRegCCorObjs3D1(WlzObject *tObj, WlzObject *sObj,
+					     WlzAffineTransform *initTr,
+					     WlzTransformType trType,
+					     WlzDVertex3 maxTran,
+					     double maxRot, int maxItr,
+					     WlzWindowFnType winFn, int noise,
+					     int *dstConv, double *dstCCor,
+					     WlzErrorNum *dstErr)
+{
+  int		itr,
+		conv = 0;
+  double	cCor = 0.0;
+  WlzDVertex3	tran;
+  WlzAffineTransform *tTr0 = NULL,
+  		*tTr1 = NULL,
+		*curTr = NULL,
+		*regTr = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const double	tranTol = 0.5;
+
+  /* Register for translation. */
+  tran = WlzRegCCorObjs3DTran(tObj, sObj, initTr, maxTran, winFn, noise,
+  			      &cCor, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tTr0 = WlzAffineTransformFromTranslation(WLZ_TRANSFORM_3D_AFFINE,
+    					     tran.vtX, tran.vtY, tran.vtZ,
+					     &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    curTr = WlzAffineTransformProduct(initTr, tTr0, &errNum);
+  }
+  (void )WlzFreeAffineTransform(tTr0);
+  tTr0 = NULL;
+  if((trType == WLZ_TRANSFORM_2D_TRANS) || (trType == WLZ_TRANSFORM_3D_TRANS))
+  {
+    conv = 1;
+  }
+  else
+  {
+    /* Iterate until the translation is less than the tolerance value or
+     * the number of iterations exceeds the maximum. */
+    itr = 0;
+    while((errNum == WLZ_ERR_NONE) &&
+	  ((conv = (fabs(tran.vtX) <= tranTol) &&
+	           (fabs(tran.vtY) <= tranTol) &&
+	           (fabs(tran.vtZ) <= tranTol)) == 0) &&
+	  ((maxItr < 0) || (itr++ < maxItr)))
+    {
+      /* Register for rotation. */
+      tTr0 = WlzRegCCorObjs3DRot(tObj, sObj, curTr, maxTran, maxRot,
+      				 winFn, noise, &errNum);
+      if(errNum == WLZ_ERR_NONE)
+      {
+	tTr1 = WlzAffineTransformProduct(curTr, tTr0, &errNum);
+      }
+      (void )WlzFreeAffineTransform(tTr0);
+      tTr0 = NULL;
+      if(errNum == WLZ_ERR_NONE)
+      {
+	(void )WlzFreeAffineTransform(curTr);
+	curTr = tTr1;
+	tTr1 = NULL;
+	/* Register for translation. */
+	tran = WlzRegCCorObjs3DTran(tObj, sObj, curTr, maxTran, winFn, noise,
+				    &cCor, &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	tTr0 = WlzAffineTransformFromTranslation(WLZ_TRANSFORM_3D_AFFINE,
+						 tran.vtX, tran.vtY, tran.vtZ,
+						 &errNum);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+	tTr1 = WlzAffineTransformProduct(curTr, tTr0, &errNum);
+      }
+      (void )WlzFreeAffineTransform(tTr0);
+      tTr0 = NULL;
+      if(errNum == WLZ_ERR_NONE)
+      {
+	(void )WlzFreeAffineTransform(curTr);
+	curTr = tTr1;
+	tTr1 = NULL;
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    regTr = curTr;
+    if(dstConv)
+    {
+      *dstConv = conv;
+    }
+    if(dstCCor)
+    {
+      *dstCCor = cCor;
+    }
+  }
+  else
+  {
+    (void )WlzFreeAffineTransform(curTr);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(regTr);
+}
+
+/*!
+* \return	Translation.
+* \ingroup	WlzRegistration
+* \brief	Registers the given 3D domain objects using a frequency
+*		domain cross correlation, to find the translation which
+*		has the highest cross correlation value.
+*		The windowed objects are padded to arrays with sizes which
+*		have only small prime factors (see AlgFFTGoodSize()), which
+*		for volumes is often far smaller than the next power of two.
+* \param	tObj			The target object. Must have
+*                                       been assigned.
+* \param	sObj			The source object to be
+*                                       registered with target object.
+*                                       Must have been assigned.
+* \param	initTr			Initial affine transform
+*                                       to be applied to the source
+*                                       object prior to registration.
+* \param	maxTran			Maximum translation.
+* \param	winFn			Window function.
+* \param	noise			Use Gaussian noise if non-zero.
+* \param	dstCCor			Destination ptr for the cross
+*                                       correlation value, may be NULL.
+* \param	dstErr			Destination error pointer,
+*                                       may be NULL.
+*/
+static WlzDVertex3 WlzRegCCorObjs3DTran(WlzObject *tObj, WlzObject *sObj,
+					WlzAffineTransform *initTr,
+					WlzDVertex3 maxTran,
+					WlzWindowFnType winFn, int noise,
+					double *dstCCor, WlzErrorNum *dstErr)
+{
+  int		oIdx;
+  double	cCor = 0.0;
+  double	sSq[2];
+  double	***oAr[2];
+  WlzIBox3	aBox;
+  WlzIBox3	oBox[2],
+  		pBox[2];
+  WlzIVertex3	aSz,
+  		aOrg,
+		centre,
+		radius,
+		tran;
+  WlzDVertex3	dstTran;
+  WlzObject	*oObj[2],
+  		*pObj[2];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dstTran.vtX = 0.0;
+  dstTran.vtY = 0.0;
+  dstTran.vtZ = 0.0;
+  oAr[0] = oAr[1] = NULL;
+  oObj[0] = oObj[1] = NULL;
+  pObj[0] = pObj[1] = NULL;
+  oObj[0] = WlzAssignObject(tObj, NULL);
+  /* Transform source object. */
+  if((initTr == NULL) || WlzAffineTransformIsIdentity(initTr, NULL))
+  {
+    oObj[1] = WlzAssignObject(sObj, NULL);
+  }
+  else
+  {
+    oObj[1] = WlzAssignObject(
+              WlzAffineTransformObj(sObj, initTr, WLZ_INTERPOLATION_NEAREST,
+				    &errNum), NULL);
+  }
+  /* Preprocess the objects. */
+  oIdx = 0;
+  while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
+  {
+    oBox[oIdx] = WlzBoundingBox3I(oObj[oIdx], &errNum);
+    if(errNum == WLZ_ERR_NONE)
+    {
+      centre.vtX = (oBox[oIdx].xMin + oBox[oIdx].xMax) / 2;
+      centre.vtY = (oBox[oIdx].yMin + oBox[oIdx].yMax) / 2;
+      centre.vtZ = (oBox[oIdx].zMin + oBox[oIdx].zMax) / 2;
+      radius.vtX = WLZ_MAX((oBox[oIdx].xMax - oBox[oIdx].xMin) / 2, 1);
+      radius.vtY = WLZ_MAX((oBox[oIdx].yMax - oBox[oIdx].yMin) / 2, 1);
+      radius.vtZ = WLZ_MAX((oBox[oIdx].zMax - oBox[oIdx].zMin) / 2, 1);
+      pObj[oIdx] = WlzAssignObject(
+                   WlzRegCCorPProcessObj3D(oObj[oIdx], winFn, centre, radius,
+      					   &errNum), NULL);
+    }
+    ++oIdx;
+  }
+  /* Create double arrays. */
+  oIdx = 0;
+  while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
+  {
+    pBox[oIdx] = WlzBoundingBox3I(pObj[oIdx], &errNum);
+    ++oIdx;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    aBox.xMin = WLZ_MIN(pBox[0].xMin, pBox[1].xMin) - (int )(maxTran.vtX) + 1;
+    aBox.yMin = WLZ_MIN(pBox[0].yMin, pBox[1].yMin) - (int )(maxTran.vtY) + 1;
+    aBox.zMin = WLZ_MIN(pBox[0].zMin, pBox[1].zMin) - (int )(maxTran.vtZ) + 1;
+    aBox.xMax = WLZ_MAX(pBox[0].xMax, pBox[1].xMax) + (int )(maxTran.vtX) + 1;
+    aBox.yMax = WLZ_MAX(pBox[0].yMax, pBox[1].yMax) + (int )(maxTran.vtY) + 1;
+    aBox.zMax = WLZ_MAX(pBox[0].zMax, pBox[1].zMax) + (int )(maxTran.vtZ) + 1;
+    aOrg.vtX = aBox.xMin;
+    aOrg.vtY = aBox.yMin;
+    aOrg.vtZ = aBox.zMin;
+    aSz.vtX = AlgFFTGoodSize(aBox.xMax - aBox.xMin + 1, 0);
+    aSz.vtY = AlgFFTGoodSize(aBox.yMax - aBox.yMin + 1, 0);
+    aSz.vtZ = AlgFFTGoodSize(aBox.zMax - aBox.zMin + 1, 0);
+    oIdx = 0;
+    while((errNum == WLZ_ERR_NONE) && (oIdx < 2))
+    {
+      errNum = WlzToArray3D((void ****)&(oAr[oIdx]), pObj[oIdx], aSz, aOrg,
+      			    noise, WLZ_GREY_DOUBLE);
+      ++oIdx;
+    }
+  }
+  if((dstCCor != NULL) && (errNum == WLZ_ERR_NONE))
+  {
+    for(oIdx = 0; oIdx < 2; ++oIdx)
+    {
+      (void )WlzArrayStats3D((void ***)(oAr[oIdx]), aSz, WLZ_GREY_DOUBLE,
+			     NULL, NULL, NULL, &(sSq[oIdx]), NULL, NULL);
+    }
+  }
+  /* Cross correlate. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzErrorFromAlg(
+             AlgCrossCorrelate3D(oAr[0], oAr[1], aSz.vtX, aSz.vtY, aSz.vtZ));
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    AlgCrossCorrPeakXYZ(&(tran.vtX), &(tran.vtY), &(tran.vtZ), &cCor, oAr[0],
+			aSz.vtX, aSz.vtY, aSz.vtZ,
+			maxTran.vtX, maxTran.vtY, maxTran.vtZ);
+    dstTran.vtX = tran.vtX;
+    dstTran.vtY = tran.vtY;
+    dstTran.vtZ = tran.vtZ;
+    if(dstCCor)
+    {
+      *dstCCor = cCor / (1.0 + (sqrt(sSq[0] * sSq[1]) *
+      				aSz.vtX * aSz.vtY * aSz.vtZ));
+    }
+  }
+  for(oIdx = 0; oIdx < 2; ++oIdx)
+  {
+    (void )WlzFreeObj(oObj[oIdx]);
+    (void )WlzFreeObj(pObj[oIdx]);
+    (void )AlcDouble3Free(oAr[oIdx]);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(dstTran);
+}
+
+/*!
+* \return	Rotation about the centre of the transformed source object.
+* \ingroup	WlzRegistration
+* \brief	Finds the rotation of the transformed 3D source object
+*		which maximises it's cross correlation with the target
+*		object.
+*		A coarse to fine pattern search is used over the angles
+*		of rotation about the x, y and z axes: each angle is
+*		stepped up and down, the candidate rotations are scored
+*		by the peak of their frequency domain cross correlation
+*		(so allowing for translation) and the best is kept if it
+*		improves the score, otherwise the step is halved. The
+*		search stops when a step would move the surface of the
+*		object by less than a quarter of a voxel.
+*		The target object is windowed once and the candidates
+*		are scored in pairs by WlzRegCCorObjs3DRotCCor(), so
+*		that at most four arrays are held at any time. The
+*		spectrum of the target is only recomputed when a pair
+*		does not fit within its array, see
+*		WlzRegCCorObjs3DRotTarget().
+* \param	tObj			The target object. Must have
+*                                       been assigned.
+* \param	sObj			The source object to be
+*                                       registered with target object.
+*                                       Must have been assigned.
+* \param	initTr			Initial affine transform
+*                                       to be applied to the source
+*                                       object prior to registration.
+* \param	maxTran			Maximum translation.
+* \param	maxRot			Maximum rotation about each axis.
+* \param	winFn			Window function.
+* \param	noise			Use Gaussian noise if non-zero.
+* \param	dstErr			Destination error pointer,
+*                                       may be NULL.
+*/
+static WlzAffineTransform *WlzRegCCorObjs3DRot(WlzObject *tObj,
+					WlzObject *sObj,
+					WlzAffineTransform *initTr,
+					WlzDVertex3 maxTran, double maxRot,
+					WlzWindowFnType winFn, int noise,
+					WlzErrorNum *dstErr)
+{
+  int		idA,
+  		idC,
+		nC,
+		bstC;
+  double	rad,
+		step,
+  		minStep = 1.0,
+		bstCCor = 0.0;
+  double	ang[3],
+  		cCor[6];
+  double	cAng[6][3];
+  WlzIBox3	sBox,
+  		tBox;
+  WlzIVertex3	centre,
+		radius;
+  WlzAffineTransform *rotTr = NULL;
+  WlzRegCCorRot3DWSp wSp;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  (void )memset(&wSp, 0, sizeof(WlzRegCCorRot3DWSp));
+  wSp.sObj = sObj;
+  wSp.initTr = initTr;
+  wSp.maxTran = maxTran;
+  wSp.winFn = winFn;
+  wSp.noise = noise;
+  ang[0] = ang[1] = ang[2] = 0.0;
+  sBox = WlzBoundingBox3I(sObj, &errNum);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    wSp.centre.vtX = 0.5 * (sBox.xMin + sBox.xMax);
+    wSp.centre.vtY = 0.5 * (sBox.yMin + sBox.yMax);
+    wSp.centre.vtZ = 0.5 * (sBox.zMin + sBox.zMax);
+    rad = 0.5 * WLZ_MAX(sBox.xMax - sBox.xMin,
+                        WLZ_MAX(sBox.yMax - sBox.yMin, sBox.zMax - sBox.zMin));
+    minStep = 0.25 / WLZ_MAX(rad, 1.0);
+    wSp.centre = WlzAffineTransformVertexD3(initTr, wSp.centre, &errNum);
+  }
+  /* Preprocess the target object once for all of the candidates. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tBox = WlzBoundingBox3I(tObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    centre.vtX = (tBox.xMin + tBox.xMax) / 2;
+    centre.vtY = (tBox.yMin + tBox.yMax) / 2;
+    centre.vtZ = (tBox.zMin + tBox.zMax) / 2;
+    radius.vtX = WLZ_MAX((tBox.xMax - tBox.xMin) / 2, 1);
+    radius.vtY = WLZ_MAX((tBox.yMax - tBox.yMin) / 2, 1);
+    radius.vtZ = WLZ_MAX((tBox.zMax - tBox.zMin) / 2, 1);
+    wSp.tPObj = WlzAssignObject(
+                WlzRegCCorPProcessObj3D(tObj, winFn, centre, radius,
+					&errNum), NULL);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    wSp.tPBox = WlzBoundingBox3I(wSp.tPObj, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzRegCCorObjs3DRotCCor(&wSp, &ang, 1, &bstCCor);
+  }
+  step = 0.5 * maxRot;
+  while((errNum == WLZ_ERR_NONE) && (step >= minStep))
+  {
+    /* Make the candidates which are within the maximum rotation. */
+    nC = 0;
+    for(idC = 0; idC < 6; ++idC)
+    {
+      double	a;
+
+      a = ang[idC / 2] + ((idC % 2)? step: -step);
+      if(fabs(a) <= maxRot)
+      {
+	for(idA = 0; idA < 3; ++idA)
+	{
+	  cAng[nC][idA] = ang[idA];
+	}
+	cAng[nC][idC / 2] = a;
+	++nC;
+      }
+    }
+    bstC = -1;
+    if(nC > 0)
+    {
+      for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < nC); idC += 2)
+      {
+	errNum = WlzRegCCorObjs3DRotCCor(&wSp, cAng + idC,
+					 WLZ_MIN(nC - idC, 2), cCor + idC);
+      }
+      bstC = 0;
+      for(idC = 1; idC < nC; ++idC)
+      {
+	if(cCor[idC] > cCor[bstC])
+	{
+	  bstC = idC;
+	}
+      }
+    }
+    if((errNum == WLZ_ERR_NONE) && (bstC >= 0) && (cCor[bstC] > bstCCor))
+    {
+      bstCCor = cCor[bstC];
+      for(idA = 0; idA < 3; ++idA)
+      {
+        ang[idA] = cAng[bstC][idA];
+      }
+    }
+    else
+    {
+      step *= 0.5;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    rotTr = WlzRegCCorRotTr3D(wSp.centre, ang, &errNum);
+  }
+  (void )WlzFreeObj(wSp.tPObj);
+  for(idA = 0; idA < 2; ++idA)
+  {
+    (void )AlcDouble3Free(wSp.tAr[idA]);
+    (void )AlcDouble3Free(wSp.sAr[idA]);
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(rotTr);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzRegistration
+* \brief	Makes sure that the arrays of the rotation search
+*		workspace cover the given box. If the box fits within
+*		the current arrays and they are not much larger than
+*		needed then the spectrum of the target object is kept,
+*		otherwise the arrays are reallocated if their size
+*		changes, the box is centred within them and the spectrum
+*		of the preprocessed target object is recomputed.
+* \param	wSp			Rotation search workspace.
+* \param	aBox			Box which the arrays must cover.
+*/
+static WlzErrorNum WlzRegCCorObjs3DRotTarget(WlzRegCCorRot3DWSp *wSp,
+					     WlzIBox3 aBox)
+{
+  int		idA;
+  WlzIVertex3	aSz;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  aSz.vtX = AlgFFTGoodSize(aBox.xMax - aBox.xMin + 1, 0);
+  aSz.vtY = AlgFFTGoodSize(aBox.yMax - aBox.yMin + 1, 0);
+  aSz.vtZ = AlgFFTGoodSize(aBox.zMax - aBox.zMin + 1, 0);
+  /* Recomputing the target spectrum costs one transform, while each pair
+   * costs two, so the current arrays are kept unless they are more than
+   * half as large again as needed. */
+  if((wSp->tAr[0] == NULL) ||
+     ((double )(wSp->aSz.vtX) * wSp->aSz.vtY * wSp->aSz.vtZ >
+      1.5 * aSz.vtX * aSz.vtY * aSz.vtZ) ||
+     (aBox.xMin < wSp->aOrg.vtX) ||
+     (aBox.yMin < wSp->aOrg.vtY) ||
+     (aBox.zMin < wSp->aOrg.vtZ) ||
+     (aBox.xMax >= wSp->aOrg.vtX + wSp->aSz.vtX) ||
+     (aBox.yMax >= wSp->aOrg.vtY + wSp->aSz.vtY) ||
+     (aBox.zMax >= wSp->aOrg.vtZ + wSp->aSz.vtZ))
+  {
+    if((wSp->tAr[0] == NULL) || (aSz.vtX != wSp->aSz.vtX) ||
+       (aSz.vtY != wSp->aSz.vtY) || (aSz.vtZ != wSp->aSz.vtZ))
+    {
+      for(idA = 0; idA < 2; ++idA)
+      {
+	(void )AlcDouble3Free(wSp->tAr[idA]);
+	(void )AlcDouble3Free(wSp->sAr[idA]);
+	wSp->tAr[idA] = wSp->sAr[idA] = NULL;
+      }
+      for(idA = 0; (errNum == WLZ_ERR_NONE) && (idA < 2); ++idA)
+      {
+	if((AlcDouble3Malloc(&(wSp->tAr[idA]),
+			     aSz.vtZ, aSz.vtY, aSz.vtX) != ALC_ER_NONE) ||
+	   (AlcDouble3Malloc(&(wSp->sAr[idA]),
+			     aSz.vtZ, aSz.vtY, aSz.vtX) != ALC_ER_NONE))
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      wSp->aSz = aSz;
+      wSp->aOrg.vtX = aBox.xMin - (aSz.vtX - (aBox.xMax - aBox.xMin + 1)) / 2;
+      wSp->aOrg.vtY = aBox.yMin - (aSz.vtY - (aBox.yMax - aBox.yMin + 1)) / 2;
+      wSp->aOrg.vtZ = aBox.zMin - (aSz.vtZ - (aBox.zMax - aBox.zMin + 1)) / 2;
+      errNum = WlzToArray3D((void ****)&(wSp->tAr[0]), wSp->tPObj,
+			    wSp->aSz, wSp->aOrg, wSp->noise,
+			    WLZ_GREY_DOUBLE);
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      (void )WlzArrayStats3D((void ***)(wSp->tAr[0]), wSp->aSz,
+			     WLZ_GREY_DOUBLE, NULL, NULL, NULL,
+			     &(wSp->tSSq), NULL, NULL);
+      (void )memset(**(wSp->tAr[1]), 0, sizeof(double) *
+		    wSp->aSz.vtX * wSp->aSz.vtY * wSp->aSz.vtZ);
+      errNum = WlzErrorFromAlg(
+	       AlgFFTDbl3D(wSp->tAr[0], wSp->tAr[1],
+			   wSp->aSz.vtX, wSp->aSz.vtY, wSp->aSz.vtZ,
+			   ALG_FFT_DIR_FWD));
+    }
+    if(errNum != WLZ_ERR_NONE)
+    {
+      for(idA = 0; idA < 2; ++idA)
+      {
+	(void )AlcDouble3Free(wSp->tAr[idA]);
+	(void )AlcDouble3Free(wSp->sAr[idA]);
+	wSp->tAr[idA] = wSp->sAr[idA] = NULL;
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzRegistration
+* \brief	Computes the normalised peak cross correlation values of
+*		the target object with the source object transformed by
+*		the initial transform followed by each of one or two
+*		candidate rotations. The two transformed source objects
+*		are correlated with the target spectrum together using
+*		AlgCrossCorrelateSpec3D(), with the arrays sized for the
+*		pair by WlzRegCCorObjs3DRotTarget().
+* \param	wSp			Rotation search workspace.
+* \param	cAng			Angles of rotation about the x, y
+*					and z axes for each candidate.
+* \param	nC			Number of candidates, either one or
+*					two.
+* \param	cCor			Destination for the normalised
+*					cross correlation value of each
+*					candidate.
+*/
+static WlzErrorNum WlzRegCCorObjs3DRotCCor(WlzRegCCorRot3DWSp *wSp,
+					   double (*cAng)[3], int nC,
+					   double *cCor)
+{
+  int		idC;
+  double	sSSq[2];
+  WlzIBox3	aBox;
+  WlzIBox3	pBox[2];
+  WlzObject	*pObj[2];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  /* Transform and window the source object for each candidate. */
+  pObj[0] = pObj[1] = NULL;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(2)
+#endif
+  for(idC = 0; idC < nC; ++idC)
+  {
+    WlzIBox3	oBox;
+    WlzIVertex3	centre,
+    		radius;
+    WlzObject	*oObj = NULL;
+    WlzAffineTransform *rotTr = NULL,
+  		*tr = NULL;
+    WlzErrorNum	errNum2 = WLZ_ERR_NONE;
+
+    rotTr = WlzRegCCorRotTr3D(wSp->centre, cAng[idC], &errNum2);
+    if(errNum2 == WLZ_ERR_NONE)
+    {
+      tr = WlzAffineTransformProduct(wSp->initTr, rotTr, &errNum2);
+    }
+    if(errNum2 == WLZ_ERR_NONE)
+    {
+      oObj = WlzAssignObject(
+	     WlzAffineTransformObj(wSp->sObj, tr, WLZ_INTERPOLATION_NEAREST,
+				   &errNum2), NULL);
+    }
+    if(errNum2 == WLZ_ERR_NONE)
+    {
+      oBox = WlzBoundingBox3I(oObj, &errNum2);
+    }
+    if(errNum2 == WLZ_ERR_NONE)
+    {
+      centre.vtX = (oBox.xMin + oBox.xMax) / 2;
+      centre.vtY = (oBox.yMin + oBox.yMax) / 2;
+      centre.vtZ = (oBox.zMin + oBox.zMax) / 2;
+      radius.vtX = WLZ_MAX((oBox.xMax - oBox.xMin) / 2, 1);
+      radius.vtY = WLZ_MAX((oBox.yMax - oBox.yMin) / 2, 1);
+      radius.vtZ = WLZ_MAX((oBox.zMax - oBox.zMin) / 2, 1);
+      pObj[idC] = WlzAssignObject(
+		  WlzRegCCorPProcessObj3D(oObj, wSp->winFn, centre, radius,
+					  &errNum2), NULL);
+    }
+    if(errNum2 == WLZ_ERR_NONE)
+    {
+      pBox[idC] = WlzBoundingBox3I(pObj[idC], &errNum2);
+    }
+    (void )WlzFreeObj(oObj);
+    (void )WlzFreeAffineTransform(rotTr);
+    (void )WlzFreeAffineTransform(tr);
+    if(errNum2 != WLZ_ERR_NONE)
+    {
+#ifdef _OPENMP
+#pragma omp critical (WlzRegCCorObjs3DRotCCor)
+#endif
+      {
+	if(errNum == WLZ_ERR_NONE)
+	{
+	  errNum = errNum2;
+	}
+      }
+    }
+  }
+  /* Make sure that the arrays cover the target and both candidates. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    aBox = wSp->tPBox;
+    for(idC = 0; idC < nC; ++idC)
+    {
+      aBox.xMin = WLZ_MIN(aBox.xMin, pBox[idC].xMin);
+      aBox.yMin = WLZ_MIN(aBox.yMin, pBox[idC].yMin);
+      aBox.zMin = WLZ_MIN(aBox.zMin, pBox[idC].zMin);
+      aBox.xMax = WLZ_MAX(aBox.xMax, pBox[idC].xMax);
+      aBox.yMax = WLZ_MAX(aBox.yMax, pBox[idC].yMax);
+      aBox.zMax = WLZ_MAX(aBox.zMax, pBox[idC].zMax);
+    }
+    aBox.xMin -= (int )(wSp->maxTran.vtX) + 1;
+    aBox.yMin -= (int )(wSp->maxTran.vtY) + 1;
+    aBox.zMin -= (int )(wSp->maxTran.vtZ) + 1;
+    aBox.xMax += (int )(wSp->maxTran.vtX) + 1;
+    aBox.yMax += (int )(wSp->maxTran.vtY) + 1;
+    aBox.zMax += (int )(wSp->maxTran.vtZ) + 1;
+    errNum = WlzRegCCorObjs3DRotTarget(wSp, aBox);
+  }
+  /* Extract the candidate arrays. A missing second candidate is
+   * correlated as an array of zeros. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(2)
+#endif
+    for(idC = 0; idC < 2; ++idC)
+    {
+      WlzErrorNum errNum2 = WLZ_ERR_NONE;
+
+      sSSq[idC] = 0.0;
+      if(idC < nC)
+      {
+	errNum2 = WlzToArray3D((void ****)&(wSp->sAr[idC]), pObj[idC],
+			       wSp->aSz, wSp->aOrg, wSp->noise,
+			       WLZ_GREY_DOUBLE);
+	if(errNum2 == WLZ_ERR_NONE)
+	{
+	  (void )WlzArrayStats3D((void ***)(wSp->sAr[idC]), wSp->aSz,
+				 WLZ_GREY_DOUBLE, NULL, NULL, NULL,
+				 &(sSSq[idC]), NULL, NULL);
+	}
+      }
+      else
+      {
+	(void )memset(**(wSp->sAr[idC]), 0, sizeof(double) *
+		      wSp->aSz.vtX * wSp->aSz.vtY * wSp->aSz.vtZ);
+      }
+      if(errNum2 != WLZ_ERR_NONE)
+      {
+#ifdef _OPENMP
+#pragma omp critical (WlzRegCCorObjs3DRotCCor)
+#endif
+	{
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = errNum2;
+	  }
+	}
+      }
+    }
+  }
+  for(idC = 0; idC < 2; ++idC)
+  {
+    (void )WlzFreeObj(pObj[idC]);
+  }
+  /* Cross correlate. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    errNum = WlzErrorFromAlg(
+	     AlgCrossCorrelateSpec3D(wSp->tAr[0], wSp->tAr[1],
+				     wSp->sAr[0], wSp->sAr[1],
+				     wSp->aSz.vtX, wSp->aSz.vtY,
+				     wSp->aSz.vtZ));
+  }
+  for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < nC); ++idC)
+  {
+    int		x,
+    		y,
+		z;
+
+    AlgCrossCorrPeakXYZ(&x, &y, &z, cCor + idC, wSp->sAr[idC],
+			wSp->aSz.vtX, wSp->aSz.vtY, wSp->aSz.vtZ,
+			wSp->maxTran.vtX, wSp->maxTran.vtY,
+			wSp->maxTran.vtZ);
+    cCor[idC] /= 1.0 + (sqrt(wSp->tSSq * sSSq[idC]) *
+			wSp->aSz.vtX * wSp->aSz.vtY * wSp->aSz.vtZ);
+  }
+  return(errNum);
+}
@@ -52,6 +52,21 @@ static char _WlzRegICP_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 #include <Wlz.h>
 
+/*!
+* \def		WLZ_REGICP_PAR_MIN
+* \ingroup	WlzTransform
+* \brief	Minimum number of vertices for which the per vertex loops
+*		of the ICP are run in parallel.
+*/
+#define WLZ_REGICP_PAR_MIN	(1024)
+
+/*!
+* \def		WLZ_REGICP_SUB_MIN
+* \ingroup	WlzTransform
+* \brief	Minimum number of source vertices in a random subsample.
+*/
+#define WLZ_REGICP_SUB_MIN	(64)
+
 /*!
 * \struct	_WlzRegICPWSp
 * \ingroup      WlzTransform
@@ -64,11 +79,19 @@ typedef struct _WlzRegICPWSp
   double	delta;		/*!< Convergence metric tollerance. */
   double	curMetric;	/*!< Current sum of distances between NN */
   double	prvMetric;	/*!< Last sum of distances between NN */
+  double	subFrac;	/*!< Initial fraction of the source vertices
+  				     used in each iteration */
+  double	trTol;		/*!< Early termination tolerance for the
+  				     transform update, not used if zero */
   /* Nearest neighbour search. */
   double	maxDist;	/*!< Maximum distance to consider for a NN */
-  AlcKDTTree	*tTree;		/*!< kD-tree */
+  AlcKDSTree	*tTree;		/*!< Static kD-tree of the target
+  				     vertices */
   int		*sNN;		/*!< Indicies of NN to source vertices */
   double	*dist;		/*!< NN distances */
+  double	*qry;		/*!< Transformed source vertex coordinates
+  				     used to query the kD-tree */
+  size_t	*nnIdx;		/*!< NN indices found by the kD-tree */
   /* Vericies and normals. */
   WlzVertexType vType;		/*!< Type of vertices WLZ_VERTEX_D2 or
   				     WLZ_VERTEX_D3 */
@@ -76,7 +99,13 @@ typedef struct _WlzRegICPWSp
   				     components. */
   int		nT;		/*!< Number of target vertices/normals */
   int		nS;		/*!< Number of source vertices/normals */
-  int		nMatch;		/*!< Minimum of nT and nS */
+  int		nPool;		/*!< Minimum of nT and nS */
+  int		nMatch;		/*!< Number of source vertices matched in
+  				     the current iteration, nPool unless
+				     subsampling */
+  int		*subIdx;	/*!< Random permutation of the source
+  				     vertex indices used for subsampling,
+				     may be NULL */
   WlzVertexP	gTVx;		/*!< Given target vertices */
   WlzVertexP	gSVx;		/*!< Given source vertices */
   WlzVertexP	gTNr;		/*!< Given target normals */
@@ -93,7 +122,7 @@ typedef struct _WlzRegICPWSp
 
 static void     		WlzRegICPTrans(
 				  WlzRegICPWSp *wSp);
-static void			WlzRegICPFindNN(
+static WlzErrorNum		WlzRegICPFindNN(
 				  WlzRegICPWSp *wSp);
 static int			WlzRegICPItr(
 				  WlzRegICPWSp *wSp,
@@ -106,7 +135,11 @@ static double			WlzRegICPWeight(
 				  double minDistWgt);
 static WlzErrorNum		WlzRegICPCompTransform(
 				  WlzRegICPWSp *wSp,
-				  WlzTransformType trType);
+				  WlzTransformType trType,
+				  double *dstDTr);
+static double			WlzRegICPTrUpdate(
+				  WlzAffineTransform *tr,
+				  WlzVertexType vType);
 static WlzErrorNum 		WlzRegICPCheckVertices(
 				  WlzVertexP *vData,
 				  int *vCnt,
@@ -114,7 +147,7 @@ static WlzErrorNum 		WlzRegICPCheckVertices(
 static WlzErrorNum 		WlzRegICPBuildTree(
 				  WlzRegICPWSp *wSp);
 static WlzAffineTransform 	*WlzRegICPTreeAndVerticesSimple(
-				  AlcKDTTree *tree,
+				  AlcKDSTree *tree,
 				  WlzTransformType trType,
 				  WlzVertexType vType,
 				  int sgnNrm,
@@ -137,6 +170,8 @@ static WlzAffineTransform 	*WlzRegICPTreeAndVerticesSimple(
 				  void *usrWgtData,
 				  double delta,
 				  double minDistWgt,
+				  double subFrac,
+				  double trTol,
 				  WlzErrorNum *dstErr);
 
 /*!
@@ -173,6 +208,13 @@ static WlzAffineTransform 	*WlzRegICPTreeAndVerticesSimple(
 * \param	delta			Tolerance for mean value of
 *					registration metric.
 * \param	minDistWgt		Minimum distance weighting.
+* \param	subFrac			Initial fraction of the source
+*					vertices used, see
+*					WlzRegICPVerticesSched(). A value
+*					of 1.0 disables subsampling.
+* \param	trTol			Tolerance for the transform update,
+*					a value of 0.0 disables early
+*					termination.
 * \param	dstErr			Destination error pointer,
 *					may be NULL.
 */
@@ -182,6 +224,7 @@ WlzAffineTransform *WlzRegICPObjsGrd(WlzObject *tObj, WlzObject *sObj,
 				     double ctrLo, double ctrHi, double ctrWth,
 				     int *dstConv, int *dstItr, int maxItr,
 				     double delta, double minDistWgt,
+				     double subFrac, double trTol,
 				     WlzErrorNum *dstErr)
 {
   int		idN,
@@ -288,11 +331,12 @@ WlzAffineTransform *WlzRegICPObjsGrd(WlzObject *tObj, WlzObject *sObj,
   /* Register the position vertices and normals. */
   if(errNum == WLZ_ERR_NONE)
   {
-    regTr = WlzRegICPVertices(vData[0], nData[0], vCnt[0],
-			       vData[1], nData[1], vCnt[1],
-			       vType, 1, initTr,
-			       trType, &conv, &itr, maxItr,
-			       delta, minDistWgt, &errNum);
+    regTr = WlzRegICPVerticesSched(vData[0], nData[0], vCnt[0],
+				   vData[1], nData[1], vCnt[1],
+				   vType, 1, initTr,
+				   trType, &conv, &itr, maxItr,
+				   delta, minDistWgt, subFrac, trTol,
+				   &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -339,6 +383,13 @@ WlzAffineTransform *WlzRegICPObjsGrd(WlzObject *tObj, WlzObject *sObj,
 * \param	delta			Tolerance for mean value of
 *					registration metric.
 * \param	minDistWgt		Minimum distance weighting.
+* \param	subFrac			Initial fraction of the source
+*					vertices used, see
+*					WlzRegICPVerticesSched(). A value
+*					of 1.0 disables subsampling.
+* \param	trTol			Tolerance for the transform update,
+*					a value of 0.0 disables early
+*					termination.
 * \param	dstErr			Destination error pointer,
 *					may be NULL.
 */
@@ -347,6 +398,7 @@ WlzAffineTransform *WlzRegICPObjs(WlzObject *tObj, WlzObject *sObj,
 				  WlzTransformType trType,
 				  int *dstConv, int *dstItr, int maxItr,
 				  double delta, double minDistWgt,
+				  double subFrac, double trTol,
 				  WlzErrorNum *dstErr)
 {
   int		idx,
@@ -400,11 +452,12 @@ WlzAffineTransform *WlzRegICPObjs(WlzObject *tObj, WlzObject *sObj,
   }
   if(errNum == WLZ_ERR_NONE)
   {
-     regTr = WlzRegICPVertices(vData[0], nData[0], vCnt[0],
-     				vData[1], nData[1], vCnt[1],
-     				vType[0], sgnNrm, initTr,
-				trType, &conv, &itr, maxItr,
-				delta, minDistWgt, &errNum);
+     regTr = WlzRegICPVerticesSched(vData[0], nData[0], vCnt[0],
+     				    vData[1], nData[1], vCnt[1],
+     				    vType[0], sgnNrm, initTr,
+				    trType, &conv, &itr, maxItr,
+				    delta, minDistWgt, subFrac, trTol,
+				    &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -742,6 +795,86 @@ WlzAffineTransform	*WlzRegICPVertices(WlzVertexP tVx, WlzVertexP tNr,
 				     	    double delta,
 					    double minDistWgt,
 					    WlzErrorNum *dstErr)
+{
+  WlzAffineTransform *regTr;
+
+  regTr = WlzRegICPVerticesSched(tVx, tNr, tCnt, sVx, sNr, sCnt,
+  				 vType, sgnNrm, initTr, trType,
+				 dstConv, dstItr, maxItr, delta, minDistWgt,
+				 1.0, 0.0, dstErr);
+  return(regTr);
+}
+
+/*!
+* \return				Affine transform which brings
+*					the two sets of vertices into
+*					register.
+* \ingroup	WlzTransform
+* \brief	Registers the two given sets of vertices using the
+*		iterative closest point algorithm, as for
+*		WlzRegICPVertices(), but with an optional random
+*		subsampling schedule and early termination.
+*
+*		If the subsample fraction is less than one, each
+*		iteration matches only a random subsample of the source
+*		vertices, starting with the given fraction of them.
+*		Each time the registration converges using a subsample
+*		the subsample size is doubled, until all the source
+*		vertices are used. Early iterations are then cheap and
+*		the final iterations use all the vertices.
+*
+*		If the transform update tolerance is greater than zero,
+*		the iteration ends as soon as the computed transform
+*		update has no element which differs from the identity
+*		transform by more than the tolerance.
+* \param	tVx			Target vertices.
+* \param	tNr			Target normals, may be NULL.
+* \param	tCnt			Number of target vertices.
+* \param	sVx			Source vertices.
+* \param	sNr			Source normals, may be NULL.
+* \param	sCnt			Number of source vertices.
+* \param	vType			Type of the vertices.
+* \param	sgnNrm			Non zero if the normals have reliably
+*					signed components.
+* \param	initTr			Initial affine transform
+*					to be applied to the source
+*					object prior to using the ICP
+*					algorithm. May be NULL.
+* \param	trType			Required transform type.
+* \param	dstConv			Destination ptr for the
+*					convergence flag (non zero
+*					on convergence), may be NULL.
+* \param	dstItr			Destination ptr for the number
+*					of iterations, may be NULL.
+* \param	maxItr			Maximum number of iterations,
+*					if <= 0 then infinite iterations
+*					are allowed.
+* \param	delta			Tolerance for mean value of
+*					registration metric.
+* \param	minDistWgt		Minimum distance weighting.
+* \param	subFrac			Initial fraction of the source
+*					vertices used, range (0.0-1.0]. A
+*					value of 1.0 disables subsampling.
+* \param	trTol			Tolerance for the transform update,
+*					a value of 0.0 disables early
+*					termination.
+* \param	dstErr			Destination error pointer,
+*					may be NULL.
+*/
+WlzAffineTransform	*WlzRegICPVerticesSched(WlzVertexP tVx,
+					    WlzVertexP tNr, int tCnt,
+					    WlzVertexP sVx, WlzVertexP sNr,
+					    int sCnt,
+					    WlzVertexType vType, int sgnNrm,
+					    WlzAffineTransform *initTr,
+					    WlzTransformType trType,
+					    int *dstConv, int *dstItr,
+					    int maxItr,
+				     	    double delta,
+					    double minDistWgt,
+					    double subFrac,
+					    double trTol,
+					    WlzErrorNum *dstErr)
 {
   int		conv = 0,
 		maxCnt = 0;
@@ -754,15 +887,21 @@ WlzAffineTransform	*WlzRegICPVertices(WlzVertexP tVx, WlzVertexP tNr,
   wSp.delta = delta;
   wSp.curMetric = DBL_MAX;
   wSp.prvMetric = DBL_MAX;
+  wSp.subFrac = subFrac;
+  wSp.trTol = trTol;
   wSp.maxDist = DBL_MAX;
   wSp.tTree = NULL;
   wSp.sNN = NULL;
   wSp.dist = NULL;
+  wSp.qry = NULL;
+  wSp.nnIdx = NULL;
   wSp.vType = vType;
   wSp.sgnNrm = sgnNrm;
   wSp.nT = tCnt;
   wSp.nS = sCnt;
-  wSp.nMatch = WLZ_MIN(tCnt, sCnt);
+  wSp.nPool = WLZ_MIN(tCnt, sCnt);
+  wSp.nMatch = wSp.nPool;
+  wSp.subIdx = NULL;
   wSp.gTVx = tVx;
   wSp.gSVx = sVx;
   wSp.gTNr = tNr;
@@ -776,10 +915,23 @@ WlzAffineTransform	*WlzRegICPVertices(WlzVertexP tVx, WlzVertexP tNr,
   maxCnt = WLZ_MAX(tCnt, sCnt);
   if(((wSp.sNN = (int *)AlcMalloc(sizeof(int) * maxCnt)) == NULL) ||
      ((wSp.dist = (double *)AlcMalloc(sizeof(double) * maxCnt)) == NULL) ||
-     ((wSp.wgt = (double *)AlcMalloc(sizeof(double) * maxCnt)) == NULL))
+     ((wSp.wgt = (double *)AlcMalloc(sizeof(double) * maxCnt)) == NULL) ||
+     ((wSp.qry = (double *)AlcMalloc(sizeof(double) * 3 * maxCnt)) == NULL) ||
+     ((wSp.nnIdx = (size_t *)AlcMalloc(sizeof(size_t) * maxCnt)) == NULL))
   {
     errNum = WLZ_ERR_MEM_ALLOC;
   }
+  else if((subFrac <= 0.0) || (subFrac > 1.0) || (trTol < 0.0))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if(subFrac < 1.0)
+  {
+    if((wSp.subIdx = (int *)AlcMalloc(sizeof(int) * wSp.nPool)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
   if(errNum == WLZ_ERR_NONE)
   {
     if(initTr)
@@ -879,6 +1031,10 @@ WlzAffineTransform	*WlzRegICPVertices(WlzVertexP tVx, WlzVertexP tNr,
   AlcFree(wSp.sNN);
   AlcFree(wSp.dist);
   AlcFree(wSp.wgt);
+  AlcFree(wSp.qry);
+  AlcFree(wSp.nnIdx);
+  AlcFree(wSp.subIdx);
+  (void )AlcKDSTreeFree(wSp.tTree);
   AlcFree(wSp.tSVx.v);
   AlcFree(wSp.tSNr.v);
   AlcFree(wSp.nNTVx.v);
@@ -962,15 +1118,21 @@ WlzObject	*WlzRegICPVerticesWSD2D(WlzVertexP tVx, WlzVertexP tNr,
   wSp.itr = 0;
   wSp.curMetric = DBL_MAX;
   wSp.prvMetric = DBL_MAX;
+  wSp.subFrac = 1.0;
+  wSp.trTol = 0.0;
   wSp.maxDist = DBL_MAX;
   wSp.tTree = NULL;
   wSp.sNN = NULL;
   wSp.dist = NULL;
+  wSp.qry = NULL;
+  wSp.nnIdx = NULL;
   wSp.vType = vType;
   wSp.sgnNrm = sgnNrm;
   wSp.nT = tCnt;
   wSp.nS = sCnt;
-  wSp.nMatch = WLZ_MIN(tCnt, sCnt);
+  wSp.nPool = WLZ_MIN(tCnt, sCnt);
+  wSp.nMatch = wSp.nPool;
+  wSp.subIdx = NULL;
   wSp.gTVx = tVx;
   wSp.gSVx = sVx;
   wSp.gTNr = tNr;
@@ -991,7 +1153,10 @@ WlzObject	*WlzRegICPVerticesWSD2D(WlzVertexP tVx, WlzVertexP tNr,
   {
     if(((wSp.sNN = (int *)AlcMalloc(sizeof(int) * maxCnt)) == NULL) ||
        ((wSp.dist = (double *)AlcMalloc(sizeof(double) * maxCnt)) == NULL) ||
-       ((wSp.wgt = (double *)AlcMalloc(sizeof(double) * maxCnt)) == NULL))
+       ((wSp.wgt = (double *)AlcMalloc(sizeof(double) * maxCnt)) == NULL) ||
+       ((wSp.qry = (double *)AlcMalloc(sizeof(double) * 3 *
+       				       maxCnt)) == NULL) ||
+       ((wSp.nnIdx = (size_t *)AlcMalloc(sizeof(size_t) * maxCnt)) == NULL))
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
@@ -1072,7 +1237,10 @@ WlzObject	*WlzRegICPVerticesWSD2D(WlzVertexP tVx, WlzVertexP tNr,
 	  if(errNum == WLZ_ERR_NONE)
 	  {
 	    WlzRegICPTrans(&wSp);
-	    WlzRegICPFindNN(&wSp);
+	    errNum = WlzRegICPFindNN(&wSp);
+	  }
+	  if(errNum == WLZ_ERR_NONE)
+	  {
 	    /* Compute weighted sum of distances for mObj. */
 	    mAry[idZ][idY][idX] = WlzRegICPWeight(&wSp, minDistWgt);
 	  }
@@ -1083,6 +1251,9 @@ WlzObject	*WlzRegICPVerticesWSD2D(WlzVertexP tVx, WlzVertexP tNr,
   AlcFree(wSp.sNN);
   AlcFree(wSp.dist);
   AlcFree(wSp.wgt);
+  AlcFree(wSp.qry);
+  AlcFree(wSp.nnIdx);
+  (void )AlcKDSTreeFree(wSp.tTree);
   AlcFree(wSp.tSVx.v);
   AlcFree(wSp.tSNr.v);
   AlcFree(wSp.nNTVx.v);
@@ -1108,7 +1279,7 @@ WlzObject	*WlzRegICPVerticesWSD2D(WlzVertexP tVx, WlzVertexP tNr,
 /*!
 * \return				Woolz error code
 * \ingroup	WlzTransform
-* \brief	Allocates and populates a k-D tree from the given vertices.
+* \brief	Builds a static k-D tree from the target vertices.
 * 		The vertices are either WlzDVertex2 orWlzDVertex3
 * \param	wSp			ICP registration workspace.
 */
@@ -1116,9 +1287,8 @@ static WlzErrorNum WlzRegICPBuildTree(WlzRegICPWSp *wSp)
 {
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  /* Use wSp->sNN as a temporay buffer of shuffling indcies. */
-  wSp->tTree = WlzVerticesBuildTree(wSp->vType, wSp->nT, wSp->gTVx,
-  				     wSp->sNN, &errNum);
+  wSp->tTree = WlzVerticesBuildKDSTree(wSp->vType, wSp->nT, wSp->gTVx,
+  				       &errNum);
   return(errNum);
 }
 
@@ -1128,6 +1298,20 @@ static WlzErrorNum WlzRegICPBuildTree(WlzRegICPWSp *wSp)
 * \ingroup	WlzTransform
 * \brief	The iterative loop of the ICP, which iterates to find the
 * 		registration transform.
+*
+*		If the workspace has a subsampling permutation then
+*		iterations start using a random subsample of the
+*		source vertices, with a new subsample drawn for each
+*		iteration. Each time the registration converges using
+*		the subsample the size of the subsample is doubled,
+*		until all the source vertices are used. Only convergence
+*		using all the source vertices ends the iteration.
+*
+*		If the workspace has a non zero transform update
+*		tolerance the iteration also ends when the computed
+*		transform update differs from the identity by less
+*		than the tolerance, which saves the final nearest
+*		neighbour search.
 * \param	wSp			ICP registration workspace.
 * \param	trType			Type of affine transform.
 * \param	maxItr			Maximum number of iterations.
@@ -1140,18 +1324,34 @@ static int	WlzRegICPItr(WlzRegICPWSp *wSp,
 			     double minDistWgt, WlzErrorNum *dstErr)
 {
   int		conv = 0;
+  double	dTr = DBL_MAX;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
+  wSp->nMatch = wSp->nPool;
+  if(wSp->subIdx && (wSp->subFrac < 1.0))
+  {
+    wSp->nMatch = WLZ_MAX((int )(wSp->subFrac * wSp->nPool),
+    			  WLZ_REGICP_SUB_MIN);
+    wSp->nMatch = WLZ_MIN(wSp->nMatch, wSp->nPool);
+  }
   do
   {
 #ifdef WLZ_REGICP_DEBUG
     (void )fprintf(stderr, "WlzRegICP wSp->itr = %d\n", wSp->itr);
 #endif /* WLZ_REGICP_DEBUG */
     wSp->prvMetric = wSp->curMetric;
+    /* Draw a new random subsample of the source vertices. */
+    if(wSp->nMatch < wSp->nPool)
+    {
+      (void )AlgShuffleIdx(wSp->nPool, wSp->subIdx, wSp->itr);
+    }
     /* Apply current transform to the vertices and normals. */
     WlzRegICPTrans(wSp);
     /* Find closest points. */
-    WlzRegICPFindNN(wSp);
+    if((errNum = WlzRegICPFindNN(wSp)) != WLZ_ERR_NONE)
+    {
+      break;
+    }
     /* Compute weightings of the matches and current metric. */
     wSp->curMetric = WlzRegICPWeight(wSp, minDistWgt);
     /* Check for convergence. */
@@ -1161,14 +1361,25 @@ static int	WlzRegICPItr(WlzRegICPWSp *wSp,
 #endif /* WLZ_REGICP_DEBUG */
     if(conv)
     {
-      (void )WlzFreeAffineTransform(wSp->curTr);
-      wSp->curTr = wSp->prvTr;
-      wSp->prvTr = NULL;
+      if(wSp->prvTr)
+      {
+	(void )WlzFreeAffineTransform(wSp->curTr);
+	wSp->curTr = wSp->prvTr;
+	wSp->prvTr = NULL;
+      }
     }
     else
     {
       /* Compute registration transform. */
-      errNum = WlzRegICPCompTransform(wSp, trType);
+      errNum = WlzRegICPCompTransform(wSp, trType, &dTr);
+      conv = (errNum == WLZ_ERR_NONE) && (dTr < wSp->trTol);
+    }
+    /* Move on to a larger subsample if converged using a subsample. */
+    if(conv && (wSp->nMatch < wSp->nPool))
+    {
+      conv = 0;
+      wSp->curMetric = DBL_MAX;
+      wSp->nMatch = WLZ_MIN(2 * wSp->nMatch, wSp->nPool);
     }
   } while((errNum == WLZ_ERR_NONE) && (wSp->itr++ < maxItr) && (conv == 0));
   if(wSp->itr > maxItr)
@@ -1186,90 +1397,112 @@ static int	WlzRegICPItr(WlzRegICPWSp *wSp,
 * \return       void
 * \ingroup	WlzTransform
 * \brief        Transforms the source vertices and normals using the
-*               current affine transform.
+*               current affine transform. Only the source vertices
+*		which are to be matched are transformed and, when
+*		subsampling, these are packed in subsample order.
 * \param        wSp                     ICP registration workspace.
 */
 static void     WlzRegICPTrans(WlzRegICPWSp *wSp)
 {
   int		idx;
+  int		*subIdx;
 
-  if(wSp->vType == WLZ_VERTEX_D2)
+  subIdx = (wSp->nMatch < wSp->nPool)? wSp->subIdx: NULL;
+#ifdef _OPENMP
+#pragma omp parallel for if(wSp->nMatch >= WLZ_REGICP_PAR_MIN)
+#endif
+  for(idx = 0; idx < wSp->nMatch; ++idx)
   {
-    for(idx = 0; idx < wSp->nS; ++idx)
+    int		idS;
+
+    idS = (subIdx)? *(subIdx + idx): idx;
+    if(wSp->vType == WLZ_VERTEX_D2)
     {
       *(wSp->tSVx.d2 + idx) = WlzAffineTransformVertexD2(wSp->curTr,
-      						*(wSp->gSVx.d2 + idx), NULL);
-    }
-    if(wSp->gSNr.v)
-    {
-      for(idx = 0; idx < wSp->nS; ++idx)
+      						*(wSp->gSVx.d2 + idS), NULL);
+      if(wSp->gSNr.v)
       {
         *(wSp->tSNr.d2 + idx) = WlzAffineTransformNormalD2(wSp->curTr,
-						*(wSp->gSNr.d2 + idx), NULL);
+						*(wSp->gSNr.d2 + idS), NULL);
       }
     }
-  }
-  else /* wSp->vType == WLZ_VERTEX_D3 */
-  {
-    for(idx = 0; idx < wSp->nS; ++idx)
+    else /* wSp->vType == WLZ_VERTEX_D3 */
     {
       *(wSp->tSVx.d3 + idx) = WlzAffineTransformVertexD3(wSp->curTr,
-      						*(wSp->gSVx.d3 + idx), NULL);
-    }
-    if(wSp->gSNr.v)
-    {
-      for(idx = 0; idx < wSp->nS; ++idx)
+      						*(wSp->gSVx.d3 + idS), NULL);
+      if(wSp->gSNr.v)
       {
         *(wSp->tSNr.d3 + idx) = WlzAffineTransformNormalD3(wSp->curTr,
-						*(wSp->gSNr.d3 + idx), NULL);
+						*(wSp->gSNr.d3 + idS), NULL);
       }
     }
   }
 }
 
 /*!
-* \return	void
+* \return	Woolz error code.
 * \ingroup	WlzTransform
 * \brief	Finds nearest neighbour matches in the target tree for
 *		the source vertices, sets the nearest neighbour
 *		indicies and permutes the NN ordered target vertices in
-*		the workspace.
+*		the workspace. All the source vertices are queried in
+*		a single batch, which is run in parallel.
 * \param	wSp			ICP registration workspace.
 */
-static void	WlzRegICPFindNN(WlzRegICPWSp *wSp)
+static WlzErrorNum WlzRegICPFindNN(WlzRegICPWSp *wSp)
 {
   int		idx;
-  WlzDVertex2	tVD2;
-  WlzDVertex3	tVD3;
-  double	datD[3];
-  AlcKDTNode	*node;
+  double	*qry;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  for(idx = 0; idx < wSp->nMatch; ++idx)
+  qry = wSp->qry;
+  if(wSp->vType == WLZ_VERTEX_D2)
   {
-    if(wSp->vType == WLZ_VERTEX_D2)
-    {
-      tVD2 = *(wSp->tSVx.d2 + idx);
-      datD[0] = tVD2.vtX;
-      datD[1] = tVD2.vtY;
-    }
-    else /* wSp->vType == WLZ_VERTEX_D3 */
+#ifdef _OPENMP
+#pragma omp parallel for if(wSp->nMatch >= WLZ_REGICP_PAR_MIN)
+#endif
+    for(idx = 0; idx < wSp->nMatch; ++idx)
     {
-      tVD3 = *(wSp->tSVx.d3 + idx);
-      datD[0] = tVD3.vtX;
-      datD[1] = tVD3.vtY;
-      datD[2] = tVD3.vtZ;
+      *(qry + (2 * idx)) = (wSp->tSVx.d2 + idx)->vtX;
+      *(qry + (2 * idx) + 1) = (wSp->tSVx.d2 + idx)->vtY;
     }
-    node = AlcKDTGetNN(wSp->tTree, datD, wSp->maxDist, wSp->dist + idx, NULL);
-    *(wSp->sNN + idx) = node->idx;
-    if(wSp->vType == WLZ_VERTEX_D2)
+  }
+  else /* wSp->vType == WLZ_VERTEX_D3 */
+  {
+#ifdef _OPENMP
+#pragma omp parallel for if(wSp->nMatch >= WLZ_REGICP_PAR_MIN)
+#endif
+    for(idx = 0; idx < wSp->nMatch; ++idx)
     {
-      *(wSp->nNTVx.d2 + idx) = *(wSp->gTVx.d2 + node->idx);
+      *(qry + (3 * idx)) = (wSp->tSVx.d3 + idx)->vtX;
+      *(qry + (3 * idx) + 1) = (wSp->tSVx.d3 + idx)->vtY;
+      *(qry + (3 * idx) + 2) = (wSp->tSVx.d3 + idx)->vtZ;
     }
-    else /* wSp->vType == WLZ_VERTEX_D3 */
+  }
+  if(AlcKDSGetKNN(wSp->tTree, wSp->nMatch, wSp->qry, 1, wSp->maxDist,
+  		  wSp->nnIdx, wSp->dist) != ALC_ER_NONE)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+#ifdef _OPENMP
+#pragma omp parallel for if(wSp->nMatch >= WLZ_REGICP_PAR_MIN)
+#endif
+    for(idx = 0; idx < wSp->nMatch; ++idx)
     {
-      *(wSp->nNTVx.d3 + idx) = *(wSp->gTVx.d3 + node->idx);
+      *(wSp->sNN + idx) = (int )*(wSp->nnIdx + idx);
+      if(wSp->vType == WLZ_VERTEX_D2)
+      {
+	*(wSp->nNTVx.d2 + idx) = *(wSp->gTVx.d2 + *(wSp->sNN + idx));
+      }
+      else /* wSp->vType == WLZ_VERTEX_D3 */
+      {
+	*(wSp->nNTVx.d3 + idx) = *(wSp->gTVx.d3 + *(wSp->sNN + idx));
+      }
     }
   }
+  return(errNum);
 }
 
 /*!
@@ -1318,13 +1551,9 @@ static double	WlzRegICPWeight(WlzRegICPWSp *wSp, double minVxWgt)
 		w0,
 		w1,
 		w2,
-  		wVx,
 		minDist,
 		maxDist,
-		wNr = 0.0,
 		meanSumWgt = 0.0;
-  WlzVertex	sV,
-  		tV;
 
   /* Find the maximum and minimum distances. */
   minDist = maxDist = *(wSp->dist + 0);
@@ -1343,8 +1572,14 @@ static double	WlzRegICPWeight(WlzRegICPWSp *wSp, double minVxWgt)
   w0 = maxDist - minDist;
   w1 = 1.0 - minVxWgt;
   w2 = (w0 > DBL_EPSILON)? w1 / w0: 1.0;
+#ifdef _OPENMP
+#pragma omp parallel for if(wSp->nMatch >= WLZ_REGICP_PAR_MIN)
+#endif
   for(idx = 0; idx < wSp->nMatch; ++idx)
   {
+    double	wVx,
+    		wNr = 0.0;
+
     /* Use linear weighting for distance such that:
      *   w = minVxWgt, d = maxDist
      * and
@@ -1362,31 +1597,26 @@ static double	WlzRegICPWeight(WlzRegICPWSp *wSp, double minVxWgt)
     {
       if(wSp->vType == WLZ_VERTEX_D2)
       {
-        tV.d2 = *(wSp->gTNr.d2 + *(wSp->sNN + idx));
-	sV.d2 = *(wSp->tSNr.d2 + idx);
-	wNr = WLZ_VTX_2_DOT(sV.d2, tV.d2);
+	wNr = WLZ_VTX_2_DOT(*(wSp->tSNr.d2 + idx),
+			    *(wSp->gTNr.d2 + *(wSp->sNN + idx)));
       }
       else /* wSp->vType == WLZ_VERTEX_D3 */
       {
-        tV.d3 = *(wSp->gTNr.d3 + *(wSp->sNN + idx));
-	sV.d3 = *(wSp->tSNr.d3 + idx);
-	wNr = WLZ_VTX_3_DOT(sV.d3, tV.d3);
+	wNr = WLZ_VTX_3_DOT(*(wSp->tSNr.d3 + idx),
+			    *(wSp->gTNr.d3 + *(wSp->sNN + idx)));
       }
       if(wSp->sgnNrm && (wNr < 0.0))
       {
         wNr = 0.0;
       }
     }
-    if(wSp->sgnNrm)
-    {
-      tD0 = wVx * wNr;
-    }
-    else
-    {
-      tD0 = wVx * wNr * wNr;
-    }
-    meanSumWgt += tD0 * *(wSp->dist + idx);
-    *(wSp->wgt + idx) = tD0;
+    *(wSp->wgt + idx) = (wSp->sgnNrm)? wVx * wNr: wVx * wNr * wNr;
+  }
+  /* Sum in order so that the metric does not depend on the number of
+   * threads. */
+  for(idx = 0; idx < wSp->nMatch; ++idx)
+  {
+    meanSumWgt += *(wSp->wgt + idx) * *(wSp->dist + idx);
   }
   meanSumWgt /= wSp->nMatch;
   return(meanSumWgt);
@@ -1399,10 +1629,17 @@ static double	WlzRegICPWeight(WlzRegICPWSp *wSp, double minVxWgt)
 *		and the weights.
 * \param	wSp			ICP registration workspace.
 * \param	trType	 		Required transform type.
+* \param	dstDTr			Destination pointer for the maximum
+*					absolute difference between the
+*					elements of the transform update and
+*					those of the identity transform,
+*					may be NULL.
 */
 static WlzErrorNum WlzRegICPCompTransform(WlzRegICPWSp *wSp,
-				          WlzTransformType trType)
+				          WlzTransformType trType,
+					  double *dstDTr)
 {
+  double	dTr = 0.0;
   WlzAffineTransform *newTr = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 #ifdef WLZ_REGICP_DEBUG
@@ -1480,6 +1717,7 @@ static WlzErrorNum WlzRegICPCompTransform(WlzRegICPWSp *wSp,
     (void )fprintf(stderr, "WlzRegICP newTr->mat = \n");
     (void )AlcDouble2WriteAsci(stderr, newTr->mat, 4, 4);
 #endif /* WLZ_REGICP_DEBUG */
+    dTr = WlzRegICPTrUpdate(newTr, wSp->vType);
     (void )WlzFreeAffineTransform(wSp->prvTr);
     wSp->prvTr = wSp->curTr;
     wSp->curTr = WlzAffineTransformProduct(newTr, wSp->prvTr, &errNum);
@@ -1490,9 +1728,45 @@ static WlzErrorNum WlzRegICPCompTransform(WlzRegICPWSp *wSp,
 #endif /* WLZ_REGICP_DEBUG */
   }
   (void )WlzFreeAffineTransform(newTr);
+  if(dstDTr)
+  {
+    *dstDTr = dTr;
+  }
   return(errNum);
 }
 
+/*!
+* \return	Maximum absolute difference between the elements of the
+*		given transform update and those of the identity
+*		transform.
+* \ingroup	WlzTransform
+* \brief	Computes the size of a transform update, which is used
+*		for early termination of the ICP iteration. Only the
+*		rotation, scale, shear and translation elements are
+*		compared.
+* \param	tr			Given transform update.
+* \param	vType			Type of the vertices.
+*/
+static double	WlzRegICPTrUpdate(WlzAffineTransform *tr,
+				  WlzVertexType vType)
+{
+  int		idR,
+  		idC,
+		dim;
+  double	dTr = 0.0;
+
+  dim = (vType == WLZ_VERTEX_D2)? 2: 3;
+  for(idR = 0; idR < dim; ++idR)
+  {
+    for(idC = 0; idC <= dim; ++idC)
+    {
+      dTr = WLZ_MAX(dTr, fabs(tr->mat[idR][idC] -
+			      ((idR == idC)? 1.0: 0.0)));
+    }
+  }
+  return(dTr);
+}
+
 /*!
 * \return	Affine transform found.
 * \ingroup	WlzTransform
@@ -1537,10 +1811,17 @@ static WlzErrorNum WlzRegICPCompTransform(WlzRegICPWSp *wSp,
 * \param	delta			Tolerance for mean value of
 *					registration metric.
 * \param	minDistWgt		Minimum distance weighting.
+* \param	subFrac			Initial fraction of the source
+*					vertices used, see
+*					WlzRegICPVerticesSched(). A value
+*					of 1.0 disables subsampling.
+* \param	trTol			Tolerance for the transform update,
+*					a value of 0.0 disables early
+*					termination.
 * \param	dstErr			Destination error pointer,
 *					may be NULL.
 */
-WlzAffineTransform *WlzRegICPTreeAndVertices(AlcKDTTree *tree,
+WlzAffineTransform *WlzRegICPTreeAndVertices(AlcKDSTree *tree,
 				WlzTransformType trType,
 				WlzVertexType vType, int sgnNrm,
 				int nT, WlzVertexP tVx, WlzVertexP tNr,
@@ -1551,6 +1832,7 @@ WlzAffineTransform *WlzRegICPTreeAndVertices(AlcKDTTree *tree,
 				WlzAffineTransform *initTr, int *dstConv,
 				WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
 				double delta, double minDistWgt,
+				double subFrac, double trTol,
 				WlzErrorNum *dstErr)
 {
   int		conv = 0;
@@ -1561,19 +1843,26 @@ WlzAffineTransform *WlzRegICPTreeAndVertices(AlcKDTTree *tree,
   		*newTr1 = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  switch(trType)
+  if((subFrac <= 0.0) || (subFrac > 1.0) || (trTol < 0.0))
   {
-    case WLZ_TRANSFORM_2D_REG: /* FALLTHROUGH */
-    case WLZ_TRANSFORM_2D_AFFINE:
-      trType0 = WLZ_TRANSFORM_2D_REG;
-      break;
-    case WLZ_TRANSFORM_3D_REG: /* FALLTHROUGH */
-    case WLZ_TRANSFORM_3D_AFFINE:
-      trType0 = WLZ_TRANSFORM_3D_REG;
-      break;
-    default:
-      errNum = WLZ_ERR_TRANSFORM_TYPE;
-      break;
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    switch(trType)
+    {
+      case WLZ_TRANSFORM_2D_REG: /* FALLTHROUGH */
+      case WLZ_TRANSFORM_2D_AFFINE:
+	trType0 = WLZ_TRANSFORM_2D_REG;
+	break;
+      case WLZ_TRANSFORM_3D_REG: /* FALLTHROUGH */
+      case WLZ_TRANSFORM_3D_AFFINE:
+	trType0 = WLZ_TRANSFORM_3D_REG;
+	break;
+      default:
+	errNum = WLZ_ERR_TRANSFORM_TYPE;
+	break;
+    }
   }
   if(errNum == WLZ_ERR_NONE)
   {
@@ -1583,7 +1872,7 @@ WlzAffineTransform *WlzRegICPTreeAndVertices(AlcKDTTree *tree,
 					 maxItr, initTr,
 					 &prvMetric, &curMetric, &conv,
 					 usrWgtFn, usrWgtData,
-					 delta, minDistWgt,
+					 delta, minDistWgt, subFrac, trTol,
 					 &errNum);
 #ifdef WLZ_REGICP_DEBUG
     (void )fprintf(stderr, "WlzRegICP newTr0->mat = \n");
@@ -1598,7 +1887,7 @@ WlzAffineTransform *WlzRegICPTreeAndVertices(AlcKDTTree *tree,
 					 maxItr, newTr0,
 					 &prvMetric, &curMetric, &conv,
 					 usrWgtFn, usrWgtData,
-					 delta, minDistWgt,
+					 delta, minDistWgt, subFrac, trTol,
 					 &errNum);
     (void )WlzFreeAffineTransform(newTr0);
     newTr0 = newTr1;
@@ -1666,10 +1955,13 @@ WlzAffineTransform *WlzRegICPTreeAndVertices(AlcKDTTree *tree,
 * \param	delta			Tolerance for mean value of
 *					registration metric.
 * \param	minDistWgt		Minimum distance weighting.
+* \param	subFrac			Initial fraction of the source
+*					vertices used.
+* \param	trTol			Tolerance for the transform update.
 * \param	dstErr			Destination error pointer,
 *					may be NULL.
 */
-static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
+static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDSTree *tree,
 				WlzTransformType trType,
 				WlzVertexType vType, int sgnNrm,
 				int nT, WlzVertexP tVx, WlzVertexP tNr,
@@ -1682,25 +1974,28 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
 				int *dstConv,
 				WlzRegICPUsrWgtFn usrWgtFn, void *usrWgtData,
 				double delta, double minDistWgt,
+				double subFrac, double trTol,
 				WlzErrorNum *dstErr)
 {
   int		idS,
   		idM,
-		idV,
 		itr = 0,
-		conv = 0;
-  AlcKDTNode	*tNode;
+		conv = 0,
+		nQ,
+		nSub;
+  int		*qIdx,
+		*mIdx = NULL,
+		*subIdx = NULL,
+		*subVIdx = NULL;
+  size_t	*nnIdx = NULL;
   WlzAffineTransform *invTr = NULL,
 		*prvTr = NULL,
   		*curTr = NULL,
   		*newTr = NULL;
   WlzVertex	dV,
   		sV,
-		sN,
 		sTV,
-		sTN,
-  		tV,
-		tN;
+  		tV;
   double	wgt0,
 		wgt1,
 		wgt2,
@@ -1711,18 +2006,43 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
 		wVx,
 		prvMetric = 0.0,
 		curMetric = 0.0;
-  double	vxD[3];
+  double	*qry = NULL,
+  		*nnDist = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
  
-  curTr = (initTr == NULL)?
-  	  WlzMakeAffineTransform(WLZ_TRANSFORM_2D_AFFINE, &errNum):
-	  WlzAffineTransformCopy(initTr, &errNum);
+  curTr = (initTr != NULL)?
+	  WlzAffineTransformCopy(initTr, &errNum):
+	  WlzMakeAffineTransform((vType == WLZ_VERTEX_D2)?
+	  			 WLZ_TRANSFORM_2D_AFFINE:
+				 WLZ_TRANSFORM_3D_AFFINE, &errNum);
   curMetric = *gCurMetric;
   if(errNum == WLZ_ERR_NONE)
   {
     invTr = WlzAffineTransformInverse(curTr, &errNum);
   }
   if(errNum == WLZ_ERR_NONE)
+  {
+    if(((qry = (double *)AlcMalloc(sizeof(double) * 3 * nS)) == NULL) ||
+       ((nnIdx = (size_t *)AlcMalloc(sizeof(size_t) * nS)) == NULL) ||
+       ((nnDist = (double *)AlcMalloc(sizeof(double) * nS)) == NULL) ||
+       ((mIdx = (int *)AlcMalloc(sizeof(int) * nS)) == NULL))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  nSub = nS;
+  if((errNum == WLZ_ERR_NONE) && (subFrac < 1.0))
+  {
+    nSub = WLZ_MAX((int )(subFrac * nS), WLZ_REGICP_SUB_MIN);
+    nSub = WLZ_MIN(nSub, nS);
+    if((nSub < nS) &&
+       (((subIdx = (int *)AlcMalloc(sizeof(int) * nS)) == NULL) ||
+        ((subVIdx = (int *)AlcMalloc(sizeof(int) * nS)) == NULL)))
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
   {
     do
     {
@@ -1731,36 +2051,63 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
       wMaxDist = 0.0;
       prvMetric = curMetric;
       curMetric = 0.0;
-      /* Populate the buffers with source vertices, nearest neighbours
-       * in the target tree and scalar product of vertex normals. While
-       * doinf this also find maximum and minimum source - target vertex
-       * distances */
-      for(idS = 0; idS < nS; ++idS)
+      /* Draw a new random subsample of the source vertices. */
+      if(nSub < nS)
       {
-	idV = *(sIdx + idS);
+        (void )AlgShuffleIdx(nS, subIdx, itr);
+	for(idS = 0; idS < nSub; ++idS)
+	{
+	  *(subVIdx + idS) = *(sIdx + *(subIdx + idS));
+	}
+	nQ = nSub;
+	qIdx = subVIdx;
+      }
+      else
+      {
+        nQ = nS;
+	qIdx = sIdx;
+      }
+      /* Transform the source vertices and find all their nearest
+       * neighbours in the target tree using a single batched query. */
+#ifdef _OPENMP
+#pragma omp parallel for if(nQ >= WLZ_REGICP_PAR_MIN)
+#endif
+      for(idS = 0; idS < nQ; ++idS)
+      {
+	int	idV;
+
+	idV = *(qIdx + idS);
 	if(vType == WLZ_VERTEX_D2)
 	{
-	  sV.d2 = *(sVx.d2 + idV);
-	  sN.d2 = *(sNr.d2 + idV);
-	  sTV.d2 = WlzAffineTransformVertexD2(curTr, sV.d2, NULL);
-	  sTN.d2 = WlzAffineTransformNormalD2(curTr, sN.d2, NULL);
-	  *(sTVxBuf.d2 + idM) = sTV.d2;
-	  vxD[0] = sTV.d2.vtX;
-	  vxD[1] = sTV.d2.vtY;
+	  WlzDVertex2 sTV2;
+
+	  sTV2 = WlzAffineTransformVertexD2(curTr, *(sVx.d2 + idV), NULL);
+	  *(qry + (2 * idS)) = sTV2.vtX;
+	  *(qry + (2 * idS) + 1) = sTV2.vtY;
 	}
 	else /* vType == WLZ_VERTEX_D3 */
 	{
-	  sV.d3 = *(sVx.d3 + idV);
-	  sN.d3 = *(sNr.d3 + idV);
-	  sTV.d3 = WlzAffineTransformVertexD3(curTr, sV.d3, NULL);
-	  sTN.d3 = WlzAffineTransformNormalD3(curTr, sN.d3, NULL);
-	  *(sTVxBuf.d3 + idM) = sTV.d3;
-	  vxD[0] = sTV.d3.vtX;
-	  vxD[1] = sTV.d3.vtY;
-	  vxD[2] = sTV.d3.vtZ;
+	  WlzDVertex3 sTV3;
+
+	  sTV3 = WlzAffineTransformVertexD3(curTr, *(sVx.d3 + idV), NULL);
+	  *(qry + (3 * idS)) = sTV3.vtX;
+	  *(qry + (3 * idS) + 1) = sTV3.vtY;
+	  *(qry + (3 * idS) + 2) = sTV3.vtZ;
 	}
-	if((tNode = AlcKDTGetNN(tree, vxD, DBL_MAX, &dist, NULL)) != NULL)
+      }
+      if(AlcKDSGetKNN(tree, nQ, qry, 1, DBL_MAX,
+                      nnIdx, nnDist) != ALC_ER_NONE)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+	break;
+      }
+      /* Find the source vertices with a nearest neighbour, the maximum
+       * and minimum source - target vertex distances. */
+      for(idS = 0; idS < nQ; ++idS)
+      {
+	if(*(nnIdx + idS) != ALC_KDS_IDX_NONE)
 	{
+	  dist = *(nnDist + idS);
 	  if(wMinDist > dist)
 	  {
 	    wMinDist = dist;
@@ -1769,21 +2116,48 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
 	  {
 	    wMaxDist = dist;
 	  }
-	  if(vType == WLZ_VERTEX_D2)
-	  {
-	    tV.d2 = *(tVx.d2 + tNode->idx);
-	    tN.d2 = *(tNr.d2 + tNode->idx);
-	    *(tVxBuf.d2 + idM) = tV.d2;
-	    *(wgtBuf + idM) = WLZ_VTX_2_DOT(sTN.d2, tN.d2);
-	  }
-	  else /* vType == WLZ_VERTEX_D3 */
-	  {
-	    tV.d3 = *(tVx.d3 + tNode->idx);
-	    tN.d3 = *(tNr.d3 + tNode->idx);
-	    *(tVxBuf.d3 + idM) = tV.d3;
-	    *(wgtBuf + idM) = WLZ_VTX_3_DOT(sTN.d3, tN.d3);
-	  }
-	  ++idM;
+	  *(mIdx + idM++) = idS;
+	}
+      }
+      /* Populate the buffers with transformed source vertices, their
+       * nearest neighbours in the target tree and the scalar product
+       * of vertex normals. */
+#ifdef _OPENMP
+#pragma omp parallel for if(idM >= WLZ_REGICP_PAR_MIN)
+#endif
+      for(idS = 0; idS < idM; ++idS)
+      {
+	int	idQ,
+		idV;
+	size_t	tIdx;
+
+	idQ = *(mIdx + idS);
+	idV = *(qIdx + idQ);
+	tIdx = *(nnIdx + idQ);
+	if(vType == WLZ_VERTEX_D2)
+	{
+	  WlzDVertex2 sTV2,
+	  	      sTN2;
+
+	  sTV2.vtX = *(qry + (2 * idQ));
+	  sTV2.vtY = *(qry + (2 * idQ) + 1);
+	  sTN2 = WlzAffineTransformNormalD2(curTr, *(sNr.d2 + idV), NULL);
+	  *(sTVxBuf.d2 + idS) = sTV2;
+	  *(tVxBuf.d2 + idS) = *(tVx.d2 + tIdx);
+	  *(wgtBuf + idS) = WLZ_VTX_2_DOT(sTN2, *(tNr.d2 + tIdx));
+	}
+	else /* vType == WLZ_VERTEX_D3 */
+	{
+	  WlzDVertex3 sTV3,
+	  	      sTN3;
+
+	  sTV3.vtX = *(qry + (3 * idQ));
+	  sTV3.vtY = *(qry + (3 * idQ) + 1);
+	  sTV3.vtZ = *(qry + (3 * idQ) + 2);
+	  sTN3 = WlzAffineTransformNormalD3(curTr, *(sNr.d3 + idV), NULL);
+	  *(sTVxBuf.d3 + idS) = sTV3;
+	  *(tVxBuf.d3 + idS) = *(tVx.d3 + tIdx);
+	  *(wgtBuf + idS) = WLZ_VTX_3_DOT(sTN3, *(tNr.d3 + tIdx));
 	}
       }
       if(idM == 0)
@@ -1796,53 +2170,78 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
 	wgt0 = wMaxDist - wMinDist;
 	wgt1 = 1.0 - minDistWgt;
 	wgt2 = (wgt0 > DBL_EPSILON)? wgt1 / wgt0: 1.0;
-	for(idS = 0; idS < idM; ++idS)
+	if(usrWgtFn)
 	{
-	  if(vType == WLZ_VERTEX_D2)
-	  {
-	    sTV.d2 = *(sTVxBuf.d2 + idS);
-	    tV.d2 = *(tVxBuf.d2 + idS);
-	    WLZ_VTX_2_SUB(dV.d2, tV.d2, sTV.d2);
-	    dist = WLZ_VTX_2_LENGTH(dV.d2);
-	  }
-	  else /* vType == WLZ_VERTEX_D3 */
-	  {
-	    sTV.d3 = *(sTVxBuf.d3 + idS);
-	    tV.d3 = *(tVxBuf.d3 + idS);
-	    WLZ_VTX_3_SUB(dV.d3, tV.d3, sTV.d3);
-	    dist = WLZ_VTX_3_LENGTH(dV.d3);
-	  }
-	  if(wgt0 > DBL_EPSILON)
-	  {
-	    wVx = 1.0 - wgt2 * (dist - wMinDist);
-	  }
-	  else
-	  {
-	    wVx = 1.0;
-	  }
-	  wNr = *(wgtBuf + idS);
-	  if(sgnNrm && (wNr < 0.0))
-	  {
-	    wNr = 0.0;
-	  }
-	  if(usrWgtFn)
+	  /* User weight functions need not be thread safe. */
+	  for(idS = 0; idS < idM; ++idS)
 	  {
 	    if(vType == WLZ_VERTEX_D2)
 	    {
+	      sTV.d2 = *(sTVxBuf.d2 + idS);
+	      tV.d2 = *(tVxBuf.d2 + idS);
+	      WLZ_VTX_2_SUB(dV.d2, tV.d2, sTV.d2);
+	      dist = WLZ_VTX_2_LENGTH(dV.d2);
 	      sV.d2 = WlzAffineTransformVertexD2(invTr, sTV.d2, NULL);
 	    }
 	    else /* vType == WLZ_VERTEX_D3 */
 	    {
+	      sTV.d3 = *(sTVxBuf.d3 + idS);
+	      tV.d3 = *(tVxBuf.d3 + idS);
+	      WLZ_VTX_3_SUB(dV.d3, tV.d3, sTV.d3);
+	      dist = WLZ_VTX_3_LENGTH(dV.d3);
 	      sV.d3 = WlzAffineTransformVertexD3(invTr, sTV.d3, NULL);
 	    }
+	    wVx = (wgt0 > DBL_EPSILON)? 1.0 - wgt2 * (dist - wMinDist): 1.0;
+	    wNr = *(wgtBuf + idS);
+	    if(sgnNrm && (wNr < 0.0))
+	    {
+	      wNr = 0.0;
+	    }
 	    *(wgtBuf + idS) = (*usrWgtFn)(vType, curTr, tree, tVx, sVx,
-	    				  tV, sV, wVx, wNr, usrWgtData);
+					  tV, sV, wVx, wNr, usrWgtData);
+	    *(nnDist + idS) = dist;
 	  }
-	  else
+	}
+	else
+	{
+#ifdef _OPENMP
+#pragma omp parallel for if(idM >= WLZ_REGICP_PAR_MIN)
+#endif
+	  for(idS = 0; idS < idM; ++idS)
 	  {
-	    *(wgtBuf + idS) = wVx * wNr;
+	    double	d,
+	    		wN,
+			wV;
+
+	    if(vType == WLZ_VERTEX_D2)
+	    {
+	      WlzDVertex2 dV2;
+
+	      WLZ_VTX_2_SUB(dV2, *(tVxBuf.d2 + idS), *(sTVxBuf.d2 + idS));
+	      d = WLZ_VTX_2_LENGTH(dV2);
+	    }
+	    else /* vType == WLZ_VERTEX_D3 */
+	    {
+	      WlzDVertex3 dV3;
+
+	      WLZ_VTX_3_SUB(dV3, *(tVxBuf.d3 + idS), *(sTVxBuf.d3 + idS));
+	      d = WLZ_VTX_3_LENGTH(dV3);
+	    }
+	    wV = (wgt0 > DBL_EPSILON)? 1.0 - wgt2 * (d - wMinDist): 1.0;
+	    wN = *(wgtBuf + idS);
+	    if(sgnNrm && (wN < 0.0))
+	    {
+	      wN = 0.0;
+	    }
+	    *(wgtBuf + idS) = wV * wN;
+	    *(nnDist + idS) = d;
 	  }
-	  curMetric += dist * *(wgtBuf + idS);
+	}
+	/* Sum the metric in order so that it does not depend on the
+	 * number of threads. */
+	for(idS = 0; idS < idM; ++idS)
+	{
+	  curMetric += *(nnDist + idS) * *(wgtBuf + idS);
 	}
 	curMetric /= idM;
       }
@@ -1876,6 +2275,7 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
 	  }
 	  else if(errNum == WLZ_ERR_NONE)
 	  {
+	    conv = WlzRegICPTrUpdate(newTr, vType) < trTol;
 	    if(curTr == NULL)
 	    {
 	      curTr = newTr;
@@ -1894,6 +2294,13 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
 	  }
 	  (void )WlzFreeAffineTransform(newTr);
 	}
+	/* Move on to a larger subsample if converged using a subsample. */
+	if(conv && (nSub < nS))
+	{
+	  conv = 0;
+	  curMetric = DBL_MAX;
+	  nSub = WLZ_MIN(2 * nSub, nS);
+	}
       }
     } while((errNum == WLZ_ERR_NONE) && (itr++ < maxItr) && (conv == 0));
   }
@@ -1911,6 +2318,12 @@ static WlzAffineTransform *WlzRegICPTreeAndVerticesSimple(AlcKDTTree *tree,
     errNum = WLZ_ERR_NONE;
     conv = 0;
   }
+  AlcFree(qry);
+  AlcFree(mIdx);
+  AlcFree(subIdx);
+  AlcFree(subVIdx);
+  AlcFree(nnIdx);
+  AlcFree(nnDist);
   (void )WlzFreeAffineTransform(invTr);
   (void )WlzFreeAffineTransform(prvTr);
   *gPrvMetric = prvMetric;
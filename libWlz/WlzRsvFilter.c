@@ -44,15 +44,25 @@ static char _WlzRsvFilter_c[] = "University of Edinburgh $Id$";
 #include <float.h>
 #include <Wlz.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+* \def		WLZ_RSVFILTER_BLOCK_WIDTH
+* \ingroup	WlzValueFilters
+* \brief	Maximum number of adjacent columns filtered together
+*		through the lines of 2D objects.
+*/
+#define WLZ_RSVFILTER_BLOCK_WIDTH	(64)
+
 /* These tests are for debuging only. */
 /* #define WLZ_RSVFILTER_TEST_1D */
 /* #define WLZ_RSVFILTER_TEST_2D */
 /* #define WLZ_RSVFILTER_TEST_3D */
 
-static WlzObject *WlzRsvFilterObj2DX(WlzObject *, WlzRsvFilter *,
-				     WlzErrorNum *);
-static WlzObject *WlzRsvFilterObj2DY(WlzObject *, WlzRsvFilter *,
-				     WlzErrorNum *);
+static WlzObject *WlzRsvFilterObj2D(WlzObject *, WlzRsvFilter *,
+				    int, WlzErrorNum *);
 static WlzObject *WlzRsvFilterObj3DXY(WlzObject *, WlzRsvFilter *,
 			              int, WlzErrorNum *);
 static WlzObject *WlzRsvFilterObj3DZ(WlzObject *, WlzRsvFilter *,
@@ -60,9 +70,12 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *, WlzRsvFilter *,
 static void	WlzRsvFilterFilterBufXF(WlzRsvFilter *,
 				      double *, double *, double *,
 				      int);
-static void	WlzRsvFilterFilterBufYF(WlzRsvFilter *,
-				      double **, double **, WlzUByte **,
-				      WlzIVertex2, int, int);
+static void	WlzRsvFilterFilterBlkY(WlzRsvFilter *,
+				       double *, double *, WlzUByte *,
+				       size_t, int, int, WlzGreyType,
+				       double *);
+static void	WlzRsvFilterQuantise(double *, int, WlzGreyType,
+				     double *);
 static void	WlzRsvFilterFilterBufZF(WlzRsvFilter *ftr,
 				 	double ***wrkBuf,
 					double ***srcBuf,
@@ -240,9 +253,7 @@ WlzObject	*WlzRsvFilterObj(WlzObject *srcObj, WlzRsvFilter *ftr,
 			         int actionMsk, WlzErrorNum *dstErr)
 {
   WlzValues	tVal;
-  WlzObject	*xObj = NULL,
-		*yObj = NULL,
-		*xyObj = NULL,
+  WlzObject	*xyObj = NULL,
 		*zObj = NULL,
   		*dstObj = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
@@ -274,38 +285,7 @@ WlzObject	*WlzRsvFilterObj(WlzObject *srcObj, WlzRsvFilter *ftr,
 	if((actionMsk & (WLZ_RSVFILTER_ACTION_X |
 			 WLZ_RSVFILTER_ACTION_Y)) != 0)
 	{
-	  /* Filter in each required direction. */
-	  if((actionMsk & WLZ_RSVFILTER_ACTION_X) != 0)
-	  {
-	    xObj = WlzRsvFilterObj2DX(srcObj, ftr, &errNum);
-	  }
-	  if((errNum == WLZ_ERR_NONE) &&
-	     ((actionMsk & WLZ_RSVFILTER_ACTION_Y) != 0))
-	  {
-	    yObj = WlzRsvFilterObj2DY((xObj)? xObj: srcObj,
-	    		              ftr, &errNum);
-	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    if(yObj)
-	    {
-	      dstObj = yObj;
-	      yObj = NULL;
-	    }
-	    else if(xObj)
-	    {
-	      dstObj = xObj;
-	      xObj = NULL;
-	    }
-	  }
-	  if(xObj)
-	  {
-	    WlzFreeObj(xObj);
-	  }
-	  if(yObj)
-	  {
-	    WlzFreeObj(yObj);
-	  }
+	  dstObj = WlzRsvFilterObj2D(srcObj, ftr, actionMsk, &errNum);
 	}
 	else
 	{
@@ -518,24 +498,26 @@ WlzErrorNum	WlzRsvFilterBuffer(WlzRsvFilter *ftr, double *datBuf,
 * \param	bufPos			Position within the buffer.
 * \param	itvLen			Interval length.
 * \param	goingUp			Non-zero if going up through
-*                                       the lines (ie raster direction
-*                                       is WLZ_RASTERDIR_DLIC).
+*                                       the planes.
 */
-static void	WlzRsvFilterFilterBufYF(WlzRsvFilter *ftr,
-				      double **wrkBuf, double **srcBuf,
-				      WlzUByte **itvBuf,
-				      WlzIVertex2 bufPos, int itvLen,
-				      int goingUp)
+static void	WlzRsvFilterFilterBufZF(WlzRsvFilter *ftr,
+				 	double ***wrkBuf,
+					double ***srcBuf,
+					WlzUByte ***itvBuf,
+					WlzIVertex3 bufPos,
+					int itvLen,
+					int goingUp)
 {
   int		cnt0,
 		cnt1,
 		kol,
+		lin,
 		iBM,
 		iBO,
 		iBS,
-  		idL0,
-		idL1,
-		idL2;
+  		idP0,
+		idP1,
+		idP2;
   double	a0,
   		a1,
 		a2,
@@ -562,17 +544,17 @@ static void	WlzRsvFilterFilterBufYF(WlzRsvFilter *ftr,
 
   if(goingUp)
   {
-    idL0 = (bufPos.vtY + 3 + 0) % 3;
-    idL1 = (bufPos.vtY + 3 + 1) % 3;
-    idL2 = (bufPos.vtY + 3 + 2) % 3;
+    idP0 = (bufPos.vtZ + 3 + 0) % 3;
+    idP1 = (bufPos.vtZ + 3 + 1) % 3;
+    idP2 = (bufPos.vtZ + 3 + 2) % 3;
     a2 = ftr->a[2];
     a3 = ftr->a[3];
   }
   else
   {
-    idL0 = (bufPos.vtY + 3 - 0) % 3;
-    idL1 = (bufPos.vtY + 3 - 1) % 3;
-    idL2 = (bufPos.vtY + 3 - 2) % 3;
+    idP0 = (bufPos.vtZ + 3 - 0) % 3;
+    idP1 = (bufPos.vtZ + 3 - 1) % 3;
+    idP2 = (bufPos.vtZ + 3 - 2) % 3;
     a0 = ftr->a[0];
     a1 = ftr->a[1];
   }
@@ -580,14 +562,15 @@ static void	WlzRsvFilterFilterBufYF(WlzRsvFilter *ftr,
   b1 = ftr->b[1];
   c = ftr->c;
   kol = bufPos.vtX;
-  iP1 = *(itvBuf + idL1);
-  iP2 = *(itvBuf + idL2);
-  dP0 = *(srcBuf + idL0) + kol;
-  fP0 = *(wrkBuf + idL0) + kol;
-  dP1 = *(srcBuf + idL1) + kol;
-  fP1 = *(wrkBuf + idL1) + kol;
-  dP2 = *(srcBuf + idL2) + kol;
-  fP2 = *(wrkBuf + idL2) + kol;
+  lin = bufPos.vtY;
+  iP1 = *(*(itvBuf + idP1) + lin);
+  iP2 = *(*(itvBuf + idP2) + lin);
+  dP0 = *(*(srcBuf + idP0) + lin) + kol;
+  fP0 = *(*(wrkBuf + idP0) + lin) + kol;
+  dP1 = *(*(srcBuf + idP1) + lin) + kol;
+  fP1 = *(*(wrkBuf + idP1) + lin) + kol;
+  dP2 = *(*(srcBuf + idP2) + lin) + kol;
+  fP2 = *(*(wrkBuf + idP2) + lin) + kol;
   cnt0 = itvLen;
   if(goingUp)
   {
@@ -603,6 +586,7 @@ static void	WlzRsvFilterFilterBufYF(WlzRsvFilter *ftr,
 	while(cnt1-- > 0)
 	{
 	  f0 = *fP0;
+	  ++dP0;
 	  *fP0 = (a2 * *dP1++) + (a3 * *dP2++) - (b0 * *fP1++) - (b1 * *fP2);
 	  *fP2++ = c * (f0 + *fP0++);
 	}
@@ -618,15 +602,15 @@ static void	WlzRsvFilterFilterBufYF(WlzRsvFilter *ftr,
 	{
 	  d1 = d0;
 	  d2 = d0;
-	  f1 = ((a2 * a3) * d0) / (b0 + b1 + 1);
-	  f2 = ((a2 * a3) * d2) / (b0 + b1 + 1);
+	  f1 = ((a2 + a3) * d0) / (b0 + b1 + 1);
+	  f2 = ((a2 + a3) * d2) / (b0 + b1 + 1);
 	}
 	else
 	{
-	  d1 = *dP1;
-	  d2 = *dP2;
 	  f1 = *fP1;
 	  f2 = *fP2;
+	  d1 = *dP1;
+	  d2 = *dP2;
 	}
 	++dP0;
 	++dP1;
@@ -689,38 +673,69 @@ static void	WlzRsvFilterFilterBufYF(WlzRsvFilter *ftr,
 /*!
 * \return	void
 * \ingroup	WlzValueFilters
-* \brief	Filters a single interval using a vertical IIR filter
-*               defined by the filter coefficients and double precision
-*               arithmetic.
-* \note         See the double precision horizontal function for
-*               simple code.
+* \brief	Rounds and clamps the given buffer of double values to
+*		the given grey type, ie to the values that would be read
+*		back after clamping them into values of the grey type.
+* \param	buf			Buffer of values.
+* \param	n			Number of values in the buffer.
+* \param	gType			Grey type.
+* \param	tmp			Temporary buffer with space for at
+*					least n double values.
+*/
+static void	WlzRsvFilterQuantise(double *buf, int n, WlzGreyType gType,
+				     double *tmp)
+{
+  WlzGreyP	bufGP,
+  		tmpGP;
+
+  if(gType != WLZ_GREY_DOUBLE)
+  {
+    bufGP.dbp = buf;
+    tmpGP.dbp = tmp;
+    WlzValueClampGreyIntoGrey(tmpGP, 0, gType, bufGP, 0, WLZ_GREY_DOUBLE, n);
+    WlzValueCopyGreyToGrey(bufGP, 0, WLZ_GREY_DOUBLE, tmpGP, 0, gType, n);
+  }
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValueFilters
+* \brief	Filters a block of adjacent columns through the lines of
+*		dense buffers using an IIR filter defined by the filter
+*		coefficients and double precision arithmetic. The values
+*		in each line of the block are contiguous, so the filter
+*		is applied to all the columns of the block at once.
+*		The causal (down) pass values are rounded to the
+*		destination grey type before they are combined with the
+*		anti-causal (up) pass values, as if they had been stored
+*		in the destination object.
+*		Filtering restarts wherever either of the two previous
+*		values along a column are outside of the domain.
 * \param	ftr			The filter.
-* \param	wrkBuf			Working buffer.
-* \param	srcBuf			Source buffer.
-* \param	itvBuf			Within interval bit buffer.
-* \param	bufPos			Position within the buffer.
-* \param	itvLen			Interval length.
-* \param	goingUp			Non-zero if going up through
-*                                       the planes.
+* \param	dat			Data buffer, the first value of the
+*					block.
+* \param	wrk			Working buffer for the filtered
+*					values, with the same layout as the
+*					data buffer.
+* \param	msk			Domain mask buffer, with the same
+*					layout as the data buffer and with
+*					non-zero values within the domain.
+* \param	stp			Step between the lines of the
+*					buffers.
+* \param	nLn			Number of lines.
+* \param	bW			Number of columns in the block.
+* \param	gType			Destination grey type.
+* \param	tmp			Temporary buffer for at least 4bW
+*					values.
 */
-static void	WlzRsvFilterFilterBufZF(WlzRsvFilter *ftr,
-				 	double ***wrkBuf,
-					double ***srcBuf,
-					WlzUByte ***itvBuf,
-					WlzIVertex3 bufPos,
-					int itvLen,
-					int goingUp)
+static void	WlzRsvFilterFilterBlkY(WlzRsvFilter *ftr,
+				       double *dat, double *wrk,
+				       WlzUByte *msk, size_t stp,
+				       int nLn, int bW, WlzGreyType gType,
+				       double *tmp)
 {
-  int		cnt0,
-		cnt1,
-		kol,
-		lin,
-		iBM,
-		iBO,
-		iBS,
-  		idP0,
-		idP1,
-		idP2;
+  int		idX,
+  		idY;
   double	a0,
   		a1,
 		a2,
@@ -729,171 +744,161 @@ static void	WlzRsvFilterFilterBufZF(WlzRsvFilter *ftr,
 		b1,
 		c,
 		d0,
-		d1,
-		d2,
 		f0,
 		f1,
-		f2;
-  WlzUByte	*iBP1,
-  		*iBP2,
-  		*iP1,
-  		*iP2;
+		fb;
   double	*dP0,
   		*dP1,
 		*dP2,
 		*fP0,
 		*fP1,
-		*fP2;
+		*fP2,
+		*qBuf;
+  WlzUByte	*mP1,
+		*mP2;
 
-  if(goingUp)
-  {
-    idP0 = (bufPos.vtZ + 3 + 0) % 3;
-    idP1 = (bufPos.vtZ + 3 + 1) % 3;
-    idP2 = (bufPos.vtZ + 3 + 2) % 3;
-    a2 = ftr->a[2];
-    a3 = ftr->a[3];
-  }
-  else
-  {
-    idP0 = (bufPos.vtZ + 3 - 0) % 3;
-    idP1 = (bufPos.vtZ + 3 - 1) % 3;
-    idP2 = (bufPos.vtZ + 3 - 2) % 3;
-    a0 = ftr->a[0];
-    a1 = ftr->a[1];
-  }
+  a0 = ftr->a[0];
+  a1 = ftr->a[1];
+  a2 = ftr->a[2];
+  a3 = ftr->a[3];
   b0 = ftr->b[0];
   b1 = ftr->b[1];
   c = ftr->c;
-  kol = bufPos.vtX;
-  lin = bufPos.vtY;
-  iP1 = *(*(itvBuf + idP1) + lin);
-  iP2 = *(*(itvBuf + idP2) + lin);
-  dP0 = *(*(srcBuf + idP0) + lin) + kol;
-  fP0 = *(*(wrkBuf + idP0) + lin) + kol;
-  dP1 = *(*(srcBuf + idP1) + lin) + kol;
-  fP1 = *(*(wrkBuf + idP1) + lin) + kol;
-  dP2 = *(*(srcBuf + idP2) + lin) + kol;
-  fP2 = *(*(wrkBuf + idP2) + lin) + kol;
-  cnt0 = itvLen;
-  if(goingUp)
-  {
-    while(cnt0 > 0)
+  fb = b0 + b1 + 1;
+  qBuf = tmp + (3 * bW);
+  /* Causal pass down through the lines. */
+  for(idY = 0; idY < nLn; ++idY)
+  {
+    dP0 = dat + (idY * stp);
+    fP0 = wrk + (idY * stp);
+    if(idY < 2)
     {
-      iBO = kol >> 3;
-      iBS = kol & 7;
-      iBP1 = iP1 + iBO;
-      iBP2 = iP2 + iBO;
-      if((iBS == 0) && ((*iBP1 & *iBP2) == 0xff) && (cnt0 >= 8))
+      for(idX = 0; idX < bW; ++idX)
       {
-	cnt1 = 8;
-	while(cnt1-- > 0)
-	{
-	  f0 = *fP0;
-	  *fP0 = (a2 * *dP1++) + (a3 * *dP2++) - (b0 * *fP1++) - (b1 * *fP2);
-	  *fP2++ = c * (f0 + *fP0++);
-	}
-	kol += 8;
-	cnt0 -= 8;
+	d0 = dP0[idX];
+	f1 = ((a0 + a1) * d0) / fb;
+	fP0[idX] = (a0 * d0) + (a1 * d0) - (b0 * f1) - (b1 * f1);
       }
-      else
+    }
+    else
+    {
+      dP1 = dP0 - stp;
+      fP1 = fP0 - stp;
+      fP2 = fP1 - stp;
+      mP1 = msk + ((idY - 1) * stp);
+      mP2 = mP1 - stp;
+      for(idX = 0; idX < bW; ++idX)
       {
-	d0 = *dP0;
-	f0 = *fP0;
-	iBM = 1 << iBS;
-	if(((*iBP1 & iBM) == 0) || ((*iBP2 & iBM) == 0))
+	d0 = dP0[idX];
+	if(mP1[idX] && mP2[idX])
 	{
-	  d1 = d0;
-	  d2 = d0;
-	  f1 = ((a2 * a3) * d0) / (b0 + b1 + 1);
-	  f2 = ((a2 * a3) * d2) / (b0 + b1 + 1);
+	  fP0[idX] = (a0 * d0) + (a1 * dP1[idX]) -
+		     (b0 * fP1[idX]) - (b1 * fP2[idX]);
 	}
 	else
 	{
-	  f1 = *fP1;
-	  f2 = *fP2;
-	  d1 = *dP1;
-	  d2 = *dP2;
+	  f1 = ((a0 + a1) * d0) / fb;
+	  fP0[idX] = (a0 * d0) + (a1 * d0) - (b0 * f1) - (b1 * f1);
 	}
-	++dP0;
-	++dP1;
-	++dP2;
-	++fP1;
-	*fP0 = (a2 * d1) + (a3 * d2) - (b0 * f1) - (b1 * f2);
-	*fP2++ = c * (f0 + *fP0++);
-	--cnt0;
-	++kol; 
       }
+      /* The line two back is no longer needed unrounded. */
+      WlzRsvFilterQuantise(fP2, bW, gType, qBuf);
     }
   }
-  else
+  for(idY = WLZ_MAX(nLn - 2, 0); idY < nLn; ++idY)
   {
-    while(cnt0 > 0)
+    WlzRsvFilterQuantise(wrk + (idY * stp), bW, gType, qBuf);
+  }
+  /* Anti-causal pass up through the lines, with the anti-causal values
+   * kept in a ring buffer of three lines. */
+  for(idY = nLn - 1; idY >= 0; --idY)
+  {
+    dP0 = dat + (idY * stp);
+    fP0 = tmp + ((idY % 3) * bW);
+    if(idY >= nLn - 2)
     {
-      iBO = kol >> 3;
-      iBS = kol & 7;
-      iBP1 = iP1 + iBO;
-      iBP2 = iP2 + iBO; 
-      if((iBS == 0) && ((*iBP1 & *iBP2) == 0xff) && (cnt0 >= 8))
+      for(idX = 0; idX < bW; ++idX)
       {
-        cnt1 = 8;
-	while(cnt1-- > 0)
-	{
-	  *fP0++ = (a0 * *dP0++) + (a1 * *dP1++) -
-	  	   (b0 * *fP1++) - (b1 * *fP2++);
-	}
-	kol += 8;
-	cnt0 -= 8;
+	d0 = dP0[idX];
+	f1 = ((a2 + a3) * d0) / fb;
+	fP0[idX] = (a2 * d0) + (a3 * d0) - (b0 * f1) - (b1 * f1);
       }
-      else
+    }
+    else
+    {
+      dP1 = dP0 + stp;
+      dP2 = dP1 + stp;
+      fP1 = tmp + (((idY + 1) % 3) * bW);
+      fP2 = tmp + (((idY + 2) % 3) * bW);
+      mP1 = msk + ((idY + 1) * stp);
+      mP2 = mP1 + stp;
+      for(idX = 0; idX < bW; ++idX)
       {
-	d0 = *dP0;
-	iBM = 1 << iBS;
-	if(((*iBP1 & iBM) == 0) || ((*iBP2 & iBM) == 0))
+	d0 = dP0[idX];
+	if(mP1[idX] && mP2[idX])
 	{
-	  d1 = d0;
-	  f1 = ((a0 + a1) * d0) / (b0 + b1 + 1);
-	  f2 = ((a0 + a1) * d0) / (b0 + b1 + 1);
+	  fP0[idX] = (a2 * dP1[idX]) + (a3 * dP2[idX]) -
+		     (b0 * fP1[idX]) - (b1 * fP2[idX]);
 	}
 	else
 	{
-	  d1 = *dP1;
-	  f1 = *fP1;
-	  f2 = *fP2;
+	  f1 = ((a2 + a3) * d0) / fb;
+	  fP0[idX] = (a2 * d0) + (a3 * d0) - (b0 * f1) - (b1 * f1);
 	}
-	++dP0;
-	++dP1;
-	++fP1;
-	++fP2;
-	*fP0++ = (a0 * d0) + (a1 * d1) - (b0 * f1) - (b1 * f2);
-	--cnt0;
-	++kol;
       }
     }
+    fP1 = wrk + (idY * stp);
+    for(idX = 0; idX < bW; ++idX)
+    {
+      f0 = fP1[idX];
+      fP1[idX] = c * (f0 + fP0[idX]);
+    }
   }
 }
 
 /*!
 * \return	The filtered object, or NULL on error.
 * \ingroup	WlzValueFilters
-* \brief	Applies a recursive filter along the lines of the given
-*               2D domain object with grey values using either double
-*               precision floating point arithmetic or fixed
-*               point arithmetic.
+* \brief	Applies a recursive filter along the lines and/or through
+*		the columns of the given 2D domain object with grey values
+*		using double precision floating point arithmetic.
+*		The object's values are read into a dense buffer which
+*		covers the object's bounding box. The intervals are then
+*		filtered in parallel along the lines, after which blocks
+*		of adjacent columns are filtered in parallel through the
+*		lines. The filtered values are the same as those which
+*		would be given by filtering along the lines into an
+*		object with the destination grey type and then filtering
+*		that through the columns.
 *               It is assumed that the object type has already been
 *               checked, the domain and values are non-null.
 * \param	srcObj			Given 2D domain object.
 * \param	ftr			Recursive filter.
+* \param	actionMsk		Action mask.
 * \param	dstErr			Destination error pointer, may
 *                                       be null.
 */
-static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
-				     WlzErrorNum *dstErr)
+static WlzObject *WlzRsvFilterObj2D(WlzObject *srcObj, WlzRsvFilter *ftr,
+				    int actionMsk, WlzErrorNum *dstErr)
 {
-  int		bufSz,
-		bufSpace,
-		itvLen;
-  WlzGreyType	bufType,
-  		srcGType,
+  int		idI,
+		bW = WLZ_RSVFILTER_BLOCK_WIDTH,
+  		nBlk = 0,
+  		nItv = 0,
+		maxItv = 0,
+		nThr = 1,
+  		xFlg,
+		yFlg;
+  size_t	idx,
+  		bufSz = 0;
+  int		*itv = NULL;
+  double	*datBuf = NULL,
+  		*wrkBuf = NULL,
+		*thrBuf = NULL;
+  WlzUByte	*mskBuf = NULL;
+  WlzIVertex2	bufOrg,
+  		bufSz2;
+  WlzGreyType	srcGType,
   		dstGType;
   WlzObjectType	vType;
   WlzGreyP	bufGP;
@@ -901,15 +906,14 @@ static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
   WlzDomain	srcDom;
   WlzValues	dstVal;
   WlzObject	*dstObj = NULL;
-  void		*lnBuf0 = NULL,
-  		*lnBuf1 = NULL,
-  		*datBuf = NULL;
-  WlzIntervalWSpace srcIWSp,
-  		dstIWSp;
-  WlzGreyWSpace srcGWSp,
-  		dstGWSp;
+  WlzIntervalWSpace iWSp;
+  WlzGreyWSpace gWSp;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
+  bufOrg.vtX = bufOrg.vtY = 0;
+  bufSz2.vtX = bufSz2.vtY = 0;
+  xFlg = (actionMsk & WLZ_RSVFILTER_ACTION_X) != 0;
+  yFlg = (actionMsk & WLZ_RSVFILTER_ACTION_Y) != 0;
   /* Gather information about the source object. */
   if(((srcDom = srcObj->domain).core->type != WLZ_INTERVALDOMAIN_INTVL) &&
      (srcDom.core->type != WLZ_INTERVALDOMAIN_RECT))
@@ -963,289 +967,160 @@ static WlzObject *WlzRsvFilterObj2DX(WlzObject *srcObj, WlzRsvFilter *ftr,
     dstObj= WlzMakeMain(srcObj->type, srcDom, dstVal, srcObj->plist,
 			NULL, &errNum);
   }
-  /* Make the working buffers. */
+  /* Make the buffers. */
   if(errNum == WLZ_ERR_NONE)
   {
-    bufSz = srcDom.i->lastkl - srcDom.i->kol1 + 1;
-    bufSpace = sizeof(double) * bufSz;
-    if(((datBuf = AlcMalloc(bufSpace)) == NULL) ||
-       ((lnBuf0 = AlcMalloc(bufSpace)) == NULL) ||
-       ((lnBuf1 = AlcMalloc(bufSpace)) ==  NULL))
+#ifdef _OPENMP
+    nThr = omp_get_max_threads();
+#endif
+    bufOrg.vtX = srcDom.i->kol1;
+    bufOrg.vtY = srcDom.i->line1;
+    bufSz2.vtX = srcDom.i->lastkl - srcDom.i->kol1 + 1;
+    bufSz2.vtY = srcDom.i->lastln - srcDom.i->line1 + 1;
+    bufSz = (size_t )(bufSz2.vtX) * bufSz2.vtY;
+    /* Use narrower blocks of columns if there would be too few blocks
+     * to keep the threads busy. */
+    idI = (((bufSz2.vtX + nThr - 1) / nThr) + 7) & ~7;
+    bW = WLZ_MAX(8, WLZ_MIN(bW, idI));
+    nBlk = (bufSz2.vtX + bW - 1) / bW;
+    if(((datBuf = (double *)AlcMalloc(sizeof(double) * bufSz)) == NULL) ||
+       ((thrBuf = (double *)AlcMalloc(sizeof(double) * nThr *
+				      WLZ_MAX(3 * bufSz2.vtX,
+				              4 * bW))) == NULL) ||
+       (yFlg &&
+        (((wrkBuf = (double *)AlcMalloc(sizeof(double) * bufSz)) == NULL) ||
+	 ((mskBuf = (WlzUByte *)AlcMalloc(sizeof(WlzUByte) *
+	 				  bufSz)) == NULL))))
     {
       errNum = WLZ_ERR_MEM_ALLOC;
     }
   }
-  /* Work down through the object from the first line to last. */
+  /* Read the object's values into the data buffer, recording the
+   * intervals and the domain mask. */
+  if(errNum == WLZ_ERR_NONE)
+  {
+    for(idx = 0; idx < bufSz; ++idx)
+    {
+      datBuf[idx] = 0.0;
+    }
+    if(yFlg)
+    {
+      WlzValueSetUByte(mskBuf, 0, bufSz);
+    }
+    errNum = WlzInitGreyScan(srcObj, &iWSp, &gWSp);
+  }
   if(errNum == WLZ_ERR_NONE)
   {
-    bufType = WLZ_GREY_DOUBLE;
-    bufGP.dbp = (double *)datBuf;
-    if(((errNum = WlzInitGreyRasterScan(srcObj, &srcIWSp, &srcGWSp,
-    					WLZ_RASTERDIR_ILIC,
-					0)) == WLZ_ERR_NONE) &&
-       ((errNum = WlzInitGreyRasterScan(dstObj, &dstIWSp, &dstGWSp,
-       					WLZ_RASTERDIR_ILIC,
-					0)) == WLZ_ERR_NONE))
+    while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
     {
-      while((errNum == WLZ_ERR_NONE) &&
-            ((errNum = WlzNextGreyInterval(&srcIWSp)) == WLZ_ERR_NONE) &&
-	    ((errNum = WlzNextGreyInterval(&dstIWSp)) == WLZ_ERR_NONE))
+      idx = ((size_t )(iWSp.linpos - bufOrg.vtY) * bufSz2.vtX) +
+            iWSp.lftpos - bufOrg.vtX;
+      bufGP.dbp = datBuf + idx;
+      WlzValueCopyGreyToGrey(bufGP, 0, WLZ_GREY_DOUBLE,
+			     gWSp.u_grintptr, 0, gWSp.pixeltype,
+			     iWSp.colrmn);
+      if(yFlg)
       {
-	/* Copy interval to working buffer. */
-	itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
-	WlzValueCopyGreyToGrey(bufGP, 0, bufType,
-			       srcGWSp.u_grintptr, 0, srcGWSp.pixeltype,
-			       itvLen);
-	/* Apply filter. */
-	WlzRsvFilterFilterBufXF(ftr, (double *)datBuf,
-			        (double *)lnBuf0, (double *)lnBuf1,
-				itvLen);
-	/* Clamp data from buffer into the dst interval. */
-	WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-			          bufGP, 0, bufType, itvLen);
+        WlzValueSetUByte(mskBuf + idx, 1, iWSp.colrmn);
+      }
+      if(xFlg)
+      {
+	if(nItv >= maxItv)
+	{
+	  maxItv = (2 * maxItv) + 1024;
+	  if((itv = (int *)AlcRealloc(itv, sizeof(int) * 3 *
+	  				   maxItv)) == NULL)
+	  {
+	    errNum = WLZ_ERR_MEM_ALLOC;
+	    break;
+	  }
+	}
+	itv[3 * nItv] = iWSp.linpos - bufOrg.vtY;
+	itv[(3 * nItv) + 1] = iWSp.lftpos - bufOrg.vtX;
+	itv[(3 * nItv) + 2] = iWSp.colrmn;
+	++nItv;
       }
     }
     if(errNum == WLZ_ERR_EOO)
     {
       errNum = WLZ_ERR_NONE;
     }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
   }
-  /* Free buffers. */
-  if(datBuf)
+  /* Filter the intervals along the lines. */
+  if((errNum == WLZ_ERR_NONE) && xFlg)
   {
-    AlcFree(datBuf);
-  }
-  if(lnBuf0)
-  {
-    AlcFree(lnBuf0);
-  }
-  if(lnBuf1)
-  {
-    AlcFree(lnBuf1);
-  }
-  if(errNum != WLZ_ERR_NONE)
-  {
-    if(dstObj)
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(dynamic, 16)
+#endif
+    for(idI = 0; idI < nItv; ++idI)
     {
-      (void )WlzFreeObj(dstObj);
-    }
-    dstObj = NULL;
-  }
-  if(dstErr)
-  {
-    *dstErr = errNum;
-  }
-  return(dstObj);
-}
+      int	thrId = 0;
+      double	*dP,
+      		*tP;
 
-/*!
-* \return	The filtered object, or NULL on error.
-* \ingroup	WlzValueFilters
-* \brief	Applies a recursive filter through the rows and columns
-*               of the given 2D domain object with grey values using
-*               either double precision floating point arithmetic or
-*               fixed point arithmetic.
-*               It is assumed that the object type has already been
-*               checked, the domain and values are non-null.
-* \param	srcObj			Given 2D domain object.
-* \param	ftr			Recursive filter.
-* \param	dstErr			Destination error pointer, may
-*                                       be null.
-*/
-static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
-			             WlzErrorNum *dstErr)
-{
-  int		idD,
-  		idN,
-		bufLnIdx,
-		dstLnIdx,
-  		itvLen,
-		itvBufWidth;
-  WlzRasterDir	rasDir;
-  WlzGreyType	bufType,
-  		srcGType,
-		dstGType;
-  WlzIVertex2	bufPos,
-  		bufSz;
-  WlzGreyP	dstBufGP,
-  		srcBufGP,
-  		wrkBufGP;
-  WlzObjectType	vType;
-  WlzPixelV	bgdPix;
-  WlzDomain	srcDom;
-  WlzValues	dstVal;
-  WlzObject	*dstObj = NULL;
-  void		**srcBuf = NULL,
-  		**wrkBuf = NULL;
-  WlzUByte	**itvBuf = NULL;
-  WlzIntervalWSpace srcIWSp,
-  		dstIWSp;
-  WlzGreyWSpace srcGWSp,
-  		dstGWSp;
-  WlzErrorNum	errNum = WLZ_ERR_NONE;
-
-  /* Gather information about the source object. */
-  if(((srcDom = srcObj->domain).core->type != WLZ_INTERVALDOMAIN_INTVL) &&
-     (srcDom.core->type != WLZ_INTERVALDOMAIN_RECT))
-  {
-    errNum = WLZ_ERR_DOMAIN_TYPE;
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    srcGType = WlzGreyTableTypeToGreyType(srcObj->values.core->type, &errNum);
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      tP = thrBuf + ((size_t )thrId * 3 * bufSz2.vtX);
+      dP = datBuf + ((size_t )(itv[3 * idI]) * bufSz2.vtX) +
+           itv[(3 * idI) + 1];
+      WlzRsvFilterFilterBufXF(ftr, dP, tP, tP + bufSz2.vtX,
+      			      itv[(3 * idI) + 2]);
+      if(yFlg)
+      {
+        WlzRsvFilterQuantise(dP, itv[(3 * idI) + 2], dstGType, tP);
+      }
+    }
   }
-  if(errNum == WLZ_ERR_NONE)
+  /* Filter blocks of columns through the lines. */
+  if((errNum == WLZ_ERR_NONE) && yFlg)
   {
-    switch(srcGType)
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nThr) schedule(dynamic)
+#endif
+    for(idI = 0; idI < nBlk; ++idI)
     {
-      /* Promote grey type for destination object. */
-      case WLZ_GREY_UBYTE: /* FALLTHROUGH */
-      case WLZ_GREY_SHORT:
-        dstGType = WLZ_GREY_SHORT;
-	break;
-      case WLZ_GREY_INT:
-	dstGType = WLZ_GREY_INT;
-        break;
-      case WLZ_GREY_FLOAT:
-        dstGType = WLZ_GREY_FLOAT;
-	break;
-      case WLZ_GREY_DOUBLE:
-        dstGType = WLZ_GREY_DOUBLE;
-	break;
-      case WLZ_GREY_RGBA: /* RGBA to be done RAB */
-      default:
-        errNum = WLZ_ERR_GREY_TYPE;
-	break;
+      int	thrId = 0;
+      size_t	off;
+
+#ifdef _OPENMP
+      thrId = omp_get_thread_num();
+#endif
+      off = (size_t )idI * bW;
+      WlzRsvFilterFilterBlkY(ftr, datBuf + off, wrkBuf + off, mskBuf + off,
+      			     bufSz2.vtX, bufSz2.vtY,
+			     WLZ_MIN(bW, bufSz2.vtX - (idI * bW)), dstGType,
+			     thrBuf + ((size_t )thrId *
+			               WLZ_MAX(3 * bufSz2.vtX, 4 * bW)));
     }
   }
+  /* Clamp the filtered values into the destination object. */
   if(errNum == WLZ_ERR_NONE)
   {
-    vType = WlzGreyTableTypeToTableType(srcObj->values.core->type, &errNum);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    bgdPix = WlzGetBackground(srcObj, &errNum);
-  }
-  /* Make destination object with it's own values but a shared domain. */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    dstVal.v = WlzNewValueTb(srcObj, WlzGreyTableType(vType, dstGType, NULL),
-    			     bgdPix, &errNum);
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    dstObj= WlzMakeMain(srcObj->type, srcDom, dstVal, srcObj->plist,
-			NULL, &errNum);
+    errNum = WlzInitGreyScan(dstObj, &iWSp, &gWSp);
   }
-  /* Make the buffers. */
   if(errNum == WLZ_ERR_NONE)
   {
-    bufSz.vtX = srcDom.i->lastkl - srcDom.i->kol1 + 1;
-    bufSz.vtY = 3;
-    if(AlcBit2Malloc(&itvBuf, bufSz.vtY, bufSz.vtX) != ALC_ER_NONE)
+    while((errNum = WlzNextGreyInterval(&iWSp)) == WLZ_ERR_NONE)
     {
-      errNum = WLZ_ERR_MEM_ALLOC;
+      idx = ((size_t )(iWSp.linpos - bufOrg.vtY) * bufSz2.vtX) +
+            iWSp.lftpos - bufOrg.vtX;
+      bufGP.dbp = ((yFlg)? wrkBuf: datBuf) + idx;
+      WlzValueClampGreyIntoGrey(gWSp.u_grintptr, 0, gWSp.pixeltype,
+			        bufGP, 0, WLZ_GREY_DOUBLE, iWSp.colrmn);
     }
-  }
-  if(errNum == WLZ_ERR_NONE)
-  {
-    bufType = WLZ_GREY_DOUBLE;
-    if((AlcDouble2Malloc((double ***)&srcBuf,
-			 bufSz.vtY, bufSz.vtX) != ALC_ER_NONE) ||
-       (AlcDouble2Malloc((double ***)&wrkBuf,
-			 bufSz.vtY, bufSz.vtX) != ALC_ER_NONE))
-    {
-      errNum = WLZ_ERR_MEM_ALLOC;
-    }
-  }
-  /* Work down and then back up through the object. */
-  if(errNum == WLZ_ERR_NONE)
-  {
-    idD = 0;
-    bufLnIdx = 0;
-    dstLnIdx = 0;
-    itvBufWidth = (bufSz.vtX + 7) / 8;
-    while((errNum == WLZ_ERR_NONE) && (idD < 2))
+    if(errNum == WLZ_ERR_EOO)
     {
-      /* Initialise buffers. */
-      for(idN = 0; idN < 3; ++idN)
-      {
-	WlzValueSetUByte(*(itvBuf + idN), 0, itvBufWidth);
-      }
-      rasDir = (idD == 0)? WLZ_RASTERDIR_ILIC: WLZ_RASTERDIR_DLIC;
-      if(((errNum = WlzInitGreyRasterScan(srcObj, &srcIWSp, &srcGWSp, rasDir,
-					  0)) == WLZ_ERR_NONE) &&
-	 ((errNum = WlzInitGreyRasterScan(dstObj, &dstIWSp, &dstGWSp, rasDir,
-					  0)) == WLZ_ERR_NONE))
-      {
-	while((errNum == WLZ_ERR_NONE) &&
-	      ((errNum = WlzNextGreyInterval(&srcIWSp)) == WLZ_ERR_NONE) &&
-	      ((errNum = WlzNextGreyInterval(&dstIWSp)) == WLZ_ERR_NONE))
-	{
-	  itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
-	  bufPos.vtX = srcIWSp.lftpos - srcDom.i->kol1;
-	  /* Process any lines between this and the last. */
-	  if(srcIWSp.nwlpos > 0)
-	  {
-	    idN = (srcIWSp.nwlpos >= 3)? 3: srcIWSp.nwlpos;
-	    while(--idN >= 0)
-	    {
-	      bufPos.vtY = srcIWSp.linpos - srcDom.i->line1 - idN;
-	      bufLnIdx = (3 + bufPos.vtY) % 3;
-	      WlzValueSetUByte(*(itvBuf + bufLnIdx), 0, itvBufWidth);
-	    }
-	    dstLnIdx = (bufPos.vtY + 3 + ((idD)? 2: - 2)) % 3;
-	  }
-	  /* Copy interval to buffer. */
-	  srcBufGP.dbp = *((double **)srcBuf + bufLnIdx);
-	  wrkBufGP.dbp = *((double **)wrkBuf + bufLnIdx);
-	  dstBufGP.dbp = *((double **)wrkBuf + dstLnIdx);
-	  WlzBitLnSetItv(*(itvBuf + bufLnIdx),
-	  		 bufPos.vtX, bufPos.vtX + itvLen - 1, bufSz.vtX);
-	  WlzValueCopyGreyToGrey(srcBufGP, bufPos.vtX, bufType,
-				 srcGWSp.u_grintptr, 0, srcGWSp.pixeltype,
-				 itvLen);
-	  if(rasDir == WLZ_RASTERDIR_DLIC)
-	  {
-	    WlzValueCopyGreyToGrey(wrkBufGP, bufPos.vtX, bufType,
-	    			   dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-				   itvLen);
-	  }
-	  /* Apply filter to this interval. */
-	  WlzRsvFilterFilterBufYF(ftr, (double **)wrkBuf, (double **)srcBuf,
-				itvBuf, bufPos, itvLen, idD);
-	  /* Clamp data buffer into the dst interval. */
-	  if(rasDir == WLZ_RASTERDIR_ILIC)
-	  {
-	    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-				      wrkBufGP, bufPos.vtX, bufType, itvLen);
-	  }
-	  else
-	  {
-	    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0, dstGWSp.pixeltype,
-				      dstBufGP, bufPos.vtX, bufType, itvLen);
-	  }
-	}
-      }
-      if(errNum == WLZ_ERR_EOO)
-      {
-	errNum = WLZ_ERR_NONE;
-      }
-      ++idD;
+      errNum = WLZ_ERR_NONE;
     }
+    (void )WlzEndGreyScan(&iWSp, &gWSp);
   }
-  if(itvBuf)
-  {
-    Alc2Free((void **)itvBuf);
-  }
-  if(srcBuf)
-  {
-    Alc2Free(srcBuf);
-  }
-  if(wrkBuf)
-  {
-    Alc2Free(wrkBuf);
-  }
+  AlcFree(itv);
+  AlcFree(datBuf);
+  AlcFree(wrkBuf);
+  AlcFree(mskBuf);
+  AlcFree(thrBuf);
   if(errNum != WLZ_ERR_NONE)
   {
     if(dstObj)
@@ -1268,7 +1143,7 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
 *               through the columns of the given 3D domain
 *               object with grey values using either double
 *               precision floating point arithmetic or fixed
-*               point arithmetic.
+*               point arithmetic. The planes are filtered in parallel.
 *               It is assumed that the object type has already been
 *               checked, the domain and values are non-null.
 * \param	srcObj			Given object.
@@ -1280,21 +1155,15 @@ static WlzObject *WlzRsvFilterObj2DY(WlzObject *srcObj, WlzRsvFilter *ftr,
 static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
 			              int actionMsk, WlzErrorNum *dstErr)
 {
-  int		nPlanes;
-  WlzObject	*srcObj2D,
-  		*dstObj2D,
-		*dstObj = NULL;
-  WlzDomain 	*srcDom2D;
-  WlzValues	*srcVal2D,
-  		*dstVal2D;
+  int		idP,
+  		nPlanes;
   WlzDomain	srcDom;
   WlzValues	dstVal;
+  WlzObject	*dstObj = NULL;
   WlzErrorNum	errNum = WLZ_ERR_NONE;
 
   dstVal.core = NULL;
   srcDom = srcObj->domain;
-  srcDom2D = srcDom.p->domains;
-  srcVal2D = srcObj->values.vox->values;
   nPlanes = srcDom.p->lastpl - srcDom.p->plane1 + 1;
   dstVal.vox = WlzMakeVoxelValueTb(srcObj->values.vox->type,
 				   srcDom.p->plane1, srcDom.p->lastpl,
@@ -1302,43 +1171,65 @@ static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
 				   NULL, &errNum);
   if(errNum == WLZ_ERR_NONE)
   {
-    dstVal2D = dstVal.vox->values;
     dstObj = WlzMakeMain(srcObj->type, srcDom, dstVal, NULL, NULL, &errNum);
   }
-  while((errNum == WLZ_ERR_NONE) &&
-        (nPlanes-- > 0))
+  if(errNum == WLZ_ERR_NONE)
   {
-    srcObj2D = NULL;
-    dstObj2D = NULL;
-    if(srcDom2D->core)
+    /* The planes are independent so filter them in parallel. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idP = 0; idP < nPlanes; ++idP)
     {
-      dstObj2D = NULL;
-      srcObj2D = WlzAssignObject(
-      		 WlzMakeMain(WLZ_2D_DOMAINOBJ, *srcDom2D++, *srcVal2D++,
-			     NULL, NULL, &errNum), NULL);
       if(errNum == WLZ_ERR_NONE)
       {
-	dstObj2D = WlzAssignObject(
-		   WlzRsvFilterObj(srcObj2D, ftr, actionMsk, &errNum), NULL);
-      }
-      if(errNum == WLZ_ERR_NONE)
-      {
-	*dstVal2D = WlzAssignValues(dstObj2D->values, NULL);
-      }
-      if(srcObj2D)
-      {
-        WlzFreeObj(srcObj2D);
-      }
-      if(dstObj2D)
-      {
-        WlzFreeObj(dstObj2D);
+	WlzDomain	*srcDom2D;
+	WlzValues	*dstVal2D;
+	WlzObject	*srcObj2D = NULL,
+			*dstObj2D = NULL;
+	WlzErrorNum	errNum2D = WLZ_ERR_NONE;
+
+	srcDom2D = srcDom.p->domains + idP;
+	dstVal2D = dstVal.vox->values + idP;
+	if(srcDom2D->core)
+	{
+	  srcObj2D = WlzAssignObject(
+		     WlzMakeMain(WLZ_2D_DOMAINOBJ, *srcDom2D,
+				 srcObj->values.vox->values[idP],
+				 NULL, NULL, &errNum2D), NULL);
+	  if(errNum2D == WLZ_ERR_NONE)
+	  {
+	    dstObj2D = WlzAssignObject(
+		       WlzRsvFilterObj(srcObj2D, ftr, actionMsk,
+				       &errNum2D), NULL);
+	  }
+	  if(errNum2D == WLZ_ERR_NONE)
+	  {
+	    *dstVal2D = WlzAssignValues(dstObj2D->values, NULL);
+	  }
+	  (void )WlzFreeObj(srcObj2D);
+	  (void )WlzFreeObj(dstObj2D);
+	}
+	else
+	{
+	  dstVal2D->core = NULL;
+	}
+	if(errNum2D != WLZ_ERR_NONE)
+	{
+#ifdef _OPENMP
+#pragma omp critical
+	  {
+#endif
+	    if(errNum == WLZ_ERR_NONE)
+	    {
+	      errNum = errNum2D;
+	    }
+#ifdef _OPENMP
+	  }
+#endif
+	}
       }
     }
-    else
-    {
-      dstVal2D->core = NULL;
-    }
-    ++dstVal2D;
   }
   if(errNum != WLZ_ERR_NONE)
   {
@@ -1364,7 +1255,8 @@ static WlzObject *WlzRsvFilterObj3DXY(WlzObject *srcObj, WlzRsvFilter *ftr,
 * \brief	Applies a recursive filter through the planes of the
 *               given 3D domain object with grey values using either
 *               double precision floating point arithmetic or fixed
-*               point arithmetic.
+*               point arithmetic. The planes are filtered in turn,
+*               with the intervals of each plane filtered in parallel.
 *               It is assumed that the object type has already been
 *               checked, the domain and values are non-null.
 * \param	srcObj			Given object.
@@ -1380,6 +1272,8 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
 		idN,
   		idP,
 		itvLen,
+		nItv = 0,
+		maxItv = 0,
 		dstPnIdx,
 		bufPlIdx,
   		nPlanes,
@@ -1398,6 +1292,7 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
   WlzGreyP	dstBufGP,
   		srcBufGP,
   		wrkBufGP;
+  int		*itv = NULL;
   void		***srcBuf = NULL,
   		***wrkBuf = NULL;
   void		**srcBuf2D,
@@ -1587,8 +1482,12 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
 	      /* Make a 2D object from destination plane. */
 	      dstObj2D = WlzMakeMain(WLZ_2D_DOMAINOBJ, *srcDom2D, *dstVal2D,
 				     NULL, NULL, &errNum);
-	      /* Process each interval of this plane. */
-	      if(((errNum = WlzInitGreyScan(srcObj2D, &srcIWSp,
+	      /* Copy the intervals of this plane into the buffers,
+	       * recording them so that they can then be filtered in
+	       * parallel. */
+	      nItv = 0;
+	      if((errNum == WLZ_ERR_NONE) &&
+	         ((errNum = WlzInitGreyScan(srcObj2D, &srcIWSp,
 	      				    &srcGWSp)) == WLZ_ERR_NONE) &&
 	         ((errNum = WlzInitGreyScan(dstObj2D, &dstIWSp,
 	      				    &dstGWSp)) == WLZ_ERR_NONE))
@@ -1602,10 +1501,23 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
 		  itvLen = srcIWSp.rgtpos - srcIWSp.lftpos + 1;
 		  bufPos.vtX = srcIWSp.lftpos - srcDom.p->kol1;
 		  bufPos.vtY = srcIWSp.linpos - srcDom.p->line1;
+		  if(nItv >= maxItv)
+		  {
+		    maxItv = (2 * maxItv) + 1024;
+		    if((itv = (int *)AlcRealloc(itv, sizeof(int) * 3 *
+		    				     maxItv)) == NULL)
+		    {
+		      errNum = WLZ_ERR_MEM_ALLOC;
+		      break;
+		    }
+		  }
+		  itv[3 * nItv] = bufPos.vtX;
+		  itv[(3 * nItv) + 1] = bufPos.vtY;
+		  itv[(3 * nItv) + 2] = itvLen;
+		  ++nItv;
 		  /* Copy interval to buffer. */
 		  srcBufGP.dbp = *((double **)srcBuf2D + bufPos.vtY);
 		  wrkBufGP.dbp = *((double **)wrkBuf2D + bufPos.vtY);
-		  dstBufGP.dbp = *((double **)dstBuf2D + bufPos.vtY);
 		  WlzBitLnSetItv(*(itvBuf2D + bufPos.vtY),
 		  		 bufPos.vtX, bufPos.vtX + itvLen - 1,
 				 bufSz.vtX);
@@ -1620,25 +1532,49 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
 					   dstGWSp.pixeltype,
 					   itvLen);
 		  }
-		  /* Apply filter to this interval. */
+		}
+		if(errNum == WLZ_ERR_EOO)
+		{
+		  errNum = WLZ_ERR_NONE;
+		}
+	      }
+	      /* Apply the filter to the intervals, each of which only
+	       * depends on the buffered planes. */
+	      if(errNum == WLZ_ERR_NONE)
+	      {
+		int	idI;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+		for(idI = 0; idI < nItv; ++idI)
+		{
+		  WlzIVertex3	itvPos;
+
+		  itvPos.vtX = itv[3 * idI];
+		  itvPos.vtY = itv[(3 * idI) + 1];
+		  itvPos.vtZ = bufPos.vtZ;
 		  WlzRsvFilterFilterBufZF(ftr, (double ***)wrkBuf,
 					  (double ***)srcBuf, itvBuf,
-					  bufPos, itvLen, idD);
-		  /* Clamp data buffer back into the destination plane. */
-		  if(idD == 0)
-		  {
-		    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0,
-					      dstGWSp.pixeltype,
-					      wrkBufGP, bufPos.vtX, bufType,
-					      itvLen);
-		  }
-		  else
-		  {
-		    WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0,
-					      dstGWSp.pixeltype,
-					      dstBufGP, bufPos.vtX, bufType,
-					      itvLen);
-		  }
+					  itvPos, itv[(3 * idI) + 2], idD);
+		}
+	      }
+	      /* Clamp data buffer back into the destination plane. */
+	      if((errNum == WLZ_ERR_NONE) &&
+	         ((errNum = WlzInitGreyScan(dstObj2D, &dstIWSp,
+	      				    &dstGWSp)) == WLZ_ERR_NONE))
+	      {
+		while((errNum = WlzNextGreyInterval(
+		      			&dstIWSp)) == WLZ_ERR_NONE)
+		{
+		  bufPos.vtX = dstIWSp.lftpos - srcDom.p->kol1;
+		  bufPos.vtY = dstIWSp.linpos - srcDom.p->line1;
+		  dstBufGP.dbp = *((double **)((idD)? dstBuf2D: wrkBuf2D) +
+		  		   bufPos.vtY);
+		  WlzValueClampGreyIntoGrey(dstGWSp.u_grintptr, 0,
+					    dstGWSp.pixeltype,
+					    dstBufGP, bufPos.vtX, bufType,
+					    dstIWSp.colrmn);
 		}
 		if(errNum == WLZ_ERR_EOO)
 		{
@@ -1662,6 +1598,7 @@ static WlzObject *WlzRsvFilterObj3DZ(WlzObject *srcObj, WlzRsvFilter *ftr,
       }
     }
   }
+  AlcFree(itv);
   if(itvBuf)
   {
     Alc3Free((void ***)itvBuf);
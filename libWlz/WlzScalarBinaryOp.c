@@ -40,13 +40,23 @@ static char _WlzScalarBinaryOp_c[] = "University of Edinburgh $Id$";
 */
 
 #include <stdlib.h>
+#include <limits.h>
 #include <float.h>
 #include <Wlz.h>
 
+typedef void (*WlzScalarBinaryOpKerFn)(WlzGreyP, WlzGreyP, WlzPixelV, int,
+				       WlzBinaryOperatorType, int);
+
+static WlzErrorNum WlzScalarBinaryOpObj(WlzObject	*o1,
+				        WlzPixelV	pval,
+				        WlzObject	*o3,
+				        WlzBinaryOperatorType op,
+					int		clampFlg);
 static WlzErrorNum WlzScalarBinaryOp3d(WlzObject	*o1,
 				       WlzPixelV	pval,
 				       WlzObject	*o3,
-				       WlzBinaryOperatorType op);
+				       WlzBinaryOperatorType op,
+				       int		clampFlg);
 
 static WlzErrorNum WlzBufIntIntScalarBinaryOp(
   int		*inbuf1,
@@ -978,33 +988,629 @@ static WlzErrorNum WlzBufDblDblScalarBinaryOp(
   return WLZ_ERR_NONE;
 }
 
-/* function:     WlzScalarBinaryOp    */
-/*! 
-* \ingroup      WlzArithmetic
-* \brief        Perform the given binary operation for each grey
-value in image o1 with val putting the result in o3.
-The value table of o3 can be identical to that of o1
-to allow overwriting.
-This function assumes that the domains of each object
-are the same. Unless overwriting is required then the
-functions WlzImageAdd, WlzImageSubtract etc. should be
-used. These return an object which is the intersection
-of the input objects.
-*
-* \return       Woolz error.
-* \param    o1	Input object.
-* \param    pval	Operand value.
-* \param    o3	Oject for the return values. Setting equal to
- <tt>o1</tt> means values will be overwritten.
- * \param    op	Opertor to be applied.
-* \par      Source:
-*                WlzScalarBinaryOp.c
+/*
+* Typed kernels which fuse the load, operator and store for intervals
+* in which the input and output grey types are the same (or WlzUByte
+* input with short output as created by WlzScalarBinaryOp2()). Each
+* kernel loops directly over the interval's grey values with a fixed
+* operator, value, working and result type so that the loops may be
+* vectorised by the compiler. Values are computed in int when both the
+* grey values and the operand are integral and otherwise in double,
+* as for the buffer functions above. The results are either cast, as
+* by the buffer functions, or clamped into the range of the result
+* type.
 */
-WlzErrorNum WlzScalarBinaryOp(
+#define WLZ_SBO_ADD(A,V)	((A)+(V))
+#define WLZ_SBO_SUB(A,V)	((A)-(V))
+#define WLZ_SBO_MUL(A,V)	((A)*(V))
+#define WLZ_SBO_DIV(A,V)	((A)/(V))
+#define WLZ_SBO_MOD(A,V)	((A)%(V))
+#define WLZ_SBO_EQ(A,V)		((A)==(V))
+#define WLZ_SBO_NE(A,V)		((A)!=(V))
+#define WLZ_SBO_GT(A,V)		((A)>(V))
+#define WLZ_SBO_GE(A,V)		((A)>=(V))
+#define WLZ_SBO_LT(A,V)		((A)<(V))
+#define WLZ_SBO_LE(A,V)		((A)<=(V))
+#define WLZ_SBO_AND(A,V)	((A)&(V))
+#define WLZ_SBO_OR(A,V)		((A)|(V))
+#define WLZ_SBO_XOR(A,V)	((A)^(V))
+#define WLZ_SBO_EQ_D(A,V)	(fabs((A)-(V))<DBL_EPSILON)
+#define WLZ_SBO_NE_D(A,V)	(fabs((A)-(V))>DBL_EPSILON)
+
+#define WLZ_SBO_CAST_UB(V)	((WlzUByte )(V))
+#define WLZ_SBO_CAST_S(V)	((short )(V))
+#define WLZ_SBO_CAST_I(V)	((int )(V))
+#define WLZ_SBO_CAST_F(V)	((float )(V))
+#define WLZ_SBO_CAST_D(V)	(V)
+#define WLZ_SBO_CLAMP_I_UB(V)	((WlzUByte )WLZ_CLAMP((V),0,255))
+#define WLZ_SBO_CLAMP_I_S(V)	((short )WLZ_CLAMP((V),SHRT_MIN,SHRT_MAX))
+#define WLZ_SBO_CLAMP_D_UB(V)	((WlzUByte )WLZ_NINT(WLZ_CLAMP((V),0.0,255.0)))
+#define WLZ_SBO_CLAMP_D_S(V) \
+	((short )WLZ_NINT(WLZ_CLAMP((V),(double )SHRT_MIN,(double )SHRT_MAX)))
+#define WLZ_SBO_CLAMP_D_I(V) \
+	(WLZ_NINT(WLZ_CLAMP((V),(double )INT_MIN,(double )INT_MAX)))
+#define WLZ_SBO_CLAMP_D_F(V)	((float )WLZ_CLAMP((V),-FLT_MAX,FLT_MAX))
+
+/*!
+* \def		WLZ_SBO_LOOP(D,S,V,N,W,X,C)
+* \brief	Applies operator X, working in type W, to the N values
+*		of S and the value V with the results stored in D using
+*		the cast or clamp C.
+*/
+#define WLZ_SBO_LOOP(D,S,V,N,W,X,C) \
+{ \
+  int	i_; \
+  W	r_; \
+ \
+  for(i_ = 0; i_ < (N); ++i_) \
+  { \
+    r_ = X((W )((S)[i_]),(V)); \
+    (D)[i_] = C(r_); \
+  } \
+}
+
+/*!
+* \def		WLZ_SBO_SWITCH_I(OP,D,S,V,N,C)
+* \brief	Applies operator OP working in int.
+*/
+#define WLZ_SBO_SWITCH_I(OP,D,S,V,N,C) \
+switch(OP) \
+{ \
+  case WLZ_BO_ADD:      WLZ_SBO_LOOP(D,S,V,N,int,WLZ_SBO_ADD,C) break; \
+  case WLZ_BO_SUBTRACT: WLZ_SBO_LOOP(D,S,V,N,int,WLZ_SBO_SUB,C) break; \
+  case WLZ_BO_MULTIPLY: WLZ_SBO_LOOP(D,S,V,N,int,WLZ_SBO_MUL,C) break; \
+  case WLZ_BO_DIVIDE:   WLZ_SBO_LOOP(D,S,V,N,int,WLZ_SBO_DIV,C) break; \
+  case WLZ_BO_MODULUS:  WLZ_SBO_LOOP(D,S,V,N,int,WLZ_SBO_MOD,C) break; \
+  case WLZ_BO_EQ:       WLZ_SBO_LOOP(D,S,V,N,int,WLZ_SBO_EQ,C) break; \
+  case WLZ_BO_NE:       WLZ_SBO_LOOP(D,S,V,N,int,WLZ_SBO_NE,C) break; \
+  case WLZ_BO_GT:       WLZ_SBO_LOOP(D,S,V,N,int,WLZ_SBO_GT,C) break; \
+  case WLZ_BO_GE:       WLZ_SBO_LOOP(D,S,V,N,int,WLZ_SBO_GE,C) break; \
+  case WLZ_BO_LT:       WLZ_SBO_LOOP(D,S,V,N,int,WLZ_SBO_LT,C) break; \
+  case WLZ_BO_LE:       WLZ_SBO_LOOP(D,S,V,N,int,WLZ_SBO_LE,C) break; \
+  case WLZ_BO_AND:      WLZ_SBO_LOOP(D,S,V,N,int,WLZ_SBO_AND,C) break; \
+  case WLZ_BO_OR:       WLZ_SBO_LOOP(D,S,V,N,int,WLZ_SBO_OR,C) break; \
+  case WLZ_BO_XOR:      WLZ_SBO_LOOP(D,S,V,N,int,WLZ_SBO_XOR,C) break; \
+  default: \
+    break; \
+}
+
+/*!
+* \def		WLZ_SBO_SWITCH_D(OP,D,S,V,N,C)
+* \brief	Applies operator OP working in double.
+*/
+#define WLZ_SBO_SWITCH_D(OP,D,S,V,N,C) \
+switch(OP) \
+{ \
+  case WLZ_BO_ADD:      WLZ_SBO_LOOP(D,S,V,N,double,WLZ_SBO_ADD,C) break; \
+  case WLZ_BO_SUBTRACT: WLZ_SBO_LOOP(D,S,V,N,double,WLZ_SBO_SUB,C) break; \
+  case WLZ_BO_MULTIPLY: WLZ_SBO_LOOP(D,S,V,N,double,WLZ_SBO_MUL,C) break; \
+  case WLZ_BO_DIVIDE:   WLZ_SBO_LOOP(D,S,V,N,double,WLZ_SBO_DIV,C) break; \
+  case WLZ_BO_EQ:       WLZ_SBO_LOOP(D,S,V,N,double,WLZ_SBO_EQ_D,C) break; \
+  case WLZ_BO_NE:       WLZ_SBO_LOOP(D,S,V,N,double,WLZ_SBO_NE_D,C) break; \
+  case WLZ_BO_GT:       WLZ_SBO_LOOP(D,S,V,N,double,WLZ_SBO_GT,C) break; \
+  case WLZ_BO_GE:       WLZ_SBO_LOOP(D,S,V,N,double,WLZ_SBO_GE,C) break; \
+  case WLZ_BO_LT:       WLZ_SBO_LOOP(D,S,V,N,double,WLZ_SBO_LT,C) break; \
+  case WLZ_BO_LE:       WLZ_SBO_LOOP(D,S,V,N,double,WLZ_SBO_LE,C) break; \
+  default: \
+    break; \
+}
+
+/*
+* \return	<void>
+* \brief	Typed kernels, one for each pair of input and output
+*		grey types, which apply the given operator to an
+*		interval of values. The operand value must either be
+*		of type WLZ_GREY_INT or WLZ_GREY_DOUBLE and the operator
+*		must have been checked as valid for it.
+* \param	gD			Output values.
+* \param	gS			Input values.
+* \param	val			Operand value.
+* \param	n			Number of values.
+* \param	op			Binary operator.
+* \param	clampFlg		Clamp results into the range of
+*					the output type if non-zero,
+*					otherwise cast.
+*/
+static void	WlzScalarBinaryOpKerUByteUByte(WlzGreyP gD, WlzGreyP gS,
+					       WlzPixelV val, int n,
+					       WlzBinaryOperatorType op,
+					       int clampFlg)
+{
+  WlzUByte	*s;
+
+  s = gS.ubp;
+  if(val.type == WLZ_GREY_INT)
+  {
+    int		v;
+
+    v = val.v.inv;
+    if(clampFlg)
+    {
+      WLZ_SBO_SWITCH_I(op, gD.ubp, s, v, n, WLZ_SBO_CLAMP_I_UB)
+    }
+    else
+    {
+      WLZ_SBO_SWITCH_I(op, gD.ubp, s, v, n, WLZ_SBO_CAST_UB)
+    }
+  }
+  else
+  {
+    double	v;
+
+    v = val.v.dbv;
+    if(clampFlg)
+    {
+      WLZ_SBO_SWITCH_D(op, gD.ubp, s, v, n, WLZ_SBO_CLAMP_D_UB)
+    }
+    else
+    {
+      WLZ_SBO_SWITCH_D(op, gD.ubp, s, v, n, WLZ_SBO_CAST_UB)
+    }
+  }
+}
+
+static void	WlzScalarBinaryOpKerUByteShort(WlzGreyP gD, WlzGreyP gS,
+					       WlzPixelV val, int n,
+					       WlzBinaryOperatorType op,
+					       int clampFlg)
+{
+  WlzUByte	*s;
+
+  s = gS.ubp;
+  if(val.type == WLZ_GREY_INT)
+  {
+    int		v;
+
+    v = val.v.inv;
+    if(clampFlg)
+    {
+      WLZ_SBO_SWITCH_I(op, gD.shp, s, v, n, WLZ_SBO_CLAMP_I_S)
+    }
+    else
+    {
+      WLZ_SBO_SWITCH_I(op, gD.shp, s, v, n, WLZ_SBO_CAST_S)
+    }
+  }
+  else
+  {
+    double	v;
+
+    v = val.v.dbv;
+    if(clampFlg)
+    {
+      WLZ_SBO_SWITCH_D(op, gD.shp, s, v, n, WLZ_SBO_CLAMP_D_S)
+    }
+    else
+    {
+      WLZ_SBO_SWITCH_D(op, gD.shp, s, v, n, WLZ_SBO_CAST_S)
+    }
+  }
+}
+
+static void	WlzScalarBinaryOpKerShortShort(WlzGreyP gD, WlzGreyP gS,
+					       WlzPixelV val, int n,
+					       WlzBinaryOperatorType op,
+					       int clampFlg)
+{
+  short		*s;
+
+  s = gS.shp;
+  if(val.type == WLZ_GREY_INT)
+  {
+    int		v;
+
+    v = val.v.inv;
+    if(clampFlg)
+    {
+      WLZ_SBO_SWITCH_I(op, gD.shp, s, v, n, WLZ_SBO_CLAMP_I_S)
+    }
+    else
+    {
+      WLZ_SBO_SWITCH_I(op, gD.shp, s, v, n, WLZ_SBO_CAST_S)
+    }
+  }
+  else
+  {
+    double	v;
+
+    v = val.v.dbv;
+    if(clampFlg)
+    {
+      WLZ_SBO_SWITCH_D(op, gD.shp, s, v, n, WLZ_SBO_CLAMP_D_S)
+    }
+    else
+    {
+      WLZ_SBO_SWITCH_D(op, gD.shp, s, v, n, WLZ_SBO_CAST_S)
+    }
+  }
+}
+
+static void	WlzScalarBinaryOpKerIntInt(WlzGreyP gD, WlzGreyP gS,
+					   WlzPixelV val, int n,
+					   WlzBinaryOperatorType op,
+					   int clampFlg)
+{
+  int		*s;
+
+  s = gS.inp;
+  if(val.type == WLZ_GREY_INT)
+  {
+    int		v;
+
+    v = val.v.inv;
+    WLZ_SBO_SWITCH_I(op, gD.inp, s, v, n, WLZ_SBO_CAST_I)
+  }
+  else
+  {
+    double	v;
+
+    v = val.v.dbv;
+    if(clampFlg)
+    {
+      WLZ_SBO_SWITCH_D(op, gD.inp, s, v, n, WLZ_SBO_CLAMP_D_I)
+    }
+    else
+    {
+      WLZ_SBO_SWITCH_D(op, gD.inp, s, v, n, WLZ_SBO_CAST_I)
+    }
+  }
+}
+
+static void	WlzScalarBinaryOpKerFloatFloat(WlzGreyP gD, WlzGreyP gS,
+					       WlzPixelV val, int n,
+					       WlzBinaryOperatorType op,
+					       int clampFlg)
+{
+  float		*s;
+  double	v;
+
+  s = gS.flp;
+  v = (val.type == WLZ_GREY_INT)? (double )(val.v.inv): val.v.dbv;
+  if(clampFlg)
+  {
+    WLZ_SBO_SWITCH_D(op, gD.flp, s, v, n, WLZ_SBO_CLAMP_D_F)
+  }
+  else
+  {
+    WLZ_SBO_SWITCH_D(op, gD.flp, s, v, n, WLZ_SBO_CAST_F)
+  }
+}
+
+static void	WlzScalarBinaryOpKerDoubleDouble(WlzGreyP gD, WlzGreyP gS,
+					         WlzPixelV val, int n,
+					         WlzBinaryOperatorType op,
+					         int clampFlg)
+{
+  double	*s;
+  double	v;
+
+  s = gS.dbp;
+  v = (val.type == WLZ_GREY_INT)? (double )(val.v.inv): val.v.dbv;
+  WLZ_SBO_SWITCH_D(op, gD.dbp, s, v, n, WLZ_SBO_CAST_D)
+}
+
+/*!
+* \return	Typed kernel or NULL if there is no kernel for the
+*		grey types.
+* \ingroup	WlzArithmetic
+* \brief	Selects the typed kernel for the given input and output
+*		grey types.
+* \param	iType			Input grey type.
+* \param	oType			Output grey type.
+*/
+static WlzScalarBinaryOpKerFn WlzScalarBinaryOpKerSet(WlzGreyType iType,
+						      WlzGreyType oType)
+{
+  WlzScalarBinaryOpKerFn kerFn = NULL;
+
+  if(iType == oType)
+  {
+    switch(iType)
+    {
+      case WLZ_GREY_UBYTE:
+	kerFn = WlzScalarBinaryOpKerUByteUByte;
+	break;
+      case WLZ_GREY_SHORT:
+	kerFn = WlzScalarBinaryOpKerShortShort;
+	break;
+      case WLZ_GREY_INT:
+	kerFn = WlzScalarBinaryOpKerIntInt;
+	break;
+      case WLZ_GREY_FLOAT:
+	kerFn = WlzScalarBinaryOpKerFloatFloat;
+	break;
+      case WLZ_GREY_DOUBLE:
+	kerFn = WlzScalarBinaryOpKerDoubleDouble;
+	break;
+      default:
+	break;
+    }
+  }
+  else if((iType == WLZ_GREY_UBYTE) && (oType == WLZ_GREY_SHORT))
+  {
+    kerFn = WlzScalarBinaryOpKerUByteShort;
+  }
+  return(kerFn);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Applies the binary operation to the grey values of
+*		a 2D domain object.
+* \param	o1			Input object.
+* \param	pval			Operand value.
+* \param	o3			Object for the return values.
+* \param	op			Operator to be applied.
+* \param	clampFlg		Clamp values into the range of the
+*					output grey type if non-zero,
+*					otherwise values are cast.
+*/
+static WlzErrorNum WlzScalarBinaryOp2d(
   WlzObject		*o1,
   WlzPixelV		pval,
   WlzObject		*o3,
-  WlzBinaryOperatorType op)
+  WlzBinaryOperatorType op,
+  int			clampFlg)
+{
+  WlzIntervalWSpace	iwsp1, iwsp3;
+  WlzGreyWSpace		gwsp1, gwsp3;
+  WlzPixelP		o1PP, o3PP, tPP;
+  WlzScalarBinaryOpKerFn kerFn = NULL;
+  int			*o1Buf=NULL;
+  void			*tBuf=NULL;
+  int			i, ival, width;
+  double		dval;
+  WlzErrorNum		errNum = WLZ_ERR_NONE;
+
+  o1PP.p.v = o3PP.p.v = tPP.p.v = NULL;
+  o1PP.type = o3PP.type = tPP.type = WLZ_GREY_ERROR;
+  /* initialise the workspaces */
+  if( (errNum = WlzInitGreyScan(o1,&iwsp1,&gwsp1)) ){
+    return errNum;
+  }
+  if( (errNum = WlzInitGreyScan(o3,&iwsp3,&gwsp3)) ){
+    return errNum;
+  }
+  width = iwsp1.intdmn->lastkl - iwsp1.intdmn->kol1 + 1;
+
+  switch( gwsp1.pixeltype ){
+  case WLZ_GREY_INT:
+  case WLZ_GREY_SHORT:
+  case WLZ_GREY_UBYTE:
+    o1PP.type = WLZ_GREY_INT;
+    break;
+
+  case WLZ_GREY_FLOAT:
+  case WLZ_GREY_DOUBLE:
+    o1PP.type = WLZ_GREY_DOUBLE;
+    break;
+  default:
+    break;
+  }
+
+  switch( pval.type ){
+  case WLZ_GREY_INT:
+  case WLZ_GREY_DOUBLE:
+    break;
+
+  case WLZ_GREY_SHORT:
+    ival = (int) pval.v.shv;
+    pval.v.inv = ival;
+    pval.type = WLZ_GREY_INT;
+    break;
+
+  case WLZ_GREY_UBYTE:
+    ival = (int) pval.v.ubv;
+    pval.v.inv = ival;
+    pval.type = WLZ_GREY_INT;
+    break;
+
+  case WLZ_GREY_FLOAT:
+    dval = (double) pval.v.flv;
+    pval.v.dbv = dval;
+    pval.type = WLZ_GREY_DOUBLE;
+    break;
+  default:
+    break;
+  }
+
+  /* check the operator is valid for the type in which the values are
+     computed */
+  if( o1PP.type != WLZ_GREY_ERROR ){
+    if( (o1PP.type == WLZ_GREY_INT) && (pval.type == WLZ_GREY_INT) ){
+      tPP.type = WLZ_GREY_INT;
+      if( (op < WLZ_BO_ADD) || (op > WLZ_BO_XOR) ){
+	errNum = WLZ_ERR_BINARY_OPERATOR_TYPE;
+      }
+      else if( (pval.v.inv == 0) &&
+	       ((op == WLZ_BO_DIVIDE) || (op == WLZ_BO_MODULUS)) ){
+	errNum = WLZ_ERR_PARAM_DATA;
+      }
+    }
+    else {
+      tPP.type = WLZ_GREY_DOUBLE;
+      if( (op < WLZ_BO_ADD) || (op > WLZ_BO_LE) ||
+	  (op == WLZ_BO_MODULUS) ){
+	errNum = WLZ_ERR_BINARY_OPERATOR_TYPE;
+      }
+    }
+  }
+
+  /* select a typed kernel or initialise the buffers */
+  if( errNum == WLZ_ERR_NONE ){
+    kerFn = WlzScalarBinaryOpKerSet(gwsp1.pixeltype, gwsp3.pixeltype);
+  }
+  if( (errNum == WLZ_ERR_NONE) && (kerFn == NULL) ){
+    switch( gwsp1.pixeltype ){
+    case WLZ_GREY_SHORT:
+    case WLZ_GREY_UBYTE:
+      o1Buf = (int *) AlcMalloc(sizeof(int) * width);
+      o1PP.p.inp = o1Buf;
+      break;
+
+    case WLZ_GREY_FLOAT:
+      o1Buf = (int *) AlcMalloc(sizeof(double) * width);
+      o1PP.p.inp = o1Buf;
+      break;
+    default:
+      break;
+    }
+    if( clampFlg && (tPP.type != WLZ_GREY_ERROR) ){
+      tBuf = AlcMalloc(sizeof(double) * width);
+      tPP.p.v = tBuf;
+    }
+  }
+
+  o3PP.type = gwsp3.pixeltype;
+
+  while( (errNum == WLZ_ERR_NONE) &&
+	 ((errNum = WlzNextGreyInterval(&iwsp1)) == WLZ_ERR_NONE) ){
+    WlzNextGreyInterval(&iwsp3);
+
+    if( kerFn ){
+      kerFn(gwsp3.u_grintptr, gwsp1.u_grintptr, pval, iwsp1.colrmn,
+	    op, clampFlg);
+      continue;
+    }
+
+    /* copy values to buffers */
+    switch(  gwsp1.pixeltype ){
+    case WLZ_GREY_INT:
+      o1PP.p.inp = gwsp1.u_grintptr.inp;
+      break;
+
+    case WLZ_GREY_SHORT:
+      for(i=0; i<iwsp1.colrmn; i++){
+	o1PP.p.inp[i] = *gwsp1.u_grintptr.shp++;
+      }
+      break;
+
+    case WLZ_GREY_UBYTE:
+      for(i=0; i<iwsp1.colrmn; i++){
+	o1PP.p.inp[i] = (int) (*gwsp1.u_grintptr.ubp++);
+      }
+      break;
+
+    case WLZ_GREY_FLOAT:
+      for(i=0; i<iwsp1.colrmn; i++){
+	o1PP.p.dbp[i] = *gwsp1.u_grintptr.flp++;
+      }
+      break;
+
+    case WLZ_GREY_DOUBLE:
+      o1PP.p.dbp = gwsp1.u_grintptr.dbp;
+      break;
+
+    default:
+      break;
+    }
+
+    switch(  gwsp3.pixeltype ){
+    case WLZ_GREY_INT:
+      o3PP.p.inp = gwsp3.u_grintptr.inp;
+      break;
+
+    case WLZ_GREY_SHORT:
+      o3PP.p.shp = gwsp3.u_grintptr.shp;
+      break;
+
+    case WLZ_GREY_UBYTE:
+      o3PP.p.ubp = gwsp3.u_grintptr.ubp;
+      break;
+
+    case WLZ_GREY_FLOAT:
+      o3PP.p.flp = gwsp3.u_grintptr.flp;
+      break;
+
+    case WLZ_GREY_DOUBLE:
+      o3PP.p.dbp = gwsp3.u_grintptr.dbp;
+      break;
+
+    default:
+      break;
+    }
+
+    /* apply binary operation, when clamping the values are computed
+       into a buffer of the working type and then clamped into the
+       output */
+    switch( o1PP.type ){
+    case WLZ_GREY_INT:
+      switch( pval.type ){
+      case WLZ_GREY_INT:
+	errNum = WlzBufIntIntScalarBinaryOp(o1PP.p.inp, pval.v.inv,
+					    (clampFlg)? tPP: o3PP,
+					    iwsp1.colrmn, op);
+	break;
+      case WLZ_GREY_DOUBLE:
+	errNum = WlzBufIntDblScalarBinaryOp(o1PP.p.inp, pval.v.dbv,
+					    (clampFlg)? tPP: o3PP,
+					    iwsp1.colrmn, op);
+	break;
+      default:
+	break;
+      }
+      break;
+    case WLZ_GREY_DOUBLE:
+      switch( pval.type ){
+      case WLZ_GREY_INT:
+	errNum = WlzBufDblIntScalarBinaryOp(o1PP.p.dbp, pval.v.inv,
+					    (clampFlg)? tPP: o3PP,
+					    iwsp1.colrmn, op);
+	break;
+      case WLZ_GREY_DOUBLE:
+	errNum = WlzBufDblDblScalarBinaryOp(o1PP.p.dbp, pval.v.dbv,
+					    (clampFlg)? tPP: o3PP,
+					    iwsp1.colrmn, op);
+	break;
+      default:
+	break;
+      }
+      break;
+    default:
+      break;
+    }
+    if( (errNum == WLZ_ERR_NONE) && clampFlg &&
+        (tPP.type != WLZ_GREY_ERROR) ){
+      WlzValueClampGreyIntoGrey(o3PP.p, 0, o3PP.type, tPP.p, 0, tPP.type,
+				iwsp1.colrmn);
+    }
+  }
+  if(errNum == WLZ_ERR_EOO)		/* Reset error from end of intervals */
+  {
+    errNum = WLZ_ERR_NONE;
+  }
+
+  /* free space */
+  if( o1Buf ){
+    AlcFree( o1Buf );
+  }
+  if( tBuf ){
+    AlcFree( tBuf );
+  }
+
+  return errNum;
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzArithmetic
+* \brief	Checks the objects and then applies the binary operation
+*		to them, see WlzScalarBinaryOp().
+* \param	o1			Input object.
+* \param	pval			Operand value.
+* \param	o3			Object for the return values.
+* \param	op			Operator to be applied.
+* \param	clampFlg		Clamp values into the range of the
+*					output grey type if non-zero,
+*					otherwise values are cast.
+*/
+static WlzErrorNum WlzScalarBinaryOpObj(
+  WlzObject		*o1,
+  WlzPixelV		pval,
+  WlzObject		*o3,
+  WlzBinaryOperatorType op,
+  int			clampFlg)
 {
   WlzErrorNum		errNum = WLZ_ERR_NONE;
 
@@ -1057,6 +1663,7 @@ WlzErrorNum WlzScalarBinaryOp(
 	errNum = WLZ_ERR_VALUES_TYPE;
 	break;
       }
+      errNum = WlzScalarBinaryOp2d(o1, pval, o3, op, clampFlg);
       break;
       
     case WLZ_3D_DOMAINOBJ:
@@ -1077,7 +1684,7 @@ WlzErrorNum WlzScalarBinaryOp(
 	errNum = WLZ_ERR_VALUES_TYPE;
 	break;
       }
-      errNum = WlzScalarBinaryOp3d(o1, pval, o3, op);
+      errNum = WlzScalarBinaryOp3d(o1, pval, o3, op, clampFlg);
       break;
       
     case WLZ_TRANS_OBJ:
@@ -1085,7 +1692,8 @@ WlzErrorNum WlzScalarBinaryOp(
 	errNum = WLZ_ERR_VALUES_NULL;
 	break;
       }
-      errNum = WlzScalarBinaryOp(o1->values.obj, pval, o3->values.obj, op);
+      errNum = WlzScalarBinaryOpObj(o1->values.obj, pval, o3->values.obj,
+				    op, clampFlg);
       break;
 
     case WLZ_EMPTY_OBJ:
@@ -1097,189 +1705,65 @@ WlzErrorNum WlzScalarBinaryOp(
     }
   }
 
-  /* scan each object */
-  if( (errNum == WLZ_ERR_NONE) && (o1->type == WLZ_2D_DOMAINOBJ) ){
-    WlzIntervalWSpace	iwsp1, iwsp3;
-    WlzGreyWSpace	gwsp1, gwsp3;
-    WlzPixelP		o1PP, o3PP;
-    int			*o1Buf=NULL;
-    int			i, ival;
-    double		dval;
-
-    o1PP.p.v = o3PP.p.v = NULL;
-    o1PP.type = o3PP.type = WLZ_GREY_ERROR;
-    /* initialise the workspaces */
-    if( (errNum = WlzInitGreyScan(o1,&iwsp1,&gwsp1)) ){
-      return errNum;
-    }
-    if( (errNum = WlzInitGreyScan(o3,&iwsp3,&gwsp3)) ){
-      return errNum;
-    }
-
-    /* initialise the buffers */
-    switch( gwsp1.pixeltype ){
-    case WLZ_GREY_INT:
-    case WLZ_GREY_DOUBLE:
-      o1PP.type = gwsp1.pixeltype;
-      break;
-
-    case WLZ_GREY_SHORT:
-    case WLZ_GREY_UBYTE:
-      o1PP.type = WLZ_GREY_INT;
-      o1Buf = (int *) AlcMalloc(sizeof(int) *
-				(iwsp1.intdmn->lastkl-iwsp1.intdmn->kol1+1));
-      o1PP.p.inp = o1Buf;
-      break;
-
-    case WLZ_GREY_FLOAT:
-      o1PP.type = WLZ_GREY_DOUBLE;
-      o1Buf = (int *) AlcMalloc(sizeof(double) *
-				(iwsp1.intdmn->lastkl-iwsp1.intdmn->kol1+1));
-      o1PP.p.inp = o1Buf;
-      break;
-    default:
-      break;
-    }
-
-    switch( pval.type ){
-    case WLZ_GREY_INT:
-    case WLZ_GREY_DOUBLE:
-      break;
-
-    case WLZ_GREY_SHORT:
-      ival = (int) pval.v.shv;
-      pval.v.inv = ival;
-      pval.type = WLZ_GREY_INT;
-      break;
-
-    case WLZ_GREY_UBYTE:
-      ival = (int) pval.v.ubv;
-      pval.v.inv = ival;
-      pval.type = WLZ_GREY_INT;
-      break;
-
-    case WLZ_GREY_FLOAT:
-      dval = (double) pval.v.flv;
-      pval.v.inv = (float )dval;
-      pval.type = WLZ_GREY_DOUBLE;
-      break;
-    default:
-      break;
-    }
-
-    o3PP.type = gwsp3.pixeltype;
-
-    while ((errNum = WlzNextGreyInterval(&iwsp1)) == WLZ_ERR_NONE) {
-      WlzNextGreyInterval(&iwsp3);
-
-      /* copy values to buffers */
-      switch(  gwsp1.pixeltype ){
-      case WLZ_GREY_INT:
-	o1PP.p.inp = gwsp1.u_grintptr.inp;
-	break;
-
-      case WLZ_GREY_SHORT:
-	for(i=0; i<iwsp1.colrmn; i++){
-	  o1PP.p.inp[i] = *gwsp1.u_grintptr.shp++;
-	}
-	break;
-
-      case WLZ_GREY_UBYTE:
-	for(i=0; i<iwsp1.colrmn; i++){
-	  o1PP.p.inp[i] = (int) (*gwsp1.u_grintptr.ubp++);
-	}
-	break;
-
-      case WLZ_GREY_FLOAT:
-	for(i=0; i<iwsp1.colrmn; i++){
-	  o1PP.p.dbp[i] = *gwsp1.u_grintptr.flp++;
-	}
-	break;
-
-      case WLZ_GREY_DOUBLE:
-	o1PP.p.dbp = gwsp1.u_grintptr.dbp;
-	break;
-
-      default:
-	break;
-      }
-
-      switch(  gwsp3.pixeltype ){
-      case WLZ_GREY_INT:
-	o3PP.p.inp = gwsp3.u_grintptr.inp;
-	break;
-
-      case WLZ_GREY_SHORT:
-	o3PP.p.shp = gwsp3.u_grintptr.shp;
-	break;
-
-      case WLZ_GREY_UBYTE:
-	o3PP.p.ubp = gwsp3.u_grintptr.ubp;
-	break;
-
-      case WLZ_GREY_FLOAT:
-	o3PP.p.flp = gwsp3.u_grintptr.flp;
-	break;
-
-      case WLZ_GREY_DOUBLE:
-	o3PP.p.dbp = gwsp3.u_grintptr.dbp;
-	break;
-
-      default:
-	break;
-      }
-
-      /* apply binary operation */
-      switch( o1PP.type ){
-      case WLZ_GREY_INT:
-	switch( pval.type ){
-	case WLZ_GREY_INT:
-	  errNum = WlzBufIntIntScalarBinaryOp(o1PP.p.inp, pval.v.inv,
-						o3PP, iwsp1.colrmn, op);
-	  break;
-	case WLZ_GREY_DOUBLE:
-	  errNum = WlzBufIntDblScalarBinaryOp(o1PP.p.inp, pval.v.dbv,
-						o3PP, iwsp1.colrmn, op);
-	  break;
-	default:
-	  break;
-	}
-	break;
-      case WLZ_GREY_DOUBLE:
-	switch( pval.type ){
-	case WLZ_GREY_INT:
-	  errNum = WlzBufDblIntScalarBinaryOp(o1PP.p.dbp, pval.v.inv,
-						o3PP, iwsp1.colrmn, op);
-	  break;
-	case WLZ_GREY_DOUBLE:
-	  errNum = WlzBufDblDblScalarBinaryOp(o1PP.p.dbp, pval.v.dbv,
-						o3PP, iwsp1.colrmn, op);
-	  break;
-	default:
-	  break;
-	}
-	break;
-      default:
-	break;
-      }
-
-      if( errNum != WLZ_ERR_NONE ){
-	break;
-      }
-    }
-    if(errNum == WLZ_ERR_EOO)		/* Reset error from end of intervals */
-    {
-      errNum = WLZ_ERR_NONE;
-    }
-
-    /* free space */
-    if( o1Buf ){
-      AlcFree( o1Buf );
-    }
+  return errNum;
+}
 
-  }
+/* function:     WlzScalarBinaryOp    */
+/*! 
+* \ingroup      WlzArithmetic
+* \brief        Perform the given binary operation for each grey
+value in image o1 with val putting the result in o3.
+The value table of o3 can be identical to that of o1
+to allow overwriting.
+This function assumes that the domains of each object
+are the same. Unless overwriting is required then the
+functions WlzImageAdd, WlzImageSubtract etc. should be
+used. These return an object which is the intersection
+of the input objects. Values outside the range of the
+grey type of o3 are cast to it.
+*
+* \return       Woolz error.
+* \param    o1	Input object.
+* \param    pval	Operand value.
+* \param    o3	Oject for the return values. Setting equal to
+ <tt>o1</tt> means values will be overwritten.
+ * \param    op	Opertor to be applied.
+* \par      Source:
+*                WlzScalarBinaryOp.c
+*/
+WlzErrorNum WlzScalarBinaryOp(
+  WlzObject		*o1,
+  WlzPixelV		pval,
+  WlzObject		*o3,
+  WlzBinaryOperatorType op)
+{
+  return WlzScalarBinaryOpObj(o1, pval, o3, op, 0);
+}
 
-  return errNum;
+/* function:     WlzScalarBinaryOpClamp    */
+/*! 
+* \ingroup      WlzArithmetic
+* \brief        Perform the given binary operation for each grey
+value in image o1 with val putting the result in o3, as
+WlzScalarBinaryOp(), but with values outside the range of
+the grey type of o3 clamped into it.
+*
+* \return       Woolz error.
+* \param    o1	Input object.
+* \param    pval	Operand value.
+* \param    o3	Oject for the return values. Setting equal to
+ <tt>o1</tt> means values will be overwritten.
+ * \param    op	Opertor to be applied.
+* \par      Source:
+*                WlzScalarBinaryOp.c
+*/
+WlzErrorNum WlzScalarBinaryOpClamp(
+  WlzObject		*o1,
+  WlzPixelV		pval,
+  WlzObject		*o3,
+  WlzBinaryOperatorType op)
+{
+  return WlzScalarBinaryOpObj(o1, pval, o3, op, 1);
 }
 
 
@@ -1287,9 +1771,9 @@ static WlzErrorNum WlzScalarBinaryOp3d(
   WlzObject	*o1,
   WlzPixelV	pval,
   WlzObject	*o3,
-  WlzBinaryOperatorType op)
+  WlzBinaryOperatorType op,
+  int		clampFlg)
 {
-  WlzObject		*temp1, *temp3;
   WlzPlaneDomain	*pdom;
   WlzDomain		*domains;
   WlzValues		*values1, *values3;
@@ -1325,8 +1809,12 @@ static WlzErrorNum WlzScalarBinaryOp3d(
     errNum = WLZ_ERR_VOXELVALUES_TYPE;
     break;
   }
+  if( errNum != WLZ_ERR_NONE ){
+    return errNum;
+  }
 
-  /* apply the binary operation to each plane */
+  /* apply the binary operation to each plane, the planes are
+     independent so may be processed in parallel */
 
   /* note a NULL domain is currently legal (to be WLZ_EMPTY_DOMAIN) and
    corresponds to a WLZ_EMPTY_OBJ */
@@ -1337,22 +1825,35 @@ static WlzErrorNum WlzScalarBinaryOp3d(
   values3 = o3->values.vox->values;
   nplanes = pdom->lastpl - pdom->plane1 + 1;
 
-  for(i=0; i < nplanes; i++, domains++, values1++, values3++){
-    if( (*domains).core == NULL ){
-      continue;
-    }
-
-    if((temp1 = WlzMakeMain(WLZ_2D_DOMAINOBJ, *domains, *values1,
-			    NULL, NULL, &errNum)) != NULL){
-      if((temp3 = WlzMakeMain(WLZ_2D_DOMAINOBJ, *domains, *values3,
-			     NULL, NULL, &errNum)) != NULL){
-	errNum = WlzScalarBinaryOp(temp1, pval, temp3, op);
-	WlzFreeObj( temp3 );
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for(i=0; i < nplanes; i++){
+    if( (errNum == WLZ_ERR_NONE) && (domains[i].core != NULL) ){
+      WlzObject		*temp1, *temp3;
+      WlzErrorNum	errNum2D = WLZ_ERR_NONE;
+
+      if((temp1 = WlzMakeMain(WLZ_2D_DOMAINOBJ, domains[i], values1[i],
+			      NULL, NULL, &errNum2D)) != NULL){
+	if((temp3 = WlzMakeMain(WLZ_2D_DOMAINOBJ, domains[i], values3[i],
+			       NULL, NULL, &errNum2D)) != NULL){
+	  errNum2D = WlzScalarBinaryOpObj(temp1, pval, temp3, op, clampFlg);
+	  WlzFreeObj( temp3 );
+	}
+	WlzFreeObj( temp1 );
+      }
+      if( errNum2D != WLZ_ERR_NONE ){
+#ifdef _OPENMP
+#pragma omp critical (WlzScalarBinaryOp3d)
+	{
+#endif
+	  if( errNum == WLZ_ERR_NONE ){
+	    errNum = errNum2D;
+	  }
+#ifdef _OPENMP
+	}
+#endif
       }
-      WlzFreeObj( temp1 );
-    }
-    if( errNum != WLZ_ERR_NONE ){
-      break;
     }
   }
 
@@ -41,6 +41,7 @@ static char _WlzTiledValues_c[] = "University of Edinburgh $Id$";
 
 #include <stdlib.h>
 #include <limits.h>
+#include <float.h>
 #include <Wlz.h>
 
 #ifdef HAVE_MMAP
@@ -61,6 +62,18 @@ static WlzObject  		*WlzMakeTiledValuesObj2D(
 				  WlzGreyType gType,
 				  WlzPixelV bgdV,
 				  WlzErrorNum *dstErr);
+/*!
+* \struct	_WlzTiledValuesCacheEntry
+* \ingroup	WlzValuesUtils
+* \brief	An entry of a ::WlzTiledValuesCache.
+* 		Typedef: ::WlzTiledValuesCacheEntry.
+*/
+typedef struct _WlzTiledValuesCacheEntry
+{
+  size_t	idx;			/*!< Index of the tile. */
+  WlzTiledValuesCache *cache;		/*!< The cache holding the entry. */
+} WlzTiledValuesCacheEntry;
+
 static WlzObject  		*WlzMakeTiledValuesObj3D(
 				  WlzObject *gObj,
 				  size_t tileSz,
@@ -68,6 +81,29 @@ static WlzObject  		*WlzMakeTiledValuesObj3D(
 				  WlzGreyType gType,
 				  WlzPixelV bgdV,
 				  WlzErrorNum *dstErr);
+static int			WlzTiledValuesTileCmp(
+				  const void *p0,
+				  const void *p1);
+static unsigned int		WlzTiledValuesCacheKeyFn(
+				  AlcLRUCache *lru,
+				  void *e);
+static int			WlzTiledValuesCacheCmpFn(
+				  const void *e0,
+				  const void *e1);
+static void			WlzTiledValuesCacheUnlinkFn(
+				  AlcLRUCache *lru,
+				  void *e);
+static void			WlzTiledValuesAdvise(
+				  WlzTiledValues *tVal,
+				  size_t *tiles,
+				  size_t nTiles);
+static void			WlzTiledValuesTouch(
+				  WlzTiledValues *tVal,
+				  size_t *tiles,
+				  size_t nTiles);
+static void			WlzTiledValuesRelease(
+				  WlzTiledValues *tVal,
+				  size_t tile);
 
 /*!
 * \return	New tiled values.
@@ -761,6 +797,399 @@ void		WlzTiledValueBufferFill(WlzTiledValueBuffer *tvb,
   tvb->valid = 1;
 }
 
+/*!
+* \return	Array of tile indices or NULL on error or if no tiles
+* 		are intersected.
+* \ingroup	WlzValuesUtils
+* \brief	Computes the indices of the tiles of the given 3D tiled
+* 		values which will be accessed when cutting a section with
+* 		the given view structure. The indices are into the tiles
+* 		themselves (ie after look up in the tiled values' table
+* 		of tile indices) and are returned in increasing order,
+* 		which is also the order of the tiles in memory or in a
+* 		memory mapped file.
+*
+* 		A tile is included if its extent, grown by one voxel in
+* 		each direction to allow for both nearest neighbour and
+* 		linear interpolation, is intersected by the view plane.
+* 		Tiles are found by stepping through the columns of tiles
+* 		perpendicular to the axis which is most nearly parallel
+* 		to the plane's normal, so the cost is proportional to the
+* 		area of the volume rather than to it's number of tiles.
+* 		The returned array should be freed using AlcFree().
+* \param	tVal			Given 3D tiled values.
+* \param	view			Initialised view structure.
+* \param	dstNTiles		Destination pointer for the number
+* 					of tile indices, must not be NULL.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+size_t		*WlzTiledValuesViewTiles(WlzTiledValues *tVal,
+				WlzThreeDViewStruct *view,
+				size_t *dstNTiles, WlzErrorNum *dstErr)
+{
+  int		idA,
+  		idB,
+		idC,
+		aA = 2,
+		aB = 0,
+		aC = 1;
+  size_t	nTiles = 0,
+  		maxTiles = 0;
+  size_t	*tiles = NULL;
+  double	dst;
+  int		org[3];
+  double	nrm[3];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  const double	mrg = 1.0;
+
+  if((tVal == NULL) || (view == NULL) || (dstNTiles == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(WlzGreyTableIsTiled(tVal->type) != WLZ_GREY_TAB_TILED)
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else if(tVal->dim != 3)
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else if((view->initialised == 0) || (view->trans == NULL))
+  {
+    errNum = WLZ_ERR_OBJECT_DATA;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* The view plane is the set of points p for which the third row of
+     * the section transform gives the same value as it does for the
+     * origin of the section. */
+    for(idA = 0; idA < 3; ++idA)
+    {
+      nrm[idA] = view->trans->mat[2][idA];
+    }
+    dst = (nrm[0] * (view->xp_to_x[0] + view->yp_to_x[0])) +
+          (nrm[1] * (view->xp_to_y[0] + view->yp_to_y[0])) +
+          (nrm[2] * (view->xp_to_z[0] + view->yp_to_z[0]));
+    org[0] = tVal->kol1;
+    org[1] = tVal->line1;
+    org[2] = tVal->plane1;
+    /* Choose axis A to be that most nearly parallel to the normal. */
+    if((fabs(nrm[0]) >= fabs(nrm[1])) && (fabs(nrm[0]) >= fabs(nrm[2])))
+    {
+      aA = 0; aB = 1; aC = 2;
+    }
+    else if(fabs(nrm[1]) >= fabs(nrm[2]))
+    {
+      aA = 1; aB = 0; aC = 2;
+    }
+    if(fabs(nrm[aA]) < DBL_EPSILON)
+    {
+      errNum = WLZ_ERR_OBJECT_DATA;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    const double w = (double )(tVal->tileWidth);
+
+    for(idC = 0; (errNum == WLZ_ERR_NONE) && (idC < tVal->nIdx[aC]); ++idC)
+    {
+      for(idB = 0; (errNum == WLZ_ERR_NONE) && (idB < tVal->nIdx[aB]);
+          ++idB)
+      {
+	int	idK,
+		a0,
+		a1;
+        double	aMin,
+		aMax;
+	double	b[2],
+		c[2];
+
+	/* Range of A over the column of tiles at (B, C). */
+	b[0] = org[aB] + (idB * w) - mrg;
+	b[1] = org[aB] + ((idB + 1) * w) - 1.0 + mrg;
+	c[0] = org[aC] + (idC * w) - mrg;
+	c[1] = org[aC] + ((idC + 1) * w) - 1.0 + mrg;
+	aMin = DBL_MAX;
+	aMax = -(DBL_MAX);
+	for(idK = 0; idK < 4; ++idK)
+	{
+	  double a;
+
+	  a = (dst - (nrm[aB] * b[idK & 1]) - (nrm[aC] * c[idK >> 1])) /
+	      nrm[aA];
+	  aMin = WLZ_MIN(aMin, a);
+	  aMax = WLZ_MAX(aMax, a);
+	}
+	a0 = (int )ceil((aMin - mrg - org[aA] + 1.0 - w) / w);
+	a1 = (int )floor((aMax + mrg - org[aA]) / w);
+	a0 = WLZ_MAX(a0, 0);
+	a1 = WLZ_MIN(a1, tVal->nIdx[aA] - 1);
+	for(idA = a0; idA <= a1; ++idA)
+	{
+	  size_t idx;
+	  int	tIdx[3];
+
+	  tIdx[aA] = idA;
+	  tIdx[aB] = idB;
+	  tIdx[aC] = idC;
+	  idx = tVal->indices[((tIdx[2] * tVal->nIdx[1]) + tIdx[1]) *
+	                      tVal->nIdx[0] + tIdx[0]];
+	  if(idx < tVal->numTiles)
+	  {
+	    if(nTiles >= maxTiles)
+	    {
+	      maxTiles = (maxTiles == 0)? 1024: 2 * maxTiles;
+	      if((tiles = (size_t *)
+	                  AlcRealloc(tiles, maxTiles * sizeof(size_t))) == NULL)
+	      {
+	        errNum = WLZ_ERR_MEM_ALLOC;
+		break;
+	      }
+	    }
+	    tiles[nTiles++] = idx;
+	  }
+	}
+      }
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(nTiles > 0)
+    {
+      size_t	idx,
+		idN;
+
+      qsort(tiles, nTiles, sizeof(size_t), WlzTiledValuesTileCmp);
+      for(idx = 1, idN = 1; idx < nTiles; ++idx)
+      {
+	if(tiles[idx] != tiles[idN - 1])
+	{
+	  tiles[idN++] = tiles[idx];
+	}
+      }
+      nTiles = idN;
+    }
+  }
+  else
+  {
+    AlcFree(tiles);
+    tiles = NULL;
+    nTiles = 0;
+  }
+  if(dstNTiles)
+  {
+    *dstNTiles = nTiles;
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tiles);
+}
+
+/*!
+* \return	New tiled values cache or NULL on error.
+* \ingroup	WlzAllocation
+* \brief	Makes a new bounded tile cache for the given memory
+* 		mapped tiled values, for use with WlzTiledValuesPrefetch().
+* 		The cache holds at most the given number of tiles resident
+* 		in memory, releasing the least recently used tiles as
+* 		others are prefetched. Tiles of values which are not
+* 		memory mapped are always resident, for these the cache
+* 		only records hits and misses.
+* 		If the tiled values do not already have a cache then the
+* 		new cache is set as their cache, so that it is used by
+* 		WlzGetSubSectionFromObject(), until it is freed.
+* \param	tVal			Given tiled values.
+* \param	maxTiles		Maximum number of tiles to be held
+* 					in the cache, must be greater than
+* 					zero.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzTiledValuesCache *WlzMakeTiledValuesCache(WlzTiledValues *tVal,
+				unsigned int maxTiles, WlzErrorNum *dstErr)
+{
+  WlzValues	val;
+  WlzTiledValuesCache *tc = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tVal == NULL)
+  {
+    errNum = WLZ_ERR_VALUES_NULL;
+  }
+  else if(WlzGreyTableIsTiled(tVal->type) != WLZ_GREY_TAB_TILED)
+  {
+    errNum = WLZ_ERR_VALUES_TYPE;
+  }
+  else if(maxTiles == 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((tc = (WlzTiledValuesCache *)
+                AlcCalloc(1, sizeof(WlzTiledValuesCache))) == NULL)
+  {
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else if((tc->lru = AlcLRUCacheNew(maxTiles, 0,
+  				    WlzTiledValuesCacheKeyFn,
+				    WlzTiledValuesCacheCmpFn,
+				    WlzTiledValuesCacheUnlinkFn,
+				    NULL)) == NULL)
+  {
+    AlcFree(tc);
+    tc = NULL;
+    errNum = WLZ_ERR_MEM_ALLOC;
+  }
+  else
+  {
+    val.t = tVal;
+    tc->tVal = WlzAssignValues(val, NULL).t;
+    if(tVal->cache == NULL)
+    {
+      tVal->cache = tc;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tc);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzAllocation
+* \brief	Frees a tiled values cache. The tiles held by the cache
+* 		are released.
+* \param	tc			Given tiled values cache.
+*/
+WlzErrorNum	WlzFreeTiledValuesCache(WlzTiledValuesCache *tc)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(tc == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    if(tc->tVal->cache == tc)
+    {
+      tc->tVal->cache = NULL;
+    }
+    AlcLRUCacheFree(tc->lru, 1);
+    errNum = WlzFreeTiledValues(tc->tVal);
+    AlcFree(tc);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzValuesUtils
+* \brief	Prefetches the tiles of the given memory mapped 3D tiled
+* 		values which will be accessed when cutting a section
+* 		with the given view structure, see
+* 		WlzTiledValuesViewTiles(). This avoids the scattered
+* 		synchronous page faults that would otherwise occur
+* 		during the section scan.
+*
+* 		Without a cache the kernel is advised (MADV_WILLNEED)
+* 		that the tiles will be needed, with runs of consecutive
+* 		tiles combined, and the function returns without waiting
+* 		for them to be read.
+*
+* 		With a cache, tiles not already in the cache are read
+* 		in before the function returns, using all available
+* 		threads so that many reads are outstanding at once, which
+* 		is appropriate for files on slow storage. The tiles are
+* 		then added to the cache, which releases the least
+* 		recently used tiles to keep within its bound.
+* 		A cache must not be shared by concurrent callers.
+*
+* 		The function does nothing for tiled values which are
+* 		not memory mapped.
+* \param	tVal			Given 3D tiled values.
+* \param	view			Initialised view structure.
+* \param	tc			Optional tiled values cache for the
+* 					given tiled values, may be NULL.
+*/
+WlzErrorNum	WlzTiledValuesPrefetch(WlzTiledValues *tVal,
+				WlzThreeDViewStruct *view,
+				WlzTiledValuesCache *tc)
+{
+  size_t	nTiles = 0;
+  size_t	*tiles = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((tc != NULL) && (tc->tVal != tVal))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else
+  {
+    tiles = WlzTiledValuesViewTiles(tVal, view, &nTiles, &errNum);
+  }
+  if((errNum == WLZ_ERR_NONE) && (nTiles > 0))
+  {
+    if(tc == NULL)
+    {
+      WlzTiledValuesAdvise(tVal, tiles, nTiles);
+    }
+    else
+    {
+      size_t	idx,
+      		nMiss = 0;
+      WlzTiledValuesCacheEntry ent;
+
+      /* Find the tiles that are not in the cache, compacting them to
+       * the start of the array. */
+      ent.cache = tc;
+      for(idx = 0; idx < nTiles; ++idx)
+      {
+        ent.idx = tiles[idx];
+	if(AlcLRUCEntryGet(tc->lru, &ent) == NULL)
+	{
+	  tiles[nMiss++] = tiles[idx];
+	}
+      }
+      tc->hits += nTiles - nMiss;
+      tc->misses += nMiss;
+      if(nMiss > 0)
+      {
+	WlzTiledValuesTouch(tVal, tiles, nMiss);
+      }
+      for(idx = 0; (errNum == WLZ_ERR_NONE) && (idx < nMiss); ++idx)
+      {
+	unsigned int n0;
+	WlzTiledValuesCacheEntry *newEnt;
+
+	if((newEnt = (WlzTiledValuesCacheEntry *)
+		     AlcMalloc(sizeof(WlzTiledValuesCacheEntry))) == NULL)
+	{
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+	else
+	{
+	  newEnt->idx = tiles[idx];
+	  newEnt->cache = tc;
+	  n0 = tc->lru->numItem;
+	  if(AlcLRUCEntryAdd(tc->lru, 1, newEnt, NULL) == NULL)
+	  {
+	    AlcFree(newEnt);
+	  }
+	  else
+	  {
+	    tc->evictions += n0 + 1 - tc->lru->numItem;
+	  }
+	}
+      }
+    }
+  }
+  AlcFree(tiles);
+  return(errNum);
+}
+
 /*!
 * \return	New tiled object or NULL on error.
 * \ingroup	WlzAllocation
@@ -1211,3 +1640,185 @@ static WlzObject  *WlzMakeTiledValuesObj3D(WlzObject *gObj, size_t tileSz,
   }
   return(tObj);
 }
+
+/*!
+* \return	Negative, zero or positive for less than, equal or greater.
+* \ingroup	WlzValuesUtils
+* \brief	Compares two tile indices for qsort().
+* \param	p0			Pointer to first index.
+* \param	p1			Pointer to second index.
+*/
+static int	WlzTiledValuesTileCmp(const void *p0, const void *p1)
+{
+  size_t	t0,
+  		t1;
+
+  t0 = *(const size_t *)p0;
+  t1 = *(const size_t *)p1;
+  return((t0 > t1) - (t0 < t1));
+}
+
+/*!
+* \return	Numeric key for the entry.
+* \ingroup	WlzValuesUtils
+* \brief	Computes the key of a tiled values cache entry from it's
+* 		tile index.
+* \param	lru			The cache (not used).
+* \param	e			Cast to (WlzTiledValuesCacheEntry *)
+* 					to get the cache entry.
+*/
+static unsigned int WlzTiledValuesCacheKeyFn(AlcLRUCache *lru, void *e)
+{
+  return((unsigned int )(((WlzTiledValuesCacheEntry *)e)->idx));
+}
+
+/*!
+* \return	Non-zero value if the cache entries are different.
+* \ingroup	WlzValuesUtils
+* \brief	Compares the tile indices of two tiled values cache
+* 		entries.
+* \param	e0			First cache entry pointer.
+* \param	e1			Second cache entry pointer.
+*/
+static int	WlzTiledValuesCacheCmpFn(const void *e0, const void *e1)
+{
+  return(((const WlzTiledValuesCacheEntry *)e0)->idx !=
+         ((const WlzTiledValuesCacheEntry *)e1)->idx);
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Called when an entry is about to be removed from a tiled
+* 		values cache, this function releases the entry's tile and
+* 		then frees the entry.
+* \param	lru			The cache (not used).
+* \param	e			Cast to (WlzTiledValuesCacheEntry *)
+* 					to get the cache entry.
+*/
+static void	WlzTiledValuesCacheUnlinkFn(AlcLRUCache *lru, void *e)
+{
+  WlzTiledValuesCacheEntry *ent;
+
+  if((ent = (WlzTiledValuesCacheEntry *)e) != NULL)
+  {
+    WlzTiledValuesRelease(ent->cache->tVal, ent->idx);
+    AlcFree(ent);
+  }
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Advises the kernel that the given tiles of memory mapped
+* 		tiled values will soon be needed. Runs of consecutive
+* 		tiles are combined into a single request.
+* \param	tVal			Given tiled values.
+* \param	tiles			Tile indices in increasing order.
+* \param	nTiles			Number of tile indices.
+*/
+static void	WlzTiledValuesAdvise(WlzTiledValues *tVal, size_t *tiles,
+				size_t nTiles)
+{
+#ifdef WLZ_USE_MMAP
+  if((tVal->fd >= 0) && (tVal->tiles.v != NULL))
+  {
+    size_t	idx,
+    		idR,
+		tBytes;
+    size_t	pgMsk;
+
+    pgMsk = (size_t )sysconf(_SC_PAGESIZE) - 1;
+    tBytes = tVal->tileSz *
+             WlzGreySize(WlzGreyTableTypeToGreyType(tVal->type, NULL));
+    for(idx = 0; idx < nTiles; idx = idR)
+    {
+      size_t	a0,
+      		a1;
+
+      for(idR = idx + 1;
+          (idR < nTiles) && (tiles[idR] == tiles[idR - 1] + 1); ++idR)
+      {
+        /* Find the end of the run of consecutive tiles. */
+      }
+      a0 = (size_t )(tVal->tiles.ubp + (tiles[idx] * tBytes));
+      a1 = (size_t )(tVal->tiles.ubp + ((tiles[idR - 1] + 1) * tBytes));
+      a0 &= ~pgMsk;
+      (void )madvise((void *)a0, a1 - a0, MADV_WILLNEED);
+    }
+  }
+#endif /* WLZ_USE_MMAP */
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Reads in the given tiles of memory mapped tiled values by
+* 		touching each of their pages. The tiles are read in
+* 		parallel so that many reads may be outstanding at once.
+* \param	tVal			Given tiled values.
+* \param	tiles			Tile indices.
+* \param	nTiles			Number of tile indices.
+*/
+static void	WlzTiledValuesTouch(WlzTiledValues *tVal, size_t *tiles,
+				size_t nTiles)
+{
+#ifdef WLZ_USE_MMAP
+  if((tVal->fd >= 0) && (tVal->tiles.v != NULL))
+  {
+    long	idx;
+    size_t	pgSz,
+		tBytes;
+
+    pgSz = (size_t )sysconf(_SC_PAGESIZE);
+    tBytes = tVal->tileSz *
+             WlzGreySize(WlzGreyTableTypeToGreyType(tVal->type, NULL));
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for(idx = 0; idx < (long )nTiles; ++idx)
+    {
+      size_t	off;
+      const volatile WlzUByte *tP;
+
+      /* Reads through a volatile pointer can not be optimised away. */
+      tP = tVal->tiles.ubp + (tiles[idx] * tBytes);
+      for(off = 0; off < tBytes; off += pgSz)
+      {
+        (void )tP[off];
+      }
+      (void )tP[tBytes - 1];
+    }
+  }
+#endif /* WLZ_USE_MMAP */
+}
+
+/*!
+* \ingroup	WlzValuesUtils
+* \brief	Releases the pages which lie entirely within the given
+* 		tile of memory mapped tiled values. The values remain
+* 		valid and will be read again from the file if accessed.
+* \param	tVal			Given tiled values.
+* \param	tile			Tile index.
+*/
+static void	WlzTiledValuesRelease(WlzTiledValues *tVal, size_t tile)
+{
+#ifdef WLZ_USE_MMAP
+  if((tVal->fd >= 0) && (tVal->tiles.v != NULL))
+  {
+    size_t	tBytes;
+    size_t	a0,
+    		a1,
+		pgMsk;
+
+    pgMsk = (size_t )sysconf(_SC_PAGESIZE) - 1;
+    tBytes = tVal->tileSz *
+             WlzGreySize(WlzGreyTableTypeToGreyType(tVal->type, NULL));
+    a0 = (size_t )(tVal->tiles.ubp + (tile * tBytes));
+    a1 = a0 + tBytes;
+    a0 = (a0 + pgMsk) & ~pgMsk;
+    a1 &= ~pgMsk;
+    if(a1 > a0)
+    {
+      (void )madvise((void *)a0, a1 - a0, MADV_DONTNEED);
+    }
+  }
+#endif /* WLZ_USE_MMAP */
+}
@@ -2297,6 +2297,29 @@ typedef struct _WlzContour
   					     defining the contour. */
 } WlzContour;
 
+/*!
+* \struct	_WlzIdxMesh3D
+* \ingroup	WlzContour
+* \brief	A lightweight 3D surface of triangles held as an array
+*		of vertices and an array of vertex index triples, without
+*		any of the topology of a Woolz geometric model.
+*		The vertices of each triangle are in counter-clockwise
+*		order when viewed from the positive side of the surface.
+*		Typedef: ::WlzIdxMesh3D.
+*/
+typedef struct _WlzIdxMesh3D
+{
+  int		nVtx;			/*!< Number of vertices. */
+  int		maxVtx;			/*!< Number of vertices space has
+  					     been allocated for. */
+  int		nTri;			/*!< Number of triangles. */
+  int		maxTri;			/*!< Number of triangles space has
+  					     been allocated for. */
+  WlzDVertex3	*vtx;			/*!< Vertex positions. */
+  int		*tri;			/*!< Vertex indices, three per
+  					     triangle. */
+} WlzIdxMesh3D;
+
 
 #ifndef WLZ_EXT_BIND
 /*!
@@ -3088,8 +3111,41 @@ typedef struct _WlzTiledValues
   					     file to the tiles. This may be
 					     set even if not memory mapped. */
   WlzGreyP 	tiles;			/*!< The tiles. */
+#ifdef WLZ_EXT_BIND
+  void		*cache;
+#else
+  struct _WlzTiledValuesCache *cache;	/*!< Tile cache used when cutting
+  					     sections, set while a cache made
+					     by WlzMakeTiledValuesCache() for
+					     these values exists, else NULL. */
+#endif
 } WlzTiledValues;
 
+/*!
+* \struct	_WlzTiledValuesCache
+* \ingroup	WlzValuesUtils
+* \brief	A bounded cache of the resident tiles of memory mapped
+* 		tiled values, see WlzTiledValuesPrefetch().
+* 		Typedef: ::WlzTiledValuesCache.
+*/
+typedef struct _WlzTiledValuesCache
+{
+  WlzTiledValues *tVal;			/*!< The tiled values, which are
+  					     assigned to the cache. */
+#ifdef WLZ_EXT_BIND
+  void		*lru;
+#else
+  AlcLRUCache	*lru;			/*!< Least recent use removal cache
+  					     of tile indices. */
+#endif
+  WlzLong	hits;			/*!< Number of prefetched tiles which
+  					     were already in the cache. */
+  WlzLong	misses;			/*!< Number of prefetched tiles which
+  					     were read in. */
+  WlzLong	evictions;		/*!< Number of tiles released to keep
+  					     within the cache bound. */
+} WlzTiledValuesCache;
+
 /*!
 * \struct	_WlzLUTValues
 * \ingroup	WlzType
@@ -3379,12 +3435,33 @@ typedef struct _WlzFRect
 /************************************************************************
 * Convolution and other value filters.
 ************************************************************************/
+/*!
+* \enum		_WlzConvolveMethod
+* \ingroup	WlzValuesFilters
+* \brief	Methods for computing the convolution of an object's
+*		values with a kernel.
+*		Typedef: ::WlzConvolveMethod.
+*/
+typedef enum _WlzConvolveMethod
+{
+  WLZ_CONVOLVE_METHOD_AUTO = 0,		/*!< Method chosen using the kernel
+  					     and object size. */
+  WLZ_CONVOLVE_METHOD_DIRECT,		/*!< Full kernel applied directly. */
+  WLZ_CONVOLVE_METHOD_SEPARABLE,	/*!< Kernel factored into 1D kernels
+  					     which are applied in turn, if
+					     possible. */
+  WLZ_CONVOLVE_METHOD_FFT		/*!< Convolution computed using the
+  					     FFT. */
+} WlzConvolveMethod;
+
 /*!
 * \struct	_WlzConvolution
 * \ingroup	WlzValuesFilters
 * \brief	A 2D space domain convolution mask.
 *		To reduce computational cost at the expense of data storage
 *		the complete convolution is used even if highly symmetrical.
+*		For WLZ_CONVOLVE_FLOAT masks the mask values are doubles
+*		cast to int *.
 *		Typedef: ::WlzConvolution.
 */
 typedef struct	_WlzConvolution
@@ -4615,7 +4692,7 @@ typedef struct _WlzMeshTransform2D5
 */
 typedef double	(*WlzRegICPUsrWgtFn)(WlzVertexType,
 			     WlzAffineTransform *,
-			     AlcKDTTree *,
+			     AlcKDSTree *,
 			     WlzVertexP, WlzVertexP, WlzVertex, WlzVertex,
 			     double, double, void *);
 
@@ -5257,6 +5334,78 @@ typedef struct _WlzKrigModelFn
                                         /*!< Function pointer. */
 } WlzKrigModelFn;
 
+#ifndef WLZ_EXT_BIND
+/*!
+* \struct	_WlzObjectCache
+* \ingroup	WlzIO
+* \brief	A shared, size bounded cache of objects read from files,
+* 		see WlzObjectCacheNew().
+* 		Typedef: ::WlzObjectCache.
+*/
+typedef struct _WlzObjectCache
+{
+  AlcLRUCache	*lru;			/*!< Least recent use removal cache
+  					     of the objects. */
+  WlzLong	hits;			/*!< Number of requests for which
+  					     a cached object was found. */
+  WlzLong	misses;			/*!< Number of requests for which
+  					     the object was read from file. */
+  WlzLong	evictions;		/*!< Number of objects removed to
+  					     keep within the cache limits. */
+  void		*lock;			/*!< Lock for the cache, an OpenMP
+  					     lock when built with OpenMP. */
+} WlzObjectCache;
+#endif /* WLZ_EXT_BIND */
+
+#ifndef WLZ_EXT_BIND
+/*!
+* \struct	_WlzPlaneStream
+* \ingroup	WlzIO
+* \brief	A 3D domain object which is read from or written to a file
+* 		one plane at a time, see WlzPlaneStreamOpenRead() and
+* 		WlzPlaneStreamOpenWrite(). The plane domain is always
+* 		held in memory, but the values of a plane are only held
+* 		while they are needed.
+* 		Typedef: ::WlzPlaneStream.
+*/
+typedef struct _WlzPlaneStream
+{
+  FILE		*fP;			/*!< File being read or written. */
+  FILE		*spool;			/*!< Temporary file for the values
+  					     of a stream being written when
+					     the plane domains are only
+					     known as the planes are
+					     written, otherwise NULL. */
+  int		write;			/*!< Non-zero if the stream is
+  					     being written. */
+  int		nxtPl;			/*!< Index of the next plane to be
+  					     read or written, relative to
+					     the first plane. */
+  int		bgdSet;			/*!< Non-zero once the background
+  					     has been set from a plane's
+					     value table. */
+  struct _WlzObject *obj;		/*!< 3D domain object with the plane
+  					     domain and a voxel value table
+					     in which only the planes held
+					     in memory have values. */
+} WlzPlaneStream;
+
+/*!
+* \typedef	WlzPlaneStreamFn
+* \ingroup	WlzIO
+* \brief	Window operator applied by WlzPlaneStreamProcess(). The
+* 		operator is given a 3D object with the planes of the
+* 		current window and must set 2D objects for each of the
+* 		planes in the given range, using a NULL object for an
+* 		empty plane. The parameters are the window object, the
+* 		first and last planes for which objects are required,
+* 		the destination array for the objects and the operator's
+* 		data.
+*/
+typedef WlzErrorNum (*WlzPlaneStreamFn)(struct _WlzObject *, int, int,
+				        struct _WlzObject **, void *);
+#endif /* WLZ_EXT_BIND */
+
 
 #ifndef WLZ_EXT_BIND
 #ifdef  __cplusplus
@@ -122,6 +122,12 @@ WlzObject *WlzUnion3d(int	n,
     }
   }
 
+  /* without grey values only the domain is needed and the set
+     operation engine computes all the planes in parallel */
+  if( (errNum == WLZ_ERR_NONE) && (uvt == 0) ){
+    return WlzDomainSetOp(n, objs, WLZ_BO_OR, dstErr);
+  }
+
   /* allocate space for a working object array */
   objlist = NULL;
   if( errNum == WLZ_ERR_NONE ){
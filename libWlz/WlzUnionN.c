@@ -75,22 +75,16 @@ WlzObject *WlzUnionN(
   WlzObject		*obj=NULL;
   WlzDomain		domain;
   WlzValues		values;
-  WlzIntervalDomain	*idom;
-  WlzInterval		*itvl = NULL, *jtvl = NULL;
+  WlzDomain		*doms;
   WlzIntervalWSpace	*iwsp;
   WlzIntervalWSpace	*biwsp = NULL, *tiwsp, niwsp;
   WlzGreyWSpace		*gwsp, ngwsp;
   WlzObjectType		type;
   int 			i, j, k, l;
-  int			inttot, numactive, change, lwas = 0, nints, noverlap;
+  int			noverlap;
   WlzPixelV		backg;
-  int			line1, lastln;
-  int			kol1,lastkl;
   WlzGreyV		gv;
   WlzGreyP		greyptr;
-  int			**locbuff = NULL;
-  int			*locbuffs = NULL;
-  int			span;
   WlzErrorNum		errNum=WLZ_ERR_NONE;
 
   /* preliminary stuff - count of non-NULL objects, note WLZ_EMPTY_OBJs
@@ -199,96 +193,38 @@ WlzObject *WlzUnionN(
   }
 
   /*
-   * find the line and column bounds of the union.
+   * Compute the union of the domains using the interval set operation
+   * engine.
    */
   if( errNum == WLZ_ERR_NONE ){
-    line1 = objs[0]->domain.i->line1;
-    lastln = objs[0]->domain.i->lastln;
-    kol1 = objs[0]->domain.i->kol1;
-    lastkl = objs[0]->domain.i->lastkl;
-    for (i=1; i<n; i++) {
-      idom = objs[i]->domain.i;
-      if (line1 > idom->line1)
-	line1 = idom->line1;
-      if (lastln < idom->lastln)
-	lastln = idom->lastln;
-      if (kol1 > idom->kol1)
-	kol1 = idom->kol1;
-      if (lastkl < idom->lastkl)
-	lastkl = idom->lastkl;
-    }
-    span = lastkl - kol1 +1 ;
-    if( (locbuff = (int **) AlcMalloc((n+1)*sizeof(int *))) == NULL ){
-      errNum = WLZ_ERR_MEM_ALLOC;
-    }
-  }
-
-  /* space must be allocated for the largest variety of grey-value */
-  if( errNum == WLZ_ERR_NONE ){
-    if( (locbuffs = (int *) AlcMalloc(sizeof(double)*span*(n+1))) == NULL ){
-      AlcFree((void *) locbuff);
+    if( (doms = (WlzDomain *) AlcMalloc(n * sizeof(WlzDomain))) == NULL ){
       errNum = WLZ_ERR_MEM_ALLOC;
     }
     else {
-      for(i=0; i <= n; i++){
-	locbuff[i] = locbuffs + i*span;
+      for(i=0; i < n; i++){
+	doms[i] = objs[i]->domain;
       }
+      domain = WlzDomainSetOp2D(n, doms, WLZ_BO_OR, &errNum);
+      AlcFree((void *) doms);
     }
   }
-  /*
-   * count the individual intervals so that sufficient space
-   * for the union may be allocated.
-   */
-  if( errNum == WLZ_ERR_NONE ){
-    inttot=0;
-    for(i=0; i < n; i++){
-      inttot += WlzIntervalCount(objs[i]->domain.i, &errNum);
-    }
+  if( (errNum == WLZ_ERR_NONE) && (domain.core == NULL) ){
+    return WlzMakeEmpty(dstErr);
   }
-
-  /*
-   * set up domain, value table structures, and object.
-   */
   if( errNum == WLZ_ERR_NONE ){
-    if( (idom = WlzMakeIntervalDomain(WLZ_INTERVALDOMAIN_INTVL,
-				      line1,lastln,kol1,lastkl,
-				      &errNum)) == NULL ){
-      AlcFree((void *) locbuffs);
-      AlcFree((void *) locbuff);
+    values.v = NULL;
+    if( (obj = WlzMakeMain(WLZ_2D_DOMAINOBJ, domain, values,
+			   NULL, NULL, &errNum)) == NULL ){
+      (void )WlzFreeDomain(domain);
     }
-    else if( (itvl = (WlzInterval *)
-	      AlcMalloc(inttot * sizeof(WlzInterval))) == NULL){
-      AlcFree((void *) locbuffs);
-      AlcFree((void *) locbuff);
-      WlzFreeIntervalDomain(idom);
-      errNum = WLZ_ERR_MEM_ALLOC;
-    }
-    else {
-      idom->freeptr = AlcFreeStackPush(idom->freeptr, (void *)itvl, NULL);
-      lwas = line1;
-      jtvl = itvl;
-      nints = 0;
-      domain.i = idom;
-      values.v = NULL;
-      if( (obj = WlzMakeMain(WLZ_2D_DOMAINOBJ, domain, values,
-			     NULL, NULL, &errNum)) == NULL ){
-	WlzFreeIntervalDomain( idom );
-	AlcFree((void *) locbuffs);
-	AlcFree((void *) locbuff);
-	return(NULL);
-      }
-    }
-  }    
-
+  }
   /*
-   * allocate space for workspaces
+   * allocate space for the grey-value workspaces
    */
-  if( errNum == WLZ_ERR_NONE ){
+  if( (errNum == WLZ_ERR_NONE) && (uvt != 0) ){
     if( (iwsp = (WlzIntervalWSpace *)
         AlcMalloc (n * sizeof (WlzIntervalWSpace))) == NULL ){
       WlzFreeObj( obj );
-      AlcFree((void *) locbuffs);
-      AlcFree((void *) locbuff);
       errNum = WLZ_ERR_MEM_ALLOC;
       obj = NULL;
     }
@@ -297,90 +233,6 @@ WlzObject *WlzUnionN(
       tiwsp = iwsp + n;
     }
   }
-
-  /*
-   * Construct the union object's table of intervals.
-   * Initialise scanning on each object/workspace combination.
-   * Scan synchronously, setting up the union of adjacent and
-   * overlapping intervals.  Needs a clear head !!
-   */
-  if( errNum == WLZ_ERR_NONE ){
-    for (i=0; i<n; i++) {
-      WlzInitRasterScan(objs[i], iwsp, WLZ_RASTERDIR_ILIC);
-      WlzNextInterval(iwsp++);
-    }
-    numactive = n;
-
-    /*
-     * find next line and left hand end of next interval of union
-     */
-    while (numactive > 0) {
-      /*
-       * find first remaining active object
-       */
-      iwsp = biwsp;
-      while( iwsp->linrmn < 0 ){
-	iwsp++;
-      }
-      /*
-       * find minimum line number of remaining active intervals
-       */
-      l = iwsp->linpos;
-      kol1 = iwsp->lftpos;
-      lastkl = iwsp->rgtpos;
-      for (iwsp++; iwsp<tiwsp; iwsp++)
-	if (iwsp->linrmn >= 0 && iwsp->linpos < l) {
-	  l = iwsp->linpos;
-	  kol1 = iwsp->lftpos;
-	  lastkl = iwsp->rgtpos;
-	}
-      /*
-       * find left-most interval in this line
-       */
-      for (iwsp=biwsp; iwsp<tiwsp; iwsp++)
-	if (iwsp->linrmn >= 0 && iwsp->linpos == l && iwsp->lftpos < kol1) {
-	  kol1 = iwsp->lftpos;
-	  lastkl = iwsp->rgtpos;
-	}
-      /*
-       * construct maximal interval with current left end-point
-       */
-      do {
-	change = 0;
-	for (iwsp=biwsp; iwsp<tiwsp; iwsp++) {
-	  while( iwsp->linrmn >= 0 && iwsp->linpos == l
-		&& iwsp->lftpos <= lastkl+1 ){
-	    if (iwsp->rgtpos > lastkl) {
-	      lastkl = iwsp->rgtpos;
-	      change = 1;
-	    }
-	    if (WlzNextInterval(iwsp) != WLZ_ERR_NONE) {
-	      numactive--;
-	    }
-	  }
-	}
-      } while (change == 1);
-      itvl->ileft = kol1 - idom->kol1;
-      itvl->iright = lastkl - idom->kol1;
-      if (l == lwas)
-	nints++;
-      else {
-	(void) WlzMakeInterval(lwas,idom,nints,jtvl);
-	for (j = lwas+1; j<l; j++) {
-	  (void) WlzMakeInterval(j,idom,0,NULL);
-	}
-	lwas = l;
-	nints = 1;
-	jtvl = itvl;
-      }
-      itvl++;
-    }
-    (void) WlzMakeInterval(lwas,idom,nints,jtvl);
-    for (j = lwas+1; j<=lastln; j++) {
-      (void) WlzMakeInterval(j,idom,0,NULL);
-    }
-  }
-
   /* now deal with the grey-values if required */
   if( (errNum == WLZ_ERR_NONE) && (uvt != 0) ){
     WlzGreyType	grey_type;
@@ -388,8 +240,6 @@ WlzObject *WlzUnionN(
     if( (gwsp = (WlzGreyWSpace *)
 	 AlcMalloc (n * sizeof (WlzGreyWSpace))) == NULL){
       WlzFreeObj( obj );
-      AlcFree((void *) locbuffs);
-      AlcFree((void *) locbuff);
       AlcFree((void *) biwsp);
       errNum = WLZ_ERR_MEM_ALLOC;
       obj = NULL;
@@ -404,8 +254,6 @@ WlzObject *WlzUnionN(
       type = WlzGreyTableType(WLZ_GREY_TAB_RAGR, grey_type, NULL);
       if( (values.v = WlzNewValueTb(obj, type, backg, &errNum)) == NULL ){
 	WlzFreeObj( obj );
-	AlcFree((void *) locbuffs);
-	AlcFree((void *) locbuff);
 	AlcFree((void *) biwsp);
 	obj = NULL;
       }
@@ -424,8 +272,6 @@ WlzObject *WlzUnionN(
 	WlzNextGreyInterval(iwsp++);
 	if( gwsp[i].pixeltype != grey_type ){
 	  AlcFree((void *) gwsp);
-	  AlcFree((void *) locbuffs);
-	  AlcFree((void *) locbuff);
 	  AlcFree((void *) biwsp);
 	  WlzFreeObj( obj );
 	  obj = NULL;
@@ -576,8 +422,6 @@ WlzObject *WlzUnionN(
 
   if( errNum == WLZ_ERR_NONE ){
     AlcFree( (void *) biwsp);
-    AlcFree( (void *)locbuff );
-    AlcFree( (void *)locbuffs );
   }
 
   if( dstErr ){
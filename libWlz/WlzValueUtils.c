@@ -505,9 +505,9 @@ void		 WlzValueClampDoubleToFloat(double *vec, size_t count)
     {
       *vec = FLT_MAX;
     }
-    else if(*vec < FLT_MIN)
+    else if(*vec < -FLT_MAX)
     {
-      *vec = FLT_MIN;
+      *vec = -FLT_MAX;
     }
     ++vec;
   }
@@ -879,9 +879,9 @@ void		WlzValueClampDoubleIntoFloat(float *dst, double *src,
     {
       *dst = FLT_MAX;
     }
-    else if(*src < FLT_MIN)
+    else if(*src < -FLT_MAX)
     {
-      *dst = FLT_MIN;
+      *dst = -FLT_MAX;
     }
     else
     {
@@ -1955,6 +1955,7 @@ void		WlzValueCopyGreyToGrey(WlzGreyP dst, size_t dstOff,
 	case WLZ_GREY_DOUBLE:
 	  WlzValueCopyDoubleToFloat(dst.flp + dstOff, src.dbp + srcOff,
 	  			    count);
+	  break;
 	case WLZ_GREY_RGBA:
 	  WlzValueCopyRGBAToFloat(dst.flp + dstOff, src.rgbp + srcOff,
 	  			  count);
@@ -2280,6 +2280,89 @@ AlcKDTTree	*WlzVerticesBuildTree(WlzVertexType vType, int nV,
   return(tree);
 }
 
+/*!
+* \ingroup      WlzFeatures
+* \return				New static kD-tree or NULL on error.
+* \brief	Builds a static kD-tree from the given vertices in a
+*		single pass. The tree's point indices are the indices
+*		of the given vertices. Unlike WlzVerticesBuildTree()
+*		no shuffle workspace is required since the tree is
+*		balanced by construction.
+* \param	vType 			Type of vertices, must be either
+*					WLZ_VERTEX_D2 or WLZ_VERTEX_D3.
+* \param	nV 			Number of vertices.
+* \param	vtx 			The vertices.
+* \param	dstErr			Destination error pointer,
+*					may be NULL.
+*/
+AlcKDSTree	*WlzVerticesBuildKDSTree(WlzVertexType vType, int nV,
+				         WlzVertexP vtx, WlzErrorNum *dstErr)
+{
+  int		idx,
+  		treeDim = 0;
+  double	*buf = NULL,
+  		*bP;
+  AlcKDSTree	*tree = NULL;
+  AlcErrno	alcErr = ALC_ER_NONE;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  switch(vType)
+  {
+    case WLZ_VERTEX_D2:
+      treeDim = 2;
+      break;
+    case WLZ_VERTEX_D3:
+      treeDim = 3;
+      break;
+    default:
+      errNum = WLZ_ERR_PARAM_TYPE;
+      break;
+  }
+  if((errNum == WLZ_ERR_NONE) && ((nV <= 0) || (vtx.v == NULL)))
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((buf = (double *)AlcMalloc(sizeof(double) * treeDim * nV)) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    bP = buf;
+    if(vType == WLZ_VERTEX_D2)
+    {
+      for(idx = 0; idx < nV; ++idx)
+      {
+        *bP++ = (vtx.d2 + idx)->vtX;
+        *bP++ = (vtx.d2 + idx)->vtY;
+      }
+    }
+    else
+    {
+      for(idx = 0; idx < nV; ++idx)
+      {
+        *bP++ = (vtx.d3 + idx)->vtX;
+        *bP++ = (vtx.d3 + idx)->vtY;
+        *bP++ = (vtx.d3 + idx)->vtZ;
+      }
+    }
+    if((tree = AlcKDSTreeNew(treeDim, nV, buf, 0, &alcErr)) == NULL)
+    {
+      errNum = (alcErr == ALC_ER_ALLOC)? WLZ_ERR_MEM_ALLOC:
+      					 WLZ_ERR_PARAM_DATA;
+    }
+  }
+  AlcFree(buf);
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(tree);
+}
+
 /* #define WLZ_VERTICIES_TEST 1 */
 #if WLZ_VERTICIES_TEST == 1
 /* Test main() for WlzVerticesFromObj().
@@ -445,6 +445,263 @@ WlzObject	*WlzWindow(WlzObject *srcObj, WlzWindowFnType winFn,
   return(dstObj);
 }
 
+/*!
+* \return	Window function weight.
+* \ingroup	WlzValuesFilters
+* \brief	Computes the weight of the given 1D window function at
+*		the given distance from the window centre, where the
+*		distance has been normalised by the distance from the
+*		centre to the window edge along the same line.
+* \param	winFn			Required windowing function.
+* \param	dist			Normalised distance from the window
+*					centre.
+*/
+static double	WlzWindowFnWeight(WlzWindowFnType winFn, double dist)
+{
+  double	w = 1.0;
+
+  if(dist >= 1.0)
+  {
+    w = 0.0;
+  }
+  else
+  {
+    switch(winFn)
+    {
+      case WLZ_WINDOWFN_BLACKMAN:
+	w = 0.42 + (0.50 * cos(WLZ_M_PI * dist)) +
+	    (0.08 * cos(2.0 * WLZ_M_PI * dist));
+	break;
+      case WLZ_WINDOWFN_HAMMING:
+	w = 0.54 + (0.46 * cos(WLZ_M_PI * dist));
+	break;
+      case WLZ_WINDOWFN_HANNING:
+	w = 0.50 + (0.50 * cos(WLZ_M_PI * dist));
+	break;
+      case WLZ_WINDOWFN_PARZEN:
+	w = 1.0 - dist;
+	break;
+      case WLZ_WINDOWFN_WELCH:
+	w = 1.0 - (dist * dist);
+	break;
+      default:
+	break;
+    }
+  }
+  return(w);
+}
+
+/*!
+* \return	void
+* \ingroup	WlzValuesFilters
+* \brief	Applies the specified window function to the given 3D
+*		Woolz object. This is the 3D equivalent of
+*		WlzWindowApplyFn(), with the 1D window functions
+*		applied along lines from the centre of an axis aligned
+*		ellipsoid to its surface. For a point \f$P\f$ relative
+*		to the centre the ratio of the distance to \f$P\f$ and
+*		the distance to the surface along the same line is
+*		\f$\sqrt{(p_x / R_x)^2 + (p_y / R_y)^2 + (p_z / R_z)^2}\f$.
+*		All data outside of the ellipsoid are set to zero.
+*		This function, which is only called by WlzWindow3D()
+*		assumes that all its parameters are valid.
+* \param	obj			Given woolz object which MUST have
+*					rectangular value tables as produced
+*					by WlzCutObjToBox3D().
+* \param	center			Centre of the window with respect to
+*					the given object.
+* \param	radius			Radius of the window function.
+* \param	winFn			Required windowing function.
+*/
+static void	WlzWindowApplyFn3D(WlzObject *obj, WlzIVertex3 center,
+				   WlzIVertex3 radius, WlzWindowFnType winFn)
+{
+  int		idP,
+  		nPl;
+  WlzPlaneDomain *pDom;
+  WlzVoxelValues *vVal;
+
+  WLZ_DBG((WLZ_DBG_LVL_FN|WLZ_DBG_LVL_2),
+	  ("WlzWindowApplyFn3D FE %p {%d %d %d} {%d %d %d} %d\n",
+	   obj, center.vtX, center.vtY, center.vtZ,
+	   radius.vtX, radius.vtY, radius.vtZ, (int )winFn));
+  if((winFn == WLZ_WINDOWFN_BLACKMAN) ||
+     (winFn == WLZ_WINDOWFN_HAMMING) ||
+     (winFn == WLZ_WINDOWFN_HANNING) ||
+     (winFn == WLZ_WINDOWFN_PARZEN) ||
+     (winFn == WLZ_WINDOWFN_WELCH))
+  {
+    pDom = obj->domain.p;
+    vVal = obj->values.vox;
+    nPl = pDom->lastpl - pDom->plane1 + 1;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for(idP = 0; idP < nPl; ++idP)
+    {
+      int	idX,
+      		idY;
+      double	dZ2;
+      WlzGreyType vType;
+      WlzGreyP	gP;
+      WlzRectValues *rVTab;
+
+      rVTab = (vVal->values + idP)->r;
+      if(rVTab)
+      {
+	vType = WlzGreyTableTypeToGreyType(rVTab->type, NULL);
+	gP = rVTab->values;
+	dZ2 = (double )(pDom->plane1 + idP - center.vtZ) / radius.vtZ;
+	dZ2 *= dZ2;
+	for(idY = 0; idY <= rVTab->lastln - rVTab->line1; ++idY)
+	{
+	  double dY2;
+
+	  dY2 = (double )(rVTab->line1 + idY - center.vtY) / radius.vtY;
+	  dY2 *= dY2;
+	  for(idX = 0; idX < rVTab->width; ++idX)
+	  {
+	    double dX,
+		   w;
+
+	    dX = (double )(rVTab->kol1 + idX - center.vtX) / radius.vtX;
+	    w = WlzWindowFnWeight(winFn, sqrt((dX * dX) + dY2 + dZ2));
+	    switch(vType)
+	    {
+	      case WLZ_GREY_INT:
+		*(gP.inp) = WLZ_NINT(*(gP.inp) * w);
+		++(gP.inp);
+		break;
+	      case WLZ_GREY_SHORT:
+		*(gP.shp) = (short )WLZ_NINT(*(gP.shp) * w);
+		++(gP.shp);
+		break;
+	      case WLZ_GREY_UBYTE:
+		*(gP.ubp) = (WlzUByte )((*(gP.ubp) * w) + 0.5);
+		++(gP.ubp);
+		break;
+	      case WLZ_GREY_FLOAT:
+		*(gP.flp) *= w;
+		++(gP.flp);
+		break;
+	      case WLZ_GREY_DOUBLE:
+		*(gP.dbp) *= w;
+		++(gP.dbp);
+		break;
+	      case WLZ_GREY_RGBA: /* RGBA to be done RAB */
+	      default:
+		break;
+	    }
+	  }
+	}
+      }
+    }
+  }
+  WLZ_DBG((WLZ_DBG_LVL_FN|WLZ_DBG_LVL_2),
+	  ("WlzWindowApplyFn3D FX\n"));
+}
+
+/*!
+* \return	New object.
+* \ingroup	WlzValuesFilters
+* \brief	Cuts a cuboid region from the given 3D object and then
+*		applies the specified 3D data windowing function, see
+*		WlzWindow() for the equivalent 2D function.
+*		Because all values outside of the window's ellipsoid are
+*		set to zero the windowed object may be padded with zeros
+*		(as for frequency domain cross correlation) without
+*		introducing discontinuities at the object's boundary.
+*		The linkcount of the returned object is zero.
+* \param	srcObj			Given source object.
+* \param	winFn			Required windowing function.
+* \param	org			Window origin with respect to the
+*					given given source object.
+* \param	rad			Window radius.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzObject	*WlzWindow3D(WlzObject *srcObj, WlzWindowFnType winFn,
+			     WlzIVertex3 org, WlzIVertex3 rad,
+			     WlzErrorNum *dstErr)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+  WlzObject	*dstObj = NULL;
+  WlzGreyType	gType;
+  WlzIBox3	cutBox;
+
+  WLZ_DBG((WLZ_DBG_LVL_FN|WLZ_DBG_LVL_1),
+	  ("WlzWindow3D FE %p %d {%d %d %d} {%d %d %d} %p\n",
+	   srcObj, winFn, org.vtX, org.vtY, org.vtZ,
+	   rad.vtX, rad.vtY, rad.vtZ, dstErr));
+  if(srcObj == NULL)
+  {
+    errNum = WLZ_ERR_OBJECT_NULL;
+  }
+  else
+  {
+    switch(srcObj->type)
+    {
+      case WLZ_EMPTY_OBJ:
+	dstObj = WlzMakeEmpty(&errNum);
+	break;
+      case WLZ_3D_DOMAINOBJ:
+	if(srcObj->domain.core == NULL)
+	{
+	  errNum = WLZ_ERR_DOMAIN_NULL;
+	}
+	else if(srcObj->values.core == NULL)
+	{
+	  errNum = WLZ_ERR_VALUES_NULL;
+	}
+	else if((rad.vtX <= 0) || (rad.vtY <= 0) || (rad.vtZ <= 0))
+	{
+	  dstObj = WlzMakeEmpty(&errNum);
+	}
+	else
+	{
+	  cutBox.xMin = org.vtX - rad.vtX;
+	  cutBox.yMin = org.vtY - rad.vtY;
+	  cutBox.zMin = org.vtZ - rad.vtZ;
+	  cutBox.xMax = org.vtX + rad.vtX;
+	  cutBox.yMax = org.vtY + rad.vtY;
+	  cutBox.zMax = org.vtZ + rad.vtZ;
+	  gType = WlzGreyTypeFromObj(srcObj, &errNum);
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    dstObj = WlzCutObjToBox3D(srcObj, cutBox, gType,
+				      0, 0.0, 0.0, &errNum);
+	    if(dstObj && (errNum == WLZ_ERR_NONE))
+	    {
+	      if(dstObj->type == WLZ_3D_DOMAINOBJ)
+	      {
+		WlzWindowApplyFn3D(dstObj, org, rad, winFn);
+	      }
+	    }
+	  }
+	}
+	break;
+      default:
+        errNum = WLZ_ERR_OBJECT_TYPE;
+	break;
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    if(dstObj)
+    {
+      WlzFreeObj(dstObj);
+      dstObj = NULL;
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  WLZ_DBG((WLZ_DBG_LVL_FN|WLZ_DBG_LVL_1),
+	  ("WlzWindow3D FX %p\n",
+	   dstObj));
+  return(dstObj);
+}
+
 /*!
 * \return	Constant name string or NULL if match fails.
 * \ingroup	WlzValuesFilters
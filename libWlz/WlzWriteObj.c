@@ -51,6 +51,29 @@ static char _WlzWriteObj_c[] = "University of Edinburgh $Id$";
 #define __x86
 #endif
 
+/*!
+* \def		WLZ_WRITE_GREYBUF_SZ
+* \ingroup	WlzIO
+* \brief	Size (in bytes) of the staging buffer used when writing
+* 		grey values.
+*/
+#define WLZ_WRITE_GREYBUF_SZ	(1 << 16)
+
+/*!
+* \struct	_WlzWriteGreyBuf
+* \ingroup	WlzIO
+* \brief	Staging buffer into which grey values are encoded in the
+* 		Woolz file format order before being written to a file
+* 		in blocks.
+* 		Typedef: ::WlzWriteGreyBuf.
+*/
+typedef struct _WlzWriteGreyBuf
+{
+  FILE			*fP;		/*!< File written to. */
+  size_t		cnt;		/*!< Number of bytes in the buffer. */
+  WlzUByte		buf[WLZ_WRITE_GREYBUF_SZ]; /*!< Encoded bytes. */
+} WlzWriteGreyBuf;
+
 
 static WlzErrorNum		WlzWriteIntervalDomain(
 				  FILE *fP,
@@ -70,6 +93,10 @@ static WlzErrorNum		WlzWriteValueTable(
 static WlzErrorNum		WlzWriteVoxelValueTable(
 				  FILE *fP,
 				  WlzObject *obj);
+static WlzErrorNum		WlzWritePlaneStreamHead(
+				  FILE *fP,
+				  WlzPlaneDomain *pDom,
+				  WlzPixelV bgdV);
 static WlzErrorNum		WlzWriteTiledValueTable(
 				  FILE *fP,
 				  WlzObject *obj,
@@ -107,6 +134,26 @@ static WlzErrorNum 		WlzWriteContour(
 static WlzErrorNum 		WlzWriteGMModel(
 				  FILE *fP,
 				  WlzGMModel *model);
+static WlzErrorNum		WlzWriteGreyBufAppend(
+				  WlzWriteGreyBuf *gBuf,
+				  WlzGreyP gP,
+				  WlzGreyType gType,
+				  WlzGreyType packing,
+				  size_t nG);
+static WlzErrorNum		WlzWriteGreyBufFlush(
+				  WlzWriteGreyBuf *gBuf);
+static void			WlzWriteSwapWords(
+				  WlzUInt *wP,
+				  size_t nW);
+static void			WlzWriteSwapShorts(
+				  unsigned short *sP,
+				  size_t nS);
+static void			WlzWriteSwapFloats(
+				  WlzUInt *wP,
+				  size_t nW);
+static void			WlzWriteSwapDoubles(
+				  WlzUInt *wP,
+				  size_t nD);
 static WlzErrorNum		WlzWriteInt(
 				  FILE *fP,
 				  int *iP,
@@ -334,6 +381,237 @@ static int putdouble(double d, FILE *fP)
   return((int )fwrite(out.ubytes, sizeof(char), 8, fP));
 }
 
+/*!
+* \ingroup	WlzIO
+* \brief	Converts a buffer of native 4 byte words in place to the
+* 		Woolz file byte order. This is the block equivalent of
+* 		WLZ_SWAP_OUT_WORD(). The loop is written using whole word
+* 		shifts and masks so that it may be vectorised by the
+* 		compiler.
+* \param	wP			Buffer of words.
+* \param	nW			Number of words in the buffer.
+*/
+static void	WlzWriteSwapWords(WlzUInt *wP, size_t nW)
+{
+#if defined (__sparc) || defined (__mips) || defined (__ppc)
+  size_t	i;
+
+  for(i = 0; i < nW; ++i)
+  {
+    WlzUInt	w;
+
+    w = wP[i];
+    wP[i] = (w << 24) | ((w & 0x0000ff00) << 8) |
+            ((w & 0x00ff0000) >> 8) | (w >> 24);
+  }
+#endif /* __sparc || __mips */
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Converts a buffer of native 2 byte shorts in place to the
+* 		Woolz file byte order. This is the block equivalent of
+* 		WLZ_SWAP_OUT_SHORT().
+* \param	sP			Buffer of shorts.
+* \param	nS			Number of shorts in the buffer.
+*/
+static void	WlzWriteSwapShorts(unsigned short *sP, size_t nS)
+{
+#if defined (__sparc) || defined (__mips) || defined (__ppc)
+  size_t	i;
+
+  for(i = 0; i < nS; ++i)
+  {
+    unsigned short s;
+
+    s = sP[i];
+    sP[i] = (unsigned short )((s << 8) | (s >> 8));
+  }
+#endif /* __sparc || __mips */
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Converts a buffer of native floats in place to the Woolz
+* 		(DEC VAX) file format. This is the block equivalent of
+* 		WLZ_SWAP_OUT_FLOAT(): the 16 bit halves are reordered and
+* 		the byte which holds the least significant bits of the
+* 		exponent is incremented without carry into its neighbour.
+* \param	wP			Buffer of floats accessed as words.
+* \param	nW			Number of floats in the buffer.
+*/
+static void	WlzWriteSwapFloats(WlzUInt *wP, size_t nW)
+{
+  size_t	i;
+
+  for(i = 0; i < nW; ++i)
+  {
+    WlzUInt	w;
+
+    w = wP[i];
+#if defined (__sparc) || defined (__mips) || defined (__ppc)
+    w = ((w & 0x00ff00ff) << 8) | ((w & 0xff00ff00) >> 8);
+    wP[i] = (w & 0xff00ffff) | ((w + 0x00010000) & 0x00ff0000);
+#endif /* __sparc || __mips */
+#if defined (__x86) || defined (__alpha)
+    w = (w << 16) | (w >> 16);
+    wP[i] = (w & 0xffff00ff) | ((w + 0x00000100) & 0x0000ff00);
+#endif /* __x86 || __alpha */
+  }
+}
+
+/*!
+* \ingroup	WlzIO
+* \brief	Converts a buffer of native 8 byte doubles in place to the
+* 		Woolz file byte order. This is the block equivalent of
+* 		WLZ_SWAP_OUT_DOUBLE().
+* \param	wP			Buffer of doubles accessed as pairs of
+* 					words.
+* \param	nD			Number of doubles in the buffer.
+*/
+static void	WlzWriteSwapDoubles(WlzUInt *wP, size_t nD)
+{
+#if defined (__sparc) || defined (__mips) || defined (__ppc)
+  size_t	i;
+
+  WlzWriteSwapWords(wP, 2 * nD);
+  for(i = 0; i < nD; ++i)
+  {
+    WlzUInt	w;
+
+    w = wP[2 * i];
+    wP[2 * i] = wP[2 * i + 1];
+    wP[2 * i + 1] = w;
+  }
+#endif /* __sparc || __mips */
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Writes any encoded grey values in the given staging buffer
+* 		to its file using a single write and then empties the
+* 		buffer.
+* \param	gBuf			Given staging buffer.
+*/
+static WlzErrorNum WlzWriteGreyBufFlush(WlzWriteGreyBuf *gBuf)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(gBuf->cnt > 0)
+  {
+    if(fwrite(gBuf->buf, sizeof(WlzUByte), gBuf->cnt, gBuf->fP) != gBuf->cnt)
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+    gBuf->cnt = 0;
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Encodes the given native grey values using the given
+* 		packing and in the Woolz file byte order, appending them
+* 		to the given staging buffer. The buffer is written to its
+* 		file whenever it becomes full. The encoded bytes are
+* 		identical to those written by putword(), putshort(),
+* 		putc(), putfloat() and putdouble() for each value in turn.
+* 		Valid grey type and packing combinations are: int values
+* 		packed as int, short or unsigned byte; short values as
+* 		short or unsigned byte and all other grey types packed as
+* 		themselves.
+* \param	gBuf			Given staging buffer.
+* \param	gP			Native grey values.
+* \param	gType			Grey type of the native values.
+* \param	packing			Grey type used for the file.
+* \param	nG			Number of grey values.
+*/
+static WlzErrorNum WlzWriteGreyBufAppend(WlzWriteGreyBuf *gBuf, WlzGreyP gP,
+				         WlzGreyType gType, WlzGreyType packing,
+					 size_t nG)
+{
+  size_t	i,
+  		gSz,
+		pSz,
+		nC;
+  WlzGreyP	bP;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  gSz = WlzGreySize(gType);
+  pSz = WlzGreySize(packing);
+  if((gSz == 0) || (pSz == 0) || (pSz > gSz) ||
+     ((pSz < gSz) && (gType != WLZ_GREY_INT) && (gType != WLZ_GREY_SHORT)) ||
+     ((pSz == gSz) && (packing != gType)))
+  {
+    errNum = WLZ_ERR_GREY_TYPE;
+  }
+  while((errNum == WLZ_ERR_NONE) && (nG > 0))
+  {
+    if((nC = (WLZ_WRITE_GREYBUF_SZ - gBuf->cnt) / pSz) == 0)
+    {
+      errNum = WlzWriteGreyBufFlush(gBuf);
+      continue;
+    }
+    if(nC > nG)
+    {
+      nC = nG;
+    }
+    bP.ubp = gBuf->buf + gBuf->cnt;
+    if(pSz == gSz)
+    {
+      (void )memcpy(bP.v, gP.v, nC * pSz);
+    }
+    else if(gType == WLZ_GREY_INT)
+    {
+      if(packing == WLZ_GREY_SHORT)
+      {
+	for(i = 0; i < nC; ++i)
+	{
+	  bP.shp[i] = (short )(gP.inp[i]);
+	}
+      }
+      else
+      {
+	for(i = 0; i < nC; ++i)
+	{
+	  bP.ubp[i] = (WlzUByte )(gP.inp[i]);
+	}
+      }
+    }
+    else /* gType == WLZ_GREY_SHORT */
+    {
+      for(i = 0; i < nC; ++i)
+      {
+	bP.ubp[i] = (WlzUByte )(gP.shp[i]);
+      }
+    }
+    switch(packing)
+    {
+      case WLZ_GREY_INT:  /* FALLTHROUGH */
+      case WLZ_GREY_RGBA:
+	WlzWriteSwapWords(bP.rgbp, nC);
+	break;
+      case WLZ_GREY_SHORT:
+	WlzWriteSwapShorts((unsigned short *)(bP.shp), nC);
+	break;
+      case WLZ_GREY_FLOAT:
+	WlzWriteSwapFloats(bP.rgbp, nC);
+	break;
+      case WLZ_GREY_DOUBLE:
+	WlzWriteSwapDoubles(bP.rgbp, nC);
+	break;
+      default:
+	break;
+    }
+    gBuf->cnt += nC * pSz;
+    gP.ubp += nC * gSz;
+    nG -= nC;
+  }
+  return(errNum);
+}
+
 /*!
 * \return       Woolz error number code.
 * \ingroup      WlzIO
@@ -533,6 +811,405 @@ WlzErrorNum	WlzWriteObj(FILE *fP, WlzObject *obj)
   return(errNum);
 }
 
+/*!
+* \return	New plane stream or NULL on error.
+* \ingroup	WlzIO
+* \brief	Opens a plane stream for writing a 3D domain object to
+* 		the given file one plane at a time using
+* 		WlzPlaneStreamWritePlane(). The stream must be closed
+* 		using WlzPlaneStreamClose(), which does not close the file.
+*
+* 		If the domain is not deferred then the given plane domain
+* 		is that of the object being written and it is written
+* 		immediately, followed by the values of each plane as it
+* 		is given. If the domain is deferred then only the plane
+* 		bounds and voxel size of the given plane domain are used,
+* 		the domain of each plane is taken from the object written
+* 		for that plane and the values are held in a temporary
+* 		file until the stream is closed, when the complete object
+* 		is written.
+* \param	fP			Output file.
+* \param	pDom			Plane domain of the object.
+* \param	bgdV			Background value of the object.
+* \param	defDom			Non-zero if the domains of the planes
+* 					are only known as the planes are
+* 					written.
+* \param	dstErr			Destination error pointer, may be NULL.
+*/
+WlzPlaneStream	*WlzPlaneStreamOpenWrite(FILE *fP, WlzPlaneDomain *pDom,
+					 WlzPixelV bgdV, int defDom,
+					 WlzErrorNum *dstErr)
+{
+  int		idP,
+  		nPl;
+  WlzDomain	dom;
+  WlzValues	val;
+  WlzObject	*obj = NULL;
+  WlzPlaneStream *str = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  val.core = NULL;
+  if((fP == NULL) || (pDom == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(pDom->type != WLZ_PLANEDOMAIN_DOMAIN)
+  {
+    errNum = WLZ_ERR_DOMAIN_TYPE;
+  }
+#ifdef _WIN32
+  else if(_setmode(_fileno(fP), 0x8000) == -1)
+  {
+    errNum = WLZ_ERR_WRITE_EOF;
+  }
+#endif
+  else
+  {
+    dom.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
+			       pDom->plane1, pDom->lastpl,
+			       pDom->line1, pDom->lastln,
+			       pDom->kol1, pDom->lastkl, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    dom.p->voxel_size[0] = pDom->voxel_size[0];
+    dom.p->voxel_size[1] = pDom->voxel_size[1];
+    dom.p->voxel_size[2] = pDom->voxel_size[2];
+    if(defDom == 0)
+    {
+      nPl = pDom->lastpl - pDom->plane1 + 1;
+      for(idP = 0; idP < nPl; ++idP)
+      {
+        dom.p->domains[idP] = WlzAssignDomain(pDom->domains[idP], NULL);
+      }
+    }
+    val.vox = WlzMakeVoxelValueTb(WLZ_VOXELVALUETABLE_GREY,
+    				  pDom->plane1, pDom->lastpl,
+				  bgdV, NULL, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    obj = WlzMakeMain(WLZ_3D_DOMAINOBJ, dom, val, NULL, NULL, &errNum);
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((str = (WlzPlaneStream *)
+              AlcCalloc(1, sizeof(WlzPlaneStream))) == NULL)
+    {
+      errNum = WLZ_ERR_MEM_ALLOC;
+    }
+    else
+    {
+      str->fP = fP;
+      str->write = 1;
+      str->obj = WlzAssignObject(obj, NULL);
+      obj = NULL;
+      if(defDom)
+      {
+        if((str->spool = tmpfile()) == NULL)
+	{
+	  errNum = WLZ_ERR_FILE_OPEN;
+	}
+      }
+      else
+      {
+        errNum = WlzWritePlaneStreamHead(fP, str->obj->domain.p,
+					 str->obj->values.vox->bckgrnd);
+      }
+    }
+  }
+  if(errNum != WLZ_ERR_NONE)
+  {
+    if(str)
+    {
+      (void )WlzFreeObj(str->obj);
+      AlcFree(str);
+      str = NULL;
+    }
+    else if(obj)
+    {
+      (void )WlzFreeObj(obj);
+    }
+    else
+    {
+      (void )WlzFreePlaneDomain(dom.p);
+      (void )WlzFreeVoxelValueTb(val.vox);
+    }
+  }
+  if(dstErr)
+  {
+    *dstErr = errNum;
+  }
+  return(str);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Writes the next plane of a plane stream opened by
+* 		WlzPlaneStreamOpenWrite(). If the stream's domain is
+* 		not deferred then the given object's values must cover
+* 		the domain of the plane in the stream's plane domain,
+* 		otherwise the given object's domain becomes the domain
+* 		of the plane. The given object is not freed.
+* \param	str			Given plane stream.
+* \param	obj			2D domain object for the plane, may
+* 					be NULL or empty for an empty plane.
+*/
+WlzErrorNum	WlzPlaneStreamWritePlane(WlzPlaneStream *str, WlzObject *obj)
+{
+  int		idP;
+  WlzObject	tObj;
+  WlzPlaneDomain *pDom;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if((str == NULL) || (str->obj == NULL))
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(str->write == 0)
+  {
+    errNum = WLZ_ERR_PARAM_DATA;
+  }
+  else if((obj != NULL) && (obj->type != WLZ_EMPTY_OBJ) &&
+          (obj->type != WLZ_2D_DOMAINOBJ))
+  {
+    errNum = WLZ_ERR_OBJECT_TYPE;
+  }
+  else
+  {
+    idP = str->nxtPl;
+    pDom = str->obj->domain.p;
+    if(idP > pDom->lastpl - pDom->plane1)
+    {
+      errNum = WLZ_ERR_WRITE_EOF;
+    }
+    else
+    {
+      tObj.type = WLZ_2D_DOMAINOBJ;
+      tObj.linkcount = 0;
+      tObj.plist = NULL;
+      tObj.assoc = NULL;
+      tObj.domain.core = NULL;
+      tObj.values.core = NULL;
+      if((obj != NULL) && (obj->type == WLZ_2D_DOMAINOBJ))
+      {
+	tObj.values = obj->values;
+	if(str->spool)
+	{
+	  tObj.domain = obj->domain;
+	}
+      }
+      if(str->spool)
+      {
+	if(tObj.domain.core == NULL)
+	{
+	  tObj.values.core = NULL;
+	}
+	else
+	{
+	  pDom->domains[idP] = WlzAssignDomain(tObj.domain, NULL);
+	}
+	errNum = WlzWriteValueTable(str->spool, &tObj);
+      }
+      else
+      {
+	tObj.domain = pDom->domains[idP];
+	errNum = WlzWriteValueTable(str->fP, &tObj);
+      }
+      if(errNum == WLZ_ERR_NONE)
+      {
+        ++(str->nxtPl);
+      }
+    }
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Closes and frees a plane stream opened by either
+* 		WlzPlaneStreamOpenRead() or WlzPlaneStreamOpenWrite().
+* 		The stream's file is not closed. When a stream which
+* 		is being written is closed all of its planes must have
+* 		been written. If the stream's domain was deferred then
+* 		empty planes at either end are removed, the bounding box
+* 		of the plane domain is set from the written planes and
+* 		the complete object is written now. If all of the planes
+* 		were empty then, as for WlzThreshold(), the object keeps
+* 		all of its planes and its given bounding box.
+* \param	str			Given plane stream.
+*/
+WlzErrorNum	WlzPlaneStreamClose(WlzPlaneStream *str)
+{
+  int		idP,
+  		nPl,
+		idF = -1,
+		idL = -1;
+  long		nB = 0;
+  size_t	nR;
+  WlzDomain	dom;
+  WlzIntervalDomain *iDom;
+  WlzPlaneDomain *pDom;
+  char		buf[4096];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  dom.core = NULL;
+  if(str == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else
+  {
+    if(str->write && str->obj)
+    {
+      pDom = str->obj->domain.p;
+      nPl = pDom->lastpl - pDom->plane1 + 1;
+      if(str->nxtPl < nPl)
+      {
+        errNum = WLZ_ERR_WRITE_INCOMPLETE;
+      }
+      else if(str->spool == NULL)
+      {
+	errNum = WlzWritePropertyList(str->fP, str->obj->plist);
+      }
+      else
+      {
+        for(idP = 0; idP < nPl; ++idP)
+	{
+	  if(pDom->domains[idP].core != NULL)
+	  {
+	    if(idF < 0)
+	    {
+	      idF = idP;
+	    }
+	    idL = idP;
+	  }
+	}
+	/* As for WlzThreshold(), if all of the planes are empty then
+	 * they are all kept along with the given bounding box. */
+	if(idF < 0)
+	{
+	  idF = 0;
+	  idL = nPl - 1;
+	}
+	dom.p = WlzMakePlaneDomain(WLZ_PLANEDOMAIN_DOMAIN,
+				   pDom->plane1 + idF, pDom->plane1 + idL,
+				   pDom->line1, pDom->lastln,
+				   pDom->kol1, pDom->lastkl, &errNum);
+	if(dom.core)
+	{
+	  dom.p->voxel_size[0] = pDom->voxel_size[0];
+	  dom.p->voxel_size[1] = pDom->voxel_size[1];
+	  dom.p->voxel_size[2] = pDom->voxel_size[2];
+	  for(idP = idF; idP <= idL; ++idP)
+	  {
+	    if((iDom = pDom->domains[idP].i) != NULL)
+	    {
+	      dom.p->domains[idP - idF] = WlzAssignDomain(pDom->domains[idP],
+	      						  NULL);
+	      if(idP == idF)
+	      {
+		dom.p->line1 = iDom->line1;
+		dom.p->lastln = iDom->lastln;
+		dom.p->kol1 = iDom->kol1;
+		dom.p->lastkl = iDom->lastkl;
+	      }
+	      else
+	      {
+		dom.p->line1 = ALG_MIN(dom.p->line1, iDom->line1);
+		dom.p->lastln = ALG_MAX(dom.p->lastln, iDom->lastln);
+		dom.p->kol1 = ALG_MIN(dom.p->kol1, iDom->kol1);
+		dom.p->lastkl = ALG_MAX(dom.p->lastkl, iDom->lastkl);
+	      }
+	    }
+	  }
+	  errNum = WlzWritePlaneStreamHead(str->fP, dom.p,
+	  				   str->obj->values.vox->bckgrnd);
+	  /* Each empty plane has a single byte in the spool file, skip
+	   * those of the empty planes which have been removed. */
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    if((fseek(str->spool, 0, SEEK_END) != 0) ||
+	       ((nB = ftell(str->spool) - idF - (nPl - 1 - idL)) < 0) ||
+	       (fseek(str->spool, idF, SEEK_SET) != 0))
+	    {
+	      errNum = WLZ_ERR_READ_INCOMPLETE;
+	    }
+	  }
+	  while((errNum == WLZ_ERR_NONE) && (nB > 0))
+	  {
+	    nR = fread(buf, 1, (size_t )ALG_MIN(nB, (long )sizeof(buf)),
+	    	       str->spool);
+	    if(nR == 0)
+	    {
+	      errNum = WLZ_ERR_READ_INCOMPLETE;
+	    }
+	    else if(fwrite(buf, 1, nR, str->fP) != nR)
+	    {
+	      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	    }
+	    nB -= (long )nR;
+	  }
+	  if(errNum == WLZ_ERR_NONE)
+	  {
+	    errNum = WlzWritePropertyList(str->fP, str->obj->plist);
+	  }
+	  (void )WlzFreePlaneDomain(dom.p);
+	}
+      }
+    }
+    if(str->spool)
+    {
+      (void )fclose(str->spool);
+    }
+    (void )WlzFreeObj(str->obj);
+    AlcFree(str);
+  }
+  return(errNum);
+}
+
+/*!
+* \return	Woolz error code.
+* \ingroup	WlzIO
+* \brief	Writes the object type, plane domain and voxel value
+* 		table header of a plane stream's object. As with
+* 		WlzWriteVoxelValueTable() the background is written
+* 		as an integer.
+* \param	fP			Output file.
+* \param	pDom			Plane domain of the object.
+* \param	bgdV			Background value of the object.
+*/
+static WlzErrorNum WlzWritePlaneStreamHead(FILE *fP, WlzPlaneDomain *pDom,
+					   WlzPixelV bgdV)
+{
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  errNum = WlzValueConvertPixel(&bgdV, bgdV, WLZ_GREY_INT);
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(putc((unsigned int )WLZ_3D_DOMAINOBJ, fP) == EOF)
+    {
+      errNum = WLZ_ERR_WRITE_EOF;
+    }
+    else
+    {
+      errNum = WlzWritePlaneDomain(fP, pDom);
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if((putc((unsigned int )WLZ_VOXELVALUETABLE_GREY, fP) == EOF) ||
+       !putword(bgdV.v.inv, fP))
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	Woolz error code.
 * \ingroup	WlzIO
@@ -1349,7 +2026,9 @@ static WlzErrorNum WlzWritePropertyList(FILE *fP, WlzPropertyList *pList)
 * \return	Woolz error code.
 * \ingroup	WlzIO
 * \brief	Writes the 2D values of a Woolz 2D domain object to the
-*		given file.
+*		given file. The grey values are encoded into a staging
+*		buffer (see WlzWriteGreyBufAppend()) which is written
+*		in blocks rather than one value at a time.
 * \param	fP			Given file.
 * \param	obj			Object containing values that
 *					are to be written to file.
@@ -1359,12 +2038,11 @@ static WlzErrorNum WlzWriteValueTable(FILE *fP, WlzObject *obj)
   WlzIntervalWSpace	iwsp;
   WlzGreyWSpace		gwsp;
   WlzGreyType		gType;
-  WlzGreyP		g;
   WlzPixelV		background,
   			min,
 			max;
-  int 			i;
-  WlzGreyType		packing;
+  WlzGreyType		packing = WLZ_GREY_ERROR;
+  WlzWriteGreyBuf	*gBuf = NULL;
   WlzErrorNum		errNum = WLZ_ERR_NONE;
 
   /* obj == NULL has been checked by WlzWriteObj() */
@@ -1419,55 +2097,6 @@ static WlzErrorNum WlzWriteValueTable(FILE *fP, WlzObject *obj)
             {
 	      errNum = WLZ_ERR_WRITE_INCOMPLETE;
 	    }
-	    if((errNum = WlzInitGreyScan(obj, &iwsp, &gwsp)) == WLZ_ERR_NONE)
-	    {
-	      while((errNum == WLZ_ERR_NONE) &&
-	            ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
-	      {
-		g = gwsp.u_grintptr;
-		switch(packing)
-		{
-		  case WLZ_GREY_INT:
-		    for(i = 0; (i < iwsp.colrmn) && (errNum == WLZ_ERR_NONE);
-			i++, g.inp++)
-		    {
-		      if(!putword(*g.inp, fP))
-		      {
-			errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		      }
-		    }
-		    break;
-		  case WLZ_GREY_SHORT:
-		    for(i = 0; (i < iwsp.colrmn) && (errNum == WLZ_ERR_NONE);
-			i++, g.inp++)
-		    {
-		      if(!putshort((short) (*g.inp), fP))
-		      {
-			errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		      }
-		    }
-		    break;
-		  case WLZ_GREY_UBYTE:
-		    for(i = 0; (i < iwsp.colrmn) && (errNum == WLZ_ERR_NONE);
-		    	i++, g.inp++)
-		    {
-		      if(putc((unsigned int )*g.inp, fP) == EOF)
-		      {
-			errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		      }
-		    }
-		    break;
-		  default:
-		    errNum = WLZ_ERR_GREY_TYPE;
-		    break;
-		}
-	      }
-	      (void )WlzEndGreyScan(&iwsp, &gwsp);
-	      if(errNum == WLZ_ERR_EOO)
-	      {
-	        errNum = WLZ_ERR_NONE;
-	      }
-	    }
 	  }
 	  break;
 	case WLZ_GREY_SHORT:
@@ -1487,45 +2116,6 @@ static WlzErrorNum WlzWriteValueTable(FILE *fP, WlzObject *obj)
 	    {
 	      errNum = WLZ_ERR_WRITE_INCOMPLETE;
 	    }
-	    if((errNum = WlzInitGreyScan(obj, &iwsp, &gwsp)) == WLZ_ERR_NONE)
-	    {
-	      while((errNum == WLZ_ERR_NONE) &&
-	            ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
-	      {
-		g = gwsp.u_grintptr;
-		switch(packing)
-		{
-		  case WLZ_GREY_SHORT:
-		    for(i = 0; (i < iwsp.colrmn) && (errNum == WLZ_ERR_NONE);
-		    	i++, g.shp++)
-		    {
-		      if(!putshort(*g.shp, fP))
-		      {
-			errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		      }
-		    }
-		    break;
-		  case WLZ_GREY_UBYTE:
-		    for(i = 0; (i < iwsp.colrmn) && (errNum == WLZ_ERR_NONE);
-		    	i++, g.shp++)
-		    {
-		      if(putc((unsigned int) *g.shp, fP) == EOF)
-		      {
-			errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		      }
-		    }
-		    break;
-		  default:
-		    errNum = WLZ_ERR_GREY_TYPE;
-		    break;
-		}
-	      }
-	      (void )WlzEndGreyScan(&iwsp, &gwsp);
-	      if(errNum == WLZ_ERR_EOO)
-	      {
-	        errNum = WLZ_ERR_NONE;
-	      }
-	    }
 	  }
 	  break;
 	case WLZ_GREY_UBYTE:
@@ -1535,28 +2125,6 @@ static WlzErrorNum WlzWriteValueTable(FILE *fP, WlzObject *obj)
 	  {
 	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
 	  }
-	  else
-	  {
-	    errNum = WlzInitGreyScan(obj, &iwsp, &gwsp);
-	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    while((errNum == WLZ_ERR_NONE) &&
-	           ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
-	    {
-	      g = gwsp.u_grintptr;
-	      if((int )fwrite(g.ubp, sizeof(WlzUByte),
-	      		      iwsp.colrmn, fP) < iwsp.colrmn)
-	      {
-		errNum = WLZ_ERR_WRITE_INCOMPLETE;
-	      }
-	    }
-	    (void )WlzEndGreyScan(&iwsp, &gwsp);
-	    if(errNum == WLZ_ERR_EOO)
-	    {
-	      errNum = WLZ_ERR_NONE;
-	    }
-	  }
 	  break;
 	case WLZ_GREY_FLOAT:
 	  packing = WLZ_GREY_FLOAT;
@@ -1565,31 +2133,6 @@ static WlzErrorNum WlzWriteValueTable(FILE *fP, WlzObject *obj)
 	  {
 	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
 	  }
-	  else
-	  {
-	    errNum = WlzInitGreyScan(obj, &iwsp, &gwsp);
-	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    while((errNum == WLZ_ERR_NONE) &&
-	           ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
-	    {
-	      g = gwsp.u_grintptr;
-	      for(i = 0; (i < iwsp.colrmn) && (errNum == WLZ_ERR_NONE);
-		  i++, g.flp++)
-	      {
-		if(!putfloat(*g.flp, fP))
-		{
-		  errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		}
-	      }
-	    }
-	    (void )WlzEndGreyScan(&iwsp, &gwsp);
-	    if(errNum == WLZ_ERR_EOO)
-	    {
-	      errNum = WLZ_ERR_NONE;
-	    }
-	  }
 	  break;
 	case WLZ_GREY_DOUBLE:
 	  packing = WLZ_GREY_DOUBLE;
@@ -1598,31 +2141,6 @@ static WlzErrorNum WlzWriteValueTable(FILE *fP, WlzObject *obj)
 	  {
 	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
 	  }
-	  else
-	  {
-	    errNum = WlzInitGreyScan(obj, &iwsp, &gwsp);
-	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    while((errNum == WLZ_ERR_NONE) &&
-	           ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
-	    {
-	      g = gwsp.u_grintptr;
-	      for(i = 0; (i < iwsp.colrmn) && (errNum == WLZ_ERR_NONE);
-	          i++, g.dbp++)
-	      {
-		if(!putdouble(*g.dbp, fP))
-		{
-		  errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		}
-	      }
-	    }
-	    (void )WlzEndGreyScan(&iwsp, &gwsp);
-	    if(errNum == WLZ_ERR_EOO)
-	    {
-	      errNum = WLZ_ERR_NONE;
-	    }
-	  }
 	  break;
 	case WLZ_GREY_RGBA:
 	  packing = WLZ_GREY_RGBA;
@@ -1631,37 +2149,43 @@ static WlzErrorNum WlzWriteValueTable(FILE *fP, WlzObject *obj)
 	  {
 	    errNum = WLZ_ERR_WRITE_INCOMPLETE;
 	  }
-	  else
-	  {
-	    errNum = WlzInitGreyScan(obj, &iwsp, &gwsp);
-	  }
-	  if(errNum == WLZ_ERR_NONE)
-	  {
-	    while((errNum == WLZ_ERR_NONE) &&
-	           ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
-	    {
-	      g = gwsp.u_grintptr;
-	      for(i = 0; (i < iwsp.colrmn) && (errNum == WLZ_ERR_NONE);
-	          i++, g.rgbp++)
-	      {
-		if(!putword(*g.rgbp, fP))
-		{
-		  errNum = WLZ_ERR_WRITE_INCOMPLETE;
-		}
-	      }
-	    }
-	    (void )WlzEndGreyScan(&iwsp, &gwsp);
-	    if(errNum == WLZ_ERR_EOO)
-	    {
-	      errNum = WLZ_ERR_NONE;
-	    }
-	  }
 	  break;
 	default:
 	  errNum = WLZ_ERR_GREY_TYPE;
 	  break;
       }
     }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      if((gBuf = (WlzWriteGreyBuf *)
+		 AlcMalloc(sizeof(WlzWriteGreyBuf))) == NULL)
+      {
+        errNum = WLZ_ERR_MEM_ALLOC;
+      }
+      else
+      {
+        gBuf->fP = fP;
+	gBuf->cnt = 0;
+	errNum = WlzInitGreyScan(obj, &iwsp, &gwsp);
+      }
+    }
+    if(errNum == WLZ_ERR_NONE)
+    {
+      /* Encode the values of each interval into the staging buffer
+       * which is written whenever it becomes full. */
+      while((errNum == WLZ_ERR_NONE) &&
+	    ((errNum = WlzNextGreyInterval(&iwsp)) == WLZ_ERR_NONE))
+      {
+	errNum = WlzWriteGreyBufAppend(gBuf, gwsp.u_grintptr, gType, packing,
+				       iwsp.colrmn);
+      }
+      (void )WlzEndGreyScan(&iwsp, &gwsp);
+      if(errNum == WLZ_ERR_EOO)
+      {
+	errNum = WlzWriteGreyBufFlush(gBuf);
+      }
+    }
+    AlcFree(gBuf);
   }
   return(errNum);
 }
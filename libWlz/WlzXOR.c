@@ -41,10 +41,6 @@ static char _WlzXOR_c[] = "University of Edinburgh $Id$";
 */
 #include <Wlz.h>
 
-#ifdef _OPENMP
-#include <omp.h>
-#endif
-
 /*!
 * \return	Object with domain equal to the set exclusive or of
 * 		the two given objects.
@@ -56,57 +52,25 @@ static char _WlzXOR_c[] = "University of Edinburgh $Id$";
 		O_x = (O_0 - O_1) \cup (O_1 - O_0)
  		\f]
 *		where \f$-\f$ and \f$\cup\f$ are the set difference and
-*		union operators respectively. This seems to be slightly
-*		quicker than the alternative:
-*		\f[
-		O_x = (O_0 \cup O_1) - (O_1 \cap O_0)
-		\f]
+*		union operators respectively. Both are computed in a
+*		single pass of the interval set operation engine, see
+*		WlzDomainSetOp().
 * \param	o0			First object.
 * \param	o1			Second object.
 * \param	dstErr			Destination error pointer, may be NULL.
 */
 WlzObject	*WlzXORDom(WlzObject *o0, WlzObject *o1, WlzErrorNum *dstErr)
 {
-  WlzObject	*d0 = NULL,
-  		*d1 = NULL,
-		*x0 = NULL;
-  WlzErrorNum	errNum0 = WLZ_ERR_NONE,
-  		errNum1 = WLZ_ERR_NONE;
-
-#ifdef _OPENMP
-#pragma omp parallel shared(o0,o1)
-  {
-#pragma omp sections
-    {
-#pragma omp section
-      {
-#endif
-	d0 = WlzAssignObject(WlzDiffDomain(o0, o1, &errNum0), NULL);
-#ifdef _OPENMP
-      }
-#pragma omp section
-      {
-#endif
-	d1 = WlzAssignObject(WlzDiffDomain(o1, o0, &errNum1), NULL);
-#ifdef _OPENMP
-      }
-    }
-  }
-#endif
-  if((errNum0 == WLZ_ERR_NONE) && (errNum1 != WLZ_ERR_NONE))
-  {
-    errNum0 = errNum1;
-  }
-  if(errNum0 == WLZ_ERR_NONE)
-  {
-    x0 = WlzUnion2(d0, d1, &errNum0);
-  }
+  WlzObject	*objs[2];
+  WlzObject	*x0 = NULL;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
 
-  (void )WlzFreeObj(d0);
-  (void )WlzFreeObj(d1);
+  objs[0] = o0;
+  objs[1] = o1;
+  x0 = WlzDomainSetOp(2, objs, WLZ_BO_XOR, &errNum);
   if(dstErr != NULL)
   {
-    *dstErr = errNum0;
+    *dstErr = errNum;
   }
   return(x0);
 }
@@ -273,6 +273,9 @@ extern WlzObject 		*WlzEffReadObjVtk(
 extern WlzErrorNum 		WlzEffWriteObjVtk(
 				  FILE *fP,
 				  WlzObject *obj);
+extern WlzErrorNum		WlzEffWriteIdxMesh3DVtk(
+				  FILE *fP,
+				  WlzIdxMesh3D *mesh);
 
 /* From WlzExtFFSlc.c */
 extern WlzObject 		*WlzEffReadObjSlc(
@@ -299,6 +302,9 @@ extern WlzObject       		*WlzEffReadObjStl(
 extern WlzErrorNum     		WlzEffWriteObjStl(
 				  FILE *fP,
 				  WlzObject *obj);
+extern WlzErrorNum		WlzEffWriteIdxMesh3DStl(
+				  FILE *fP,
+				  WlzIdxMesh3D *mesh);
 /* From WlzExtFFIPL.c */
 extern WlzObject 		*WlzEffReadObjIPL(
 				  FILE *fP,
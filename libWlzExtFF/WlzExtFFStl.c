@@ -271,6 +271,81 @@ WlzErrorNum	WlzEffWriteObjStl(FILE *fP, WlzObject *obj)
   return(errNum);
 }
 
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Writes the given indexed triangle mesh to the given file
+* 		stream using the stereolithography stl file format, see
+* 		WlzEffReadObjStl(). The facets are written directly from
+* 		the mesh's arrays.
+* \param	fP			Output file stream.
+* \param	mesh			Given indexed triangle mesh.
+*/
+WlzErrorNum	WlzEffWriteIdxMesh3DStl(FILE *fP, WlzIdxMesh3D *mesh)
+{
+  int		idx;
+  int		*tri;
+  WlzDVertex3	nrm;
+  WlzDVertex3	*vtx[3];
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(fP == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((mesh->nVtx < 3) || (mesh->nTri < 1))
+  {
+    errNum = WLZ_ERR_DOMAIN_DATA;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(fprintf(fP, "solid ascii\n") <= 0)
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tri = mesh->tri;
+    for(idx = 0; idx < mesh->nTri; ++idx)
+    {
+      vtx[0] = mesh->vtx + tri[0];
+      vtx[1] = mesh->vtx + tri[1];
+      vtx[2] = mesh->vtx + tri[2];
+      nrm = WlzGeomTriangleNormal(*vtx[0], *vtx[1], *vtx[2]);
+      if(fprintf(fP,
+		 "  facet normal %g %g %g\n"
+		 "    outer loop\n"
+		 "      vertex %g %g %g\n"
+		 "      vertex %g %g %g\n"
+		 "      vertex %g %g %g\n"
+		 "    endloop\n"
+		 "  endfacet\n",
+		 nrm.vtX, nrm.vtY, nrm.vtZ,
+		 vtx[0]->vtX, vtx[0]->vtY, vtx[0]->vtZ,
+		 vtx[1]->vtX, vtx[1]->vtY, vtx[1]->vtZ,
+		 vtx[2]->vtX, vtx[2]->vtY, vtx[2]->vtZ) <= 0)
+      {
+	errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	break;
+      }
+      tri += 3;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    if(fprintf(fP, "endsolid\n") <= 0)
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	Woolz error number.
 * \ingroup	WlzExtFF
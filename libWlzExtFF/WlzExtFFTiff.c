@@ -46,6 +46,9 @@ static char _WlzExtFFTiff_c[] = "University of Edinburgh $Id$";
 #include <Wlz.h>
 #include <WlzExtFF.h>
 #include <tiffio.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #define	CVT(x)		(((x) * 255) / ((1L<<16)-1))
 
@@ -358,7 +361,7 @@ static WlzObject *WlzExtFFReadTiffDirObj(
   unsigned short *redcolormap, *bluecolormap, *greencolormap;
   unsigned char red[256], green[256], blue[256];
   int		width, height, numcolors;
-  int		len, tileWidth, tileHeight;
+  int		len, tileWidth, tileHeight, rowsPerStrip;
   int		wlzDepth;
   WlzGreyType	newpixtype;
   WlzPixelV	bckgrnd;
@@ -371,8 +374,19 @@ static WlzObject *WlzExtFFReadTiffDirObj(
   WlzGreyP	wlzData;
 
   /* don't need to check tif file pointer since already checked
-     but do need to set the directory */
-  TIFFSetDirectory(tif, dir);
+     but do need to set the directory. TIFFSetDirectory() walks the
+     directory chain from the start of the file so just step on to the
+     next directory when reading planes in sequence. */
+  if( TIFFCurrentDirectory(tif) + 1 == dir ){
+    if( TIFFReadDirectory(tif) != 1 ){
+      errNum = WLZ_ERR_FILE_FORMAT;
+    }
+  }
+  else if( TIFFCurrentDirectory(tif) != dir ){
+    if( TIFFSetDirectory(tif, dir) != 1 ){
+      errNum = WLZ_ERR_FILE_FORMAT;
+    }
+  }
 
   /* determine depth and pixel type */
   if(errNum == WLZ_ERR_NONE)
@@ -521,24 +535,39 @@ static WlzObject *WlzExtFFReadTiffDirObj(
       }
     }
     else {
-      /* use scanline read */
-      if( (buf = (unsigned char *) AlcMalloc(TIFFScanlineSize(tif))) == NULL ){
+      /* read whole (decoded) strips rather than a scanline at a time */
+      int	lineSz, stripRows;
+
+      lineSz = TIFFScanlineSize(tif);
+      if( (TIFFGetField(tif, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip) != 1) ||
+	  (rowsPerStrip <= 0) || (rowsPerStrip > height) ){
+	rowsPerStrip = height;
+      }
+      if( (buf = (unsigned char *)
+	   AlcMalloc((WlzLong )lineSz * rowsPerStrip)) == NULL ){
 	errNum = WLZ_ERR_MEM_ALLOC;
       }
 
       if( errNum == WLZ_ERR_NONE ){
 	dstPtr = wlzData.ubp;
-	for (row = 0; row < height; row++) {
+	for (row = 0; row < height; row += rowsPerStrip) {
 
-	  /* read a scanline */
-	  if (TIFFReadScanline(tif, buf, row, 0) < 0){
+	  /* read a strip */
+	  stripRows = ((row + rowsPerStrip) > height)? height - row:
+	  	      rowsPerStrip;
+	  if (TIFFReadEncodedStrip(tif, TIFFComputeStrip(tif, row, 0), buf,
+	  			   (WlzLong )lineSz * stripRows) < 0){
 	    errNum = WLZ_ERR_FILE_FORMAT;
 	    break;
 	  }
 
-	  /* convert a row of data */
-	  dstPtr = WlzEFFTiffToWlzRowData(buf, dstPtr, width, photometric, samplesperpixel,
-					  bitspersample, newpixtype, red, green, blue, &errNum);
+	  /* convert the rows of the strip */
+	  for(i = 0; i < stripRows; i++){
+	    dstPtr = WlzEFFTiffToWlzRowData(buf + (WlzLong )lineSz * i, dstPtr,
+	    				    width, photometric, samplesperpixel,
+					    bitspersample, newpixtype,
+					    red, green, blue, &errNum);
+	  }
 	}
       }
     }
@@ -593,6 +622,9 @@ static WlzObject *WlzExtFFReadTiffDirObj(
 * \return	Object read from file.
 * \ingroup	WlzExtFF
 * \brief	Reads a Woolz object from the given file using the TIFF format.
+* 		The pages of a multi-page TIFF file are read as the planes
+* 		of a 3D object. Unless split, these pages are decoded in
+* 		parallel with each thread opening the file for itself.
 * \param	tiffFileName		Given file name.
 * \param	split			If the image is tiled return individual
 *					tiles within a compound object.
@@ -644,6 +676,7 @@ WlzObject	*WlzEffReadObjTiff(
       WlzDomain	domain, *domains = NULL;
       WlzValues	values, *valuess = NULL;
       WlzPixelV 	bckgrnd;
+      WlzErrorNum	*pErr = NULL;
 
       domain.core = NULL;
       values.core = NULL;
@@ -687,29 +720,81 @@ WlzObject	*WlzEffReadObjTiff(
 	TIFFGetField(tif, TIFFTAG_YRESOLUTION, &(domain.p->voxel_size[1]));
       }
 
-      /* now put in remaining planes */
+      /* now put in remaining planes. These are decoded in parallel with
+	 each thread using its own TIFF handle and reading a contiguous
+	 block of planes so that it steps through the directory chain in
+	 sequence. A single thread just uses the open TIFF handle. Errors
+	 are kept per plane and the first failing plane then handled as
+	 for a sequential read. */
       if( errNum == WLZ_ERR_NONE ){
-	for(p=1; p < numPlanes; p++){
-	  if((tmpObj = WlzExtFFReadTiffDirObj(tif, p, split, &errNum)) != NULL){
-	    domains[p] = WlzAssignDomain(tmpObj->domain, NULL);
-	    valuess[p] = WlzAssignValues(tmpObj->values, NULL);
-	    WlzFreeObj(tmpObj);
+	if((pErr = (WlzErrorNum *)
+		   AlcCalloc(numPlanes, sizeof(WlzErrorNum))) == NULL){
+	  errNum = WLZ_ERR_MEM_ALLOC;
+	}
+      }
+      if( errNum == WLZ_ERR_NONE ){
+#ifdef _OPENMP
+#pragma omp parallel private(tmpObj)
+#endif
+	{
+	  TIFF	*thrTif = tif;
+
+#ifdef _OPENMP
+	  if( omp_get_num_threads() > 1 ){
+	    thrTif = TIFFOpen(tiffFileName, "rb");
 	  }
-	  else {
-	    /* if it is an image-type error then it is probably some
-	       proprietory information. If there is only one plane
-	       then convert to 2D but still return incomplete read */
-	    if((errNum == WLZ_ERR_IMAGE_TYPE) && (p == 1)){
-	      tmpObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, domains[0],
-				   valuess[0], NULL, NULL, NULL);
-	      WlzFreeObj(obj);
-	      obj = tmpObj;
+#pragma omp for schedule(static)
+#endif
+	  for(p=1; p < numPlanes; p++){
+	    if( thrTif == NULL ){
+	      pErr[p] = WLZ_ERR_READ_EOF;
 	    }
-	    errNum = WLZ_ERR_READ_INCOMPLETE;
+	    else if((tmpObj = WlzExtFFReadTiffDirObj(thrTif, p, split,
+						     &(pErr[p]))) != NULL){
+	      domains[p] = WlzAssignDomain(tmpObj->domain, NULL);
+	      valuess[p] = WlzAssignValues(tmpObj->values, NULL);
+	      WlzFreeObj(tmpObj);
+	    }
+	    else if( pErr[p] == WLZ_ERR_NONE ){
+	      pErr[p] = WLZ_ERR_READ_INCOMPLETE;
+	    }
+	  }
+	  if( thrTif && (thrTif != tif) ){
+	    TIFFClose(thrTif);
+	  }
+	}
+	for(p=1; p < numPlanes; p++){
+	  if( pErr[p] != WLZ_ERR_NONE ){
 	    break;
 	  }
 	}
+	if( p < numPlanes ){
+	  int	q;
+
+	  /* discard any planes read beyond the first failure */
+	  for(q = p + 1; q < numPlanes; q++){
+	    if( domains[q].core ){
+	      (void )WlzFreeDomain(domains[q]);
+	      domains[q].core = NULL;
+	    }
+	    if( valuess[q].core ){
+	      (void )WlzFreeValues(valuess[q]);
+	      valuess[q].core = NULL;
+	    }
+	  }
+	  /* if it is an image-type error then it is probably some
+	     proprietory information. If there is only one plane
+	     then convert to 2D but still return incomplete read */
+	  if((pErr[p] == WLZ_ERR_IMAGE_TYPE) && (p == 1)){
+	    tmpObj = WlzMakeMain(WLZ_2D_DOMAINOBJ, domains[0],
+				 valuess[0], NULL, NULL, NULL);
+	    WlzFreeObj(obj);
+	    obj = tmpObj;
+	  }
+	  errNum = WLZ_ERR_READ_INCOMPLETE;
+	}
       }
+      AlcFree(pErr);
 
       /* should standardise here (if 3D) */
     }
@@ -186,6 +186,88 @@ WlzErrorNum	WlzEffWriteObjVtk(FILE *fP, WlzObject *obj)
   return(errNum);
 }
 
+/*!
+* \return	Woolz error number.
+* \ingroup	WlzExtFF
+* \brief	Writes the given indexed triangle mesh to the given
+*		stream using the Visualization Toolkit (polydata) file
+*		format. The vertices and triangles are written directly
+*		from the mesh's arrays.
+* \param	fP			Output file stream.
+* \param	mesh			Given indexed triangle mesh.
+*/
+WlzErrorNum	WlzEffWriteIdxMesh3DVtk(FILE *fP, WlzIdxMesh3D *mesh)
+{
+  int		idx;
+  int		*tri;
+  WlzDVertex3	*vtx;
+  WlzErrorNum	errNum = WLZ_ERR_NONE;
+
+  if(fP == NULL)
+  {
+    errNum = WLZ_ERR_PARAM_NULL;
+  }
+  else if(mesh == NULL)
+  {
+    errNum = WLZ_ERR_DOMAIN_NULL;
+  }
+  else if((mesh->nVtx < 3) || (mesh->nTri < 1))
+  {
+    errNum = WLZ_ERR_DOMAIN_DATA;
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Output the file header. */
+    if(fprintf(fP,
+	       "# vtk DataFile Version 1.0\n"
+	       "Written by WlzEffWriteIdxMesh3DVtk().\n"
+	       "ASCII\n"
+	       "DATASET POLYDATA\n"
+	       "POINTS %d float\n",
+	       mesh->nVtx) <= 0)
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Output the vertex positions. */
+    vtx = mesh->vtx;
+    for(idx = 0; idx < mesh->nVtx; ++idx)
+    {
+      if(fprintf(fP, "%g %g %g\n", vtx->vtX, vtx->vtY, vtx->vtZ) <= 0)
+      {
+	errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	break;
+      }
+      ++vtx;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    /* Output the triangle vertex indices. */
+    if(fprintf(fP,
+	       "POLYGONS %d %d\n", mesh->nTri, 4 * mesh->nTri) <= 0)
+    {
+      errNum = WLZ_ERR_WRITE_INCOMPLETE;
+    }
+  }
+  if(errNum == WLZ_ERR_NONE)
+  {
+    tri = mesh->tri;
+    for(idx = 0; idx < mesh->nTri; ++idx)
+    {
+      if(fprintf(fP, "3 %d %d %d\n", tri[0], tri[1], tri[2]) <= 0)
+      {
+	errNum = WLZ_ERR_WRITE_INCOMPLETE;
+	break;
+      }
+      tri += 3;
+    }
+  }
+  return(errNum);
+}
+
 /*!
 * \return	Woolz error number.
 * \ingroup	WlzExtFF